@@ -0,0 +1,655 @@
+// bench_charts.cpp
+// Per-chart benchmarks: ingest, update() and draw() at several data sizes.
+// Every chart gets three rows:
+//   <chart>_ingest  feeding one batch of new data (setTargetData, pushSamples, ...)
+//   <chart>_update  one frame of CPU work: ingest + update(), so the chart never settles
+//   <chart>_draw    draw() into an offscreen render target (CPU submission + batch flush)
+
+#include "bench_util.h"
+#include "RLAreaChart.h"
+#include "RLBarChart.h"
+#include "RLBubble.h"
+#include "RLCandlestickChart.h"
+#include "RLGauge.h"
+#include "RLGaugePanel.h"
+#include "RLHeatMap.h"
+#include "RLHeatMap3D.h"
+#include "RLLinearGauge.h"
+#include "RLLogPlot.h"
+#include "RLOrderBookVis.h"
+#include "RLPieChart.h"
+#include "RLRadarChart.h"
+#include "RLSankey.h"
+#include "RLScatterPlot.h"
+#include "RLTimeSeries.h"
+#include "RLTreeMap.h"
+#include "raylib.h"
+#include <algorithm>
+#include <cmath>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+static constexpr float BENCH_DT = 1.0f / 60.0f;
+static constexpr int TARGET_WIDTH = 1280;
+static constexpr int TARGET_HEIGHT = 720;
+static constexpr Rectangle BENCH_BOUNDS{ 0.0f, 0.0f, (float)TARGET_WIDTH, (float)TARGET_HEIGHT };
+
+struct ChartBenchContext {
+    RenderTexture2D mTarget{};
+    bool mDraw = false;
+    double mMinSeconds = 0.25;
+};
+
+// Deterministic [0, 1) sequence so runs are comparable
+float nextRandom(uint32_t& rSeed) {
+    rSeed = rSeed * 1664525u + 1013904223u;
+    return (float)(rSeed >> 8) / 16777216.0f;
+}
+
+template<typename Chart, typename Ingest, typename Draw>
+void benchChart(const char* pName, size_t aSize, size_t aItems, Chart& rChart,
+                Ingest&& rIngest, Draw&& rDraw, const ChartBenchContext& rCtx) {
+    const std::string lName = pName;
+
+    printResult((lName + "_ingest").c_str(), aSize, 1, runTimed([&]() {
+        rIngest();
+    }, aItems, rCtx.mMinSeconds));
+
+    printResult((lName + "_update").c_str(), aSize, 1, runTimed([&]() {
+        rIngest();
+        rChart.update(BENCH_DT);
+    }, aItems, rCtx.mMinSeconds));
+
+    if (!rCtx.mDraw || rCtx.mTarget.id == 0) {
+        return;
+    }
+    rIngest();
+    rChart.update(BENCH_DT);
+    printResult((lName + "_draw").c_str(), aSize, 1, runTimed([&]() {
+        BeginTextureMode(rCtx.mTarget);
+        ClearBackground(BLACK);
+        rDraw();
+        EndTextureMode();
+    }, aSize, rCtx.mMinSeconds));
+}
+
+void benchTimeSeries(size_t aWindow, const ChartBenchContext& rCtx) {
+    RLTimeSeries lChart(BENCH_BOUNDS, aWindow);
+    const size_t lTrace = lChart.addTrace();
+    std::vector<float> lBlock(256);
+    uint32_t lSeed = 1u;
+    for (size_t i = 0; i < aWindow; i += lBlock.size()) {
+        for (float& rV : lBlock) {
+            rV = nextRandom(lSeed) * 2.0f - 1.0f;
+        }
+        lChart.pushSamples(lTrace, std::span<const float>(lBlock));
+    }
+    benchChart("timeseries", aWindow, lBlock.size(), lChart, [&]() {
+        lChart.pushSamples(lTrace, std::span<const float>(lBlock));
+    }, [&]() { lChart.draw(); }, rCtx);
+
+    // 100 windows of history zoomed out to the plot width: the pyramid keeps the
+    // rebuild O(plot width) however long the history is
+    const size_t lHistorySize = aWindow * 100;
+    RLTimeSeries lHistory(BENCH_BOUNDS, aWindow);
+    const size_t lHistoryTrace = lHistory.addTrace();
+    lHistory.setTraceHistoryEnabled(lHistoryTrace, true);
+    for (size_t i = 0; i < lHistorySize; i += lBlock.size()) {
+        for (float& rV : lBlock) {
+            rV = nextRandom(lSeed) * 2.0f - 1.0f;
+        }
+        lHistory.pushSamples(lHistoryTrace, std::span<const float>(lBlock));
+    }
+    printResult("timeseries_history_rebuild", lHistorySize, 1, runTimed([&]() {
+        lHistory.setHistoryView(0, lHistorySize);
+        (void)lHistory.getTraceScreenPointCount(lHistoryTrace);
+    }, 1, rCtx.mMinSeconds));
+
+    // 256 synchronized channels fed by frames; the amplitude alternates so every
+    // iteration re-scales and remaps all channels (one vectorized pass each)
+    const size_t lChannels = 256;
+    const size_t lChannelWindow = aWindow / 10;
+    RLTimeSeries lMulti(BENCH_BOUNDS, lChannelWindow);
+    RLTimeSeriesChartStyle lMultiStyle;
+    lMultiStyle.mSmoothScale = false;
+    lMulti.setStyle(lMultiStyle);
+    const size_t lFirstChannel = lMulti.addChannelGroup(lChannels);
+    std::vector<float> lFrames(16 * lChannels);
+    for (size_t i = 0; i < lChannelWindow; i += 16) {
+        for (float& rV : lFrames) {
+            rV = nextRandom(lSeed) * 2.0f - 1.0f;
+        }
+        lMulti.pushFrames(lFirstChannel, lFrames.data(), 16, lChannels);
+    }
+    float lAmplitude = 1.0f;
+    printResult("timeseries_channels_rescale", lChannelWindow * lChannels, 16, runTimed([&]() {
+        lAmplitude = lAmplitude > 1.5f ? 1.0f : 2.0f;
+        for (float& rV : lFrames) {
+            rV = (nextRandom(lSeed) * 2.0f - 1.0f) * lAmplitude;
+        }
+        lMulti.pushFrames(lFirstChannel, lFrames.data(), 16, lChannels);
+        lMulti.update(BENCH_DT);
+        for (size_t c = 0; c < lChannels; c++) {
+            (void)lMulti.getTraceScreenPointCount(lFirstChannel + c);
+        }
+    }, 16, rCtx.mMinSeconds));
+
+    // Snapshot of all 256 full channels, and restoring it (dashboard warm-up)
+    std::vector<uint8_t> lState;
+    printResult("timeseries_state_save", lChannelWindow * lChannels, 1, runTimed([&]() {
+        lState = lMulti.saveState();
+    }, lChannelWindow * lChannels, rCtx.mMinSeconds));
+    printResult("timeseries_state_load", lChannelWindow * lChannels, 1, runTimed([&]() {
+        lMulti.loadState(lState);
+    }, lChannelWindow * lChannels, rCtx.mMinSeconds));
+}
+
+void benchHeatMap(size_t aSide, const ChartBenchContext& rCtx) {
+    RLHeatMap lChart(BENCH_BOUNDS, (int)aSide, (int)aSide);
+    std::vector<Vector2> lPoints(4096);
+    uint32_t lSeed = 2u;
+    for (Vector2& rP : lPoints) {
+        rP = Vector2{ nextRandom(lSeed) * 2.0f - 1.0f, nextRandom(lSeed) * 2.0f - 1.0f };
+    }
+    benchChart("heatmap", aSide * aSide, lPoints.size(), lChart, [&]() {
+        lChart.addPoints(std::span<const Vector2>(lPoints));
+    }, [&]() { lChart.draw(); }, rCtx);
+
+    // Click-stream ingest: one large batch per frame, binned serially and on all
+    // cores (the per-thread grids are merged by prepare())
+    std::vector<Vector2> lBatch(1 << 20);
+    for (Vector2& rP : lBatch) {
+        rP = Vector2{ nextRandom(lSeed) * 2.0f - 1.0f, nextRandom(lSeed) * 2.0f - 1.0f };
+    }
+    for (const int lThreads : { 1, 0 }) {
+        RLHeatMap lIngest(BENCH_BOUNDS, (int)aSide, (int)aSide);
+        lIngest.setBinningThreads(lThreads);
+        printResult(lThreads == 1 ? "heatmap_bin_serial" : "heatmap_bin_threaded", aSide * aSide,
+                    lThreads == 1 ? 1 : (size_t)std::max(1u, std::thread::hardware_concurrency()), runTimed([&]() {
+            lIngest.addPoints(std::span<const Vector2>(lBatch));
+            lIngest.prepare(0.016f);
+        }, lBatch.size(), rCtx.mMinSeconds));
+    }
+}
+
+void benchOrderBook(size_t aLevels, const ChartBenchContext& rCtx) {
+    RLOrderBookVis lChart(BENCH_BOUNDS, 256, aLevels);
+    RLOrderBookSnapshot lSnapshots[2];
+    uint32_t lSeed = 3u;
+    for (int s = 0; s < 2; s++) {
+        const float lMid = 100.0f + (float)s * 0.05f;
+        for (size_t i = 0; i < aLevels; i++) {
+            lSnapshots[s].mBids.emplace_back(lMid - 0.01f * (float)(i + 1), 10.0f + nextRandom(lSeed) * 90.0f);
+            lSnapshots[s].mAsks.emplace_back(lMid + 0.01f * (float)(i + 1), 10.0f + nextRandom(lSeed) * 90.0f);
+        }
+    }
+    size_t lPhase = 0;
+    benchChart("orderbook", aLevels, aLevels * 2, lChart, [&]() {
+        lChart.pushSnapshot(lSnapshots[lPhase++ & 1]);
+    }, [&]() { lChart.draw2D(); }, rCtx);
+}
+
+void benchHeatMap3D(size_t aSide, const ChartBenchContext& rCtx) {
+    RLHeatMap3D lChart((int)aSide, (int)aSide);
+    std::vector<float> lGrids[2];
+    for (int g = 0; g < 2; g++) {
+        lGrids[g].resize(aSide * aSide);
+        for (size_t y = 0; y < aSide; y++) {
+            for (size_t x = 0; x < aSide; x++) {
+                lGrids[g][y * aSide + x] = sinf((float)x * 0.1f + (float)g) * cosf((float)y * 0.1f);
+            }
+        }
+    }
+    Camera3D lCamera = {};
+    lCamera.position = Vector3{ 2.5f, 2.0f, 2.5f };
+    lCamera.target = Vector3{ 0.0f, 0.0f, 0.0f };
+    lCamera.up = Vector3{ 0.0f, 1.0f, 0.0f };
+    lCamera.fovy = 45.0f;
+    lCamera.projection = CAMERA_PERSPECTIVE;
+    size_t lPhase = 0;
+    benchChart("heatmap3d", aSide * aSide, aSide * aSide, lChart, [&]() {
+        lChart.setValues((int)aSide, (int)aSide, std::span<const float>(lGrids[lPhase++ & 1]));
+    }, [&]() {
+        BeginMode3D(lCamera);
+        lChart.draw(Vector3{ 0.0f, 0.0f, 0.0f }, 1.0f, lCamera);
+        EndMode3D();
+    }, rCtx);
+}
+
+void benchSankey(size_t aLinks, const ChartBenchContext& rCtx) {
+    RLSankey lChart(BENCH_BOUNDS);
+    const int lColumns = 4;
+    const size_t lPerColumn = aLinks / 12 > 2 ? aLinks / 12 : 2;
+    for (int c = 0; c < lColumns; c++) {
+        for (size_t n = 0; n < lPerColumn; n++) {
+            lChart.addNode("N" + std::to_string(c) + "." + std::to_string(n), Color{ 80, 180, 255, 255 }, c);
+        }
+    }
+    std::vector<size_t> lLinks;
+    uint32_t lSeed = 4u;
+    for (size_t i = 0; i < aLinks; i++) {
+        const size_t lCol = i % (size_t)(lColumns - 1);
+        const size_t lSrc = lCol * lPerColumn + (i / 3) % lPerColumn;
+        const size_t lDst = (lCol + 1) * lPerColumn + (i * 7 + 1) % lPerColumn;
+        lLinks.push_back(lChart.addLink(lSrc, lDst, 1.0f + nextRandom(lSeed) * 9.0f));
+    }
+    benchChart("sankey", aLinks, aLinks, lChart, [&]() {
+        for (const size_t lLink : lLinks) {
+            lChart.setLinkValue(lLink, 1.0f + nextRandom(lSeed) * 9.0f);
+        }
+    }, [&]() { lChart.draw(); }, rCtx);
+
+    // Structural relayout every frame: auto columns plus barycenter ordering
+    RLSankeyStyle lStyle;
+    lStyle.mOrderNodes = true;
+    RLSankey lLayout(BENCH_BOUNDS, lStyle);
+    for (size_t n = 0; n < (size_t)lColumns * lPerColumn; n++) {
+        lLayout.addNode("N" + std::to_string(n));
+    }
+    for (size_t i = 0; i < aLinks; i++) {
+        const size_t lCol = i % (size_t)(lColumns - 1);
+        const size_t lSrc = lCol * lPerColumn + (i / 3) % lPerColumn;
+        const size_t lDst = (lCol + 1) * lPerColumn + (i * 7 + 1) % lPerColumn;
+        lLayout.addLink(lSrc, lDst, 1.0f + nextRandom(lSeed) * 9.0f);
+    }
+    benchChart("sankey_layout", aLinks, aLinks, lLayout, [&]() {
+        lLayout.setNodeColumn(0, -1);
+    }, [&]() { lLayout.draw(); }, rCtx);
+}
+
+void benchTreeMap(size_t aLeaves, const ChartBenchContext& rCtx) {
+    RLTreeMap lChart(BENCH_BOUNDS);
+    RLTreeNode lRoots[2];
+    uint32_t lSeed = 5u;
+    for (int r = 0; r < 2; r++) {
+        lRoots[r].mLabel = "Root";
+        for (size_t g = 0; g * 16 < aLeaves; g++) {
+            RLTreeNode lGroup;
+            lGroup.mLabel = "G" + std::to_string(g);
+            for (size_t i = g * 16; i < aLeaves && i < (g + 1) * 16; i++) {
+                RLTreeNode lLeaf;
+                lLeaf.mLabel = "L" + std::to_string(i);
+                lLeaf.mValue = 1.0f + nextRandom(lSeed) * 99.0f;
+                lGroup.mChildren.push_back(lLeaf);
+            }
+            lRoots[r].mChildren.push_back(lGroup);
+        }
+    }
+    lChart.setData(lRoots[0]);
+    size_t lPhase = 0;
+    benchChart("treemap", aLeaves, aLeaves, lChart, [&]() {
+        lChart.setTargetData(lRoots[lPhase++ & 1]);
+    }, [&]() { lChart.draw(); }, rCtx);
+
+    // One leaf per frame through updateValue (incremental re-layout)
+    std::vector<std::string> lPath(2);
+    benchChart("treemap_update", aLeaves, 1, lChart, [&]() {
+        const size_t lLeaf = (size_t)(nextRandom(lSeed) * (float)(aLeaves - 1));
+        lPath[0] = "G" + std::to_string(lLeaf / 16);
+        lPath[1] = "L" + std::to_string(lLeaf);
+        lChart.updateValue(lPath, 1.0f + nextRandom(lSeed) * 99.0f);
+    }, [&]() { lChart.draw(); }, rCtx);
+
+    // Flat input with an unchanged structure: only values are read
+    RLTreeFlatData lFlat = lChart.getData();
+    benchChart("treemap_flat", aLeaves, aLeaves, lChart, [&]() {
+        for (float& rValue : lFlat.mValue) {
+            rValue = 1.0f + nextRandom(lSeed) * 99.0f;
+        }
+        lChart.setTargetData(lFlat);
+    }, [&]() { lChart.draw(); }, rCtx);
+}
+
+// aGravity runs the packing simulation (collision passes on every hardware thread)
+void benchBubble(size_t aCount, bool aGravity, const ChartBenchContext& rCtx) {
+    RLBubbleStyle lStyle;
+    lStyle.mPhysicsThreads = 0;
+    lStyle.mSizeScale = aGravity ? 2.0f : lStyle.mSizeScale;
+    lStyle.mMinRadius = aGravity ? 1.0f : lStyle.mMinRadius;
+    RLBubble lChart(BENCH_BOUNDS, aGravity ? RLBubbleMode::Gravity : RLBubbleMode::Scatter, lStyle);
+    std::vector<RLBubblePoint> lData[2];
+    uint32_t lSeed = 6u;
+    for (int d = 0; d < 2; d++) {
+        lData[d].resize(aCount);
+        for (RLBubblePoint& rP : lData[d]) {
+            rP.mX = nextRandom(lSeed);
+            rP.mY = nextRandom(lSeed);
+            rP.mSize = 1.0f + nextRandom(lSeed) * 20.0f;
+        }
+    }
+    lChart.setData(lData[0]);
+    size_t lPhase = 0;
+    benchChart(aGravity ? "bubble_gravity" : "bubble", aCount, aCount, lChart, [&]() {
+        lChart.setTargetData(lData[lPhase++ & 1]);
+    }, [&]() { lChart.draw(); }, rCtx);
+}
+
+// aDensity bins the series into a pixel-resolution grid instead of drawing markers
+void benchScatter(size_t aCount, bool aDensity, const ChartBenchContext& rCtx) {
+    RLScatterPlotStyle lStyle;
+    lStyle.mDensityThreshold = aDensity ? 1 : 0;
+    RLScatterPlot lChart(BENCH_BOUNDS, lStyle);
+    std::vector<Vector2> lData[2];
+    uint32_t lSeed = 7u;
+    for (int d = 0; d < 2; d++) {
+        lData[d].resize(aCount);
+        for (Vector2& rP : lData[d]) {
+            rP = Vector2{ nextRandom(lSeed), nextRandom(lSeed) };
+        }
+    }
+    lChart.setSingleSeries(lData[0]);
+    size_t lPhase = 0;
+    benchChart(aDensity ? "scatter_density" : "scatter", aCount, aCount, lChart, [&]() {
+        lChart.setSingleSeriesTargetData(lData[lPhase++ & 1]);
+    }, [&]() { lChart.draw(); }, rCtx);
+}
+
+void benchArea(size_t aPoints, bool aStreaming, const ChartBenchContext& rCtx) {
+    RLAreaChart lChart(BENCH_BOUNDS);
+    std::vector<RLAreaSeries> lData[2];
+    uint32_t lSeed = 8u;
+    for (int d = 0; d < 2; d++) {
+        lData[d].resize(3);
+        for (RLAreaSeries& rS : lData[d]) {
+            rS.mValues.resize(aPoints);
+            for (float& rV : rS.mValues) {
+                rV = 10.0f + nextRandom(lSeed) * 40.0f;
+            }
+        }
+    }
+    lChart.setData(lData[0]);
+    if (aStreaming) {
+        // One new column per frame into a full window
+        lChart.setStreamingWindow(aPoints);
+        float lSample[3] = {};
+        benchChart("area_stream", aPoints, aPoints * 3, lChart, [&]() {
+            for (float& rV : lSample) {
+                rV = 10.0f + nextRandom(lSeed) * 40.0f;
+            }
+            lChart.pushSample(lSample);
+        }, [&]() { lChart.draw(); }, rCtx);
+        return;
+    }
+    size_t lPhase = 0;
+    benchChart("area", aPoints, aPoints * 3, lChart, [&]() {
+        lChart.setTargetData(lData[lPhase++ & 1]);
+    }, [&]() { lChart.draw(); }, rCtx);
+}
+
+void benchBar(size_t aCount, const ChartBenchContext& rCtx) {
+    RLBarChart lChart(BENCH_BOUNDS, RLBarOrientation::VERTICAL);
+    std::vector<RLBarData> lData[2];
+    uint32_t lSeed = 9u;
+    for (int d = 0; d < 2; d++) {
+        lData[d].resize(aCount);
+        for (RLBarData& rB : lData[d]) {
+            rB.value = nextRandom(lSeed) * 100.0f;
+        }
+    }
+    lChart.setData(lData[0]);
+    size_t lPhase = 0;
+    benchChart("bar", aCount, aCount, lChart, [&]() {
+        lChart.setTargetData(lData[lPhase++ & 1]);
+    }, [&]() { lChart.draw(); }, rCtx);
+}
+
+// Histogram-sized bar chart in dense mode: flat arrays, merged sub-pixel bins, one instanced draw
+void benchBarDense(size_t aBins, const ChartBenchContext& rCtx) {
+    RLBarChart lChart(BENCH_BOUNDS, RLBarOrientation::VERTICAL);
+    std::vector<float> lData[2];
+    uint32_t lSeed = 19u;
+    for (int d = 0; d < 2; d++) {
+        lData[d].resize(aBins);
+        for (float& rV : lData[d]) {
+            rV = nextRandom(lSeed) * 100.0f;
+        }
+    }
+    lChart.setDenseData(lData[0]);
+    size_t lPhase = 0;
+    benchChart("bar_dense", aBins, aBins, lChart, [&]() {
+        lChart.setDenseTargetData(lData[lPhase++ & 1]);
+    }, [&]() { lChart.draw(); }, rCtx);
+}
+
+void benchPie(size_t aSlices, const ChartBenchContext& rCtx) {
+    RLPieChart lChart(BENCH_BOUNDS);
+    std::vector<RLPieSliceData> lData[2];
+    uint32_t lSeed = 10u;
+    for (int d = 0; d < 2; d++) {
+        lData[d].resize(aSlices);
+        for (RLPieSliceData& rS : lData[d]) {
+            rS.mValue = 1.0f + nextRandom(lSeed) * 10.0f;
+        }
+    }
+    lChart.setData(lData[0]);
+    size_t lPhase = 0;
+    benchChart("pie", aSlices, aSlices, lChart, [&]() {
+        lChart.setTargetData(lData[lPhase++ & 1]);
+    }, [&]() { lChart.draw(); }, rCtx);
+}
+
+void benchRadar(size_t aAxes, const ChartBenchContext& rCtx) {
+    RLRadarChart lChart(BENCH_BOUNDS);
+    std::vector<std::string> lLabels;
+    for (size_t i = 0; i < aAxes; i++) {
+        lLabels.push_back("A" + std::to_string(i));
+    }
+    lChart.setAxes(lLabels);
+    std::vector<float> lValues[2];
+    uint32_t lSeed = 11u;
+    for (int d = 0; d < 2; d++) {
+        lValues[d].resize(aAxes);
+        for (float& rV : lValues[d]) {
+            rV = nextRandom(lSeed) * 100.0f;
+        }
+    }
+    for (int s = 0; s < 3; s++) {
+        RLRadarSeries lSeries;
+        lSeries.mValues = lValues[0];
+        lChart.addSeries(lSeries);
+    }
+    size_t lPhase = 0;
+    benchChart("radar", aAxes, aAxes * 3, lChart, [&]() {
+        const std::vector<float>& rValues = lValues[lPhase++ & 1];
+        for (size_t s = 0; s < 3; s++) {
+            lChart.setSeriesData(s, rValues);
+        }
+    }, [&]() { lChart.draw(); }, rCtx);
+}
+
+// Server overlay: many series on a 12-axis radar, all updated per frame
+void benchRadarOverlay(size_t aSeries, const ChartBenchContext& rCtx) {
+    constexpr size_t AXES = 12;
+    RLRadarChart lChart(BENCH_BOUNDS);
+    std::vector<std::string> lLabels;
+    for (size_t i = 0; i < AXES; i++) {
+        lLabels.push_back("A" + std::to_string(i));
+    }
+    lChart.setAxes(lLabels);
+    std::vector<float> lMatrix[2];
+    uint32_t lSeed = 13u;
+    for (int d = 0; d < 2; d++) {
+        lMatrix[d].resize(aSeries * AXES);
+        for (float& rV : lMatrix[d]) {
+            rV = nextRandom(lSeed) * 100.0f;
+        }
+    }
+    for (size_t s = 0; s < aSeries; s++) {
+        RLRadarSeries lSeries;
+        lSeries.mShowMarkers = false;
+        lChart.addSeries(lSeries);
+    }
+    size_t lPhase = 0;
+    benchChart("radar_overlay", aSeries, aSeries * AXES, lChart, [&]() {
+        lChart.setAllSeriesData(lMatrix[lPhase++ & 1], aSeries);
+    }, [&]() { lChart.draw(); }, rCtx);
+}
+
+void benchLogPlot(size_t aWindow, const ChartBenchContext& rCtx) {
+    RLLogPlot lChart(BENCH_BOUNDS);
+    lChart.setWindowSize(aWindow);
+    std::vector<float> lBlock(256);
+    uint32_t lSeed = 12u;
+    for (float& rV : lBlock) {
+        rV = nextRandom(lSeed);
+    }
+    for (size_t i = 0; i < aWindow; i += lBlock.size()) {
+        lChart.pushSamples(std::span<const float>(lBlock));
+    }
+    benchChart("logplot", aWindow, lBlock.size(), lChart, [&]() {
+        lChart.pushSamples(std::span<const float>(lBlock));
+    }, [&]() { lChart.draw(); }, rCtx);
+}
+
+void benchCandlestick(size_t aVisible, bool aBatched, const ChartBenchContext& rCtx) {
+    RLCandleStyle lStyle;
+    lStyle.mBatchGeometry = aBatched;
+    RLCandlestickChart lChart(BENCH_BOUNDS, 1, (int)aVisible, lStyle);
+    RLCandlestickChart::CandleInput lSample;
+    lSample.aVolume = 1000.0f;
+    lSample.aDate = "2024-01-15 09:30:00";
+    uint32_t lSeed = 13u;
+    float lPrice = 100.0f;
+    auto lPush = [&]() {
+        const float lNext = lPrice + (nextRandom(lSeed) - 0.5f);
+        lSample.aOpen = lPrice;
+        lSample.aClose = lNext;
+        lSample.aHigh = (lPrice > lNext ? lPrice : lNext) + 0.2f;
+        lSample.aLow = (lPrice < lNext ? lPrice : lNext) - 0.2f;
+        lPrice = lNext;
+        lChart.addSample(lSample);
+    };
+    for (size_t i = 0; i < aVisible; i++) {
+        lPush();
+    }
+    benchChart(aBatched ? "candlestick_batched" : "candlestick", aVisible, 16, lChart, [&]() {
+        for (int i = 0; i < 16; i++) {
+            lPush();
+        }
+    }, [&]() { lChart.draw(); }, rCtx);
+}
+
+void benchGauge(const ChartBenchContext& rCtx) {
+    RLGauge lChart(BENCH_BOUNDS, 0.0f, 100.0f);
+    size_t lPhase = 0;
+    benchChart("gauge", 1, 1, lChart, [&]() {
+        lChart.setTargetValue((lPhase++ & 1) ? 80.0f : 20.0f);
+    }, [&]() { lChart.draw(); }, rCtx);
+}
+
+// aCount small gauges drawn one by one or through a GaugePanel
+struct GaugeWall {
+    std::vector<RLGauge> mGauges;
+    void update(float aDt) {
+        for (RLGauge& rGauge : mGauges) {
+            rGauge.update(aDt);
+        }
+    }
+};
+
+void benchGaugeWall(size_t aCount, bool aPanel, const ChartBenchContext& rCtx) {
+    GaugeWall lWall;
+    const int lColumns = (int)ceilf(sqrtf((float)aCount));
+    const float lSize = BENCH_BOUNDS.width / (float)lColumns;
+    for (size_t i = 0; i < aCount; i++) {
+        const float lX = (float)((int)i % lColumns) * lSize;
+        const float lY = (float)((int)i / lColumns) * lSize;
+        lWall.mGauges.emplace_back(Rectangle{ lX, lY, lSize, lSize }, 0.0f, 100.0f);
+    }
+    RLCharts::GaugePanel lPanel;
+    auto lDrawPanel = [&]() {
+        lPanel.begin();
+        for (const RLGauge& rGauge : lWall.mGauges) {
+            lPanel.add(rGauge);
+        }
+        lPanel.end();
+    };
+    if (aPanel && rCtx.mDraw && rCtx.mTarget.id != 0) {
+        // Bake the face outside the timed texture mode
+        lDrawPanel();
+    }
+    size_t lPhase = 0;
+    benchChart(aPanel ? "gauge_panel" : "gauge_wall", aCount, aCount, lWall, [&]() {
+        const float lTarget = (lPhase++ & 1) ? 80.0f : 20.0f;
+        for (RLGauge& rGauge : lWall.mGauges) {
+            rGauge.setTargetValue(lTarget);
+        }
+    }, [&]() {
+        if (aPanel) {
+            lDrawPanel();
+        } else {
+            for (const RLGauge& rGauge : lWall.mGauges) {
+                rGauge.draw();
+            }
+        }
+    }, rCtx);
+}
+
+void benchLinearGauge(size_t aChannels, const ChartBenchContext& rCtx) {
+    RLLinearGauge lChart(BENCH_BOUNDS, 0.0f, 1.0f, RLLinearGaugeOrientation::VERTICAL);
+    lChart.setMode(RLLinearGaugeMode::VU_METER);
+    lChart.setChannels(std::vector<RLVuMeterChannel>(aChannels));
+    std::vector<float> lLevels[2];
+    uint32_t lSeed = 14u;
+    for (int d = 0; d < 2; d++) {
+        lLevels[d].resize(aChannels);
+        for (float& rV : lLevels[d]) {
+            rV = nextRandom(lSeed);
+        }
+    }
+    size_t lPhase = 0;
+    benchChart("vumeter", aChannels, aChannels, lChart, [&]() {
+        lChart.setChannelValues(lLevels[lPhase++ & 1]);
+    }, [&]() { lChart.draw(); }, rCtx);
+}
+
+void runChartBenchmarks(bool aQuick, bool aDraw, double aMinSeconds) {
+    ChartBenchContext lCtx;
+    lCtx.mDraw = aDraw;
+    lCtx.mMinSeconds = aMinSeconds;
+    if (aDraw) {
+        lCtx.mTarget = LoadRenderTexture(TARGET_WIDTH, TARGET_HEIGHT);
+    }
+
+    // --quick keeps the two smallest sizes of every chart
+    const size_t lSizeCount = aQuick ? 2 : 3;
+    const size_t lStreamSizes[] = { 1000, 10000, 100000 };
+    const size_t lGridSides[] = { 128, 512, 1024 };
+    const size_t lSurfaceSides[] = { 64, 256, 512 };
+    const size_t lLevels[] = { 64, 256, 1024 };
+    const size_t lItems[] = { 64, 512, 4096 };
+    const size_t lSmall[] = { 8, 32, 128 };
+
+    for (size_t i = 0; i < lSizeCount; i++) {
+        benchTimeSeries(lStreamSizes[i], lCtx);
+        benchLogPlot(lStreamSizes[i], lCtx);
+        benchScatter(lStreamSizes[i], false, lCtx);
+        benchScatter(lStreamSizes[i] * 10, true, lCtx);
+        benchHeatMap(lGridSides[i], lCtx);
+        benchHeatMap3D(lSurfaceSides[i], lCtx);
+        benchOrderBook(lLevels[i], lCtx);
+        benchCandlestick(lLevels[i], false, lCtx);
+        benchCandlestick(lLevels[i], true, lCtx);
+        benchSankey(lItems[i], lCtx);
+        benchTreeMap(lItems[i], lCtx);
+        benchBubble(lItems[i], false, lCtx);
+        benchBubble(lItems[i] * 5, true, lCtx);
+        benchArea(lItems[i], false, lCtx);
+        benchArea(lItems[i], true, lCtx);
+        benchBar(lItems[i] / 4, lCtx);
+        benchBarDense(lStreamSizes[i], lCtx);
+        benchPie(lSmall[i], lCtx);
+        benchRadar(lSmall[i], lCtx);
+        benchRadarOverlay(lSmall[i] * 2, lCtx);
+        benchLinearGauge(lSmall[i] / 4, lCtx);
+    }
+    benchGauge(lCtx);
+    benchGaugeWall(512, false, lCtx);
+    benchGaugeWall(512, true, lCtx);
+
+    if (lCtx.mTarget.id != 0) {
+        UnloadRenderTexture(lCtx.mTarget);
+    }
+}
@@ -0,0 +1,141 @@
+// bench_main.cpp
+// Micro-benchmarks for the charts' CPU hot paths.
+// Output is CSV on stdout: benchmark,size,threads,ns_per_op,ns_per_item,allocs_per_op
+
+#include "bench_util.h"
+#include "RLOffscreen.h"
+#include "RLSimd.h"
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <thread>
+#include <vector>
+
+std::atomic<size_t> gAllocCount{ 0 };
+
+// Count every heap allocation so the CSV can report allocs_per_op
+void* operator new(size_t aSize) {
+    gAllocCount.fetch_add(1, std::memory_order_relaxed);
+    void* lpMem = std::malloc(aSize > 0 ? aSize : 1);
+    if (lpMem == nullptr) {
+        throw std::bad_alloc();
+    }
+    return lpMem;
+}
+
+void operator delete(void* pMem) noexcept {
+    std::free(pMem);
+}
+
+void operator delete(void* pMem, size_t aSize) noexcept {
+    (void)aSize;
+    std::free(pMem);
+}
+
+// Same row-band split RLHeatMap::updateTexturePixels uses
+void colorizeThreaded(const float* pValues, uint32_t* pOut, size_t aCount, float aInvMax,
+                      const uint32_t* pLut, size_t aThreads) {
+    const size_t lBand = (aCount + aThreads - 1) / aThreads;
+    std::vector<std::thread> lWorkers;
+    size_t lStart = 0;
+    for (size_t t = 0; t + 1 < aThreads && lStart + lBand < aCount; ++t) {
+        lWorkers.emplace_back(RLCharts::colorizeLut, pValues + lStart, pOut + lStart, lBand, aInvMax, pLut);
+        lStart += lBand;
+    }
+    RLCharts::colorizeLut(pValues + lStart, pOut + lStart, aCount - lStart, aInvMax, pLut);
+    for (std::thread& rWorker : lWorkers) {
+        rWorker.join();
+    }
+}
+
+void benchHeatMapColorize(size_t aSide, double aMinSeconds) {
+    const size_t lCells = aSide * aSide;
+    std::vector<float> lCounts(lCells);
+    std::vector<uint32_t> lPixels(lCells);
+    uint32_t lLut[256];
+    for (uint32_t i = 0; i < 256; i++) {
+        lLut[i] = 0xFF000000u | (i << 16) | ((255u - i) << 8);
+    }
+    // Clustered distribution similar to accumulated event counts
+    uint32_t lSeed = 1u;
+    for (float& rV : lCounts) {
+        lSeed = lSeed * 1664525u + 1013904223u;
+        rV = (float)((lSeed >> 16) % 97u) * (float)((lSeed >> 8) & 3u);
+    }
+    const float lInvMax = 1.0f / 288.0f;
+
+    printResult("heatmap_colorize_scalar", lCells, 1, runTimed([&]() {
+        RLCharts::colorizeLutScalar(lCounts.data(), lPixels.data(), lCells, lInvMax, lLut);
+    }, lCells, aMinSeconds));
+
+    printResult("heatmap_colorize_simd", lCells, 1, runTimed([&]() {
+        RLCharts::colorizeLut(lCounts.data(), lPixels.data(), lCells, lInvMax, lLut);
+    }, lCells, aMinSeconds));
+
+    const size_t lThreads = std::thread::hardware_concurrency() > 1 ? std::thread::hardware_concurrency() : 2;
+    printResult("heatmap_colorize_simd_threaded", lCells, lThreads, runTimed([&]() {
+        colorizeThreaded(lCounts.data(), lPixels.data(), lCells, lInvMax, lLut, lThreads);
+    }, lCells, aMinSeconds));
+}
+
+void benchHeatMapBinCells(size_t aPoints, double aMinSeconds) {
+    std::vector<float> lXY(aPoints * 2);
+    std::vector<int32_t> lCells(aPoints);
+    uint32_t lSeed = 5u;
+    for (float& rV : lXY) {
+        lSeed = lSeed * 1664525u + 1013904223u;
+        rV = (float)(lSeed >> 8) * (2.2f / 16777216.0f) - 1.1f;
+    }
+
+    printResult("heatmap_bin_cells_scalar", aPoints, 1, runTimed([&]() {
+        int32_t lBounds[4] = { INT32_MAX, INT32_MAX, -1, -1 };
+        RLCharts::normalizedToCellsScalar(lXY.data(), aPoints, 1024, 768, lCells.data(), lBounds);
+    }, aPoints, aMinSeconds));
+
+    printResult("heatmap_bin_cells_simd", aPoints, 1, runTimed([&]() {
+        int32_t lBounds[4] = { INT32_MAX, INT32_MAX, -1, -1 };
+        RLCharts::normalizedToCells(lXY.data(), aPoints, 1024, 768, lCells.data(), lBounds);
+    }, aPoints, aMinSeconds));
+}
+
+int main(int aArgc, char** apArgv) {
+    // --quick shortens every measurement (smoke run in CI)
+    // --no-charts runs only the kernel benchmarks (no GL context needed)
+    // --no-draw skips the draw() rows of the chart benchmarks
+    double lMinSeconds = 0.25;
+    bool lQuick = false;
+    bool lCharts = true;
+    bool lDraw = true;
+    for (int i = 1; i < aArgc; i++) {
+        if (std::strcmp(apArgv[i], "--quick") == 0) {
+            lMinSeconds = 0.01;
+            lQuick = true;
+        } else if (std::strcmp(apArgv[i], "--no-charts") == 0) {
+            lCharts = false;
+        } else if (std::strcmp(apArgv[i], "--no-draw") == 0) {
+            lDraw = false;
+        }
+    }
+
+    std::fprintf(stderr, "cpp-charts bench (simd: %s)\n", RLCharts::simdName());
+    std::printf("benchmark,size,threads,ns_per_op,ns_per_item,allocs_per_op\n");
+
+    for (const size_t lSide : { (size_t)256, (size_t)1024, (size_t)2048 }) {
+        benchHeatMapColorize(lSide, lMinSeconds);
+    }
+    benchHeatMapBinCells(1 << 16, lMinSeconds);
+
+    if (lCharts) {
+        // Charts upload textures and meshes from update(), so they all need a context
+        SetTraceLogLevel(LOG_WARNING);
+        if (RLCharts::initHeadlessContext(320, 240)) {
+            runChartBenchmarks(lQuick, lDraw, lMinSeconds);
+            RLCharts::closeHeadlessContext();
+        } else {
+            std::fprintf(stderr, "no GL context, chart benchmarks skipped\n");
+        }
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,48 @@
+// bench_util.h
+// Timing and CSV helpers shared by the benchmark translation units.
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+
+// Counted by the global operator new replacement in bench_main.cpp
+extern std::atomic<size_t> gAllocCount;
+
+struct BenchResult {
+    double mNsPerOp{ 0.0 };
+    double mNsPerItem{ 0.0 };
+    double mAllocsPerOp{ 0.0 };
+};
+
+// Run aFn until at least aMinSeconds have passed, return the average time and
+// heap allocation count per call
+template<typename Fn>
+BenchResult runTimed(Fn&& rFn, size_t aItems, double aMinSeconds) {
+    rFn(); // warm-up (page faults, caches)
+    size_t lIterations = 0;
+    const size_t lAllocsBefore = gAllocCount.load(std::memory_order_relaxed);
+    const auto lStart = std::chrono::steady_clock::now();
+    double lElapsed = 0.0;
+    do {
+        rFn();
+        lIterations++;
+        lElapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - lStart).count();
+    } while (lElapsed < aMinSeconds);
+    const size_t lAllocs = gAllocCount.load(std::memory_order_relaxed) - lAllocsBefore;
+
+    BenchResult lResult;
+    lResult.mNsPerOp = lElapsed * 1e9 / (double)lIterations;
+    lResult.mNsPerItem = lResult.mNsPerOp / (double)(aItems > 0 ? aItems : 1);
+    lResult.mAllocsPerOp = (double)lAllocs / (double)lIterations;
+    return lResult;
+}
+
+inline void printResult(const char* pName, size_t aSize, size_t aThreads, const BenchResult& rResult) {
+    std::printf("%s,%zu,%zu,%.1f,%.3f,%.2f\n", pName, aSize, aThreads, rResult.mNsPerOp, rResult.mNsPerItem,
+                rResult.mAllocsPerOp);
+}
+
+// Per-chart benchmarks (bench_charts.cpp). aDraw enables the draw() rows, which
+// need a GL context (hidden window) and render into an offscreen target.
+void runChartBenchmarks(bool aQuick, bool aDraw, double aMinSeconds);
@@ -5,6 +5,7 @@
 #include "src/charts/RLBarChart.h"
 #include "src/charts/RLBubble.h"
 #include "src/charts/RLCandlestickChart.h"
+#include "src/charts/RLDashboard.h"
 #include "src/charts/RLGauge.h"
 #include "src/charts/RLHeatMap.h"
 #include "src/charts/RLHeatMap3D.h"
@@ -17,10 +18,16 @@
 #include "src/charts/RLScatterPlot.h"
 #include "src/charts/RLTimeSeries.h"
 #include "src/charts/RLTreeMap.h"
+#include "src/RLFrameArena.h"
+#include "src/RLSimd.h"
 #include <vector>
 #include <cstdlib>
 #include <ctime>
 #include <cmath>
+#include <cstdio>
+#if defined(__EMSCRIPTEN__)
+#include <emscripten.h>
+#endif
 
 // Helper to generate random float in range
 float randFloat(float aMin, float aMax) {
@@ -580,6 +587,49 @@ int main() {
     };
     lVuMeter.setChannels(lVuChannels);
 
+    // All charts update in parallel; GPU uploads and drawing stay on this thread
+    RLDashboard lDashboard;
+    lDashboard.add(lBarChart);
+    lDashboard.add(lBubble);
+    lDashboard.add(lCandlestick);
+    lDashboard.add(lGauge);
+    lDashboard.add(lHeatMap);
+    lDashboard.add(lPieChart);
+    lDashboard.add(lScatterPlot);
+    lDashboard.add(lBarChart2);
+    lDashboard.add(lOrderBook, [&]() { lOrderBook.draw2D(); });
+    lDashboard.add(lTreeMap);
+    lDashboard.add(lTimeSeries);
+    lDashboard.add(lLogPlot);
+    lDashboard.add(lAreaChart);
+    lDashboard.add(lRadarChart);
+    lDashboard.add(lSankey);
+    lDashboard.add(lLinearGauge);
+    lDashboard.add(lVuMeter);
+    lDashboard.add(lHeatMap3D, [&]() {
+        // Render 3D heat map to texture, then draw it flipped (render textures are inverted)
+        BeginTextureMode(lHeatMap3DRT);
+        ClearBackground(Color{25, 28, 35, 255});
+        BeginMode3D(lHeatMap3DCamera);
+        lHeatMap3D.draw(Vector3{0.0f, 0.0f, 0.0f}, 1.0f, lHeatMap3DCamera);
+        EndMode3D();
+        EndTextureMode();
+        DrawTextureRec(lHeatMap3DRT.texture,
+                       Rectangle{0, 0, (float)lHeatMap3DRT.texture.width, -(float)lHeatMap3DRT.texture.height},
+                       Vector2{lHeatMap3DBounds.x, lHeatMap3DBounds.y}, WHITE);
+    });
+
+    // Frame timing: CPU time of update + draw (before EndDrawing() waits for vsync),
+    // averaged over REPORT_FRAMES frames. In the web build each average is also
+    // posted to the embedding page (wasm/perf.html compares builds with it).
+    const int REPORT_FRAMES = 120;
+    double lWorkMsSum = 0.0;
+    double lFrameMsSum = 0.0;
+    int lReportFrames = 0;
+    float lWorkMs = 0.0f;
+    float lFrameMs = 0.0f;
+    char lTimingText[128] = "";
+
     // Animation variables
     float lTime = 0.0f;
     float lGaugeTargetValue = 65.0f;
@@ -587,6 +637,8 @@ int main() {
 
     // Main loop
     while (!WindowShouldClose()) {
+        const double lFrameStart = GetTime();
+        RLCharts::beginFrame();
         float lDt = GetFrameTime();
         lTime += lDt;
 
@@ -621,25 +673,6 @@ int main() {
             lMidPrice += randFloat(-0.02f, 0.02f);
         }
 
-        // Update all charts
-        lBarChart.update(lDt);
-        lBubble.update(lDt);
-        lCandlestick.update(lDt);
-        lGauge.update(lDt);
-        lHeatMap.update(lDt);
-        lPieChart.update(lDt);
-        lScatterPlot.update(lDt);
-        lBarChart2.update(lDt);
-        lOrderBook.update(lDt);
-        lTreeMap.update(lDt);
-        lTimeSeries.update(lDt);
-        lLogPlot.update(lDt);
-        lAreaChart.update(lDt);
-        lRadarChart.update(lDt);
-        lSankey.update(lDt);
-        lLinearGauge.update(lDt);
-        lVuMeter.update(lDt);
-
         // Update 3D heat map with animated data
         lHeatMap3DRotation += lDt * 0.5f;
         for (int lY = 0; lY < 24; ++lY) {
@@ -652,7 +685,6 @@ int main() {
             }
         }
         lHeatMap3D.setValues(24, 24, lHeatMap3DValues);
-        lHeatMap3D.update(lDt);
 
         // Update 3D camera rotation for heat map (orbit around the plot)
         float lCamDist = 2.5f;
@@ -665,45 +697,19 @@ int main() {
         lTimeSeries.pushSample(lTSTrace1, 0.5f * sinf(lTSTime * 2.0f) + randFloat(-0.05f, 0.05f));
         lTimeSeries.pushSample(lTSTrace2, 0.4f * cosf(lTSTime * 1.5f) + randFloat(-0.05f, 0.05f));
 
+        // Update all charts
+        lDashboard.update(lDt);
+
         // Draw
         BeginDrawing();
         ClearBackground(Color{15, 17, 20, 255});
 
-        // Render 3D heat map to texture
-        BeginTextureMode(lHeatMap3DRT);
-        ClearBackground(Color{25, 28, 35, 255});
-        BeginMode3D(lHeatMap3DCamera);
-        lHeatMap3D.draw(Vector3{0.0f, 0.0f, 0.0f}, 1.0f, lHeatMap3DCamera);
-        EndMode3D();
-        EndTextureMode();
-
         // Draw title
         DrawText("RayLib Charts - All Chart Types (Testing Static Conflicts)",
                  10, 5, 20, Color{200, 200, 210, 255});
 
         // Draw all charts
-        lBarChart.draw();
-        lBubble.draw();
-        lCandlestick.draw();
-        lGauge.draw();
-        lHeatMap.draw();
-        lPieChart.draw();
-        lScatterPlot.draw();
-        lBarChart2.draw();
-        lOrderBook.draw2D();
-        lTreeMap.draw();
-        lTimeSeries.draw();
-        lLogPlot.draw();
-        lAreaChart.draw();
-        lRadarChart.draw();
-        lSankey.draw();
-        lLinearGauge.draw();
-        lVuMeter.draw();
-
-        // Draw 3D heat map render texture (flipped vertically because render textures are inverted)
-        DrawTextureRec(lHeatMap3DRT.texture,
-                       Rectangle{0, 0, (float)lHeatMap3DRT.texture.width, -(float)lHeatMap3DRT.texture.height},
-                       Vector2{lHeatMap3DBounds.x, lHeatMap3DBounds.y}, WHITE);
+        lDashboard.draw();
 
         // Draw labels for each chart (5x4 grid, 18 charts)
         const char* lLabels[] = {
@@ -725,6 +731,27 @@ int main() {
         }
 
         DrawFPS(SCREEN_WIDTH - 100, 5);
+        DrawText(lTimingText, SCREEN_WIDTH - 520, 5, 20, Color{200, 200, 210, 255});
+
+        lWorkMsSum += (GetTime() - lFrameStart) * 1000.0;
+        lFrameMsSum += lDt * 1000.0;
+        if (++lReportFrames == REPORT_FRAMES) {
+            lWorkMs = (float)(lWorkMsSum / REPORT_FRAMES);
+            lFrameMs = (float)(lFrameMsSum / REPORT_FRAMES);
+            snprintf(lTimingText, sizeof(lTimingText), "%s, %zu threads: %.2f ms work / %.2f ms frame",
+                     RLCharts::simdName(), lDashboard.getThreadCount(), lWorkMs, lFrameMs);
+#if defined(__EMSCRIPTEN__)
+            EM_ASM({
+                if (window.parent !== window) {
+                    window.parent.postMessage({ cppChartsTiming: true, simd: UTF8ToString($0), threads: $1,
+                                                workMs: $2, frameMs: $3 }, "*");
+                }
+            }, RLCharts::simdName(), (int)lDashboard.getThreadCount(), lWorkMs, lFrameMs);
+#endif
+            lWorkMsSum = 0.0;
+            lFrameMsSum = 0.0;
+            lReportFrames = 0;
+        }
 
         EndDrawing();
     }
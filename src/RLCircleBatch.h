@@ -0,0 +1,326 @@
+// RLCircleBatch.h
+#pragma once
+#include "raylib.h"
+#include "rlgl.h"
+#include "raymath.h"
+#include "RLGpuStaging.h"
+#include "RLLineBatch.h"
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Instanced circle renderer for markers and bubbles.
+// Every circle is one instance of a shared unit quad; a signed-distance fragment
+// shader turns the quad into an anti-aliased disc with an optional outline ring,
+// so any number of circles costs one upload and one instanced draw call instead
+// of a tessellated triangle fan each. The instance buffers are uploaded only
+// after the circles changed and grow in powers of two.
+//
+// Instancing needs desktop OpenGL 3.3; on GLES/WebGL (or if the shader fails to
+// compile) draw() falls back to triangle fans through a LineBatch, with the same
+// placement. GPU resources are created on the first draw() and owned by the batch:
+// a copy only takes the circles and creates its own resources when drawn.
+
+namespace RLCharts {
+
+class CircleBatch {
+public:
+    CircleBatch() = default;
+    ~CircleBatch() { unload(); }
+
+    CircleBatch(const CircleBatch& rOther) : mCircles(rOther.mCircles), mFills(rOther.mFills),
+                                             mStrokes(rOther.mStrokes), mInstancing(rOther.mInstancing) {}
+    CircleBatch& operator=(const CircleBatch& rOther) {
+        if (this != &rOther) {
+            mCircles = rOther.mCircles;
+            mFills = rOther.mFills;
+            mStrokes = rOther.mStrokes;
+            mInstancing = rOther.mInstancing;
+            mDirty = true;
+        }
+        return *this;
+    }
+    CircleBatch(CircleBatch&& rOther) noexcept { swapWith(rOther); }
+    CircleBatch& operator=(CircleBatch&& rOther) noexcept {
+        if (this != &rOther) {
+            unload();
+            swapWith(rOther);
+        }
+        return *this;
+    }
+
+    void clear() {
+        mCircles.clear();
+        mFills.clear();
+        mStrokes.clear();
+        mDirty = true;
+    }
+    [[nodiscard]] bool empty() const { return mFills.empty(); }
+    [[nodiscard]] size_t size() const { return mFills.size(); }
+
+    // Filled disc of aRadius pixels
+    void add(Vector2 aCenter, float aRadius, Color aFill) { add(aCenter, aRadius, aFill, 0.0f, BLANK); }
+    // Disc with a ring of aOutline pixels around it (outside aRadius)
+    void add(Vector2 aCenter, float aRadius, Color aFill, float aOutline, Color aOutlineColor) {
+        if (aRadius <= 0.0f) {
+            return;
+        }
+        mCircles.push_back(aCenter.x);
+        mCircles.push_back(aCenter.y);
+        mCircles.push_back(aRadius);
+        mCircles.push_back(aOutline > 0.0f ? aOutline : 0.0f);
+        mFills.push_back(aFill);
+        mStrokes.push_back(aOutlineColor);
+        mDirty = true;
+    }
+
+    // Instanced path on/off (on by default; off always uses triangle fans)
+    void setInstancing(bool aEnabled) {
+        mInstancing = aEnabled;
+        mDirty = true;
+    }
+    [[nodiscard]] bool isInstancingEnabled() const { return mInstancing; }
+    // Whether the last draw() went through the instanced shader
+    [[nodiscard]] bool wasInstanced() const { return mReady && mInstancing; }
+
+    void draw() const {
+        if (mFills.empty()) {
+            return;
+        }
+        if (mInstancing && ensureResources()) {
+            drawInstanced();
+            return;
+        }
+        if (mDirty) {
+            mFallback.clear();
+            for (size_t i = 0; i < mFills.size(); ++i) {
+                const Vector2 lCenter{ mCircles[i * 4], mCircles[i * 4 + 1] };
+                const float lRadius = mCircles[i * 4 + 2];
+                const float lOutline = mCircles[i * 4 + 3];
+                if (lOutline > 0.0f && mStrokes[i].a > 0) {
+                    mFallback.addCircleOutline(lCenter, lRadius + lOutline * 0.5f, lOutline, mStrokes[i]);
+                }
+                mFallback.addCircle(lCenter, lRadius, mFills[i]);
+            }
+            mDirty = false;
+        }
+        mFallback.draw();
+    }
+
+    // Release the GPU resources (needs the GL context; done by the destructor)
+    void unload() {
+        if (mShader.id != 0) {
+            UnloadShader(mShader);
+        }
+        mShader = Shader{};
+        releaseBuffers();
+        mReady = false;
+        mFailed = false;
+        mDirty = true;
+    }
+
+private:
+    // Quad corners in [-1, 1]; the shader scales them to radius + outline + AA margin
+    static constexpr float QUAD[12] = { -1.0f, -1.0f, 1.0f, -1.0f, 1.0f, 1.0f,
+                                        -1.0f, -1.0f, 1.0f, 1.0f, -1.0f, 1.0f };
+
+    void swapWith(CircleBatch& rOther) {
+        std::swap(mCircles, rOther.mCircles);
+        std::swap(mFills, rOther.mFills);
+        std::swap(mStrokes, rOther.mStrokes);
+        std::swap(mFallback, rOther.mFallback);
+        std::swap(mInstancing, rOther.mInstancing);
+        std::swap(mDirty, rOther.mDirty);
+        std::swap(mReady, rOther.mReady);
+        std::swap(mFailed, rOther.mFailed);
+        std::swap(mShader, rOther.mShader);
+        std::swap(mLocMvp, rOther.mLocMvp);
+        std::swap(mLocPosition, rOther.mLocPosition);
+        std::swap(mLocCircle, rOther.mLocCircle);
+        std::swap(mLocFill, rOther.mLocFill);
+        std::swap(mLocStroke, rOther.mLocStroke);
+        std::swap(mVao, rOther.mVao);
+        std::swap(mQuadVbo, rOther.mQuadVbo);
+        std::swap(mCircleVbo, rOther.mCircleVbo);
+        std::swap(mFillVbo, rOther.mFillVbo);
+        std::swap(mStrokeVbo, rOther.mStrokeVbo);
+        std::swap(mCapacity, rOther.mCapacity);
+    }
+
+    void releaseBuffers() const {
+        if (mVao != 0) {
+            rlUnloadVertexArray(mVao);
+        }
+        const unsigned int lBuffers[] = { mQuadVbo, mCircleVbo, mFillVbo, mStrokeVbo };
+        for (const unsigned int lVbo : lBuffers) {
+            if (lVbo != 0) {
+                rlUnloadVertexBuffer(lVbo);
+            }
+        }
+        mVao = 0;
+        mQuadVbo = 0;
+        mCircleVbo = 0;
+        mFillVbo = 0;
+        mStrokeVbo = 0;
+        mCapacity = 0;
+    }
+
+    [[nodiscard]] bool ensureResources() const {
+        if (mFailed) {
+            return false;
+        }
+        if (!mReady) {
+            // GLSL 330: desktop GL only
+            const int lVersion = rlGetVersion();
+            if (lVersion != RL_OPENGL_33 && lVersion != RL_OPENGL_43) {
+                mFailed = true;
+                return false;
+            }
+            const char* pVertex =
+                "#version 330\n"
+                "in vec2 vertexPosition;\n"
+                "in vec4 instanceCircle;\n" // center, radius, outline
+                "in vec4 instanceFill;\n"
+                "in vec4 instanceStroke;\n"
+                "uniform mat4 mvp;\n"
+                "out vec2 fragLocal;\n"
+                "out vec2 fragShape;\n"
+                "out vec4 fragFill;\n"
+                "out vec4 fragStroke;\n"
+                "void main() {\n"
+                "    float extent = instanceCircle.z + instanceCircle.w + 1.0;\n"
+                "    fragLocal = vertexPosition * extent;\n"
+                "    fragShape = instanceCircle.zw;\n"
+                "    fragFill = instanceFill;\n"
+                "    fragStroke = instanceStroke;\n"
+                "    gl_Position = mvp * vec4(instanceCircle.xy + fragLocal, 0.0, 1.0);\n"
+                "}\n";
+            const char* pFragment =
+                "#version 330\n"
+                "in vec2 fragLocal;\n"
+                "in vec2 fragShape;\n"
+                "in vec4 fragFill;\n"
+                "in vec4 fragStroke;\n"
+                "out vec4 finalColor;\n"
+                "void main() {\n"
+                "    float d = length(fragLocal);\n"
+                "    float aa = max(fwidth(d), 1e-4) * 0.5;\n"
+                "    float outer = fragShape.x + fragShape.y;\n"
+                "    float shape = 1.0 - smoothstep(outer - aa, outer + aa, d);\n"
+                "    float fill = fragShape.y > 0.0 ? 1.0 - smoothstep(fragShape.x - aa, fragShape.x + aa, d) : 1.0;\n"
+                "    vec4 color = mix(fragStroke, fragFill, fill);\n"
+                "    if (shape * color.a <= 0.0) discard;\n"
+                "    finalColor = vec4(color.rgb, color.a * shape);\n"
+                "}\n";
+            mShader = LoadShaderFromMemory(pVertex, pFragment);
+            if (!IsShaderValid(mShader)) {
+                mShader = Shader{};
+                mFailed = true;
+                return false;
+            }
+            mLocMvp = GetShaderLocation(mShader, "mvp");
+            mLocPosition = GetShaderLocationAttrib(mShader, "vertexPosition");
+            mLocCircle = GetShaderLocationAttrib(mShader, "instanceCircle");
+            mLocFill = GetShaderLocationAttrib(mShader, "instanceFill");
+            mLocStroke = GetShaderLocationAttrib(mShader, "instanceStroke");
+            if (mLocPosition < 0 || mLocCircle < 0 || mLocFill < 0 || mLocStroke < 0) {
+                UnloadShader(mShader);
+                mShader = Shader{};
+                mFailed = true;
+                return false;
+            }
+            mReady = true;
+            mDirty = true;
+        }
+        if (mFills.size() > mCapacity && !allocateBuffers(mFills.size())) {
+            mReady = false;
+            mFailed = true;
+            return false;
+        }
+        if (mDirty) {
+            rlUpdateVertexBuffer(mCircleVbo, mCircles.data(), (int)(mCircles.size() * sizeof(float)), 0);
+            rlUpdateVertexBuffer(mFillVbo, mFills.data(), (int)(mFills.size() * sizeof(Color)), 0);
+            rlUpdateVertexBuffer(mStrokeVbo, mStrokes.data(), (int)(mStrokes.size() * sizeof(Color)), 0);
+            countBufferUpload(mCircles.size() * sizeof(float));
+            countBufferUpload((mFills.size() + mStrokes.size()) * sizeof(Color));
+            mDirty = false;
+        }
+        return true;
+    }
+
+    // (Re)create the VAO with room for at least aCount instances
+    [[nodiscard]] bool allocateBuffers(size_t aCount) const {
+        releaseBuffers();
+        size_t lCapacity = 256;
+        while (lCapacity < aCount) {
+            lCapacity *= 2;
+        }
+        // Each rlLoadVertexBuffer leaves its buffer bound for the attribute setup after it
+        mVao = rlLoadVertexArray();
+        rlEnableVertexArray(mVao);
+        mQuadVbo = rlLoadVertexBuffer(QUAD, (int)sizeof(QUAD), false);
+        rlSetVertexAttribute((unsigned int)mLocPosition, 2, RL_FLOAT, false, 0, 0);
+        rlEnableVertexAttribute((unsigned int)mLocPosition);
+        mCircleVbo = rlLoadVertexBuffer(nullptr, (int)(lCapacity * 4 * sizeof(float)), true);
+        rlSetVertexAttribute((unsigned int)mLocCircle, 4, RL_FLOAT, false, 0, 0);
+        rlEnableVertexAttribute((unsigned int)mLocCircle);
+        rlSetVertexAttributeDivisor((unsigned int)mLocCircle, 1);
+        mFillVbo = rlLoadVertexBuffer(nullptr, (int)(lCapacity * sizeof(Color)), true);
+        rlSetVertexAttribute((unsigned int)mLocFill, 4, RL_UNSIGNED_BYTE, true, 0, 0);
+        rlEnableVertexAttribute((unsigned int)mLocFill);
+        rlSetVertexAttributeDivisor((unsigned int)mLocFill, 1);
+        mStrokeVbo = rlLoadVertexBuffer(nullptr, (int)(lCapacity * sizeof(Color)), true);
+        rlSetVertexAttribute((unsigned int)mLocStroke, 4, RL_UNSIGNED_BYTE, true, 0, 0);
+        rlEnableVertexAttribute((unsigned int)mLocStroke);
+        rlSetVertexAttributeDivisor((unsigned int)mLocStroke, 1);
+        rlDisableVertexArray();
+
+        if (mVao == 0 || mQuadVbo == 0 || mCircleVbo == 0 || mFillVbo == 0 || mStrokeVbo == 0) {
+            releaseBuffers();
+            return false;
+        }
+        mCapacity = lCapacity;
+        mDirty = true;
+        return true;
+    }
+
+    void drawInstanced() const {
+        // Flush whatever rlgl batched so far so the circles keep their place in the draw order
+        rlDrawRenderBatchActive();
+        rlDisableBackfaceCulling();
+        const Matrix lMvp = MatrixMultiply(MatrixMultiply(rlGetMatrixTransform(), rlGetMatrixModelview()),
+                                           rlGetMatrixProjection());
+        rlEnableShader(mShader.id);
+        rlSetUniformMatrix(mLocMvp, lMvp);
+        rlEnableVertexArray(mVao);
+        rlDrawVertexArrayInstanced(0, 6, (int)mFills.size());
+        rlDisableVertexArray();
+        rlDisableShader();
+        rlEnableBackfaceCulling();
+    }
+
+    std::vector<float> mCircles; // x, y, radius, outline per circle
+    std::vector<Color> mFills;
+    std::vector<Color> mStrokes;
+    mutable LineBatch mFallback;
+    bool mInstancing = true;
+    mutable bool mDirty = true;
+
+    // GPU state (created lazily by draw())
+    mutable bool mReady = false;
+    mutable bool mFailed = false;
+    mutable Shader mShader{};
+    mutable int mLocMvp = -1;
+    mutable int mLocPosition = -1;
+    mutable int mLocCircle = -1;
+    mutable int mLocFill = -1;
+    mutable int mLocStroke = -1;
+    mutable unsigned int mVao = 0;
+    mutable unsigned int mQuadVbo = 0;
+    mutable unsigned int mCircleVbo = 0;
+    mutable unsigned int mFillVbo = 0;
+    mutable unsigned int mStrokeVbo = 0;
+    mutable size_t mCapacity = 0;
+};
+
+} // namespace RLCharts
@@ -0,0 +1,20 @@
+// RLCivilDate.h
+#pragma once
+#include <cstdint>
+
+// Calendar helpers shared by the candlestick chart's date parsing and the OHLC
+// loader (no raylib dependency).
+
+namespace RLCharts {
+
+// Days since 1970-01-01 of a proleptic Gregorian date (H. Hinnant's days_from_civil)
+inline int64_t daysFromCivil(int64_t aYear, int64_t aMonth, int64_t aDay) {
+    aYear -= aMonth <= 2 ? 1 : 0;
+    const int64_t lEra = (aYear >= 0 ? aYear : aYear - 399) / 400;
+    const int64_t lYoe = aYear - lEra * 400;
+    const int64_t lDoy = (153 * (aMonth + (aMonth > 2 ? -3 : 9)) + 2) / 5 + aDay - 1;
+    const int64_t lDoe = lYoe * 365 + lYoe / 4 - lYoe / 100 + lDoy;
+    return lEra * 146097 + lDoe - 719468;
+}
+
+} // namespace RLCharts
@@ -0,0 +1,183 @@
+// RLColormap.h
+#pragma once
+#include "raylib.h"
+#include <array>
+#include <cstddef>
+#include <vector>
+
+// Shared color lookup tables for the scalar-field charts (heat maps, order book).
+// A colormap is a list of evenly spaced color stops expanded into a LUT by
+// piecewise-linear interpolation. buildStopLut() is the one implementation of
+// that expansion; the perceptual presets are expanded at compile time into
+// 256-entry tables, so charts using them never rebuild anything. Colormap holds
+// a LUT of any size (4096 entries for banding-free gradients on large surfaces);
+// RLGpuColormap.h uploads one as a texture.
+
+namespace RLCharts {
+
+enum class ColormapPreset {
+    VIRIDIS,
+    MAGMA,
+    INFERNO,
+    PLASMA,
+    CIVIDIS,
+    TURBO,
+    GRAYSCALE
+};
+
+constexpr size_t COLORMAP_LUT_SIZE = 256;          // What the charts' colorize paths index
+constexpr size_t COLORMAP_HIRES_LUT_SIZE = 4096;
+constexpr size_t COLORMAP_PRESET_STOPS = 10;
+
+// Entry aIndex of an aSize-entry LUT over aStopCount evenly spaced stops
+constexpr Color stopLutEntry(const Color* pStops, size_t aStopCount, size_t aIndex, size_t aSize) {
+    if (aStopCount == 1 || aSize < 2) {
+        return pStops[0];
+    }
+    const float lT = (float)aIndex / (float)(aSize - 1);
+    const float lSegF = lT * (float)(aStopCount - 1);
+    auto lSeg = (size_t)lSegF;
+    if (lSeg >= aStopCount - 1) {
+        lSeg = aStopCount - 2;
+    }
+    const float lLerp = lSegF - (float)lSeg;
+    const Color& rA = pStops[lSeg];
+    const Color& rB = pStops[lSeg + 1];
+    return Color{
+        (unsigned char)((float)rA.r + ((float)rB.r - (float)rA.r) * lLerp),
+        (unsigned char)((float)rA.g + ((float)rB.g - (float)rA.g) * lLerp),
+        (unsigned char)((float)rA.b + ((float)rB.b - (float)rA.b) * lLerp),
+        (unsigned char)((float)rA.a + ((float)rB.a - (float)rA.a) * lLerp)
+    };
+}
+
+// Expand aStopCount (>= 1) stops into pOut[0, aSize)
+inline void buildStopLut(const Color* pStops, size_t aStopCount, Color* pOut, size_t aSize) {
+    if (pStops == nullptr || aStopCount == 0) {
+        return;
+    }
+    for (size_t i = 0; i < aSize; ++i) {
+        pOut[i] = stopLutEntry(pStops, aStopCount, i, aSize);
+    }
+}
+
+using ColormapStops = std::array<Color, COLORMAP_PRESET_STOPS>;
+
+// Ten evenly spaced samples of each map (matplotlib's viridis family, Google's
+// turbo); the linear interpolation between them stays within a few levels of
+// the reference tables
+constexpr ColormapStops colormapStops(ColormapPreset aPreset) {
+    switch (aPreset) {
+        case ColormapPreset::VIRIDIS:
+            return {{ {68, 1, 84, 255}, {72, 40, 120, 255}, {62, 74, 137, 255}, {49, 104, 142, 255},
+                      {38, 130, 142, 255}, {31, 158, 137, 255}, {53, 183, 121, 255}, {109, 205, 89, 255},
+                      {180, 222, 44, 255}, {253, 231, 37, 255} }};
+        case ColormapPreset::MAGMA:
+            return {{ {0, 0, 4, 255}, {24, 15, 62, 255}, {69, 16, 119, 255}, {114, 31, 129, 255},
+                      {159, 47, 127, 255}, {205, 64, 113, 255}, {241, 96, 93, 255}, {253, 149, 103, 255},
+                      {254, 201, 141, 255}, {252, 253, 191, 255} }};
+        case ColormapPreset::INFERNO:
+            return {{ {0, 0, 4, 255}, {27, 12, 66, 255}, {75, 12, 107, 255}, {120, 28, 109, 255},
+                      {165, 44, 96, 255}, {207, 68, 70, 255}, {237, 105, 37, 255}, {251, 154, 6, 255},
+                      {247, 208, 60, 255}, {252, 255, 164, 255} }};
+        case ColormapPreset::PLASMA:
+            return {{ {13, 8, 135, 255}, {71, 3, 159, 255}, {115, 1, 168, 255}, {156, 23, 158, 255},
+                      {189, 55, 134, 255}, {216, 87, 107, 255}, {237, 121, 83, 255}, {250, 158, 59, 255},
+                      {253, 201, 38, 255}, {240, 249, 33, 255} }};
+        case ColormapPreset::CIVIDIS:
+            return {{ {0, 32, 77, 255}, {0, 51, 111, 255}, {57, 72, 107, 255}, {87, 92, 109, 255},
+                      {112, 113, 115, 255}, {138, 135, 121, 255}, {166, 157, 117, 255}, {196, 181, 108, 255},
+                      {228, 207, 91, 255}, {255, 234, 70, 255} }};
+        case ColormapPreset::TURBO:
+            return {{ {48, 18, 59, 255}, {70, 98, 215, 255}, {54, 170, 249, 255}, {26, 228, 182, 255},
+                      {114, 254, 94, 255}, {199, 239, 52, 255}, {250, 186, 57, 255}, {246, 107, 25, 255},
+                      {203, 42, 4, 255}, {122, 4, 3, 255} }};
+        case ColormapPreset::GRAYSCALE:
+        default:
+            break;
+    }
+    ColormapStops lGray{};
+    for (size_t i = 0; i < COLORMAP_PRESET_STOPS; ++i) {
+        const auto lV = (unsigned char)(i * 255 / (COLORMAP_PRESET_STOPS - 1));
+        lGray[i] = Color{ lV, lV, lV, 255 };
+    }
+    return lGray;
+}
+
+template<size_t N>
+constexpr std::array<Color, N> makePresetLut(ColormapPreset aPreset) {
+    const ColormapStops lStops = colormapStops(aPreset);
+    std::array<Color, N> lLut{};
+    for (size_t i = 0; i < N; ++i) {
+        lLut[i] = stopLutEntry(lStops.data(), lStops.size(), i, N);
+    }
+    return lLut;
+}
+
+// Compile-time 256-entry LUT of a preset (shared, never rebuilt)
+inline const Color* presetLut(ColormapPreset aPreset) {
+    static constexpr std::array<Color, COLORMAP_LUT_SIZE> VIRIDIS_LUT = makePresetLut<COLORMAP_LUT_SIZE>(ColormapPreset::VIRIDIS);
+    static constexpr std::array<Color, COLORMAP_LUT_SIZE> MAGMA_LUT = makePresetLut<COLORMAP_LUT_SIZE>(ColormapPreset::MAGMA);
+    static constexpr std::array<Color, COLORMAP_LUT_SIZE> INFERNO_LUT = makePresetLut<COLORMAP_LUT_SIZE>(ColormapPreset::INFERNO);
+    static constexpr std::array<Color, COLORMAP_LUT_SIZE> PLASMA_LUT = makePresetLut<COLORMAP_LUT_SIZE>(ColormapPreset::PLASMA);
+    static constexpr std::array<Color, COLORMAP_LUT_SIZE> CIVIDIS_LUT = makePresetLut<COLORMAP_LUT_SIZE>(ColormapPreset::CIVIDIS);
+    static constexpr std::array<Color, COLORMAP_LUT_SIZE> TURBO_LUT = makePresetLut<COLORMAP_LUT_SIZE>(ColormapPreset::TURBO);
+    static constexpr std::array<Color, COLORMAP_LUT_SIZE> GRAYSCALE_LUT = makePresetLut<COLORMAP_LUT_SIZE>(ColormapPreset::GRAYSCALE);
+    switch (aPreset) {
+        case ColormapPreset::VIRIDIS: return VIRIDIS_LUT.data();
+        case ColormapPreset::MAGMA: return MAGMA_LUT.data();
+        case ColormapPreset::INFERNO: return INFERNO_LUT.data();
+        case ColormapPreset::PLASMA: return PLASMA_LUT.data();
+        case ColormapPreset::CIVIDIS: return CIVIDIS_LUT.data();
+        case ColormapPreset::TURBO: return TURBO_LUT.data();
+        case ColormapPreset::GRAYSCALE:
+        default: return GRAYSCALE_LUT.data();
+    }
+}
+
+// A colormap LUT of arbitrary resolution
+class Colormap {
+public:
+    explicit Colormap(ColormapPreset aPreset, size_t aSize = COLORMAP_LUT_SIZE) {
+        const ColormapStops lStops = colormapStops(aPreset);
+        mStops.assign(lStops.begin(), lStops.end());
+        if (aSize == COLORMAP_LUT_SIZE) {
+            const Color* pLut = presetLut(aPreset);
+            mLut.assign(pLut, pLut + COLORMAP_LUT_SIZE);
+        } else {
+            rebuild(aSize);
+        }
+    }
+
+    explicit Colormap(const std::vector<Color>& rStops, size_t aSize = COLORMAP_LUT_SIZE)
+        : mStops(rStops.empty() ? std::vector<Color>{ BLACK, WHITE } : rStops) {
+        rebuild(aSize);
+    }
+
+    [[nodiscard]] const Color* data() const { return mLut.data(); }
+    [[nodiscard]] size_t size() const { return mLut.size(); }
+    [[nodiscard]] const std::vector<Color>& getStops() const { return mStops; }
+
+    // Nearest entry for t in [0, 1] (clamped)
+    [[nodiscard]] Color sample(float aT) const {
+        const float lT = aT < 0.0f ? 0.0f : (aT > 1.0f ? 1.0f : aT);
+        return mLut[(size_t)(lT * (float)(mLut.size() - 1) + 0.5f)];
+    }
+
+    void setResolution(size_t aSize) {
+        if (aSize != mLut.size()) {
+            rebuild(aSize);
+        }
+    }
+
+private:
+    void rebuild(size_t aSize) {
+        mLut.resize(aSize < 2 ? 2 : aSize);
+        buildStopLut(mStops.data(), mStops.size(), mLut.data(), mLut.size());
+    }
+
+    std::vector<Color> mStops;
+    std::vector<Color> mLut;
+};
+
+} // namespace RLCharts
@@ -1,7 +1,9 @@
 // RLCommon.h
 #pragma once
 #include "raylib.h"
+#include "RLSimd.h"
 #include <cmath>
+#include <cstddef>
 
 // Common utilities for raylib charts
 // All functions are in the RLCharts namespace to avoid conflicts
@@ -76,10 +78,124 @@ inline float colorLuma(const Color& rColor) {
     return 0.2126f * rColor.r + 0.7152f * rColor.g + 0.0722f * rColor.b;
 }
 
-// Smooth approach function for exponential smoothing
+// Smooth approach function for exponential smoothing. Snaps to b once close, or
+// once the step is below float resolution (large magnitudes such as prices)
 inline float approach(float a, float b, float aSpeedDt) {
     float lDiff = b - a;
-    return a + lDiff * (lDiff * lDiff < 1e-8f ? 1.0f : clamp01(aSpeedDt));
+    const float lNext = a + lDiff * (lDiff * lDiff < 1e-8f ? 1.0f : clamp01(aSpeedDt));
+    return (lNext == a && aSpeedDt > 0.0f) ? b : lNext;
+}
+
+// True when aValue is within approach()'s snap distance of aTarget (settled)
+inline bool nearlyEqual(float aValue, float aTarget) {
+    const float lDiff = aTarget - aValue;
+    return lDiff * lDiff < 1e-8f;
+}
+
+inline bool colorEquals(const Color& a, const Color& b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+// lerpColor for per-frame animation: every differing channel moves at least one
+// step, so the color reaches aTarget exactly instead of stalling once
+// (b - a) * t truncates to zero
+inline Color approachColor(const Color& a, const Color& b, float t) {
+    t = clamp01(t);
+    auto step = [t](unsigned char aFrom, unsigned char aTo) {
+        const int lDiff = (int)aTo - (int)aFrom;
+        int lStep = (int)((float)lDiff * t);
+        if (lStep == 0 && lDiff != 0) {
+            lStep = lDiff > 0 ? 1 : -1;
+        }
+        return (unsigned char)((int)aFrom + lStep);
+    };
+    return Color{ step(a.r, b.r), step(a.g, b.g), step(a.b, b.b), step(a.a, b.a) };
+}
+
+// Reference batched approach(): elements within 1e-4 of their target snap to it
+// exactly, the rest move by clamp01(aSpeedDt) of the distance. Returns true when
+// every element was already at (or has now snapped to) its target.
+inline bool approachArrayScalar(float* pCur, const float* pTarget, size_t aCount, float aSpeedDt) {
+    const float lK = clamp01(aSpeedDt);
+    bool lSettled = true;
+    for (size_t i = 0; i < aCount; ++i) {
+        const float lDiff = pTarget[i] - pCur[i];
+        if (lDiff * lDiff < 1e-8f) {
+            pCur[i] = pTarget[i];
+        } else {
+            pCur[i] = pCur[i] + lDiff * lK;
+            lSettled = false;
+        }
+    }
+    return lSettled;
+}
+
+// Vectorized approachArrayScalar (see RLSimd.h for the instruction set selection).
+// Charts use the result to skip mesh/texture rebuilds once an animation settles.
+inline bool approachArray(float* pCur, const float* pTarget, size_t aCount, float aSpeedDt) {
+    const float lK = clamp01(aSpeedDt);
+    size_t i = 0;
+    bool lSettled = true;
+#if defined(RLCHARTS_SIMD_AVX2)
+    const __m256 lK8 = _mm256_set1_ps(lK);
+    const __m256 lEps8 = _mm256_set1_ps(1e-8f);
+    __m256 lSnapAll = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+    for (; i + 8 <= aCount; i += 8) {
+        const __m256 lA = _mm256_loadu_ps(pCur + i);
+        const __m256 lB = _mm256_loadu_ps(pTarget + i);
+        const __m256 lDiff = _mm256_sub_ps(lB, lA);
+        const __m256 lSnap = _mm256_cmp_ps(_mm256_mul_ps(lDiff, lDiff), lEps8, _CMP_LT_OQ);
+        const __m256 lStep = _mm256_add_ps(lA, _mm256_mul_ps(lDiff, lK8));
+        _mm256_storeu_ps(pCur + i, _mm256_blendv_ps(lStep, lB, lSnap));
+        lSnapAll = _mm256_and_ps(lSnapAll, lSnap);
+    }
+    lSettled = _mm256_movemask_ps(lSnapAll) == 0xFF;
+#elif defined(RLCHARTS_SIMD_SSE2)
+    const __m128 lK4 = _mm_set1_ps(lK);
+    const __m128 lEps4 = _mm_set1_ps(1e-8f);
+    __m128 lSnapAll = _mm_castsi128_ps(_mm_set1_epi32(-1));
+    for (; i + 4 <= aCount; i += 4) {
+        const __m128 lA = _mm_loadu_ps(pCur + i);
+        const __m128 lB = _mm_loadu_ps(pTarget + i);
+        const __m128 lDiff = _mm_sub_ps(lB, lA);
+        const __m128 lSnap = _mm_cmplt_ps(_mm_mul_ps(lDiff, lDiff), lEps4);
+        const __m128 lStep = _mm_add_ps(lA, _mm_mul_ps(lDiff, lK4));
+        _mm_storeu_ps(pCur + i, _mm_or_ps(_mm_and_ps(lSnap, lB), _mm_andnot_ps(lSnap, lStep)));
+        lSnapAll = _mm_and_ps(lSnapAll, lSnap);
+    }
+    lSettled = _mm_movemask_ps(lSnapAll) == 0xF;
+#elif defined(RLCHARTS_SIMD_NEON)
+    const float32x4_t lK4 = vdupq_n_f32(lK);
+    const float32x4_t lEps4 = vdupq_n_f32(1e-8f);
+    uint32x4_t lSnapAll = vdupq_n_u32(0xFFFFFFFFu);
+    for (; i + 4 <= aCount; i += 4) {
+        const float32x4_t lA = vld1q_f32(pCur + i);
+        const float32x4_t lB = vld1q_f32(pTarget + i);
+        const float32x4_t lDiff = vsubq_f32(lB, lA);
+        const uint32x4_t lSnap = vcltq_f32(vmulq_f32(lDiff, lDiff), lEps4);
+        const float32x4_t lStep = vaddq_f32(lA, vmulq_f32(lDiff, lK4));
+        vst1q_f32(pCur + i, vbslq_f32(lSnap, lB, lStep));
+        lSnapAll = vandq_u32(lSnapAll, lSnap);
+    }
+    lSettled = (vgetq_lane_u32(lSnapAll, 0) & vgetq_lane_u32(lSnapAll, 1) &
+                vgetq_lane_u32(lSnapAll, 2) & vgetq_lane_u32(lSnapAll, 3)) != 0;
+#elif defined(RLCHARTS_SIMD_WASM)
+    const v128_t lK4 = wasm_f32x4_splat(lK);
+    const v128_t lEps4 = wasm_f32x4_splat(1e-8f);
+    v128_t lSnapAll = wasm_i32x4_splat(-1);
+    for (; i + 4 <= aCount; i += 4) {
+        const v128_t lA = wasm_v128_load(pCur + i);
+        const v128_t lB = wasm_v128_load(pTarget + i);
+        const v128_t lDiff = wasm_f32x4_sub(lB, lA);
+        const v128_t lSnap = wasm_f32x4_lt(wasm_f32x4_mul(lDiff, lDiff), lEps4);
+        const v128_t lStep = wasm_f32x4_add(lA, wasm_f32x4_mul(lDiff, lK4));
+        wasm_v128_store(pCur + i, wasm_v128_bitselect(lB, lStep, lSnap));
+        lSnapAll = wasm_v128_and(lSnapAll, lSnap);
+    }
+    lSettled = wasm_i32x4_all_true(lSnapAll);
+#endif
+    const bool lTailSettled = approachArrayScalar(pCur + i, pTarget + i, aCount - i, aSpeedDt);
+    return lSettled && lTailSettled;
 }
 
 // Multiply alpha channel by a factor
@@ -124,5 +240,37 @@ inline Vector2 catmullRom(const Vector2& aP0, const Vector2& aP1,
     return { lX, lY };
 }
 
+// Half-open cell rectangle [mX0, mX1) x [mY0, mY1), used to track dirty grid regions.
+// Default constructed it is empty; include/merge grow it to the bounding box.
+struct CellRect {
+    int mX0{0};
+    int mY0{0};
+    int mX1{0};
+    int mY1{0};
+
+    [[nodiscard]] bool isEmpty() const { return mX0 >= mX1 || mY0 >= mY1; }
+    [[nodiscard]] int width() const { return isEmpty() ? 0 : mX1 - mX0; }
+    [[nodiscard]] int height() const { return isEmpty() ? 0 : mY1 - mY0; }
+    [[nodiscard]] size_t area() const { return (size_t)width() * (size_t)height(); }
+
+    void reset() { *this = CellRect{}; }
+
+    void include(int aX, int aY) {
+        merge(CellRect{aX, aY, aX + 1, aY + 1});
+    }
+
+    void merge(const CellRect& rOther) {
+        if (rOther.isEmpty()) return;
+        if (isEmpty()) {
+            *this = rOther;
+            return;
+        }
+        mX0 = minVal(mX0, rOther.mX0);
+        mY0 = minVal(mY0, rOther.mY0);
+        mX1 = maxVal(mX1, rOther.mX1);
+        mY1 = maxVal(mY1, rOther.mY1);
+    }
+};
+
 } // namespace RLCharts
 
@@ -0,0 +1,228 @@
+// RLFeedSocket.cpp
+#include "RLFeedSocket.h"
+#include <cstdio>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#if !defined(_WIN32_WINNT) || _WIN32_WINNT < 0x0600
+#undef _WIN32_WINNT
+#define _WIN32_WINNT 0x0600 // WSAPoll
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace RLCharts {
+
+#if defined(_WIN32)
+using SocketHandle = SOCKET;
+using PollEntry = WSAPOLLFD;
+
+static bool initSockets() {
+    static const bool sReady = []() {
+        WSADATA lData;
+        return WSAStartup(MAKEWORD(2, 2), &lData) == 0;
+    }();
+    return sReady;
+}
+
+static void closeSocket(SocketHandle aSocket) {
+    closesocket(aSocket);
+}
+
+static bool setNonBlocking(SocketHandle aSocket, bool aEnabled) {
+    u_long lMode = aEnabled ? 1 : 0;
+    return ioctlsocket(aSocket, FIONBIO, &lMode) == 0;
+}
+
+static bool connectPending() {
+    return WSAGetLastError() == WSAEWOULDBLOCK;
+}
+
+static bool interrupted() {
+    const int lError = WSAGetLastError();
+    return lError == WSAEINTR || lError == WSAEWOULDBLOCK;
+}
+#else
+using SocketHandle = int;
+using PollEntry = pollfd;
+
+static bool initSockets() {
+    return true;
+}
+
+static void closeSocket(SocketHandle aSocket) {
+    ::close(aSocket);
+}
+
+static bool setNonBlocking(SocketHandle aSocket, bool aEnabled) {
+    const int lFlags = fcntl(aSocket, F_GETFL, 0);
+    if (lFlags < 0) {
+        return false;
+    }
+    return fcntl(aSocket, F_SETFL, aEnabled ? (lFlags | O_NONBLOCK) : (lFlags & ~O_NONBLOCK)) == 0;
+}
+
+static bool connectPending() {
+    return errno == EINPROGRESS;
+}
+
+static bool interrupted() {
+    return errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK;
+}
+#endif
+
+// 1 when aEvents are ready, 0 on timeout, -1 on a socket error
+static int waitSocket(SocketHandle aSocket, short aEvents, int aTimeoutMs) {
+    PollEntry lFd{};
+    lFd.fd = aSocket;
+    lFd.events = aEvents;
+#if defined(_WIN32)
+    const int lReady = WSAPoll(&lFd, 1, aTimeoutMs);
+#else
+    const int lReady = poll(&lFd, 1, aTimeoutMs);
+#endif
+    if (lReady < 0) {
+        return interrupted() ? 0 : -1;
+    }
+    if (lReady == 0) {
+        return 0;
+    }
+    // POLLHUP with data still queued is left to recv(), which then reports the close
+    return (lFd.revents & (POLLERR | POLLNVAL)) != 0 ? -1 : 1;
+}
+
+bool FeedSocket::openUdp(const char* pGroup, uint16_t aPort, const char* pInterface) {
+    close();
+    if (!initSockets()) {
+        return false;
+    }
+    const SocketHandle lSocket = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+#if defined(_WIN32)
+    if (lSocket == INVALID_SOCKET) {
+#else
+    if (lSocket < 0) {
+#endif
+        return false;
+    }
+    // Several listeners may share a multicast port; a large receive buffer rides out render hitches
+    const int lReuse = 1;
+    setsockopt(lSocket, SOL_SOCKET, SO_REUSEADDR, (const char*)&lReuse, sizeof(lReuse));
+    const int lReceiveBuffer = 4 << 20;
+    setsockopt(lSocket, SOL_SOCKET, SO_RCVBUF, (const char*)&lReceiveBuffer, sizeof(lReceiveBuffer));
+
+    sockaddr_in lAddress{};
+    lAddress.sin_family = AF_INET;
+    lAddress.sin_port = htons(aPort);
+    lAddress.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (bind(lSocket, (const sockaddr*)&lAddress, sizeof(lAddress)) != 0) {
+        closeSocket(lSocket);
+        return false;
+    }
+
+    if (pGroup != nullptr && pGroup[0] != '\0') {
+        ip_mreq lRequest{};
+        if (inet_pton(AF_INET, pGroup, &lRequest.imr_multiaddr) != 1 ||
+            (ntohl(lRequest.imr_multiaddr.s_addr) & 0xF0000000u) != 0xE0000000u) {
+            closeSocket(lSocket);
+            return false; // not an IPv4 multicast address
+        }
+        lRequest.imr_interface.s_addr = htonl(INADDR_ANY);
+        if (pInterface != nullptr && pInterface[0] != '\0' &&
+            inet_pton(AF_INET, pInterface, &lRequest.imr_interface) != 1) {
+            closeSocket(lSocket);
+            return false;
+        }
+        if (setsockopt(lSocket, IPPROTO_IP, IP_ADD_MEMBERSHIP, (const char*)&lRequest, sizeof(lRequest)) != 0) {
+            closeSocket(lSocket);
+            return false;
+        }
+    }
+    mHandle = (intptr_t)lSocket;
+    mStream = false;
+    return true;
+}
+
+bool FeedSocket::connectTcp(const char* pHost, uint16_t aPort, int aTimeoutMs) {
+    close();
+    if (!initSockets() || pHost == nullptr) {
+        return false;
+    }
+    char lPort[8];
+    std::snprintf(lPort, sizeof(lPort), "%u", (unsigned)aPort);
+    addrinfo lHints{};
+    lHints.ai_family = AF_UNSPEC;
+    lHints.ai_socktype = SOCK_STREAM;
+    addrinfo* pList = nullptr;
+    if (getaddrinfo(pHost, lPort, &lHints, &pList) != 0) {
+        return false;
+    }
+    for (const addrinfo* pInfo = pList; pInfo != nullptr; pInfo = pInfo->ai_next) {
+        const SocketHandle lSocket = socket(pInfo->ai_family, pInfo->ai_socktype, pInfo->ai_protocol);
+#if defined(_WIN32)
+        if (lSocket == INVALID_SOCKET) {
+#else
+        if (lSocket < 0) {
+#endif
+            continue;
+        }
+        // Non-blocking connect so an unreachable host fails after aTimeoutMs
+        bool lConnected = false;
+        if (setNonBlocking(lSocket, true)) {
+            if (connect(lSocket, pInfo->ai_addr, (int)pInfo->ai_addrlen) == 0) {
+                lConnected = true;
+            } else if (connectPending() && waitSocket(lSocket, POLLOUT, aTimeoutMs) == 1) {
+                int lError = 0;
+                socklen_t lLength = sizeof(lError);
+                lConnected = getsockopt(lSocket, SOL_SOCKET, SO_ERROR, (char*)&lError, &lLength) == 0 && lError == 0;
+            }
+        }
+        if (lConnected && setNonBlocking(lSocket, false)) {
+            mHandle = (intptr_t)lSocket;
+            mStream = true;
+            break;
+        }
+        closeSocket(lSocket);
+    }
+    freeaddrinfo(pList);
+    return isOpen();
+}
+
+void FeedSocket::close() {
+    if (mHandle != -1) {
+        closeSocket((SocketHandle)mHandle);
+    }
+    mHandle = -1;
+}
+
+long FeedSocket::receive(char* pBuffer, size_t aCapacity, int aTimeoutMs) {
+    if (mHandle == -1) {
+        return -1;
+    }
+    const SocketHandle lSocket = (SocketHandle)mHandle;
+    const int lReady = waitSocket(lSocket, POLLIN, aTimeoutMs);
+    if (lReady <= 0) {
+        return lReady;
+    }
+    const long lReceived = (long)recv(lSocket, pBuffer, (int)aCapacity, 0);
+    if (lReceived > 0) {
+        return lReceived;
+    }
+    if (lReceived == 0) {
+        // End of stream for TCP; an empty datagram for UDP
+        return mStream ? -1 : 0;
+    }
+    return interrupted() ? 0 : -1;
+}
+
+} // namespace RLCharts
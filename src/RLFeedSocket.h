@@ -0,0 +1,38 @@
+// RLFeedSocket.h
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Implemented in RLFeedSocket.cpp (no raylib dependency, so the platform socket
+// headers stay out of translation units that include raylib.h; add it to the
+// target's sources and link ws2_32 on Windows). Used by the live feed adapters
+// (RLDataSource.h).
+
+namespace RLCharts {
+
+// Minimal blocking-with-timeout IPv4 UDP / TCP receive socket
+class FeedSocket {
+public:
+    FeedSocket() = default;
+    ~FeedSocket() { close(); }
+    FeedSocket(const FeedSocket&) = delete;
+    FeedSocket& operator=(const FeedSocket&) = delete;
+
+    // Bind UDP aPort on all interfaces; with a multicast pGroup (e.g. "239.1.1.1")
+    // also join it, on the interface address pInterface if given
+    bool openUdp(const char* pGroup, uint16_t aPort, const char* pInterface = nullptr);
+    // Connect to pHost:aPort, giving up after aTimeoutMs
+    bool connectTcp(const char* pHost, uint16_t aPort, int aTimeoutMs = 2000);
+    void close();
+    [[nodiscard]] bool isOpen() const { return mHandle != -1; }
+
+    // Bytes received (> 0), 0 if nothing arrived within aTimeoutMs, -1 once the
+    // peer closed the connection or on an error
+    long receive(char* pBuffer, size_t aCapacity, int aTimeoutMs);
+
+private:
+    intptr_t mHandle = -1;
+    bool mStream = false;
+};
+
+} // namespace RLCharts
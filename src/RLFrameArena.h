@@ -0,0 +1,203 @@
+// RLFrameArena.h
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <vector>
+
+// Per-frame scratch memory for the charts' update() and draw() paths.
+// FrameArena is a monotonic bump allocator exposed as a std::pmr::memory_resource,
+// so transient containers are plain std::pmr::vectors that never touch the heap
+// once the arena has grown to a frame's working set. Deallocation is a no-op;
+// memory comes back when the arena is rewound.
+//
+// Charts open a FrameScratch at the top of a hot function and build their
+// temporaries on it; the scope rewinds the arena on exit, so scratch use stays
+// bounded even when the application never resets it:
+//   RLCharts::FrameScratch lScratch;
+//   std::pmr::vector<Vector2> lPoints(lScratch.resource());
+//
+// Each thread has its own arena (frameArena()). The application calls
+// RLCharts::beginFrame() once per frame on every thread that updates or draws
+// charts: it rewinds the arena, merges chunks the last frame spilled into one
+// block sized for the whole frame, and rolls the allocation counters.
+// getLastFrameHeapAllocations() is the debug counter for zero steady-state
+// allocations: after warm-up it stays 0.
+
+namespace RLCharts {
+
+class FrameArena final : public std::pmr::memory_resource {
+public:
+    static constexpr size_t DEFAULT_CHUNK_BYTES = 64 * 1024;
+
+    // Position to rewind to (see FrameScratch)
+    struct Marker {
+        size_t mChunk{ 0 };
+        size_t mOffset{ 0 };
+    };
+
+    explicit FrameArena(size_t aInitialBytes = DEFAULT_CHUNK_BYTES) : mInitialBytes(aInitialBytes) {}
+    ~FrameArena() override { releaseChunks(); }
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    [[nodiscard]] Marker mark() const { return Marker{ mCurrent, mOffset }; }
+
+    // Drop everything allocated after aMarker (the chunks stay for reuse)
+    void rewind(Marker aMarker) {
+        if (aMarker.mChunk < mCurrent || (aMarker.mChunk == mCurrent && aMarker.mOffset < mOffset)) {
+            mCurrent = aMarker.mChunk;
+            mOffset = aMarker.mOffset;
+        }
+    }
+
+    // Start of a frame: rewind to empty and, if the last frame needed more than
+    // one chunk, replace them with a single chunk that holds the whole frame
+    void reset() {
+        if (mChunks.size() > 1) {
+            size_t lTotal = 0;
+            for (const Chunk& rChunk : mChunks) {
+                lTotal += rChunk.mSize;
+            }
+            releaseChunks();
+            addChunk(lTotal);
+        }
+        mCurrent = 0;
+        mOffset = 0;
+        mLastFrameAllocations = mFrameAllocations;
+        mFrameAllocations = 0;
+        mLastFrameBytes = mFrameHighWater;
+        mFrameHighWater = 0;
+    }
+
+    // Heap allocations made by the arena: since construction, in the current
+    // frame, and in the last completed frame (0 in steady state)
+    [[nodiscard]] size_t getHeapAllocations() const { return mHeapAllocations; }
+    [[nodiscard]] size_t getFrameHeapAllocations() const { return mFrameAllocations; }
+    [[nodiscard]] size_t getLastFrameHeapAllocations() const { return mLastFrameAllocations; }
+    // Peak scratch bytes in use during the last completed frame
+    [[nodiscard]] size_t getLastFrameBytes() const { return mLastFrameBytes; }
+    [[nodiscard]] size_t getCapacity() const {
+        size_t lTotal = 0;
+        for (const Chunk& rChunk : mChunks) {
+            lTotal += rChunk.mSize;
+        }
+        return lTotal;
+    }
+
+private:
+    struct Chunk {
+        std::byte* mpData{ nullptr };
+        size_t mSize{ 0 };
+    };
+
+    static constexpr size_t CHUNK_ALIGN = alignof(std::max_align_t);
+
+    void* do_allocate(size_t aBytes, size_t aAlign) override {
+        if (aBytes == 0) {
+            aBytes = 1;
+        }
+        for (;;) {
+            if (mCurrent < mChunks.size()) {
+                const Chunk& rChunk = mChunks[mCurrent];
+                const auto lBase = reinterpret_cast<uintptr_t>(rChunk.mpData);
+                const uintptr_t lAligned = (lBase + mOffset + aAlign - 1) & ~(uintptr_t)(aAlign - 1);
+                const size_t lStart = (size_t)(lAligned - lBase);
+                if (lStart + aBytes <= rChunk.mSize) {
+                    mOffset = lStart + aBytes;
+                    trackUsage();
+                    return rChunk.mpData + lStart;
+                }
+                // Move on to the next chunk if it is big enough, else insert a new one
+                if (mCurrent + 1 < mChunks.size() && mChunks[mCurrent + 1].mSize >= aBytes + aAlign) {
+                    ++mCurrent;
+                    mOffset = 0;
+                    continue;
+                }
+                const size_t lGrow = rChunk.mSize * 2 > aBytes + aAlign ? rChunk.mSize * 2 : aBytes + aAlign;
+                insertChunk(mCurrent + 1, lGrow);
+                ++mCurrent;
+                mOffset = 0;
+                continue;
+            }
+            const size_t lFirst = mInitialBytes > aBytes + aAlign ? mInitialBytes : aBytes + aAlign;
+            addChunk(lFirst);
+            mCurrent = mChunks.size() - 1;
+            mOffset = 0;
+        }
+    }
+
+    void do_deallocate(void*, size_t, size_t) override {}
+
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& rOther) const noexcept override {
+        return this == &rOther;
+    }
+
+    void addChunk(size_t aBytes) { insertChunk(mChunks.size(), aBytes); }
+
+    void insertChunk(size_t aIndex, size_t aBytes) {
+        Chunk lChunk;
+        lChunk.mpData = static_cast<std::byte*>(::operator new(aBytes, std::align_val_t{ CHUNK_ALIGN }));
+        lChunk.mSize = aBytes;
+        mChunks.insert(mChunks.begin() + (std::ptrdiff_t)aIndex, lChunk);
+        mHeapAllocations++;
+        mFrameAllocations++;
+    }
+
+    void releaseChunks() {
+        for (const Chunk& rChunk : mChunks) {
+            ::operator delete(rChunk.mpData, std::align_val_t{ CHUNK_ALIGN });
+        }
+        mChunks.clear();
+    }
+
+    void trackUsage() {
+        size_t lUsed = mOffset;
+        for (size_t i = 0; i < mCurrent; ++i) {
+            lUsed += mChunks[i].mSize;
+        }
+        mFrameHighWater = lUsed > mFrameHighWater ? lUsed : mFrameHighWater;
+    }
+
+    std::vector<Chunk> mChunks;
+    size_t mInitialBytes;
+    size_t mCurrent{ 0 };
+    size_t mOffset{ 0 };
+    size_t mHeapAllocations{ 0 };
+    size_t mFrameAllocations{ 0 };
+    size_t mLastFrameAllocations{ 0 };
+    size_t mFrameHighWater{ 0 };
+    size_t mLastFrameBytes{ 0 };
+};
+
+// The calling thread's arena
+inline FrameArena& frameArena() {
+    thread_local FrameArena sArena;
+    return sArena;
+}
+
+// Once per frame, per thread, before updating and drawing charts
+inline void beginFrame() {
+    frameArena().reset();
+}
+
+// Scratch scope for one update()/draw(): containers built on resource() must be
+// declared after the scope so they are destroyed before it rewinds the arena
+class FrameScratch {
+public:
+    FrameScratch() : mArena(frameArena()), mMarker(mArena.mark()) {}
+    ~FrameScratch() { mArena.rewind(mMarker); }
+
+    FrameScratch(const FrameScratch&) = delete;
+    FrameScratch& operator=(const FrameScratch&) = delete;
+
+    [[nodiscard]] std::pmr::memory_resource* resource() const { return &mArena; }
+
+private:
+    FrameArena& mArena;
+    FrameArena::Marker mMarker;
+};
+
+} // namespace RLCharts
@@ -0,0 +1,248 @@
+// RLGaugePanel.h
+#pragma once
+#include "raylib.h"
+#include "rlgl.h"
+#include "RLRenderCache.h"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Panel renderer for walls of many RLGauge / RLLinearGauge instances.
+// A gauge splits into a face (background, track or base arc, ticks, labels, range
+// bands) that only depends on its style, range and size, and a dynamic part
+// (needle, fill, value text). GaugePanel bakes each distinct face once into a
+// shared atlas texture, keyed by the gauge's getFaceKey(). Per frame it draws all
+// faces as textured quads from that one texture, then the dynamic parts of all
+// gauges back to back, so the wall costs a handful of draw calls instead of
+// redrawing every tick and label of every gauge.
+//
+// Usage:
+//   RLCharts::GaugePanel lPanel;
+//   lPanel.begin();
+//   for (const RLGauge& rGauge : lGauges) { lPanel.add(rGauge); }
+//   lPanel.add(lLinearGauge);
+//   lPanel.end();
+//
+// end() renders into the atlas when a new face shows up, so call it outside
+// BeginTextureMode (and not through a RenderCache). Faces are baked at whole-pixel
+// offsets; gauges with the same key at different sub-pixel positions share one.
+// When the atlas is full it is cleared and refilled with the faces of the current
+// frame (at most every RESET_INTERVAL frames); faces that still do not fit, or all
+// of them when no render target is available, are drawn directly with drawFace().
+
+namespace RLCharts {
+
+class GaugePanel {
+public:
+    static constexpr int DEFAULT_ATLAS_SIZE = 2048;
+
+    explicit GaugePanel(int aAtlasSize = DEFAULT_ATLAS_SIZE) : mAtlasSize(aAtlasSize > 16 ? aAtlasSize : 16) {}
+    ~GaugePanel() { release(); }
+
+    // Owns a GPU render target
+    GaugePanel(const GaugePanel&) = delete;
+    GaugePanel& operator=(const GaugePanel&) = delete;
+
+    // Start collecting the gauges of a frame
+    void begin() { mEntries.clear(); }
+
+    // Queue a gauge (anything with getBounds(), getFaceKey(), drawFace() and
+    // drawDynamic()); it must stay alive until end()
+    template<typename T>
+    void add(const T& rGauge) {
+        mEntries.push_back(Entry{ &rGauge, rGauge.getBounds(), rGauge.getFaceKey(), &drawFaceOf<T>,
+                                  &drawDynamicOf<T>, NO_CELL });
+    }
+
+    // Bake new faces, then draw all faces and all dynamic parts
+    void end() {
+        mDirectFaces = 0;
+        if (mEntries.empty()) {
+            return;
+        }
+        if (ensureAtlas()) {
+            assignCells();
+            bakeNewCells();
+        }
+
+        // Atlas faces: one texture, one blend mode
+        BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+        for (const Entry& rEntry : mEntries) {
+            if (rEntry.mCell == NO_CELL) {
+                continue;
+            }
+            const Rectangle lCell = mCells[rEntry.mCell];
+            // Render textures are stored bottom-up
+            const Rectangle lSource{ lCell.x, (float)mAtlasSize - lCell.y - lCell.height, lCell.width,
+                                     -lCell.height };
+            DrawTextureRec(mAtlas.texture, lSource,
+                           Vector2{ floorf(rEntry.mBounds.x) - (float)CELL_PADDING,
+                                    floorf(rEntry.mBounds.y) - (float)CELL_PADDING },
+                           WHITE);
+        }
+        EndBlendMode();
+
+        for (const Entry& rEntry : mEntries) {
+            if (rEntry.mCell == NO_CELL) {
+                rEntry.mDrawFace(rEntry.mpGauge);
+                mDirectFaces++;
+            }
+        }
+        for (const Entry& rEntry : mEntries) {
+            rEntry.mDrawDynamic(rEntry.mpGauge);
+        }
+    }
+
+    // Drop all baked faces (e.g. after reloading a font the faces use)
+    void invalidate() {
+        mCellOf.clear();
+        mCells.clear();
+        mShelfX = 0;
+        mShelfY = 0;
+        mShelfHeight = 0;
+    }
+
+    void release() {
+        if (mAtlas.id != 0) {
+            UnloadRenderTexture(mAtlas);
+        }
+        mAtlas = RenderTexture2D{};
+        invalidate();
+    }
+
+    [[nodiscard]] bool isValid() const { return mAtlas.id != 0; }
+    [[nodiscard]] int getAtlasSize() const { return mAtlasSize; }
+    // Distinct faces currently in the atlas
+    [[nodiscard]] size_t getFaceCount() const { return mCells.size(); }
+    // Faces rendered into the atlas since construction
+    [[nodiscard]] size_t getBakeCount() const { return mBakeCount; }
+    // Faces drawn directly in the last end() (atlas full or unavailable)
+    [[nodiscard]] size_t getDirectFaceCount() const { return mDirectFaces; }
+
+private:
+    static constexpr uint32_t NO_CELL = 0xFFFFFFFFu;
+    // Empty border around each face so neighbours never bleed into each other
+    static constexpr int CELL_PADDING = 1;
+    static constexpr size_t RESET_INTERVAL = 120;
+
+    struct Entry {
+        const void* mpGauge;
+        Rectangle mBounds;
+        uint64_t mKey;
+        void (*mDrawFace)(const void*);
+        void (*mDrawDynamic)(const void*);
+        uint32_t mCell;
+    };
+
+    template<typename T>
+    static void drawFaceOf(const void* pGauge) {
+        ((const T*)pGauge)->drawFace();
+    }
+    template<typename T>
+    static void drawDynamicOf(const void* pGauge) {
+        ((const T*)pGauge)->drawDynamic();
+    }
+
+    bool ensureAtlas() {
+        if (mAtlas.id == 0) {
+            mAtlas = LoadRenderTexture(mAtlasSize, mAtlasSize);
+            invalidate();
+        }
+        return mAtlas.id != 0;
+    }
+
+    // Look up or allocate one cell per entry. A full atlas is cleared and refilled
+    // with this frame's faces only, at most once per RESET_INTERVAL frames so a
+    // wall that never fits does not rebake every frame.
+    void assignCells() {
+        mNewCells.clear();
+        mFramesSinceReset++;
+        bool lOverflow = false;
+        for (Entry& rEntry : mEntries) {
+            rEntry.mCell = findOrAllocate(rEntry, lOverflow);
+        }
+        if (lOverflow && mFramesSinceReset >= RESET_INTERVAL) {
+            mFramesSinceReset = 0;
+            invalidate();
+            mNewCells.clear();
+            lOverflow = false;
+            for (Entry& rEntry : mEntries) {
+                rEntry.mCell = findOrAllocate(rEntry, lOverflow);
+            }
+        }
+    }
+
+    uint32_t findOrAllocate(const Entry& rEntry, bool& rOverflow) {
+        const auto lIt = mCellOf.find(rEntry.mKey);
+        if (lIt != mCellOf.end()) {
+            return lIt->second;
+        }
+        const int lWidth = (int)ceilf(rEntry.mBounds.width) + 1 + 2 * CELL_PADDING;
+        const int lHeight = (int)ceilf(rEntry.mBounds.height) + 1 + 2 * CELL_PADDING;
+        if (lWidth > mAtlasSize || lHeight > mAtlasSize) {
+            return NO_CELL;
+        }
+        // Shelf packing: fill rows left to right, open a new row when full
+        if (mShelfX + lWidth > mAtlasSize) {
+            mShelfY += mShelfHeight;
+            mShelfX = 0;
+            mShelfHeight = 0;
+        }
+        if (mShelfY + lHeight > mAtlasSize) {
+            rOverflow = true;
+            return NO_CELL;
+        }
+        const uint32_t lCell = (uint32_t)mCells.size();
+        mCells.push_back(Rectangle{ (float)mShelfX, (float)mShelfY, (float)lWidth, (float)lHeight });
+        mCellOf.emplace(rEntry.mKey, lCell);
+        mNewCells.push_back((uint32_t)(&rEntry - mEntries.data()));
+        mShelfX += lWidth;
+        mShelfHeight = lHeight > mShelfHeight ? lHeight : mShelfHeight;
+        return lCell;
+    }
+
+    void bakeNewCells() {
+        if (mNewCells.empty()) {
+            return;
+        }
+        BeginTextureMode(mAtlas);
+        if (mCells.size() == mNewCells.size()) {
+            // First faces since the atlas was (re)started
+            ClearBackground(BLANK);
+        }
+        // Premultiplied color with coverage alpha, as in RenderCache
+        rlSetBlendFactorsSeparate(RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE, RL_ONE_MINUS_SRC_ALPHA, RL_FUNC_ADD,
+                                  RL_FUNC_ADD);
+        BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+        for (const uint32_t lIndex : mNewCells) {
+            const Entry& rEntry = mEntries[lIndex];
+            const Rectangle lCell = mCells[rEntry.mCell];
+            rlPushMatrix();
+            rlTranslatef(lCell.x + (float)CELL_PADDING - floorf(rEntry.mBounds.x),
+                         lCell.y + (float)CELL_PADDING - floorf(rEntry.mBounds.y), 0.0f);
+            rEntry.mDrawFace(rEntry.mpGauge);
+            rlPopMatrix();
+            mBakeCount++;
+        }
+        EndBlendMode();
+        EndTextureMode();
+        mNewCells.clear();
+    }
+
+    int mAtlasSize;
+    RenderTexture2D mAtlas{};
+    std::unordered_map<uint64_t, uint32_t> mCellOf; // face key -> cell
+    std::vector<Rectangle> mCells;
+    std::vector<Entry> mEntries;
+    std::vector<uint32_t> mNewCells; // entries whose face is baked this frame
+    int mShelfX = 0;
+    int mShelfY = 0;
+    int mShelfHeight = 0;
+    size_t mFramesSinceReset = RESET_INTERVAL;
+    size_t mBakeCount = 0;
+    size_t mDirectFaces = 0;
+};
+
+} // namespace RLCharts
@@ -0,0 +1,99 @@
+// RLGpuColormap.h
+#pragma once
+#include "raylib.h"
+#include "rlgl.h"
+#include <string>
+
+// Helpers for colormapping scalar grids on the GPU.
+// A chart uploads its raw float grid as a single-channel (R32F) texture and its
+// 256-entry LUT as a 256x1 RGBA texture; a fragment shader does normalization and
+// the LUT lookup, so the CPU never touches individual pixels. Fragment bodies are
+// written once against the macros below and get a GLSL 330 or GLSL ES 100 header
+// depending on the running context.
+
+namespace RLCharts {
+
+inline bool isGlesContext() {
+    const int lVersion = rlGetVersion();
+    return lVersion == RL_OPENGL_ES_20 || lVersion == RL_OPENGL_ES_30;
+}
+
+// Compile a colormap fragment shader on top of raylib's default vertex shader.
+// The body may use: fragTexCoord, fragColor, texture0, GRID_TEXTURE(sampler, uv)
+// and must assign FRAG_OUT.
+inline Shader loadColormapShader(const char* pFragmentBody) {
+    std::string lCode;
+    if (isGlesContext()) {
+        lCode = "#version 100\n"
+                "precision highp float;\n"
+                "varying vec2 fragTexCoord;\n"
+                "varying vec4 fragColor;\n"
+                "#define GRID_TEXTURE texture2D\n"
+                "#define FRAG_OUT gl_FragColor\n";
+    } else {
+        lCode = "#version 330\n"
+                "in vec2 fragTexCoord;\n"
+                "in vec4 fragColor;\n"
+                "out vec4 finalColor;\n"
+                "#define GRID_TEXTURE texture\n"
+                "#define FRAG_OUT finalColor\n";
+    }
+    lCode += "uniform sampler2D texture0;\n";
+    lCode += pFragmentBody;
+    return LoadShaderFromMemory(nullptr, lCode.c_str());
+}
+
+// Single-channel float texture for a row-major aWidth x aHeight grid (id 0 if float
+// textures are unsupported, e.g. WebGL 1 without OES_texture_float)
+inline Texture2D loadFloatGridTexture(int aWidth, int aHeight, const float* pData, bool aLinear) {
+    Image lImg = {};
+    lImg.data = (void*)pData;
+    lImg.width = aWidth;
+    lImg.height = aHeight;
+    lImg.mipmaps = 1;
+    lImg.format = PIXELFORMAT_UNCOMPRESSED_R32;
+    Texture2D lTexture = LoadTextureFromImage(lImg);
+    if (lTexture.id != 0) {
+        SetTextureWrap(lTexture, TEXTURE_WRAP_CLAMP);
+        // Linear filtering of float textures needs an extension on GLES
+        SetTextureFilter(lTexture, (aLinear && !isGlesContext()) ? TEXTURE_FILTER_BILINEAR : TEXTURE_FILTER_POINT);
+    }
+    return lTexture;
+}
+
+// aSize x 1 RGBA texture holding a colormap LUT (RLColormap.h)
+inline Texture2D loadLutTexture(const Color* pLut, int aSize = 256) {
+    Image lImg = {};
+    lImg.data = (void*)pLut;
+    lImg.width = aSize;
+    lImg.height = 1;
+    lImg.mipmaps = 1;
+    lImg.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+    Texture2D lTexture = LoadTextureFromImage(lImg);
+    if (lTexture.id != 0) {
+        SetTextureWrap(lTexture, TEXTURE_WRAP_CLAMP);
+        SetTextureFilter(lTexture, TEXTURE_FILTER_POINT);
+    }
+    return lTexture;
+}
+
+// GLSL helper shared by the colormap shaders: same index math as the CPU path
+// (truncate value * invMax * 255, clamp to [0, 255]) then fetch the LUT texel center.
+// On a wider LUT texture each of the 256 steps samples its nearest entry.
+inline const char* colormapLookupGlsl() {
+    return "vec4 lutLookup(sampler2D aLut, float aValue, float aInvMax) {\n"
+           "    float lIdx = floor(clamp(aValue * aInvMax * 255.0, 0.0, 255.0));\n"
+           "    return GRID_TEXTURE(aLut, vec2((lIdx + 0.5) / 256.0, 0.5));\n"
+           "}\n";
+}
+
+// Continuous variant for high-resolution LUTs: no 256-step quantization, so a
+// 4096-entry texture gives banding-free gradients (aSize = LUT texture width)
+inline const char* colormapSmoothLookupGlsl() {
+    return "vec4 lutLookupSmooth(sampler2D aLut, float aValue, float aInvMax, float aSize) {\n"
+           "    float lT = clamp(aValue * aInvMax, 0.0, 1.0);\n"
+           "    return GRID_TEXTURE(aLut, vec2((lT * (aSize - 1.0) + 0.5) / aSize, 0.5));\n"
+           "}\n";
+}
+
+} // namespace RLCharts
@@ -0,0 +1,322 @@
+// RLGpuStaging.h
+#pragma once
+#include "raylib.h"
+#include "rlgl.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Staging for charts whose update is split into prepare(dt) and commit().
+// prepare() does the CPU work on any thread and records the GPU uploads it would
+// have made into an UploadList, together with a copy of the bytes, so the chart
+// can keep changing its own buffers afterwards. commit() runs on the render
+// thread, creates missing GL resources and replays the list.
+//
+// StagingBuffers double-buffers a chart's staged frame: prepare() fills one slot
+// while commit() may still be uploading the other, so preparing frame N+1 can
+// overlap committing frame N. If prepare() runs again before the previous slot was
+// committed, it takes that slot back and appends to it; replaying uploads in order
+// leaves the latest data on the GPU either way.
+//
+// Upload targets are addressed through pointers to the chart's resource handles
+// (Texture2D, Mesh, VBO id) and resolved at replay time, so a resource created by
+// commit() just before the replay receives the staged data.
+//
+// The staged bytes live in blocks that are never moved, so the memory returned
+// for one upload stays valid while further uploads are added (until clear()):
+// a chart may take several staging pointers and fill them together.
+//
+// Every upload the charts make (replayed lists and the instanced batches' own
+// buffer updates) is also tallied in the process-wide GpuUploadCounters, so tests
+// can pin upload budgets such as "an idle heat map uploads nothing".
+
+namespace RLCharts {
+
+// Bytes sent to the GPU since the start of the process, by kind. Always on: the
+// cost is one relaxed atomic add per upload call, not per byte.
+struct GpuUploadCounters {
+    std::atomic<uint64_t> mTextureBytes{ 0 }; // UpdateTexture / UpdateTextureRec
+    std::atomic<uint64_t> mBufferBytes{ 0 };  // mesh and vertex buffer updates
+    std::atomic<uint64_t> mUploadCount{ 0 };
+
+    [[nodiscard]] uint64_t getTotalBytes() const {
+        return mTextureBytes.load(std::memory_order_relaxed) + mBufferBytes.load(std::memory_order_relaxed);
+    }
+};
+
+inline GpuUploadCounters& gpuUploadCounters() {
+    static GpuUploadCounters sCounters;
+    return sCounters;
+}
+
+inline void countTextureUpload(size_t aBytes) {
+    gpuUploadCounters().mTextureBytes.fetch_add(aBytes, std::memory_order_relaxed);
+    gpuUploadCounters().mUploadCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+inline void countBufferUpload(size_t aBytes) {
+    gpuUploadCounters().mBufferBytes.fetch_add(aBytes, std::memory_order_relaxed);
+    gpuUploadCounters().mUploadCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+class UploadList {
+public:
+    // Blocks are kept for the next frame
+    void clear() {
+        mOps.clear();
+        for (Block& rBlock : mBlocks) {
+            rBlock.mUsed = 0;
+        }
+        mBlock = 0;
+        mByteCount = 0;
+    }
+
+    [[nodiscard]] bool empty() const { return mOps.empty(); }
+    [[nodiscard]] size_t getByteCount() const { return mByteCount; }
+
+    // Whole texture; returns aBytes of staging memory to fill
+    void* texture(const Texture2D* pTexture, size_t aBytes) {
+        return addOp(Kind::TEXTURE, pTexture, Rectangle{}, 0, aBytes);
+    }
+    // Sub-rectangle of a texture, rows packed (aRect.width texels per row)
+    void* textureRect(const Texture2D* pTexture, Rectangle aRect, size_t aBytes) {
+        return addOp(Kind::TEXTURE_RECT, pTexture, aRect, 0, aBytes);
+    }
+    // Vertex buffer aIndex of a mesh uploaded with UploadMesh(), at byte aOffset
+    void* meshBuffer(const Mesh* pMesh, int aIndex, size_t aBytes, int aOffset = 0) {
+        return addOp(Kind::MESH_BUFFER, pMesh, Rectangle{ (float)aIndex, 0.0f, 0.0f, 0.0f }, aOffset, aBytes);
+    }
+    // Raw vertex buffer (rlLoadVertexBuffer id), at byte aOffset
+    void* vertexBuffer(const unsigned int* pBufferId, size_t aBytes, int aOffset = 0) {
+        return addOp(Kind::VERTEX_BUFFER, pBufferId, Rectangle{}, aOffset, aBytes);
+    }
+
+    void texture(const Texture2D* pTexture, const void* pData, size_t aBytes) {
+        std::memcpy(texture(pTexture, aBytes), pData, aBytes);
+    }
+    void textureRect(const Texture2D* pTexture, Rectangle aRect, const void* pData, size_t aBytes) {
+        std::memcpy(textureRect(pTexture, aRect, aBytes), pData, aBytes);
+    }
+    void meshBuffer(const Mesh* pMesh, int aIndex, const void* pData, size_t aBytes, int aOffset = 0) {
+        std::memcpy(meshBuffer(pMesh, aIndex, aBytes, aOffset), pData, aBytes);
+    }
+    void vertexBuffer(const unsigned int* pBufferId, const void* pData, size_t aBytes, int aOffset = 0) {
+        std::memcpy(vertexBuffer(pBufferId, aBytes, aOffset), pData, aBytes);
+    }
+
+    // True if the list replaces the whole of pTexture (a freshly created texture
+    // then needs nothing else)
+    [[nodiscard]] bool coversTexture(const Texture2D* pTexture) const {
+        for (const Op& rOp : mOps) {
+            if (rOp.mKind == Kind::TEXTURE && rOp.mpTarget == pTexture) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Render thread: issue the uploads in recording order and return the bytes
+    // sent. Targets that do not exist (id 0) are skipped, and so are mesh uploads
+    // that no longer fit their buffer (staged before the mesh was rebuilt smaller)
+    size_t replay() const {
+        size_t lSent = 0;
+        for (const Op& rOp : mOps) {
+            const unsigned char* pData = rOp.mpData;
+            switch (rOp.mKind) {
+                case Kind::TEXTURE: {
+                    const auto* pTexture = static_cast<const Texture2D*>(rOp.mpTarget);
+                    if (pTexture->id == 0) {
+                        continue;
+                    }
+                    UpdateTexture(*pTexture, pData);
+                    countTextureUpload(rOp.mSize);
+                    break;
+                }
+                case Kind::TEXTURE_RECT: {
+                    const auto* pTexture = static_cast<const Texture2D*>(rOp.mpTarget);
+                    if (pTexture->id == 0) {
+                        continue;
+                    }
+                    UpdateTextureRec(*pTexture, rOp.mRect, pData);
+                    countTextureUpload(rOp.mSize);
+                    break;
+                }
+                case Kind::MESH_BUFFER: {
+                    const auto* pMesh = static_cast<const Mesh*>(rOp.mpTarget);
+                    const auto lIndex = (int)rOp.mRect.x;
+                    if (pMesh->vboId == nullptr || pMesh->vboId[lIndex] == 0 ||
+                        (size_t)rOp.mTargetOffset + rOp.mSize > meshBufferBytes(*pMesh, lIndex)) {
+                        continue;
+                    }
+                    rlUpdateVertexBuffer(pMesh->vboId[lIndex], pData, (int)rOp.mSize, rOp.mTargetOffset);
+                    countBufferUpload(rOp.mSize);
+                    break;
+                }
+                case Kind::VERTEX_BUFFER: {
+                    const unsigned int lId = *static_cast<const unsigned int*>(rOp.mpTarget);
+                    if (lId == 0) {
+                        continue;
+                    }
+                    rlUpdateVertexBuffer(lId, pData, (int)rOp.mSize, rOp.mTargetOffset);
+                    countBufferUpload(rOp.mSize);
+                    break;
+                }
+            }
+            lSent += rOp.mSize;
+        }
+        return lSent;
+    }
+
+private:
+    enum class Kind { TEXTURE, TEXTURE_RECT, MESH_BUFFER, VERTEX_BUFFER };
+
+    struct Op {
+        Kind mKind{ Kind::TEXTURE };
+        const void* mpTarget{ nullptr };
+        Rectangle mRect{};     // texture sub-rectangle, or the mesh buffer index in x
+        int mTargetOffset{ 0 };
+        const unsigned char* mpData{ nullptr };
+        size_t mSize{ 0 };
+    };
+
+    struct Block {
+        std::unique_ptr<unsigned char[]> mpData;
+        size_t mCapacity{ 0 };
+        size_t mUsed{ 0 };
+    };
+
+    static constexpr size_t DATA_ALIGN = 16;
+    // Smallest block; larger uploads get a block of their own size
+    static constexpr size_t BLOCK_BYTES = 256 * 1024;
+
+    // Size of a mesh vertex buffer in UploadMesh()'s layout
+    static size_t meshBufferBytes(const Mesh& rMesh, int aIndex) {
+        static constexpr size_t BYTES_PER_VERTEX[] = {
+            3 * sizeof(float), // positions
+            2 * sizeof(float), // texcoords
+            3 * sizeof(float), // normals
+            4,                 // colors
+            4 * sizeof(float), // tangents
+            2 * sizeof(float)  // texcoords2
+        };
+        if (aIndex < 0 || aIndex >= (int)(sizeof(BYTES_PER_VERTEX) / sizeof(BYTES_PER_VERTEX[0]))) {
+            return SIZE_MAX;
+        }
+        return (size_t)rMesh.vertexCount * BYTES_PER_VERTEX[aIndex];
+    }
+
+    void* addOp(Kind aKind, const void* pTarget, Rectangle aRect, int aTargetOffset, size_t aBytes) {
+        Op lOp;
+        lOp.mKind = aKind;
+        lOp.mpTarget = pTarget;
+        lOp.mRect = aRect;
+        lOp.mTargetOffset = aTargetOffset;
+        lOp.mSize = aBytes;
+        unsigned char* pData = allocate(aBytes);
+        lOp.mpData = pData;
+        mOps.push_back(lOp);
+        mByteCount += aBytes;
+        return pData;
+    }
+
+    // Next aBytes in the current block, else in the first later block they fit
+    // (blocks skipped stay unused until clear())
+    unsigned char* allocate(size_t aBytes) {
+        for (; mBlock < mBlocks.size(); mBlock++) {
+            Block& rBlock = mBlocks[mBlock];
+            const size_t lOffset = (rBlock.mUsed + DATA_ALIGN - 1) & ~(DATA_ALIGN - 1);
+            if (lOffset + aBytes <= rBlock.mCapacity) {
+                rBlock.mUsed = lOffset + aBytes;
+                return rBlock.mpData.get() + lOffset;
+            }
+        }
+        Block lBlock;
+        lBlock.mCapacity = aBytes > BLOCK_BYTES ? aBytes : BLOCK_BYTES;
+        lBlock.mpData = std::make_unique<unsigned char[]>(lBlock.mCapacity);
+        lBlock.mUsed = aBytes;
+        mBlocks.push_back(std::move(lBlock));
+        return mBlocks.back().mpData.get();
+    }
+
+    std::vector<Op> mOps;
+    std::vector<Block> mBlocks; // kept across frames
+    size_t mBlock{ 0 };         // block the next upload starts looking in
+    size_t mByteCount{ 0 };
+};
+
+// Two staged frames of type T (which provides clear()) handed between prepare()
+// and commit(); at most one prepare() and one commit() at a time
+template<typename T>
+class StagingBuffers {
+public:
+    StagingBuffers() = default;
+    StagingBuffers(const StagingBuffers&) = delete;
+    StagingBuffers& operator=(const StagingBuffers&) = delete;
+
+    // prepare(): the slot to fill (the uncommitted one if there is one)
+    T& beginPrepare() {
+        std::lock_guard<std::mutex> lLock(mMutex);
+        if (mPublished >= 0) {
+            mPreparing = mPublished;
+            mPublished = -1;
+        } else {
+            mPreparing = mCommitting == 0 ? 1 : 0;
+        }
+        return mSlots[mPreparing];
+    }
+
+    // prepare(): hand the filled slot to the next commit()
+    void endPrepare() {
+        std::lock_guard<std::mutex> lLock(mMutex);
+        mPublished = mPreparing;
+        mPreparing = -1;
+    }
+
+    // commit(): the last prepared slot, or nullptr if nothing was prepared since
+    T* beginCommit() {
+        std::lock_guard<std::mutex> lLock(mMutex);
+        if (mPublished < 0) {
+            return nullptr;
+        }
+        mCommitting = mPublished;
+        mPublished = -1;
+        return &mSlots[mCommitting];
+    }
+
+    // commit(): done with the slot; it is cleared for reuse
+    void endCommit() {
+        std::lock_guard<std::mutex> lLock(mMutex);
+        if (mCommitting >= 0) {
+            mSlots[mCommitting].clear();
+            mCommitting = -1;
+        }
+    }
+
+    // A prepared frame is waiting for commit()
+    [[nodiscard]] bool hasPending() const {
+        std::lock_guard<std::mutex> lLock(mMutex);
+        return mPublished >= 0;
+    }
+
+    // Drop staged frames (e.g. after a resize invalidated their targets); not
+    // while prepare() or commit() runs
+    void discard() {
+        std::lock_guard<std::mutex> lLock(mMutex);
+        mSlots[0].clear();
+        mSlots[1].clear();
+        mPublished = -1;
+    }
+
+private:
+    mutable std::mutex mMutex;
+    T mSlots[2];
+    int mPreparing{ -1 };
+    int mPublished{ -1 };
+    int mCommitting{ -1 };
+};
+
+} // namespace RLCharts
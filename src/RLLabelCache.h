@@ -0,0 +1,153 @@
+// RLLabelCache.h
+#pragma once
+#include "raylib.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+// Text measurement cache for charts that draw the same labels every frame.
+// MeasureTextEx walks every codepoint of the string; LabelCache keeps the result
+// per (text, font, size, spacing), so a settled chart measures each label once.
+// Lookups reuse one key buffer and do not allocate after warm-up. The cache is
+// cleared when it grows past its entry limit (labels built from changing numbers
+// would otherwise accumulate), and should be cleared when a font is reloaded.
+//
+// FormattedLabel keeps the text of one numeric label and only reformats it when
+// the value (or format) changes, e.g. one per axis tick:
+//   const char* pText = mTickLabels[i].format("%.0f", lTick.mValue);
+//   const Vector2 lSize = mLabelCache.measure(lFont, pText, lFontSize, 0.0f);
+//
+// Both are meant as mutable members of a chart (draw() is const); they are not
+// shared between threads.
+
+namespace RLCharts {
+
+class LabelCache {
+public:
+    static constexpr size_t DEFAULT_MAX_ENTRIES = 4096;
+
+    explicit LabelCache(size_t aMaxEntries = DEFAULT_MAX_ENTRIES) : mMaxEntries(aMaxEntries) {}
+
+    // Same as MeasureTextEx(rFont, pText, aFontSize, aSpacing)
+    [[nodiscard]] Vector2 measure(const Font& rFont, const char* pText, float aFontSize, float aSpacing) {
+        setKey(pText, fontId(rFont), aFontSize, aSpacing);
+        const auto lIt = mEntries.find(mKey);
+        if (lIt != mEntries.end()) {
+            mHits++;
+            return lIt->second;
+        }
+        const Vector2 lSize = MeasureTextEx(rFont, pText, aFontSize, aSpacing);
+        insert(lSize);
+        return lSize;
+    }
+
+    // Same as MeasureText(pText, aFontSize) (default font, integer width)
+    [[nodiscard]] int measureDefault(const char* pText, int aFontSize) {
+        setKey(pText, DEFAULT_FONT_ID, (float)aFontSize, -1.0f);
+        const auto lIt = mEntries.find(mKey);
+        if (lIt != mEntries.end()) {
+            mHits++;
+            return (int)lIt->second.x;
+        }
+        const int lWidth = MeasureText(pText, aFontSize);
+        insert(Vector2{ (float)lWidth, (float)aFontSize });
+        return lWidth;
+    }
+
+    void clear() { mEntries.clear(); }
+
+    [[nodiscard]] size_t size() const { return mEntries.size(); }
+    // Lookups answered from the cache / measured, since construction
+    [[nodiscard]] size_t getHits() const { return mHits; }
+    [[nodiscard]] size_t getMisses() const { return mMisses; }
+
+private:
+    // Default-font lookups sort apart from any loaded font's texture id
+    static constexpr uint64_t DEFAULT_FONT_ID = 0xFFFFFFFFFFFFFFFFull;
+
+    struct Key {
+        std::string mText;
+        uint64_t mFont = 0;
+        float mSize = 0.0f;
+        float mSpacing = 0.0f;
+
+        bool operator==(const Key& rOther) const {
+            return mFont == rOther.mFont && mSize == rOther.mSize && mSpacing == rOther.mSpacing &&
+                   mText == rOther.mText;
+        }
+    };
+    struct KeyHash {
+        size_t operator()(const Key& rKey) const {
+            uint32_t lSize = 0;
+            uint32_t lSpacing = 0;
+            std::memcpy(&lSize, &rKey.mSize, sizeof(lSize));
+            std::memcpy(&lSpacing, &rKey.mSpacing, sizeof(lSpacing));
+            size_t lHash = std::hash<std::string>()(rKey.mText);
+            lHash ^= (size_t)(rKey.mFont * 0x9E3779B97F4A7C15ull) + (lHash << 6) + (lHash >> 2);
+            lHash ^= (size_t)(((uint64_t)lSize << 32) | lSpacing) * (size_t)0xC2B2AE3D27D4EB4Full;
+            return lHash;
+        }
+    };
+
+    // The texture id identifies a loaded font; the size fields catch a different
+    // font reloaded under a recycled id
+    [[nodiscard]] static uint64_t fontId(const Font& rFont) {
+        return ((uint64_t)rFont.texture.id << 32) ^ ((uint64_t)(uint32_t)rFont.baseSize << 16) ^
+               (uint64_t)(uint32_t)rFont.glyphCount;
+    }
+
+    void setKey(const char* pText, uint64_t aFont, float aSize, float aSpacing) {
+        mKey.mText.assign(pText != nullptr ? pText : "");
+        mKey.mFont = aFont;
+        mKey.mSize = aSize;
+        mKey.mSpacing = aSpacing;
+    }
+
+    void insert(Vector2 aSize) {
+        mMisses++;
+        if (mEntries.size() >= mMaxEntries) {
+            mEntries.clear();
+        }
+        mEntries.emplace(mKey, aSize);
+    }
+
+    std::unordered_map<Key, Vector2, KeyHash> mEntries;
+    Key mKey; // lookup buffer, keeps its capacity
+    size_t mMaxEntries;
+    size_t mHits = 0;
+    size_t mMisses = 0;
+};
+
+// Text of one label with a single numeric argument, formatted on change only
+class FormattedLabel {
+public:
+    // pFormat takes exactly one argument of type T (e.g. "%.0f" with a double,
+    // "10^%d" with an int)
+    template<typename T>
+    const char* format(const char* pFormat, T aValue) {
+        const double lValue = (double)aValue;
+        if (pFormat != mpFormat || !(lValue == mValue)) {
+            snprintf(mText, sizeof(mText), pFormat, aValue);
+            mpFormat = pFormat;
+            mValue = lValue;
+            mFormatCount++;
+        }
+        return mText;
+    }
+
+    [[nodiscard]] const char* getText() const { return mText; }
+    // Number of times the text was actually formatted
+    [[nodiscard]] size_t getFormatCount() const { return mFormatCount; }
+
+private:
+    char mText[48] = {};
+    const char* mpFormat = nullptr;
+    double mValue = 0.0;
+    size_t mFormatCount = 0;
+};
+
+} // namespace RLCharts
@@ -0,0 +1,455 @@
+// RLLineBatch.h
+#pragma once
+#include "raylib.h"
+#include "rlgl.h"
+#include "raymath.h"
+#include "RLCommon.h"
+#include "RLGpuStaging.h"
+#include <vector>
+#include <cstddef>
+#include <utility>
+
+// Batched line and marker renderer shared by the polyline-heavy charts.
+// Thick polylines are expanded into a mitered triangle strip and point markers
+// into triangle fans, all collected into one triangle list instead of one
+// DrawLineEx/DrawCircleV call (and one batch-limit check) per segment/point.
+// Geometry is kept until clear(), so a chart can rebuild it only when its data
+// or style changed and draw the cached triangles every frame.
+//
+// draw() uploads the triangles into GPU vertex buffers only after they changed
+// (buffers grow in powers of two) and draws them with one call, so a settled
+// trace costs no vertex submission at all. That needs desktop OpenGL 3.3; on
+// GLES/WebGL (or if the shader fails to compile) draw() replays the triangles
+// through rlgl's immediate batch instead. GPU resources are created on the first
+// draw() and owned by the batch, as in RLCircleBatch.h: a copy only takes the
+// triangles and creates its own resources when drawn.
+
+namespace RLCharts {
+
+class LineBatch {
+public:
+    LineBatch() = default;
+    ~LineBatch() { unload(); }
+
+    LineBatch(const LineBatch& rOther) : mPositions(rOther.mPositions), mColors(rOther.mColors) {}
+    LineBatch& operator=(const LineBatch& rOther) {
+        if (this != &rOther) {
+            mPositions = rOther.mPositions;
+            mColors = rOther.mColors;
+            mDirty = true;
+        }
+        return *this;
+    }
+    LineBatch(LineBatch&& rOther) noexcept { swapWith(rOther); }
+    LineBatch& operator=(LineBatch&& rOther) noexcept {
+        if (this != &rOther) {
+            unload();
+            swapWith(rOther);
+        }
+        return *this;
+    }
+
+    void clear() {
+        mPositions.clear();
+        mColors.clear();
+        mDirty = true;
+    }
+    [[nodiscard]] bool empty() const { return mPositions.empty(); }
+    [[nodiscard]] size_t getVertexCount() const { return mPositions.size(); }
+    [[nodiscard]] size_t getTriangleCount() const { return mPositions.size() / 3; }
+    // Whether the last draw() went through the vertex buffers
+    [[nodiscard]] bool wasBuffered() const { return mReady; }
+
+    // Single thick segment (same footprint as DrawLineEx)
+    void addSegment(Vector2 aFrom, Vector2 aTo, float aThickness, Color aColor) {
+        const float lDx = aTo.x - aFrom.x;
+        const float lDy = aTo.y - aFrom.y;
+        const float lLen = sqrtf(lDx * lDx + lDy * lDy);
+        if (lLen <= 0.0f || aThickness <= 0.0f) {
+            return;
+        }
+        const float lScale = aThickness * 0.5f / lLen;
+        const Vector2 lN{ -lDy * lScale, lDx * lScale };
+        const Vector2 lA{ aFrom.x + lN.x, aFrom.y + lN.y };
+        const Vector2 lB{ aFrom.x - lN.x, aFrom.y - lN.y };
+        const Vector2 lC{ aTo.x + lN.x, aTo.y + lN.y };
+        const Vector2 lD{ aTo.x - lN.x, aTo.y - lN.y };
+        addTriangle(lA, lB, lC, aColor);
+        addTriangle(lB, lD, lC, aColor);
+    }
+
+    // Connected thick polyline with mitered joins (no gaps between segments)
+    void addPolyline(const Vector2* pPoints, size_t aCount, float aThickness, Color aColor) {
+        if (pPoints == nullptr) {
+            return;
+        }
+        addPolylineFrom([pPoints](size_t aIndex) { return pPoints[aIndex]; }, aCount, aThickness, aColor);
+    }
+
+    // Same for a polyline stored in two pieces (a wrapped ring buffer): pFirst
+    // continues with pSecond, joined like any other two segments
+    void addPolyline(const Vector2* pFirst, size_t aFirstCount, const Vector2* pSecond, size_t aSecondCount,
+                     float aThickness, Color aColor) {
+        if ((pFirst == nullptr && aFirstCount > 0) || (pSecond == nullptr && aSecondCount > 0)) {
+            return;
+        }
+        addPolylineFrom([pFirst, pSecond, aFirstCount](size_t aIndex) {
+            return aIndex < aFirstCount ? pFirst[aIndex] : pSecond[aIndex - aFirstCount];
+        }, aFirstCount + aSecondCount, aThickness, aColor);
+    }
+
+    // Filled triangle strip (same vertex order as DrawTriangleStrip)
+    void addTriangleStrip(const Vector2* pPoints, size_t aCount, Color aColor) {
+        if (pPoints == nullptr || aCount < 3) {
+            return;
+        }
+        reserveVertices((aCount - 2) * 3);
+        for (size_t i = 2; i < aCount; ++i) {
+            addTriangle(pPoints[i - 2], pPoints[i - 1], pPoints[i], aColor);
+        }
+    }
+
+    // Filled circle marker
+    void addCircle(Vector2 aCenter, float aRadius, Color aColor) {
+        if (aRadius <= 0.0f) {
+            return;
+        }
+        const int lSegments = circleSegments(aRadius);
+        const float lStep = 2.0f * PI / (float)lSegments;
+        Vector2 lPrev{ aCenter.x + aRadius, aCenter.y };
+        for (int i = 1; i <= lSegments; ++i) {
+            const float lAngle = lStep * (float)i;
+            const Vector2 lCur{ aCenter.x + cosf(lAngle) * aRadius, aCenter.y + sinf(lAngle) * aRadius };
+            addTriangle(aCenter, lPrev, lCur, aColor);
+            lPrev = lCur;
+        }
+    }
+
+    // Circle outline with the given line thickness (centered on aRadius)
+    void addCircleOutline(Vector2 aCenter, float aRadius, float aThickness, Color aColor) {
+        if (aRadius <= 0.0f || aThickness <= 0.0f) {
+            return;
+        }
+        const float lInner = RLCharts::maxVal(0.0f, aRadius - aThickness * 0.5f);
+        const float lOuter = aRadius + aThickness * 0.5f;
+        const int lSegments = circleSegments(lOuter);
+        const float lStep = 2.0f * PI / (float)lSegments;
+        Vector2 lPrevIn{ aCenter.x + lInner, aCenter.y };
+        Vector2 lPrevOut{ aCenter.x + lOuter, aCenter.y };
+        for (int i = 1; i <= lSegments; ++i) {
+            const float lCos = cosf(lStep * (float)i);
+            const float lSin = sinf(lStep * (float)i);
+            const Vector2 lIn{ aCenter.x + lCos * lInner, aCenter.y + lSin * lInner };
+            const Vector2 lOut{ aCenter.x + lCos * lOuter, aCenter.y + lSin * lOuter };
+            addTriangle(lPrevIn, lPrevOut, lOut, aColor);
+            addTriangle(lPrevIn, lOut, lIn, aColor);
+            lPrevIn = lIn;
+            lPrevOut = lOut;
+        }
+    }
+
+    void addTriangle(Vector2 aA, Vector2 aB, Vector2 aC, Color aColor) {
+        // rlgl culls clockwise faces: keep every triangle counter-clockwise on screen
+        const float lCross = (aB.x - aA.x) * (aC.y - aA.y) - (aB.y - aA.y) * (aC.x - aA.x);
+        if (lCross == 0.0f) {
+            return;
+        }
+        if (lCross < 0.0f) {
+            pushVertices(aA, aColor, aB, aColor, aC, aColor);
+        } else {
+            pushVertices(aA, aColor, aC, aColor, aB, aColor);
+        }
+    }
+
+    // Triangle with a color per vertex (gradients)
+    void addTriangle(Vector2 aA, Color aColorA, Vector2 aB, Color aColorB, Vector2 aC, Color aColorC) {
+        const float lCross = (aB.x - aA.x) * (aC.y - aA.y) - (aB.y - aA.y) * (aC.x - aA.x);
+        if (lCross == 0.0f) {
+            return;
+        }
+        if (lCross < 0.0f) {
+            pushVertices(aA, aColorA, aB, aColorB, aC, aColorC);
+        } else {
+            pushVertices(aA, aColorA, aC, aColorC, aB, aColorB);
+        }
+    }
+
+    // Draw all collected geometry
+    void draw() const {
+        if (mPositions.empty()) {
+            return;
+        }
+        if (ensureResources()) {
+            drawBuffered();
+            return;
+        }
+        drawImmediate();
+    }
+
+    // Release the GPU resources (needs the GL context; done by the destructor)
+    void unload() {
+        if (mShader.id != 0) {
+            UnloadShader(mShader);
+        }
+        mShader = Shader{};
+        releaseBuffers();
+        mReady = false;
+        mFailed = false;
+        mDirty = true;
+    }
+
+private:
+    // Multiple of 3 that fits well inside rlgl's default vertex batch
+    static constexpr size_t DRAW_CHUNK_VERTICES = 3 * 2048;
+
+    void swapWith(LineBatch& rOther) {
+        std::swap(mPositions, rOther.mPositions);
+        std::swap(mColors, rOther.mColors);
+        std::swap(mDirty, rOther.mDirty);
+        std::swap(mReady, rOther.mReady);
+        std::swap(mFailed, rOther.mFailed);
+        std::swap(mShader, rOther.mShader);
+        std::swap(mLocMvp, rOther.mLocMvp);
+        std::swap(mLocPosition, rOther.mLocPosition);
+        std::swap(mLocColor, rOther.mLocColor);
+        std::swap(mVao, rOther.mVao);
+        std::swap(mPositionVbo, rOther.mPositionVbo);
+        std::swap(mColorVbo, rOther.mColorVbo);
+        std::swap(mCapacity, rOther.mCapacity);
+    }
+
+    void reserveVertices(size_t aMore) {
+        mPositions.reserve(mPositions.size() + aMore);
+        mColors.reserve(mColors.size() + aMore);
+    }
+
+    void pushVertices(Vector2 aA, Color aColorA, Vector2 aB, Color aColorB, Vector2 aC, Color aColorC) {
+        mPositions.push_back(aA);
+        mPositions.push_back(aB);
+        mPositions.push_back(aC);
+        mColors.push_back(aColorA);
+        mColors.push_back(aColorB);
+        mColors.push_back(aColorC);
+        mDirty = true;
+    }
+
+    // rlgl immediate mode, a few large RL_TRIANGLES blocks
+    void drawImmediate() const {
+        const size_t lCount = mPositions.size();
+        for (size_t lStart = 0; lStart < lCount; lStart += DRAW_CHUNK_VERTICES) {
+            const size_t lEnd = RLCharts::minVal(lCount, lStart + DRAW_CHUNK_VERTICES);
+            // Flush up front if needed so a chunk never gets split mid-triangle
+            rlCheckRenderBatchLimit((int)(lEnd - lStart));
+            rlBegin(RL_TRIANGLES);
+            for (size_t i = lStart; i < lEnd; ++i) {
+                const Color& rColor = mColors[i];
+                rlColor4ub(rColor.r, rColor.g, rColor.b, rColor.a);
+                rlVertex2f(mPositions[i].x, mPositions[i].y);
+            }
+            rlEnd();
+        }
+    }
+
+    void releaseBuffers() const {
+        if (mVao != 0) {
+            rlUnloadVertexArray(mVao);
+        }
+        if (mPositionVbo != 0) {
+            rlUnloadVertexBuffer(mPositionVbo);
+        }
+        if (mColorVbo != 0) {
+            rlUnloadVertexBuffer(mColorVbo);
+        }
+        mVao = 0;
+        mPositionVbo = 0;
+        mColorVbo = 0;
+        mCapacity = 0;
+    }
+
+    [[nodiscard]] bool ensureResources() const {
+        if (mFailed) {
+            return false;
+        }
+        if (!mReady) {
+            // GLSL 330: desktop GL only
+            const int lVersion = rlGetVersion();
+            if (lVersion != RL_OPENGL_33 && lVersion != RL_OPENGL_43) {
+                mFailed = true;
+                return false;
+            }
+            const char* pVertex =
+                "#version 330\n"
+                "in vec2 vertexPosition;\n"
+                "in vec4 vertexColor;\n"
+                "uniform mat4 mvp;\n"
+                "out vec4 fragColor;\n"
+                "void main() {\n"
+                "    fragColor = vertexColor;\n"
+                "    gl_Position = mvp * vec4(vertexPosition, 0.0, 1.0);\n"
+                "}\n";
+            const char* pFragment =
+                "#version 330\n"
+                "in vec4 fragColor;\n"
+                "out vec4 finalColor;\n"
+                "void main() {\n"
+                "    finalColor = fragColor;\n"
+                "}\n";
+            mShader = LoadShaderFromMemory(pVertex, pFragment);
+            if (!IsShaderValid(mShader)) {
+                mShader = Shader{};
+                mFailed = true;
+                return false;
+            }
+            mLocMvp = GetShaderLocation(mShader, "mvp");
+            mLocPosition = GetShaderLocationAttrib(mShader, "vertexPosition");
+            mLocColor = GetShaderLocationAttrib(mShader, "vertexColor");
+            if (mLocPosition < 0 || mLocColor < 0) {
+                UnloadShader(mShader);
+                mShader = Shader{};
+                mFailed = true;
+                return false;
+            }
+            mReady = true;
+            mDirty = true;
+        }
+        if (mPositions.size() > mCapacity && !allocateBuffers(mPositions.size())) {
+            mReady = false;
+            mFailed = true;
+            return false;
+        }
+        if (mDirty) {
+            rlUpdateVertexBuffer(mPositionVbo, mPositions.data(), (int)(mPositions.size() * sizeof(Vector2)), 0);
+            rlUpdateVertexBuffer(mColorVbo, mColors.data(), (int)(mColors.size() * sizeof(Color)), 0);
+            countBufferUpload(mPositions.size() * (sizeof(Vector2) + sizeof(Color)));
+            mDirty = false;
+        }
+        return true;
+    }
+
+    // (Re)create the VAO with room for at least aCount vertices
+    [[nodiscard]] bool allocateBuffers(size_t aCount) const {
+        releaseBuffers();
+        size_t lCapacity = 1024;
+        while (lCapacity < aCount) {
+            lCapacity *= 2;
+        }
+        // Each rlLoadVertexBuffer leaves its buffer bound for the attribute setup after it
+        mVao = rlLoadVertexArray();
+        rlEnableVertexArray(mVao);
+        mPositionVbo = rlLoadVertexBuffer(nullptr, (int)(lCapacity * sizeof(Vector2)), true);
+        rlSetVertexAttribute((unsigned int)mLocPosition, 2, RL_FLOAT, false, 0, 0);
+        rlEnableVertexAttribute((unsigned int)mLocPosition);
+        mColorVbo = rlLoadVertexBuffer(nullptr, (int)(lCapacity * sizeof(Color)), true);
+        rlSetVertexAttribute((unsigned int)mLocColor, 4, RL_UNSIGNED_BYTE, true, 0, 0);
+        rlEnableVertexAttribute((unsigned int)mLocColor);
+        rlDisableVertexArray();
+
+        if (mVao == 0 || mPositionVbo == 0 || mColorVbo == 0) {
+            releaseBuffers();
+            return false;
+        }
+        mCapacity = lCapacity;
+        mDirty = true;
+        return true;
+    }
+
+    void drawBuffered() const {
+        // Flush whatever rlgl batched so far so the triangles keep their place in the draw order
+        rlDrawRenderBatchActive();
+        const Matrix lMvp = MatrixMultiply(MatrixMultiply(rlGetMatrixTransform(), rlGetMatrixModelview()),
+                                           rlGetMatrixProjection());
+        rlEnableShader(mShader.id);
+        rlSetUniformMatrix(mLocMvp, lMvp);
+        rlEnableVertexArray(mVao);
+        rlDrawVertexArray(0, (int)mPositions.size());
+        rlDisableVertexArray();
+        rlDisableShader();
+    }
+
+    static int circleSegments(float aRadius) {
+        return RLCharts::clamp((int)(aRadius * 4.0f), 12, 36);
+    }
+
+    // Polyline through rPointAt(0 .. aCount - 1)
+    template<typename PointAt>
+    void addPolylineFrom(const PointAt& rPointAt, size_t aCount, float aThickness, Color aColor) {
+        if (aCount < 2 || aThickness <= 0.0f) {
+            return;
+        }
+        const float lHalf = aThickness * 0.5f;
+        reserveVertices((aCount - 1) * 6);
+
+        // Normal of the first non-degenerate segment
+        size_t lPrev = 0;
+        Vector2 lPrevNormal{};
+        bool lHavePrev = false;
+        Vector2 lPrevLeft{};
+        Vector2 lPrevRight{};
+
+        for (size_t i = 1; i < aCount; ++i) {
+            const Vector2 lP0 = rPointAt(lPrev);
+            const Vector2 lP1 = rPointAt(i);
+            const float lDx = lP1.x - lP0.x;
+            const float lDy = lP1.y - lP0.y;
+            const float lLen = sqrtf(lDx * lDx + lDy * lDy);
+            if (lLen <= 1e-6f) {
+                continue;
+            }
+            const Vector2 lNormal{ -lDy / lLen, lDx / lLen };
+
+            if (!lHavePrev) {
+                lPrevLeft = { lP0.x + lNormal.x * lHalf, lP0.y + lNormal.y * lHalf };
+                lPrevRight = { lP0.x - lNormal.x * lHalf, lP0.y - lNormal.y * lHalf };
+                lHavePrev = true;
+            } else {
+                // Miter at lP0 between the previous and current segment
+                Vector2 lMiter{ lPrevNormal.x + lNormal.x, lPrevNormal.y + lNormal.y };
+                const float lMiterLen = sqrtf(lMiter.x * lMiter.x + lMiter.y * lMiter.y);
+                float lExtent = lHalf;
+                if (lMiterLen > 1e-6f) {
+                    lMiter.x /= lMiterLen;
+                    lMiter.y /= lMiterLen;
+                    const float lDot = lMiter.x * lNormal.x + lMiter.y * lNormal.y;
+                    lExtent = lDot > 0.5f ? lHalf / lDot : lHalf * 2.0f; // limit spikes
+                } else {
+                    lMiter = lNormal;
+                }
+                const Vector2 lLeft{ lP0.x + lMiter.x * lExtent, lP0.y + lMiter.y * lExtent };
+                const Vector2 lRight{ lP0.x - lMiter.x * lExtent, lP0.y - lMiter.y * lExtent };
+                addTriangle(lPrevLeft, lPrevRight, lLeft, aColor);
+                addTriangle(lPrevRight, lRight, lLeft, aColor);
+                lPrevLeft = lLeft;
+                lPrevRight = lRight;
+            }
+            lPrevNormal = lNormal;
+            lPrev = i;
+        }
+
+        if (!lHavePrev) {
+            return;
+        }
+        const Vector2 lEnd = rPointAt(lPrev);
+        const Vector2 lLeft{ lEnd.x + lPrevNormal.x * lHalf, lEnd.y + lPrevNormal.y * lHalf };
+        const Vector2 lRight{ lEnd.x - lPrevNormal.x * lHalf, lEnd.y - lPrevNormal.y * lHalf };
+        addTriangle(lPrevLeft, lPrevRight, lLeft, aColor);
+        addTriangle(lPrevRight, lRight, lLeft, aColor);
+    }
+
+    std::vector<Vector2> mPositions; // three per triangle, counter-clockwise on screen
+    std::vector<Color> mColors;      // per vertex
+    mutable bool mDirty = true;
+
+    // GPU state (created lazily by draw())
+    mutable bool mReady = false;
+    mutable bool mFailed = false;
+    mutable Shader mShader{};
+    mutable int mLocMvp = -1;
+    mutable int mLocPosition = -1;
+    mutable int mLocColor = -1;
+    mutable unsigned int mVao = 0;
+    mutable unsigned int mPositionVbo = 0;
+    mutable unsigned int mColorVbo = 0;
+    mutable size_t mCapacity = 0;
+};
+
+} // namespace RLCharts
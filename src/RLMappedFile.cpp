@@ -0,0 +1,142 @@
+// RLMappedFile.cpp
+#include "RLMappedFile.h"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace RLCharts {
+
+bool MappedFile::open(const char* pPath) {
+    close();
+#if defined(_WIN32)
+    HANDLE lFile = CreateFileA(pPath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                               FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (lFile == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    mpFile = (void*)lFile;
+    LARGE_INTEGER lSize;
+    if (!GetFileSizeEx(lFile, &lSize)) {
+        close();
+        return false;
+    }
+    mSize = (size_t)lSize.QuadPart;
+    if (mSize == 0) {
+        return true;
+    }
+    HANDLE lMapping = CreateFileMappingA(lFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (lMapping == nullptr) {
+        close();
+        return false;
+    }
+    mpMapping = (void*)lMapping;
+    mpData = (const char*)MapViewOfFile(lMapping, FILE_MAP_READ, 0, 0, 0);
+    if (mpData == nullptr) {
+        close();
+        return false;
+    }
+    mMapped = true;
+    return true;
+#else
+    const int lFd = ::open(pPath, O_RDONLY);
+    if (lFd < 0) {
+        return false;
+    }
+    struct stat lStat {};
+    if (fstat(lFd, &lStat) != 0) {
+        ::close(lFd);
+        return false;
+    }
+    mSize = (size_t)lStat.st_size;
+    if (mSize == 0) {
+        ::close(lFd);
+        return true;
+    }
+#if !defined(__EMSCRIPTEN__)
+    void* lpMap = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, lFd, 0);
+    if (lpMap != MAP_FAILED) {
+        ::close(lFd);
+        madvise(lpMap, mSize, MADV_SEQUENTIAL);
+        mpData = (const char*)lpMap;
+        mMapped = true;
+        return true;
+    }
+#endif
+    // No mapping: read it in
+    mCopy.resize(mSize);
+    size_t lRead = 0;
+    while (lRead < mSize) {
+        const ssize_t lGot = ::read(lFd, mCopy.data() + lRead, mSize - lRead);
+        if (lGot <= 0) {
+            break;
+        }
+        lRead += (size_t)lGot;
+    }
+    ::close(lFd);
+    if (lRead != mSize) {
+        close();
+        return false;
+    }
+    mpData = mCopy.data();
+    return true;
+#endif
+}
+
+void MappedFile::close() {
+#if defined(_WIN32)
+    if (mMapped) {
+        UnmapViewOfFile(mpData);
+    }
+    if (mpMapping != nullptr) {
+        CloseHandle((HANDLE)mpMapping);
+    }
+    if (mpFile != nullptr) {
+        CloseHandle((HANDLE)mpFile);
+    }
+#else
+    if (mMapped) {
+        munmap((void*)mpData, mSize);
+    }
+#endif
+    mpFile = nullptr;
+    mpMapping = nullptr;
+    mMapped = false;
+    mCopy.clear();
+    mCopy.shrink_to_fit();
+    mpData = nullptr;
+    mSize = 0;
+}
+
+bool statFile(const char* pPath, FileStamp& rOut) {
+#if defined(_WIN32)
+    WIN32_FILE_ATTRIBUTE_DATA lInfo;
+    if (!GetFileAttributesExA(pPath, GetFileExInfoStandard, &lInfo)) {
+        return false;
+    }
+    rOut.mSize = ((uint64_t)lInfo.nFileSizeHigh << 32) | (uint64_t)lInfo.nFileSizeLow;
+    rOut.mModified = (int64_t)(((uint64_t)lInfo.ftLastWriteTime.dwHighDateTime << 32) |
+                               (uint64_t)lInfo.ftLastWriteTime.dwLowDateTime);
+    return true;
+#else
+    struct stat lStat {};
+    if (stat(pPath, &lStat) != 0) {
+        return false;
+    }
+    rOut.mSize = (uint64_t)lStat.st_size;
+#if defined(__APPLE__)
+    rOut.mModified = (int64_t)lStat.st_mtimespec.tv_sec * 1000000000 + (int64_t)lStat.st_mtimespec.tv_nsec;
+#else
+    rOut.mModified = (int64_t)lStat.st_mtim.tv_sec * 1000000000 + (int64_t)lStat.st_mtim.tv_nsec;
+#endif
+    return true;
+#endif
+}
+
+} // namespace RLCharts
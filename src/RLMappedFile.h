@@ -0,0 +1,52 @@
+// RLMappedFile.h
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Implemented in RLMappedFile.cpp (no raylib dependency; add it to the target's
+// sources). Used by the OHLC loader (RLOhlcLoader.h) and by the sample pyramid's
+// spill file (RLSamplePyramid.h).
+
+namespace RLCharts {
+
+// Read-only view of a whole file: mmap / MapViewOfFile, or a heap copy where
+// mapping is not available (e.g. the Emscripten file system)
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { close(); }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const char* pPath);
+    void close();
+
+    [[nodiscard]] const char* data() const { return mpData; }
+    [[nodiscard]] size_t size() const { return mSize; }
+
+private:
+    const char* mpData = nullptr;
+    size_t mSize = 0;
+    void* mpFile = nullptr;    // Windows file handle
+    void* mpMapping = nullptr; // Windows mapping handle
+    bool mMapped = false;
+    std::vector<char> mCopy;
+};
+
+// Size and last write time of a file, for telling whether a cache derived from it
+// is stale. mModified is in platform ticks (ns on POSIX, 100 ns on Windows) and
+// only meant for comparison.
+struct FileStamp {
+    uint64_t mSize = 0;
+    int64_t mModified = 0;
+
+    [[nodiscard]] bool operator==(const FileStamp& rOther) const {
+        return mSize == rOther.mSize && mModified == rOther.mModified;
+    }
+};
+
+// False if the file does not exist or cannot be queried
+bool statFile(const char* pPath, FileStamp& rOut);
+
+} // namespace RLCharts
@@ -0,0 +1,211 @@
+// RLOffscreen.h
+#pragma once
+#include "raylib.h"
+#include "rlgl.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <utility>
+#include <vector>
+
+// Headless rendering of charts into offscreen targets, for reports, snapshots and
+// batch jobs (e.g. thousands of candlestick thumbnails) without a visible window.
+//
+// OffscreenRenderer owns a ring of aDepth render targets. submit() draws a chart
+// into the next free target and returns a ticket; the pixels of that target are
+// only read back once aDepth - 1 newer charts were submitted (or on flush()), so
+// the GPU has finished it by then and the readback does not stall the pipeline.
+// Frames come out of fetch() in submission order, RGBA8 with the top row first.
+//
+// Usage:
+//   RLCharts::initHeadlessContext(1, 1);
+//   RLCharts::OffscreenRenderer lRenderer(320, 180);
+//   for (...) {
+//       RLCandlestickChart lChart(Rectangle{ 0, 0, 320, 180 }, 1, 60);
+//       ... addSample(), update() ...
+//       lRenderer.submit(lChart, Rectangle{ 0, 0, 320, 180 });
+//       while (lRenderer.fetch(lFrame)) { RLCharts::exportPng(lFrame, ...); }
+//   }
+//   lRenderer.flush();
+//   while (lRenderer.fetch(lFrame)) { ... }
+
+namespace RLCharts {
+
+// Open a hidden window to get a GL context; returns false if none is available
+// (e.g. no display/EGL device). Default-framebuffer size does not limit targets.
+inline bool initHeadlessContext(int aWidth, int aHeight) {
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(aWidth, aHeight, "cpp-charts headless");
+    return IsWindowReady();
+}
+
+inline void closeHeadlessContext() {
+    if (IsWindowReady()) {
+        CloseWindow();
+    }
+}
+
+class OffscreenRenderer {
+public:
+    struct Frame {
+        uint64_t mTicket = 0;
+        int mWidth = 0;
+        int mHeight = 0;
+        std::vector<unsigned char> mPixels; // RGBA8, top row first
+    };
+
+    OffscreenRenderer(int aWidth, int aHeight, size_t aDepth = 3)
+        : mWidth(aWidth > 0 ? aWidth : 1), mHeight(aHeight > 0 ? aHeight : 1), mSlots(aDepth > 0 ? aDepth : 1) {}
+    ~OffscreenRenderer() { release(); }
+
+    // Owns GPU render targets
+    OffscreenRenderer(const OffscreenRenderer&) = delete;
+    OffscreenRenderer& operator=(const OffscreenRenderer&) = delete;
+
+    // Render rChart (via its draw()) with aBounds mapped to the target origin.
+    // Returns the frame's ticket, 0 if no render target could be created.
+    template<typename T>
+    uint64_t submit(const T& rChart, Rectangle aBounds) {
+        return submitWith(aBounds, [&rChart]() { rChart.draw(); });
+    }
+
+    // Same, for charts whose draw takes arguments (e.g. RLOrderBookVis::draw3D)
+    template<typename Fn>
+    uint64_t submitWith(Rectangle aBounds, Fn&& rDraw) {
+        Slot& rSlot = mSlots[mNext];
+        if (rSlot.mPending) {
+            resolve(rSlot);
+        }
+        if (rSlot.mTarget.id == 0) {
+            rSlot.mTarget = LoadRenderTexture(mWidth, mHeight);
+            if (rSlot.mTarget.id == 0) {
+                return 0;
+            }
+        }
+
+        BeginTextureMode(rSlot.mTarget);
+        ClearBackground(mClearColor);
+        rlPushMatrix();
+        rlTranslatef(-aBounds.x, -aBounds.y, 0.0f);
+        rDraw();
+        rlPopMatrix();
+        EndTextureMode();
+
+        rSlot.mTicket = ++mLastTicket;
+        rSlot.mPending = true;
+        mNext = (mNext + 1) % mSlots.size();
+        return rSlot.mTicket;
+    }
+
+    // Read back every in-flight target (end of a batch)
+    void flush() {
+        for (size_t i = 0; i < mSlots.size(); i++) {
+            Slot& rSlot = mSlots[(mNext + i) % mSlots.size()];
+            if (rSlot.mPending) {
+                resolve(rSlot);
+            }
+        }
+    }
+
+    // Pop the oldest read-back frame; false if none is ready yet
+    bool fetch(Frame& rFrame) {
+        if (mReady.empty()) {
+            return false;
+        }
+        rFrame = std::move(mReady.front());
+        mReady.pop_front();
+        return true;
+    }
+
+    void release() {
+        for (Slot& rSlot : mSlots) {
+            if (rSlot.mTarget.id != 0) {
+                UnloadRenderTexture(rSlot.mTarget);
+            }
+            rSlot = Slot{};
+        }
+        mNext = 0;
+    }
+
+    void setClearColor(Color aColor) { mClearColor = aColor; }
+
+    [[nodiscard]] int getWidth() const { return mWidth; }
+    [[nodiscard]] int getHeight() const { return mHeight; }
+    [[nodiscard]] size_t getDepth() const { return mSlots.size(); }
+    [[nodiscard]] size_t getReadyCount() const { return mReady.size(); }
+    // Submitted but not yet read back
+    [[nodiscard]] size_t getInFlightCount() const {
+        size_t lCount = 0;
+        for (const Slot& rSlot : mSlots) {
+            lCount += rSlot.mPending ? 1 : 0;
+        }
+        return lCount;
+    }
+
+private:
+    struct Slot {
+        RenderTexture2D mTarget{};
+        uint64_t mTicket = 0;
+        bool mPending = false;
+    };
+
+    void resolve(Slot& rSlot) {
+        rSlot.mPending = false;
+        void* lpPixels = rlReadTexturePixels(rSlot.mTarget.texture.id, mWidth, mHeight,
+                                             PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+        if (lpPixels == nullptr) {
+            return;
+        }
+        Frame lFrame;
+        lFrame.mTicket = rSlot.mTicket;
+        lFrame.mWidth = mWidth;
+        lFrame.mHeight = mHeight;
+        lFrame.mPixels.resize((size_t)mWidth * (size_t)mHeight * 4);
+        // Render textures are stored bottom-up
+        const size_t lRowBytes = (size_t)mWidth * 4;
+        const unsigned char* lpSrc = (const unsigned char*)lpPixels;
+        for (int y = 0; y < mHeight; y++) {
+            std::memcpy(lFrame.mPixels.data() + (size_t)y * lRowBytes,
+                        lpSrc + (size_t)(mHeight - 1 - y) * lRowBytes, lRowBytes);
+        }
+        MemFree(lpPixels);
+        mReady.push_back(std::move(lFrame));
+    }
+
+    int mWidth = 0;
+    int mHeight = 0;
+    std::vector<Slot> mSlots;
+    size_t mNext = 0;
+    uint64_t mLastTicket = 0;
+    std::deque<Frame> mReady;
+    Color mClearColor{ 0, 0, 0, 0 };
+};
+
+// Write a frame as PNG (raylib's ExportImage, format picked by extension)
+inline bool exportPng(const OffscreenRenderer::Frame& rFrame, const char* pFileName) {
+    if (rFrame.mPixels.empty()) {
+        return false;
+    }
+    Image lImg = {};
+    lImg.data = (void*)rFrame.mPixels.data();
+    lImg.width = rFrame.mWidth;
+    lImg.height = rFrame.mHeight;
+    lImg.mipmaps = 1;
+    lImg.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+    return ExportImage(lImg, pFileName);
+}
+
+// Write a frame as raw RGBA8 bytes (width * height * 4, top row first)
+inline bool exportRaw(const OffscreenRenderer::Frame& rFrame, const char* pFileName) {
+    FILE* lpFile = std::fopen(pFileName, "wb");
+    if (lpFile == nullptr) {
+        return false;
+    }
+    const size_t lWritten = std::fwrite(rFrame.mPixels.data(), 1, rFrame.mPixels.size(), lpFile);
+    std::fclose(lpFile);
+    return lWritten == rFrame.mPixels.size();
+}
+
+} // namespace RLCharts
@@ -0,0 +1,259 @@
+// RLOhlcLoader.cpp
+#include "RLOhlcLoader.h"
+#include "RLCivilDate.h"
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+namespace RLCharts {
+
+// Average CSV line length, only used to size the column reservations
+static constexpr size_t CSV_BYTES_PER_ROW_ESTIMATE = 48;
+// Below this many bytes per thread the parse stays on fewer threads
+static constexpr size_t CSV_MIN_CHUNK_BYTES = 1 << 20;
+static constexpr char OHLC_BINARY_MAGIC[8] = { 'R', 'L', 'O', 'H', 'L', 'C', '2', '\0' };
+// Magic, row count, source file size and source write time
+static constexpr size_t OHLC_BINARY_HEADER = sizeof(OHLC_BINARY_MAGIC) + 3 * sizeof(uint64_t);
+static constexpr size_t OHLC_BINARY_ROW_BYTES = sizeof(int64_t) + 5 * sizeof(float);
+
+// Field parsers: return the position after the value, or nullptr
+static const char* parseFloatField(const char* pBegin, const char* pEnd, float& rOut) {
+    while (pBegin < pEnd && (*pBegin == ' ' || *pBegin == '+')) {
+        pBegin++;
+    }
+#if defined(__cpp_lib_to_chars)
+    const std::from_chars_result lResult = std::from_chars(pBegin, pEnd, rOut);
+    return lResult.ec == std::errc() ? lResult.ptr : nullptr;
+#else
+    // Floating-point from_chars missing (older libc++): strtof on a bounded copy
+    char lBuf[64];
+    const size_t lLen = std::min((size_t)(pEnd - pBegin), sizeof(lBuf) - 1);
+    std::memcpy(lBuf, pBegin, lLen);
+    lBuf[lLen] = '\0';
+    char* lpStop = nullptr;
+    rOut = std::strtof(lBuf, &lpStop);
+    return lpStop == lBuf ? nullptr : pBegin + (lpStop - lBuf);
+#endif
+}
+
+static const char* parseIntField(const char* pBegin, const char* pEnd, int64_t& rOut) {
+    const std::from_chars_result lResult = std::from_chars(pBegin, pEnd, rOut);
+    return lResult.ec == std::errc() ? lResult.ptr : nullptr;
+}
+
+// "YYYY-MM-DD[ HH:MM[:SS]]" ('T' separator allowed) or integer epoch seconds
+static const char* parseTimeField(const char* pBegin, const char* pEnd, int64_t& rOut) {
+    while (pBegin < pEnd && *pBegin == ' ') {
+        pBegin++;
+    }
+    const char* lpDash = pBegin;
+    while (lpDash < pEnd && *lpDash >= '0' && *lpDash <= '9') {
+        lpDash++;
+    }
+    if (lpDash == pBegin || lpDash == pEnd || *lpDash != '-') {
+        return parseIntField(pBegin, pEnd, rOut);
+    }
+    int64_t lYear = 0;
+    int64_t lMonth = 0;
+    int64_t lDay = 0;
+    const char* p = parseIntField(pBegin, pEnd, lYear);
+    if (p == nullptr || p + 1 >= pEnd || (p = parseIntField(p + 1, pEnd, lMonth)) == nullptr ||
+        p + 1 >= pEnd || *p != '-' || (p = parseIntField(p + 1, pEnd, lDay)) == nullptr) {
+        return nullptr;
+    }
+    int64_t lSeconds = 0;
+    if (p < pEnd && (*p == ' ' || *p == 'T')) {
+        int64_t lHour = 0;
+        int64_t lMinute = 0;
+        int64_t lSecond = 0;
+        const char* q = parseIntField(p + 1, pEnd, lHour);
+        if (q != nullptr && q + 1 < pEnd && *q == ':' && (q = parseIntField(q + 1, pEnd, lMinute)) != nullptr) {
+            if (q + 1 < pEnd && *q == ':') {
+                const char* lpSecond = parseIntField(q + 1, pEnd, lSecond);
+                q = lpSecond != nullptr ? lpSecond : q;
+            }
+            lSeconds = lHour * 3600 + lMinute * 60 + lSecond;
+            p = q;
+        }
+    }
+    rOut = daysFromCivil(lYear, lMonth, lDay) * 86400 + lSeconds;
+    return p;
+}
+
+void parseOhlcLines(const char* pBegin, const char* pEnd, OhlcColumns& rOut) {
+    const char* lpLine = pBegin;
+    while (lpLine < pEnd) {
+        const char* lpEol = (const char*)std::memchr(lpLine, '\n', (size_t)(pEnd - lpLine));
+        if (lpEol == nullptr) {
+            lpEol = pEnd;
+        }
+        int64_t lTime = 0;
+        float lValues[5] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+        const char* p = parseTimeField(lpLine, lpEol, lTime);
+        bool lOk = p != nullptr;
+        for (int i = 0; i < 5 && lOk; i++) {
+            // Skip whatever is left of the previous field (e.g. a time zone suffix)
+            while (p < lpEol && *p != ',') {
+                p++;
+            }
+            lOk = p < lpEol && (p = parseFloatField(p + 1, lpEol, lValues[i])) != nullptr;
+        }
+        if (lOk) {
+            rOut.mTime.push_back(lTime);
+            rOut.mOpen.push_back(lValues[0]);
+            rOut.mHigh.push_back(lValues[1]);
+            rOut.mLow.push_back(lValues[2]);
+            rOut.mClose.push_back(lValues[3]);
+            rOut.mVolume.push_back(lValues[4]);
+        }
+        lpLine = lpEol + 1;
+    }
+}
+
+bool loadOhlcCsv(const char* pPath, OhlcColumns& rOut, unsigned aThreads) {
+    rOut.clear();
+    MappedFile lFile;
+    if (!lFile.open(pPath)) {
+        return false;
+    }
+    if (lFile.size() == 0) {
+        return true;
+    }
+    const char* lpBegin = lFile.data();
+    const char* lpEnd = lpBegin + lFile.size();
+
+    // Header: a first line with letters (other than a date/time 'T')
+    const char* lpFirstEol = (const char*)std::memchr(lpBegin, '\n', lFile.size());
+    const char* lpFirstEnd = lpFirstEol != nullptr ? lpFirstEol : lpEnd;
+    for (const char* p = lpBegin; p < lpFirstEnd; p++) {
+        if ((*p >= 'A' && *p <= 'Z' && *p != 'T') || (*p >= 'a' && *p <= 'z')) {
+            lpBegin = lpFirstEol != nullptr ? lpFirstEol + 1 : lpEnd;
+            break;
+        }
+    }
+
+    size_t lThreads = aThreads;
+    if (lThreads == 0) {
+        lThreads = std::max<size_t>(1, std::min<size_t>(std::thread::hardware_concurrency(),
+                                                        (size_t)(lpEnd - lpBegin) / CSV_MIN_CHUNK_BYTES));
+    }
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+    lThreads = 1;
+#endif
+    if (lThreads == 1) {
+        rOut.reserve((size_t)(lpEnd - lpBegin) / CSV_BYTES_PER_ROW_ESTIMATE);
+        parseOhlcLines(lpBegin, lpEnd, rOut);
+        return true;
+    }
+
+    // Chunk ends moved forward to the next line start
+    std::vector<const char*> lCuts(lThreads + 1, lpEnd);
+    lCuts[0] = lpBegin;
+    const size_t lStep = (size_t)(lpEnd - lpBegin) / lThreads;
+    for (size_t i = 1; i < lThreads; i++) {
+        const char* p = std::max(lCuts[i - 1], lpBegin + i * lStep);
+        const char* lpEol = (const char*)std::memchr(p, '\n', (size_t)(lpEnd - p));
+        lCuts[i] = lpEol != nullptr ? lpEol + 1 : lpEnd;
+    }
+    std::vector<OhlcColumns> lParts(lThreads);
+    const auto lParse = [&lCuts, &lParts](size_t aPart) {
+        lParts[aPart].reserve((size_t)(lCuts[aPart + 1] - lCuts[aPart]) / CSV_BYTES_PER_ROW_ESTIMATE);
+        parseOhlcLines(lCuts[aPart], lCuts[aPart + 1], lParts[aPart]);
+    };
+    std::vector<std::thread> lWorkers;
+    lWorkers.reserve(lThreads - 1);
+    for (size_t i = 1; i < lThreads; i++) {
+        lWorkers.emplace_back(lParse, i);
+    }
+    lParse(0);
+    for (std::thread& rWorker : lWorkers) {
+        rWorker.join();
+    }
+
+    size_t lTotal = 0;
+    for (const OhlcColumns& rPart : lParts) {
+        lTotal += rPart.size();
+    }
+    rOut = std::move(lParts[0]);
+    rOut.reserve(lTotal);
+    for (size_t i = 1; i < lThreads; i++) {
+        rOut.append(lParts[i]);
+    }
+    return true;
+}
+
+bool saveOhlcBinary(const char* pPath, const OhlcColumns& rData, const char* pSourcePath) {
+    FileStamp lSource;
+    if (pSourcePath != nullptr && !statFile(pSourcePath, lSource)) {
+        return false;
+    }
+    FILE* lpFile = std::fopen(pPath, "wb");
+    if (lpFile == nullptr) {
+        return false;
+    }
+    const uint64_t lCount = rData.size();
+    bool lOk = std::fwrite(OHLC_BINARY_MAGIC, 1, sizeof(OHLC_BINARY_MAGIC), lpFile) == sizeof(OHLC_BINARY_MAGIC) &&
+               std::fwrite(&lCount, sizeof(lCount), 1, lpFile) == 1 &&
+               std::fwrite(&lSource.mSize, sizeof(lSource.mSize), 1, lpFile) == 1 &&
+               std::fwrite(&lSource.mModified, sizeof(lSource.mModified), 1, lpFile) == 1;
+    if (lOk && lCount > 0) {
+        const std::vector<float>* lpColumns[5] = { &rData.mOpen, &rData.mHigh, &rData.mLow, &rData.mClose, &rData.mVolume };
+        lOk = std::fwrite(rData.mTime.data(), sizeof(int64_t), (size_t)lCount, lpFile) == lCount;
+        for (size_t i = 0; i < 5 && lOk; i++) {
+            lOk = std::fwrite(lpColumns[i]->data(), sizeof(float), (size_t)lCount, lpFile) == lCount;
+        }
+    }
+    return std::fclose(lpFile) == 0 && lOk;
+}
+
+bool loadOhlcBinary(const char* pPath, OhlcColumns& rOut, const char* pSourcePath) {
+    rOut.clear();
+    MappedFile lFile;
+    if (!lFile.open(pPath) || lFile.size() < OHLC_BINARY_HEADER ||
+        std::memcmp(lFile.data(), OHLC_BINARY_MAGIC, sizeof(OHLC_BINARY_MAGIC)) != 0) {
+        return false;
+    }
+    uint64_t lCount = 0;
+    FileStamp lStored;
+    const char* lpHeader = lFile.data() + sizeof(OHLC_BINARY_MAGIC);
+    std::memcpy(&lCount, lpHeader, sizeof(lCount));
+    std::memcpy(&lStored.mSize, lpHeader + sizeof(uint64_t), sizeof(lStored.mSize));
+    std::memcpy(&lStored.mModified, lpHeader + 2 * sizeof(uint64_t), sizeof(lStored.mModified));
+    // A source that is gone cannot be compared; the cache is all there is then
+    FileStamp lSource;
+    if (pSourcePath != nullptr && statFile(pSourcePath, lSource) && !(lSource == lStored)) {
+        return false;
+    }
+    if (lCount != (uint64_t)((lFile.size() - OHLC_BINARY_HEADER) / OHLC_BINARY_ROW_BYTES) ||
+        lFile.size() != OHLC_BINARY_HEADER + (size_t)lCount * OHLC_BINARY_ROW_BYTES) {
+        return false;
+    }
+    const char* p = lFile.data() + OHLC_BINARY_HEADER;
+    rOut.mTime.resize((size_t)lCount);
+    std::memcpy(rOut.mTime.data(), p, (size_t)lCount * sizeof(int64_t));
+    p += (size_t)lCount * sizeof(int64_t);
+    std::vector<float>* lpColumns[5] = { &rOut.mOpen, &rOut.mHigh, &rOut.mLow, &rOut.mClose, &rOut.mVolume };
+    for (std::vector<float>* lpColumn : lpColumns) {
+        lpColumn->resize((size_t)lCount);
+        std::memcpy(lpColumn->data(), p, (size_t)lCount * sizeof(float));
+        p += (size_t)lCount * sizeof(float);
+    }
+    return true;
+}
+
+bool loadOhlcCached(const char* pCsvPath, const char* pCachePath, OhlcColumns& rOut, unsigned aThreads) {
+    if (pCachePath != nullptr && loadOhlcBinary(pCachePath, rOut, pCsvPath)) {
+        return true;
+    }
+    if (!loadOhlcCsv(pCsvPath, rOut, aThreads)) {
+        return false;
+    }
+    if (pCachePath != nullptr) {
+        saveOhlcBinary(pCachePath, rOut, pCsvPath);
+    }
+    return true;
+}
+
+} // namespace RLCharts
@@ -0,0 +1,171 @@
+// RLOhlcLoader.h
+#pragma once
+#include "RLMappedFile.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Bulk OHLCV loading and replay for RLCandlestickChart and friends.
+//
+// loadOhlcCsv() memory-maps a "date,open,high,low,close,volume[,...]" file (the
+// layout of JPM_1_minute_bars.csv), splits it at line boundaries and parses the
+// chunks on several threads with std::from_chars into columns. The date column is
+// either "YYYY-MM-DD[ HH:MM[:SS]]" or integer epoch seconds; a header line is
+// skipped. saveOhlcBinary() / loadOhlcBinary() keep a columnar cache of the
+// result that loads with a single memcpy per column, and loadOhlcCached() picks
+// the cache when it exists and the CSV has not changed since it was written.
+//
+// The loader is implemented in RLOhlcLoader.cpp and RLMappedFile.cpp (no raylib
+// dependency; add both to the target's sources). OhlcReplay then feeds the rows
+// to a chart at the recorded pace (scaled by a speed factor, with market-closed
+// gaps capped) or at a fixed rate:
+//   RLCharts::OhlcColumns lData;
+//   RLCharts::loadOhlcCached("JPM_1_minute_bars.csv", "JPM_1_minute_bars.ohlc", lData);
+//   RLCharts::OhlcReplay lReplay(lData);
+//   lReplay.setSpeed(60.0);                    // one recorded minute per second
+//   ... per frame: lReplay.feed(GetFrameTime(), lChart);
+
+namespace RLCharts {
+
+// Columnar OHLCV rows; mTime is seconds since the epoch (dates read as UTC)
+struct OhlcColumns {
+    std::vector<int64_t> mTime;
+    std::vector<float> mOpen;
+    std::vector<float> mHigh;
+    std::vector<float> mLow;
+    std::vector<float> mClose;
+    std::vector<float> mVolume;
+
+    [[nodiscard]] size_t size() const { return mTime.size(); }
+    [[nodiscard]] bool empty() const { return mTime.empty(); }
+    void clear() {
+        mTime.clear();
+        mOpen.clear();
+        mHigh.clear();
+        mLow.clear();
+        mClose.clear();
+        mVolume.clear();
+    }
+    void reserve(size_t aCount) {
+        mTime.reserve(aCount);
+        mOpen.reserve(aCount);
+        mHigh.reserve(aCount);
+        mLow.reserve(aCount);
+        mClose.reserve(aCount);
+        mVolume.reserve(aCount);
+    }
+    void append(const OhlcColumns& rOther) {
+        mTime.insert(mTime.end(), rOther.mTime.begin(), rOther.mTime.end());
+        mOpen.insert(mOpen.end(), rOther.mOpen.begin(), rOther.mOpen.end());
+        mHigh.insert(mHigh.end(), rOther.mHigh.begin(), rOther.mHigh.end());
+        mLow.insert(mLow.end(), rOther.mLow.begin(), rOther.mLow.end());
+        mClose.insert(mClose.end(), rOther.mClose.begin(), rOther.mClose.end());
+        mVolume.insert(mVolume.end(), rOther.mVolume.begin(), rOther.mVolume.end());
+    }
+};
+
+// Load a CSV file into rOut (replacing its content). aThreads = 0 picks the
+// hardware concurrency, capped so every thread gets at least 1 MB.
+bool loadOhlcCsv(const char* pPath, OhlcColumns& rOut, unsigned aThreads = 0);
+
+// Parse the complete lines of [pBegin, pEnd) into rOut; malformed lines are skipped
+void parseOhlcLines(const char* pBegin, const char* pEnd, OhlcColumns& rOut);
+
+// Columnar cache: 8-byte magic, uint64 row count, the source file's size and
+// write time (FileStamp, zero without a source), then each column contiguous
+// (time as int64, the rest as float), native byte order. With pSourcePath, save
+// records that file's stamp and load rejects a cache whose stamp differs from
+// the file's current one (a missing source file is not checked).
+bool saveOhlcBinary(const char* pPath, const OhlcColumns& rData, const char* pSourcePath = nullptr);
+bool loadOhlcBinary(const char* pPath, OhlcColumns& rOut, const char* pSourcePath = nullptr);
+
+// Binary cache if present and still matching the CSV, else parse the CSV and
+// (try to) write the cache
+bool loadOhlcCached(const char* pCsvPath, const char* pCachePath, OhlcColumns& rOut, unsigned aThreads = 0);
+
+// Feeds loaded rows to a sink at the recorded pace or a fixed rate
+class OhlcReplay {
+public:
+    explicit OhlcReplay(const OhlcColumns& rData) : mpData(&rData) {}
+
+    // Recorded time per wall-clock second (1 = real time, 60 = a minute per second)
+    void setSpeed(double aSpeed) {
+        mSpeed = aSpeed > 0.0 ? aSpeed : 1.0;
+        mRate = 0.0;
+    }
+    // Fixed rows per second, ignoring timestamps (0 = back to recorded pace)
+    void setRate(double aRowsPerSecond) { mRate = aRowsPerSecond > 0.0 ? aRowsPerSecond : 0.0; }
+    // Longest recorded gap replayed in full (overnight / weekend closes), in seconds
+    void setMaxGap(double aSeconds) { mMaxGap = aSeconds > 0.0 ? aSeconds : 0.0; }
+    void setPaused(bool aPaused) { mPaused = aPaused; }
+    void seek(size_t aRow) {
+        mCursor = std::min(aRow, mpData->size());
+        mClock = 0.0;
+    }
+
+    // Advance by aDt wall-clock seconds; rSink(row) is called for every row that
+    // became due, at most aMaxRows per call. Returns the number of rows emitted.
+    template<typename Fn>
+    size_t advance(float aDt, Fn&& rSink, size_t aMaxRows = (size_t)-1) {
+        if (mPaused || finished()) {
+            return 0;
+        }
+        mClock += (double)aDt * (mRate > 0.0 ? mRate : mSpeed);
+        size_t lEmitted = 0;
+        while (mCursor < mpData->size() && lEmitted < aMaxRows) {
+            const double lCost = rowCost(mCursor);
+            if (mClock < lCost) {
+                break;
+            }
+            mClock -= lCost;
+            rSink(mCursor);
+            mCursor++;
+            lEmitted++;
+        }
+        if (finished()) {
+            mClock = 0.0;
+        }
+        return lEmitted;
+    }
+
+    // advance() into rChart.addSample(T::CandleSample) (RLCandlestickChart)
+    template<typename T>
+    size_t feed(float aDt, T& rChart, size_t aMaxRows = (size_t)-1) {
+        const OhlcColumns& rData = *mpData;
+        return advance(aDt, [&rData, &rChart](size_t aRow) {
+            typename T::CandleSample lSample;
+            lSample.aOpen = rData.mOpen[aRow];
+            lSample.aHigh = rData.mHigh[aRow];
+            lSample.aLow = rData.mLow[aRow];
+            lSample.aClose = rData.mClose[aRow];
+            lSample.aVolume = rData.mVolume[aRow];
+            lSample.aTime = rData.mTime[aRow];
+            rChart.addSample(lSample);
+        }, aMaxRows);
+    }
+
+    [[nodiscard]] size_t getCursor() const { return mCursor; }
+    [[nodiscard]] bool finished() const { return mCursor >= mpData->size(); }
+    [[nodiscard]] bool isPaused() const { return mPaused; }
+
+private:
+    // Clock units (recorded seconds, or rows in fixed-rate mode) before aRow is due
+    [[nodiscard]] double rowCost(size_t aRow) const {
+        if (mRate > 0.0 || aRow == 0) {
+            return mRate > 0.0 ? 1.0 : 0.0;
+        }
+        const double lGap = (double)(mpData->mTime[aRow] - mpData->mTime[aRow - 1]);
+        return std::clamp(lGap, 0.0, mMaxGap);
+    }
+
+    const OhlcColumns* mpData;
+    size_t mCursor = 0;
+    double mClock = 0.0;
+    double mSpeed = 1.0;
+    double mRate = 0.0;
+    double mMaxGap = 60.0;
+    bool mPaused = false;
+};
+
+} // namespace RLCharts
@@ -0,0 +1,147 @@
+// RLOhlcPyramid.h
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Multi-resolution OHLCV history.
+// Every sample is folded into a fixed set of levels (1, 5, 15 and 60 samples per
+// bar, plus one bar per trading day) as it arrives, so a chart can switch to any
+// resolution by merging a handful of bars from the coarsest level that divides
+// it, instead of replaying the raw stream. Bars never span a day boundary; within
+// a day they are aligned to the day's first sample, the same way
+// RLCandlestickChart aggregates candles.
+
+namespace RLCharts {
+
+struct OhlcBar {
+    float mOpen = 0.0f;
+    float mHigh = 0.0f;
+    float mLow = 0.0f;
+    float mClose = 0.0f;
+    float mVolume = 0.0f;
+    uint32_t mDay = 0;       // trading day index (0 = first day seen)
+    uint32_t mDayOffset = 0; // samples into the day at the bar's first sample
+    uint32_t mCount = 0;     // samples aggregated
+};
+
+class OhlcPyramid {
+public:
+    static constexpr size_t LEVEL_COUNT = 5;
+    // Samples per bar of each level; 0 = one bar per day
+    static constexpr uint32_t LEVEL_FACTORS[LEVEL_COUNT] = { 1, 5, 15, 60, 0 };
+
+    void clear() {
+        for (size_t i = 0; i < LEVEL_COUNT; i++) {
+            mLevels[i].clear();
+            mOpen[i] = false;
+        }
+        mSampleCount = 0;
+        mDay = 0;
+        mDayOffset = 0;
+    }
+
+    // Fold in one sample; aNewDay starts a new trading day (ignored for the first sample)
+    void add(float aOpen, float aHigh, float aLow, float aClose, float aVolume, bool aNewDay) {
+        if (aNewDay && mSampleCount > 0) {
+            mDay++;
+            mDayOffset = 0;
+        }
+        for (size_t i = 0; i < LEVEL_COUNT; i++) {
+            std::vector<OhlcBar>& rLevel = mLevels[i];
+            if (mOpen[i] && rLevel.back().mDay != mDay) {
+                mOpen[i] = false;
+            }
+            if (!mOpen[i]) {
+                OhlcBar lBar;
+                lBar.mOpen = aOpen;
+                lBar.mHigh = aHigh;
+                lBar.mLow = aLow;
+                lBar.mClose = aClose;
+                lBar.mVolume = aVolume;
+                lBar.mDay = mDay;
+                lBar.mDayOffset = mDayOffset;
+                lBar.mCount = 1;
+                rLevel.push_back(lBar);
+                mOpen[i] = true;
+            } else {
+                mergeInto(rLevel.back(), aHigh, aLow, aClose, aVolume, 1);
+            }
+            if (LEVEL_FACTORS[i] != 0 && rLevel.back().mCount >= LEVEL_FACTORS[i]) {
+                mOpen[i] = false;
+            }
+        }
+        mSampleCount++;
+        mDayOffset++;
+    }
+
+    // Append the newest aCount bars of aSamplesPerBar samples (0 = daily) to rOut,
+    // oldest first. Cost is O(aCount * aSamplesPerBar / level factor).
+    void collect(uint32_t aSamplesPerBar, size_t aCount, std::vector<OhlcBar>& rOut) const {
+        const size_t lLevel = levelFor(aSamplesPerBar);
+        const std::vector<OhlcBar>& rBars = mLevels[lLevel];
+        const size_t lFirstOut = rOut.size();
+        size_t lGroups = 0;
+        size_t i = rBars.size();
+        while (i > 0 && lGroups < aCount) {
+            // Walk back over the bars that belong to the same output bar
+            const OhlcBar& rNewest = rBars[i - 1];
+            const uint32_t lSlot = aSamplesPerBar == 0 ? 0 : rNewest.mDayOffset / aSamplesPerBar;
+            size_t lStart = i - 1;
+            while (lStart > 0 && rBars[lStart - 1].mDay == rNewest.mDay &&
+                   (aSamplesPerBar == 0 || rBars[lStart - 1].mDayOffset / aSamplesPerBar == lSlot)) {
+                lStart--;
+            }
+            OhlcBar lBar = rBars[lStart];
+            for (size_t j = lStart + 1; j < i; j++) {
+                mergeInto(lBar, rBars[j].mHigh, rBars[j].mLow, rBars[j].mClose, rBars[j].mVolume, rBars[j].mCount);
+            }
+            rOut.push_back(lBar);
+            lGroups++;
+            i = lStart;
+        }
+        // Collected newest first
+        std::reverse(rOut.begin() + (std::ptrdiff_t)lFirstOut, rOut.end());
+    }
+
+    // Level used by collect() for aSamplesPerBar: the coarsest factor that divides it
+    [[nodiscard]] static size_t levelFor(uint32_t aSamplesPerBar) {
+        if (aSamplesPerBar == 0) {
+            return LEVEL_COUNT - 1;
+        }
+        size_t lLevel = 0;
+        for (size_t i = 1; i < LEVEL_COUNT; i++) {
+            if (LEVEL_FACTORS[i] != 0 && aSamplesPerBar % LEVEL_FACTORS[i] == 0) {
+                lLevel = i;
+            }
+        }
+        return lLevel;
+    }
+
+    [[nodiscard]] size_t getSampleCount() const { return mSampleCount; }
+    [[nodiscard]] size_t getDayCount() const { return mSampleCount > 0 ? (size_t)mDay + 1 : 0; }
+    // Bars of one level, including the one still aggregating
+    [[nodiscard]] const std::vector<OhlcBar>& getLevel(size_t aLevel) const { return mLevels[aLevel]; }
+
+private:
+    static void mergeInto(OhlcBar& rBar, float aHigh, float aLow, float aClose, float aVolume, uint32_t aCount) {
+        if (aHigh > rBar.mHigh) {
+            rBar.mHigh = aHigh;
+        }
+        if (aLow < rBar.mLow) {
+            rBar.mLow = aLow;
+        }
+        rBar.mClose = aClose;
+        rBar.mVolume += aVolume;
+        rBar.mCount += aCount;
+    }
+
+    std::vector<OhlcBar> mLevels[LEVEL_COUNT];
+    bool mOpen[LEVEL_COUNT]{};
+    size_t mSampleCount = 0;
+    uint32_t mDay = 0;
+    uint32_t mDayOffset = 0;
+};
+
+} // namespace RLCharts
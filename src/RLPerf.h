@@ -0,0 +1,212 @@
+// RLPerf.h
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Optional frame-time instrumentation for charts.
+// Compiled out unless RLCHARTS_PERF is 1 (CMake: -DCPP_CHARTS_PERF=ON); the macros
+// below then expand to nothing, and getPerfStats() returns all zeros. The stats
+// member is present either way, so mixing instrumented and plain translation
+// units does not change the chart classes' layout.
+//
+// Every chart exposes getPerfStats() with timers for update(), its cache rebuilds
+// (layout, screen points, texture pixels, mesh vertices) and draw(), plus the
+// bytes it uploaded to the GPU and the explicit mesh/texture draws it issued in
+// the last frame. Immediate-mode shapes go through raylib's shared batch and are
+// not counted as draw calls.
+//
+// Zones can also be recorded for chrome://tracing / Perfetto:
+//   RLCharts::PerfTrace::instance().start();
+//   ... frames ...
+//   RLCharts::PerfTrace::instance().writeChromeTrace("charts_trace.json");
+// and are forwarded to Tracy when the build defines TRACY_ENABLE.
+
+#ifndef RLCHARTS_PERF
+#define RLCHARTS_PERF 0
+#endif
+
+#if RLCHARTS_PERF && defined(TRACY_ENABLE)
+#include <tracy/Tracy.hpp>
+#endif
+
+namespace RLCharts {
+
+// Weight of the newest sample in the moving average (~30 frame window)
+constexpr float PERF_EMA_ALPHA = 1.0f / 30.0f;
+
+struct PerfTimer {
+    float mLastMs = 0.0f;
+    float mEmaMs = 0.0f;
+    float mMaxMs = 0.0f;
+    uint64_t mCount = 0;
+
+    void record(float aMs) {
+        mLastMs = aMs;
+        mEmaMs = (mCount == 0) ? aMs : mEmaMs + (aMs - mEmaMs) * PERF_EMA_ALPHA;
+        if (aMs > mMaxMs) {
+            mMaxMs = aMs;
+        }
+        mCount++;
+    }
+};
+
+struct PerfStats {
+    PerfTimer mUpdate;
+    PerfTimer mRebuild; // cache rebuilds, summed per call
+    PerfTimer mDraw;
+    size_t mUploadBytes = 0;      // uploaded between the previous and the last draw()
+    size_t mUploadBytesTotal = 0;
+    size_t mDrawCalls = 0;        // explicit mesh/texture draws in the last draw()
+
+    // Accumulators for the frame in progress
+    size_t mPendingUploadBytes = 0;
+    size_t mPendingDrawCalls = 0;
+
+    void addUpload(size_t aBytes) {
+        mPendingUploadBytes += aBytes;
+        mUploadBytesTotal += aBytes;
+    }
+    void endFrame() {
+        mUploadBytes = mPendingUploadBytes;
+        mDrawCalls = mPendingDrawCalls;
+        mPendingUploadBytes = 0;
+        mPendingDrawCalls = 0;
+    }
+};
+
+struct PerfTraceEvent {
+    const char* mName = nullptr;
+    double mStartUs = 0.0;
+    double mDurationUs = 0.0;
+    size_t mThread = 0;
+};
+
+// Process-wide recorder for chart zones (Chrome trace event format)
+class PerfTrace {
+public:
+    static PerfTrace& instance() {
+        static PerfTrace sTrace;
+        return sTrace;
+    }
+
+    void start() {
+        std::lock_guard<std::mutex> lLock(mMutex);
+        mEvents.clear();
+        mRecording = true;
+    }
+    void stop() { mRecording = false; }
+    [[nodiscard]] bool isRecording() const { return mRecording; }
+
+    void record(const char* pName, std::chrono::steady_clock::time_point aStart,
+                std::chrono::steady_clock::time_point aEnd) {
+        if (!mRecording) {
+            return;
+        }
+        PerfTraceEvent lEvent;
+        lEvent.mName = pName;
+        lEvent.mStartUs = std::chrono::duration<double, std::micro>(aStart - mEpoch).count();
+        lEvent.mDurationUs = std::chrono::duration<double, std::micro>(aEnd - aStart).count();
+        lEvent.mThread = std::hash<std::thread::id>{}(std::this_thread::get_id()) & 0xFFFF;
+        std::lock_guard<std::mutex> lLock(mMutex);
+        mEvents.push_back(lEvent);
+    }
+
+    // Write the recorded zones as a Chrome trace ("X" complete events)
+    bool writeChromeTrace(const char* pFileName) {
+        FILE* lpFile = std::fopen(pFileName, "w");
+        if (lpFile == nullptr) {
+            return false;
+        }
+        std::lock_guard<std::mutex> lLock(mMutex);
+        std::fprintf(lpFile, "{\"traceEvents\":[\n");
+        for (size_t i = 0; i < mEvents.size(); i++) {
+            const PerfTraceEvent& rEvent = mEvents[i];
+            std::fprintf(lpFile, "{\"name\":\"%s\",\"cat\":\"chart\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%zu}%s\n",
+                         rEvent.mName, rEvent.mStartUs, rEvent.mDurationUs, rEvent.mThread,
+                         i + 1 < mEvents.size() ? "," : "");
+        }
+        std::fprintf(lpFile, "]}\n");
+        return std::fclose(lpFile) == 0;
+    }
+
+    [[nodiscard]] size_t getEventCount() {
+        std::lock_guard<std::mutex> lLock(mMutex);
+        return mEvents.size();
+    }
+
+private:
+    PerfTrace() : mEpoch(std::chrono::steady_clock::now()) {}
+
+    std::chrono::steady_clock::time_point mEpoch;
+    std::mutex mMutex;
+    std::vector<PerfTraceEvent> mEvents;
+    std::atomic<bool> mRecording{ false };
+};
+
+// Times its own lifetime into rTimer (and the trace, if recording)
+class PerfScope {
+public:
+    PerfScope(PerfTimer& rTimer, const char* pName)
+        : mTimer(rTimer), mpName(pName), mStart(std::chrono::steady_clock::now()) {}
+    ~PerfScope() {
+        const auto lEnd = std::chrono::steady_clock::now();
+        mTimer.record(std::chrono::duration<float, std::milli>(lEnd - mStart).count());
+        PerfTrace::instance().record(mpName, mStart, lEnd);
+    }
+    PerfScope(const PerfScope&) = delete;
+    PerfScope& operator=(const PerfScope&) = delete;
+
+private:
+    PerfTimer& mTimer;
+    const char* mpName;
+    std::chrono::steady_clock::time_point mStart;
+};
+
+// Draw scope: also closes the frame's upload / draw-call counters
+class PerfFrameScope {
+public:
+    PerfFrameScope(PerfStats& rStats, const char* pName) : mStats(rStats), mScope(rStats.mDraw, pName) {}
+    ~PerfFrameScope() { mStats.endFrame(); }
+    PerfFrameScope(const PerfFrameScope&) = delete;
+    PerfFrameScope& operator=(const PerfFrameScope&) = delete;
+
+private:
+    PerfStats& mStats;
+    PerfScope mScope;
+};
+
+} // namespace RLCharts
+
+#define RLCHARTS_PERF_CONCAT_INNER(a, b) a##b
+#define RLCHARTS_PERF_CONCAT(a, b) RLCHARTS_PERF_CONCAT_INNER(a, b)
+
+#if RLCHARTS_PERF
+#if defined(TRACY_ENABLE)
+#define RLCHARTS_PERF_ZONE(pName) ZoneScopedN(pName)
+#else
+#define RLCHARTS_PERF_ZONE(pName) ((void)0)
+#endif
+// Time the rest of the enclosing block into rStats.mUpdate / mRebuild
+#define RLCHARTS_PERF_UPDATE(rStats, pName) RLCHARTS_PERF_ZONE(pName); \
+    RLCharts::PerfScope RLCHARTS_PERF_CONCAT(lPerfScope, __LINE__)((rStats).mUpdate, pName)
+#define RLCHARTS_PERF_REBUILD(rStats, pName) RLCHARTS_PERF_ZONE(pName); \
+    RLCharts::PerfScope RLCHARTS_PERF_CONCAT(lPerfScope, __LINE__)((rStats).mRebuild, pName)
+// Time the rest of draw() and close the frame's counters
+#define RLCHARTS_PERF_DRAW(rStats, pName) RLCHARTS_PERF_ZONE(pName); \
+    RLCharts::PerfFrameScope RLCHARTS_PERF_CONCAT(lPerfScope, __LINE__)(rStats, pName)
+#define RLCHARTS_PERF_UPLOAD(rStats, aBytes) (rStats).addUpload((size_t)(aBytes))
+#define RLCHARTS_PERF_DRAW_CALLS(rStats, aCount) ((rStats).mPendingDrawCalls += (size_t)(aCount))
+#else
+#define RLCHARTS_PERF_UPDATE(rStats, pName) ((void)0)
+#define RLCHARTS_PERF_REBUILD(rStats, pName) ((void)0)
+#define RLCHARTS_PERF_DRAW(rStats, pName) ((void)0)
+#define RLCHARTS_PERF_UPLOAD(rStats, aBytes) ((void)0)
+#define RLCHARTS_PERF_DRAW_CALLS(rStats, aCount) ((void)0)
+#endif
@@ -0,0 +1,291 @@
+// RLRectBatch.h
+#pragma once
+#include "raylib.h"
+#include "rlgl.h"
+#include "raymath.h"
+#include "RLGpuStaging.h"
+#include "RLLineBatch.h"
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Instanced axis-aligned rectangle renderer for dense bar and histogram views.
+// Every rectangle is one instance of a shared unit quad that the vertex shader
+// places and scales, so thousands of bars cost one upload and one instanced draw
+// call instead of one DrawRectangle each. The instance buffers are uploaded only
+// after the rectangles changed and grow in powers of two.
+//
+// Instancing needs desktop OpenGL 3.3; on GLES/WebGL (or if the shader fails to
+// compile) draw() falls back to two triangles per rectangle through a LineBatch.
+// GPU resources are created on the first draw() and owned by the batch: a copy
+// only takes the rectangles and creates its own resources when drawn.
+
+namespace RLCharts {
+
+class RectBatch {
+public:
+    RectBatch() = default;
+    ~RectBatch() { unload(); }
+
+    RectBatch(const RectBatch& rOther) : mRects(rOther.mRects), mColors(rOther.mColors),
+                                         mInstancing(rOther.mInstancing) {}
+    RectBatch& operator=(const RectBatch& rOther) {
+        if (this != &rOther) {
+            mRects = rOther.mRects;
+            mColors = rOther.mColors;
+            mInstancing = rOther.mInstancing;
+            mDirty = true;
+        }
+        return *this;
+    }
+    RectBatch(RectBatch&& rOther) noexcept { swapWith(rOther); }
+    RectBatch& operator=(RectBatch&& rOther) noexcept {
+        if (this != &rOther) {
+            unload();
+            swapWith(rOther);
+        }
+        return *this;
+    }
+
+    void clear() {
+        mRects.clear();
+        mColors.clear();
+        mDirty = true;
+    }
+    void reserve(size_t aCount) {
+        mRects.reserve(aCount * 4);
+        mColors.reserve(aCount);
+    }
+    [[nodiscard]] bool empty() const { return mColors.empty(); }
+    [[nodiscard]] size_t size() const { return mColors.size(); }
+
+    void add(Rectangle aRect, Color aColor) {
+        if (aRect.width <= 0.0f || aRect.height <= 0.0f) {
+            return;
+        }
+        mRects.push_back(aRect.x);
+        mRects.push_back(aRect.y);
+        mRects.push_back(aRect.width);
+        mRects.push_back(aRect.height);
+        mColors.push_back(aColor);
+        mDirty = true;
+    }
+
+    // Instanced path on/off (on by default; off always uses triangles)
+    void setInstancing(bool aEnabled) {
+        mInstancing = aEnabled;
+        mDirty = true;
+    }
+    [[nodiscard]] bool isInstancingEnabled() const { return mInstancing; }
+    // Whether the last draw() went through the instanced shader
+    [[nodiscard]] bool wasInstanced() const { return mReady && mInstancing; }
+
+    void draw() const {
+        if (mColors.empty()) {
+            return;
+        }
+        if (mInstancing && ensureResources()) {
+            drawInstanced();
+            return;
+        }
+        if (mDirty) {
+            mFallback.clear();
+            for (size_t i = 0; i < mColors.size(); ++i) {
+                const float lX0 = mRects[i * 4];
+                const float lY0 = mRects[i * 4 + 1];
+                const float lX1 = lX0 + mRects[i * 4 + 2];
+                const float lY1 = lY0 + mRects[i * 4 + 3];
+                mFallback.addTriangle({ lX0, lY0 }, { lX1, lY0 }, { lX1, lY1 }, mColors[i]);
+                mFallback.addTriangle({ lX0, lY0 }, { lX1, lY1 }, { lX0, lY1 }, mColors[i]);
+            }
+            mDirty = false;
+        }
+        mFallback.draw();
+    }
+
+    // Release the GPU resources (needs the GL context; done by the destructor)
+    void unload() {
+        if (mShader.id != 0) {
+            UnloadShader(mShader);
+        }
+        mShader = Shader{};
+        releaseBuffers();
+        mReady = false;
+        mFailed = false;
+        mDirty = true;
+    }
+
+private:
+    // Quad corners in [0, 1]; the shader maps them onto each rectangle
+    static constexpr float QUAD[12] = { 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f,
+                                        0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 1.0f };
+
+    void swapWith(RectBatch& rOther) {
+        std::swap(mRects, rOther.mRects);
+        std::swap(mColors, rOther.mColors);
+        std::swap(mFallback, rOther.mFallback);
+        std::swap(mInstancing, rOther.mInstancing);
+        std::swap(mDirty, rOther.mDirty);
+        std::swap(mReady, rOther.mReady);
+        std::swap(mFailed, rOther.mFailed);
+        std::swap(mShader, rOther.mShader);
+        std::swap(mLocMvp, rOther.mLocMvp);
+        std::swap(mLocPosition, rOther.mLocPosition);
+        std::swap(mLocRect, rOther.mLocRect);
+        std::swap(mLocColor, rOther.mLocColor);
+        std::swap(mVao, rOther.mVao);
+        std::swap(mQuadVbo, rOther.mQuadVbo);
+        std::swap(mRectVbo, rOther.mRectVbo);
+        std::swap(mColorVbo, rOther.mColorVbo);
+        std::swap(mCapacity, rOther.mCapacity);
+    }
+
+    void releaseBuffers() const {
+        if (mVao != 0) {
+            rlUnloadVertexArray(mVao);
+        }
+        const unsigned int lBuffers[] = { mQuadVbo, mRectVbo, mColorVbo };
+        for (const unsigned int lVbo : lBuffers) {
+            if (lVbo != 0) {
+                rlUnloadVertexBuffer(lVbo);
+            }
+        }
+        mVao = 0;
+        mQuadVbo = 0;
+        mRectVbo = 0;
+        mColorVbo = 0;
+        mCapacity = 0;
+    }
+
+    [[nodiscard]] bool ensureResources() const {
+        if (mFailed) {
+            return false;
+        }
+        if (!mReady) {
+            // GLSL 330: desktop GL only
+            const int lVersion = rlGetVersion();
+            if (lVersion != RL_OPENGL_33 && lVersion != RL_OPENGL_43) {
+                mFailed = true;
+                return false;
+            }
+            const char* pVertex =
+                "#version 330\n"
+                "in vec2 vertexPosition;\n"
+                "in vec4 instanceRect;\n" // x, y, width, height
+                "in vec4 instanceColor;\n"
+                "uniform mat4 mvp;\n"
+                "out vec4 fragColor;\n"
+                "void main() {\n"
+                "    fragColor = instanceColor;\n"
+                "    gl_Position = mvp * vec4(instanceRect.xy + vertexPosition * instanceRect.zw, 0.0, 1.0);\n"
+                "}\n";
+            const char* pFragment =
+                "#version 330\n"
+                "in vec4 fragColor;\n"
+                "out vec4 finalColor;\n"
+                "void main() {\n"
+                "    finalColor = fragColor;\n"
+                "}\n";
+            mShader = LoadShaderFromMemory(pVertex, pFragment);
+            if (!IsShaderValid(mShader)) {
+                mShader = Shader{};
+                mFailed = true;
+                return false;
+            }
+            mLocMvp = GetShaderLocation(mShader, "mvp");
+            mLocPosition = GetShaderLocationAttrib(mShader, "vertexPosition");
+            mLocRect = GetShaderLocationAttrib(mShader, "instanceRect");
+            mLocColor = GetShaderLocationAttrib(mShader, "instanceColor");
+            if (mLocPosition < 0 || mLocRect < 0 || mLocColor < 0) {
+                UnloadShader(mShader);
+                mShader = Shader{};
+                mFailed = true;
+                return false;
+            }
+            mReady = true;
+            mDirty = true;
+        }
+        if (mColors.size() > mCapacity && !allocateBuffers(mColors.size())) {
+            mReady = false;
+            mFailed = true;
+            return false;
+        }
+        if (mDirty) {
+            rlUpdateVertexBuffer(mRectVbo, mRects.data(), (int)(mRects.size() * sizeof(float)), 0);
+            rlUpdateVertexBuffer(mColorVbo, mColors.data(), (int)(mColors.size() * sizeof(Color)), 0);
+            countBufferUpload(mRects.size() * sizeof(float));
+            countBufferUpload(mColors.size() * sizeof(Color));
+            mDirty = false;
+        }
+        return true;
+    }
+
+    // (Re)create the VAO with room for at least aCount instances
+    [[nodiscard]] bool allocateBuffers(size_t aCount) const {
+        releaseBuffers();
+        size_t lCapacity = 256;
+        while (lCapacity < aCount) {
+            lCapacity *= 2;
+        }
+        // Each rlLoadVertexBuffer leaves its buffer bound for the attribute setup after it
+        mVao = rlLoadVertexArray();
+        rlEnableVertexArray(mVao);
+        mQuadVbo = rlLoadVertexBuffer(QUAD, (int)sizeof(QUAD), false);
+        rlSetVertexAttribute((unsigned int)mLocPosition, 2, RL_FLOAT, false, 0, 0);
+        rlEnableVertexAttribute((unsigned int)mLocPosition);
+        mRectVbo = rlLoadVertexBuffer(nullptr, (int)(lCapacity * 4 * sizeof(float)), true);
+        rlSetVertexAttribute((unsigned int)mLocRect, 4, RL_FLOAT, false, 0, 0);
+        rlEnableVertexAttribute((unsigned int)mLocRect);
+        rlSetVertexAttributeDivisor((unsigned int)mLocRect, 1);
+        mColorVbo = rlLoadVertexBuffer(nullptr, (int)(lCapacity * sizeof(Color)), true);
+        rlSetVertexAttribute((unsigned int)mLocColor, 4, RL_UNSIGNED_BYTE, true, 0, 0);
+        rlEnableVertexAttribute((unsigned int)mLocColor);
+        rlSetVertexAttributeDivisor((unsigned int)mLocColor, 1);
+        rlDisableVertexArray();
+
+        if (mVao == 0 || mQuadVbo == 0 || mRectVbo == 0 || mColorVbo == 0) {
+            releaseBuffers();
+            return false;
+        }
+        mCapacity = lCapacity;
+        mDirty = true;
+        return true;
+    }
+
+    void drawInstanced() const {
+        // Flush whatever rlgl batched so far so the rectangles keep their place in the draw order
+        rlDrawRenderBatchActive();
+        rlDisableBackfaceCulling();
+        const Matrix lMvp = MatrixMultiply(MatrixMultiply(rlGetMatrixTransform(), rlGetMatrixModelview()),
+                                           rlGetMatrixProjection());
+        rlEnableShader(mShader.id);
+        rlSetUniformMatrix(mLocMvp, lMvp);
+        rlEnableVertexArray(mVao);
+        rlDrawVertexArrayInstanced(0, 6, (int)mColors.size());
+        rlDisableVertexArray();
+        rlDisableShader();
+        rlEnableBackfaceCulling();
+    }
+
+    std::vector<float> mRects; // x, y, width, height per rectangle
+    std::vector<Color> mColors;
+    mutable LineBatch mFallback;
+    bool mInstancing = true;
+    mutable bool mDirty = true;
+
+    // GPU state (created lazily by draw())
+    mutable bool mReady = false;
+    mutable bool mFailed = false;
+    mutable Shader mShader{};
+    mutable int mLocMvp = -1;
+    mutable int mLocPosition = -1;
+    mutable int mLocRect = -1;
+    mutable int mLocColor = -1;
+    mutable unsigned int mVao = 0;
+    mutable unsigned int mQuadVbo = 0;
+    mutable unsigned int mRectVbo = 0;
+    mutable unsigned int mColorVbo = 0;
+    mutable size_t mCapacity = 0;
+};
+
+} // namespace RLCharts
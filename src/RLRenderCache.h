@@ -0,0 +1,284 @@
+// RLRenderCache.h
+#pragma once
+#include "raylib.h"
+#include "rlgl.h"
+#include "raymath.h"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Retained render target for charts that are mostly static.
+// Every chart exposes isSettled() (animations have converged, update() is idle)
+// and needsRedraw() (something changed since its last draw()). RenderCache draws
+// the chart into an offscreen texture only when needsRedraw() is true, the size
+// changed or invalidate() was called; every other frame it is one textured quad.
+// The chart draws at its normal screen coordinates, translated into the texture.
+//
+// Usage:
+//   RLCharts::RenderCache lCache;
+//   lBars.update(dt);
+//   lCache.draw(lBars, lBars.getBounds());
+//
+// StaticLayer is the same idea inside a chart that keeps animating: the part of
+// the chart drawn under the data (background, grid, axes, tick labels) is cached
+// and only the data is drawn every frame. See setStaticLayerCache() on the charts.
+
+namespace RLCharts {
+
+class RenderCache {
+public:
+    RenderCache() = default;
+    ~RenderCache() { release(); }
+
+    // Owns a GPU render target
+    RenderCache(const RenderCache&) = delete;
+    RenderCache& operator=(const RenderCache&) = delete;
+
+    // Draw rChart (via its draw()) through the cache at aBounds
+    template<typename T>
+    void draw(const T& rChart, Rectangle aBounds) {
+        drawWith(rChart, aBounds, [&rChart]() { rChart.draw(); });
+    }
+
+    // Same, for charts whose draw takes arguments (e.g. RLOrderBookVis::draw3D):
+    // rDraw renders the chart, rChart.needsRedraw() decides when
+    template<typename T, typename Fn>
+    void drawWith(const T& rChart, Rectangle aBounds, Fn&& rDraw) {
+        const int lWidth = (int)ceilf(aBounds.width);
+        const int lHeight = (int)ceilf(aBounds.height);
+        if (lWidth <= 0 || lHeight <= 0) {
+            return;
+        }
+        if (mTarget.id != 0 && (lWidth != mWidth || lHeight != mHeight)) {
+            release();
+        }
+        if (mTarget.id == 0) {
+            mTarget = LoadRenderTexture(lWidth, lHeight);
+            if (mTarget.id == 0) {
+                // No framebuffer support: draw directly
+                rDraw();
+                return;
+            }
+            mWidth = lWidth;
+            mHeight = lHeight;
+            mDirty = true;
+        }
+
+        if (mDirty || rChart.needsRedraw()) {
+            BeginTextureMode(mTarget);
+            ClearBackground(BLANK);
+            // Store premultiplied color with plain coverage alpha, so compositing
+            // the texture matches drawing the chart directly
+            rlSetBlendFactorsSeparate(RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE, RL_ONE_MINUS_SRC_ALPHA,
+                                      RL_FUNC_ADD, RL_FUNC_ADD);
+            BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+            rlPushMatrix();
+            rlTranslatef(-aBounds.x, -aBounds.y, 0.0f);
+            rDraw();
+            rlPopMatrix();
+            EndBlendMode();
+            EndTextureMode();
+            mDirty = false;
+            mRenderCount++;
+        }
+
+        // Render textures are stored bottom-up
+        BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+        DrawTextureRec(mTarget.texture, Rectangle{ 0.0f, 0.0f, (float)mWidth, -(float)mHeight },
+                       Vector2{ aBounds.x, aBounds.y }, WHITE);
+        EndBlendMode();
+    }
+
+    // Force a re-render on the next draw (e.g. after changing a shared font)
+    void invalidate() { mDirty = true; }
+
+    void release() {
+        if (mTarget.id != 0) {
+            UnloadRenderTexture(mTarget);
+        }
+        mTarget = RenderTexture2D{};
+        mWidth = 0;
+        mHeight = 0;
+        mDirty = true;
+    }
+
+    [[nodiscard]] bool isValid() const { return mTarget.id != 0; }
+    // Number of times the chart was actually rendered into the cache
+    [[nodiscard]] size_t getRenderCount() const { return mRenderCount; }
+
+private:
+    RenderTexture2D mTarget{};
+    int mWidth = 0;
+    int mHeight = 0;
+    bool mDirty = true;
+    size_t mRenderCount = 0;
+};
+
+// FNV-1a over the fields that define a face (GaugePanel) or a static layer
+class FaceKey {
+public:
+    FaceKey& add(const void* pData, size_t aBytes) {
+        const unsigned char* pBytes = (const unsigned char*)pData;
+        for (size_t i = 0; i < aBytes; ++i) {
+            mHash = (mHash ^ pBytes[i]) * 0x100000001B3ull;
+        }
+        return *this;
+    }
+    FaceKey& add(float aValue) {
+        // +0 and -0 draw the same
+        const float lValue = aValue == 0.0f ? 0.0f : aValue;
+        return add(&lValue, sizeof(lValue));
+    }
+    FaceKey& add(int aValue) { return add(&aValue, sizeof(aValue)); }
+    FaceKey& add(bool aValue) { return add(aValue ? 1 : 0); }
+    FaceKey& add(Color aColor) {
+        const unsigned char lRgba[4] = { aColor.r, aColor.g, aColor.b, aColor.a };
+        return add(lRgba, sizeof(lRgba));
+    }
+    FaceKey& add(const Font& rFont) { return add((int)rFont.texture.id).add(rFont.baseSize); }
+    FaceKey& add(const std::string& rText) { return add((int)rText.size()).add(rText.data(), rText.size()); }
+
+    [[nodiscard]] uint64_t get() const { return mHash; }
+
+private:
+    uint64_t mHash = 0xCBF29CE484222325ull;
+};
+
+// Cached static layer of one chart. draw() renders the layer through rDraw into
+// an offscreen texture when it was invalidated, its key changed (charts hash the
+// scale their tick labels depend on) or the layer size or sub-pixel offset
+// changed; otherwise it is one textured quad. Moving the chart by whole pixels
+// reuses the texture. A disabled layer, a missing render target or a chart drawn
+// under rlPushMatrix, e.g. through a RenderCache (the layer cannot nest render
+// targets), draws directly.
+//
+// Re-renders happen inside draw(), so do not enable the cache on a chart that you
+// draw into your own BeginTextureMode. A 2D camera active around the chart is
+// restored after a re-render. Copies start with no texture, like the batches.
+class StaticLayer {
+public:
+    StaticLayer() = default;
+    ~StaticLayer() { release(); }
+
+    StaticLayer(const StaticLayer& rOther) : mEnabled(rOther.mEnabled) {}
+    StaticLayer& operator=(const StaticLayer& rOther) {
+        if (this != &rOther) {
+            release();
+            mEnabled = rOther.mEnabled;
+        }
+        return *this;
+    }
+
+    void setEnabled(bool aEnabled) {
+        mEnabled = aEnabled;
+        if (!aEnabled) {
+            release();
+        }
+    }
+    [[nodiscard]] bool isEnabled() const { return mEnabled; }
+
+    // Draw the layer covering aBounds; rDraw renders it at screen coordinates
+    template<typename Fn>
+    void draw(Rectangle aBounds, uint64_t aKey, Fn&& rDraw) {
+        if (!mEnabled || !isIdentity(rlGetMatrixTransform())) {
+            rDraw();
+            return;
+        }
+        const float lX = floorf(aBounds.x);
+        const float lY = floorf(aBounds.y);
+        const int lWidth = (int)ceilf(aBounds.x + aBounds.width - lX);
+        const int lHeight = (int)ceilf(aBounds.y + aBounds.height - lY);
+        if (lWidth <= 0 || lHeight <= 0) {
+            return;
+        }
+        if (mTarget.id != 0 && (lWidth != mWidth || lHeight != mHeight)) {
+            release();
+        }
+        if (mTarget.id == 0) {
+            mTarget = LoadRenderTexture(lWidth, lHeight);
+            if (mTarget.id == 0) {
+                rDraw();
+                return;
+            }
+            mWidth = lWidth;
+            mHeight = lHeight;
+            mDirty = true;
+        }
+        const float lFracX = aBounds.x - lX;
+        const float lFracY = aBounds.y - lY;
+        if (mDirty || aKey != mKey || lFracX != mFracX || lFracY != mFracY) {
+            // BeginTextureMode resets the modelview matrix and EndTextureMode the
+            // screen projection; put back a camera the caller may have begun
+            const Matrix lModelview = rlGetMatrixModelview();
+            BeginTextureMode(mTarget);
+            ClearBackground(BLANK);
+            // Premultiplied color with coverage alpha, as in RenderCache
+            rlSetBlendFactorsSeparate(RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE, RL_ONE_MINUS_SRC_ALPHA,
+                                      RL_FUNC_ADD, RL_FUNC_ADD);
+            BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+            rlPushMatrix();
+            rlTranslatef(-lX, -lY, 0.0f);
+            rDraw();
+            rlPopMatrix();
+            EndBlendMode();
+            EndTextureMode();
+            rlLoadIdentity();
+            rlMultMatrixf(MatrixToFloat(lModelview));
+            mDirty = false;
+            mKey = aKey;
+            mFracX = lFracX;
+            mFracY = lFracY;
+            mRenderCount++;
+        }
+
+        // Render textures are stored bottom-up
+        BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+        DrawTextureRec(mTarget.texture, Rectangle{ 0.0f, 0.0f, (float)mWidth, -(float)mHeight },
+                       Vector2{ lX, lY }, WHITE);
+        EndBlendMode();
+    }
+
+    // Re-render on the next draw (bounds, style or anything else under the key changed)
+    void invalidate() { mDirty = true; }
+
+    void release() {
+        if (mTarget.id != 0) {
+            UnloadRenderTexture(mTarget);
+        }
+        mTarget = RenderTexture2D{};
+        mWidth = 0;
+        mHeight = 0;
+        mDirty = true;
+    }
+
+    [[nodiscard]] bool isValid() const { return mTarget.id != 0; }
+    // Number of times the layer was rendered into its texture
+    [[nodiscard]] size_t getRenderCount() const { return mRenderCount; }
+
+private:
+    static bool isIdentity(const Matrix& rM) {
+        return rM.m0 == 1.0f && rM.m5 == 1.0f && rM.m10 == 1.0f && rM.m15 == 1.0f && rM.m12 == 0.0f &&
+               rM.m13 == 0.0f && rM.m14 == 0.0f && rM.m1 == 0.0f && rM.m4 == 0.0f;
+    }
+
+    RenderTexture2D mTarget{};
+    int mWidth = 0;
+    int mHeight = 0;
+    uint64_t mKey = 0;
+    float mFracX = 0.0f;
+    float mFracY = 0.0f;
+    bool mEnabled = false;
+    bool mDirty = true;
+    size_t mRenderCount = 0;
+};
+
+// BeginScissorMode for chart code that may render through a RenderCache:
+// applies the translation pushed by the cache so the clip rectangle stays
+// on the chart (no-op offset when drawing directly to the screen)
+inline void beginChartScissor(int aX, int aY, int aWidth, int aHeight) {
+    const Matrix lTransform = rlGetMatrixTransform();
+    BeginScissorMode(aX + (int)lTransform.m12, aY + (int)lTransform.m13, aWidth, aHeight);
+}
+
+} // namespace RLCharts
@@ -0,0 +1,97 @@
+// RLRingQueue.h
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Double-ended queue on a grow-only power-of-two ring. Every element has an
+// absolute position (front() is at getBeginPos()) that stays the same while the
+// element is queued, also across growth, so a caller can remember where a run of
+// elements starts and later trim the queue back to it. clear() keeps the
+// storage: a queue cycling through a bounded number of elements stops allocating
+// once it has grown to fit them.
+
+namespace RLCharts {
+
+template<typename T>
+class RingQueue {
+public:
+    void clear() {
+        mBegin = 0;
+        mEnd = 0;
+    }
+    void reserve(size_t aCount) {
+        if (aCount > mItems.size()) {
+            grow(aCount);
+        }
+    }
+    [[nodiscard]] size_t size() const { return (size_t)(mEnd - mBegin); }
+    [[nodiscard]] bool empty() const { return mBegin == mEnd; }
+
+    [[nodiscard]] uint64_t getBeginPos() const { return mBegin; }
+    [[nodiscard]] uint64_t getEndPos() const { return mEnd; }
+    [[nodiscard]] T& at(uint64_t aPos) { return mItems[(size_t)aPos & mMask]; }
+    [[nodiscard]] const T& at(uint64_t aPos) const { return mItems[(size_t)aPos & mMask]; }
+    [[nodiscard]] T& operator[](size_t aIndex) { return at(mBegin + aIndex); }
+    [[nodiscard]] const T& operator[](size_t aIndex) const { return at(mBegin + aIndex); }
+    [[nodiscard]] const T& front() const { return at(mBegin); }
+    [[nodiscard]] const T& back() const { return at(mEnd - 1); }
+
+    void pushBack(const T& rItem) {
+        if (size() == mItems.size()) {
+            grow(size() + 1);
+        }
+        at(mEnd++) = rItem;
+    }
+    void pushFront(const T& rItem) {
+        if (size() == mItems.size()) {
+            grow(size() + 1);
+        }
+        at(--mBegin) = rItem;
+    }
+    void popFront(size_t aCount = 1) { mBegin += aCount; }
+    void popBack(size_t aCount = 1) { mEnd -= aCount; }
+    // Drop the elements before / from the absolute position aPos
+    void dropBefore(uint64_t aPos) { mBegin = aPos; }
+    void truncate(uint64_t aPos) { mEnd = aPos; }
+
+    // The queued elements, oldest first, as at most two contiguous runs
+    [[nodiscard]] size_t firstRun(const T*& rpData) const {
+        if (empty()) {
+            rpData = nullptr;
+            return 0;
+        }
+        const size_t lStart = (size_t)mBegin & mMask;
+        rpData = mItems.data() + lStart;
+        return size() < mItems.size() - lStart ? size() : mItems.size() - lStart;
+    }
+    [[nodiscard]] size_t secondRun(const T*& rpData) const {
+        const T* pFirst = nullptr;
+        const size_t lCount = size() - firstRun(pFirst);
+        rpData = lCount > 0 ? mItems.data() : nullptr;
+        return lCount;
+    }
+
+private:
+    void grow(size_t aMinCapacity) {
+        size_t lCapacity = mItems.empty() ? 16 : mItems.size() * 2;
+        while (lCapacity < aMinCapacity) {
+            lCapacity *= 2;
+        }
+        // Same absolute positions under the new mask
+        std::vector<T> lItems(lCapacity);
+        const size_t lMask = lCapacity - 1;
+        for (uint64_t lPos = mBegin; lPos != mEnd; ++lPos) {
+            lItems[(size_t)lPos & lMask] = at(lPos);
+        }
+        mItems.swap(lItems);
+        mMask = lMask;
+    }
+
+    std::vector<T> mItems;
+    size_t mMask = 0;
+    uint64_t mBegin = 0;
+    uint64_t mEnd = 0;
+};
+
+} // namespace RLCharts
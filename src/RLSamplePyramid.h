@@ -0,0 +1,383 @@
+// RLSamplePyramid.h
+#pragma once
+#include "RLMappedFile.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <span>
+#include <string>
+#include <vector>
+
+// Long-history store for one stream of samples (RLTimeSeries trace history).
+// Level 0 keeps the raw samples; every level above keeps one min/max/mean bucket
+// per FANOUT buckets of the level below, so level L buckets span FANOUT^L
+// samples. append() folds each sample in as it arrives (amortized O(1)), and
+// collect() reduces any sample range to one bucket per pixel column by reading
+// the coarsest level whose buckets are no wider than a column: at most FANOUT
+// buckets per column, O(columns) whatever the history length. Column edges are
+// rounded to that level's bucket boundaries.
+//
+// enableSpill() moves the oldest blocks of every level to a scratch file once a
+// level holds more than the resident limit, and reads them back through a
+// memory mapping (RLMappedFile.h), so only the recent history stays in RAM. The
+// mapping is reopened after each spill, which happens once per SPILL_BLOCK
+// samples at most. Where mapping is unavailable (Emscripten) MappedFile reads the
+// file back into memory, so spilling saves nothing there. The file is truncated
+// by enableSpill() and clear() and removed when the pyramid is destroyed.
+// The pyramid needs RLMappedFile.cpp in the target's sources.
+
+namespace RLCharts {
+
+// One reduced range: samples [mFirst, mFirst + mCount)
+struct SampleBucket {
+    float mMin = 0.0f;
+    float mMax = 0.0f;
+    float mMean = 0.0f;
+    size_t mFirst = 0;
+    size_t mCount = 0;
+};
+
+class SamplePyramid {
+public:
+    static constexpr size_t FANOUT = 4;
+    // Elements per spilled block (every level)
+    static constexpr size_t SPILL_BLOCK = 65536;
+    static constexpr size_t DEFAULT_RESIDENT = 1 << 20;
+
+    SamplePyramid() { clear(); }
+    ~SamplePyramid() {
+        mMap.close();
+        if (!mSpillPath.empty()) {
+            std::remove(mSpillPath.c_str());
+        }
+    }
+
+    SamplePyramid(const SamplePyramid&) = delete;
+    SamplePyramid& operator=(const SamplePyramid&) = delete;
+
+    void clear() {
+        mRaw = LevelStore<float>{};
+        mLevels.clear();
+        mOpen.assign(2, Accumulator{});
+        mSampleCount = 0;
+        if (!mSpillPath.empty()) {
+            mMap.close();
+            mSpillBytes = 0;
+            mSpillOk = truncateSpill();
+        }
+    }
+
+    // Spill levels holding more than aResidentElements elements to pPath.
+    // Returns false (and keeps everything in memory) if the file cannot be created.
+    bool enableSpill(const char* pPath, size_t aResidentElements = DEFAULT_RESIDENT) {
+        disableSpill();
+        if (pPath == nullptr || *pPath == '\0') {
+            return false;
+        }
+        mSpillPath = pPath;
+        mResidentLimit = std::max(aResidentElements, SPILL_BLOCK);
+        if (!truncateSpill()) {
+            mSpillPath.clear();
+            return false;
+        }
+        mSpillOk = true;
+        spillIfNeeded();
+        return true;
+    }
+
+    // Read every spilled block back into memory and delete the file
+    void disableSpill() {
+        if (mSpillPath.empty()) {
+            return;
+        }
+        unspill(mRaw);
+        for (LevelStore<Bucket>& rLevel : mLevels) {
+            unspill(rLevel);
+        }
+        mMap.close();
+        std::remove(mSpillPath.c_str());
+        mSpillPath.clear();
+        mSpillBytes = 0;
+        mSpillOk = false;
+    }
+
+    void append(float aValue) {
+        mRaw.mResident.push_back(aValue);
+        mSampleCount++;
+        fold(1, aValue, aValue, (double)aValue);
+        if (mSpillOk && mRaw.mResident.size() >= mResidentLimit + SPILL_BLOCK) {
+            spillIfNeeded();
+        }
+    }
+
+    void append(std::span<const float> aValues) {
+        for (const float lValue : aValues) {
+            append(lValue);
+        }
+    }
+
+    // Reduce samples [aFirst, aFirst + aCount) (clamped to the history) to at
+    // most aColumns buckets of about equal width, appended to rOut oldest first.
+    // Fewer samples than columns give one bucket per sample. Returns the number
+    // of buckets appended.
+    size_t collect(size_t aFirst, size_t aCount, size_t aColumns, std::vector<SampleBucket>& rOut) const {
+        if (aFirst >= mSampleCount || aCount == 0 || aColumns == 0) {
+            return 0;
+        }
+        aCount = std::min(aCount, mSampleCount - aFirst);
+        const size_t lColumns = std::min(aColumns, aCount);
+        const size_t lLevel = levelFor(aCount / lColumns);
+        for (size_t c = 0; c < lColumns; c++) {
+            const size_t lLo = aFirst + c * aCount / lColumns;
+            const size_t lHi = aFirst + (c + 1) * aCount / lColumns;
+            rOut.push_back(reduce(lLo, lHi, lLevel));
+        }
+        return lColumns;
+    }
+
+    // Min and max of samples [aFirst, aFirst + aCount); false if the range is empty
+    bool extent(size_t aFirst, size_t aCount, float& rMin, float& rMax) const {
+        if (aFirst >= mSampleCount || aCount == 0) {
+            return false;
+        }
+        aCount = std::min(aCount, mSampleCount - aFirst);
+        const SampleBucket lAll = reduce(aFirst, aFirst + aCount, levelFor(aCount));
+        rMin = lAll.mMin;
+        rMax = lAll.mMax;
+        return true;
+    }
+
+    [[nodiscard]] size_t getSampleCount() const { return mSampleCount; }
+    // Levels holding at least one complete bucket, the raw samples included
+    [[nodiscard]] size_t getLevelCount() const { return 1 + mLevels.size(); }
+    [[nodiscard]] bool isSpilling() const { return mSpillOk; }
+    [[nodiscard]] size_t getResidentBytes() const {
+        size_t lBytes = mRaw.mResident.size() * sizeof(float);
+        for (const LevelStore<Bucket>& rLevel : mLevels) {
+            lBytes += rLevel.mResident.size() * sizeof(Bucket);
+        }
+        return lBytes;
+    }
+    [[nodiscard]] size_t getSpilledBytes() const { return mSpillBytes; }
+
+private:
+    struct Bucket {
+        float mMin;
+        float mMax;
+        float mMean;
+    };
+
+    // Level L + 1's bucket being filled from level L (level 0 = the samples)
+    struct Accumulator {
+        float mMin = 0.0f;
+        float mMax = 0.0f;
+        double mSum = 0.0;
+        size_t mCount = 0; // level L elements folded in
+        size_t mSamples = 0;
+    };
+
+    // Elements [0, mBlocks.size() * SPILL_BLOCK) live in the spill file, the rest in mResident
+    template<typename T>
+    struct LevelStore {
+        std::vector<uint64_t> mBlocks; // file offsets of the spilled blocks
+        std::vector<T> mResident;
+
+        [[nodiscard]] size_t spilled() const { return mBlocks.size() * SPILL_BLOCK; }
+        [[nodiscard]] size_t size() const { return spilled() + mResident.size(); }
+    };
+
+    // Samples per bucket of aLevel
+    static size_t bucketSpan(size_t aLevel) {
+        size_t lSpan = 1;
+        for (size_t i = 0; i < aLevel; i++) {
+            lSpan *= FANOUT;
+        }
+        return lSpan;
+    }
+
+    // Coarsest existing level whose buckets hold at most aSamples samples
+    [[nodiscard]] size_t levelFor(size_t aSamples) const {
+        size_t lLevel = 0;
+        size_t lSpan = 1;
+        while (lLevel < mLevels.size() && lSpan * FANOUT <= aSamples) {
+            lSpan *= FANOUT;
+            lLevel++;
+        }
+        return lLevel;
+    }
+
+    // Fold one complete level aLevel - 1 element into level aLevel's open bucket
+    void fold(size_t aLevel, float aMin, float aMax, double aSum) {
+        for (;;) {
+            Accumulator& rOpen = mOpen[aLevel];
+            const size_t lChildSpan = bucketSpan(aLevel - 1);
+            if (rOpen.mCount == 0) {
+                rOpen.mMin = aMin;
+                rOpen.mMax = aMax;
+                rOpen.mSum = 0.0;
+            } else {
+                rOpen.mMin = std::min(rOpen.mMin, aMin);
+                rOpen.mMax = std::max(rOpen.mMax, aMax);
+            }
+            rOpen.mSum += aSum;
+            rOpen.mCount++;
+            rOpen.mSamples += lChildSpan;
+            if (rOpen.mCount < FANOUT) {
+                return;
+            }
+            const Bucket lDone{ rOpen.mMin, rOpen.mMax, (float)(rOpen.mSum / (double)rOpen.mSamples) };
+            const double lSum = rOpen.mSum;
+            rOpen = Accumulator{};
+            if (mLevels.size() < aLevel) {
+                mLevels.resize(aLevel);
+                mOpen.resize(aLevel + 2);
+            }
+            mLevels[aLevel - 1].mResident.push_back(lDone);
+            aMin = lDone.mMin;
+            aMax = lDone.mMax;
+            aSum = lSum;
+            aLevel++;
+        }
+    }
+
+    // Element aIndex of a level, from memory or the spill file
+    template<typename T>
+    T read(const LevelStore<T>& rLevel, size_t aIndex) const {
+        const size_t lSpilled = rLevel.spilled();
+        if (aIndex >= lSpilled) {
+            return rLevel.mResident[aIndex - lSpilled];
+        }
+        T lValue{};
+        const uint64_t lOffset = rLevel.mBlocks[aIndex / SPILL_BLOCK] + (aIndex % SPILL_BLOCK) * sizeof(T);
+        if (lOffset + sizeof(T) <= mMap.size()) {
+            std::memcpy(&lValue, mMap.data() + lOffset, sizeof(T));
+        }
+        return lValue;
+    }
+
+    // Samples [aLo, aHi) as seen from aLevel: the buckets starting in the range,
+    // plus the partial newest bucket when the range reaches the end
+    [[nodiscard]] SampleBucket reduce(size_t aLo, size_t aHi, size_t aLevel) const {
+        const size_t lSpan = bucketSpan(aLevel);
+        size_t lBegin = aLo / lSpan;
+        size_t lEnd = aHi == mSampleCount ? (aHi + lSpan - 1) / lSpan : aHi / lSpan;
+        if (lEnd <= lBegin) {
+            lEnd = lBegin + 1;
+        }
+        const size_t lComplete = aLevel == 0 ? mRaw.size() : mLevels[aLevel - 1].size();
+
+        SampleBucket lOut;
+        lOut.mFirst = lBegin * lSpan;
+        double lSum = 0.0;
+        auto lMerge = [&](float aMin, float aMax, double aSum, size_t aCount) {
+            if (lOut.mCount == 0) {
+                lOut.mMin = aMin;
+                lOut.mMax = aMax;
+            } else {
+                lOut.mMin = std::min(lOut.mMin, aMin);
+                lOut.mMax = std::max(lOut.mMax, aMax);
+            }
+            lSum += aSum;
+            lOut.mCount += aCount;
+        };
+        for (size_t b = lBegin; b < std::min(lEnd, lComplete); b++) {
+            if (aLevel == 0) {
+                const float lValue = read(mRaw, b);
+                lMerge(lValue, lValue, (double)lValue, 1);
+            } else {
+                const Bucket lBucket = read(mLevels[aLevel - 1], b);
+                lMerge(lBucket.mMin, lBucket.mMax, (double)lBucket.mMean * (double)lSpan, lSpan);
+            }
+        }
+        if (lEnd > lComplete) {
+            // The newest bucket is still open: it is spread over the open accumulators below
+            for (size_t lLevel = std::min(aLevel, mOpen.size() - 1); lLevel >= 1; lLevel--) {
+                const Accumulator& rOpen = mOpen[lLevel];
+                if (rOpen.mCount > 0) {
+                    lMerge(rOpen.mMin, rOpen.mMax, rOpen.mSum, rOpen.mSamples);
+                }
+            }
+        }
+        lOut.mMean = lOut.mCount > 0 ? (float)(lSum / (double)lOut.mCount) : 0.0f;
+        return lOut;
+    }
+
+    bool truncateSpill() {
+        FILE* lpFile = std::fopen(mSpillPath.c_str(), "wb");
+        return lpFile != nullptr && std::fclose(lpFile) == 0;
+    }
+
+    // Move whole blocks beyond the resident limit of every level to the file
+    void spillIfNeeded() {
+        if (!mSpillOk) {
+            return;
+        }
+        auto lOver = [this](size_t aResident) { return aResident >= mResidentLimit + SPILL_BLOCK; };
+        bool lAny = lOver(mRaw.mResident.size());
+        for (const LevelStore<Bucket>& rLevel : mLevels) {
+            lAny = lAny || lOver(rLevel.mResident.size());
+        }
+        if (!lAny) {
+            return;
+        }
+        // The mapping is closed while appending (Windows will not share a mapped file for writing)
+        mMap.close();
+        FILE* lpFile = std::fopen(mSpillPath.c_str(), "ab");
+        bool lOk = lpFile != nullptr;
+        if (lOk) {
+            lOk = spillLevel(lpFile, mRaw);
+            for (LevelStore<Bucket>& rLevel : mLevels) {
+                lOk = lOk && spillLevel(lpFile, rLevel);
+            }
+            lOk = std::fclose(lpFile) == 0 && lOk;
+        }
+        mSpillOk = lOk && (mSpillBytes == 0 || mMap.open(mSpillPath.c_str()));
+    }
+
+    template<typename T>
+    bool spillLevel(FILE* pFile, LevelStore<T>& rLevel) {
+        size_t lBlocks = 0;
+        bool lOk = true;
+        while (rLevel.mResident.size() - lBlocks * SPILL_BLOCK >= mResidentLimit + SPILL_BLOCK) {
+            const T* pBlock = rLevel.mResident.data() + lBlocks * SPILL_BLOCK;
+            if (std::fwrite(pBlock, sizeof(T), SPILL_BLOCK, pFile) != SPILL_BLOCK) {
+                lOk = false;
+                break;
+            }
+            rLevel.mBlocks.push_back(mSpillBytes);
+            mSpillBytes += SPILL_BLOCK * sizeof(T);
+            lBlocks++;
+        }
+        rLevel.mResident.erase(rLevel.mResident.begin(), rLevel.mResident.begin() + (std::ptrdiff_t)(lBlocks * SPILL_BLOCK));
+        return lOk;
+    }
+
+    template<typename T>
+    void unspill(LevelStore<T>& rLevel) {
+        if (rLevel.mBlocks.empty()) {
+            return;
+        }
+        std::vector<T> lAll(rLevel.size());
+        for (size_t i = 0; i < rLevel.spilled(); i++) {
+            lAll[i] = read(rLevel, i);
+        }
+        std::copy(rLevel.mResident.begin(), rLevel.mResident.end(), lAll.begin() + (std::ptrdiff_t)rLevel.spilled());
+        rLevel.mResident = std::move(lAll);
+        rLevel.mBlocks.clear();
+    }
+
+    LevelStore<float> mRaw;
+    std::vector<LevelStore<Bucket>> mLevels; // level L at index L - 1
+    std::vector<Accumulator> mOpen;          // open bucket of level L at index L (0 unused)
+    size_t mSampleCount = 0;
+
+    std::string mSpillPath;
+    size_t mResidentLimit = DEFAULT_RESIDENT;
+    uint64_t mSpillBytes = 0;
+    bool mSpillOk = false;
+    MappedFile mMap;
+};
+
+} // namespace RLCharts
@@ -0,0 +1,534 @@
+// RLSimd.h
+#pragma once
+#include <cstdint>
+#include <cstddef>
+
+// SIMD kernels shared by the charts' per-frame CPU hot paths.
+// The instruction set is picked at compile time (AVX2 > SSE2 on x86, NEON on ARM,
+// SIMD128 on WebAssembly built with -msimd128); every kernel has a scalar
+// reference implementation producing identical results, used for the remainder
+// elements and on targets without SIMD.
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define RLCHARTS_SIMD_AVX2 1
+    #define RLCHARTS_SIMD_SSE2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define RLCHARTS_SIMD_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define RLCHARTS_SIMD_NEON 1
+#elif defined(__wasm_simd128__)
+    #include <wasm_simd128.h>
+    #define RLCHARTS_SIMD_WASM 1
+#endif
+
+namespace RLCharts {
+
+// Name of the compiled-in instruction set (for logs and benchmarks)
+inline const char* simdName() {
+#if defined(RLCHARTS_SIMD_AVX2)
+    return "avx2";
+#elif defined(RLCHARTS_SIMD_SSE2)
+    return "sse2";
+#elif defined(RLCHARTS_SIMD_NEON)
+    return "neon";
+#elif defined(RLCHARTS_SIMD_WASM)
+    return "wasm-simd128";
+#else
+    return "scalar";
+#endif
+}
+
+// Reference colorization: pOut[i] = pLut[clamp((int)(pValues[i] * aInvMax * 255), 0, 255)]
+// pLut holds 256 packed RGBA colors (raylib Color layout).
+inline void colorizeLutScalar(const float* pValues, uint32_t* pOut, size_t aCount,
+                              float aInvMax, const uint32_t* pLut) {
+    for (size_t i = 0; i < aCount; ++i) {
+        float lT = pValues[i] * aInvMax * 255.0f;
+        lT = lT < 255.0f ? lT : 255.0f; // same operand order as minps/maxps (NaN -> 255)
+        lT = lT > 0.0f ? lT : 0.0f;
+        pOut[i] = pLut[(int)lT];
+    }
+}
+
+// Vectorized colorization: the index math runs 4 or 8 lanes wide, the LUT fetch
+// uses a hardware gather on AVX2 and scalar loads elsewhere.
+inline void colorizeLut(const float* pValues, uint32_t* pOut, size_t aCount,
+                        float aInvMax, const uint32_t* pLut) {
+    size_t i = 0;
+#if defined(RLCHARTS_SIMD_AVX2)
+    const __m256 lInv8 = _mm256_set1_ps(aInvMax);
+    const __m256 lScale8 = _mm256_set1_ps(255.0f);
+    const __m256 lZero8 = _mm256_setzero_ps();
+    for (; i + 8 <= aCount; i += 8) {
+        __m256 lT = _mm256_mul_ps(_mm256_mul_ps(_mm256_loadu_ps(pValues + i), lInv8), lScale8);
+        lT = _mm256_max_ps(_mm256_min_ps(lT, lScale8), lZero8);
+        const __m256i lIdx = _mm256_cvttps_epi32(lT);
+        const __m256i lRgba = _mm256_i32gather_epi32((const int*)pLut, lIdx, 4);
+        _mm256_storeu_si256((__m256i*)(pOut + i), lRgba);
+    }
+#elif defined(RLCHARTS_SIMD_SSE2)
+    const __m128 lInv4 = _mm_set1_ps(aInvMax);
+    const __m128 lScale4 = _mm_set1_ps(255.0f);
+    const __m128 lZero4 = _mm_setzero_ps();
+    alignas(16) int32_t lIdx[4];
+    for (; i + 4 <= aCount; i += 4) {
+        __m128 lT = _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(pValues + i), lInv4), lScale4);
+        lT = _mm_max_ps(_mm_min_ps(lT, lScale4), lZero4);
+        _mm_store_si128((__m128i*)lIdx, _mm_cvttps_epi32(lT));
+        pOut[i + 0] = pLut[lIdx[0]];
+        pOut[i + 1] = pLut[lIdx[1]];
+        pOut[i + 2] = pLut[lIdx[2]];
+        pOut[i + 3] = pLut[lIdx[3]];
+    }
+#elif defined(RLCHARTS_SIMD_NEON)
+    const float32x4_t lInv4 = vdupq_n_f32(aInvMax);
+    const float32x4_t lScale4 = vdupq_n_f32(255.0f);
+    const float32x4_t lZero4 = vdupq_n_f32(0.0f);
+    int32_t lIdx[4];
+    for (; i + 4 <= aCount; i += 4) {
+        float32x4_t lT = vmulq_f32(vmulq_f32(vld1q_f32(pValues + i), lInv4), lScale4);
+        lT = vmaxq_f32(vminq_f32(lT, lScale4), lZero4);
+        vst1q_s32(lIdx, vcvtq_s32_f32(lT));
+        pOut[i + 0] = pLut[lIdx[0]];
+        pOut[i + 1] = pLut[lIdx[1]];
+        pOut[i + 2] = pLut[lIdx[2]];
+        pOut[i + 3] = pLut[lIdx[3]];
+    }
+#elif defined(RLCHARTS_SIMD_WASM)
+    const v128_t lInv4 = wasm_f32x4_splat(aInvMax);
+    const v128_t lScale4 = wasm_f32x4_splat(255.0f);
+    const v128_t lZero4 = wasm_f32x4_splat(0.0f);
+    for (; i + 4 <= aCount; i += 4) {
+        v128_t lT = wasm_f32x4_mul(wasm_f32x4_mul(wasm_v128_load(pValues + i), lInv4), lScale4);
+        lT = wasm_f32x4_pmax(wasm_f32x4_pmin(lT, lScale4), lZero4);
+        const v128_t lIdx = wasm_i32x4_trunc_sat_f32x4(lT);
+        pOut[i + 0] = pLut[wasm_i32x4_extract_lane(lIdx, 0)];
+        pOut[i + 1] = pLut[wasm_i32x4_extract_lane(lIdx, 1)];
+        pOut[i + 2] = pLut[wasm_i32x4_extract_lane(lIdx, 2)];
+        pOut[i + 3] = pLut[wasm_i32x4_extract_lane(lIdx, 3)];
+    }
+#endif
+    colorizeLutScalar(pValues + i, pOut + i, aCount - i, aInvMax, pLut);
+}
+
+// Interpolation weights for the true-peak estimate: Catmull-Rom between the two
+// middle samples of a 4-sample history at t = 1/4, 1/2, 3/4 (4x oversampling)
+constexpr float PCM_TP_W25[4] = { -0.0703125f, 0.8671875f, 0.2265625f, -0.0234375f };
+constexpr float PCM_TP_W50[4] = { -0.0625f, 0.5625f, 0.5625f, -0.0625f };
+constexpr float PCM_TP_W75[4] = { -0.0234375f, 0.2265625f, 0.8671875f, -0.0703125f };
+
+// Reference per-channel block statistics of interleaved PCM (aFrames frames of
+// aChannels samples), for channels [aFirst, aChannels): adds x^2 to pSumSq[c],
+// raises pPeak[c] to max |x| and pTruePeak[c] to the max of |x| and the
+// interpolated in-between values. pHistory holds the last three samples per
+// channel (3 * aChannels floats, oldest first: [h0 | h1 | h2]) and carries the
+// interpolation across blocks.
+inline void pcmBlockStatsScalar(const float* pFrames, size_t aFrames, size_t aChannels, size_t aFirst,
+                                float* pSumSq, float* pPeak, float* pTruePeak, float* pHistory) {
+    float* pH0 = pHistory;
+    float* pH1 = pHistory + aChannels;
+    float* pH2 = pHistory + 2 * aChannels;
+    for (size_t f = 0; f < aFrames; ++f) {
+        const float* pRow = pFrames + f * aChannels;
+        for (size_t c = aFirst; c < aChannels; ++c) {
+            const float lX = pRow[c];
+            const float lAbs = lX < 0.0f ? -lX : lX;
+            pSumSq[c] += lX * lX;
+            pPeak[c] = pPeak[c] > lAbs ? pPeak[c] : lAbs;
+            const float lH0 = pH0[c];
+            const float lH1 = pH1[c];
+            const float lH2 = pH2[c];
+            float lI25 = PCM_TP_W25[0] * lH0 + PCM_TP_W25[1] * lH1 + PCM_TP_W25[2] * lH2 + PCM_TP_W25[3] * lX;
+            float lI50 = PCM_TP_W50[0] * lH0 + PCM_TP_W50[1] * lH1 + PCM_TP_W50[2] * lH2 + PCM_TP_W50[3] * lX;
+            float lI75 = PCM_TP_W75[0] * lH0 + PCM_TP_W75[1] * lH1 + PCM_TP_W75[2] * lH2 + PCM_TP_W75[3] * lX;
+            lI25 = lI25 < 0.0f ? -lI25 : lI25;
+            lI50 = lI50 < 0.0f ? -lI50 : lI50;
+            lI75 = lI75 < 0.0f ? -lI75 : lI75;
+            float lTrue = pTruePeak[c] > lAbs ? pTruePeak[c] : lAbs;
+            lTrue = lTrue > lI25 ? lTrue : lI25;
+            lTrue = lTrue > lI50 ? lTrue : lI50;
+            pTruePeak[c] = lTrue > lI75 ? lTrue : lI75;
+            pH0[c] = lH1;
+            pH1[c] = lH2;
+            pH2[c] = lX;
+        }
+    }
+}
+
+// Vectorized block statistics: four channels per lane group (the interleaved
+// rows are contiguous in channel order), the remaining channels go through the
+// scalar reference. Each channel sees the same operations in the same order, so
+// the results match pcmBlockStatsScalar exactly.
+inline void pcmBlockStats(const float* pFrames, size_t aFrames, size_t aChannels,
+                          float* pSumSq, float* pPeak, float* pTruePeak, float* pHistory) {
+    size_t lVector = 0;
+#if defined(RLCHARTS_SIMD_SSE2)
+    lVector = aChannels & ~(size_t)3;
+    const __m128 lSign = _mm_set1_ps(-0.0f);
+    float* pH0 = pHistory;
+    float* pH1 = pHistory + aChannels;
+    float* pH2 = pHistory + 2 * aChannels;
+    for (size_t f = 0; f < aFrames; ++f) {
+        const float* pRow = pFrames + f * aChannels;
+        for (size_t c = 0; c < lVector; c += 4) {
+            const __m128 lX = _mm_loadu_ps(pRow + c);
+            const __m128 lAbs = _mm_andnot_ps(lSign, lX);
+            _mm_storeu_ps(pSumSq + c, _mm_add_ps(_mm_loadu_ps(pSumSq + c), _mm_mul_ps(lX, lX)));
+            _mm_storeu_ps(pPeak + c, _mm_max_ps(_mm_loadu_ps(pPeak + c), lAbs));
+            const __m128 lH0 = _mm_loadu_ps(pH0 + c);
+            const __m128 lH1 = _mm_loadu_ps(pH1 + c);
+            const __m128 lH2 = _mm_loadu_ps(pH2 + c);
+            const auto lInterp = [&](const float* pW) {
+                __m128 lI = _mm_mul_ps(_mm_set1_ps(pW[0]), lH0);
+                lI = _mm_add_ps(lI, _mm_mul_ps(_mm_set1_ps(pW[1]), lH1));
+                lI = _mm_add_ps(lI, _mm_mul_ps(_mm_set1_ps(pW[2]), lH2));
+                lI = _mm_add_ps(lI, _mm_mul_ps(_mm_set1_ps(pW[3]), lX));
+                return _mm_andnot_ps(lSign, lI);
+            };
+            __m128 lTrue = _mm_max_ps(_mm_loadu_ps(pTruePeak + c), lAbs);
+            lTrue = _mm_max_ps(lTrue, lInterp(PCM_TP_W25));
+            lTrue = _mm_max_ps(lTrue, lInterp(PCM_TP_W50));
+            lTrue = _mm_max_ps(lTrue, lInterp(PCM_TP_W75));
+            _mm_storeu_ps(pTruePeak + c, lTrue);
+            _mm_storeu_ps(pH0 + c, lH1);
+            _mm_storeu_ps(pH1 + c, lH2);
+            _mm_storeu_ps(pH2 + c, lX);
+        }
+    }
+#elif defined(RLCHARTS_SIMD_NEON)
+    lVector = aChannels & ~(size_t)3;
+    float* pH0 = pHistory;
+    float* pH1 = pHistory + aChannels;
+    float* pH2 = pHistory + 2 * aChannels;
+    for (size_t f = 0; f < aFrames; ++f) {
+        const float* pRow = pFrames + f * aChannels;
+        for (size_t c = 0; c < lVector; c += 4) {
+            const float32x4_t lX = vld1q_f32(pRow + c);
+            const float32x4_t lAbs = vabsq_f32(lX);
+            vst1q_f32(pSumSq + c, vaddq_f32(vld1q_f32(pSumSq + c), vmulq_f32(lX, lX)));
+            vst1q_f32(pPeak + c, vmaxq_f32(vld1q_f32(pPeak + c), lAbs));
+            const float32x4_t lH0 = vld1q_f32(pH0 + c);
+            const float32x4_t lH1 = vld1q_f32(pH1 + c);
+            const float32x4_t lH2 = vld1q_f32(pH2 + c);
+            // Separate multiply and add (no fused vmla) to match the scalar rounding
+            const auto lInterp = [&](const float* pW) {
+                float32x4_t lI = vmulq_f32(vdupq_n_f32(pW[0]), lH0);
+                lI = vaddq_f32(lI, vmulq_f32(vdupq_n_f32(pW[1]), lH1));
+                lI = vaddq_f32(lI, vmulq_f32(vdupq_n_f32(pW[2]), lH2));
+                lI = vaddq_f32(lI, vmulq_f32(vdupq_n_f32(pW[3]), lX));
+                return vabsq_f32(lI);
+            };
+            float32x4_t lTrue = vmaxq_f32(vld1q_f32(pTruePeak + c), lAbs);
+            lTrue = vmaxq_f32(lTrue, lInterp(PCM_TP_W25));
+            lTrue = vmaxq_f32(lTrue, lInterp(PCM_TP_W50));
+            lTrue = vmaxq_f32(lTrue, lInterp(PCM_TP_W75));
+            vst1q_f32(pTruePeak + c, lTrue);
+            vst1q_f32(pH0 + c, lH1);
+            vst1q_f32(pH1 + c, lH2);
+            vst1q_f32(pH2 + c, lX);
+        }
+    }
+#elif defined(RLCHARTS_SIMD_WASM)
+    lVector = aChannels & ~(size_t)3;
+    float* pH0 = pHistory;
+    float* pH1 = pHistory + aChannels;
+    float* pH2 = pHistory + 2 * aChannels;
+    for (size_t f = 0; f < aFrames; ++f) {
+        const float* pRow = pFrames + f * aChannels;
+        for (size_t c = 0; c < lVector; c += 4) {
+            const v128_t lX = wasm_v128_load(pRow + c);
+            const v128_t lAbs = wasm_f32x4_abs(lX);
+            wasm_v128_store(pSumSq + c, wasm_f32x4_add(wasm_v128_load(pSumSq + c), wasm_f32x4_mul(lX, lX)));
+            wasm_v128_store(pPeak + c, wasm_f32x4_pmax(wasm_v128_load(pPeak + c), lAbs));
+            const v128_t lH0 = wasm_v128_load(pH0 + c);
+            const v128_t lH1 = wasm_v128_load(pH1 + c);
+            const v128_t lH2 = wasm_v128_load(pH2 + c);
+            const auto lInterp = [&](const float* pW) {
+                v128_t lI = wasm_f32x4_mul(wasm_f32x4_splat(pW[0]), lH0);
+                lI = wasm_f32x4_add(lI, wasm_f32x4_mul(wasm_f32x4_splat(pW[1]), lH1));
+                lI = wasm_f32x4_add(lI, wasm_f32x4_mul(wasm_f32x4_splat(pW[2]), lH2));
+                lI = wasm_f32x4_add(lI, wasm_f32x4_mul(wasm_f32x4_splat(pW[3]), lX));
+                return wasm_f32x4_abs(lI);
+            };
+            v128_t lTrue = wasm_f32x4_pmax(wasm_v128_load(pTruePeak + c), lAbs);
+            lTrue = wasm_f32x4_pmax(lTrue, lInterp(PCM_TP_W25));
+            lTrue = wasm_f32x4_pmax(lTrue, lInterp(PCM_TP_W50));
+            lTrue = wasm_f32x4_pmax(lTrue, lInterp(PCM_TP_W75));
+            wasm_v128_store(pTruePeak + c, lTrue);
+            wasm_v128_store(pH0 + c, lH1);
+            wasm_v128_store(pH1 + c, lH2);
+            wasm_v128_store(pH2 + c, lX);
+        }
+    }
+#endif
+    pcmBlockStatsScalar(pFrames, aFrames, aChannels, lVector, pSumSq, pPeak, pTruePeak, pHistory);
+}
+
+// Reference range: lowers rMin and raises rMax over pValues[0, aCount). The
+// caller seeds both (e.g. with the first value).
+inline void minMaxScalar(const float* pValues, size_t aCount, float& rMin, float& rMax) {
+    for (size_t i = 0; i < aCount; ++i) {
+        rMin = pValues[i] < rMin ? pValues[i] : rMin;
+        rMax = pValues[i] > rMax ? pValues[i] : rMax;
+    }
+}
+
+// Vectorized range: four running minima and maxima, reduced at the end
+inline void minMax(const float* pValues, size_t aCount, float& rMin, float& rMax) {
+    size_t i = 0;
+    float lMin[4] = { rMin, rMin, rMin, rMin };
+    float lMax[4] = { rMax, rMax, rMax, rMax };
+#if defined(RLCHARTS_SIMD_SSE2)
+    __m128 lMin4 = _mm_set1_ps(rMin);
+    __m128 lMax4 = _mm_set1_ps(rMax);
+    for (; i + 4 <= aCount; i += 4) {
+        const __m128 lX = _mm_loadu_ps(pValues + i);
+        lMin4 = _mm_min_ps(lX, lMin4);
+        lMax4 = _mm_max_ps(lX, lMax4);
+    }
+    _mm_storeu_ps(lMin, lMin4);
+    _mm_storeu_ps(lMax, lMax4);
+#elif defined(RLCHARTS_SIMD_NEON)
+    float32x4_t lMin4 = vdupq_n_f32(rMin);
+    float32x4_t lMax4 = vdupq_n_f32(rMax);
+    for (; i + 4 <= aCount; i += 4) {
+        const float32x4_t lX = vld1q_f32(pValues + i);
+        lMin4 = vminq_f32(lX, lMin4);
+        lMax4 = vmaxq_f32(lX, lMax4);
+    }
+    vst1q_f32(lMin, lMin4);
+    vst1q_f32(lMax, lMax4);
+#elif defined(RLCHARTS_SIMD_WASM)
+    v128_t lMin4 = wasm_f32x4_splat(rMin);
+    v128_t lMax4 = wasm_f32x4_splat(rMax);
+    for (; i + 4 <= aCount; i += 4) {
+        const v128_t lX = wasm_v128_load(pValues + i);
+        lMin4 = wasm_f32x4_pmin(lX, lMin4);
+        lMax4 = wasm_f32x4_pmax(lX, lMax4);
+    }
+    wasm_v128_store(lMin, lMin4);
+    wasm_v128_store(lMax, lMax4);
+#endif
+    minMaxScalar(lMin, 4, rMin, rMax);
+    minMaxScalar(lMax, 4, rMin, rMax);
+    minMaxScalar(pValues + i, aCount - i, rMin, rMax);
+}
+
+// Reference affine map: pOut[i] = pValues[i] * aScale + aOffset (multiply, then
+// add; pOut may alias pValues)
+inline void scaleOffsetScalar(const float* pValues, float* pOut, size_t aCount, float aScale, float aOffset) {
+    for (size_t i = 0; i < aCount; ++i) {
+        pOut[i] = pValues[i] * aScale + aOffset;
+    }
+}
+
+// Vectorized affine map, 4 or 8 lanes wide
+inline void scaleOffset(const float* pValues, float* pOut, size_t aCount, float aScale, float aOffset) {
+    size_t i = 0;
+#if defined(RLCHARTS_SIMD_AVX2)
+    const __m256 lScale8 = _mm256_set1_ps(aScale);
+    const __m256 lOffset8 = _mm256_set1_ps(aOffset);
+    for (; i + 8 <= aCount; i += 8) {
+        _mm256_storeu_ps(pOut + i, _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(pValues + i), lScale8), lOffset8));
+    }
+#elif defined(RLCHARTS_SIMD_SSE2)
+    const __m128 lScale4 = _mm_set1_ps(aScale);
+    const __m128 lOffset4 = _mm_set1_ps(aOffset);
+    for (; i + 4 <= aCount; i += 4) {
+        _mm_storeu_ps(pOut + i, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(pValues + i), lScale4), lOffset4));
+    }
+#elif defined(RLCHARTS_SIMD_NEON)
+    const float32x4_t lScale4 = vdupq_n_f32(aScale);
+    const float32x4_t lOffset4 = vdupq_n_f32(aOffset);
+    for (; i + 4 <= aCount; i += 4) {
+        vst1q_f32(pOut + i, vaddq_f32(vmulq_f32(vld1q_f32(pValues + i), lScale4), lOffset4));
+    }
+#elif defined(RLCHARTS_SIMD_WASM)
+    const v128_t lScale4 = wasm_f32x4_splat(aScale);
+    const v128_t lOffset4 = wasm_f32x4_splat(aOffset);
+    for (; i + 4 <= aCount; i += 4) {
+        wasm_v128_store(pOut + i, wasm_f32x4_add(wasm_f32x4_mul(wasm_v128_load(pValues + i), lScale4), lOffset4));
+    }
+#endif
+    scaleOffsetScalar(pValues + i, pOut + i, aCount - i, aScale, aOffset);
+}
+
+// Reference binning of points in normalized [-1, 1] space (x right, y up, stored
+// as interleaved x, y pairs like raylib's Vector2) onto an aCellsX x aCellsY
+// row-major grid whose row 0 is the top:
+//   ix = clamp((int)(x * aCellsX/2 + aCellsX/2)), iy = clamp((int)(aCellsY/2 - y * aCellsY/2))
+// pOut[i] = iy * aCellsX + ix, or -1 for a point outside [-1, 1] (NaN included).
+// rBounds = { minX, minY, maxX, maxY } is widened to the cells of valid points;
+// the caller seeds it (e.g. { INT32_MAX, INT32_MAX, -1, -1 }).
+inline void normalizedToCellsScalar(const float* pXY, size_t aCount, int aCellsX, int aCellsY,
+                                    int32_t* pOut, int32_t (&rBounds)[4]) {
+    const float lHalfW = (float)aCellsX * 0.5f;
+    const float lHalfH = (float)aCellsY * 0.5f;
+    const float lLastX = (float)(aCellsX - 1);
+    const float lLastY = (float)(aCellsY - 1);
+    for (size_t i = 0; i < aCount; ++i) {
+        const float lX = pXY[2 * i];
+        const float lY = pXY[2 * i + 1];
+        if (!(lX >= -1.0f && lX <= 1.0f && lY >= -1.0f && lY <= 1.0f)) {
+            pOut[i] = -1;
+            continue;
+        }
+        // Clamping before the truncation gives the same cell as clamping after it
+        float lFx = lX * lHalfW + lHalfW;
+        float lFy = lHalfH - lY * lHalfH;
+        lFx = lFx < lLastX ? lFx : lLastX;
+        lFy = lFy < lLastY ? lFy : lLastY;
+        const int32_t lIx = (int32_t)(lFx > 0.0f ? lFx : 0.0f);
+        const int32_t lIy = (int32_t)(lFy > 0.0f ? lFy : 0.0f);
+        pOut[i] = lIy * aCellsX + lIx;
+        rBounds[0] = lIx < rBounds[0] ? lIx : rBounds[0];
+        rBounds[1] = lIy < rBounds[1] ? lIy : rBounds[1];
+        rBounds[2] = lIx > rBounds[2] ? lIx : rBounds[2];
+        rBounds[3] = lIy > rBounds[3] ? lIy : rBounds[3];
+    }
+}
+
+// Vectorized binning, four points per step: the lanes deinterleave x and y, clamp
+// and truncate the cell coordinates, and form the index in float, which is exact
+// up to 2^24 cells (larger grids take the scalar reference). The bounds are kept
+// as float minima/maxima of the truncated coordinates, invalid lanes masked out.
+inline void normalizedToCells(const float* pXY, size_t aCount, int aCellsX, int aCellsY,
+                              int32_t* pOut, int32_t (&rBounds)[4]) {
+    size_t i = 0;
+#if defined(RLCHARTS_SIMD_SSE2) || defined(RLCHARTS_SIMD_NEON) || defined(RLCHARTS_SIMD_WASM)
+    if ((size_t)aCellsX * (size_t)aCellsY <= ((size_t)1 << 24)) {
+        alignas(16) float lLow[4];
+        alignas(16) float lHigh[4];
+        const float lBig = 3.0e38f;
+#endif
+#if defined(RLCHARTS_SIMD_SSE2)
+        const __m128 lHalfW4 = _mm_set1_ps((float)aCellsX * 0.5f);
+        const __m128 lHalfH4 = _mm_set1_ps((float)aCellsY * 0.5f);
+        const __m128 lLastX4 = _mm_set1_ps((float)(aCellsX - 1));
+        const __m128 lLastY4 = _mm_set1_ps((float)(aCellsY - 1));
+        const __m128 lCellsX4 = _mm_set1_ps((float)aCellsX);
+        const __m128 lOne4 = _mm_set1_ps(1.0f);
+        const __m128 lMinusOne4 = _mm_set1_ps(-1.0f);
+        const __m128 lZero4 = _mm_setzero_ps();
+        const __m128 lBig4 = _mm_set1_ps(lBig);
+        const __m128 lMinusBig4 = _mm_set1_ps(-lBig);
+        __m128 lMinX4 = lBig4, lMinY4 = lBig4, lMaxX4 = lMinusBig4, lMaxY4 = lMinusBig4;
+        for (; i + 4 <= aCount; i += 4) {
+            const __m128 lA = _mm_loadu_ps(pXY + 2 * i);
+            const __m128 lB = _mm_loadu_ps(pXY + 2 * i + 4);
+            const __m128 lX = _mm_shuffle_ps(lA, lB, _MM_SHUFFLE(2, 0, 2, 0));
+            const __m128 lY = _mm_shuffle_ps(lA, lB, _MM_SHUFFLE(3, 1, 3, 1));
+            const __m128 lValid = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(lX, lMinusOne4), _mm_cmple_ps(lX, lOne4)),
+                                             _mm_and_ps(_mm_cmpge_ps(lY, lMinusOne4), _mm_cmple_ps(lY, lOne4)));
+            __m128 lFx = _mm_add_ps(_mm_mul_ps(lX, lHalfW4), lHalfW4);
+            __m128 lFy = _mm_sub_ps(lHalfH4, _mm_mul_ps(lY, lHalfH4));
+            lFx = _mm_cvtepi32_ps(_mm_cvttps_epi32(_mm_max_ps(_mm_min_ps(lFx, lLastX4), lZero4)));
+            lFy = _mm_cvtepi32_ps(_mm_cvttps_epi32(_mm_max_ps(_mm_min_ps(lFy, lLastY4), lZero4)));
+            const __m128i lIdx = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(lFy, lCellsX4), lFx));
+            const __m128i lValidI = _mm_castps_si128(lValid);
+            _mm_storeu_si128((__m128i*)(pOut + i), _mm_or_si128(_mm_and_si128(lValidI, lIdx),
+                                                               _mm_andnot_si128(lValidI, _mm_set1_epi32(-1))));
+            lMinX4 = _mm_min_ps(lMinX4, _mm_or_ps(_mm_and_ps(lValid, lFx), _mm_andnot_ps(lValid, lBig4)));
+            lMinY4 = _mm_min_ps(lMinY4, _mm_or_ps(_mm_and_ps(lValid, lFy), _mm_andnot_ps(lValid, lBig4)));
+            lMaxX4 = _mm_max_ps(lMaxX4, _mm_or_ps(_mm_and_ps(lValid, lFx), _mm_andnot_ps(lValid, lMinusBig4)));
+            lMaxY4 = _mm_max_ps(lMaxY4, _mm_or_ps(_mm_and_ps(lValid, lFy), _mm_andnot_ps(lValid, lMinusBig4)));
+        }
+        _mm_store_ps(lLow, _mm_min_ps(lMinX4, _mm_shuffle_ps(lMinX4, lMinX4, _MM_SHUFFLE(1, 0, 3, 2))));
+        _mm_store_ps(lHigh, _mm_max_ps(lMaxX4, _mm_shuffle_ps(lMaxX4, lMaxX4, _MM_SHUFFLE(1, 0, 3, 2))));
+        float lMinX = lLow[0] < lLow[1] ? lLow[0] : lLow[1];
+        float lMaxX = lHigh[0] > lHigh[1] ? lHigh[0] : lHigh[1];
+        _mm_store_ps(lLow, _mm_min_ps(lMinY4, _mm_shuffle_ps(lMinY4, lMinY4, _MM_SHUFFLE(1, 0, 3, 2))));
+        _mm_store_ps(lHigh, _mm_max_ps(lMaxY4, _mm_shuffle_ps(lMaxY4, lMaxY4, _MM_SHUFFLE(1, 0, 3, 2))));
+        float lMinY = lLow[0] < lLow[1] ? lLow[0] : lLow[1];
+        float lMaxY = lHigh[0] > lHigh[1] ? lHigh[0] : lHigh[1];
+#elif defined(RLCHARTS_SIMD_NEON)
+        const float32x4_t lHalfW4 = vdupq_n_f32((float)aCellsX * 0.5f);
+        const float32x4_t lHalfH4 = vdupq_n_f32((float)aCellsY * 0.5f);
+        const float32x4_t lLastX4 = vdupq_n_f32((float)(aCellsX - 1));
+        const float32x4_t lLastY4 = vdupq_n_f32((float)(aCellsY - 1));
+        const float32x4_t lCellsX4 = vdupq_n_f32((float)aCellsX);
+        const float32x4_t lOne4 = vdupq_n_f32(1.0f);
+        const float32x4_t lMinusOne4 = vdupq_n_f32(-1.0f);
+        const float32x4_t lZero4 = vdupq_n_f32(0.0f);
+        const float32x4_t lBig4 = vdupq_n_f32(lBig);
+        const float32x4_t lMinusBig4 = vdupq_n_f32(-lBig);
+        float32x4_t lMinX4 = lBig4, lMinY4 = lBig4, lMaxX4 = lMinusBig4, lMaxY4 = lMinusBig4;
+        for (; i + 4 <= aCount; i += 4) {
+            const float32x4x2_t lXY = vld2q_f32(pXY + 2 * i);
+            const uint32x4_t lValid = vandq_u32(vandq_u32(vcgeq_f32(lXY.val[0], lMinusOne4), vcleq_f32(lXY.val[0], lOne4)),
+                                                vandq_u32(vcgeq_f32(lXY.val[1], lMinusOne4), vcleq_f32(lXY.val[1], lOne4)));
+            float32x4_t lFx = vaddq_f32(vmulq_f32(lXY.val[0], lHalfW4), lHalfW4);
+            float32x4_t lFy = vsubq_f32(lHalfH4, vmulq_f32(lXY.val[1], lHalfH4));
+            lFx = vcvtq_f32_s32(vcvtq_s32_f32(vmaxq_f32(vminq_f32(lFx, lLastX4), lZero4)));
+            lFy = vcvtq_f32_s32(vcvtq_s32_f32(vmaxq_f32(vminq_f32(lFy, lLastY4), lZero4)));
+            const int32x4_t lIdx = vcvtq_s32_f32(vaddq_f32(vmulq_f32(lFy, lCellsX4), lFx));
+            vst1q_s32(pOut + i, vbslq_s32(lValid, lIdx, vdupq_n_s32(-1)));
+            lMinX4 = vminq_f32(lMinX4, vbslq_f32(lValid, lFx, lBig4));
+            lMinY4 = vminq_f32(lMinY4, vbslq_f32(lValid, lFy, lBig4));
+            lMaxX4 = vmaxq_f32(lMaxX4, vbslq_f32(lValid, lFx, lMinusBig4));
+            lMaxY4 = vmaxq_f32(lMaxY4, vbslq_f32(lValid, lFy, lMinusBig4));
+        }
+        vst1q_f32(lLow, vminq_f32(lMinX4, vextq_f32(lMinX4, lMinX4, 2)));
+        vst1q_f32(lHigh, vmaxq_f32(lMaxX4, vextq_f32(lMaxX4, lMaxX4, 2)));
+        float lMinX = lLow[0] < lLow[1] ? lLow[0] : lLow[1];
+        float lMaxX = lHigh[0] > lHigh[1] ? lHigh[0] : lHigh[1];
+        vst1q_f32(lLow, vminq_f32(lMinY4, vextq_f32(lMinY4, lMinY4, 2)));
+        vst1q_f32(lHigh, vmaxq_f32(lMaxY4, vextq_f32(lMaxY4, lMaxY4, 2)));
+        float lMinY = lLow[0] < lLow[1] ? lLow[0] : lLow[1];
+        float lMaxY = lHigh[0] > lHigh[1] ? lHigh[0] : lHigh[1];
+#elif defined(RLCHARTS_SIMD_WASM)
+        const v128_t lHalfW4 = wasm_f32x4_splat((float)aCellsX * 0.5f);
+        const v128_t lHalfH4 = wasm_f32x4_splat((float)aCellsY * 0.5f);
+        const v128_t lLastX4 = wasm_f32x4_splat((float)(aCellsX - 1));
+        const v128_t lLastY4 = wasm_f32x4_splat((float)(aCellsY - 1));
+        const v128_t lCellsX4 = wasm_f32x4_splat((float)aCellsX);
+        const v128_t lOne4 = wasm_f32x4_splat(1.0f);
+        const v128_t lMinusOne4 = wasm_f32x4_splat(-1.0f);
+        const v128_t lZero4 = wasm_f32x4_splat(0.0f);
+        const v128_t lBig4 = wasm_f32x4_splat(lBig);
+        const v128_t lMinusBig4 = wasm_f32x4_splat(-lBig);
+        v128_t lMinX4 = lBig4, lMinY4 = lBig4, lMaxX4 = lMinusBig4, lMaxY4 = lMinusBig4;
+        for (; i + 4 <= aCount; i += 4) {
+            const v128_t lA = wasm_v128_load(pXY + 2 * i);
+            const v128_t lB = wasm_v128_load(pXY + 2 * i + 4);
+            const v128_t lX = wasm_i32x4_shuffle(lA, lB, 0, 2, 4, 6);
+            const v128_t lY = wasm_i32x4_shuffle(lA, lB, 1, 3, 5, 7);
+            const v128_t lValid = wasm_v128_and(wasm_v128_and(wasm_f32x4_ge(lX, lMinusOne4), wasm_f32x4_le(lX, lOne4)),
+                                                wasm_v128_and(wasm_f32x4_ge(lY, lMinusOne4), wasm_f32x4_le(lY, lOne4)));
+            v128_t lFx = wasm_f32x4_add(wasm_f32x4_mul(lX, lHalfW4), lHalfW4);
+            v128_t lFy = wasm_f32x4_sub(lHalfH4, wasm_f32x4_mul(lY, lHalfH4));
+            lFx = wasm_f32x4_convert_i32x4(wasm_i32x4_trunc_sat_f32x4(wasm_f32x4_pmax(wasm_f32x4_pmin(lFx, lLastX4), lZero4)));
+            lFy = wasm_f32x4_convert_i32x4(wasm_i32x4_trunc_sat_f32x4(wasm_f32x4_pmax(wasm_f32x4_pmin(lFy, lLastY4), lZero4)));
+            const v128_t lIdx = wasm_i32x4_trunc_sat_f32x4(wasm_f32x4_add(wasm_f32x4_mul(lFy, lCellsX4), lFx));
+            wasm_v128_store(pOut + i, wasm_v128_bitselect(lIdx, wasm_i32x4_splat(-1), lValid));
+            lMinX4 = wasm_f32x4_pmin(lMinX4, wasm_v128_bitselect(lFx, lBig4, lValid));
+            lMinY4 = wasm_f32x4_pmin(lMinY4, wasm_v128_bitselect(lFy, lBig4, lValid));
+            lMaxX4 = wasm_f32x4_pmax(lMaxX4, wasm_v128_bitselect(lFx, lMinusBig4, lValid));
+            lMaxY4 = wasm_f32x4_pmax(lMaxY4, wasm_v128_bitselect(lFy, lMinusBig4, lValid));
+        }
+        wasm_v128_store(lLow, wasm_f32x4_pmin(lMinX4, wasm_i32x4_shuffle(lMinX4, lMinX4, 2, 3, 0, 1)));
+        wasm_v128_store(lHigh, wasm_f32x4_pmax(lMaxX4, wasm_i32x4_shuffle(lMaxX4, lMaxX4, 2, 3, 0, 1)));
+        float lMinX = lLow[0] < lLow[1] ? lLow[0] : lLow[1];
+        float lMaxX = lHigh[0] > lHigh[1] ? lHigh[0] : lHigh[1];
+        wasm_v128_store(lLow, wasm_f32x4_pmin(lMinY4, wasm_i32x4_shuffle(lMinY4, lMinY4, 2, 3, 0, 1)));
+        wasm_v128_store(lHigh, wasm_f32x4_pmax(lMaxY4, wasm_i32x4_shuffle(lMaxY4, lMaxY4, 2, 3, 0, 1)));
+        float lMinY = lLow[0] < lLow[1] ? lLow[0] : lLow[1];
+        float lMaxY = lHigh[0] > lHigh[1] ? lHigh[0] : lHigh[1];
+#endif
+#if defined(RLCHARTS_SIMD_SSE2) || defined(RLCHARTS_SIMD_NEON) || defined(RLCHARTS_SIMD_WASM)
+        // All lanes invalid leaves the sentinels, which the comparisons skip
+        if (lMinX <= lMaxX) {
+            rBounds[0] = (int32_t)lMinX < rBounds[0] ? (int32_t)lMinX : rBounds[0];
+            rBounds[1] = (int32_t)lMinY < rBounds[1] ? (int32_t)lMinY : rBounds[1];
+            rBounds[2] = (int32_t)lMaxX > rBounds[2] ? (int32_t)lMaxX : rBounds[2];
+            rBounds[3] = (int32_t)lMaxY > rBounds[3] ? (int32_t)lMaxY : rBounds[3];
+        }
+    }
+#endif
+    normalizedToCellsScalar(pXY + 2 * i, aCount - i, aCellsX, aCellsY, pOut + i, rBounds);
+}
+
+} // namespace RLCharts
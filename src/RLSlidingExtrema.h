@@ -0,0 +1,76 @@
+// RLSlidingExtrema.h
+#pragma once
+#include "RLRingQueue.h"
+#include <cstddef>
+#include <cstdint>
+
+// Minimum and maximum of a FIFO window (values pushed at the back, dropped from
+// the front) in O(1) amortized per operation, using the monotonic deque method:
+// each side keeps only the values that can still become the extremum, so queries
+// never rescan the window.
+//
+// push(aMin, aMax) tracks separate series for the two sides, e.g. candle lows and
+// highs; push(aValue) tracks one.
+//
+// The two deques are RingQueues, which only grow (to the next power of two above
+// the window size), so a chart streaming through a fixed window stops allocating
+// once its first window is full.
+
+namespace RLCharts {
+
+template<typename T>
+class SlidingExtrema {
+public:
+    void clear() {
+        mMin.clear();
+        mMax.clear();
+        mHead = 0;
+        mTail = 0;
+    }
+
+    void push(T aValue) { push(aValue, aValue); }
+    void push(T aMinValue, T aMaxValue) {
+        while (!mMin.empty() && !(mMin.back().mValue < aMinValue)) {
+            mMin.popBack();
+        }
+        mMin.pushBack(Entry{ mTail, aMinValue });
+        while (!mMax.empty() && !(aMaxValue < mMax.back().mValue)) {
+            mMax.popBack();
+        }
+        mMax.pushBack(Entry{ mTail, aMaxValue });
+        mTail++;
+    }
+
+    // Drop the oldest value
+    void popFront() {
+        if (mHead == mTail) {
+            return;
+        }
+        if (mMin.front().mSeq == mHead) {
+            mMin.popFront();
+        }
+        if (mMax.front().mSeq == mHead) {
+            mMax.popFront();
+        }
+        mHead++;
+    }
+
+    [[nodiscard]] bool empty() const { return mHead == mTail; }
+    [[nodiscard]] size_t size() const { return (size_t)(mTail - mHead); }
+    // Undefined when empty
+    [[nodiscard]] T getMin() const { return mMin.front().mValue; }
+    [[nodiscard]] T getMax() const { return mMax.front().mValue; }
+
+private:
+    struct Entry {
+        uint64_t mSeq;
+        T mValue;
+    };
+
+    RingQueue<Entry> mMin;
+    RingQueue<Entry> mMax;
+    uint64_t mHead = 0; // sequence number of the oldest value
+    uint64_t mTail = 0; // sequence number of the next push
+};
+
+} // namespace RLCharts
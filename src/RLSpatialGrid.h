@@ -0,0 +1,181 @@
+// RLSpatialGrid.h
+#pragma once
+#include "raylib.h"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Uniform grid over 2D points for neighbour queries, hit-testing and culling.
+// build() bins item ids with a counting sort into one flat array (cell start
+// offsets + ids, CSR layout), so a rebuild touches two vectors that keep their
+// capacity and never allocates once warmed up. Items outside the area are binned
+// into the nearest edge cell, so queries still find them.
+//
+// Positions are not stored: queries take the same accessor as build() and the
+// caller keeps owning the points (screen-space caches, bubble states, ...).
+
+namespace RLCharts {
+
+class SpatialGrid {
+public:
+    static constexpr uint32_t NONE = 0xFFFFFFFFu;
+
+    // Bin aCount items, rGetPos(i) -> Vector2, over aArea with square cells of aCellSize
+    template<typename GetPos>
+    void build(Rectangle aArea, float aCellSize, size_t aCount, GetPos&& rGetPos) {
+        mCellSize = aCellSize >= 1.0f ? aCellSize : 1.0f;
+        mInvCellSize = 1.0f / mCellSize;
+        mOriginX = aArea.x;
+        mOriginY = aArea.y;
+        mCols = (int)(aArea.width * mInvCellSize) + 1;
+        mRows = (int)(aArea.height * mInvCellSize) + 1;
+        mCols = mCols < 1 ? 1 : mCols;
+        mRows = mRows < 1 ? 1 : mRows;
+
+        mCellStart.assign((size_t)mCols * (size_t)mRows + 1, 0);
+        mItemCell.resize(aCount);
+        for (size_t i = 0; i < aCount; ++i) {
+            const uint32_t lCell = cellIndex(rGetPos(i));
+            mItemCell[i] = lCell;
+            mCellStart[lCell + 1]++;
+        }
+        for (size_t c = 1; c < mCellStart.size(); ++c) {
+            mCellStart[c] += mCellStart[c - 1];
+        }
+        // Scatter the ids into their cells
+        mItems.resize(aCount);
+        mCursor.assign(mCellStart.begin(), mCellStart.end() - 1);
+        for (size_t i = 0; i < aCount; ++i) {
+            mItems[mCursor[mItemCell[i]]++] = (uint32_t)i;
+        }
+    }
+
+    void clear() {
+        mItems.clear();
+        mCellStart.assign(1, 0);
+        mCols = 0;
+        mRows = 0;
+    }
+
+    [[nodiscard]] bool empty() const { return mItems.empty(); }
+    [[nodiscard]] size_t size() const { return mItems.size(); }
+    [[nodiscard]] int getCols() const { return mCols; }
+    [[nodiscard]] int getRows() const { return mRows; }
+    [[nodiscard]] float getCellSize() const { return mCellSize; }
+
+    // Cell coordinates of a position (clamped to the grid)
+    void cellOf(Vector2 aPos, int& rCx, int& rCy) const {
+        rCx = clampCell((aPos.x - mOriginX) * mInvCellSize, mCols);
+        rCy = clampCell((aPos.y - mOriginY) * mInvCellSize, mRows);
+    }
+
+    // Ids in one cell; nullptr / 0 outside the grid
+    [[nodiscard]] const uint32_t* cellItems(int aCx, int aCy, size_t& rCount) const {
+        if (aCx < 0 || aCx >= mCols || aCy < 0 || aCy >= mRows) {
+            rCount = 0;
+            return nullptr;
+        }
+        const size_t lCell = (size_t)aCy * (size_t)mCols + (size_t)aCx;
+        rCount = mCellStart[lCell + 1] - mCellStart[lCell];
+        return mItems.data() + mCellStart[lCell];
+    }
+
+    // rFn(id) for every item binned into a cell that overlaps aRect (a superset of
+    // the items inside it)
+    template<typename Fn>
+    void forEachInRect(Rectangle aRect, Fn&& rFn) const {
+        if (mItems.empty()) {
+            return;
+        }
+        int lX0 = 0;
+        int lY0 = 0;
+        int lX1 = 0;
+        int lY1 = 0;
+        cellOf({ aRect.x, aRect.y }, lX0, lY0);
+        cellOf({ aRect.x + aRect.width, aRect.y + aRect.height }, lX1, lY1);
+        for (int y = lY0; y <= lY1; ++y) {
+            for (int x = lX0; x <= lX1; ++x) {
+                size_t lCount = 0;
+                const uint32_t* pIds = cellItems(x, y, lCount);
+                for (size_t i = 0; i < lCount; ++i) {
+                    rFn(pIds[i]);
+                }
+            }
+        }
+    }
+
+    // Closest item to aPos within aMaxDistance (NONE if there is none), visiting
+    // cells in growing rings and stopping once no closer item can exist.
+    // rAccept(id) can reject items (e.g. hidden series); rDistance gets the distance.
+    template<typename GetPos, typename Accept>
+    [[nodiscard]] uint32_t nearest(Vector2 aPos, float aMaxDistance, GetPos&& rGetPos, Accept&& rAccept,
+                                   float& rDistance) const {
+        uint32_t lBest = NONE;
+        float lBestD2 = aMaxDistance * aMaxDistance;
+        if (mItems.empty()) {
+            return NONE;
+        }
+        int lCx = 0;
+        int lCy = 0;
+        cellOf(aPos, lCx, lCy);
+        const float lRings = std::ceil(aMaxDistance * mInvCellSize) + 1.0f;
+        const int lGridRings = mCols > mRows ? mCols : mRows;
+        const int lMaxRing = lRings < (float)lGridRings ? (int)lRings : lGridRings;
+        for (int lRing = 0; lRing <= lMaxRing; ++lRing) {
+            // Everything in this ring is at least (lRing - 1) cells away
+            const float lRingMin = (float)(lRing - 1) * mCellSize;
+            if (lRing > 1 && lRingMin * lRingMin > lBestD2) {
+                break;
+            }
+            for (int y = lCy - lRing; y <= lCy + lRing; ++y) {
+                const bool lEdgeRow = (y == lCy - lRing) || (y == lCy + lRing);
+                const int lStep = lEdgeRow || lRing == 0 ? 1 : 2 * lRing;
+                for (int x = lCx - lRing; x <= lCx + lRing; x += lStep) {
+                    size_t lCount = 0;
+                    const uint32_t* pIds = cellItems(x, y, lCount);
+                    for (size_t i = 0; i < lCount; ++i) {
+                        const Vector2 lP = rGetPos(pIds[i]);
+                        const float lDx = lP.x - aPos.x;
+                        const float lDy = lP.y - aPos.y;
+                        const float lD2 = lDx * lDx + lDy * lDy;
+                        if (lD2 <= lBestD2 && rAccept(pIds[i])) {
+                            lBestD2 = lD2;
+                            lBest = pIds[i];
+                        }
+                    }
+                }
+            }
+        }
+        rDistance = std::sqrt(lBestD2);
+        return lBest;
+    }
+
+private:
+    // Clamped in float so far-off (or NaN) positions never overflow the int cast
+    [[nodiscard]] static int clampCell(float aCell, int aCount) {
+        if (!(aCell >= 0.0f)) {
+            return 0;
+        }
+        return aCell >= (float)aCount ? aCount - 1 : (int)aCell;
+    }
+    [[nodiscard]] uint32_t cellIndex(Vector2 aPos) const {
+        int lCx = 0;
+        int lCy = 0;
+        cellOf(aPos, lCx, lCy);
+        return (uint32_t)(lCy * mCols + lCx);
+    }
+
+    float mCellSize = 1.0f;
+    float mInvCellSize = 1.0f;
+    float mOriginX = 0.0f;
+    float mOriginY = 0.0f;
+    int mCols = 0;
+    int mRows = 0;
+    std::vector<uint32_t> mCellStart{ 0 }; // mCols * mRows + 1 offsets into mItems
+    std::vector<uint32_t> mItems;          // ids grouped by cell
+    std::vector<uint32_t> mItemCell;       // build scratch: cell per id
+    std::vector<uint32_t> mCursor;         // build scratch: write position per cell
+};
+
+} // namespace RLCharts
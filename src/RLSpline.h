@@ -0,0 +1,146 @@
+// RLSpline.h
+#pragma once
+#include "raylib.h"
+#include "RLCommon.h"
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Adaptive Catmull-Rom tessellation shared by the spline line modes.
+// A segment P1 -> P2 gets as many uniform steps as its curvature needs to stay
+// within a pixel tolerance of the true curve (the chord error of a cubic is
+// bounded by |second derivative| / (8 n^2)), capped by its on-screen length. A
+// straight stretch therefore costs one step (two points) instead of one per few
+// pixels.
+//
+// SplineCache keeps the last tessellation of a polyline and copies segments
+// whose four control points did not change, so only moved points are re-evaluated.
+
+namespace RLCharts {
+
+// Steps for the segment aP1 -> aP2: enough for aTolerancePx, but no closer than
+// aMinPixels apart along the chord
+inline size_t splineSegmentSteps(const Vector2& aP0, const Vector2& aP1, const Vector2& aP2, const Vector2& aP3,
+                                 float aMinPixels, float aTolerancePx) {
+    // Bezier control points of the segment: P1, P1 + (P2 - P0) / 6, P2 - (P3 - P1) / 6, P2
+    const Vector2 lB1{ aP1.x + (aP2.x - aP0.x) / 6.0f, aP1.y + (aP2.y - aP0.y) / 6.0f };
+    const Vector2 lB2{ aP2.x - (aP3.x - aP1.x) / 6.0f, aP2.y - (aP3.y - aP1.y) / 6.0f };
+    const float lTolerance = maxVal(aTolerancePx, 0.01f);
+    // The curve stays inside the hull of its control points: if both inner ones
+    // are within tolerance of the chord, one step is exact enough
+    const float lCx = aP2.x - aP1.x;
+    const float lCy = aP2.y - aP1.y;
+    const float lChord = sqrtf(lCx * lCx + lCy * lCy);
+    if (lChord > 0.0f) {
+        const float lD1 = fabsf((lB1.x - aP1.x) * lCy - (lB1.y - aP1.y) * lCx) / lChord;
+        const float lD2 = fabsf((lB2.x - aP1.x) * lCy - (lB2.y - aP1.y) * lCx) / lChord;
+        if (lD1 <= lTolerance && lD2 <= lTolerance) {
+            return 1;
+        }
+    }
+    const float lAx = aP1.x - 2.0f * lB1.x + lB2.x;
+    const float lAy = aP1.y - 2.0f * lB1.y + lB2.y;
+    const float lBx = lB1.x - 2.0f * lB2.x + aP2.x;
+    const float lBy = lB1.y - 2.0f * lB2.y + aP2.y;
+    const float lBend = sqrtf(maxVal(lAx * lAx + lAy * lAy, lBx * lBx + lBy * lBy));
+    // |B''| <= 6 * lBend, chord error <= |B''| / (8 n^2)
+    const float lCurveSteps = ceilf(sqrtf(0.75f * lBend / lTolerance));
+    const float lLengthSteps = floorf(distance(aP1, aP2) / maxVal(aMinPixels, 0.5f)) + 1.0f;
+    const float lSteps = minVal(lCurveSteps, lLengthSteps);
+    return lSteps < 1.0f ? 1 : (size_t)lSteps;
+}
+
+// aSteps points of the segment aP1 -> aP2 at t = 0, 1/aSteps, ... (aP2 excluded)
+inline void tessellateSplineSegment(const Vector2& aP0, const Vector2& aP1, const Vector2& aP2, const Vector2& aP3,
+                                    size_t aSteps, Vector2* pOut) {
+    const float lInv = 1.0f / (float)aSteps;
+    for (size_t s = 0; s < aSteps; ++s) {
+        pOut[s] = catmullRom(aP0, aP1, aP2, aP3, (float)s * lInv);
+    }
+}
+
+class SplineCache {
+public:
+    // Tessellate the polyline pPts[0..aCount) (ends use duplicated control points)
+    void build(const Vector2* pPts, size_t aCount, float aMinPixels, float aTolerancePx) {
+        const bool lSameParams = aMinPixels == mMinPixels && aTolerancePx == mTolerancePx;
+        mMinPixels = aMinPixels;
+        mTolerancePx = aTolerancePx;
+        mReused = 0;
+        mNextPoints.clear();
+        mNextStarts.clear();
+        if (aCount >= 2) {
+            const size_t lOldCount = mControls.size();
+            for (size_t lSeg = 0; lSeg + 1 < aCount; ++lSeg) {
+                mNextStarts.push_back(mNextPoints.size());
+                if (lSameParams && lSeg + 1 < lOldCount && sameControls(pPts, aCount, lSeg)) {
+                    mNextPoints.insert(mNextPoints.end(), mPoints.begin() + (std::ptrdiff_t)mStarts[lSeg],
+                                       mPoints.begin() + (std::ptrdiff_t)mStarts[lSeg + 1]);
+                    mReused++;
+                    continue;
+                }
+                const Vector2& rP0 = pPts[lSeg > 0 ? lSeg - 1 : 0];
+                const Vector2& rP1 = pPts[lSeg];
+                const Vector2& rP2 = pPts[lSeg + 1];
+                const Vector2& rP3 = pPts[lSeg + 2 < aCount ? lSeg + 2 : aCount - 1];
+                const size_t lSteps = splineSegmentSteps(rP0, rP1, rP2, rP3, aMinPixels, aTolerancePx);
+                const size_t lStart = mNextPoints.size();
+                mNextPoints.resize(lStart + lSteps);
+                tessellateSplineSegment(rP0, rP1, rP2, rP3, lSteps, &mNextPoints[lStart]);
+            }
+            // Closing point; its index doubles as the end of the last segment
+            mNextStarts.push_back(mNextPoints.size());
+            mNextPoints.push_back(pPts[aCount - 1]);
+        }
+        std::swap(mPoints, mNextPoints);
+        std::swap(mStarts, mNextStarts);
+        mControls.assign(pPts, pPts + (aCount >= 2 ? aCount : 0));
+    }
+
+    void clear() {
+        mPoints.clear();
+        mStarts.clear();
+        mControls.clear();
+        mReused = 0;
+    }
+
+    [[nodiscard]] const std::vector<Vector2>& getPoints() const { return mPoints; }
+    [[nodiscard]] size_t getSegmentCount() const { return mStarts.empty() ? 0 : mStarts.size() - 1; }
+    // Points of segment aSegment are [getSegmentStart(aSegment), getSegmentStart(aSegment + 1))
+    [[nodiscard]] size_t getSegmentStart(size_t aSegment) const { return mStarts[aSegment]; }
+    // Segments copied from the previous build() instead of evaluated
+    [[nodiscard]] size_t getReusedSegments() const { return mReused; }
+
+private:
+    // Whether aSegment had the same four control points in the previous build
+    [[nodiscard]] bool sameControls(const Vector2* pPts, size_t aCount, size_t aSegment) const {
+        const size_t lOldCount = mControls.size();
+        for (int k = -1; k <= 2; ++k) {
+            const size_t lNew = clampControl(aSegment, k, aCount);
+            const size_t lOld = clampControl(aSegment, k, lOldCount);
+            if (pPts[lNew].x != mControls[lOld].x || pPts[lNew].y != mControls[lOld].y) {
+                return false;
+            }
+        }
+        return true;
+    }
+    [[nodiscard]] static size_t clampControl(size_t aSegment, int aOffset, size_t aCount) {
+        if (aOffset < 0) {
+            return aSegment > 0 ? aSegment - 1 : 0;
+        }
+        const size_t lIndex = aSegment + (size_t)aOffset;
+        return lIndex < aCount ? lIndex : aCount - 1;
+    }
+
+    std::vector<Vector2> mPoints;   // segments back to back, then the last control point
+    std::vector<size_t> mStarts;    // first point of each segment, plus the closing point
+    std::vector<Vector2> mControls; // input of the last build()
+    std::vector<Vector2> mNextPoints;
+    std::vector<size_t> mNextStarts;
+    float mMinPixels = -1.0f;
+    float mTolerancePx = -1.0f;
+    size_t mReused = 0;
+};
+
+} // namespace RLCharts
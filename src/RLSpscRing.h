@@ -0,0 +1,111 @@
+// RLSpscRing.h
+#pragma once
+#include <atomic>
+#include <vector>
+#include <cstddef>
+
+// Lock-free single-producer/single-consumer ring buffer.
+// One thread calls push(), one other thread calls consume()/pop(). Capacity is
+// rounded up to a power of two; head and tail live on separate cache lines so
+// producer and consumer don't false-share.
+
+namespace RLCharts {
+
+template<typename T>
+class SpscRing {
+public:
+    explicit SpscRing(size_t aCapacity = 4096) {
+        size_t lCapacity = 2;
+        while (lCapacity < aCapacity) {
+            lCapacity <<= 1;
+        }
+        mBuffer.resize(lCapacity);
+        mMask = lCapacity - 1;
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    [[nodiscard]] size_t capacity() const { return mBuffer.size(); }
+
+    // Approximate fill level (exact when called from either endpoint thread)
+    [[nodiscard]] size_t size() const {
+        return mTail.load(std::memory_order_acquire) - mHead.load(std::memory_order_acquire);
+    }
+    [[nodiscard]] bool empty() const { return size() == 0; }
+
+    // Producer side. Returns false when the ring is full.
+    bool push(const T& rValue) {
+        const size_t lTail = mTail.load(std::memory_order_relaxed);
+        if (lTail - mHeadCache == mBuffer.size()) {
+            mHeadCache = mHead.load(std::memory_order_acquire);
+            if (lTail - mHeadCache == mBuffer.size()) {
+                return false;
+            }
+        }
+        mBuffer[lTail & mMask] = rValue;
+        mTail.store(lTail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Producer side. Pushes as many values as fit and returns how many were written.
+    size_t push(const T* pValues, size_t aCount) {
+        const size_t lTail = mTail.load(std::memory_order_relaxed);
+        size_t lFree = mBuffer.size() - (lTail - mHeadCache);
+        if (lFree < aCount) {
+            mHeadCache = mHead.load(std::memory_order_acquire);
+            lFree = mBuffer.size() - (lTail - mHeadCache);
+        }
+        const size_t lCount = aCount < lFree ? aCount : lFree;
+        for (size_t i = 0; i < lCount; ++i) {
+            mBuffer[(lTail + i) & mMask] = pValues[i];
+        }
+        mTail.store(lTail + lCount, std::memory_order_release);
+        return lCount;
+    }
+
+    // Consumer side. Hands everything currently queued to rFn(const T* pData, size_t aCount)
+    // as at most two contiguous runs (no intermediate copy). Returns the number consumed.
+    template<typename Fn>
+    size_t consume(Fn&& rFn) {
+        const size_t lHead = mHead.load(std::memory_order_relaxed);
+        const size_t lTail = mTail.load(std::memory_order_acquire);
+        const size_t lCount = lTail - lHead;
+        if (lCount == 0) {
+            return 0;
+        }
+        const size_t lStart = lHead & mMask;
+        const size_t lFirst = (mBuffer.size() - lStart) < lCount ? (mBuffer.size() - lStart) : lCount;
+        rFn(mBuffer.data() + lStart, lFirst);
+        if (lCount > lFirst) {
+            rFn(mBuffer.data(), lCount - lFirst);
+        }
+        mHead.store(lTail, std::memory_order_release);
+        return lCount;
+    }
+
+    // Consumer side. Pops up to aMaxCount values into pOut.
+    size_t pop(T* pOut, size_t aMaxCount) {
+        const size_t lHead = mHead.load(std::memory_order_relaxed);
+        const size_t lTail = mTail.load(std::memory_order_acquire);
+        const size_t lAvail = lTail - lHead;
+        const size_t lCount = lAvail < aMaxCount ? lAvail : aMaxCount;
+        for (size_t i = 0; i < lCount; ++i) {
+            pOut[i] = mBuffer[(lHead + i) & mMask];
+        }
+        mHead.store(lHead + lCount, std::memory_order_release);
+        return lCount;
+    }
+
+private:
+    static constexpr size_t CACHE_LINE = 64;
+
+    std::vector<T> mBuffer;
+    size_t mMask{ 0 };
+
+    alignas(CACHE_LINE) std::atomic<size_t> mHead{ 0 }; // Consumer position
+    alignas(CACHE_LINE) std::atomic<size_t> mTail{ 0 }; // Producer position
+    size_t mHeadCache{ 0 };                             // Producer's last seen head
+};
+
+} // namespace RLCharts
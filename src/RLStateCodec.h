@@ -0,0 +1,196 @@
+// RLStateCodec.h
+#pragma once
+#include <zlib.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <vector>
+
+// Compact binary format for the charts' saveState()/loadState() snapshots.
+//
+// A snapshot is a 20-byte header (magic "RLCS", format version, chart tag and the
+// raw payload size, all little-endian) followed by the zlib-compressed payload.
+// StateWriter builds the payload from scalars and float arrays; StateReader checks
+// the header, inflates the payload and reads it back with every read bounds
+// checked, so a truncated or foreign blob fails cleanly instead of crashing.
+//
+// Float arrays (ring buffers, grids) are stored so that zlib can find structure in
+// them: each value's bit pattern is XORed with its predecessor's, which zeroes the
+// sign, exponent and leading mantissa bits of slowly varying data, and the four
+// bytes of every value are then split into four byte planes, so those zeroed high
+// bytes form long runs. Level 1 compression keeps saving a large dashboard in the
+// low milliseconds.
+
+namespace RLCharts {
+
+inline constexpr uint32_t STATE_VERSION = 1;
+
+// Four-character chart tag, e.g. stateTag("TSER")
+constexpr uint32_t stateTag(const char (&rName)[5]) {
+    return (uint32_t)(uint8_t)rName[0] | (uint32_t)(uint8_t)rName[1] << 8 |
+           (uint32_t)(uint8_t)rName[2] << 16 | (uint32_t)(uint8_t)rName[3] << 24;
+}
+
+class StateWriter {
+public:
+    void writeU32(uint32_t aValue) {
+        for (int i = 0; i < 4; ++i) {
+            mPayload.push_back((uint8_t)(aValue >> (8 * i)));
+        }
+    }
+    void writeU64(uint64_t aValue) {
+        writeU32((uint32_t)aValue);
+        writeU32((uint32_t)(aValue >> 32));
+    }
+    void writeF32(float aValue) {
+        uint32_t lBits = 0;
+        std::memcpy(&lBits, &aValue, sizeof(lBits));
+        writeU32(lBits);
+    }
+
+    // aCount floats, XOR-delta coded and byte-plane shuffled
+    void writeFloats(const float* pValues, size_t aCount) {
+        const size_t lStart = mPayload.size();
+        mPayload.resize(lStart + aCount * 4);
+        uint8_t* pOut = mPayload.data() + lStart;
+        uint32_t lPrev = 0;
+        for (size_t i = 0; i < aCount; ++i) {
+            uint32_t lBits = 0;
+            std::memcpy(&lBits, pValues + i, sizeof(lBits));
+            const uint32_t lDelta = lBits ^ lPrev;
+            lPrev = lBits;
+            for (size_t b = 0; b < 4; ++b) {
+                pOut[b * aCount + i] = (uint8_t)(lDelta >> (8 * b));
+            }
+        }
+    }
+    void writeFloats(std::span<const float> aValues) { writeFloats(aValues.data(), aValues.size()); }
+
+    // Header plus compressed payload; empty if compression failed
+    [[nodiscard]] std::vector<uint8_t> finish(uint32_t aTag) const {
+        uLongf lPackedSize = compressBound((uLong)mPayload.size());
+        std::vector<uint8_t> lOut(HEADER_SIZE + lPackedSize);
+        if (compress2(lOut.data() + HEADER_SIZE, &lPackedSize, mPayload.data(), (uLong)mPayload.size(), 1) != Z_OK) {
+            return {};
+        }
+        lOut.resize(HEADER_SIZE + lPackedSize);
+        putU32(lOut.data(), MAGIC);
+        putU32(lOut.data() + 4, STATE_VERSION);
+        putU32(lOut.data() + 8, aTag);
+        putU32(lOut.data() + 12, (uint32_t)mPayload.size());
+        putU32(lOut.data() + 16, (uint32_t)((uint64_t)mPayload.size() >> 32));
+        return lOut;
+    }
+
+    [[nodiscard]] size_t getPayloadSize() const { return mPayload.size(); }
+
+    static constexpr size_t HEADER_SIZE = 20;
+    static constexpr uint32_t MAGIC = stateTag("RLCS");
+
+private:
+    static void putU32(uint8_t* pOut, uint32_t aValue) {
+        for (int i = 0; i < 4; ++i) {
+            pOut[i] = (uint8_t)(aValue >> (8 * i));
+        }
+    }
+
+    std::vector<uint8_t> mPayload;
+};
+
+class StateReader {
+public:
+    // Check the header against aTag and inflate the payload; false if the blob is
+    // not a snapshot of this chart type or is corrupt
+    bool open(std::span<const uint8_t> aBlob, uint32_t aTag) {
+        mPayload.clear();
+        mPos = 0;
+        if (aBlob.size() < StateWriter::HEADER_SIZE) {
+            return false;
+        }
+        const uint8_t* pHeader = aBlob.data();
+        if (getU32(pHeader) != StateWriter::MAGIC || getU32(pHeader + 4) != STATE_VERSION ||
+            getU32(pHeader + 8) != aTag) {
+            return false;
+        }
+        const uint64_t lRawSize = (uint64_t)getU32(pHeader + 12) | (uint64_t)getU32(pHeader + 16) << 32;
+        const size_t lPackedSize = aBlob.size() - StateWriter::HEADER_SIZE;
+        // Deflate cannot expand data by more than ~1032:1; a larger claim is corrupt
+        if (lRawSize > (uint64_t)lPackedSize * 1032 + 64) {
+            return false;
+        }
+        mPayload.resize((size_t)lRawSize);
+        uLongf lInflated = (uLongf)lRawSize;
+        if (uncompress(mPayload.data(), &lInflated, pHeader + StateWriter::HEADER_SIZE, (uLong)lPackedSize) != Z_OK ||
+            lInflated != lRawSize) {
+            mPayload.clear();
+            return false;
+        }
+        return true;
+    }
+
+    bool readU32(uint32_t& rValue) {
+        if (remaining() < 4) {
+            return false;
+        }
+        rValue = getU32(mPayload.data() + mPos);
+        mPos += 4;
+        return true;
+    }
+    bool readU64(uint64_t& rValue) {
+        uint32_t lLow = 0;
+        uint32_t lHigh = 0;
+        if (!readU32(lLow) || !readU32(lHigh)) {
+            return false;
+        }
+        rValue = (uint64_t)lLow | (uint64_t)lHigh << 32;
+        return true;
+    }
+    bool readF32(float& rValue) {
+        uint32_t lBits = 0;
+        if (!readU32(lBits)) {
+            return false;
+        }
+        std::memcpy(&rValue, &lBits, sizeof(rValue));
+        return true;
+    }
+
+    bool readFloats(float* pValues, size_t aCount) {
+        if (aCount > remaining() / 4) {
+            return false;
+        }
+        const uint8_t* pIn = mPayload.data() + mPos;
+        uint32_t lPrev = 0;
+        for (size_t i = 0; i < aCount; ++i) {
+            uint32_t lDelta = 0;
+            for (size_t b = 0; b < 4; ++b) {
+                lDelta |= (uint32_t)pIn[b * aCount + i] << (8 * b);
+            }
+            lPrev ^= lDelta;
+            std::memcpy(pValues + i, &lPrev, sizeof(lPrev));
+        }
+        mPos += aCount * 4;
+        return true;
+    }
+    bool readFloats(std::vector<float>& rValues, size_t aCount) {
+        if (aCount > remaining() / 4) {
+            return false;
+        }
+        rValues.resize(aCount);
+        return readFloats(rValues.data(), aCount);
+    }
+
+    [[nodiscard]] size_t remaining() const { return mPayload.size() - mPos; }
+    // Every byte of the payload was read
+    [[nodiscard]] bool atEnd() const { return mPos == mPayload.size(); }
+
+private:
+    static uint32_t getU32(const uint8_t* pIn) {
+        return (uint32_t)pIn[0] | (uint32_t)pIn[1] << 8 | (uint32_t)pIn[2] << 16 | (uint32_t)pIn[3] << 24;
+    }
+
+    std::vector<uint8_t> mPayload;
+    size_t mPos{ 0 };
+};
+
+} // namespace RLCharts
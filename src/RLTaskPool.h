@@ -0,0 +1,230 @@
+// RLTaskPool.h
+#pragma once
+#include "RLFrameArena.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Persistent work-stealing thread pool for per-frame fan-out (RLDashboard runs
+// one task per chart on it). parallelFor(n, fn) deals the task indices round-robin
+// onto one queue per thread, so index 0, 1, 2 ... start first; order the tasks
+// most expensive first. Each thread pops from the front of its own queue and,
+// once that is empty, steals from the back of the others, so a few slow tasks do
+// not leave the rest of the pool idle. The calling thread works too and returns
+// when every task has finished; an exception thrown by a task is rethrown there.
+//
+// Queues are index ranges, so dispatching a job never allocates. Workers sleep
+// between jobs and begin each job with a fresh frame arena (beginFrame()).
+// A parallelFor issued from inside a task runs serially on that thread.
+// Emscripten builds without -pthread get a single-threaded pool.
+//
+// Charts that split their own work (heat map binning and colorizing, scatter
+// density, bubble collisions) run it on TaskPool::shared() unless they are given
+// a pool with setTaskPool(). The shared pool is created on first use with one
+// thread per core; parallelFor calls from several threads take turns on it.
+
+namespace RLCharts {
+
+class TaskPool {
+public:
+    // aThreads counts the calling thread; 0 = std::thread::hardware_concurrency()
+    explicit TaskPool(size_t aThreads = 0) {
+        size_t lThreads = aThreads == 0 ? (size_t)std::thread::hardware_concurrency() : aThreads;
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+        lThreads = 1; // web build without -pthread: no workers, tasks run inline
+#endif
+        mThreadCount = lThreads == 0 ? 1 : lThreads;
+        mQueues = std::make_unique<Queue[]>(mThreadCount);
+        mWorkers.reserve(mThreadCount - 1);
+        for (size_t lSlot = 1; lSlot < mThreadCount; ++lSlot) {
+            mWorkers.emplace_back([this, lSlot]() { workerLoop(lSlot); });
+        }
+    }
+
+    ~TaskPool() {
+        {
+            std::lock_guard<std::mutex> lLock(mWakeMutex);
+            mStop = true;
+        }
+        mWakeCv.notify_all();
+        for (std::thread& rWorker : mWorkers) {
+            rWorker.join();
+        }
+    }
+
+    TaskPool(const TaskPool&) = delete;
+    TaskPool& operator=(const TaskPool&) = delete;
+
+    // Process-wide pool, created on first use
+    static TaskPool& shared() {
+        static TaskPool sPool;
+        return sPool;
+    }
+
+    [[nodiscard]] size_t getThreadCount() const { return mThreadCount; }
+    // Tasks that ran on a thread other than the one they were dealt to
+    [[nodiscard]] size_t getStealCount() const { return mSteals.load(std::memory_order_relaxed); }
+
+    // Run rFn(i) for every i in [0, aCount) and wait for all of them
+    template<typename Fn>
+    void parallelFor(size_t aCount, Fn&& rFn) {
+        if (aCount == 0) {
+            return;
+        }
+        if (mThreadCount == 1 || aCount == 1 || insideTask()) {
+            for (size_t i = 0; i < aCount; ++i) {
+                rFn(i);
+            }
+            return;
+        }
+        auto* pFn = &rFn;
+        run(aCount, (void*)pFn, [](void* pCtx, size_t aIndex) {
+            (*static_cast<decltype(pFn)>(pCtx))(aIndex);
+        });
+    }
+
+private:
+    using TaskFn = void (*)(void*, size_t);
+
+    // Remaining local positions [mBegin, mEnd); position k of slot s is task s + k * thread count
+    struct alignas(64) Queue {
+        std::mutex mMutex;
+        size_t mBegin{ 0 };
+        size_t mEnd{ 0 };
+    };
+
+    static bool& insideTask() {
+        thread_local bool tInside = false;
+        return tInside;
+    }
+
+    void run(size_t aCount, void* pCtx, TaskFn pFn) {
+        std::lock_guard<std::mutex> lJobLock(mJobMutex);
+        mpJobCtx = pCtx;
+        mpJobFn = pFn;
+        mError = nullptr;
+        mRemaining.store(aCount, std::memory_order_relaxed);
+        for (size_t lSlot = 0; lSlot < mThreadCount; ++lSlot) {
+            Queue& rQueue = mQueues[lSlot];
+            std::lock_guard<std::mutex> lLock(rQueue.mMutex);
+            rQueue.mBegin = 0;
+            rQueue.mEnd = aCount > lSlot ? (aCount - lSlot + mThreadCount - 1) / mThreadCount : 0;
+        }
+        {
+            std::lock_guard<std::mutex> lLock(mWakeMutex);
+            mGeneration++;
+        }
+        mWakeCv.notify_all();
+
+        drain(0);
+        {
+            std::unique_lock<std::mutex> lLock(mDoneMutex);
+            mDoneCv.wait(lLock, [this]() { return mRemaining.load(std::memory_order_acquire) == 0; });
+        }
+        if (mError) {
+            std::exception_ptr lError = mError;
+            mError = nullptr;
+            std::rethrow_exception(lError);
+        }
+    }
+
+    void workerLoop(size_t aSlot) {
+        uint64_t lSeen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lLock(mWakeMutex);
+                mWakeCv.wait(lLock, [this, lSeen]() { return mStop || mGeneration != lSeen; });
+                if (mStop) {
+                    return;
+                }
+                lSeen = mGeneration;
+            }
+            beginFrame();
+            drain(aSlot);
+        }
+    }
+
+    // Own queue first, then steal until every queue is empty
+    void drain(size_t aSlot) {
+        size_t lIndex = 0;
+        for (;;) {
+            if (popFront(aSlot, lIndex)) {
+                runTask(lIndex);
+                continue;
+            }
+            bool lStole = false;
+            for (size_t lStep = 1; lStep < mThreadCount && !lStole; ++lStep) {
+                lStole = stealBack((aSlot + lStep) % mThreadCount, lIndex);
+            }
+            if (!lStole) {
+                return;
+            }
+            mSteals.fetch_add(1, std::memory_order_relaxed);
+            runTask(lIndex);
+        }
+    }
+
+    bool popFront(size_t aSlot, size_t& rIndex) {
+        Queue& rQueue = mQueues[aSlot];
+        std::lock_guard<std::mutex> lLock(rQueue.mMutex);
+        if (rQueue.mBegin == rQueue.mEnd) {
+            return false;
+        }
+        rIndex = aSlot + rQueue.mBegin++ * mThreadCount;
+        return true;
+    }
+
+    bool stealBack(size_t aVictim, size_t& rIndex) {
+        Queue& rQueue = mQueues[aVictim];
+        std::lock_guard<std::mutex> lLock(rQueue.mMutex);
+        if (rQueue.mBegin == rQueue.mEnd) {
+            return false;
+        }
+        rIndex = aVictim + --rQueue.mEnd * mThreadCount;
+        return true;
+    }
+
+    void runTask(size_t aIndex) {
+        insideTask() = true;
+        try {
+            mpJobFn(mpJobCtx, aIndex);
+        } catch (...) {
+            std::lock_guard<std::mutex> lLock(mDoneMutex);
+            if (!mError) {
+                mError = std::current_exception();
+            }
+        }
+        insideTask() = false;
+        if (mRemaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::lock_guard<std::mutex> lLock(mDoneMutex);
+            mDoneCv.notify_all();
+        }
+    }
+
+    size_t mThreadCount{ 1 };
+    std::unique_ptr<Queue[]> mQueues;
+    std::vector<std::thread> mWorkers;
+
+    std::mutex mJobMutex; // one parallelFor at a time
+    void* mpJobCtx{ nullptr };
+    TaskFn mpJobFn{ nullptr };
+    std::exception_ptr mError;
+
+    std::mutex mWakeMutex;
+    std::condition_variable mWakeCv;
+    uint64_t mGeneration{ 0 };
+    bool mStop{ false };
+
+    std::mutex mDoneMutex;
+    std::condition_variable mDoneCv;
+    std::atomic<size_t> mRemaining{ 0 };
+    std::atomic<size_t> mSteals{ 0 };
+};
+
+} // namespace RLCharts
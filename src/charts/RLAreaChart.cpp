@@ -9,20 +9,40 @@ RLAreaChart::RLAreaChart(Rectangle aBounds, RLAreaChartMode aMode,
     : mBounds(aBounds), mMode(aMode), mStyle(rStyle) {}
 
 void RLAreaChart::setBounds(Rectangle aBounds) {
+    mRedrawPending = true;
     mBounds = aBounds;
+    mStaticLayer.invalidate();
 }
 
 void RLAreaChart::setMode(RLAreaChartMode aMode) {
+    mRedrawPending = true;
     mMode = aMode;
+    mStaticLayer.invalidate();
+    if (mStreamCapacity > 0) {
+        // The window peak is a column total or a column maximum depending on the mode
+        mWindowPeak.clear();
+        for (size_t i = 0; i < mStreamCount; ++i) {
+            mWindowPeak.push(columnPeak(pointSlot(i)));
+        }
+    }
     calculateMaxValue();
 }
 
 void RLAreaChart::setStyle(const RLAreaChartStyle& rStyle) {
+    mRedrawPending = true;
     mStyle = rStyle;
+    mStaticLayer.invalidate();
 }
 
 void RLAreaChart::setXLabels(const std::vector<std::string>& rLabels) {
+    mRedrawPending = true;
     mXLabels = rLabels;
+    mStaticLayer.invalidate();
+}
+
+void RLAreaChart::setStaticLayerCache(bool aEnabled) {
+    mRedrawPending = true;
+    mStaticLayer.setEnabled(aEnabled);
 }
 
 void RLAreaChart::calculateMaxValue() {
@@ -36,6 +56,12 @@ void RLAreaChart::calculateMaxValue() {
         return;
     }
 
+    if (mStreamCapacity > 0) {
+        const float lPeak = mWindowPeak.empty() ? 1.0f : std::max(mWindowPeak.getMax(), 1.0f);
+        mMaxValueTarget = lPeak * 1.1f;
+        return;
+    }
+
     size_t lNumPoints = mSeriesData[0].mValues.size();
     float lMax = 1.0f;
 
@@ -61,8 +87,11 @@ void RLAreaChart::calculateMaxValue() {
 }
 
 void RLAreaChart::setData(const std::vector<RLAreaSeries>& rSeries) {
+    mRedrawPending = true;
     mSeriesData = rSeries;
 
+    mStackDirty = true;
+
     bool lIsFirstData = mSeries.empty();
     mSeries.resize(rSeries.size());
 
@@ -80,6 +109,10 @@ void RLAreaChart::setData(const std::vector<RLAreaSeries>& rSeries) {
         // Otherwise keep current values and animate to new targets
     }
 
+    if (mStreamCapacity > 0) {
+        restartStream();
+    }
+
     calculateMaxValue();
 
     // If first data, also animate the max value from a lower starting point
@@ -89,6 +122,7 @@ void RLAreaChart::setData(const std::vector<RLAreaSeries>& rSeries) {
 }
 
 void RLAreaChart::setTargetData(const std::vector<RLAreaSeries>& rSeries) {
+    mRedrawPending = true;
     mSeriesData = rSeries;
 
     // Ensure we have the right number of series
@@ -110,14 +144,154 @@ void RLAreaChart::setTargetData(const std::vector<RLAreaSeries>& rSeries) {
         rS.mAlpha = rSeries[i].mAlpha;
     }
 
+    mStackDirty = true;
+    if (mStreamCapacity > 0) {
+        restartStream();
+    }
+
+    calculateMaxValue();
+}
+
+void RLAreaChart::setStreamingWindow(size_t aPoints) {
+    mRedrawPending = true;
+    if (mStreamCapacity > 0) {
+        linearizeStream();
+    }
+    mStreamCapacity = aPoints;
+    if (mStreamCapacity > 0) {
+        restartStream();
+    } else {
+        // Keep what is on screen instead of animating back to the last setData()
+        for (auto& rS : mSeries) {
+            rS.mTargets = rS.mValues;
+        }
+    }
+    mStackDirty = true;
+    calculateMaxValue();
+}
+
+void RLAreaChart::pushSample(std::span<const float> aValues) {
+    if (mStreamCapacity == 0 || mSeries.empty()) {
+        return;
+    }
+    mRedrawPending = true;
+
+    size_t lSlot = 0;
+    if (mStreamCount < mStreamCapacity) {
+        lSlot = mStreamCount++;
+    } else {
+        // Overwrite the oldest point
+        lSlot = mStreamHead;
+        mStreamHead = mStreamHead + 1 < mStreamCapacity ? mStreamHead + 1 : 0;
+        mWindowPeak.popFront();
+    }
+    for (size_t s = 0; s < mSeries.size(); ++s) {
+        mSeries[s].mValues[lSlot] = s < aValues.size() ? aValues[s] : 0.0f;
+    }
+    if (!mStackDirty) {
+        updateStackColumn(lSlot);
+    }
+    mWindowPeak.push(columnPeak(lSlot));
     calculateMaxValue();
 }
 
+size_t RLAreaChart::getPointCount() const {
+    if (mStreamCapacity > 0) {
+        return mStreamCount;
+    }
+    return mSeries.empty() ? 0 : mSeries[0].mValues.size();
+}
+
+float RLAreaChart::getValue(size_t aSeriesIndex, size_t aPointIndex) const {
+    if (aSeriesIndex >= mSeries.size() || aPointIndex >= seriesPointCount(aSeriesIndex)) {
+        return 0.0f;
+    }
+    return mSeries[aSeriesIndex].mValues[pointSlot(aPointIndex)];
+}
+
+size_t RLAreaChart::seriesPointCount(size_t aSeriesIndex) const {
+    return mStreamCapacity > 0 ? mStreamCount : mSeries[aSeriesIndex].mValues.size();
+}
+
+size_t RLAreaChart::pointSlot(size_t aPointIndex) const {
+    if (mStreamCapacity == 0) {
+        return aPointIndex;
+    }
+    const size_t lSlot = mStreamHead + aPointIndex;
+    return lSlot < mStreamCapacity ? lSlot : lSlot - mStreamCapacity;
+}
+
+float RLAreaChart::columnPeak(size_t aSlot) const {
+    float lPeak = 0.0f;
+    for (const auto& rS : mSeries) {
+        if (mMode == RLAreaChartMode::OVERLAPPED) {
+            lPeak = std::max(lPeak, rS.mValues[aSlot]);
+        } else {
+            lPeak += rS.mValues[aSlot];
+        }
+    }
+    return lPeak;
+}
+
+// Turns the linear data of every series (its targets, or its values once those
+// are gone) into a ring of mStreamCapacity slots holding the last points
+void RLAreaChart::restartStream() {
+    size_t lPoints = 0;
+    for (auto& rS : mSeries) {
+        if (!rS.mTargets.empty()) {
+            rS.mValues = rS.mTargets;
+        }
+        lPoints = std::max(lPoints, rS.mValues.size());
+    }
+    const size_t lFirst = lPoints > mStreamCapacity ? lPoints - mStreamCapacity : 0;
+    mStreamHead = 0;
+    mStreamCount = lPoints - lFirst;
+
+    std::vector<float> lWindow(mStreamCapacity, 0.0f);
+    for (auto& rS : mSeries) {
+        std::fill(lWindow.begin(), lWindow.end(), 0.0f);
+        for (size_t i = 0; i < mStreamCount && lFirst + i < rS.mValues.size(); ++i) {
+            lWindow[i] = rS.mValues[lFirst + i];
+        }
+        rS.mValues = lWindow;
+        // Streamed points are shown as they arrive, nothing to animate
+        rS.mTargets.clear();
+    }
+
+    mWindowPeak.clear();
+    for (size_t i = 0; i < mStreamCount; ++i) {
+        mWindowPeak.push(columnPeak(i));
+    }
+    mStackDirty = true;
+}
+
+// Back from ring order to plain vectors of the points in the window
+void RLAreaChart::linearizeStream() {
+    std::vector<float> lLinear(mStreamCount);
+    for (auto& rS : mSeries) {
+        for (size_t i = 0; i < mStreamCount; ++i) {
+            lLinear[i] = rS.mValues[pointSlot(i)];
+        }
+        rS.mValues = lLinear;
+    }
+    mStreamHead = 0;
+    mStreamCount = 0;
+    mWindowPeak.clear();
+}
+
 void RLAreaChart::update(float aDt) {
+    RLCHARTS_PERF_UPDATE(mPerf, "RLAreaChart::update");
+    if (isSettled()) {
+        return;
+    }
+    mRedrawPending = true;
     if (!mStyle.mSmoothAnimate) {
         mMaxValue = mMaxValueTarget;
-        for (auto& rS : mSeries) {
-            rS.mValues = rS.mTargets;
+        if (mStreamCapacity == 0) {
+            for (auto& rS : mSeries) {
+                rS.mValues = rS.mTargets;
+            }
+            mStackDirty = true;
         }
         return;
     }
@@ -125,30 +299,61 @@ void RLAreaChart::update(float aDt) {
     float lLambda = mStyle.mAnimateSpeed;
     float lAlpha = 1.0f - expf(-lLambda * fmaxf(0.0f, aDt));
 
-    mMaxValue = RLCharts::lerpF(mMaxValue, mMaxValueTarget, lAlpha);
+    mMaxValue = RLCharts::approach(mMaxValue, mMaxValueTarget, lAlpha);
 
     for (auto& rS : mSeries) {
+        const size_t lCount = std::min(rS.mValues.size(), rS.mTargets.size());
+        if (lCount > 0) {
+            RLCharts::approachArray(rS.mValues.data(), rS.mTargets.data(), lCount, lAlpha);
+            mStackDirty = true;
+        }
+    }
+}
+
+bool RLAreaChart::isSettled() const {
+    if (!RLCharts::nearlyEqual(mMaxValue, mMaxValueTarget)) {
+        return false;
+    }
+    for (const auto& rS : mSeries) {
         for (size_t i = 0; i < rS.mValues.size() && i < rS.mTargets.size(); ++i) {
-            rS.mValues[i] = RLCharts::lerpF(rS.mValues[i], rS.mTargets[i], lAlpha);
+            if (!RLCharts::nearlyEqual(rS.mValues[i], rS.mTargets[i])) {
+                return false;
+            }
         }
     }
+    return true;
 }
 
-float RLAreaChart::getStackedValue(size_t aSeriesIndex, size_t aPointIndex) const {
+void RLAreaChart::updateStackColumn(size_t aSlot) const {
+    float* pColumn = mStack.data() + aSlot * mSeries.size();
     float lSum = 0.0f;
-    for (size_t i = 0; i <= aSeriesIndex; ++i) {
-        if (aPointIndex < mSeries[i].mValues.size()) {
-            lSum += mSeries[i].mValues[aPointIndex];
+    for (size_t s = 0; s < mSeries.size(); ++s) {
+        if (aSlot < mSeries[s].mValues.size()) {
+            lSum += mSeries[s].mValues[aSlot];
         }
+        pColumn[s] = lSum;
     }
+}
+
+void RLAreaChart::rebuildStack() const {
+    size_t lSlots = 0;
+    for (const auto& rS : mSeries) {
+        lSlots = std::max(lSlots, rS.mValues.size());
+    }
+    mStack.resize(lSlots * mSeries.size());
+    for (size_t i = 0; i < lSlots; ++i) {
+        updateStackColumn(i);
+    }
+    mStackDirty = false;
+}
+
+// Reads the cached running sums; the caller rebuilds them first if dirty
+float RLAreaChart::getStackedValue(size_t aSeriesIndex, size_t aPointIndex) const {
+    const float* pColumn = mStack.data() + pointSlot(aPointIndex) * mSeries.size();
+    const float lSum = pColumn[aSeriesIndex];
 
     if (mMode == RLAreaChartMode::PERCENT) {
-        float lTotal = 0.0f;
-        for (const auto& rS : mSeries) {
-            if (aPointIndex < rS.mValues.size()) {
-                lTotal += rS.mValues[aPointIndex];
-            }
-        }
+        const float lTotal = pColumn[mSeries.size() - 1];
         return lTotal > 0.0f ? (lSum / lTotal) * 100.0f : 0.0f;
     }
 
@@ -156,17 +361,25 @@ float RLAreaChart::getStackedValue(size_t aSeriesIndex, size_t aPointIndex) cons
 }
 
 void RLAreaChart::draw() const {
-    if (mStyle.mShowBackground) {
-        DrawRectangleRec(mBounds, mStyle.mBackground);
-    }
-
-    if (mStyle.mShowGrid) {
-        drawGrid();
+    RLCHARTS_PERF_DRAW(mPerf, "RLAreaChart::draw");
+    mRedrawPending = false;
+
+    // Background, grid and axes (cached if enabled). Value labels are right-aligned
+    // against the axis and may reach past the bounds, so the layer gets a margin.
+    const float lMargin = (float)mStyle.mLabelFontSize * 4.0f;
+    const Rectangle lLayerBounds{ mBounds.x - lMargin, mBounds.y - lMargin,
+                                  mBounds.width + 2.0f * lMargin, mBounds.height + 2.0f * lMargin };
+    // The labels depend on the value axis and, for the X labels, the point count
+    RLCharts::FaceKey lKey;
+    lKey.add(mMaxValue).add(mSeries.empty() ? 0 : (int)seriesPointCount(0));
+    mStaticLayer.draw(lLayerBounds, lKey.get(), [this]() { drawStaticLayer(); });
+
+    if (mStackDirty && mMode != RLAreaChartMode::OVERLAPPED) {
+        rebuildStack();
     }
 
-    drawAxes();
-
     // Draw areas from back to front
+    mBatch.clear();
     if (mMode == RLAreaChartMode::OVERLAPPED) {
         for (size_t i = 0; i < mSeries.size(); ++i) {
             drawArea(i);
@@ -176,6 +389,7 @@ void RLAreaChart::draw() const {
             drawArea((size_t)i);
         }
     }
+    mBatch.draw();
 
     if (mStyle.mShowLegend) {
         drawLegend();
@@ -192,7 +406,7 @@ void RLAreaChart::drawArea(size_t aSeriesIndex) const {
     float lChartHeight = mBounds.height - mStyle.mPadding * 2.0f - 20.0f;
     float lBaseY = mBounds.y + mBounds.height - mStyle.mPadding;
 
-    size_t lNumPoints = rS.mValues.size();
+    size_t lNumPoints = seriesPointCount(aSeriesIndex);
     if (lNumPoints < 2) {
         return;
     }
@@ -204,10 +418,12 @@ void RLAreaChart::drawArea(size_t aSeriesIndex) const {
 
     // Build triangle strip for efficient rendering
     // Format: top0, bottom0, top1, bottom1, top2, bottom2, ...
-    std::vector<Vector2> lStripPoints;
+    std::vector<Vector2>& lStripPoints = mStripPoints;
+    lStripPoints.clear();
     lStripPoints.reserve(lNumPoints * 2);
 
-    std::vector<Vector2> lTopPoints;
+    std::vector<Vector2>& lTopPoints = mTopPoints;
+    lTopPoints.clear();
     lTopPoints.reserve(lNumPoints);
 
     for (size_t i = 0; i < lNumPoints; ++i) {
@@ -216,7 +432,7 @@ void RLAreaChart::drawArea(size_t aSeriesIndex) const {
         float lBottomValue = 0.0f;
 
         if (mMode == RLAreaChartMode::OVERLAPPED) {
-            lValue = rS.mValues[i];
+            lValue = rS.mValues[pointSlot(i)];
         } else {
             lValue = getStackedValue(aSeriesIndex, i);
             if (aSeriesIndex > 0) {
@@ -232,22 +448,30 @@ void RLAreaChart::drawArea(size_t aSeriesIndex) const {
         lStripPoints.push_back({lX, lBottomY});
     }
 
-    // Draw a filled area using a triangle strip (much faster than individual triangles)
-    DrawTriangleStrip(lStripPoints.data(), (int)lStripPoints.size(), lFillColor);
+    // Filled area as a triangle strip, batched with the lines of all series
+    mBatch.addTriangleStrip(lStripPoints.data(), lStripPoints.size(), lFillColor);
 
-    // Draw the top line
-    for (size_t i = 0; i < lNumPoints - 1; ++i) {
-        DrawLineEx(lTopPoints[i], lTopPoints[i + 1], mStyle.mLineThickness, rS.mColor);
-    }
+    // Top line
+    mBatch.addPolyline(lTopPoints.data(), lTopPoints.size(), mStyle.mLineThickness, rS.mColor);
 
-    // Draw points
+    // Points
     if (mStyle.mShowPoints) {
         for (const auto& rP : lTopPoints) {
-            DrawCircleV(rP, mStyle.mPointRadius, rS.mColor);
+            mBatch.addCircle(rP, mStyle.mPointRadius, rS.mColor);
         }
     }
 }
 
+void RLAreaChart::drawStaticLayer() const {
+    if (mStyle.mShowBackground) {
+        DrawRectangleRec(mBounds, mStyle.mBackground);
+    }
+    if (mStyle.mShowGrid) {
+        drawGrid();
+    }
+    drawAxes();
+}
+
 void RLAreaChart::drawAxes() const {
     float lChartHeight = mBounds.height - mStyle.mPadding * 2.0f - 20.0f;
     float lBaseY = mBounds.y + mBounds.height - mStyle.mPadding;
@@ -279,9 +503,9 @@ void RLAreaChart::drawAxes() const {
     }
 
     // X-axis labels
-    if (!mXLabels.empty() && !mSeries.empty() && !mSeries[0].mValues.empty()) {
+    if (!mXLabels.empty() && !mSeries.empty() && seriesPointCount(0) >= 2) {
         float lChartWidth = mBounds.width - mStyle.mPadding * 2.0f;
-        size_t lNumPoints = mSeries[0].mValues.size();
+        size_t lNumPoints = seriesPointCount(0);
         float lPointSpacing = lChartWidth / (float)(lNumPoints - 1);
 
         size_t lLabelStep = mXLabels.size() > 10 ? mXLabels.size() / 10 : 1;
@@ -1,6 +1,12 @@
 // RLAreaChart.h
 #pragma once
 #include "raylib.h"
+#include "RLPerf.h"
+#include "RLLineBatch.h"
+#include "RLSlidingExtrema.h"
+#include "RLRenderCache.h"
+#include <cstddef>
+#include <span>
 #include <vector>
 #include <string>
 
@@ -65,12 +71,38 @@ public:
     void setTargetData(const std::vector<RLAreaSeries>& rSeries);
     void setXLabels(const std::vector<std::string>& rLabels);
 
+    // Streaming: keep only the last aPoints points of every series in ring buffers
+    // (0 = off, the default). The series (colors, labels) and the initial window
+    // come from setData()/setTargetData(); pushSample() then appends one point to
+    // every series in O(series), without re-sending or animating whole series.
+    void setStreamingWindow(size_t aPoints);
+    // One new value per series (missing values are 0, extra ones ignored); the
+    // oldest point drops out once the window is full
+    void pushSample(std::span<const float> aValues);
+
     void update(float aDt);
     void draw() const;
+    // Keep the background, grid, axes and axis labels in a render texture that is
+    // re-rendered only after a bounds, style, mode or label setter or a change of
+    // the value axis (while it animates, every frame), and draw just the areas
+    // over it (RLRenderCache.h). Off by default.
+    void setStaticLayerCache(bool aEnabled);
+    [[nodiscard]] const RLCharts::StaticLayer& getStaticLayer() const { return mStaticLayer; }
+
+    // Settled once every point and the value axis have reached their targets
+    [[nodiscard]] bool isSettled() const;
+    [[nodiscard]] bool needsRedraw() const { return mRedrawPending || !isSettled(); }
+    // update()/rebuild/draw() timers and GPU counters (RLPerf.h); zero unless built with RLCHARTS_PERF
+    [[nodiscard]] const RLCharts::PerfStats& getPerfStats() const { return mPerf; }
 
     [[nodiscard]] Rectangle getBounds() const { return mBounds; }
     [[nodiscard]] RLAreaChartMode getMode() const { return mMode; }
     [[nodiscard]] float getMaxValue() const { return mMaxValue; }
+    [[nodiscard]] bool isStreaming() const { return mStreamCapacity > 0; }
+    // Points per series (the window fill level while streaming)
+    [[nodiscard]] size_t getPointCount() const;
+    // Current value of a point, oldest first (0 for an unknown index)
+    [[nodiscard]] float getValue(size_t aSeriesIndex, size_t aPointIndex) const;
 
 private:
     struct SeriesDyn {
@@ -83,10 +115,19 @@ private:
 
     void calculateMaxValue();
     void drawArea(size_t aSeriesIndex) const;
+    void drawStaticLayer() const;
     void drawAxes() const;
     void drawGrid() const;
     void drawLegend() const;
     float getStackedValue(size_t aSeriesIndex, size_t aPointIndex) const;
+    [[nodiscard]] size_t seriesPointCount(size_t aSeriesIndex) const;
+    // Storage index of a point (ring position while streaming)
+    [[nodiscard]] size_t pointSlot(size_t aPointIndex) const;
+    void rebuildStack() const;
+    void updateStackColumn(size_t aSlot) const;
+    [[nodiscard]] float columnPeak(size_t aSlot) const;
+    void restartStream();
+    void linearizeStream();
 
     Rectangle mBounds{};
     RLAreaChartMode mMode{RLAreaChartMode::STACKED};
@@ -96,5 +137,26 @@ private:
     std::vector<std::string> mXLabels;
     float mMaxValue{100.0f};
     float mMaxValueTarget{100.0f};
+    mutable bool mRedrawPending{true}; // cleared by draw()
+    mutable RLCharts::PerfStats mPerf;
+    mutable RLCharts::StaticLayer mStaticLayer;
+
+    // Fills, lines and points of all series, submitted in one batch per frame
+    mutable RLCharts::LineBatch mBatch;
+    mutable std::vector<Vector2> mStripPoints;
+    mutable std::vector<Vector2> mTopPoints;
+
+    // Running stack sums per point: mStack[slot * series + s] is the sum of series
+    // 0..s. Rebuilt in one pass after values changed; pushSample() fills in only
+    // the new column.
+    mutable std::vector<float> mStack;
+    mutable bool mStackDirty{true};
+
+    // Streaming ring: every series' mValues holds mStreamCapacity slots, the
+    // oldest point at mStreamHead
+    size_t mStreamCapacity{0};
+    size_t mStreamHead{0};
+    size_t mStreamCount{0};
+    RLCharts::SlidingExtrema<float> mWindowPeak; // value axis over the window
 };
 
@@ -1,6 +1,7 @@
 // RLBarChart.cpp
 #include "RLBarChart.h"
 #include "RLCommon.h"
+#include "RLSimd.h"
 #include <algorithm>
 #include <cmath>
 
@@ -13,11 +14,13 @@ RLBarChart::RLBarChart(Rectangle aBounds, RLBarOrientation aOrientation, const R
     mScaleMaxTarget = mScaleMax;
 }
 
-void RLBarChart::setBounds(Rectangle aBounds){ mBounds = aBounds; }
+void RLBarChart::setBounds(Rectangle aBounds){ mBounds = aBounds; mRedrawPending = true; mDenseDirty = true; mStaticLayer.invalidate(); }
 
-void RLBarChart::setOrientation(RLBarOrientation aOrientation){ mOrientation = aOrientation; }
+void RLBarChart::setOrientation(RLBarOrientation aOrientation){ mOrientation = aOrientation; mRedrawPending = true; mDenseDirty = true; mStaticLayer.invalidate(); }
 
-void RLBarChart::setStyle(const RLBarChartStyle &rStyle){ mStyle = rStyle; }
+void RLBarChart::setStyle(const RLBarChartStyle &rStyle){ mStyle = rStyle; mRedrawPending = true; mDenseDirty = true; mStaticLayer.invalidate(); }
+
+void RLBarChart::setStaticLayerCache(bool aEnabled){ mStaticLayer.setEnabled(aEnabled); mRedrawPending = true; }
 
 void RLBarChart::ensureSize(size_t aCount){
     // Only ever grow immediately. Shrinking is animated and trimmed later in Update().
@@ -26,7 +29,17 @@ void RLBarChart::ensureSize(size_t aCount){
     }
 }
 
+void RLBarChart::leaveDenseMode(){
+    mDense = false;
+    mDenseValues.clear();
+    mDenseTargets.clear();
+    mDenseColors.clear();
+    mDenseBatch.clear();
+}
+
 void RLBarChart::setData(const std::vector<RLBarData> &rData){
+    mRedrawPending = true;
+    leaveDenseMode();
     mTargetCount = rData.size();
     // Hard set current data; this is immediate, no appear/disappear animation.
     mBars.clear();
@@ -81,6 +94,11 @@ float RLBarChart::computeAutoMaxFromTargets() const{
 }
 
 void RLBarChart::setTargetData(const std::vector<RLBarData> &rData){
+    mRedrawPending = true;
+    if (mDense){
+        // Regular bars grow in from nothing rather than out of the dense bins
+        leaveDenseMode();
+    }
     const size_t lOldSize = mBars.size();
     mTargetCount = rData.size();
     ensureSize(mTargetCount);
@@ -111,7 +129,69 @@ void RLBarChart::setTargetData(const std::vector<RLBarData> &rData){
     recomputeScaleTargetsFromData(rData);
 }
 
+void RLBarChart::setDenseData(std::span<const float> aValues, std::span<const Color> aColors){
+    setDense(aValues, aColors, false);
+}
+
+void RLBarChart::setDenseTargetData(std::span<const float> aValues, std::span<const Color> aColors){
+    setDense(aValues, aColors, true);
+}
+
+void RLBarChart::setDense(std::span<const float> aValues, std::span<const Color> aColors, bool aAnimate){
+    mRedrawPending = true;
+    mDenseDirty = true;
+    if (!mDense){
+        mDense = true;
+        mBars.clear();
+        mTargetCount = 0;
+    }
+    mDenseTargets.assign(aValues.begin(), aValues.end());
+    if (aAnimate){
+        // Bins that are new grow from zero; bins that are gone are dropped at once
+        mDenseValues.resize(mDenseTargets.size(), 0.0f);
+    } else {
+        mDenseValues = mDenseTargets;
+    }
+    if (aColors.size() == aValues.size()){
+        mDenseColors.assign(aColors.begin(), aColors.end());
+    } else {
+        mDenseColors.clear();
+    }
+
+    if (mStyle.mAutoScale){
+        float lMin = 1.0f;
+        float lMax = 1.0f;
+        RLCharts::minMax(mDenseTargets.data(), mDenseTargets.size(), lMin, lMax);
+        mScaleMin = 0.0f;
+        mScaleMaxTarget = lMax;
+        if (!aAnimate){
+            mScaleMax = lMax;
+        }
+    } else {
+        mScaleMin = mStyle.mMinValue;
+        mScaleMax = fmaxf(mStyle.mMaxValue, mStyle.mMinValue + 1.0f);
+        mScaleMaxTarget = mScaleMax;
+    }
+}
+
+void RLBarChart::setViewRange(float aFirstBin, float aBinCount){
+    mRedrawPending = true;
+    mDenseDirty = true;
+    mViewFirst = aFirstBin;
+    mViewCount = fmaxf(aBinCount, 0.0f);
+}
+
+void RLBarChart::resetViewRange(){ setViewRange(0.0f, 0.0f); }
+
+void RLBarChart::setDenseInstancing(bool aEnabled){ mDenseBatch.setInstancing(aEnabled); mRedrawPending = true; }
+
+float RLBarChart::getViewFirst() const{ return (mViewCount > 0.0f) ? mViewFirst : 0.0f; }
+
+float RLBarChart::getViewCount() const{ return (mViewCount > 0.0f) ? mViewCount : (float)mDenseValues.size(); }
+
 void RLBarChart::setScale(float aMinValue, float aMaxValue){
+    mRedrawPending = true;
+    mDenseDirty = true;
     mStyle.mAutoScale = false;
     mStyle.mMinValue = aMinValue;
     mStyle.mMaxValue = aMaxValue;
@@ -122,7 +202,14 @@ void RLBarChart::setScale(float aMinValue, float aMaxValue){
 
 
 void RLBarChart::update(float aDt){
+    RLCHARTS_PERF_UPDATE(mPerf, "RLBarChart::update");
+    if (isSettled()){
+        return;
+    }
+    mRedrawPending = true;
+    mDenseDirty = true;
     if (!mStyle.mSmoothAnimate){
+        std::copy(mDenseTargets.begin(), mDenseTargets.end(), mDenseValues.begin());
         for (auto &lB : mBars){
             lB.mValue = lB.mTarget;
             lB.mColor = lB.mColorTarget;
@@ -138,11 +225,16 @@ void RLBarChart::update(float aDt){
     const float lLambda = mStyle.mAnimateSpeed; // how fast it converges
     const float lAlpha = 1.0f - expf(-lLambda * fmaxf(0.0f, aDt));
     for (auto &rB : mBars){
-        rB.mValue = RLCharts::lerpF(rB.mValue, rB.mTarget, lAlpha);
-        rB.mColor = RLCharts::lerpColor(rB.mColor, rB.mColorTarget, lAlpha);
-        rB.mVisAlpha = RLCharts::lerpF(rB.mVisAlpha, rB.mVisTarget, lAlpha);
+        rB.mValue = RLCharts::approach(rB.mValue, rB.mTarget, lAlpha);
+        rB.mColor = RLCharts::approachColor(rB.mColor, rB.mColorTarget, lAlpha);
+        rB.mVisAlpha = RLCharts::approach(rB.mVisAlpha, rB.mVisTarget, lAlpha);
+    }
+    float* pValues = mDenseValues.data();
+    const float* pTargets = mDenseTargets.data();
+    for (size_t i = 0, lCount = mDenseValues.size(); i < lCount; ++i){
+        pValues[i] = RLCharts::approach(pValues[i], pTargets[i], lAlpha);
     }
-    mScaleMax = RLCharts::lerpF(mScaleMax, mScaleMaxTarget, lAlpha);
+    mScaleMax = RLCharts::approach(mScaleMax, mScaleMaxTarget, lAlpha);
 
     // Remove bars that have faded out and are beyond target range (tail)
     if (mBars.size() > mTargetCount){
@@ -158,30 +250,39 @@ void RLBarChart::update(float aDt){
     }
 }
 
-void RLBarChart::draw() const{
-    // background
-    if (mStyle.mShowBackground){
-        DrawRectangleRounded(mBounds, 0.08f, 6, mStyle.mBackground);
+bool RLBarChart::isSettled() const{
+    if (mBars.size() > mTargetCount || !RLCharts::nearlyEqual(mScaleMax, mScaleMaxTarget)){
+        return false;
+    }
+    for (size_t i = 0; i < mDenseValues.size(); ++i){
+        if (!RLCharts::nearlyEqual(mDenseValues[i], mDenseTargets[i])){
+            return false;
+        }
     }
+    for (const auto &rB : mBars){
+        if (!RLCharts::nearlyEqual(rB.mValue, rB.mTarget) || !RLCharts::nearlyEqual(rB.mVisAlpha, rB.mVisTarget) ||
+            !RLCharts::colorEquals(rB.mColor, rB.mColorTarget)){
+            return false;
+        }
+    }
+    return true;
+}
 
-    const float lPad = mStyle.mPadding;
-    Rectangle lInner{ mBounds.x + lPad, mBounds.y + lPad, mBounds.width - 2.0f*lPad, mBounds.height - 2.0f*lPad };
+void RLBarChart::draw() const{
+    RLCHARTS_PERF_DRAW(mPerf, "RLBarChart::draw");
+    mRedrawPending = false;
+    // background and grid (cached if enabled)
+    mStaticLayer.draw(mBounds, 0, [this](){ drawStaticLayer(); });
 
-    // grid
-    if (mStyle.mShowGrid && mStyle.mGridLines > 0){
-        if (mOrientation == RLBarOrientation::VERTICAL){
-            for (int i=1;i<=mStyle.mGridLines;i++){
-                float t = (float)i / (float)(mStyle.mGridLines+1);
-                float y = lInner.y + lInner.height * (1.0f - t);
-                DrawLineV({lInner.x, y}, {lInner.x + lInner.width, y}, mStyle.mGridColor);
-            }
-        }else{
-            for (int i=1;i<=mStyle.mGridLines;i++){
-                float t = (float)i / (float)(mStyle.mGridLines+1);
-                float x = lInner.x + lInner.width * t;
-                DrawLineV({x, lInner.y}, {x, lInner.y + lInner.height}, mStyle.mGridColor);
-            }
+    if (mDense){
+        if (mDenseDirty){
+            rebuildDenseBars();
         }
+        if (!mDenseBatch.empty()){
+            mDenseBatch.draw();
+            RLCHARTS_PERF_DRAW_CALLS(mPerf, 1);
+        }
+        return;
     }
 
     int lCountAll = (int)mBars.size();
@@ -189,6 +290,9 @@ void RLBarChart::draw() const{
         return;
     }
 
+    const float lPad = mStyle.mPadding;
+    Rectangle lInner{ mBounds.x + lPad, mBounds.y + lPad, mBounds.width - 2.0f*lPad, mBounds.height - 2.0f*lPad };
+
     const float lCorner = mStyle.mCornerRadius;
     const float lSpacing = mStyle.mSpacing;
     const float lMin = mScaleMin;
@@ -314,3 +418,107 @@ void RLBarChart::draw() const{
         }
     }
 }
+
+void RLBarChart::rebuildDenseBars() const{
+    RLCHARTS_PERF_REBUILD(mPerf, "RLBarChart::rebuildDenseBars");
+    mDenseDirty = false;
+    mDenseBatch.clear();
+
+    const float lPad = mStyle.mPadding;
+    const Rectangle lInner{ mBounds.x + lPad, mBounds.y + lPad, mBounds.width - 2.0f*lPad, mBounds.height - 2.0f*lPad };
+    const bool lVertical = (mOrientation == RLBarOrientation::VERTICAL);
+    // Bins run along lAxisLen; values extend along lValueLen
+    const float lAxisLen = lVertical ? lInner.width : lInner.height;
+    const float lValueLen = lVertical ? lInner.height : lInner.width;
+    const float lFirst = getViewFirst();
+    const float lCount = getViewCount();
+    const size_t lBins = mDenseValues.size();
+    if (lBins == 0 || lCount <= 0.0f || lAxisLen <= 0.0f || lValueLen <= 0.0f){
+        return;
+    }
+    // Window: only bins overlapping [lFirst, lFirst + lCount) are visited
+    const size_t lBegin = (size_t)RLCharts::clamp(floorf(lFirst), 0.0f, (float)lBins);
+    const size_t lEnd = (size_t)RLCharts::clamp(ceilf(lFirst + lCount), 0.0f, (float)lBins);
+    if (lBegin >= lEnd){
+        return;
+    }
+
+    const float lBinPx = lAxisLen / lCount;
+    const float lRange = mScaleMax - mScaleMin;
+    const Color lDefault = mStyle.mDenseColor;
+    // Bar covering [aStart, aStart + aLength) along the bin axis, clipped to the plot
+    auto lEmit = [&](float aStart, float aLength, float aValue, Color aColor){
+        const float lA = fmaxf(aStart, 0.0f);
+        const float lB = fminf(aStart + aLength, lAxisLen);
+        if (lB <= lA){
+            return;
+        }
+        const float lExtent = lValueLen * RLCharts::clamp01((aValue - mScaleMin) / lRange);
+        if (lVertical){
+            mDenseBatch.add({ lInner.x + lA, lInner.y + lInner.height - lExtent, lB - lA, lExtent }, aColor);
+        } else {
+            mDenseBatch.add({ lInner.x, lInner.y + lA, lExtent, lB - lA }, aColor);
+        }
+    };
+
+    if (lBinPx >= 1.0f){
+        // One bar per bin; the spacing shrinks with the bins so they never vanish
+        const float lGap = fminf(mStyle.mSpacing, lBinPx * 0.25f);
+        mDenseBatch.reserve(lEnd - lBegin);
+        for (size_t i = lBegin; i < lEnd; ++i){
+            const Color lColor = mDenseColors.empty() ? lDefault : mDenseColors[i];
+            lEmit(((float)i - lFirst) * lBinPx + lGap * 0.5f, lBinPx - lGap, mDenseValues[i], lColor);
+        }
+        return;
+    }
+
+    // Bins narrower than a pixel: merge each pixel column into one bar as tall as
+    // its tallest bin, so narrow peaks stay visible
+    const int lColumns = (int)ceilf(lAxisLen);
+    mDenseBatch.reserve((size_t)lColumns);
+    int lColumn = -1;
+    float lPeak = 0.0f;
+    Color lPeakColor = lDefault;
+    for (size_t i = lBegin; i < lEnd; ++i){
+        const int lBinColumn = RLCharts::clamp((int)floorf(((float)i - lFirst) * lBinPx), 0, lColumns - 1);
+        const float lValue = mDenseValues[i];
+        if (lBinColumn != lColumn){
+            if (lColumn >= 0){
+                lEmit((float)lColumn, 1.0f, lPeak, lPeakColor);
+            }
+            lColumn = lBinColumn;
+            lPeak = lValue;
+            lPeakColor = mDenseColors.empty() ? lDefault : mDenseColors[i];
+        } else if (lValue > lPeak){
+            lPeak = lValue;
+            lPeakColor = mDenseColors.empty() ? lDefault : mDenseColors[i];
+        }
+    }
+    lEmit((float)lColumn, 1.0f, lPeak, lPeakColor);
+}
+
+void RLBarChart::drawStaticLayer() const{
+    if (mStyle.mShowBackground){
+        DrawRectangleRounded(mBounds, 0.08f, 6, mStyle.mBackground);
+    }
+
+    const float lPad = mStyle.mPadding;
+    const Rectangle lInner{ mBounds.x + lPad, mBounds.y + lPad, mBounds.width - 2.0f*lPad, mBounds.height - 2.0f*lPad };
+
+    // grid
+    if (mStyle.mShowGrid && mStyle.mGridLines > 0){
+        if (mOrientation == RLBarOrientation::VERTICAL){
+            for (int i=1;i<=mStyle.mGridLines;i++){
+                float t = (float)i / (float)(mStyle.mGridLines+1);
+                float y = lInner.y + lInner.height * (1.0f - t);
+                DrawLineV({lInner.x, y}, {lInner.x + lInner.width, y}, mStyle.mGridColor);
+            }
+        }else{
+            for (int i=1;i<=mStyle.mGridLines;i++){
+                float t = (float)i / (float)(mStyle.mGridLines+1);
+                float x = lInner.x + lInner.width * t;
+                DrawLineV({x, lInner.y}, {x, lInner.y + lInner.height}, mStyle.mGridColor);
+            }
+        }
+    }
+}
@@ -1,7 +1,12 @@
 // RLBarChart.h
 #pragma once
 #include "raylib.h"
+#include "RLPerf.h"
 #include "../RLCommon.h"
+#include "../RLRectBatch.h"
+#include "../RLRenderCache.h"
+#include <cstddef>
+#include <span>
 #include <vector>
 #include <string>
 
@@ -34,6 +39,7 @@ struct RLBarChartStyle {
     float mSpacing = 10.0f;      // spacing between bars
     float mCornerRadius = 5.0f;  // rounded corner radius
     float mBorderThickness = 2.0f;
+    Color mDenseColor{80, 180, 255, 255}; // dense mode bars without per-bin colors
 
     // Labels
     bool mShowLabels = true;
@@ -62,6 +68,21 @@ public:
     void setData(const std::vector<RLBarData> &rData);
     void setTargetData(const std::vector<RLBarData> &rData);
 
+    // Dense mode for histograms with thousands of bins. Values, targets and colors
+    // are kept as flat arrays, only the bins inside the view range are drawn, bins
+    // narrower than a pixel are merged (the tallest bin of each pixel column wins)
+    // and all bars go out as one instanced draw (RLRectBatch.h). Dense bars have
+    // square corners, no borders and no labels. aColors is per bin, or empty for
+    // mDenseColor. setData()/setTargetData() switch back to the regular mode.
+    void setDenseData(std::span<const float> aValues, std::span<const Color> aColors = {});
+    void setDenseTargetData(std::span<const float> aValues, std::span<const Color> aColors = {});
+    // Bins [aFirstBin, aFirstBin + aBinCount) fill the plot; fractional values pan
+    // and zoom smoothly. The default view shows every bin.
+    void setViewRange(float aFirstBin, float aBinCount);
+    void resetViewRange();
+    // Instanced draw on/off (on by default; off draws triangles through rlgl)
+    void setDenseInstancing(bool aEnabled);
+
     // Optional explicit scale (autoScale=false)
     void setScale(float aMinValue, float aMaxValue);
 
@@ -69,10 +90,29 @@ public:
     void update(float aDt);
     // Draw chart
     void draw() const;
+    // Keep the background and grid in a render texture that is re-rendered only
+    // after setBounds()/setOrientation()/setStyle(), and draw just the bars over
+    // it each frame (RLRenderCache.h). Off by default.
+    void setStaticLayerCache(bool aEnabled);
+    [[nodiscard]] const RLCharts::StaticLayer& getStaticLayer() const { return mStaticLayer; }
+
+    // Settled once values, colors, visibility and scale are at their targets and
+    // faded-out bars are gone; needsRedraw() also covers setters since the last draw()
+    [[nodiscard]] bool isSettled() const;
+    [[nodiscard]] bool needsRedraw() const { return mRedrawPending || !isSettled(); }
+    // update()/rebuild/draw() timers and GPU counters (RLPerf.h); zero unless built with RLCHARTS_PERF
+    [[nodiscard]] const RLCharts::PerfStats& getPerfStats() const { return mPerf; }
 
     // Helpers
     [[nodiscard]] Rectangle getBounds() const { return mBounds; }
     [[nodiscard]] RLBarOrientation getOrientation() const { return mOrientation; }
+    [[nodiscard]] bool isDense() const { return mDense; }
+    [[nodiscard]] size_t getDenseBinCount() const { return mDenseValues.size(); }
+    [[nodiscard]] float getViewFirst() const;
+    [[nodiscard]] float getViewCount() const;
+    // Bars the last dense draw() emitted after windowing and merging
+    [[nodiscard]] size_t getDenseDrawnBars() const { return mDenseBatch.size(); }
+    [[nodiscard]] const RLCharts::RectBatch& getDenseBatch() const { return mDenseBatch; }
 
 private:
     struct BarDyn {
@@ -97,7 +137,24 @@ private:
     float mScaleMax{1.0f};
     float mScaleMaxTarget{1.0f};
     size_t mTargetCount{0};
-
+    mutable bool mRedrawPending{true}; // cleared by draw()
+    mutable RLCharts::PerfStats mPerf;
+    mutable RLCharts::StaticLayer mStaticLayer;
+
+    // Dense mode: one entry per bin
+    bool mDense{false};
+    std::vector<float> mDenseValues;
+    std::vector<float> mDenseTargets;
+    std::vector<Color> mDenseColors;   // empty = mStyle.mDenseColor
+    float mViewFirst{0.0f};
+    float mViewCount{0.0f};            // 0 = all bins
+    mutable RLCharts::RectBatch mDenseBatch;
+    mutable bool mDenseDirty{true};    // bars need rebuilding before the next draw()
+
+    void drawStaticLayer() const;
+    void leaveDenseMode();
+    void setDense(std::span<const float> aValues, std::span<const Color> aColors, bool aAnimate);
+    void rebuildDenseBars() const;
     void ensureSize(size_t aCount);
     void recomputeScaleTargetsFromData(const std::vector<RLBarData> &rData);
     [[nodiscard]] float computeAutoMaxFromTargets() const;
@@ -4,87 +4,61 @@
 #include <algorithm>
 #include <vector>
 
-// --- SpatialGrid implementation ---
-// Optimizes collision detection from O(N^2) to roughly O(N)
-
-void RLBubble::SpatialGrid::setup(Rectangle aBounds, float aMaxDiameter) {
-    mCellSize = aMaxDiameter;
-    if (mCellSize < 1.0f) mCellSize = 10.0f;
-
-    mStartX = aBounds.x;
-    mStartY = aBounds.y;
-    mCols = (int)(aBounds.width / mCellSize) + 2;
-    mRows = (int)(aBounds.height / mCellSize) + 2;
-
-    const auto lTotal = static_cast<size_t>(mCols * mRows);
-    if (mCells.size() < lTotal) {
-        mCells.resize(lTotal);
-    }
-
-    // Fast clear
-    for (auto& rCell : mCells) rCell.clear();
-}
-
-void RLBubble::SpatialGrid::insert(int aBubbleIndex, Vector2 aPos) {
-    int lCx = (int)((aPos.x - mStartX) / mCellSize);
-    int lCy = (int)((aPos.y - mStartY) / mCellSize);
-    // Bounds check
-    if (lCx >= 0 && lCx < mCols && lCy >= 0 && lCy < mRows) {
-        mCells[lCy * mCols + lCx].push_back(aBubbleIndex);
-    }
-}
-
-const std::vector<int>* RLBubble::SpatialGrid::getCell(int aCx, int aCy) const {
-    if (aCx >= 0 && aCx < mCols && aCy >= 0 && aCy < mRows) {
-        return &mCells[aCy * mCols + aCx];
-    }
-    return nullptr;
-}
-
 RLBubble::RLBubble(Rectangle bounds, RLBubbleMode mode, const RLBubbleStyle &style)
     : mBounds(bounds), mMode(mode), mStyle(style)
 {
 }
 
+void RLBubble::setTaskPool(RLCharts::TaskPool* pPool){ mpTaskPool = pPool; }
+
 Rectangle RLBubble::chartRect() const{
     float pad = mStyle.mShowAxes ? 32.0f : 8.0f;
     return Rectangle{ mBounds.x+pad, mBounds.y+pad, std::max(0.0f,mBounds.width-2*pad), std::max(0.0f,mBounds.height-2*pad) };
 }
 
-void RLBubble::setBounds(Rectangle bounds){ mBounds = bounds; }
-void RLBubble::setStyle(const RLBubbleStyle &rStyle){ mStyle = rStyle; }
-void RLBubble::setMode(RLBubbleMode mode){ mMode = mode; }
+void RLBubble::setBounds(Rectangle bounds){ mBounds = bounds; mPhysicsAsleep = false; mRedrawPending = true; }
+void RLBubble::setStyle(const RLBubbleStyle &rStyle){ mStyle = rStyle; mPhysicsAsleep = false; mRedrawPending = true; }
+void RLBubble::setMode(RLBubbleMode mode){ mMode = mode; mPhysicsAsleep = false; mRedrawPending = true; }
 
 float RLBubble::sizeToRadius(float size) const{
     float r = std::sqrt(std::max(0.0f, size)) * mStyle.mSizeScale;
     return std::max(mStyle.mMinRadius, r);
 }
 
+void RLBubble::pushBubble(const BubbleDyn &b, Vector2 pos, float radius, float mass){
+    mBubbles.push_back(b);
+    mPos.push_back(pos);
+    mPrevPos.push_back(pos);
+    mVel.push_back({0,0});
+    mRadius.push_back(radius);
+    mMass.push_back(mass);
+}
+
 
 void RLBubble::setImmediateDataInternal(const std::vector<RLBubblePoint> &data){
     Rectangle cr = chartRect();
     size_t n = data.size();
     mBubbles.clear();
+    mPos.clear();
+    mPrevPos.clear();
+    mVel.clear();
+    mRadius.clear();
+    mMass.clear();
     mBubbles.reserve(n);
     mLargestIndex = -1;
     float largestR = -1.0f;
     for (size_t i=0;i<n;i++){
         const auto &p = data[i];
+        const Vector2 pos{ cr.x + RLCharts::clamp01(p.mX)*cr.width, cr.y + (1.0f- RLCharts::clamp01(p.mY))*cr.height };
+        const float radius = sizeToRadius(p.mSize);
         BubbleDyn b;
-        b.mPos = { cr.x + RLCharts::clamp01(p.mX)*cr.width, cr.y + (1.0f- RLCharts::clamp01(p.mY))*cr.height };
-        b.mPrevPos = b.mPos;
-        b.mRadius = sizeToRadius(p.mSize);
         b.mColor = p.mColor;
-        
-        b.mPosTarget = b.mPos;
-        b.mRadiusTarget = b.mRadius;
+        b.mPosTarget = pos;
+        b.mRadiusTarget = radius;
         b.mColorTarget = b.mColor;
-        
-        b.mVel = {0,0};
-        b.mMass = std::max(1.0f, b.mRadius * b.mRadius); // Mass proportional to area
-        
-        mBubbles.push_back(b);
-        if (b.mRadius > largestR){ largestR = b.mRadius; mLargestIndex = (int)i; }
+
+        pushBubble(b, pos, radius, std::max(1.0f, radius * radius)); // Mass proportional to area
+        if (radius > largestR){ largestR = radius; mLargestIndex = (int)i; }
     }
 }
 
@@ -102,17 +76,17 @@ void RLBubble::buildTargetsForAnimation(const std::vector<RLBubblePoint> &data){
         auto &b = mBubbles[i];
         
         // If invisible/uninitialized, spawn at target location with 0 radius
-        if (b.mRadius <= 0.1f && b.mColor.a == 0){
-            b.mPos = { cr.x + RLCharts::clamp01(p.mX)*cr.width, cr.y + (1.0f- RLCharts::clamp01(p.mY))*cr.height };
-            b.mPrevPos = b.mPos;
+        if (mRadius[i] <= 0.1f && b.mColor.a == 0){
+            mPos[i] = { cr.x + RLCharts::clamp01(p.mX)*cr.width, cr.y + (1.0f- RLCharts::clamp01(p.mY))*cr.height };
+            mPrevPos[i] = mPos[i];
             b.mColor = { p.mColor.r, p.mColor.g, p.mColor.b, 0 };
-            b.mRadius = 0.0f;
+            mRadius[i] = 0.0f;
         }
 
         b.mPosTarget = { cr.x + RLCharts::clamp01(p.mX)*cr.width, cr.y + (1.0f- RLCharts::clamp01(p.mY))*cr.height };
         b.mRadiusTarget = sizeToRadius(p.mSize);
         b.mColorTarget = p.mColor;
-        b.mMass = std::max(1.0f, b.mRadiusTarget * b.mRadiusTarget);
+        mMass[i] = std::max(1.0f, b.mRadiusTarget * b.mRadiusTarget);
         
         if (b.mRadiusTarget > largestR){ largestR = b.mRadiusTarget; mLargestIndex = (int)i; }
     }
@@ -120,7 +94,7 @@ void RLBubble::buildTargetsForAnimation(const std::vector<RLBubblePoint> &data){
     // Fade out excess bubbles
     for (size_t i=minN; i<oldN; ++i){
         auto &b = mBubbles[i];
-        b.mPosTarget = b.mPos; 
+        b.mPosTarget = mPos[i];
         b.mRadiusTarget = 0.0f;
         b.mColorTarget = b.mColor; 
         b.mColorTarget.a = 0;
@@ -131,17 +105,13 @@ void RLBubble::buildTargetsForAnimation(const std::vector<RLBubblePoint> &data){
         mBubbles.reserve(newN);
         for (size_t i=oldN; i<newN; ++i){
             const auto &p = data[i];
+            const Vector2 pos{ cr.x + RLCharts::clamp01(p.mX)*cr.width, cr.y + (1.0f- RLCharts::clamp01(p.mY))*cr.height };
             BubbleDyn b{};
-            b.mPos = { cr.x + RLCharts::clamp01(p.mX)*cr.width, cr.y + (1.0f- RLCharts::clamp01(p.mY))*cr.height };
-            b.mPrevPos = b.mPos;
-            b.mPosTarget = b.mPos;
-            b.mRadius = 0.0f;
+            b.mPosTarget = pos;
             b.mRadiusTarget = sizeToRadius(p.mSize);
             b.mColor = { p.mColor.r, p.mColor.g, p.mColor.b, 0 };
             b.mColorTarget = p.mColor;
-            b.mVel = {0,0};
-            b.mMass = std::max(1.0f, b.mRadiusTarget * b.mRadiusTarget);
-            mBubbles.push_back(b);
+            pushBubble(b, pos, 0.0f, std::max(1.0f, b.mRadiusTarget * b.mRadiusTarget));
             
             if (b.mRadiusTarget > largestR){ largestR = b.mRadiusTarget; mLargestIndex = (int)i; }
         }
@@ -149,15 +119,34 @@ void RLBubble::buildTargetsForAnimation(const std::vector<RLBubblePoint> &data){
 }
 
 void RLBubble::setData(const std::vector<RLBubblePoint> &rData){
+    mRedrawPending = true;
+    mPhysicsAsleep = false;
     setImmediateDataInternal(rData);
 }
 
 void RLBubble::setTargetData(const std::vector<RLBubblePoint> &rData){
+    mRedrawPending = true;
+    mPhysicsAsleep = false;
     buildTargetsForAnimation(rData);
 }
 
+bool RLBubble::isSettled() const{
+    if (mMode == RLBubbleMode::Gravity && !mBubbles.empty() && !mPhysicsAsleep) return false;
+    for (size_t i=0; i<mBubbles.size(); ++i){
+        const auto &b = mBubbles[i];
+        if (!RLCharts::nearlyEqual(mRadius[i], b.mRadiusTarget) || !RLCharts::colorEquals(b.mColor, b.mColorTarget)) return false;
+        if (mMode == RLBubbleMode::Scatter &&
+            (!RLCharts::nearlyEqual(mPos[i].x, b.mPosTarget.x) || !RLCharts::nearlyEqual(mPos[i].y, b.mPosTarget.y))) return false;
+        // Faded-out bubbles are still waiting for removal
+        if (b.mRadiusTarget <= 0.001f) return false;
+    }
+    return true;
+}
+
 void RLBubble::update(float dt){
-    if (mBubbles.empty()) return;
+    RLCHARTS_PERF_UPDATE(mPerf, "RLBubble::update");
+    if (mBubbles.empty() || isSettled()) return;
+    mRedrawPending = true;
 
     // Cap dt to prevent physics explosions on lag
     dt = std::max(0.001f, std::min(dt, 0.05f)); 
@@ -166,17 +155,20 @@ void RLBubble::update(float dt){
     float lerpT = 1.0f - std::exp(-mLerpSpeed * dt);
     float maxDiameter = 0.0f;
 
-    for (auto &b : mBubbles){
-        b.mRadius = RLCharts::lerpF(b.mRadius, b.mRadiusTarget, lerpT);
-        b.mColor  = RLCharts::lerpColor(b.mColor,  b.mColorTarget,  lerpT);
-        if (b.mRadius * 2.0f > maxDiameter) maxDiameter = b.mRadius * 2.0f;
+    const size_t count = mBubbles.size();
+    for (size_t i=0; i<count; ++i){
+        auto &b = mBubbles[i];
+        mRadius[i] = RLCharts::approach(mRadius[i], b.mRadiusTarget, lerpT);
+        b.mColor  = RLCharts::approachColor(b.mColor,  b.mColorTarget,  lerpT);
+        if (mRadius[i] * 2.0f > maxDiameter) maxDiameter = mRadius[i] * 2.0f;
     }
 
     if (mMode == RLBubbleMode::Scatter){
         // --- SCATTER MODE: Simple Lerp ---
-        for (auto &b : mBubbles){
-            b.mPos = RLCharts::lerpVector2(b.mPos, b.mPosTarget, lerpT);
-            b.mPrevPos = b.mPos; // Keep physics state sync
+        for (size_t i=0; i<count; ++i){
+            mPos[i].x = RLCharts::approach(mPos[i].x, mBubbles[i].mPosTarget.x, lerpT);
+            mPos[i].y = RLCharts::approach(mPos[i].y, mBubbles[i].mPosTarget.y, lerpT);
+            mPrevPos[i] = mPos[i]; // Keep physics state sync
         }
     } else {
         // --- GRAVITY MODE: Stabilized PBD ---
@@ -185,113 +177,165 @@ void RLBubble::update(float dt){
 
         const float friction = 0.88f;    // High friction stops spinning
         const float gravityStr = 15.0f;  // Pull to center
-        const int iterations = 8;        // Solver iterations for stability
 
         // A. Forces & Integration
-        for (auto &b : mBubbles){
+        for (size_t i=0; i<count; ++i){
+            Vector2 &pos = mPos[i];
+            Vector2 &vel = mVel[i];
+            const float radius = mRadius[i];
+
             // Center Gravity
-            float dx = center.x - b.mPos.x;
-            float dy = center.y - b.mPos.y;
+            float dx = center.x - pos.x;
+            float dy = center.y - pos.y;
             
             // Add force to velocity
-            b.mVel.x += dx * gravityStr * dt;
-            b.mVel.y += dy * gravityStr * dt;
+            vel.x += dx * gravityStr * dt;
+            vel.y += dy * gravityStr * dt;
 
             // Apply Friction (Damping) immediately
-            b.mVel.x *= friction;
-            b.mVel.y *= friction;
+            vel.x *= friction;
+            vel.y *= friction;
 
             // Store previous pos for Verlet
-            b.mPrevPos = b.mPos;
+            mPrevPos[i] = pos;
 
             // Apply Velocity
-            b.mPos.x += b.mVel.x * dt;
-            b.mPos.y += b.mVel.y * dt;
+            pos.x += vel.x * dt;
+            pos.y += vel.y * dt;
 
             // Wall Constraints (Hard clamp)
-            if (b.mPos.x < cr.x + b.mRadius) b.mPos.x = cr.x + b.mRadius;
-            if (b.mPos.x > cr.x + cr.width - b.mRadius) b.mPos.x = cr.x + cr.width - b.mRadius;
-            if (b.mPos.y < cr.y + b.mRadius) b.mPos.y = cr.y + b.mRadius;
-            if (b.mPos.y > cr.y + cr.height - b.mRadius) b.mPos.y = cr.y + cr.height - b.mRadius;
+            if (pos.x < cr.x + radius) pos.x = cr.x + radius;
+            if (pos.x > cr.x + cr.width - radius) pos.x = cr.x + cr.width - radius;
+            if (pos.y < cr.y + radius) pos.y = cr.y + radius;
+            if (pos.y > cr.y + cr.height - radius) pos.y = cr.y + cr.height - radius;
         }
 
         // B. Collision Resolution (Grid Optimized)
-        mGrid.setup(cr, maxDiameter);
-        for(int i = 0; i < (int)mBubbles.size(); ++i) {
-            mGrid.insert(i, mBubbles[i].mPos);
+        mGrid.build(cr, maxDiameter >= 1.0f ? maxDiameter : 10.0f, count,
+                    [this](size_t aIndex) { return mPos[aIndex]; });
+        collisionPass();
+
+        // C. Reconstruct Velocity
+        mPhysicsAsleep = true;
+        for (size_t i=0; i<count; ++i){
+            Vector2 &vel = mVel[i];
+            vel.x = (mPos[i].x - mPrevPos[i].x) / dt;
+            vel.y = (mPos[i].y - mPrevPos[i].y) / dt;
+
+            // Sleep threshold to stop micro-jitter
+            float speedSq = vel.x*vel.x + vel.y*vel.y;
+            if (speedSq < 1.0f) {
+                vel = {0,0};
+            } else {
+                mPhysicsAsleep = false;
+            }
         }
+    }
 
-        for (int k = 0; k < iterations; ++k){
-            for (int i = 0; i < (int)mBubbles.size(); ++i) {
-                auto& a = mBubbles[i];
-                if (a.mRadius <= 0.0f) continue;
-
-                int cx = (int)((a.mPos.x - mGrid.mStartX) / mGrid.mCellSize);
-                int cy = (int)((a.mPos.y - mGrid.mStartY) / mGrid.mCellSize);
-
-                // Check 3x3 neighbors
-                for (int ny = cy - 1; ny <= cy + 1; ++ny) {
-                    for (int nx = cx - 1; nx <= cx + 1; ++nx) {
-                        const std::vector<int>* cell = mGrid.getCell(nx, ny);
-                        if (!cell) continue;
-
-                        for (int j : *cell) {
-                            if (i == j) continue;
-                            auto& b = mBubbles[j];
-
-                            float dx = a.mPos.x - b.mPos.x;
-                            float dy = a.mPos.y - b.mPos.y;
-                            float rSum = a.mRadius + b.mRadius;
-
-                            // Bounding box check
-                            if (std::abs(dx) >= rSum || std::abs(dy) >= rSum) continue;
-
-                            float distSq = dx*dx + dy*dy;
-                            if (distSq < rSum*rSum && distSq > 0.0001f) {
-                                float dist = std::sqrt(distSq);
-                                float pen = (rSum - dist) * 0.5f; // Split overlap
-
-                                float nx_val = dx / dist;
-                                float ny_val = dy / dist;
-
-                                // Mass-weighted push
-                                // Heavier (larger) bubbles move less
-                                float totalM = a.mMass + b.mMass;
-                                float ratioA = b.mMass / totalM;
-                                float ratioB = a.mMass / totalM;
-
-                                a.mPos.x += nx_val * pen * ratioA;
-                                a.mPos.y += ny_val * pen * ratioA;
-                                b.mPos.x -= nx_val * pen * ratioB;
-                                b.mPos.y -= ny_val * pen * ratioB;
-                            }
+    removeDeadBubbles();
+}
+
+void RLBubble::resolveCollisions(size_t begin, size_t end){
+    // Each bubble sums its own share of every overlap against the positions of
+    // the previous pass: it writes only mPush[i], so slices run in parallel and
+    // the result does not depend on the thread count
+    for (size_t i = begin; i < end; ++i) {
+        Vector2 push{0,0};
+        const Vector2 a = mPos[i];
+        const float ra = mRadius[i];
+        if (ra > 0.0f) {
+            const float ma = mMass[i];
+            int cx = 0;
+            int cy = 0;
+            mGrid.cellOf(a, cx, cy);
+
+            // Check 3x3 neighbors
+            for (int ny = cy - 1; ny <= cy + 1; ++ny) {
+                for (int nx = cx - 1; nx <= cx + 1; ++nx) {
+                    size_t cellCount = 0;
+                    const uint32_t* cell = mGrid.cellItems(nx, ny, cellCount);
+
+                    for (size_t c = 0; c < cellCount; ++c) {
+                        const size_t j = cell[c];
+                        if (i == j) continue;
+                        const Vector2 b = mPos[j];
+
+                        float dx = a.x - b.x;
+                        float dy = a.y - b.y;
+                        float rSum = ra + mRadius[j];
+
+                        // Bounding box check
+                        if (std::abs(dx) >= rSum || std::abs(dy) >= rSum) continue;
+
+                        float distSq = dx*dx + dy*dy;
+                        if (distSq < rSum*rSum && distSq > 0.0001f) {
+                            float dist = std::sqrt(distSq);
+                            float pen = (rSum - dist) * 0.5f; // Split overlap
+
+                            // Mass-weighted push
+                            // Heavier (larger) bubbles move less
+                            float ratio = mMass[j] / (ma + mMass[j]);
+                            push.x += dx / dist * pen * ratio;
+                            push.y += dy / dist * pen * ratio;
                         }
                     }
                 }
             }
         }
+        mPush[i] = push;
+    }
+}
 
-        // C. Reconstruct Velocity
-        for (auto &b : mBubbles){
-            b.mVel.x = (b.mPos.x - b.mPrevPos.x) / dt;
-            b.mVel.y = (b.mPos.y - b.mPrevPos.y) / dt;
-
-            // Sleep threshold to stop micro-jitter
-            float speedSq = b.mVel.x*b.mVel.x + b.mVel.y*b.mVel.y;
-            if (speedSq < 1.0f) {
-                b.mVel = {0,0};
-            }
+void RLBubble::collisionPass(){
+    const int iterations = 8;        // Solver iterations for stability
+    const size_t count = mPos.size();
+    mPush.resize(count);
+
+    RLCharts::TaskPool &rPool = getTaskPool();
+    size_t threads = mStyle.mPhysicsThreads == 0 ? rPool.getThreadCount()
+                                                 : (size_t)std::max(1, mStyle.mPhysicsThreads);
+    threads = std::max((size_t)1, std::min(threads, count / PHYSICS_MIN_BUBBLES_PER_THREAD));
+
+    for (int k = 0; k < iterations; ++k){
+        rPool.parallelFor(threads, [this, threads, count](size_t t){
+            resolveCollisions(count * t / threads, count * (t + 1) / threads);
+        });
+        for (size_t i = 0; i < count; ++i){
+            mPos[i].x += mPush[i].x;
+            mPos[i].y += mPush[i].y;
         }
     }
+}
 
-    // Cleanup dead bubbles
-    auto it = std::remove_if(mBubbles.begin(), mBubbles.end(), [](const BubbleDyn &b){
-        return (b.mRadiusTarget <= 0.001f) && (b.mRadius < 0.5f) && (b.mColor.a < 5);
-    });
-    if (it != mBubbles.end()) mBubbles.erase(it, mBubbles.end());
+void RLBubble::removeDeadBubbles(){
+    // Compact every array in step
+    size_t out = 0;
+    for (size_t i = 0; i < mBubbles.size(); ++i){
+        const bool dead = (mBubbles[i].mRadiusTarget <= 0.001f) && (mRadius[i] < 0.5f) && (mBubbles[i].mColor.a < 5);
+        if (dead) continue;
+        if (out != i){
+            mBubbles[out] = mBubbles[i];
+            mPos[out] = mPos[i];
+            mPrevPos[out] = mPrevPos[i];
+            mVel[out] = mVel[i];
+            mRadius[out] = mRadius[i];
+            mMass[out] = mMass[i];
+        }
+        out++;
+    }
+    if (out != mBubbles.size()){
+        mBubbles.resize(out);
+        mPos.resize(out);
+        mPrevPos.resize(out);
+        mVel.resize(out);
+        mRadius.resize(out);
+        mMass.resize(out);
+    }
 }
 
 void RLBubble::draw() const{
+    RLCHARTS_PERF_DRAW(mPerf, "RLBubble::draw");
+    mRedrawPending = false;
     // 1. Background
     if (mStyle.mBackground.a > 0) 
         DrawRectangleRounded(mBounds, 0.06f, 6, mStyle.mBackground);
@@ -310,23 +354,39 @@ void RLBubble::draw() const{
     }
 
     // 3. Draw Bubbles (Sorted by size)
-    // We sort pointers to avoid copying large vectors, drawing large bubbles first.
-    std::vector<const BubbleDyn*> drawOrder;
-    drawOrder.reserve(mBubbles.size());
-    for(const auto& b : mBubbles) drawOrder.push_back(&b);
-    
-    // Sort: Large radius -> Small radius (Painter's algorithm)
-    std::sort(drawOrder.begin(), drawOrder.end(), [](const BubbleDyn* a, const BubbleDyn* b){
-        return a->mRadius > b->mRadius; 
-    });
-
-    // Draw
-    for (const auto *b : drawOrder){
-        if (b->mRadius < 1.0f) continue; // Skip tiny ones
-        
-        if (mStyle.mOutline > 0.0f){ 
-            DrawCircleV(b->mPos, b->mRadius + mStyle.mOutline, mStyle.mOutlineColor); 
+    // Large radius -> Small radius (Painter's algorithm). The order is kept
+    // between frames; radii change a little per frame, so an insertion sort
+    // repairs it in close to linear time. A reshuffle (new data) that would
+    // make it quadratic falls back to a full sort.
+    const auto larger = [this](uint32_t a, uint32_t b){ return mRadius[a] > mRadius[b]; };
+    bool fullSort = mDrawOrder.size() != mBubbles.size();
+    if (fullSort){
+        mDrawOrder.resize(mBubbles.size());
+        for (size_t i = 0; i < mDrawOrder.size(); ++i) mDrawOrder[i] = (uint32_t)i;
+    } else {
+        size_t moves = 0;
+        const size_t maxMoves = 8 * mDrawOrder.size();
+        for (size_t i = 1; i < mDrawOrder.size() && !fullSort; ++i){
+            const uint32_t id = mDrawOrder[i];
+            size_t j = i;
+            while (j > 0 && larger(id, mDrawOrder[j - 1])){
+                mDrawOrder[j] = mDrawOrder[j - 1];
+                j--;
+                moves++;
+            }
+            mDrawOrder[j] = id;
+            fullSort = moves > maxMoves;
         }
-        DrawCircleV(b->mPos, b->mRadius, b->mColor);
     }
+    if (fullSort){
+        std::sort(mDrawOrder.begin(), mDrawOrder.end(), larger);
+    }
+
+    // Draw, all bubbles in one instanced batch
+    mCircles.clear();
+    for (const uint32_t i : mDrawOrder){
+        if (mRadius[i] < 1.0f) continue; // Skip tiny ones
+        mCircles.add(mPos[i], mRadius[i], mBubbles[i].mColor, mStyle.mOutline, mStyle.mOutlineColor);
+    }
+    mCircles.draw();
 }
\ No newline at end of file
@@ -1,5 +1,9 @@
 #pragma once
 #include "raylib.h"
+#include "RLPerf.h"
+#include "RLSpatialGrid.h"
+#include "RLCircleBatch.h"
+#include "RLTaskPool.h"
 #include "../RLCommon.h"
 #include <vector>
 
@@ -31,6 +35,7 @@ struct RLBubbleStyle {
     Color mOutlineColor{0,0,0,80};
     bool mShowAxes = true;
     bool mSmooth = true;
+    int mPhysicsThreads = 1;    // gravity collision tasks: 1 = update thread only, 0 = every task pool thread
 };
 
 class RLBubble {
@@ -50,41 +55,39 @@ public:
     void update(float dt);
     // Draw chart inside bounds.
     void draw() const;
+    // Pool that runs threaded collision passes (RLTaskPool.h); nullptr =
+    // RLCharts::TaskPool::shared(). The pool must outlive the chart.
+    void setTaskPool(RLCharts::TaskPool* pPool);
+    [[nodiscard]] RLCharts::TaskPool& getTaskPool() const {
+        return mpTaskPool != nullptr ? *mpTaskPool : RLCharts::TaskPool::shared();
+    }
+
+    // Settled once radii, colors and positions reached their targets (gravity mode:
+    // once every bubble fell below the sleep threshold). needsRedraw() also covers
+    // setters since the last draw().
+    [[nodiscard]] bool isSettled() const;
+    [[nodiscard]] bool needsRedraw() const { return mRedrawPending || !isSettled(); }
+    // update()/rebuild/draw() timers and GPU counters (RLPerf.h); zero unless built with RLCHARTS_PERF
+    [[nodiscard]] const RLCharts::PerfStats& getPerfStats() const { return mPerf; }
 
     // Helpers
     [[nodiscard]] Rectangle getBounds() const { return mBounds; }
     [[nodiscard]] RLBubbleMode getMode() const { return mMode; }
+    [[nodiscard]] size_t getBubbleCount() const { return mBubbles.size(); }
+    // Current center and radius of bubble i (i < getBubbleCount())
+    [[nodiscard]] Vector2 getBubblePosition(size_t i) const { return mPos[i]; }
+    [[nodiscard]] float getBubbleRadius(size_t i) const { return mRadius[i]; }
 
 private:
+    // Per-bubble state outside the physics loops; the hot fields live in the
+    // parallel arrays below (same index)
     struct BubbleDyn {
-        // current state
-        Vector2 mPos{0,0};
-        Vector2 mPrevPos{0,0}; // Required for stable physics (Verlet)
-        float mRadius{5.0f};
         Color mColor{ 80,180,255,255 };
 
         // target state (scatter)
         Vector2 mPosTarget{0,0};
         float mRadiusTarget{5.0f};
         Color mColorTarget{ 80,180,255,255 };
-
-        // velocity (gravity)
-        Vector2 mVel{0,0};
-        float mMass{1.0f};
-    };
-
-    // Spatial grid for optimized collision detection O(N) instead of O(N^2)
-    struct SpatialGrid {
-        int mCols{0};
-        int mRows{0};
-        float mCellSize{1.0f};
-        float mStartX{0.0f};
-        float mStartY{0.0f};
-        std::vector<std::vector<int>> mCells;
-
-        void setup(Rectangle aBounds, float aMaxDiameter);
-        void insert(int aBubbleIndex, Vector2 aPos);
-        [[nodiscard]] const std::vector<int>* getCell(int aCx, int aCy) const;
     };
 
     Rectangle mBounds{};
@@ -92,8 +95,23 @@ private:
     RLBubbleStyle mStyle{};
 
     std::vector<BubbleDyn> mBubbles;
+    // Hot state, structure-of-arrays
+    std::vector<Vector2> mPos;
+    std::vector<Vector2> mPrevPos;  // Required for stable physics (Verlet)
+    std::vector<Vector2> mVel;      // gravity
+    std::vector<float> mRadius;
+    std::vector<float> mMass;
+    std::vector<Vector2> mPush;     // collision pass scratch: displacement per bubble
+    // Threaded collision passes only pay off with enough bubbles per task
+    static constexpr size_t PHYSICS_MIN_BUBBLES_PER_THREAD = 2048;
+    RLCharts::TaskPool* mpTaskPool{nullptr};
+    mutable std::vector<uint32_t> mDrawOrder; // large -> small, kept between frames
+    mutable RLCharts::CircleBatch mCircles;   // instanced discs + outlines
     int mLargestIndex{-1};
-    SpatialGrid mGrid{};
+    RLCharts::SpatialGrid mGrid; // collision broad phase, O(N) instead of O(N^2)
+    bool mPhysicsAsleep{false};      // gravity mode: last step left every bubble at rest
+    mutable bool mRedrawPending{true}; // cleared by draw()
+    mutable RLCharts::PerfStats mPerf;
 
     // animation parameters
     float mLerpSpeed = 6.0f;         // scatter smoothing
@@ -103,4 +121,8 @@ private:
     void setImmediateDataInternal(const std::vector<RLBubblePoint> &data);
     [[nodiscard]] Rectangle chartRect() const;
     [[nodiscard]] float sizeToRadius(float size) const;
+    void pushBubble(const BubbleDyn &b, Vector2 pos, float radius, float mass);
+    void resolveCollisions(size_t begin, size_t end);
+    void collisionPass();
+    void removeDeadBubbles();
 };
\ No newline at end of file
@@ -1,8 +1,11 @@
 // RLCandlestickChart.cpp
 #include "RLCandlestickChart.h"
+#include "RLCivilDate.h"
 #include "RLCommon.h"
+#include "rlgl.h"
 #include <cmath>
 #include <algorithm>
+#include <cstdio>
 
 
 RLCandlestickChart::RLCandlestickChart(Rectangle aBounds, int aValuesPerCandle, int aVisibleCandles, const RLCandleStyle &aStyle)
@@ -13,29 +16,164 @@ RLCandlestickChart::RLCandlestickChart(Rectangle aBounds, int aValuesPerCandle,
     mScaleTargetMax = mScaleMax;
 }
 
-void RLCandlestickChart::setBounds(Rectangle aBounds) { mBounds = aBounds; }
-void RLCandlestickChart::setValuesPerCandle(int aValuesPerCandle) { mValuesPerCandle = (aValuesPerCandle <= 0) ? 1 : aValuesPerCandle; }
-void RLCandlestickChart::setVisibleCandles(int aVisibleCandles) { mVisibleCandles = (aVisibleCandles <= 1) ? 1 : aVisibleCandles; ensureWindow(); }
-void RLCandlestickChart::setStyle(const RLCandleStyle &rStyle) { mStyle = rStyle; }
+void RLCandlestickChart::setBounds(Rectangle aBounds) { mBounds = aBounds; mRedrawPending = true; mBatchValid = false; }
+void RLCandlestickChart::setValuesPerCandle(int aValuesPerCandle) {
+    mValuesPerCandle = (aValuesPerCandle <= 0) ? 1 : aValuesPerCandle;
+    mDaily = false;
+    mRedrawPending = true;
+    if (mHistoryEnabled) {
+        rebuildFromHistory();
+    }
+}
+void RLCandlestickChart::setVisibleCandles(int aVisibleCandles) {
+    mVisibleCandles = (aVisibleCandles <= 1) ? 1 : aVisibleCandles;
+    mRedrawPending = true;
+    mBatchValid = false;
+    if (mHistoryEnabled) {
+        rebuildFromHistory();
+    } else {
+        ensureWindow();
+    }
+}
+void RLCandlestickChart::setHistoryEnabled(bool aEnabled) {
+    if (aEnabled != mHistoryEnabled) {
+        mHistory.clear();
+        mHistoryDays.clear();
+    }
+    mHistoryEnabled = aEnabled;
+}
+void RLCandlestickChart::setDailyCandles(bool aDaily) {
+    mDaily = aDaily;
+    mRedrawPending = true;
+    if (mHistoryEnabled) {
+        rebuildFromHistory();
+    }
+}
+void RLCandlestickChart::setStyle(const RLCandleStyle &rStyle) {
+    const bool lScaleInputChanged = rStyle.mIncludeWicksInScale != mStyle.mIncludeWicksInScale;
+    mStyle = rStyle;
+    mRedrawPending = true;
+    mBatchValid = false;
+    if (lScaleInputChanged) {
+        rebuildExtrema();
+    }
+}
 void RLCandlestickChart::setExplicitScale(float aMinPrice, float aMaxPrice) {
+    mRedrawPending = true;
     mStyle.mAutoScale = false;
     mScaleMin = aMinPrice;
     mScaleMax = aMaxPrice > aMinPrice ? aMaxPrice : (aMinPrice + 1.0f);
     mScaleTargetMax = mScaleMax;
 }
 
-std::string RLCandlestickChart::dayKeyFromDate(const std::string &aDate) {
-    // Expect formats like YYYY-MM-DD HH:MM:SS or YYYY-MM-DD
-    size_t lPos = aDate.find(' ');
-    if (lPos == std::string::npos) {
-        return aDate;
+void RLCandlestickChart::setDayBoundaryOffset(int aSeconds) { mDayBoundaryOffset = aSeconds; }
+
+// Parse "YYYY-MM-DD[ HH:MM[:SS]]" without allocating. Unparsable strings get a hashed
+// day number (flagged, so no label is drawn) so day changes are still detected.
+bool RLCandlestickChart::parseDate(const std::string &rDate, int64_t &rDay, int64_t &rTime) {
+    int64_t lFields[6] = {0, 0, 0, 0, 0, 0};
+    int lField = 0;
+    bool lDigits = false;
+    size_t i = 0;
+    for (; i < rDate.size() && lField < 6; ++i) {
+        const char lCh = rDate[i];
+        if (lCh >= '0' && lCh <= '9') {
+            lFields[lField] = lFields[lField] * 10 + (lCh - '0');
+            lDigits = true;
+        } else if (lDigits && (lCh == '-' || lCh == ':' || lCh == ' ' || lCh == 'T')) {
+            lField++;
+            lDigits = false;
+        } else {
+            break;
+        }
+    }
+    const int lParsed = lField + (lDigits ? 1 : 0);
+    if (lParsed >= 3 && lFields[1] >= 1 && lFields[1] <= 12 && lFields[2] >= 1 && lFields[2] <= 31) {
+        rDay = RLCharts::daysFromCivil(lFields[0], lFields[1], lFields[2]);
+        rTime = rDay * SECONDS_PER_DAY + lFields[3] * 3600 + lFields[4] * 60 + lFields[5];
+        return true;
+    }
+    // FNV-1a over the date part
+    uint64_t lHash = 1469598103934665603ull;
+    for (const char lCh : rDate) {
+        if (lCh == ' ') {
+            break;
+        }
+        lHash = (lHash ^ (unsigned char)lCh) * 1099511628211ull;
+    }
+    rDay = (int64_t)(lHash >> 2) | UNPARSED_DAY_FLAG;
+    rTime = 0;
+    return false;
+}
+
+const char* RLCandlestickChart::dayLabel(int64_t aDay) const {
+    DayLabel &rLabel = mDayLabels[(uint64_t)aDay % DAY_LABEL_CACHE];
+    if (rLabel.mDay != aDay) {
+        // civil_from_days
+        const int64_t lZ = aDay + 719468;
+        const int64_t lEra = (lZ >= 0 ? lZ : lZ - 146096) / 146097;
+        const int64_t lDoe = lZ - lEra * 146097;
+        const int64_t lYoe = (lDoe - lDoe / 1460 + lDoe / 36524 - lDoe / 146096) / 365;
+        const int64_t lDoy = lDoe - (365 * lYoe + lYoe / 4 - lYoe / 100);
+        const int64_t lMp = (5 * lDoy + 2) / 153;
+        const int lDayOfMonth = (int)(lDoy - (153 * lMp + 2) / 5 + 1);
+        const int lMonth = (int)(lMp < 10 ? lMp + 3 : lMp - 9);
+        snprintf(rLabel.mText, sizeof(rLabel.mText), "%02d-%02d", lMonth, lDayOfMonth);
+        rLabel.mDay = aDay;
     }
-    return aDate.substr(0, lPos);
+    return rLabel.mText;
 }
 
 void RLCandlestickChart::addSample(const CandleInput &rSample) {
-    std::string lIncomingDay = dayKeyFromDate(rSample.aDate);
-    if (mHasWorking && lIncomingDay != mWorking.mDayKey) {
+    int64_t lDay = 0;
+    int64_t lTime = 0;
+    parseDate(rSample.aDate, lDay, lTime);
+    ingest(rSample.aOpen, rSample.aHigh, rSample.aLow, rSample.aClose, rSample.aVolume, lTime, lDay);
+}
+
+void RLCandlestickChart::addSample(const CandleSample &rSample) {
+    const int64_t lLocal = rSample.aTime + mDayBoundaryOffset;
+    // Floor division so times before 1970 land on the right day
+    const int64_t lDay = (lLocal >= 0 ? lLocal : lLocal - (SECONDS_PER_DAY - 1)) / SECONDS_PER_DAY;
+    ingest(rSample.aOpen, rSample.aHigh, rSample.aLow, rSample.aClose, rSample.aVolume, lLocal, lDay);
+}
+
+RLCandlestickChart::Producer RLCandlestickChart::createProducer(size_t aCapacity) {
+    mProducers.push_back(std::make_unique<RLCharts::SpscRing<CandleSample>>(aCapacity > 0 ? aCapacity : 1));
+    return Producer{mProducers.back().get()};
+}
+
+bool RLCandlestickChart::Producer::push(const CandleSample &rSample) {
+    return mpQueue != nullptr && mpQueue->push(rSample);
+}
+
+size_t RLCandlestickChart::Producer::push(const CandleSample *pSamples, size_t aCount) {
+    if (mpQueue == nullptr || pSamples == nullptr) {
+        return 0;
+    }
+    return mpQueue->push(pSamples, aCount);
+}
+
+void RLCandlestickChart::drainProducers() {
+    for (auto &rpQueue : mProducers) {
+        rpQueue->consume([&](const CandleSample *pSamples, size_t aCount) {
+            for (size_t i = 0; i < aCount; ++i) {
+                addSample(pSamples[i]);
+            }
+        });
+    }
+}
+
+void RLCandlestickChart::ingest(float aOpen, float aHigh, float aLow, float aClose, float aVolume, int64_t aTime, int64_t aDay) {
+    mRedrawPending = true;
+    if (mHistoryEnabled) {
+        const bool lNewDay = mHistoryDays.empty() || mHistoryDays.back() != aDay;
+        if (lNewDay) {
+            mHistoryDays.push_back(aDay);
+        }
+        mHistory.add(aOpen, aHigh, aLow, aClose, aVolume, lNewDay);
+    }
+    if (mHasWorking && aDay != mWorking.mDay) {
         // Day changed: finalize the current candle early to align separator exactly at boundary
         finalizeWorkingCandle();
     }
@@ -46,45 +184,109 @@ void RLCandlestickChart::addSample(const CandleInput &rSample) {
         if (mValuesPerCandle == 1 && mHasLastClose) {
             mWorking.mOpen = mLastClose;
         } else {
-            mWorking.mOpen = rSample.aOpen;
+            mWorking.mOpen = aOpen;
         }
-        mWorking.mHigh = rSample.aHigh;
-        mWorking.mLow = rSample.aLow;
-        mWorking.mClose = rSample.aClose;
-        mWorking.mVolume = rSample.aVolume;
-        mWorking.mDate = rSample.aDate;
-        mWorking.mDayKey = lIncomingDay;
+        mWorking.mHigh = aHigh;
+        mWorking.mLow = aLow;
+        mWorking.mClose = aClose;
+        mWorking.mVolume = aVolume;
+        mWorking.mTime = aTime;
+        mWorking.mDay = aDay;
         mWorking.mDaySeparator = false; // the finalized candle will decide
         mWorkingCount = 1;
         mHasWorking = true;
     } else {
         // aggregate
-        if (rSample.aHigh > mWorking.mHigh) {
-            mWorking.mHigh = rSample.aHigh;
+        if (aHigh > mWorking.mHigh) {
+            mWorking.mHigh = aHigh;
         }
-        if (rSample.aLow < mWorking.mLow) {
-            mWorking.mLow = rSample.aLow;
+        if (aLow < mWorking.mLow) {
+            mWorking.mLow = aLow;
         }
-        mWorking.mClose = rSample.aClose;
-        mWorking.mVolume += rSample.aVolume;
-        mWorking.mDate = rSample.aDate; // keep the last timestamp
+        mWorking.mClose = aClose;
+        mWorking.mVolume += aVolume;
+        mWorking.mTime = aTime; // keep the last timestamp
         mWorkingCount += 1;
     }
+    prepareCandle(mWorking);
 
-    if (mWorkingCount >= mValuesPerCandle) {
+    // Daily candles only close on the day change above
+    if (!mDaily && mWorkingCount >= mValuesPerCandle) {
         finalizeWorkingCandle();
     }
 }
 
+RLCandlestickChart::CandleDyn RLCandlestickChart::candleFromBar(const RLCharts::OhlcBar &rBar) const {
+    CandleDyn lCandle;
+    lCandle.mOpen = rBar.mOpen;
+    lCandle.mHigh = rBar.mHigh;
+    lCandle.mLow = rBar.mLow;
+    lCandle.mClose = rBar.mClose;
+    lCandle.mVolume = rBar.mVolume;
+    lCandle.mDay = mHistoryDays[rBar.mDay];
+    prepareCandle(lCandle);
+    return lCandle;
+}
+
+void RLCandlestickChart::rebuildFromHistory() {
+    RLCHARTS_PERF_REBUILD(mPerf, "RLCandlestickChart::rebuildFromHistory");
+    const uint32_t lPerBar = mDaily ? 0 : (uint32_t)mValuesPerCandle;
+    // The window, the working candle and one bar before the window (separator, open)
+    mHistoryScratch.clear();
+    mHistory.collect(lPerBar, (size_t)mVisibleCandles + 2, mHistoryScratch);
+
+    mCandles.clear();
+    mFrontSlot = 0;
+    mBatchValid = false;
+    mPriceExtrema.clear();
+    mVolumeExtrema.clear();
+    mHasWorking = false;
+    mWorkingCount = 0;
+    mHasIncoming = false;
+    mIsSliding = false;
+    mSlideProgress = 0.0f;
+    mHasLastClose = false;
+    mRedrawPending = true;
+    if (mHistoryScratch.empty()) {
+        return;
+    }
+
+    // Single-value candles open at the previous close, as addSample does
+    if (lPerBar == 1) {
+        for (size_t i = mHistoryScratch.size() - 1; i > 0; --i) {
+            mHistoryScratch[i].mOpen = mHistoryScratch[i - 1].mClose;
+        }
+    }
+
+    // The newest bar is still aggregating unless it reached its sample count
+    const RLCharts::OhlcBar &rNewest = mHistoryScratch.back();
+    const bool lWorking = mDaily || rNewest.mCount < lPerBar;
+    const size_t lFinalEnd = mHistoryScratch.size() - (lWorking ? 1 : 0);
+    const size_t lFinalStart = lFinalEnd > (size_t)mVisibleCandles ? lFinalEnd - (size_t)mVisibleCandles : 0;
+    for (size_t i = lFinalStart; i < lFinalEnd; ++i) {
+        CandleDyn lCandle = candleFromBar(mHistoryScratch[i]);
+        lCandle.mDaySeparator = (i == 0) || mHistoryScratch[i].mDay != mHistoryScratch[i - 1].mDay;
+        pushCandle(lCandle);
+    }
+    if (lFinalEnd > 0) {
+        mLastClose = mHistoryScratch[lFinalEnd - 1].mClose;
+        mHasLastClose = true;
+    }
+    if (lWorking) {
+        mWorking = candleFromBar(rNewest);
+        mWorkingCount = (int)rNewest.mCount;
+        mHasWorking = true;
+    }
+}
+
 void RLCandlestickChart::finalizeWorkingCandle() {
     // Determine if day changed compared to the last finalized candle
     bool lNewDay = false;
-    std::string lKey = mWorking.mDayKey;
     if (mCandles.empty()) {
         lNewDay = true;
     } else {
         const CandleDyn &lLast = mCandles.back();
-        lNewDay = (lLast.mDayKey != lKey);
+        lNewDay = (lLast.mDay != mWorking.mDay);
     }
     CandleDyn lFinal = mWorking;
     lFinal.mDaySeparator = lNewDay;
@@ -93,6 +295,10 @@ void RLCandlestickChart::finalizeWorkingCandle() {
     mLastClose = mWorking.mClose;
     mHasLastClose = true;
 
+    // A candle still waiting for its slide (several finalized in one frame, e.g.
+    // a drained producer queue) is placed now rather than overwritten
+    placeIncoming();
+
     // Trigger slide for every new candle to ensure a smooth "scroll left"
     mIncoming = lFinal;
     mHasIncoming = true;
@@ -112,13 +318,59 @@ void RLCandlestickChart::ensureWindow() {
         // If sliding, pop when the slide finishes in update.
         // If not sliding (e.g., init), just drop oldest.
         if (!mIsSliding) {
-            mCandles.pop_front();
+            popCandle();
         } else {
             break;
         }
     }
 }
 
+void RLCandlestickChart::prepareCandle(CandleDyn &rCandle) {
+    rCandle.mUp = rCandle.mClose >= rCandle.mOpen;
+    rCandle.mBodyTop = rCandle.mUp ? rCandle.mClose : rCandle.mOpen;
+    rCandle.mBodyBottom = rCandle.mUp ? rCandle.mOpen : rCandle.mClose;
+}
+
+// Append the candle waiting for its slide and drop the oldest beyond the window
+void RLCandlestickChart::placeIncoming() {
+    if (mHasIncoming) {
+        pushCandle(mIncoming);
+        mHasIncoming = false;
+    }
+    while ((int)mCandles.size() > mVisibleCandles) {
+        popCandle();
+    }
+}
+
+// All mCandles changes go through pushCandle/popCandle so the extrema stay in step
+void RLCandlestickChart::pushCandle(const CandleDyn &rCandle) {
+    mCandles.push_back(rCandle);
+    if (mBatchValid) {
+        appendCandleGeometry(rCandle, mFrontSlot + (uint32_t)mCandles.size() - 1, mBatchBodyWidth, mBatchPrice, mBatchVolume);
+    }
+    mPriceExtrema.push(rCandle.mLow, mStyle.mIncludeWicksInScale ? rCandle.mHigh : rCandle.mBodyTop);
+    mVolumeExtrema.push(rCandle.mVolume);
+}
+
+void RLCandlestickChart::popCandle() {
+    mCandles.pop_front();
+    mFrontSlot++;
+    if (mBatchValid) {
+        mBatchHead++;
+    }
+    mPriceExtrema.popFront();
+    mVolumeExtrema.popFront();
+}
+
+void RLCandlestickChart::rebuildExtrema() {
+    mPriceExtrema.clear();
+    mVolumeExtrema.clear();
+    for (const CandleDyn &rCandle : mCandles) {
+        mPriceExtrema.push(rCandle.mLow, mStyle.mIncludeWicksInScale ? rCandle.mHigh : rCandle.mBodyTop);
+        mVolumeExtrema.push(rCandle.mVolume);
+    }
+}
+
 Rectangle RLCandlestickChart::priceArea() const {
     float lPad = mStyle.mPadding;
     float lVolumeH = mBounds.height * mStyle.mVolumeAreaRatio;
@@ -135,14 +387,11 @@ Rectangle RLCandlestickChart::volumeArea() const {
 
 float RLCandlestickChart::extractPriceMax() const {
     float lMax = mStyle.mAutoScale ? 0.0f : mStyle.lMaxPrice;
-    for (const auto &lC : mCandles) {
-        float lVal = mStyle.mIncludeWicksInScale ? lC.mHigh : (lC.mOpen > lC.mClose ? lC.mOpen : lC.mClose);
-        if (lVal > lMax) {
-            lMax = lVal;
-        }
+    if (!mPriceExtrema.empty() && mPriceExtrema.getMax() > lMax) {
+        lMax = mPriceExtrema.getMax();
     }
     if (mHasWorking) {
-        float lVal = mStyle.mIncludeWicksInScale ? mWorking.mHigh : (mWorking.mOpen > mWorking.mClose ? mWorking.mOpen : mWorking.mClose);
+        float lVal = mStyle.mIncludeWicksInScale ? mWorking.mHigh : mWorking.mBodyTop;
         if (lVal > lMax) {
             lMax = lVal;
         }
@@ -153,27 +402,50 @@ float RLCandlestickChart::extractPriceMax() const {
     return lMax;
 }
 
+// Min visible low for better framing
+float RLCandlestickChart::extractPriceMin() const {
+    float lMin = mPriceExtrema.empty() ? 1e30f : mPriceExtrema.getMin();
+    if (mHasWorking && mWorking.mLow < lMin) {
+        lMin = mWorking.mLow;
+    }
+    if (lMin == 1e30f) {
+        lMin = 0.0f;
+    }
+    return lMin;
+}
+
+bool RLCandlestickChart::isSettled() const {
+    if (mIsSliding) {
+        return false;
+    }
+    for (const auto &rpQueue : mProducers) {
+        if (!rpQueue->empty()) {
+            return false;
+        }
+    }
+    if (!mStyle.mAutoScale) {
+        return true;
+    }
+    const float lMin = extractPriceMin();
+    const float lMax = extractPriceMax();
+    return mScaleMin == lMin && (RLCharts::nearlyEqual(mScaleMax, lMax) || (lMax <= lMin && mScaleMax == lMin + 1.0f));
+}
+
 void RLCandlestickChart::update(float aDt) {
+    RLCHARTS_PERF_UPDATE(mPerf, "RLCandlestickChart::update");
+    drainProducers();
+    if (isSettled()) {
+        return;
+    }
+    mRedrawPending = true;
+
     // Update scaling
     if (mStyle.mAutoScale) {
         float lTarget = extractPriceMax();
         mScaleTargetMax = lTarget;
         const float lT = RLCharts::clamp01(mStyle.mFadeSpeed * aDt);
-        mScaleMax = RLCharts::lerpF(mScaleMax, mScaleTargetMax, lT);
-        // Compute min as min visible low for better framing
-        float lMin = 1e30f;
-        for (const auto &lCandle : mCandles) {
-            if (lCandle.mLow < lMin) {
-                lMin = lCandle.mLow;
-            }
-        }
-        if (mHasWorking && mWorking.mLow < lMin) {
-            lMin = mWorking.mLow;
-        }
-        if (lMin == 1e30f) {
-            lMin = 0.0f;
-        }
-        mScaleMin = lMin;
+        mScaleMax = RLCharts::approach(mScaleMax, mScaleTargetMax, lT);
+        mScaleMin = extractPriceMin();
         if (mScaleMax <= mScaleMin) {
             mScaleMax = mScaleMin + 1.0f;
         }
@@ -187,19 +459,14 @@ void RLCandlestickChart::update(float aDt) {
             mSlideProgress = 1.0f;
             mIsSliding = false;
             // Append the incoming candle now that slide finished
-            if (mHasIncoming) {
-                mCandles.push_back(mIncoming);
-                mHasIncoming = false;
-            }
-            // Remove oldest if window exceeded
-            while ((int)mCandles.size() > mVisibleCandles) {
-                mCandles.pop_front();
-            }
+            placeIncoming();
         }
     }
 }
 
 void RLCandlestickChart::draw() const {
+    RLCHARTS_PERF_DRAW(mPerf, "RLCandlestickChart::draw");
+    mRedrawPending = false;
     // Background
     DrawRectangleRec(mBounds, mStyle.mBackground);
 
@@ -235,10 +502,8 @@ void RLCandlestickChart::draw() const {
 
     // Calculate Max Volume for scaling
     float lMaxVol = 1.0f;
-    for (const auto& lC : mCandles) {
-        if (lC.mVolume > lMaxVol) {
-            lMaxVol = lC.mVolume;
-        }
+    if (!mVolumeExtrema.empty() && mVolumeExtrema.getMax() > lMaxVol) {
+        lMaxVol = mVolumeExtrema.getMax();
     }
     if (mHasWorking && mWorking.mVolume > lMaxVol) {
         lMaxVol = mWorking.mVolume;
@@ -247,115 +512,215 @@ void RLCandlestickChart::draw() const {
         lMaxVol = mIncoming.mVolume;
     }
 
-    // Helper to draw a single candle at absolute X
-    auto drawSingleCandle = [&](const CandleDyn& aC, float aX) {
-        if (aX + lBodyWidth < lPriceR.x - 2.0f) {
-            return;
-        }
-        if (aX > lPriceR.x + lPriceR.width + 2.0f) {
-            return;
-        }
+    // --- RENDER LOGIC ---
+    // Slots are anchored to the right edge: slot 0 holds the working candle, slot
+    // -1 the newest finalized one (or the incoming one while sliding), and so on.
+    // While sliding, everything moves left by SlideProgress * Unit; that is applied
+    // once as a translation instead of being added to every candle's X.
+    const float lRightEdge = lPriceR.x + lPriceR.width;
+    const float lSlot0X = lRightEdge - lBodyWidth;
+    const float lSlideOffset = mIsSliding ? -mSlideProgress * lUnit : 0.0f;
+
+    // Candles are placed in untranslated slot coordinates; cull against the shifted view
+    const float lViewLeft = lPriceR.x - 2.0f - lSlideOffset;
+    const float lViewRight = lPriceR.x + lPriceR.width + 2.0f - lSlideOffset;
+
+    // Finalized candles from slot -1 leftwards; only the ones inside the view are visited
+    const int lCount = (int)mCandles.size();
+    const float lNewestX = lSlot0X - lUnit;
+    int lFirst = 0;
+    if (lNewestX + lBodyWidth < lViewLeft) {
+        lFirst = lCount;
+    } else {
+        const int lFitting = (int)std::floor((lNewestX + lBodyWidth - lViewLeft) / lUnit) + 1;
+        lFirst = lCount > lFitting ? lCount - lFitting : 0;
+    }
 
-        bool lUp = aC.mClose >= aC.mOpen;
-        Color lBodyColor = lUp ? mStyle.mUpBody : mStyle.mDownBody;
-        Color lWickColor = lUp ? mStyle.mUpWick : mStyle.mDownWick;
+    if (mStyle.mBatchGeometry) {
+        drawBatched(lPriceR, lVolR, lBodyWidth, lUnit, lMaxVol, lNewestX + lSlideOffset, lFirst);
+        return;
+    }
 
-        // Apply full opacity for all candles (working and finalized)
-        unsigned char lA = 255;
+    // All candles are drawn at full opacity
+    auto opaque = [](Color aColor) {
+        aColor.a = 255;
+        return aColor;
+    };
+    const Color lUpBody = opaque(mStyle.mUpBody);
+    const Color lDownBody = opaque(mStyle.mDownBody);
+    const Color lUpWick = opaque(mStyle.mUpWick);
+    const Color lDownWick = opaque(mStyle.mDownWick);
+    const Color lSeparator = opaque(mStyle.mSeparator);
+    const Color lVolumeUp = opaque(mStyle.mVolumeUp);
+    const Color lVolumeDown = opaque(mStyle.mVolumeDown);
 
-        lBodyColor.a = lA;
-        lWickColor.a = lA;
+    auto drawSingleCandle = [&](const CandleDyn& aC, float aX) {
+        const Color lBodyColor = aC.mUp ? lUpBody : lDownBody;
+        const Color lWickColor = aC.mUp ? lUpWick : lDownWick;
 
         // Wick
-        float lYH = priceToY(aC.mHigh);
-        float lYL = priceToY(aC.mLow);
-        DrawLineEx({ aX + lBodyWidth*0.5f, lYH }, { aX + lBodyWidth*0.5f, lYL }, mStyle.mWickThickness, lWickColor);
+        const float lWickX = aX + lBodyWidth * 0.5f;
+        DrawLineEx({ lWickX, priceToY(aC.mHigh) }, { lWickX, priceToY(aC.mLow) }, mStyle.mWickThickness, lWickColor);
 
         // Body
-        float lYO = priceToY(aC.mOpen);
-        float lYC = priceToY(aC.mClose);
-        float lYTop = lYO < lYC ? lYO : lYC;
-        float lH = std::fabs(lYC - lYO);
+        float lYTop = priceToY(aC.mBodyTop);
+        float lH = priceToY(aC.mBodyBottom) - lYTop;
         if (lH < 1.0f) {
             lH = 1.0f;
             lYTop -= 0.5f;
         }
-        Rectangle lBody{ aX, lYTop, lBodyWidth, lH };
-        DrawRectangleRec(lBody, lBodyColor);
+        DrawRectangleRec(Rectangle{ aX, lYTop, lBodyWidth, lH }, lBodyColor);
 
         // Day separator
         if (aC.mDaySeparator) {
-            Color lSep = mStyle.mSeparator;
-            lSep.a = lA;
-            DrawLineV({ aX - lSpacing*0.5f, lPriceR.y }, { aX - lSpacing*0.5f, lPriceR.y + lPriceR.height }, lSep);
+            DrawLineV({ aX - lSpacing*0.5f, lPriceR.y }, { aX - lSpacing*0.5f, lPriceR.y + lPriceR.height }, lSeparator);
+            if (mStyle.mShowDayLabels && aC.mDay < UNPARSED_DAY_FLAG) {
+                DrawText(dayLabel(aC.mDay), (int)(aX + 2.0f), (int)(lPriceR.y + 2.0f), mStyle.mDayLabelFontSize, mStyle.mDayLabelColor);
+            }
         }
 
         // Volume
-        float lVN = aC.mVolume / lMaxVol;
-        float lVH = lVolR.height * RLCharts::clamp01(lVN);
-        float lVY = lVolR.y + lVolR.height - lVH;
-        Color lVolColor = lUp ? mStyle.mVolumeUp : mStyle.mVolumeDown;
-        lVolColor.a = lA;
-        DrawRectangle((int)aX, (int)lVY, (int)lBodyWidth, (int)lVH, lVolColor);
+        const float lVH = lVolR.height * RLCharts::clamp01(aC.mVolume / lMaxVol);
+        const float lVY = lVolR.y + lVolR.height - lVH;
+        DrawRectangle((int)aX, (int)lVY, (int)lBodyWidth, (int)lVH, aC.mUp ? lVolumeUp : lVolumeDown);
+    };
+    auto drawIfVisible = [&](const CandleDyn& aC, float aX) {
+        if (aX + lBodyWidth >= lViewLeft && aX <= lViewRight) {
+            drawSingleCandle(aC, aX);
+        }
     };
 
-    // --- RENDER LOGIC ---
-    // We anchor the coordinate system to the Right Edge.
-    // The "Rightmost Slot" (Slot 0) is reserved for the Working candle.
-    // The "Next Slot" (Slot -1) is for the last Finalized candle (or Incoming).
-    // All items slide left by (SlideProgress * Unit) when sliding.
-
-    float lRightEdge = lPriceR.x + lPriceR.width;
-    float lSlot0_X = lRightEdge - lBodyWidth; // Base X for the Working Slot
-
-    // Global render offset due to sliding
-    float lSlideOffset = 0.0f;
     if (mIsSliding) {
-        lSlideOffset = -mSlideProgress * lUnit;
+        rlPushMatrix();
+        rlTranslatef(lSlideOffset, 0.0f, 0.0f);
     }
 
-    // 1. Draw Working Candle (if any)
-    // If sliding, it is entering from right (Slot +1 -> Slot 0).
-    // If not sliding, it is stable at Slot 0.
+    // 1. Working candle: at slot 0, or entering from slot +1 while sliding
     if (mHasWorking) {
-        float lWorkingX = lSlot0_X;
-        if (mIsSliding) {
-            // It visually moves from (Slot 0 + Unit) to (Slot 0)
-            // Combined with lSlideOffset which is (-Progress * Unit), we need logic:
-            // Target Pos = Slot 0. Start Pos = Slot +1.
-            // Pos = Slot0 + Unit * (1.0 - Progress).
-            // Let's rely on global offset:
-            // lWorkingX + lSlideOffset = (Slot0) - Slide.
-            // We want (Slot0 + Unit) - Slide.
-            lWorkingX += lUnit;
-        }
-        drawSingleCandle(mWorking, lWorkingX + lSlideOffset);
+        drawIfVisible(mWorking, mIsSliding ? lSlot0X + lUnit : lSlot0X);
     }
 
-    // 2. Draw Incoming Candle (only if sliding)
-    // It is moving from Slot 0 (Working pos) to Slot -1 (Finalized pos).
-    // At Progress=0: Pos = Slot0.
-    // At Progress=1: Pos = Slot0 - Unit.
-    // Formula: Slot0 + SlideOffset matches this.
+    // 2. Incoming candle: moving from slot 0 to slot -1
     if (mIsSliding && mHasIncoming) {
-        drawSingleCandle(mIncoming, lSlot0_X + lSlideOffset);
+        drawIfVisible(mIncoming, lSlot0X);
     }
 
-    // 3. Draw History Candles (mCandles)
-    // If sliding: The newest history candle was at Slot -1, moving to Slot -2.
-    //             Start drawing at (Slot0 - Unit) + SlideOffset.
-    // If NOT sliding: The newest history candle IS at Slot -1 (stable).
-    //             Start drawing at (Slot0 - Unit).
+    // 3. Finalized candles, newest first
+    for (int i = lCount - 1; i >= lFirst; --i) {
+        drawIfVisible(mCandles[i], lNewestX - (float)(lCount - 1 - i) * lUnit);
+    }
+
+    if (mIsSliding) {
+        rlPopMatrix();
+    }
+}
+
+void RLCandlestickChart::appendCandleGeometry(const CandleDyn &rCandle, uint32_t aSlot, float aBodyWidth,
+                                              std::vector<CandleVertex> &rPrice, std::vector<CandleVertex> &rVolume) const {
+    auto opaque = [](Color aColor) {
+        aColor.a = 255;
+        return aColor;
+    };
+    // Quad corners in rlgl's counter-clockwise order: top-left, bottom-left, bottom-right, top-right
+    auto quad = [aSlot](std::vector<CandleVertex> &rOut, float aX0, float aX1, float aTop, float aBottom,
+                        float aDyTop, float aDyBottom, Color aColor) {
+        rOut.push_back({ aSlot, aX0, aTop, aDyTop, aColor });
+        rOut.push_back({ aSlot, aX0, aBottom, aDyBottom, aColor });
+        rOut.push_back({ aSlot, aX1, aBottom, aDyBottom, aColor });
+        rOut.push_back({ aSlot, aX1, aTop, aDyTop, aColor });
+    };
+    // Values beyond any scale, clamped to the area edges
+    constexpr float EDGE_VALUE = 1e30f;
+
+    const float lCenter = aBodyWidth * 0.5f;
+    const float lHalfWick = mStyle.mWickThickness * 0.5f;
+    quad(rPrice, lCenter - lHalfWick, lCenter + lHalfWick, rCandle.mHigh, rCandle.mLow, 0.0f, 0.0f,
+         opaque(rCandle.mUp ? mStyle.mUpWick : mStyle.mDownWick));
+    // Half a pixel on both ends keeps flat bodies at least 1px tall
+    quad(rPrice, 0.0f, aBodyWidth, rCandle.mBodyTop, rCandle.mBodyBottom, -0.5f, 0.5f,
+         opaque(rCandle.mUp ? mStyle.mUpBody : mStyle.mDownBody));
+    const float lSepX = -mStyle.mCandleSpacing * 0.5f;
+    const float lSepHalf = rCandle.mDaySeparator ? 0.5f : 0.0f;
+    quad(rPrice, lSepX - lSepHalf, lSepX + lSepHalf, EDGE_VALUE, -EDGE_VALUE, 0.0f, 0.0f, opaque(mStyle.mSeparator));
+
+    quad(rVolume, 0.0f, aBodyWidth, rCandle.mVolume, 0.0f, 0.0f, 0.0f,
+         opaque(rCandle.mUp ? mStyle.mVolumeUp : mStyle.mVolumeDown));
+}
+
+void RLCandlestickChart::drawBatched(Rectangle aPriceR, Rectangle aVolR, float aBodyWidth, float aUnit, float aMaxVol,
+                                     float aNewestX, int aFirst) const {
+    if (!mBatchValid || mBatchBodyWidth != aBodyWidth) {
+        RLCHARTS_PERF_REBUILD(mPerf, "RLCandlestickChart::rebuildBatch");
+        mBatchPrice.clear();
+        mBatchVolume.clear();
+        mBatchHead = 0;
+        mBatchBodyWidth = aBodyWidth;
+        mBatchValid = true;
+        for (size_t i = 0; i < mCandles.size(); ++i) {
+            appendCandleGeometry(mCandles[i], mFrontSlot + (uint32_t)i, aBodyWidth, mBatchPrice, mBatchVolume);
+        }
+    } else if (mBatchHead > 0 && mBatchHead * 2 >= mCandles.size()) {
+        // Drop popped candles once they outnumber the half of the buffer still in use
+        mBatchPrice.erase(mBatchPrice.begin(), mBatchPrice.begin() + (std::ptrdiff_t)(mBatchHead * CANDLE_PRICE_VERTICES));
+        mBatchVolume.erase(mBatchVolume.begin(), mBatchVolume.begin() + (std::ptrdiff_t)(mBatchHead * CANDLE_VOLUME_VERTICES));
+        mBatchHead = 0;
+    }
 
-    float lHistoryStartX = lSlot0_X - lUnit + lSlideOffset;
+    const uint32_t lNewestSlot = mFrontSlot + (uint32_t)mCandles.size() - 1;
+    mBatchLivePrice.clear();
+    mBatchLiveVolume.clear();
+    if (mIsSliding && mHasIncoming) {
+        appendCandleGeometry(mIncoming, lNewestSlot + 1, aBodyWidth, mBatchLivePrice, mBatchLiveVolume);
+    }
+    if (mHasWorking) {
+        appendCandleGeometry(mWorking, lNewestSlot + (mIsSliding ? 2 : 1), aBodyWidth, mBatchLivePrice, mBatchLiveVolume);
+    }
 
-    // Iterate backwards so we draw from right to left
-    int lCount = (int)mCandles.size();
-    for (int i = lCount - 1; i >= 0; --i) {
-        // Calculate offset from the newest history candle
-        int lDist = (lCount - 1) - i; // 0 for newest
-        float lX = lHistoryStartX - ((float)lDist * lUnit);
+    float lPriceRange = (mScaleMax - mScaleMin);
+    if (lPriceRange <= 0.0001f) {
+        lPriceRange = 1.0f;
+    }
+    // y = value * scale + offset, clamped to the area
+    const float lPriceScale = -aPriceR.height / lPriceRange;
+    const float lPriceOffset = aPriceR.y + aPriceR.height + mScaleMin * aPriceR.height / lPriceRange;
+    const float lVolScale = -aVolR.height / aMaxVol;
+    const float lVolOffset = aVolR.y + aVolR.height;
+
+    auto submit = [&](const CandleVertex *pVertices, size_t aCount, float aScale, float aOffset, float aTop, float aBottom) {
+        // Whole quads per chunk, well inside rlgl's default vertex batch
+        constexpr size_t CHUNK_VERTICES = 4 * 1024;
+        for (size_t lStart = 0; lStart < aCount; lStart += CHUNK_VERTICES) {
+            const size_t lEnd = RLCharts::minVal(aCount, lStart + CHUNK_VERTICES);
+            rlCheckRenderBatchLimit((int)(lEnd - lStart));
+            rlBegin(RL_QUADS);
+            for (size_t i = lStart; i < lEnd; ++i) {
+                const CandleVertex &rV = pVertices[i];
+                const float lX = aNewestX + (float)(int32_t)(rV.mSlot - lNewestSlot) * aUnit + rV.mDx;
+                const float lY = RLCharts::clamp(rV.mValue * aScale + aOffset, aTop, aBottom) + rV.mDy;
+                rlColor4ub(rV.mColor.r, rV.mColor.g, rV.mColor.b, rV.mColor.a);
+                rlVertex2f(lX, lY);
+            }
+            rlEnd();
+        }
+    };
 
-        drawSingleCandle(mCandles[i], lX);
+    const size_t lFirst = mBatchHead + (size_t)aFirst;
+    const size_t lVisible = mCandles.size() - (size_t)aFirst;
+    const float lPriceBottom = aPriceR.y + aPriceR.height;
+    submit(mBatchPrice.data() + lFirst * CANDLE_PRICE_VERTICES, lVisible * CANDLE_PRICE_VERTICES,
+           lPriceScale, lPriceOffset, aPriceR.y, lPriceBottom);
+    submit(mBatchLivePrice.data(), mBatchLivePrice.size(), lPriceScale, lPriceOffset, aPriceR.y, lPriceBottom);
+    submit(mBatchVolume.data() + lFirst * CANDLE_VOLUME_VERTICES, lVisible * CANDLE_VOLUME_VERTICES,
+           lVolScale, lVolOffset, aVolR.y, aVolR.y + aVolR.height);
+    submit(mBatchLiveVolume.data(), mBatchLiveVolume.size(), lVolScale, lVolOffset, aVolR.y, aVolR.y + aVolR.height);
+
+    if (mStyle.mShowDayLabels) {
+        for (size_t i = (size_t)aFirst; i < mCandles.size(); ++i) {
+            const CandleDyn &rC = mCandles[i];
+            if (rC.mDaySeparator && rC.mDay < UNPARSED_DAY_FLAG) {
+                const float lX = aNewestX - (float)(mCandles.size() - 1 - i) * aUnit;
+                DrawText(dayLabel(rC.mDay), (int)(lX + 2.0f), (int)(aPriceR.y + 2.0f), mStyle.mDayLabelFontSize, mStyle.mDayLabelColor);
+            }
+        }
     }
-}
\ No newline at end of file
+}
@@ -2,7 +2,14 @@
 #pragma once
 
 #include "raylib.h"
+#include "RLPerf.h"
+#include "RLOhlcPyramid.h"
+#include "RLSlidingExtrema.h"
+#include "RLSpscRing.h"
+#include <cstddef>
+#include <cstdint>
 #include <deque>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -35,6 +42,16 @@ struct RLCandleStyle {
     float lMinPrice = 0.0f;
     float lMaxPrice = 1.0f;
     bool mIncludeWicksInScale = true;
+
+    // Batched geometry: finalized candles are kept as quads in a persistent vertex
+    // buffer (price/volume space, so rescaling does not rebuild it) and submitted in
+    // one RL_QUADS block instead of several shape calls per candle
+    bool mBatchGeometry = false;
+
+    // Day labels at the separators (formatted once per day and cached)
+    bool mShowDayLabels = false;
+    int mDayLabelFontSize = 10;
+    Color mDayLabelColor{200, 200, 200, 160};
 };
 
 class RLCandlestickChart {
@@ -48,6 +65,36 @@ public:
         std::string aDate; // e.g. 2024-01-15 09:35:00
     };
 
+    // Allocation-free input: timestamp in seconds since the Unix epoch (UTC).
+    // Day boundaries are derived arithmetically, see setDayBoundaryOffset().
+    struct CandleSample {
+        float aOpen{0.0f};
+        float aHigh{0.0f};
+        float aLow{0.0f};
+        float aClose{0.0f};
+        float aVolume{0.0f};
+        int64_t aTime{0};
+    };
+
+    // Producer handle for feeding samples from another thread. Backed by a
+    // lock-free single-producer/single-consumer ring that update() drains through
+    // addSample(). Only one thread may push through a given producer. Handles
+    // stay valid for the lifetime of the chart.
+    class Producer {
+    public:
+        Producer() = default;
+        // Returns false if the queue is full (sample dropped)
+        bool push(const CandleSample &rSample);
+        // Returns the number of samples queued (less than aCount if the queue filled up)
+        size_t push(const CandleSample *pSamples, size_t aCount);
+        [[nodiscard]] bool isValid() const { return mpQueue != nullptr; }
+
+    private:
+        friend class RLCandlestickChart;
+        explicit Producer(RLCharts::SpscRing<CandleSample> *pQueue) : mpQueue(pQueue) {}
+        RLCharts::SpscRing<CandleSample> *mpQueue{nullptr};
+    };
+
     RLCandlestickChart(Rectangle bounds, int valuesPerCandle, int visibleCandles, const RLCandleStyle &style = {});
 
     void setBounds(Rectangle aBounds);
@@ -56,14 +103,40 @@ public:
     void setStyle(const RLCandleStyle &rStyle);
     void setExplicitScale(float aMinPrice, float aMaxPrice);
 
+    // Keep an aggregation pyramid of every sample (RLOhlcPyramid.h): setValuesPerCandle(),
+    // setVisibleCandles() and setDailyCandles() then rebuild the window from history in
+    // O(visible candles) instead of starting over. Enabling clears any previous history.
+    void setHistoryEnabled(bool aEnabled);
+    // One candle per trading day; setValuesPerCandle() switches back to sample counts
+    void setDailyCandles(bool aDaily);
+
     // Stream a single OHLCV sample. After mValuesPerCandle samples the current candle is finalized
     void addSample(const CandleInput &rSample);
+    void addSample(const CandleSample &rSample);
+    // Seconds added to CandleSample::aTime before splitting into days, i.e. the exchange's
+    // UTC offset (e.g. -5 * 3600 for New York winter time). String dates are already local.
+    void setDayBoundaryOffset(int aSeconds);
+    // Create a cross-thread producer (call from the render thread)
+    Producer createProducer(size_t aCapacity = 8192);
 
     // Update time-based animations
     void update(float aDt);
     // Draw chart
     void draw() const;
 
+    // Settled when no slide is running, every producer queue is empty and the auto
+    // scale has caught up with the data
+    [[nodiscard]] bool isSettled() const;
+    [[nodiscard]] bool needsRedraw() const { return mRedrawPending || !isSettled(); }
+    // update()/rebuild/draw() timers and GPU counters (RLPerf.h); zero unless built with RLCHARTS_PERF
+    [[nodiscard]] const RLCharts::PerfStats& getPerfStats() const { return mPerf; }
+
+    [[nodiscard]] const RLCharts::OhlcPyramid& getHistory() const { return mHistory; }
+    [[nodiscard]] bool isHistoryEnabled() const { return mHistoryEnabled; }
+    [[nodiscard]] bool isDailyCandles() const { return mDaily; }
+    // Finalized candles in the window (excludes the one still aggregating)
+    [[nodiscard]] size_t getCandleCount() const { return mCandles.size(); }
+
 private:
     struct CandleDyn {
         // Aggregated data
@@ -72,10 +145,37 @@ private:
         float mLow{0.0f};
         float mClose{0.0f};
         float mVolume{0.0f};
-        std::string mDate;      // full date-time string
-        std::string mDayKey;    // yyyy-mm-dd
+        int64_t mTime{0};       // last sample, local seconds since the epoch
+        int64_t mDay{0};        // local day number (days since 1970-01-01)
         bool mDaySeparator{false};
+        // Derived once per candle (prepareCandle)
+        float mBodyTop{0.0f};   // max(open, close)
+        float mBodyBottom{0.0f}; // min(open, close)
+        bool mUp{true};
+    };
+
+    // Batched geometry vertex: x = slot position + mDx pixels, y = the price (or
+    // volume) mValue mapped through the current scale, then offset by mDy pixels
+    struct CandleVertex {
+        uint32_t mSlot{0};
+        float mDx{0.0f};
+        float mValue{0.0f};
+        float mDy{0.0f};
+        Color mColor{};
     };
+    // Wick, body and separator quads (an invisible separator keeps the stride fixed)
+    static constexpr size_t CANDLE_PRICE_VERTICES = 12;
+    static constexpr size_t CANDLE_VOLUME_VERTICES = 4;
+
+    // Formatted day label, cached per day number
+    struct DayLabel {
+        int64_t mDay{INT64_MIN};
+        char mText[12]{};
+    };
+    static constexpr size_t DAY_LABEL_CACHE = 16;
+    static constexpr int SECONDS_PER_DAY = 86400;
+    // Set on day numbers hashed from date strings that could not be parsed (no label)
+    static constexpr int64_t UNPARSED_DAY_FLAG = (int64_t)1 << 62;
 
     Rectangle mBounds{};        // total bounds (price + volume)
     RLCandleStyle mStyle{};
@@ -96,6 +196,21 @@ private:
     float mSlideProgress{0.0f}; // 0..1 of one candle width slide
     bool mIsSliding{false};
 
+    uint32_t mFrontSlot{0};         // slot number of mCandles.front()
+
+    // Batched geometry (mBatchGeometry), mirrors mCandles from mBatchHead on
+    mutable std::vector<CandleVertex> mBatchPrice;
+    mutable std::vector<CandleVertex> mBatchVolume;
+    mutable std::vector<CandleVertex> mBatchLivePrice;  // working/incoming, per frame
+    mutable std::vector<CandleVertex> mBatchLiveVolume;
+    mutable size_t mBatchHead{0};   // candles popped since the last compaction
+    mutable bool mBatchValid{false};
+    mutable float mBatchBodyWidth{0.0f};
+
+    // Window extrema of mCandles, maintained on push/pop (wick or body top / low, volume)
+    RLCharts::SlidingExtrema<float> mPriceExtrema;
+    RLCharts::SlidingExtrema<float> mVolumeExtrema;
+
     // Scaling
     float mScaleMin{0.0f};
     float mScaleMax{1.0f};
@@ -105,11 +220,42 @@ private:
     float mLastClose{0.0f};
     bool mHasLastClose{false};
 
+    // Resolution history (setHistoryEnabled)
+    bool mHistoryEnabled{false};
+    bool mDaily{false};
+    RLCharts::OhlcPyramid mHistory;
+    std::vector<int64_t> mHistoryDays;             // day number per pyramid day index
+    std::vector<RLCharts::OhlcBar> mHistoryScratch; // reused by rebuildFromHistory
+
+    mutable bool mRedrawPending{true}; // cleared by draw()
+    mutable RLCharts::PerfStats mPerf;
+
+    int mDayBoundaryOffset{0};
+    mutable DayLabel mDayLabels[DAY_LABEL_CACHE];
+
+    // Cross-thread ingest queues, drained by update()
+    std::vector<std::unique_ptr<RLCharts::SpscRing<CandleSample>>> mProducers;
+
     // Helpers
     [[nodiscard]] float extractPriceMax() const;
+    [[nodiscard]] float extractPriceMin() const;
     [[nodiscard]] Rectangle priceArea() const;
     [[nodiscard]] Rectangle volumeArea() const;
-    static std::string dayKeyFromDate(const std::string &aDate);
+    static bool parseDate(const std::string &rDate, int64_t &rDay, int64_t &rTime);
+    [[nodiscard]] const char* dayLabel(int64_t aDay) const;
+    void ingest(float aOpen, float aHigh, float aLow, float aClose, float aVolume, int64_t aTime, int64_t aDay);
     void finalizeWorkingCandle();
+    void drainProducers();
+    static void prepareCandle(CandleDyn &rCandle);
+    void placeIncoming();
+    void pushCandle(const CandleDyn &rCandle);
+    void popCandle();
+    void rebuildExtrema();
+    void appendCandleGeometry(const CandleDyn &rCandle, uint32_t aSlot, float aBodyWidth,
+                              std::vector<CandleVertex> &rPrice, std::vector<CandleVertex> &rVolume) const;
+    void drawBatched(Rectangle aPriceR, Rectangle aVolR, float aBodyWidth, float aUnit, float aMaxVol,
+                     float aNewestX, int aFirst) const;
     void ensureWindow();
+    void rebuildFromHistory();
+    [[nodiscard]] CandleDyn candleFromBar(const RLCharts::OhlcBar &rBar) const;
 };
@@ -0,0 +1,120 @@
+// RLDashboard.h
+#pragma once
+#include "RLTaskPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+// Container that updates many charts per frame on a thread pool.
+// Chart updates (layout, smoothing, colorization, mesh vertex generation) are
+// independent per chart, so update(dt) runs them as parallel tasks on an
+// RLCharts::TaskPool. Then, on the calling (render) thread, it runs every stage
+// that touches the GPU. draw() draws the charts in the order they were added.
+// Usage: add() each chart once, then per frame update(dt) and draw() between
+// BeginDrawing()/EndDrawing(). The dashboard does not own the charts.
+//
+// Each chart's update is split into a compute stage and a commit stage:
+//  - a chart with prepare(dt) and commit() (the heat map, order book, 3D heat
+//    map and scatter plot, whose uploads must stay on the GL thread) runs prepare
+//    on the pool and commit on the render thread;
+//  - any other chart's update() makes no GL calls and runs entirely on the pool.
+// Compute tasks are started most expensive first (by last frame's time), so a
+// large heat map does not end up last on a busy pool.
+//
+// Do not call chart setters from other threads while update() runs. Call
+// RLCharts::beginFrame() once per frame on the render thread, as usual; the pool's
+// workers reset their own frame arenas.
+
+class RLDashboard {
+public:
+    // aThreads counts the render thread; 0 = std::thread::hardware_concurrency()
+    explicit RLDashboard(size_t aThreads = 0) : mPool(aThreads) {}
+
+    RLDashboard(const RLDashboard&) = delete;
+    RLDashboard& operator=(const RLDashboard&) = delete;
+
+    // Add a chart drawn with its draw()
+    template<typename T>
+    void add(T& rChart) {
+        static_assert(requires(const T& rC) { rC.draw(); },
+                      "chart has no draw(); pass a draw callable, e.g. add(lOrderBook, [&] { lOrderBook.draw2D(); })");
+        add(rChart, [pChart = &rChart]() { pChart->draw(); });
+    }
+
+    // Add a chart drawn by aDraw (charts whose draw takes arguments, 3D views)
+    template<typename T, typename DrawFn>
+    void add(T& rChart, DrawFn aDraw) {
+        Entry lEntry;
+        lEntry.mpChart = &rChart;
+        if constexpr (requires(T& rC, float aDt) { rC.prepare(aDt); rC.commit(); }) {
+            lEntry.mCompute = [](void* pChart, float aDt) { static_cast<T*>(pChart)->prepare(aDt); };
+            lEntry.mCommit = [](void* pChart, float) { static_cast<T*>(pChart)->commit(); };
+        } else {
+            lEntry.mCompute = [](void* pChart, float aDt) { static_cast<T*>(pChart)->update(aDt); };
+        }
+        lEntry.mDraw = std::move(aDraw);
+        mEntries.push_back(std::move(lEntry));
+        if (mEntries.back().mCompute != nullptr) {
+            mComputeOrder.push_back(mEntries.size() - 1);
+        }
+    }
+
+    void clear() {
+        mEntries.clear();
+        mComputeOrder.clear();
+    }
+
+    // Compute stages in parallel, then commit stages in insertion order on this thread
+    void update(float aDt) {
+        const auto lStart = std::chrono::steady_clock::now();
+        std::stable_sort(mComputeOrder.begin(), mComputeOrder.end(), [this](size_t aA, size_t aB) {
+            return mEntries[aA].mComputeMs > mEntries[aB].mComputeMs;
+        });
+        mPool.parallelFor(mComputeOrder.size(), [this, aDt](size_t aTask) {
+            Entry& rEntry = mEntries[mComputeOrder[aTask]];
+            const auto lTaskStart = std::chrono::steady_clock::now();
+            rEntry.mCompute(rEntry.mpChart, aDt);
+            rEntry.mComputeMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - lTaskStart).count();
+        });
+        const auto lComputed = std::chrono::steady_clock::now();
+        for (Entry& rEntry : mEntries) {
+            if (rEntry.mCommit != nullptr) {
+                rEntry.mCommit(rEntry.mpChart, aDt);
+            }
+        }
+        const auto lEnd = std::chrono::steady_clock::now();
+        mLastComputeMs = std::chrono::duration<float, std::milli>(lComputed - lStart).count();
+        mLastCommitMs = std::chrono::duration<float, std::milli>(lEnd - lComputed).count();
+    }
+
+    void draw() const {
+        for (const Entry& rEntry : mEntries) {
+            rEntry.mDraw();
+        }
+    }
+
+    [[nodiscard]] size_t getChartCount() const { return mEntries.size(); }
+    [[nodiscard]] size_t getThreadCount() const { return mPool.getThreadCount(); }
+    [[nodiscard]] const RLCharts::TaskPool& getPool() const { return mPool; }
+    // Wall time of the last update()'s parallel compute phase and render-thread commit phase
+    [[nodiscard]] float getLastComputeMs() const { return mLastComputeMs; }
+    [[nodiscard]] float getLastCommitMs() const { return mLastCommitMs; }
+
+private:
+    struct Entry {
+        void* mpChart{ nullptr };
+        void (*mCompute)(void*, float){ nullptr }; // on the pool
+        void (*mCommit)(void*, float){ nullptr };  // on the render thread
+        std::function<void()> mDraw;
+        float mComputeMs{ 0.0f };                  // last compute time, for scheduling
+    };
+
+    RLCharts::TaskPool mPool;
+    std::vector<Entry> mEntries;
+    std::vector<size_t> mComputeOrder; // entries with a compute stage, most expensive first
+    float mLastComputeMs{ 0.0f };
+    float mLastCommitMs{ 0.0f };
+};
@@ -0,0 +1,580 @@
+// RLDataSource.cpp
+#include "RLDataSource.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+namespace RLCharts {
+
+// Wait per read() before pending records are retried
+static constexpr int READ_TIMEOUT_MS = 20;
+// Receive buffer; fits the largest UDP datagram
+static constexpr size_t RECEIVE_BUFFER_BYTES = 65536;
+// Initial batch capacity per route, so steady streaming does not reallocate
+static constexpr size_t ROUTE_RESERVE = 1024;
+
+static bool isFeedSeparator(char aChar) {
+    return aChar == ' ' || aChar == '\t' || aChar == ',';
+}
+
+static const char* skipFeedSeparators(const char* pBegin, const char* pEnd) {
+    while (pBegin < pEnd && isFeedSeparator(*pBegin)) {
+        pBegin++;
+    }
+    return pBegin;
+}
+
+// Field parsers: return the position after the value (which must end at a
+// separator or the end of the line), or nullptr
+static const char* parseFeedFloat(const char* pBegin, const char* pEnd, float& rOut) {
+    pBegin = skipFeedSeparators(pBegin, pEnd);
+#if defined(__cpp_lib_to_chars)
+    const std::from_chars_result lResult = std::from_chars(pBegin, pEnd, rOut);
+    const char* pStop = lResult.ec == std::errc() ? lResult.ptr : nullptr;
+#else
+    // Floating-point from_chars missing (older libc++): strtof on a bounded copy
+    char lBuf[64];
+    const size_t lLen = std::min((size_t)(pEnd - pBegin), sizeof(lBuf) - 1);
+    std::memcpy(lBuf, pBegin, lLen);
+    lBuf[lLen] = '\0';
+    char* lpStop = nullptr;
+    rOut = std::strtof(lBuf, &lpStop);
+    const char* pStop = lpStop == lBuf ? nullptr : pBegin + (lpStop - lBuf);
+#endif
+    return pStop != nullptr && (pStop == pEnd || isFeedSeparator(*pStop)) ? pStop : nullptr;
+}
+
+template<typename T>
+static const char* parseFeedInt(const char* pBegin, const char* pEnd, T& rOut) {
+    pBegin = skipFeedSeparators(pBegin, pEnd);
+    const std::from_chars_result lResult = std::from_chars(pBegin, pEnd, rOut);
+    if (lResult.ec != std::errc() || (lResult.ptr != pEnd && !isFeedSeparator(*lResult.ptr))) {
+        return nullptr;
+    }
+    return lResult.ptr;
+}
+
+} // namespace RLCharts
+
+// ============================================================================
+// Line protocol
+// ============================================================================
+
+RLFeedParse parseFeedLine(std::string_view aLine, RLFeedRecord& rRecord) {
+    const char* p = aLine.data();
+    const char* pEnd = p + aLine.size();
+    if (pEnd > p && pEnd[-1] == '\r') {
+        pEnd--;
+    }
+    p = RLCharts::skipFeedSeparators(p, pEnd);
+    if (p == pEnd || *p == '#') {
+        return RLFeedParse::Empty;
+    }
+
+    int lFloats = 0;
+    switch (*p) {
+        case 's': rRecord.mKind = RLFeedKind::Sample; lFloats = 1; break;
+        case 'b': rRecord.mKind = RLFeedKind::Bid; lFloats = 2; break;
+        case 'a': rRecord.mKind = RLFeedKind::Ask; lFloats = 2; break;
+        case 'c': rRecord.mKind = RLFeedKind::Commit; lFloats = 0; break;
+        case 'o': rRecord.mKind = RLFeedKind::Candle; lFloats = 5; break;
+        default: return RLFeedParse::Invalid;
+    }
+    p++;
+    if (p < pEnd && !RLCharts::isFeedSeparator(*p)) {
+        return RLFeedParse::Invalid; // tags are single letters
+    }
+
+    p = RLCharts::parseFeedInt(p, pEnd, rRecord.mChannel);
+    if (p == nullptr) {
+        return RLFeedParse::Invalid;
+    }
+    rRecord.mTime = 0;
+    if (rRecord.mKind == RLFeedKind::Candle) {
+        p = RLCharts::parseFeedInt(p, pEnd, rRecord.mTime);
+        if (p == nullptr) {
+            return RLFeedParse::Invalid;
+        }
+    }
+    for (int i = 0; i < lFloats; ++i) {
+        p = RLCharts::parseFeedFloat(p, pEnd, rRecord.mValues[i]);
+        if (p == nullptr) {
+            return RLFeedParse::Invalid;
+        }
+    }
+    return RLCharts::skipFeedSeparators(p, pEnd) == pEnd ? RLFeedParse::Record : RLFeedParse::Invalid;
+}
+
+// ============================================================================
+// RLDataSource
+// ============================================================================
+
+RLDataSource::RLDataSource(RLFeedPolicy aPolicy) : mPolicy(aPolicy) {
+    mCarry.reserve(MAX_LINE);
+}
+
+RLDataSource::~RLDataSource() {
+    stop();
+}
+
+bool RLDataSource::addSampleRoute(uint32_t aChannel, RLTimeSeries::Producer aProducer) {
+    if (isRunning() || !aProducer.isValid()) {
+        return false;
+    }
+    mSampleRoutes.push_back({aChannel, aProducer, {}});
+    mSampleRoutes.back().mPending.reserve(RLCharts::ROUTE_RESERVE);
+    return true;
+}
+
+bool RLDataSource::addBookRoute(uint32_t aChannel, RLOrderBookVis::Producer aProducer) {
+    if (isRunning() || !aProducer.isValid()) {
+        return false;
+    }
+    mBookRoutes.push_back({aChannel, aProducer, {}});
+    mBookRoutes.back().mPending.reserve(RLCharts::ROUTE_RESERVE);
+    return true;
+}
+
+bool RLDataSource::addCandleRoute(uint32_t aChannel, RLCandlestickChart::Producer aProducer) {
+    if (isRunning() || !aProducer.isValid()) {
+        return false;
+    }
+    mCandleRoutes.push_back({aChannel, aProducer, {}});
+    mCandleRoutes.back().mPending.reserve(RLCharts::ROUTE_RESERVE);
+    return true;
+}
+
+void RLDataSource::setReconnectDelay(int aMilliseconds) {
+    mReconnectDelay = std::max(aMilliseconds, 0);
+}
+
+bool RLDataSource::start() {
+    if (isRunning()) {
+        return false;
+    }
+    if (mThread.joinable()) {
+        mThread.join();
+    }
+    mStop.store(false, std::memory_order_relaxed);
+    mRunning.store(true, std::memory_order_release);
+    mThread = std::thread([this]() { run(); });
+    return true;
+}
+
+void RLDataSource::stop() {
+    mStop.store(true, std::memory_order_relaxed);
+    if (mThread.joinable()) {
+        mThread.join();
+    }
+    mRunning.store(false, std::memory_order_release);
+}
+
+void RLDataSource::feed(std::string_view aText) {
+    mCounters.mBytes.fetch_add(aText.size(), std::memory_order_relaxed);
+    consume(aText.data(), aText.size(), false);
+    flushRoutes(false);
+}
+
+void RLDataSource::flush() {
+    if (!mCarry.empty()) {
+        processLine(mCarry);
+        mCarry.clear();
+    }
+    flushRoutes(false);
+}
+
+RLFeedStats RLDataSource::getStats() const {
+    RLFeedStats lStats;
+    lStats.mBytes = mCounters.mBytes.load(std::memory_order_relaxed);
+    lStats.mRecords = mCounters.mRecords.load(std::memory_order_relaxed);
+    lStats.mInvalid = mCounters.mInvalid.load(std::memory_order_relaxed);
+    lStats.mUnrouted = mCounters.mUnrouted.load(std::memory_order_relaxed);
+    lStats.mDelivered = mCounters.mDelivered.load(std::memory_order_relaxed);
+    lStats.mDropped = mCounters.mDropped.load(std::memory_order_relaxed);
+    lStats.mCoalesced = mCounters.mCoalesced.load(std::memory_order_relaxed);
+    lStats.mReconnects = mCounters.mReconnects.load(std::memory_order_relaxed);
+    return lStats;
+}
+
+void RLDataSource::run() {
+    while (!stopRequested()) {
+        if (!open()) {
+            if (!reopens()) {
+                break;
+            }
+            mCounters.mReconnects.fetch_add(1, std::memory_order_relaxed);
+            sleepFor(mReconnectDelay);
+            continue;
+        }
+        mCarry.clear();
+        const bool lFramed = isFramed();
+        const bool lWait = !isLive();
+        for (;;) {
+            const char* pData = nullptr;
+            const long lSize = read(pData, RLCharts::READ_TIMEOUT_MS);
+            if (lSize < 0 || stopRequested()) {
+                break;
+            }
+            if (lSize > 0) {
+                mCounters.mBytes.fetch_add((uint64_t)lSize, std::memory_order_relaxed);
+                consume(pData, (size_t)lSize, lFramed);
+            }
+            // Also after a timeout, so records held back by backpressure go out
+            flushRoutes(lWait);
+        }
+        // A line cut off by a disconnect is incomplete
+        mCarry.clear();
+        close();
+        flushRoutes(lWait);
+        if (stopRequested() || !reopens()) {
+            break;
+        }
+        mCounters.mReconnects.fetch_add(1, std::memory_order_relaxed);
+        if (isLive()) {
+            sleepFor(mReconnectDelay);
+        }
+    }
+    mRunning.store(false, std::memory_order_release);
+}
+
+void RLDataSource::consume(const char* pData, size_t aSize, bool aFramed) {
+    const char* p = pData;
+    const char* pEnd = pData + aSize;
+    if (!mCarry.empty()) {
+        const char* pBreak = (const char*)std::memchr(p, '\n', (size_t)(pEnd - p));
+        if (pBreak == nullptr) {
+            mCarry.append(p, pEnd);
+            if (mCarry.size() > MAX_LINE) {
+                mCounters.mInvalid.fetch_add(1, std::memory_order_relaxed);
+                mCarry.clear();
+            }
+            return;
+        }
+        mCarry.append(p, pBreak);
+        processLine(mCarry);
+        mCarry.clear();
+        p = pBreak + 1;
+    }
+    while (p < pEnd) {
+        const char* pBreak = (const char*)std::memchr(p, '\n', (size_t)(pEnd - p));
+        if (pBreak == nullptr) {
+            if (aFramed) {
+                processLine(std::string_view(p, (size_t)(pEnd - p)));
+            } else if ((size_t)(pEnd - p) <= MAX_LINE) {
+                mCarry.assign(p, pEnd);
+            } else {
+                mCounters.mInvalid.fetch_add(1, std::memory_order_relaxed);
+            }
+            return;
+        }
+        processLine(std::string_view(p, (size_t)(pBreak - p)));
+        p = pBreak + 1;
+    }
+}
+
+void RLDataSource::processLine(std::string_view aLine) {
+    RLFeedRecord lRecord;
+    const RLFeedParse lResult = parseFeedLine(aLine, lRecord);
+    if (lResult == RLFeedParse::Empty) {
+        return;
+    }
+    if (lResult == RLFeedParse::Invalid) {
+        mCounters.mInvalid.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    mCounters.mRecords.fetch_add(1, std::memory_order_relaxed);
+
+    bool lRouted = false;
+    switch (lRecord.mKind) {
+        case RLFeedKind::Sample:
+            for (SampleRoute& rRoute : mSampleRoutes) {
+                if (rRoute.mChannel == lRecord.mChannel) {
+                    rRoute.mPending.push_back(lRecord.mValues[0]);
+                    lRouted = true;
+                }
+            }
+            break;
+        case RLFeedKind::Bid:
+        case RLFeedKind::Ask:
+        case RLFeedKind::Commit: {
+            RLOrderBookUpdate lUpdate;
+            lUpdate.mSide = lRecord.mKind == RLFeedKind::Ask ? RLOrderBookSide::Ask : RLOrderBookSide::Bid;
+            lUpdate.mPrice = lRecord.mValues[0];
+            lUpdate.mSize = lRecord.mValues[1];
+            lUpdate.mCommit = lRecord.mKind == RLFeedKind::Commit;
+            for (BookRoute& rRoute : mBookRoutes) {
+                if (rRoute.mChannel == lRecord.mChannel) {
+                    rRoute.mPending.push_back(lUpdate);
+                    lRouted = true;
+                }
+            }
+            break;
+        }
+        case RLFeedKind::Candle: {
+            RLCandlestickChart::CandleSample lSample;
+            lSample.aOpen = lRecord.mValues[0];
+            lSample.aHigh = lRecord.mValues[1];
+            lSample.aLow = lRecord.mValues[2];
+            lSample.aClose = lRecord.mValues[3];
+            lSample.aVolume = lRecord.mValues[4];
+            lSample.aTime = lRecord.mTime;
+            for (CandleRoute& rRoute : mCandleRoutes) {
+                if (rRoute.mChannel == lRecord.mChannel) {
+                    rRoute.mPending.push_back(lSample);
+                    lRouted = true;
+                }
+            }
+            break;
+        }
+    }
+    if (!lRouted) {
+        mCounters.mUnrouted.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// ============================================================================
+// Delivery and backpressure
+// ============================================================================
+
+void RLDataSource::flushRoutes(bool aWait) {
+    for (;;) {
+        bool lDone = true;
+        for (SampleRoute& rRoute : mSampleRoutes) {
+            lDone &= flushRoute(rRoute, aWait);
+        }
+        for (BookRoute& rRoute : mBookRoutes) {
+            lDone &= flushRoute(rRoute, aWait);
+        }
+        for (CandleRoute& rRoute : mCandleRoutes) {
+            lDone &= flushRoute(rRoute, aWait);
+        }
+        if (lDone || !aWait || stopRequested()) {
+            return;
+        }
+        // Lossless (replay): wait until the render thread drained some room
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+// Push the route's batch; true once nothing is held back
+template<typename R>
+bool RLDataSource::flushRoute(R& rRoute, bool aWait) {
+    auto& rPending = rRoute.mPending;
+    if (rPending.empty()) {
+        return true;
+    }
+    const size_t lPushed = rRoute.mProducer.push(rPending.data(), rPending.size());
+    mCounters.mDelivered.fetch_add(lPushed, std::memory_order_relaxed);
+    rPending.erase(rPending.begin(), rPending.begin() + (std::ptrdiff_t)lPushed);
+    if (rPending.empty() || aWait) {
+        return rPending.empty();
+    }
+
+    if (getPolicy() == RLFeedPolicy::Drop) {
+        mCounters.mDropped.fetch_add(rPending.size(), std::memory_order_relaxed);
+        rPending.clear();
+        return true;
+    }
+    coalesce(rPending);
+    if (rPending.size() > MAX_PENDING) {
+        const size_t lExcess = rPending.size() - MAX_PENDING;
+        mCounters.mDropped.fetch_add(lExcess, std::memory_order_relaxed);
+        rPending.erase(rPending.begin(), rPending.begin() + (std::ptrdiff_t)lExcess);
+    }
+    return false;
+}
+
+void RLDataSource::coalesce(std::vector<float>& rPending) {
+    const size_t lCount = rPending.size();
+    if (lCount < 2) {
+        return;
+    }
+    float lValue = rPending.back();
+    if (getPolicy() == RLFeedPolicy::Aggregate) {
+        double lSum = 0.0;
+        for (const float lSample : rPending) {
+            lSum += lSample;
+        }
+        lValue = (float)(lSum / (double)lCount);
+    }
+    rPending.clear();
+    rPending.push_back(lValue);
+    mCounters.mCoalesced.fetch_add(lCount - 1, std::memory_order_relaxed);
+}
+
+void RLDataSource::coalesce(std::vector<RLCandlestickChart::CandleSample>& rPending) {
+    const size_t lCount = rPending.size();
+    if (lCount < 2) {
+        return;
+    }
+    RLCandlestickChart::CandleSample lMerged = rPending.back();
+    if (getPolicy() == RLFeedPolicy::Aggregate) {
+        lMerged.aOpen = rPending.front().aOpen;
+        lMerged.aVolume = 0.0f;
+        for (const RLCandlestickChart::CandleSample& rSample : rPending) {
+            lMerged.aHigh = std::max(lMerged.aHigh, rSample.aHigh);
+            lMerged.aLow = std::min(lMerged.aLow, rSample.aLow);
+            lMerged.aVolume += rSample.aVolume;
+        }
+    }
+    rPending.clear();
+    rPending.push_back(lMerged);
+    mCounters.mCoalesced.fetch_add(lCount - 1, std::memory_order_relaxed);
+}
+
+// Levels between two commits collapse to the latest size per (side, price), which
+// applies the same book. Every commit but the last is dropped, so the chart skips
+// the intermediate columns and jumps to the newest committed book.
+void RLDataSource::coalesce(std::vector<RLOrderBookUpdate>& rPending) {
+    const size_t lCount = rPending.size();
+    const auto lLevelLess = [](const RLOrderBookUpdate& rA, const RLOrderBookUpdate& rB) {
+        return rA.mSide != rB.mSide ? rA.mSide < rB.mSide : rA.mPrice < rB.mPrice;
+    };
+    const auto lCollapse = [&](size_t aBegin, size_t aEnd) {
+        const size_t lStart = mScratch.size();
+        for (size_t i = aBegin; i < aEnd; ++i) {
+            if (!rPending[i].mCommit) {
+                mScratch.push_back(rPending[i]);
+            }
+        }
+        // Stable, so the last update of each level stays last among its equals
+        std::stable_sort(mScratch.begin() + (std::ptrdiff_t)lStart, mScratch.end(), lLevelLess);
+        size_t lOut = lStart;
+        for (size_t i = lStart; i < mScratch.size(); ++i) {
+            if (i + 1 < mScratch.size() && !lLevelLess(mScratch[i], mScratch[i + 1])) {
+                continue;
+            }
+            mScratch[lOut++] = mScratch[i];
+        }
+        mScratch.resize(lOut);
+    };
+
+    size_t lLastCommit = lCount;
+    for (size_t i = 0; i < lCount; ++i) {
+        if (rPending[i].mCommit) {
+            lLastCommit = i;
+        }
+    }
+    mScratch.clear();
+    if (lLastCommit < lCount) {
+        lCollapse(0, lLastCommit);
+        mScratch.push_back(rPending[lLastCommit]);
+        lCollapse(lLastCommit + 1, lCount);
+    } else {
+        lCollapse(0, lCount);
+    }
+    mCounters.mCoalesced.fetch_add(lCount - mScratch.size(), std::memory_order_relaxed);
+    rPending.swap(mScratch);
+}
+
+void RLDataSource::sleepFor(int aMilliseconds) const {
+    // In slices, so stop() does not wait out a long reconnect delay
+    const auto lUntil = std::chrono::steady_clock::now() + std::chrono::milliseconds(aMilliseconds);
+    while (!stopRequested() && std::chrono::steady_clock::now() < lUntil) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(std::min(aMilliseconds, 20)));
+    }
+}
+
+// ============================================================================
+// Adapters
+// ============================================================================
+
+RLUdpFeedSource::RLUdpFeedSource(const char* pGroup, uint16_t aPort, RLFeedPolicy aPolicy, const char* pInterface)
+    : RLDataSource(aPolicy), mGroup(pGroup != nullptr ? pGroup : ""),
+      mInterface(pInterface != nullptr ? pInterface : ""), mPort(aPort), mBuffer(RLCharts::RECEIVE_BUFFER_BYTES) {}
+
+RLUdpFeedSource::~RLUdpFeedSource() {
+    stop();
+}
+
+bool RLUdpFeedSource::open() {
+    return mSocket.openUdp(mGroup.c_str(), mPort, mInterface.c_str());
+}
+
+long RLUdpFeedSource::read(const char*& rpData, int aTimeoutMs) {
+    rpData = mBuffer.data();
+    return mSocket.receive(mBuffer.data(), mBuffer.size(), aTimeoutMs);
+}
+
+void RLUdpFeedSource::close() {
+    mSocket.close();
+}
+
+RLTcpFeedSource::RLTcpFeedSource(const char* pHost, uint16_t aPort, RLFeedPolicy aPolicy)
+    : RLDataSource(aPolicy), mHost(pHost != nullptr ? pHost : ""), mPort(aPort), mBuffer(RLCharts::RECEIVE_BUFFER_BYTES) {}
+
+RLTcpFeedSource::~RLTcpFeedSource() {
+    stop();
+}
+
+bool RLTcpFeedSource::open() {
+    return mSocket.connectTcp(mHost.c_str(), mPort);
+}
+
+long RLTcpFeedSource::read(const char*& rpData, int aTimeoutMs) {
+    rpData = mBuffer.data();
+    return mSocket.receive(mBuffer.data(), mBuffer.size(), aTimeoutMs);
+}
+
+void RLTcpFeedSource::close() {
+    mSocket.close();
+}
+
+RLReplayFeedSource::RLReplayFeedSource(const char* pPath, double aLinesPerSecond, bool aLoop, RLFeedPolicy aPolicy)
+    : RLDataSource(aPolicy), mPath(pPath != nullptr ? pPath : ""), mLinesPerSecond(aLinesPerSecond), mLoop(aLoop) {}
+
+RLReplayFeedSource::~RLReplayFeedSource() {
+    stop();
+}
+
+bool RLReplayFeedSource::open() {
+    if (!mFile.open(mPath.c_str()) || mFile.size() == 0) {
+        mFile.close();
+        return false;
+    }
+    mPos = 0;
+    mLinesSent = 0;
+    mStart = std::chrono::steady_clock::now();
+    return true;
+}
+
+long RLReplayFeedSource::read(const char*& rpData, int aTimeoutMs) {
+    const size_t lSize = mFile.size();
+    if (mPos >= lSize) {
+        return -1;
+    }
+    uint64_t lLines = MAX_CHUNK_LINES;
+    if (mLinesPerSecond > 0.0) {
+        const double lElapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - mStart).count();
+        const uint64_t lDue = (uint64_t)(lElapsed * mLinesPerSecond);
+        if (lDue <= mLinesSent) {
+            // Sleep until the next line is due
+            const double lWait = (double)(mLinesSent + 1) / mLinesPerSecond - lElapsed;
+            const int lMs = std::clamp((int)std::ceil(lWait * 1000.0), 1, std::max(aTimeoutMs, 1));
+            std::this_thread::sleep_for(std::chrono::milliseconds(lMs));
+            return 0;
+        }
+        lLines = std::min<uint64_t>(lDue - mLinesSent, MAX_CHUNK_LINES);
+    }
+
+    // Whole lines straight from the mapping
+    const char* pBegin = mFile.data() + mPos;
+    const char* pEnd = mFile.data() + lSize;
+    const char* p = pBegin;
+    uint64_t lCount = 0;
+    while (lCount < lLines && p < pEnd) {
+        const char* pBreak = (const char*)std::memchr(p, '\n', (size_t)(pEnd - p));
+        p = pBreak != nullptr ? pBreak + 1 : pEnd;
+        lCount++;
+    }
+    mLinesSent += lCount;
+    mPos = (size_t)(p - mFile.data());
+    rpData = pBegin;
+    return (long)(p - pBegin);
+}
+
+void RLReplayFeedSource::close() {
+    mFile.close();
+}
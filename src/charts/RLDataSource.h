@@ -0,0 +1,257 @@
+// RLDataSource.h
+#pragma once
+#include "RLTimeSeries.h"
+#include "RLOrderBookVis.h"
+#include "RLCandlestickChart.h"
+#include "RLMappedFile.h"
+#include "RLFeedSocket.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// Live feed adapters: a data source reads a text line protocol on its own I/O
+// thread and delivers the records in batches into the charts' cross-thread
+// producer queues (RLTimeSeries::Producer, RLOrderBookVis::Producer,
+// RLCandlestickChart::Producer). Lines are parsed in place in the receive
+// buffer (or straight from the mapped file for replay) into per-route batches,
+// and each batch is one push into the chart's ring after every read.
+//
+// Protocol, one record per line, fields separated by spaces, tabs or commas;
+// empty lines and lines starting with '#' are skipped:
+//   s <channel> <value>                                   time series sample
+//   b <channel> <price> <size>                            bid level (size 0 removes it)
+//   a <channel> <price> <size>                            ask level
+//   c <channel>                                           commit the order book column
+//   o <channel> <time> <open> <high> <low> <close> <volume>  candle sample (epoch seconds)
+//
+// When a chart's queue is full (the render thread fell behind) the route keeps
+// the records that did not fit and applies the source's RLFeedPolicy to them
+// before the next attempt. Replay sources never drop: their I/O thread waits for
+// room instead. Implemented in RLDataSource.cpp; add it, RLFeedSocket.cpp and
+// RLMappedFile.cpp to the target's sources (and ws2_32 on Windows).
+
+// Backpressure policy for records that do not fit into a chart's queue
+enum class RLFeedPolicy {
+    Drop,       // Discard them (the queue keeps the oldest, nothing is held back)
+    LatestWins, // Keep only the newest sample/candle; collapse book levels to their latest size
+    Aggregate   // Average samples and merge candles (OHLCV) into one; book levels as LatestWins
+};
+
+enum class RLFeedKind {
+    Sample,
+    Bid,
+    Ask,
+    Commit,
+    Candle
+};
+
+// One parsed protocol line
+struct RLFeedRecord {
+    RLFeedKind mKind{RLFeedKind::Sample};
+    uint32_t mChannel{0};
+    int64_t mTime{0};        // Candle time (epoch seconds)
+    float mValues[5]{};      // Sample: value; book: price, size; candle: open, high, low, close, volume
+};
+
+enum class RLFeedParse {
+    Record,  // rRecord holds the line
+    Empty,   // Blank line or comment
+    Invalid  // Unknown tag, missing or malformed field
+};
+
+// Parse one line (without its line break; a trailing '\r' is ignored)
+RLFeedParse parseFeedLine(std::string_view aLine, RLFeedRecord& rRecord);
+
+// Cumulative counters, safe to read from any thread
+struct RLFeedStats {
+    uint64_t mBytes{0};       // Bytes read
+    uint64_t mRecords{0};     // Lines parsed into records
+    uint64_t mInvalid{0};     // Lines that failed to parse
+    uint64_t mUnrouted{0};    // Records without a route for their channel
+    uint64_t mDelivered{0};   // Records pushed into chart queues
+    uint64_t mDropped{0};     // Records discarded by backpressure
+    uint64_t mCoalesced{0};   // Records merged into others by LatestWins/Aggregate
+    uint64_t mReconnects{0};  // Failed opens, disconnects and replay loops
+};
+
+// Base class: routing, batching, backpressure and the I/O thread. Adapters
+// implement open()/read()/close().
+class RLDataSource {
+public:
+    explicit RLDataSource(RLFeedPolicy aPolicy = RLFeedPolicy::LatestWins);
+    virtual ~RLDataSource();
+
+    RLDataSource(const RLDataSource&) = delete;
+    RLDataSource& operator=(const RLDataSource&) = delete;
+
+    // Routes from protocol channels to chart producers. Add them before start();
+    // several routes may share a channel. Returns false while running or for an
+    // invalid producer. Each producer must only be fed by this source.
+    bool addSampleRoute(uint32_t aChannel, RLTimeSeries::Producer aProducer);
+    bool addBookRoute(uint32_t aChannel, RLOrderBookVis::Producer aProducer);
+    bool addCandleRoute(uint32_t aChannel, RLCandlestickChart::Producer aProducer);
+
+    // May change while running; takes effect at the next flush
+    void setPolicy(RLFeedPolicy aPolicy) { mPolicy.store(aPolicy, std::memory_order_relaxed); }
+    [[nodiscard]] RLFeedPolicy getPolicy() const { return mPolicy.load(std::memory_order_relaxed); }
+    // Pause between reconnection attempts (default 1 s)
+    void setReconnectDelay(int aMilliseconds);
+
+    // Start/stop the I/O thread. stop() joins it; a replay source that reached
+    // its end stops by itself (isRunning() turns false).
+    bool start();
+    void stop();
+    [[nodiscard]] bool isRunning() const { return mRunning.load(std::memory_order_acquire); }
+
+    // Parse and deliver lines on the calling thread (tests, custom transports).
+    // Must not be used while the I/O thread runs. A trailing partial line is
+    // kept until the next call completes it or flush() ends it.
+    void feed(std::string_view aText);
+    // Deliver pending records, applying the policy to those that do not fit
+    void flush();
+
+    [[nodiscard]] RLFeedStats getStats() const;
+
+protected:
+    // Connect/open the transport; false retries after the reconnect delay
+    virtual bool open() = 0;
+    // Next chunk of input: point rpData at it and return its size, 0 when
+    // nothing arrived within aTimeoutMs, or -1 at the end of the stream / on error
+    virtual long read(const char*& rpData, int aTimeoutMs) = 0;
+    virtual void close() = 0;
+    // Chunks hold whole lines (datagrams, replay); otherwise partial lines carry over
+    [[nodiscard]] virtual bool isFramed() const { return false; }
+    // Live feeds apply the policy under backpressure; others wait for room
+    [[nodiscard]] virtual bool isLive() const { return true; }
+    // Reopen after read() returned -1 (live transports reconnect, replay loops)
+    [[nodiscard]] virtual bool reopens() const { return true; }
+
+    [[nodiscard]] bool stopRequested() const { return mStop.load(std::memory_order_relaxed); }
+
+private:
+    template<typename Producer, typename T>
+    struct Route {
+        uint32_t mChannel;
+        Producer mProducer;
+        std::vector<T> mPending; // Parsed, not yet in the chart's queue
+    };
+    using SampleRoute = Route<RLTimeSeries::Producer, float>;
+    using BookRoute = Route<RLOrderBookVis::Producer, RLOrderBookUpdate>;
+    using CandleRoute = Route<RLCandlestickChart::Producer, RLCandlestickChart::CandleSample>;
+
+    // Records a route holds back before the oldest are dropped
+    static constexpr size_t MAX_PENDING = 65536;
+    // Longest line accepted across chunk boundaries
+    static constexpr size_t MAX_LINE = 4096;
+
+    void run();
+    void consume(const char* pData, size_t aSize, bool aFramed);
+    void processLine(std::string_view aLine);
+    void flushRoutes(bool aWait);
+    template<typename R>
+    bool flushRoute(R& rRoute, bool aWait);
+    void coalesce(std::vector<float>& rPending);
+    void coalesce(std::vector<RLCandlestickChart::CandleSample>& rPending);
+    void coalesce(std::vector<RLOrderBookUpdate>& rPending);
+    void sleepFor(int aMilliseconds) const;
+
+    std::atomic<RLFeedPolicy> mPolicy;
+    int mReconnectDelay{1000};
+    std::vector<SampleRoute> mSampleRoutes;
+    std::vector<BookRoute> mBookRoutes;
+    std::vector<CandleRoute> mCandleRoutes;
+    std::string mCarry;                      // Partial line between unframed chunks
+    std::vector<RLOrderBookUpdate> mScratch; // Book coalescing
+
+    std::thread mThread;
+    std::atomic<bool> mStop{false};
+    std::atomic<bool> mRunning{false};
+
+    struct Counters {
+        std::atomic<uint64_t> mBytes{0};
+        std::atomic<uint64_t> mRecords{0};
+        std::atomic<uint64_t> mInvalid{0};
+        std::atomic<uint64_t> mUnrouted{0};
+        std::atomic<uint64_t> mDelivered{0};
+        std::atomic<uint64_t> mDropped{0};
+        std::atomic<uint64_t> mCoalesced{0};
+        std::atomic<uint64_t> mReconnects{0};
+    };
+    Counters mCounters;
+};
+
+// UDP datagrams, one or more whole lines each. aGroup is a multicast group to
+// join (IPv4, e.g. "239.1.1.1") or nullptr/"" for plain unicast on aPort;
+// aInterface optionally picks the local interface address for the join.
+class RLUdpFeedSource : public RLDataSource {
+public:
+    RLUdpFeedSource(const char* pGroup, uint16_t aPort, RLFeedPolicy aPolicy = RLFeedPolicy::LatestWins,
+                    const char* pInterface = nullptr);
+    ~RLUdpFeedSource() override;
+
+protected:
+    bool open() override;
+    long read(const char*& rpData, int aTimeoutMs) override;
+    void close() override;
+    [[nodiscard]] bool isFramed() const override { return true; }
+
+private:
+    std::string mGroup;
+    std::string mInterface;
+    uint16_t mPort;
+    RLCharts::FeedSocket mSocket;
+    std::vector<char> mBuffer;
+};
+
+// TCP stream of lines, reconnecting after a disconnect. WebSocket feeds can be
+// bridged onto it with a relay such as websocat.
+class RLTcpFeedSource : public RLDataSource {
+public:
+    RLTcpFeedSource(const char* pHost, uint16_t aPort, RLFeedPolicy aPolicy = RLFeedPolicy::LatestWins);
+    ~RLTcpFeedSource() override;
+
+protected:
+    bool open() override;
+    long read(const char*& rpData, int aTimeoutMs) override;
+    void close() override;
+
+private:
+    std::string mHost;
+    uint16_t mPort;
+    RLCharts::FeedSocket mSocket;
+    std::vector<char> mBuffer;
+};
+
+// Replay of a recorded feed file at aLinesPerSecond (0 = as fast as the charts
+// take it), optionally looping. The file is memory-mapped and parsed in place.
+class RLReplayFeedSource : public RLDataSource {
+public:
+    RLReplayFeedSource(const char* pPath, double aLinesPerSecond, bool aLoop = false,
+                       RLFeedPolicy aPolicy = RLFeedPolicy::LatestWins);
+    ~RLReplayFeedSource() override;
+
+protected:
+    bool open() override;
+    long read(const char*& rpData, int aTimeoutMs) override;
+    void close() override;
+    [[nodiscard]] bool isFramed() const override { return true; }
+    [[nodiscard]] bool isLive() const override { return false; }
+    [[nodiscard]] bool reopens() const override { return mLoop; }
+
+private:
+    // Lines handed out per read() at most
+    static constexpr size_t MAX_CHUNK_LINES = 4096;
+
+    std::string mPath;
+    double mLinesPerSecond;
+    bool mLoop;
+    RLCharts::MappedFile mFile;
+    size_t mPos{0};
+    uint64_t mLinesSent{0};
+    std::chrono::steady_clock::time_point mStart{};
+};
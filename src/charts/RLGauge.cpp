@@ -1,16 +1,14 @@
 // RLGauge.cpp
 #include "RLGauge.h"
 #include "RLCommon.h"
-#include <array>
+#include "RLGaugePanel.h"
 #include <cmath>
-#include <cstdio>
 
 // Constants for RLGauge
 constexpr float CENTER_DOT_SCALE = 1.2f;
 constexpr float FONT_SIZE_SCALE = 0.20f;
 constexpr float TEXT_Y_OFFSET = 0.4f;
 constexpr float HALF = 0.5f;
-constexpr int VALUE_BUFFER_SIZE = 32;
 
 
 RLGauge::RLGauge(Rectangle bounds, float minValue, float maxValue, const RLGaugeStyle &style)
@@ -20,14 +18,17 @@ RLGauge::RLGauge(Rectangle bounds, float minValue, float maxValue, const RLGauge
 }
 
 void RLGauge::setBounds(Rectangle bounds){
+    mRedrawPending = true;
     mBounds = bounds;
     mCenter = { mBounds.x + (mBounds.width * HALF), mBounds.y + (mBounds.height * HALF) };
     float lRadius = fminf(mBounds.width, mBounds.height) * HALF;
     mRadius = fmaxf(4.0f, lRadius - 4.0f);
+    mStaticLayer.invalidate();
     recomputeGeometry();
 }
 
 void RLGauge::setRange(float minValue, float maxValue){
+    mRedrawPending = true;
     mMinValue = minValue;
     mMaxValue = (maxValue==minValue)?(minValue+1.0f):maxValue;
     mValue = fminf(mMaxValue, fmaxf(mMinValue, mValue));
@@ -35,16 +36,28 @@ void RLGauge::setRange(float minValue, float maxValue){
 }
 
 void RLGauge::setStyle(const RLGaugeStyle &rStyle){
+    mRedrawPending = true;
     mStyle = rStyle;
+    mStaticLayer.invalidate();
     recomputeGeometry();
 }
 
+void RLGauge::setStaticLayerCache(bool aEnabled){
+    mRedrawPending = true;
+    mStaticLayer.setEnabled(aEnabled);
+}
+
 void RLGauge::setValue(float value){
-    mValue = fminf(mMaxValue, fmaxf(mMinValue, value));
+    const float lValue = fminf(mMaxValue, fmaxf(mMinValue, value));
+    if (lValue != mValue){
+        mRedrawPending = true;
+    }
+    mValue = lValue;
     mTargetValue = mValue;
 }
 
 void RLGauge::setTargetValue(float value){
+    // A new target shows up as !isSettled(), repeating the same one costs nothing
     mTargetValue = fminf(mMaxValue, fmaxf(mMinValue, value));
 }
 
@@ -81,14 +94,42 @@ void RLGauge::recomputeGeometry(){
 }
 
 void RLGauge::update(float aDeltaTime){
+    RLCHARTS_PERF_UPDATE(mPerf, "RLGauge::update");
+    if (isSettled()){ return; }
+    mRedrawPending = true;
     if (!mStyle.mSmoothAnimate){ mValue = mTargetValue; return; }
-    // critically damped like smoothing; simple exponential approach
+    // critically damped like smoothing; simple exponential approach (snaps when close)
     constexpr float LAMBDA = 10.0f; // speed factor
     const float lAlpha = 1.0f - expf(-LAMBDA * fmaxf(0.0f, aDeltaTime));
-    mValue = mValue + ((mTargetValue - mValue) * lAlpha);
+    mValue = RLCharts::approach(mValue, mTargetValue, lAlpha);
+}
+
+bool RLGauge::isSettled() const{
+    return RLCharts::nearlyEqual(mValue, mTargetValue);
 }
 
 void RLGauge::draw() const{
+    RLCHARTS_PERF_DRAW(mPerf, "RLGauge::draw");
+    mStaticLayer.draw(mBounds, 0, [this](){ drawFace(); });
+    drawDynamic();
+}
+
+uint64_t RLGauge::getFaceKey() const{
+    RLCharts::FaceKey lKey;
+    lKey.add(mBounds.width).add(mBounds.height);
+    lKey.add(mStyle.mBackgroundColor).add(mStyle.mBaseArcColor);
+    lKey.add(mStyle.mThickness).add(mStyle.mStartAngle).add(mStyle.mEndAngle);
+    lKey.add(mStyle.mShowTicks);
+    if (mStyle.mShowTicks){
+        lKey.add(mStyle.mTickColor).add(mStyle.mMajorTickColor);
+        lKey.add(mStyle.mTickCount).add(mStyle.mMajorEvery);
+        lKey.add(mStyle.mTickLen).add(mStyle.mMajorTickLen);
+        lKey.add(mStyle.mTickThickness).add(mStyle.mMajorTickThickness);
+    }
+    return lKey.get();
+}
+
+void RLGauge::drawFace() const{
     // background
     if (mStyle.mBackgroundColor.a > 0){
         DrawRectangleRounded(mBounds, 0.15f, 8, mStyle.mBackgroundColor);
@@ -100,11 +141,7 @@ void RLGauge::draw() const{
     // base arc
     DrawRing(mCenter, lInnerR, lOuterR, mStyle.mStartAngle, mStyle.mEndAngle, 64, mStyle.mBaseArcColor);
 
-    // value arc
-    const float lAngValue = valueToAngle(mValue);
-    DrawRing(mCenter, lInnerR, lOuterR, mStyle.mStartAngle, lAngValue, 64, mStyle.mValueArcColor);
-
-    // ticks
+    // ticks (inside the ring, so the value arc never covers them)
     if (mStyle.mShowTicks){
         for (const auto &lTick : mTicks){
             const Color lColor = lTick.mMajor ? mStyle.mMajorTickColor : mStyle.mTickColor;
@@ -112,6 +149,16 @@ void RLGauge::draw() const{
             DrawLineEx(lTick.mP0, lTick.mP1, lThickness, lColor);
         }
     }
+}
+
+void RLGauge::drawDynamic() const{
+    mRedrawPending = false;
+    const float lInnerR = mRadius - mStyle.mThickness;
+    const float lOuterR = mRadius;
+
+    // value arc
+    const float lAngValue = valueToAngle(mValue);
+    DrawRing(mCenter, lInnerR, lOuterR, mStyle.mStartAngle, lAngValue, 64, mStyle.mValueArcColor);
 
     // needle
     if (mStyle.mShowNeedle){
@@ -125,18 +172,18 @@ void RLGauge::draw() const{
 
     // value text
     if (mStyle.mShowValueText){
-        std::array<char, VALUE_BUFFER_SIZE> lBuf{};
         const float lNormValue = (mValue - mMinValue)/(mMaxValue - mMinValue);
-        // map to 0-100 for common gauge feel
-        snprintf(lBuf.data(), lBuf.size(), "%.0f", lNormValue * 100.0f);
+        // map to 0-100 for common gauge feel; rounded first, so the text is only
+        // reformatted (and measured) when the shown number changes
+        const char* pText = mValueLabel.format("%.0f", (double)roundf(lNormValue * 100.0f));
         const Font &lFont = (mStyle.mLabelFont.baseSize>0)? mStyle.mLabelFont : GetFontDefault();
         float lFontSize = (fminf(mBounds.width, mBounds.height) * FONT_SIZE_SCALE);
-        const Vector2 lTextSize = MeasureTextEx(lFont, lBuf.data(), lFontSize, 0);
+        const Vector2 lTextSize = mLabelCache.measure(lFont, pText, lFontSize, 0);
         // Position text at the bottom center of the gauge (below center, inside the arc)
         const float lTextInnerR = mRadius - mStyle.mThickness;
         const float lTextY = mCenter.y + (lTextInnerR * TEXT_Y_OFFSET);  // Position below center
         // center text horizontally and vertically
         const Vector2 lPos{ mCenter.x - (lTextSize.x * HALF), lTextY - (lTextSize.y * HALF) };
-        DrawTextEx(lFont, lBuf.data(), lPos, lFontSize, 0, mStyle.mLabelColor);
+        DrawTextEx(lFont, pText, lPos, lFontSize, 0, mStyle.mLabelColor);
     }
 }
@@ -1,6 +1,10 @@
 // RLGauge.h
 #pragma once
 #include "raylib.h"
+#include "RLPerf.h"
+#include "RLLabelCache.h"
+#include "RLRenderCache.h"
+#include <cstdint>
 #include <vector>
 
 // A lightweight, fast circular gauge for raylib.
@@ -52,6 +56,27 @@ public:
     // dt in seconds
     void update(float dt);
     void draw() const;
+    // Keep the face in a render texture that is re-rendered only after
+    // setBounds()/setStyle(), and draw just the needle, value arc and text over it
+    // each frame (RLRenderCache.h). Off by default; for walls of gauges GaugePanel
+    // shares one atlas instead.
+    void setStaticLayerCache(bool aEnabled);
+    [[nodiscard]] const RLCharts::StaticLayer& getStaticLayer() const { return mStaticLayer; }
+
+    // Panel rendering (RLGaugePanel.h): draw() is drawFace() then drawDynamic().
+    // The face (background, base arc, ticks) only depends on the inputs hashed
+    // into getFaceKey(), so a panel bakes it once for all gauges sharing a key.
+    void drawFace() const;
+    void drawDynamic() const;
+    [[nodiscard]] uint64_t getFaceKey() const;
+    [[nodiscard]] Rectangle getBounds() const { return mBounds; }
+
+    // Settled once the needle has reached its target; needsRedraw() is also
+    // true after any setter until the next draw() (see RLRenderCache.h)
+    [[nodiscard]] bool isSettled() const;
+    [[nodiscard]] bool needsRedraw() const { return mRedrawPending || !isSettled(); }
+    // update()/rebuild/draw() timers and GPU counters (RLPerf.h); zero unless built with RLCHARTS_PERF
+    [[nodiscard]] const RLCharts::PerfStats& getPerfStats() const { return mPerf; }
 
 private:
     Rectangle mBounds{};
@@ -64,6 +89,11 @@ private:
     float mTargetValue{};
 
     RLGaugeStyle mStyle{};
+    mutable bool mRedrawPending{true}; // cleared by draw()
+    mutable RLCharts::PerfStats mPerf;
+    mutable RLCharts::LabelCache mLabelCache;
+    mutable RLCharts::FormattedLabel mValueLabel;
+    mutable RLCharts::StaticLayer mStaticLayer; // face
 
     // Cached geometry for ticks to avoid per-frame trig
     struct TickGeom {
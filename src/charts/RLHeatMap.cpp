@@ -1,7 +1,11 @@
 #include "RLHeatMap.h"
 #include "RLCommon.h"
+#include "RLSimd.h"
+#include "RLGpuColormap.h"
+#include "RLStateCodec.h"
 #include <cmath>
 #include <algorithm>
+#include <string>
 
 
 RLHeatMap::RLHeatMap(Rectangle aBounds, int aCellsX, int aCellsY)
@@ -26,128 +30,481 @@ RLHeatMap::~RLHeatMap(){
         mTexture = Texture2D{};
         mTextureValid = false;
     }
+    releaseGpuResources();
 }
 
-void RLHeatMap::setBounds(Rectangle aBounds){ mBounds = aBounds; }
+void RLHeatMap::setBounds(Rectangle aBounds){ mBounds = aBounds; mRedrawPending = true; }
 
-void RLHeatMap::setGrid(int aCellsX, int aCellsY){ ensureGrid(aCellsX, aCellsY); }
+void RLHeatMap::setGrid(int aCellsX, int aCellsY){ ensureGrid(aCellsX, aCellsY); mRedrawPending = true; }
 
-void RLHeatMap::setUpdateMode(RLHeatMapUpdateMode aMode){ mMode = aMode; }
+void RLHeatMap::setUpdateMode(RLHeatMapUpdateMode aMode){ mMode = aMode; mRedrawPending = true; }
 
-void RLHeatMap::setDecayHalfLifeSeconds(float aSeconds){ mDecayHalfLife = aSeconds; }
+void RLHeatMap::setDecayHalfLifeSeconds(float aSeconds){ mDecayHalfLife = aSeconds; mRedrawPending = true; }
 
-void RLHeatMap::setStyle(const RLHeatMapStyle &rStyle){ mStyle = rStyle; }
+void RLHeatMap::setStyle(const RLHeatMapStyle &rStyle){ mStyle = rStyle; mRedrawPending = true; }
+
+void RLHeatMap::setColorizeThreads(int aThreads){ mColorizeThreads = aThreads < 0 ? 1 : aThreads; }
+void RLHeatMap::setTaskPool(RLCharts::TaskPool* pPool){ mpTaskPool = pPool; }
+
+void RLHeatMap::setGpuColormap(bool aEnabled){
+    mRedrawPending = true;
+    if (aEnabled == mGpuColormap) return;
+    mGpuColormap = aEnabled;
+    mGpuFailed = false;
+    if (!aEnabled){
+        // The CPU path expects fully decayed counts
+        foldDecayScale();
+        releaseGpuResources();
+    }
+    markAllDirty();
+}
 
 void RLHeatMap::setColorStops(const std::vector<Color> &rStops){
+    mRedrawPending = true;
     if (rStops.size() < 2) return;
     mStops = rStops;
     mLutDirty = true;
 }
 
+void RLHeatMap::setColormap(RLCharts::ColormapPreset aPreset){
+    const RLCharts::ColormapStops lStops = RLCharts::colormapStops(aPreset);
+    setColorStops(std::vector<Color>(lStops.begin(), lStops.end()));
+}
+
 void RLHeatMap::clear(){
+    mRedrawPending = true;
     std::fill(mCounts.begin(), mCounts.end(), 0.0f);
+    discardShards();
+    mDecayScale = 1.0f;
     mMaxValue = 1.0f;
-    mCountsDirty = true;
+    mDirty.merge(mLive);
+    mLive.reset();
 }
 
 bool RLHeatMap::addPoints(const std::vector<Vector2>& rPoints){
-    if (rPoints.empty()) {
+    return addPoints(std::span<const Vector2>(rPoints.data(), rPoints.size()));
+}
+
+bool RLHeatMap::addPoints(std::span<const Vector2> aPoints){
+    return binPoints(aPoints, nullptr);
+}
+
+bool RLHeatMap::addPoints(std::span<const Vector2> aPoints, std::span<const float> aWeights){
+    if (aWeights.size() != aPoints.size()) {
+        mRedrawPending = true;
+        return false;
+    }
+    return binPoints(aPoints, aWeights.data());
+}
+
+void RLHeatMap::setBinningThreads(int aThreads){ mBinThreads = aThreads < 0 ? 1 : aThreads; }
+
+// Add aCount points (pWeights[i] each if given, else 1), times aIncrement, to
+// pGrid. Returns the largest value written and widens rTouched by the cells hit.
+float RLHeatMap::binSlice(const Vector2* pPoints, const float* pWeights, size_t aCount, float aIncrement,
+                          int aCellsX, int aCellsY, float* pGrid, RLCharts::CellRect& rTouched){
+    // Cell indices are computed a chunk at a time (vectorized), then scattered
+    static constexpr size_t CHUNK = 1024;
+    int32_t lCells[CHUNK];
+    int32_t lBounds[4] = { INT32_MAX, INT32_MAX, -1, -1 };
+    float lPeak = 0.0f;
+    for (size_t lStart = 0; lStart < aCount; lStart += CHUNK){
+        const size_t lCount = RLCharts::minVal(CHUNK, aCount - lStart);
+        // Vector2 is two packed floats: the points are interleaved x, y pairs
+        RLCharts::normalizedToCells(reinterpret_cast<const float*>(pPoints + lStart), lCount, aCellsX, aCellsY,
+                                    lCells, lBounds);
+        if (pWeights == nullptr){
+            for (size_t j = 0; j < lCount; ++j){
+                if (lCells[j] < 0) continue;
+                const float lV = pGrid[lCells[j]] + aIncrement;
+                pGrid[lCells[j]] = lV;
+                if (lV > lPeak) lPeak = lV;
+            }
+        } else {
+            const float* pW = pWeights + lStart;
+            for (size_t j = 0; j < lCount; ++j){
+                if (lCells[j] < 0) continue;
+                const float lV = pGrid[lCells[j]] + pW[j] * aIncrement;
+                pGrid[lCells[j]] = lV;
+                if (lV > lPeak) lPeak = lV;
+            }
+        }
+    }
+    if (lBounds[2] >= 0){
+        rTouched.merge(RLCharts::CellRect{lBounds[0], lBounds[1], lBounds[2] + 1, lBounds[3] + 1});
+    }
+    return lPeak;
+}
+
+size_t RLHeatMap::binThreadCount(size_t aItems, size_t aMinItemsPerThread) const{
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+    (void)aItems;
+    (void)aMinItemsPerThread;
+    return 1; // web build without -pthread
+#else
+    const size_t lThreads = mBinThreads == 0 ? getTaskPool().getThreadCount() : (size_t)mBinThreads;
+    return RLCharts::maxVal((size_t)1, RLCharts::minVal(lThreads, aItems / aMinItemsPerThread));
+#endif
+}
+
+bool RLHeatMap::binPoints(std::span<const Vector2> aPoints, const float* pWeights){
+    if (aPoints.empty()) {
         return false;
     }
+    mRedrawPending = true;
 
     if (mMode == RLHeatMapUpdateMode::Replace){
         // Replace mode: clear first, then add.
         // Note: If you call addPoints multiple times per frame in Replace mode,
         // this will wipe previous calls. Usually Replace implies "Set Data".
         std::fill(mCounts.begin(), mCounts.end(), 0.0f);
+        discardShards();
+        mDecayScale = 1.0f;
         mMaxValue = 1.0f;
+        mDirty.merge(mLive);
+        mLive.reset();
     }
 
-    // Optimization: Pre-calculate scaling factors to avoid (p + 1) * 0.5 inside loop
-    // Original: (x + 1) * 0.5 * Width
-    // Optimized: x * (0.5 * Width) + (0.5 * Width)
-    const float lHalfW = (float)mCellsX * 0.5f;
-    const float lHalfH = (float)mCellsY * 0.5f;
-    const int lStride = mCellsX;
+    // Stored counts are divided by the pending decay scale (1 on the CPU path)
+    const float lIncrement = 1.0f / mDecayScale;
+    const size_t lThreads = binThreadCount(aPoints.size(), BIN_MIN_POINTS_PER_THREAD);
+
+    if (lThreads == 1){
+        RLCharts::CellRect lTouched;
+        const float lPeak = binSlice(aPoints.data(), pWeights, aPoints.size(), lIncrement, mCellsX, mCellsY,
+                                     mCounts.data(), lTouched);
+        const float lCurrentMax = std::max(mMaxValue, lPeak * mDecayScale);
+        mMaxValue = lCurrentMax;
+        mGpuDecayPeak = std::max(mGpuDecayPeak, lCurrentMax);
+        mDirty.merge(lTouched);
+        mLive.merge(lTouched);
+        return true;
+    }
 
-    float lCurrentMax = mMaxValue;
+    // Task t bins slice t into its own grid: no shared cell, no atomics. The
+    // grids are allocated by their tasks and kept across frames.
+    if (mShards.size() < lThreads) {
+        mShards.resize(lThreads);
+    }
+    const size_t lCells = mCounts.size();
+    const auto lBin = [this, aPoints, pWeights, lIncrement, lThreads, lCells](size_t aThread){
+        BinShard& rShard = mShards[aThread];
+        if (rShard.mGrid.size() != lCells) {
+            rShard.mGrid.assign(lCells, 0.0f);
+        }
+        const size_t lBegin = aPoints.size() * aThread / lThreads;
+        const size_t lEnd = aPoints.size() * (aThread + 1) / lThreads;
+        binSlice(aPoints.data() + lBegin, pWeights != nullptr ? pWeights + lBegin : nullptr, lEnd - lBegin,
+                 lIncrement, mCellsX, mCellsY, rShard.mGrid.data(), rShard.mTouched);
+    };
+    getTaskPool().parallelFor(lThreads, lBin);
+    mShardsPending = true;
+    return true;
+}
 
-    // Note: We cannot easily OpenMP this loop because of race conditions on mCounts[idx]++
-    // unless we use atomic adds, which might be slower than serial for dense clusters.
-    for (size_t i = 0; i < rPoints.size(); ++i){
-        const Vector2& rP = rPoints[i];
+void RLHeatMap::mergeShards(){
+    if (!mShardsPending) return;
+    mShardsPending = false;
+    RLCharts::CellRect lRect;
+    for (const BinShard& rShard : mShards){
+        lRect.merge(rShard.mTouched);
+    }
+    if (lRect.isEmpty()) return;
+
+    // Each band of rows sums every shard into mCounts and zeroes it again
+    const size_t lStride = (size_t)mCellsX;
+    const auto lMergeRows = [this, lRect, lStride](int aY0, int aY1, float& rPeak){
+        float lMin = 0.0f;
+        float lPeak = 0.0f;
+        for (int y = aY0; y < aY1; ++y){
+            float* pDst = mCounts.data() + (size_t)y * lStride;
+            for (BinShard& rShard : mShards){
+                const RLCharts::CellRect& rTouched = rShard.mTouched;
+                if (y < rTouched.mY0 || y >= rTouched.mY1) continue;
+                float* pSrc = rShard.mGrid.data() + (size_t)y * lStride;
+                for (int x = rTouched.mX0; x < rTouched.mX1; ++x){
+                    pDst[x] += pSrc[x];
+                    pSrc[x] = 0.0f;
+                }
+            }
+            RLCharts::minMax(pDst + lRect.mX0, (size_t)lRect.width(), lMin, lPeak);
+        }
+        rPeak = lPeak;
+    };
+    const size_t lThreads = RLCharts::minVal(binThreadCount(lRect.area(), COLORIZE_MIN_CELLS_PER_THREAD),
+                                             (size_t)lRect.height());
+    mShardPeaks.assign(lThreads, 0.0f);
+    getTaskPool().parallelFor(lThreads, [this, &lMergeRows, lRect, lThreads](size_t aBand){
+        lMergeRows(lRect.mY0 + (int)((size_t)lRect.height() * aBand / lThreads),
+                   lRect.mY0 + (int)((size_t)lRect.height() * (aBand + 1) / lThreads), mShardPeaks[aBand]);
+    });
+
+    const float lCurrentMax = std::max(mMaxValue, *std::max_element(mShardPeaks.begin(), mShardPeaks.end()) * mDecayScale);
+    mMaxValue = lCurrentMax;
+    mGpuDecayPeak = std::max(mGpuDecayPeak, lCurrentMax);
+    for (BinShard& rShard : mShards){
+        mDirty.merge(rShard.mTouched);
+        mLive.merge(rShard.mTouched);
+        rShard.mTouched.reset();
+    }
+}
 
-        // Bounds check (assuming input is normalized -1 to 1)
-        if (rP.x < -1.0f || rP.x > 1.0f || rP.y < -1.0f || rP.y > 1.0f) continue;
+void RLHeatMap::discardShards(){
+    const size_t lStride = (size_t)mCellsX;
+    for (BinShard& rShard : mShards){
+        const RLCharts::CellRect& rTouched = rShard.mTouched;
+        for (int y = rTouched.mY0; y < rTouched.mY1 && !rTouched.isEmpty(); ++y){
+            float* pRow = rShard.mGrid.data() + (size_t)y * lStride;
+            std::fill(pRow + rTouched.mX0, pRow + rTouched.mX1, 0.0f);
+        }
+        rShard.mTouched.reset();
+    }
+    mShardsPending = false;
+}
 
-        // Coordinate math optimized
-        // Y is flipped: input +1 (top) maps to index 0.
-        // y_norm = (p.y + 1) * 0.5. y_flip = 1.0 - y_norm.
-        // y_idx = y_flip * Height = (1.0 - (0.5*p.y + 0.5)) * H = (0.5 - 0.5*p.y) * H
-        // = 0.5*H - p.y*0.5*H
+bool RLHeatMap::setCounts(std::span<const float> aCounts){
+    if (aCounts.size() != mCounts.size()) {
+        return false;
+    }
+    mRedrawPending = true;
+    discardShards();
+    // Cells that were live may be zero now, so they are stale as well
+    mDirty.merge(mLive);
+    mLive.reset();
+    float lMax = 0.0f;
+    const size_t lStride = (size_t)mCellsX;
+    for (int y = 0; y < mCellsY; ++y){
+        const float* pSrc = aCounts.data() + (size_t)y * lStride;
+        float* pDst = mCounts.data() + (size_t)y * lStride;
+        int lFirst = -1;
+        int lLast = -1;
+        for (int x = 0; x < mCellsX; ++x){
+            const float lV = pSrc[x];
+            pDst[x] = lV;
+            if (lV > 0.0f){
+                if (lFirst < 0) lFirst = x;
+                lLast = x;
+                if (lV > lMax) lMax = lV;
+            }
+        }
+        if (lFirst >= 0){
+            mLive.merge(RLCharts::CellRect{lFirst, y, lLast + 1, y + 1});
+        }
+    }
+    mDecayScale = 1.0f;
+    mMaxValue = std::max(lMax, 1.0f);
+    mGpuDecayPeak = lMax;
+    mDirty.merge(mLive);
+    return true;
+}
 
-        int lIx = (int)(rP.x * lHalfW + lHalfW);
-        int lIy = (int)(lHalfH - rP.y * lHalfH);
+namespace RLCharts {
 
-        // Fast clamp to ensure we stay in grid memory
-        lIx = RLCharts::clampIdx(lIx, mCellsX);
-        lIy = RLCharts::clampIdx(lIy, mCellsY);
+static constexpr uint32_t HEATMAP_STATE_TAG = stateTag("HMAP");
 
-        size_t lIdx = (size_t)lIy * lStride + lIx;
+} // namespace RLCharts
 
-        float lVal = mCounts[lIdx] + 1.0f;
-        mCounts[lIdx] = lVal;
+std::vector<uint8_t> RLHeatMap::saveState() const{
+    RLCharts::StateWriter lWriter;
+    lWriter.writeU32((uint32_t)mCellsX);
+    lWriter.writeU32((uint32_t)mCellsY);
+    // Cell values with unmerged binning shards and the pending GPU decay folded in
+    std::vector<float> lValues(mCounts);
+    for (const BinShard& rShard : mShards){
+        if (!mShardsPending || rShard.mTouched.isEmpty()) continue;
+        for (size_t i = 0; i < lValues.size(); ++i){
+            lValues[i] += rShard.mGrid[i];
+        }
+    }
+    for (float& rV : lValues){
+        rV *= mDecayScale;
+    }
+    lWriter.writeFloats(lValues);
+    return lWriter.finish(RLCharts::HEATMAP_STATE_TAG);
+}
 
-        // Track max value locally to minimize memory writes
-        if (lVal > lCurrentMax) lCurrentMax = lVal;
+bool RLHeatMap::loadState(std::span<const uint8_t> aState){
+    RLCharts::StateReader lReader;
+    uint32_t lCellsX = 0;
+    uint32_t lCellsY = 0;
+    std::vector<float> lValues;
+    if (!lReader.open(aState, RLCharts::HEATMAP_STATE_TAG) || !lReader.readU32(lCellsX) || !lReader.readU32(lCellsY) ||
+        lCellsX == 0 || lCellsY == 0 || lCellsX > (uint32_t)INT32_MAX || lCellsY > (uint32_t)INT32_MAX ||
+        !lReader.readFloats(lValues, (size_t)lCellsX * lCellsY) || !lReader.atEnd()){
+        return false;
     }
+    if ((int)lCellsX != mCellsX || (int)lCellsY != mCellsY){
+        setGrid((int)lCellsX, (int)lCellsY);
+    }
+    return setCounts(lValues);
+}
 
-    mMaxValue = lCurrentMax;
-    mCountsDirty = true;
-    return true;
+bool RLHeatMap::isPrepared() const{
+    if (mShardsPending) return false;
+    if (!mDirty.isEmpty() || mLutDirty || (mPreparedGpu && mLutUploadDirty)) return false;
+    return !(mMode == RLHeatMapUpdateMode::Decay && mDecayHalfLife > 0.0f && !mLive.isEmpty());
+}
+
+bool RLHeatMap::isSettled() const{
+    if (mStaging.hasPending() || mRestageAll.load(std::memory_order_relaxed) || gpuPathWanted() != mPreparedGpu) return false;
+    return isPrepared();
 }
 
 void RLHeatMap::update(float aDt){
+    prepare(aDt);
+    commit();
+}
+
+void RLHeatMap::prepare(float aDt){
+    RLCHARTS_PERF_UPDATE(mPerf, "RLHeatMap::prepare");
+    if (mRestageAll.exchange(false)){
+        markAllDirty();
+        mLutUploadDirty = true;
+    }
+    // Points binned by several threads since the last frame
+    mergeShards();
+    const bool lGpu = gpuPathWanted();
+    if (lGpu != mPreparedGpu){
+        // Switching paths (enabled, disabled or GPU setup failed): the CPU path
+        // expects fully decayed counts, and either path starts from a full upload
+        if (!lGpu) foldDecayScale();
+        mPreparedGpu = lGpu;
+        mLutUploadDirty = true;
+        markAllDirty();
+    }
+    if (isPrepared()){
+        mLastUploadCells = 0;
+        return;
+    }
+    StagedFrame& rFrame = mStaging.beginPrepare();
+
     // 1. Handle Decay
-    if (mMode == RLHeatMapUpdateMode::Decay && mDecayHalfLife > 0.0f){
+    if (lGpu && mMode == RLHeatMapUpdateMode::Decay && mDecayHalfLife > 0.0f && !mLive.isEmpty()){
+        // Uniform decay is just a shader uniform: no per-cell work, no upload
+        const float lDecayFactor = powf(0.5f, aDt / mDecayHalfLife);
+        mDecayScale *= lDecayFactor;
+        mMaxValue = std::max(mMaxValue * lDecayFactor, 1.0f);
+        mGpuDecayPeak *= lDecayFactor;
+        if (mGpuDecayPeak * 255.0f < mMaxValue){
+            // Every cell maps to LUT[0] now: clear once and stop decaying
+            std::fill(mCounts.begin(), mCounts.end(), 0.0f);
+            mDecayScale = 1.0f;
+            mMaxValue = 1.0f;
+            mGpuDecayPeak = 0.0f;
+            mDirty.merge(mLive);
+            mLive.reset();
+        } else if (mDecayScale < 1e-6f){
+            // Keep stored counts in a comfortable float range
+            foldDecayScale();
+            markAllDirty();
+        }
+    } else if (mMode == RLHeatMapUpdateMode::Decay && mDecayHalfLife > 0.0f && !mLive.isEmpty()){
+        // Only the live box can change; it shrinks as cells decay to zero
         float lDecayFactor = powf(0.5f, aDt / mDecayHalfLife);
         float lNewMax = 0.0f;
-        const size_t lCount = mCounts.size();
+        int lNewX0 = mLive.mX1;
+        int lNewY0 = mLive.mY1;
+        int lNewX1 = mLive.mX0;
+        int lNewY1 = mLive.mY0;
+        const int lX0 = mLive.mX0;
+        const int lX1 = mLive.mX1;
 
         #ifdef _OPENMP
-        #pragma omp parallel for reduction(max:lNewMax)
+        #pragma omp parallel for reduction(max:lNewMax, lNewX1, lNewY1) reduction(min:lNewX0, lNewY0)
         #endif
-        for (size_t i = 0; i < lCount; ++i){
-            float lV = mCounts[i] * lDecayFactor;
-            // Threshold to zero
-            if (lV < 1e-4f) lV = 0.0f;
-            mCounts[i] = lV;
-            if (lV > lNewMax) lNewMax = lV;
+        for (int y = mLive.mY0; y < mLive.mY1; ++y){
+            float* pRow = mCounts.data() + (size_t)y * (size_t)mCellsX;
+            for (int x = lX0; x < lX1; ++x){
+                float lV = pRow[x] * lDecayFactor;
+                // Threshold to zero
+                if (lV < 1e-4f) lV = 0.0f;
+                pRow[x] = lV;
+                if (lV > 0.0f){
+                    if (lV > lNewMax) lNewMax = lV;
+                    if (x < lNewX0) lNewX0 = x;
+                    if (x + 1 > lNewX1) lNewX1 = x + 1;
+                    if (y < lNewY0) lNewY0 = y;
+                    if (y + 1 > lNewY1) lNewY1 = y + 1;
+                }
+            }
         }
         mMaxValue = std::max(lNewMax, 1.0f);
-        mCountsDirty = true;
+        mDirty.merge(mLive);
+        mLive = RLCharts::CellRect{lNewX0, lNewY0, lNewX1, lNewY1};
+        if (mLive.isEmpty()) mLive.reset();
     }
 
     // 2. Handle Texture Updates
     if (mLutDirty) rebuildLUT();
 
-    if (mCountsDirty){
-        rebuildTextureIfNeeded();
-        updateTexturePixels();
-        mCountsDirty = false;
+    mLastUploadCells = 0;
+    if (lGpu){
+        if (mLutUploadDirty){
+            rFrame.mUploads.texture(&mLutTexture, mLut, sizeof(mLut));
+            mLutUploadDirty = false;
+        }
+        // The max is a uniform here, only changed counts need uploading
+        if (!mDirty.isEmpty()){
+            mLastUploadCells = mDirty.area();
+            stageDirtyRect(rFrame.mUploads, &mGridTexture, (const uint32_t*)mCounts.data());
+            mDirty.reset();
+        }
+    } else {
+        // Every live cell's color depends on the max
+        if (mMaxValue != mColorizedMax) mDirty.merge(mLive);
+        if (!mDirty.isEmpty()){
+            updateTexturePixels(rFrame.mUploads);
+            mDirty.reset();
+        }
+    }
+    rFrame.mGpu = lGpu;
+    rFrame.mInvMax = (mMaxValue > 1e-6f) ? (1.0f / mMaxValue) : 1.0f;
+    rFrame.mDecayScale = mDecayScale;
+    mStaging.endPrepare();
+}
+
+void RLHeatMap::commit(){
+    StagedFrame* pFrame = mStaging.beginCommit();
+    if (pFrame == nullptr) return;
+
+    const bool lHadTextures = pFrame->mGpu ? mGpuReady : mTextureValid;
+    const bool lReady = pFrame->mGpu ? ensureGpuResources() : rebuildTextureIfNeeded();
+    if (lReady && !lHadTextures){
+        // New textures start empty: unless this frame fills them, restage everything
+        const bool lCovered = pFrame->mGpu
+            ? pFrame->mUploads.coversTexture(&mGridTexture) && pFrame->mUploads.coversTexture(&mLutTexture)
+            : pFrame->mUploads.coversTexture(&mTexture);
+        if (!lCovered) mRestageAll = true;
     }
+    [[maybe_unused]] const size_t lSent = pFrame->mUploads.replay();
+    RLCHARTS_PERF_UPLOAD(mPerf, lSent);
+
+    mDrawGpu = pFrame->mGpu && lReady;
+    mDrawInvMax = pFrame->mInvMax;
+    mDrawDecayScale = pFrame->mDecayScale;
+    mRedrawPending = true;
+    mStaging.endCommit();
 }
 
 void RLHeatMap::draw() const{
+    RLCHARTS_PERF_DRAW(mPerf, "RLHeatMap::draw");
+    mRedrawPending = false;
     if (mStyle.mShowBackground){
         DrawRectangleRec(mBounds, mStyle.mBackground);
     }
 
-    if (mTextureValid && mTexture.id != 0){
-        Rectangle lSrc = {0, 0, (float)mCellsX, (float)mCellsY};
-        Rectangle lDst = mBounds;
-        Vector2 lOrigin = {0, 0};
-        DrawTexturePro(mTexture, lSrc, lDst, lOrigin, 0.0f, WHITE);
+    const Rectangle lSrc = {0, 0, (float)mCellsX, (float)mCellsY};
+    if (mDrawGpu && isGpuColormapActive()){
+        BeginShaderMode(mGpuShader);
+        SetShaderValueTexture(mGpuShader, mLocLut, mLutTexture);
+        SetShaderValue(mGpuShader, mLocInvMax, &mDrawInvMax, SHADER_UNIFORM_FLOAT);
+        SetShaderValue(mGpuShader, mLocDecayScale, &mDrawDecayScale, SHADER_UNIFORM_FLOAT);
+        DrawTexturePro(mGridTexture, lSrc, mBounds, Vector2{0, 0}, 0.0f, WHITE);
+        RLCHARTS_PERF_DRAW_CALLS(mPerf, 1);
+        EndShaderMode();
+    } else if (mTextureValid && mTexture.id != 0){
+        DrawTexturePro(mTexture, lSrc, mBounds, Vector2{0, 0}, 0.0f, WHITE);
+        RLCHARTS_PERF_DRAW_CALLS(mPerf, 1);
     }
 
     if (mStyle.mShowBorder){
@@ -166,12 +523,16 @@ void RLHeatMap::ensureGrid(int aCellsX, int aCellsY){
 
     size_t lTotal = (size_t)mCellsX * (size_t)mCellsY;
     mCounts.assign(lTotal, 0.0f);
+    // Binning grids have the old size
+    mShards.clear();
+    mShardsPending = false;
 
-    // Pixel buffer size (4 bytes per pixel)
-    mPixels.assign(lTotal * 4, 0);
-
+    mDecayScale = 1.0f;
     mMaxValue = 1.0f;
-    mCountsDirty = true;
+    mLive.reset();
+    markAllDirty();
+    // Staged frames target the old size
+    mStaging.discard();
 
     // Force texture recreation
     if (mTextureValid && mTexture.id != 0){
@@ -179,37 +540,28 @@ void RLHeatMap::ensureGrid(int aCellsX, int aCellsY){
         mTexture = Texture2D{};
         mTextureValid = false;
     }
+    if (mGridTexture.id != 0){
+        UnloadTexture(mGridTexture);
+        mGridTexture = Texture2D{};
+        mGpuReady = false;
+    }
 }
 
 void RLHeatMap::rebuildLUT(){
-    size_t lN = mStops.size();
-    if (lN < 2) return; // Should not happen due to check in ensure/setColor
-
-    for (int i = 0; i < 256; ++i){
-        float lT = (float)i / 255.0f;
-        float lSegF = lT * (float)(lN - 1);
-        auto lSeg = (size_t)lSegF;
-        if (lSeg >= lN - 1) lSeg = lN - 2;
-
-        float lLerp = lSegF - (float)lSeg;
-
-        const Color& rA = mStops[lSeg];
-        const Color& rB = mStops[lSeg + 1];
-
-        // Fast lerp: compute as float, then cast to unsigned char
-        mLut[i].r = (unsigned char)((float)rA.r + ((float)rB.r - (float)rA.r) * lLerp);
-        mLut[i].g = (unsigned char)((float)rA.g + ((float)rB.g - (float)rA.g) * lLerp);
-        mLut[i].b = (unsigned char)((float)rA.b + ((float)rB.b - (float)rA.b) * lLerp);
-        mLut[i].a = (unsigned char)((float)rA.a + ((float)rB.a - (float)rA.a) * lLerp);
-    }
+    if (mStops.size() < 2) return; // Should not happen due to check in ensure/setColor
+    RLCharts::buildStopLut(mStops.data(), mStops.size(), mLut, RLCharts::COLORMAP_LUT_SIZE);
     mLutDirty = false;
+    mLutUploadDirty = true;
+    // The CPU texture bakes the LUT in
+    if (!mPreparedGpu) markAllDirty();
 }
 
-void RLHeatMap::rebuildTextureIfNeeded(){
-    if (mTextureValid && mTexture.id != 0) return;
+bool RLHeatMap::rebuildTextureIfNeeded(){
+    if (mTextureValid && mTexture.id != 0) return true;
 
+    // Created empty; the staged texels are uploaded right after
     Image lImg = {};
-    lImg.data = mPixels.data();
+    lImg.data = nullptr;
     lImg.width = mCellsX;
     lImg.height = mCellsY;
     lImg.mipmaps = 1;
@@ -223,48 +575,150 @@ void RLHeatMap::rebuildTextureIfNeeded(){
     SetTextureWrap(mTexture, TEXTURE_WRAP_CLAMP);
 
     mTextureValid = (mTexture.id != 0);
+    return mTextureValid;
 }
 
-void RLHeatMap::updateTexturePixels(){
-    const size_t lTotalPixels = (size_t)mCellsX * (size_t)mCellsY;
+void RLHeatMap::updateTexturePixels(RLCharts::UploadList& rUploads){
+    RLCHARTS_PERF_REBUILD(mPerf, "RLHeatMap::updateTexturePixels");
+    // Avoid division in the loop
+    const float lInvMax = (mMaxValue > 1e-6f) ? (1.0f / mMaxValue) : 1.0f;
+    const size_t lStride = (size_t)mCellsX;
+    const size_t lWidth = (size_t)mDirty.width();
+
+    // Colorize straight into the staged upload, rows packed to the dirty width
+    const size_t lBytes = mDirty.area() * sizeof(uint32_t);
+    void* pStaged = (mDirty.width() == mCellsX && mDirty.height() == mCellsY)
+        ? rUploads.texture(&mTexture, lBytes)
+        : rUploads.textureRect(&mTexture, Rectangle{(float)mDirty.mX0, (float)mDirty.mY0, (float)mDirty.width(), (float)mDirty.height()}, lBytes);
+    auto* pOut = static_cast<uint32_t*>(pStaged);
+
+    if (lWidth == lStride){
+        // Whole rows are contiguous: one (possibly threaded) pass
+        colorizeRows((size_t)mDirty.mY0 * lStride, (size_t)mDirty.height() * lStride, lInvMax, pOut);
+    } else {
+        const auto pLut32 = (const uint32_t*)mLut;
+        for (int y = mDirty.mY0; y < mDirty.mY1; ++y){
+            const size_t lRowStart = (size_t)y * lStride + (size_t)mDirty.mX0;
+            RLCharts::colorizeLut(mCounts.data() + lRowStart, pOut + (size_t)(y - mDirty.mY0) * lWidth,
+                                  lWidth, lInvMax, pLut32);
+        }
+    }
+    mColorizedMax = mMaxValue;
+    mLastUploadCells = mDirty.area();
+}
 
-    // Use raw pointers for speed
-    const float* pCounts = mCounts.data();
+void RLHeatMap::colorizeRows(size_t aFirstCell, size_t aCellCount, float aInvMax, uint32_t* pPixels32) const{
+    // raylib Color is 4 packed bytes (r,g,b,a): treat LUT entries and pixels as uint32_t
+    const float* pCounts = mCounts.data() + aFirstCell;
+    const auto pLut32 = (const uint32_t*)mLut;
 
-    // Cast to uint32_t to write 4 bytes (RGBA) in one instruction
-    // Raylib Color is r,g,b,a in memory (struct), usually packed.
-    // WARNING: This assumes Little Endian for exact byte order if constructing integer manually,
-    // but here we just copy from Color struct, which is safe if we copy the struct.
-    // However, writing to uint32_t* is the standard optimization for pixel buffers.
-    auto pPixels32 = (uint32_t*)mPixels.data();
+    RLCharts::TaskPool& rPool = getTaskPool();
+    size_t lThreads = mColorizeThreads == 0 ? rPool.getThreadCount() : (size_t)mColorizeThreads;
+    lThreads = RLCharts::minVal(lThreads, aCellCount / COLORIZE_MIN_CELLS_PER_THREAD);
 
-    // Avoid division in the loop
-    const float lInvMax = (mMaxValue > 1e-6f) ? (1.0f / mMaxValue) : 1.0f;
-    const float SCALE_255 = 255.0f;
+    if (lThreads <= 1){
+        RLCharts::colorizeLut(pCounts, pPixels32, aCellCount, aInvMax, pLut32);
+        return;
+    }
 
-    // Use OpenMP if available for massive speedup on large grids
-    #ifdef _OPENMP
-    #pragma omp parallel for
-    #endif
-    for (size_t i = 0; i < lTotalPixels; ++i){
-        float lV = pCounts[i];
+    // Split into bands of whole rows, one pool task each
+    const size_t lRows = aCellCount / (size_t)mCellsX;
+    const size_t lRowsPerBand = (lRows + lThreads - 1) / lThreads;
+    const size_t lBandCells = lRowsPerBand * (size_t)mCellsX;
+    const size_t lBands = (aCellCount + lBandCells - 1) / lBandCells;
+    rPool.parallelFor(lBands, [=](size_t aBand){
+        const size_t lStart = aBand * lBandCells;
+        RLCharts::colorizeLut(pCounts + lStart, pPixels32 + lStart,
+                              RLCharts::minVal(lBandCells, aCellCount - lStart), aInvMax, pLut32);
+    });
+}
 
-        // Fast index calculation without branching 'clampi' or 'clamp01f' overhead
-        // v * invMax is roughly 0..1.
-        int lIdx = (int)(lV * lInvMax * SCALE_255);
+void RLHeatMap::stageDirtyRect(RLCharts::UploadList& rUploads, const Texture2D* pTexture, const uint32_t* pGrid) const{
+    // Both the RGBA8 pixels and the R32 counts are 4 bytes per cell
+    const size_t lStride = (size_t)mCellsX;
+    const size_t lBytes = mDirty.area() * sizeof(uint32_t);
+    if (mDirty.width() == mCellsX && mDirty.height() == mCellsY){
+        rUploads.texture(pTexture, pGrid, lBytes);
+        return;
+    }
+
+    const Rectangle lRec = {(float)mDirty.mX0, (float)mDirty.mY0, (float)mDirty.width(), (float)mDirty.height()};
+    auto* pOut = static_cast<uint32_t*>(rUploads.textureRect(pTexture, lRec, lBytes));
+    if (mDirty.width() == mCellsX){
+        // Full-width band is already contiguous
+        std::copy_n(pGrid + (size_t)mDirty.mY0 * lStride, mDirty.area(), pOut);
+        return;
+    }
 
-        // Branchless clamping to 0..255
-        if (lIdx > 255) lIdx = 255;
-        // if (lIdx < 0) lIdx = 0; // v is always >= 0, so this is unnecessary
+    const size_t lWidth = (size_t)mDirty.width();
+    for (int y = mDirty.mY0; y < mDirty.mY1; ++y){
+        std::copy_n(pGrid + (size_t)y * lStride + (size_t)mDirty.mX0, lWidth,
+                    pOut + (size_t)(y - mDirty.mY0) * lWidth);
+    }
+}
 
-        Color lC = mLut[lIdx];
+void RLHeatMap::markAllDirty(){
+    mDirty = RLCharts::CellRect{0, 0, mCellsX, mCellsY};
+}
 
-        // Reinterpret cast hack to write 4 bytes at once
-        // (Color struct is 4 bytes: r,g,b,a)
-        pPixels32[i] = *(uint32_t*)&lC;
+bool RLHeatMap::ensureGpuResources(){
+    if (mGpuReady) return true;
+    if (mGpuFailed) return false;
+
+    if (mGpuShader.id == 0){
+        std::string lBody = "uniform sampler2D lutTexture;\n"
+                            "uniform float invMax;\n"
+                            "uniform float decayScale;\n";
+        lBody += RLCharts::colormapLookupGlsl();
+        lBody += "void main() {\n"
+                 "    float lValue = GRID_TEXTURE(texture0, fragTexCoord).r * decayScale;\n"
+                 "    FRAG_OUT = lutLookup(lutTexture, lValue, invMax) * fragColor;\n"
+                 "}\n";
+        mGpuShader = RLCharts::loadColormapShader(lBody.c_str());
+        mLocLut = GetShaderLocation(mGpuShader, "lutTexture");
+        mLocInvMax = GetShaderLocation(mGpuShader, "invMax");
+        mLocDecayScale = GetShaderLocation(mGpuShader, "decayScale");
+    }
+    // Textures are created empty; LUT and counts come from the staged frame
+    if (mLutTexture.id == 0){
+        mLutTexture = RLCharts::loadLutTexture(nullptr);
+    }
+    if (mGridTexture.id == 0){
+        mGridTexture = RLCharts::loadFloatGridTexture(mCellsX, mCellsY, nullptr, false);
     }
 
-    if (mTextureValid && mTexture.id != 0){
-        UpdateTexture(mTexture, mPixels.data());
+    mGpuReady = IsShaderValid(mGpuShader) && mLutTexture.id != 0 && mGridTexture.id != 0;
+    if (!mGpuReady){
+        // The next prepare() switches to the CPU path and restages everything
+        releaseGpuResources();
+        mGpuFailed = true;
+    }
+    return mGpuReady;
+}
+
+void RLHeatMap::releaseGpuResources(){
+    if (mGpuShader.id != 0){
+        UnloadShader(mGpuShader);
+        mGpuShader = Shader{};
     }
-}
\ No newline at end of file
+    if (mGridTexture.id != 0){
+        UnloadTexture(mGridTexture);
+        mGridTexture = Texture2D{};
+    }
+    if (mLutTexture.id != 0){
+        UnloadTexture(mLutTexture);
+        mLutTexture = Texture2D{};
+    }
+    mGpuReady = false;
+}
+
+void RLHeatMap::foldDecayScale(){
+    // Pending shards hold counts divided by the current scale too
+    mergeShards();
+    if (mDecayScale == 1.0f) return;
+    for (float& rV : mCounts){
+        rV *= mDecayScale;
+        if (rV < 1e-4f) rV = 0.0f;
+    }
+    mDecayScale = 1.0f;
+}
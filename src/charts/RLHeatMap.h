@@ -1,7 +1,14 @@
 // RLHeatMap.h
 #pragma once
 #include "raylib.h"
+#include "RLPerf.h"
+#include "RLCommon.h"
+#include "RLColormap.h"
+#include "RLGpuStaging.h"
+#include "RLTaskPool.h"
+#include <atomic>
 #include <vector>
+#include <span>
 #include <cstdint>
 
 enum class RLHeatMapUpdateMode {
@@ -29,22 +36,79 @@ public:
     void setUpdateMode(RLHeatMapUpdateMode aMode);
     void setDecayHalfLifeSeconds(float aSeconds);
     void setStyle(const RLHeatMapStyle &rStyle);
+    // Worker threads for colorizing large grids: 1 = the prepare() thread only (default),
+    // 0 = every thread of the task pool. Small grids always stay serial.
+    void setColorizeThreads(int aThreads);
+    // Pool that runs threaded colorizing and binning (RLTaskPool.h); nullptr =
+    // RLCharts::TaskPool::shared(). The pool must outlive the chart.
+    void setTaskPool(RLCharts::TaskPool* pPool);
+    // Colormap on the GPU: upload the raw counts as a float texture and do max
+    // normalization, decay and the LUT lookup in a fragment shader. Falls back to
+    // the CPU path if float textures or the shader are unavailable.
+    void setGpuColormap(bool aEnabled);
 
     // Provide 3 or 4 color stops; interpolated evenly across [0..1]
     void setColorStops(const std::vector<Color> &rStops);
+    // Perceptual preset (viridis, magma, ...) from RLColormap.h
+    void setColormap(RLCharts::ColormapPreset aPreset);
 
     // Add points in normalized space [-1,1] for both x and y
-    // Returns false if rPoints is empty
+    // Returns false if rPoints is empty. The span overload reads caller-owned memory directly.
     bool addPoints(const std::vector<Vector2>& rPoints);
+    bool addPoints(std::span<const Vector2> aPoints);
+    // Weighted points: aWeights[i] (non-negative) is added to the cell of
+    // aPoints[i] instead of 1. Returns false if aPoints is empty or the sizes differ.
+    bool addPoints(std::span<const Vector2> aPoints, std::span<const float> aWeights);
+    // Bin large addPoints() batches as aThreads tasks on the task pool (0 = every
+    // pool thread, 1 = serial, the default). Each task adds its slice of the batch
+    // into a private grid, so no cell is written by two threads and no atomics are
+    // needed; prepare() merges the private grids into the counts once per frame.
+    // Batches of less than 32K points per thread use fewer threads.
+    void setBinningThreads(int aThreads);
+    // Replace the whole grid with values binned by the caller (row-major, top row
+    // first, getCellsX() * getCellsY() entries), e.g. the density mode of
+    // RLScatterPlot. Returns false if the size does not match the grid.
+    bool setCounts(std::span<const float> aCounts);
     void clear();
+    // Snapshot of the grid size and cell values (RLStateCodec.h), e.g. to warm up
+    // a dashboard after a restart. loadState() resizes the grid to the saved one;
+    // it returns false, leaving the map untouched, for a blob that does not match.
+    [[nodiscard]] std::vector<uint8_t> saveState() const;
+    bool loadState(std::span<const uint8_t> aState);
 
+    // update(dt) is prepare(dt) followed by commit(). prepare() does the CPU work
+    // (decay, colorization, packing the changed texels into a staging buffer)
+    // without GL calls and may run on a worker thread; commit() creates the
+    // textures and uploads the staged frame on the render thread. The staging is
+    // double-buffered (RLGpuStaging.h) and draw() only reads committed state, so
+    // prepare() for the next frame may overlap commit() and draw() of the previous
+    // one. Setters, isSettled() and needsRedraw() must not overlap prepare().
     void update(float aDt);
+    void prepare(float aDt);
+    void commit();
     void draw() const;
 
+    // Settled when no texels are stale and nothing is left decaying; needsRedraw()
+    // also covers setters and addPoints() since the last draw()
+    [[nodiscard]] bool isSettled() const;
+    [[nodiscard]] bool needsRedraw() const { return mRedrawPending || !isSettled(); }
+    // update()/rebuild/draw() timers and GPU counters (RLPerf.h); zero unless built with RLCHARTS_PERF
+    [[nodiscard]] const RLCharts::PerfStats& getPerfStats() const { return mPerf; }
+
     [[nodiscard]] Rectangle getBounds() const { return mBounds; }
     [[nodiscard]] int getCellsX() const { return mCellsX; }
     [[nodiscard]] int getCellsY() const { return mCellsY; }
     [[nodiscard]] RLHeatMapUpdateMode getUpdateMode() const { return mMode; }
+    [[nodiscard]] int getColorizeThreads() const { return mColorizeThreads; }
+    [[nodiscard]] int getBinningThreads() const { return mBinThreads; }
+    [[nodiscard]] RLCharts::TaskPool& getTaskPool() const {
+        return mpTaskPool != nullptr ? *mpTaskPool : RLCharts::TaskPool::shared();
+    }
+    [[nodiscard]] bool isGpuColormapEnabled() const { return mGpuColormap; }
+    // True once the GPU resources were created successfully
+    [[nodiscard]] bool isGpuColormapActive() const { return mGpuColormap && mGpuReady; }
+    // Cells recolored/staged by the last prepare() (dirty-rectangle size)
+    [[nodiscard]] size_t getLastUploadCells() const { return mLastUploadCells; }
 
 private:
     Rectangle mBounds{};
@@ -53,26 +117,97 @@ private:
     RLHeatMapUpdateMode mMode{RLHeatMapUpdateMode::Accumulate};
     RLHeatMapStyle mStyle{};
 
-    // Aggregation grid
+    // Aggregation grid. Cell value = mCounts[i] * mDecayScale; the CPU path decays
+    // cells in place (scale stays 1), the GPU path only decays the scale.
     std::vector<float> mCounts;
+    float mDecayScale{1.0f};
     float mMaxValue{1.0f};
-    bool mCountsDirty{false};
+    float mGpuDecayPeak{0.0f}; // upper bound of any cell value while the GPU path decays
+    mutable bool mRedrawPending{true}; // cleared by draw()
+    mutable RLCharts::PerfStats mPerf;
+
+    // Cells whose texture texels are stale, and the bounding box of cells that may
+    // be non-zero (zero cells map to LUT[0] whatever the max, so a max change only
+    // recolors the live box)
+    RLCharts::CellRect mDirty;
+    RLCharts::CellRect mLive;
+    float mColorizedMax{0.0f};          // mMaxValue the CPU texture was colored with
+    size_t mLastUploadCells{0};
+
+    // One prepared frame: its uploads and the uniforms draw() uses with them
+    struct StagedFrame {
+        RLCharts::UploadList mUploads;
+        bool mGpu{false};
+        float mInvMax{1.0f};
+        float mDecayScale{1.0f};
+        void clear() { mUploads.clear(); }
+    };
+    RLCharts::StagingBuffers<StagedFrame> mStaging;
+    bool mPreparedGpu{false};               // path the last prepare() took
+    std::atomic<bool> mRestageAll{false};   // commit() created textures the staged frame did not fill
+    // Committed state read by draw()
+    bool mDrawGpu{false};
+    float mDrawInvMax{1.0f};
+    float mDrawDecayScale{1.0f};
 
     // Color mapping
     std::vector<Color> mStops; // 3 or 4
     Color mLut[256]{};
     bool mLutDirty{true};
 
-    // Texture resources (cpu pixels reused)
-    std::vector<unsigned char> mPixels; // RGBA
+    // Texture resources (colorized texels go straight into the staging buffer)
     Texture2D mTexture{};
     bool mTextureValid{false};
 
     // Decay (exponential by half-life)
     float mDecayHalfLife{0.0f};
 
+    // Colorization split (rows per worker) for big grids
+    static constexpr size_t COLORIZE_MIN_CELLS_PER_THREAD = 64 * 1024;
+    int mColorizeThreads{1};
+    RLCharts::TaskPool* mpTaskPool{nullptr};
+
+    // Parallel binning: one private grid per binning thread, zero outside its
+    // touched box, summed into mCounts by mergeShards()
+    static constexpr size_t BIN_MIN_POINTS_PER_THREAD = 32 * 1024;
+    struct BinShard {
+        std::vector<float> mGrid;
+        RLCharts::CellRect mTouched;
+    };
+    int mBinThreads{1};
+    std::vector<BinShard> mShards;
+    std::vector<float> mShardPeaks; // per merge band, kept across frames
+    bool mShardsPending{false};
+
+    // GPU colormap resources
+    bool mGpuColormap{false};
+    bool mGpuReady{false};
+    std::atomic<bool> mGpuFailed{false};    // set by commit(), read by prepare()
+    bool mLutUploadDirty{true};
+    Shader mGpuShader{};
+    int mLocLut{-1};
+    int mLocInvMax{-1};
+    int mLocDecayScale{-1};
+    Texture2D mGridTexture{};
+    Texture2D mLutTexture{};
+
     void ensureGrid(int aCellsX, int aCellsY);
     void rebuildLUT();
-    void rebuildTextureIfNeeded();
-    void updateTexturePixels();
+    bool rebuildTextureIfNeeded();
+    void updateTexturePixels(RLCharts::UploadList& rUploads);
+    void colorizeRows(size_t aFirstCell, size_t aCellCount, float aInvMax, uint32_t* pPixels32) const;
+    void stageDirtyRect(RLCharts::UploadList& rUploads, const Texture2D* pTexture, const uint32_t* pGrid) const;
+    // State of the last prepare() alone, without the staging hand-off
+    [[nodiscard]] bool isPrepared() const;
+    [[nodiscard]] bool gpuPathWanted() const { return mGpuColormap && !mGpuFailed.load(std::memory_order_acquire); }
+    void markAllDirty();
+    bool ensureGpuResources();
+    void releaseGpuResources();
+    void foldDecayScale();
+    bool binPoints(std::span<const Vector2> aPoints, const float* pWeights);
+    static float binSlice(const Vector2* pPoints, const float* pWeights, size_t aCount, float aIncrement,
+                          int aCellsX, int aCellsY, float* pGrid, RLCharts::CellRect& rTouched);
+    [[nodiscard]] size_t binThreadCount(size_t aItems, size_t aMinItemsPerThread) const;
+    void mergeShards();
+    void discardShards();
 };
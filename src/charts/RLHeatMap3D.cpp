@@ -1,7 +1,9 @@
 // RLHeatMap3D.cpp
 #include "RLHeatMap3D.h"
 #include "RLCommon.h"
+#include "RLGpuColormap.h"
 #include "rlgl.h"
+#include "raymath.h"
 #include <algorithm>
 #include <cmath>
 #include <cstdio>
@@ -10,6 +12,8 @@ namespace {
     const int PERFORMANCE_WARNING_THRESHOLD = 65536; // 256x256
     const int LUT_SIZE = 256;
     const float BOX_SIZE = 1.0f; // Normalized box size (scaled at draw time)
+    const int SURFACE_CHUNK_CELLS = 128; // (128+1)^2 vertices fit 16-bit mesh indices
+    const int MAX_SURFACE_LOD = 4;       // Coarsest tile: vertex stride 16
 }
 
 RLHeatMap3D::RLHeatMap3D() {
@@ -28,9 +32,12 @@ RLHeatMap3D::RLHeatMap3D(int aWidth, int aHeight) : RLHeatMap3D() {
 RLHeatMap3D::~RLHeatMap3D() {
     freeMesh();
     freeScatterMesh();
+    freeInstanceResources();
 }
 
 void RLHeatMap3D::setGridSize(int aWidth, int aHeight) {
+    mRedrawPending = true;
+    mValuesSettled = false;
     if (aWidth < 2 || aHeight < 2) {
         TraceLog(LOG_WARNING, "RLHeatMap3D: Grid size must be at least 2x2");
         return;
@@ -64,52 +71,52 @@ void RLHeatMap3D::setGridSize(int aWidth, int aHeight) {
 
     freeMesh();
     freeScatterMesh();
+    freeInstanceResources();
+    // Staged frames target the old tiles and buffers
+    mStaging.discard();
+    mScatterMeshDirty = true;
     buildMesh();
 }
 
 bool RLHeatMap3D::setValues(int aWidth, int aHeight, const std::vector<float>& rValues) {
-    if (rValues.empty()) {
+    return setValues(aWidth, aHeight, std::span<const float>(rValues.data(), rValues.size()));
+}
+
+bool RLHeatMap3D::setValues(int aWidth, int aHeight, std::span<const float> aValues) {
+    if (aValues.empty()) {
         return false;
     }
 
     const size_t lExpectedSize = (size_t)aWidth * (size_t)aHeight;
-    if (rValues.size() != lExpectedSize) {
+    if (aValues.size() != lExpectedSize) {
         return false;
     }
+    mRedrawPending = true;
+    mValuesSettled = false;
 
     if (mWidth != aWidth || mHeight != aHeight) {
         setGridSize(aWidth, aHeight);
     }
 
-    mTargetValues = rValues;
+    mTargetValues.assign(aValues.begin(), aValues.end());
 
     if (mAutoRange) {
-        float lMin = mTargetValues[0];
-        float lMax = mTargetValues[0];
-        for (size_t i = 1; i < mTargetValues.size(); ++i) {
-            lMin = std::min(lMin, mTargetValues[i]);
-            lMax = std::max(lMax, mTargetValues[i]);
-        }
-        if (lMax - lMin < 1e-6f) {
-            lMax = lMin + 1.0f;
-        }
-        mMinValue = lMin;
-        mMaxValue = lMax;
-        mAxisMinZ = lMin;
-        mAxisMaxZ = lMax;
+        updateAutoRange();
     }
-
-    mMeshDirty = true;
     return true;
 }
 
 bool RLHeatMap3D::updatePartialValues(int aX, int aY, int aW, int aH, const std::vector<float>& rValues) {
-    if (rValues.empty() || aW <= 0 || aH <= 0) {
+    return updatePartialValues(aX, aY, aW, aH, std::span<const float>(rValues.data(), rValues.size()));
+}
+
+bool RLHeatMap3D::updatePartialValues(int aX, int aY, int aW, int aH, std::span<const float> aValues) {
+    if (aValues.empty() || aW <= 0 || aH <= 0) {
         return false;
     }
 
     const size_t lExpectedSize = (size_t)aW * (size_t)aH;
-    if (rValues.size() != lExpectedSize) {
+    if (aValues.size() != lExpectedSize) {
         return false;
     }
 
@@ -121,6 +128,8 @@ bool RLHeatMap3D::updatePartialValues(int aX, int aY, int aW, int aH, const std:
     if (lX0 >= lX1 || lY0 >= lY1) {
         return false;
     }
+    mRedrawPending = true;
+    mValuesSettled = false;
 
     for (int lY = lY0; lY < lY1; ++lY) {
         for (int lX = lX0; lX < lX1; ++lX) {
@@ -128,31 +137,19 @@ bool RLHeatMap3D::updatePartialValues(int aX, int aY, int aW, int aH, const std:
             const int lSrcY = lY - aY;
             const int lSrcIdx = lSrcY * aW + lSrcX;
             const int lDstIdx = lY * mWidth + lX;
-            mTargetValues[(size_t)lDstIdx] = rValues[(size_t)lSrcIdx];
+            mTargetValues[(size_t)lDstIdx] = aValues[(size_t)lSrcIdx];
         }
     }
 
+    // Only the animating cells' tiles are rewritten, unless the range moved
     if (mAutoRange && !mTargetValues.empty()) {
-        float lMin = mTargetValues[0];
-        float lMax = mTargetValues[0];
-        for (size_t i = 1; i < mTargetValues.size(); ++i) {
-            lMin = std::min(lMin, mTargetValues[i]);
-            lMax = std::max(lMax, mTargetValues[i]);
-        }
-        if (lMax - lMin < 1e-6f) {
-            lMax = lMin + 1.0f;
-        }
-        mMinValue = lMin;
-        mMaxValue = lMax;
-        mAxisMinZ = lMin;
-        mAxisMaxZ = lMax;
+        updateAutoRange();
     }
-
-    mMeshDirty = true;
     return true;
 }
 
 void RLHeatMap3D::setPalette(Color aColorA, Color aColorB, Color aColorC) {
+    mRedrawPending = true;
     mPaletteStops.clear();
     mPaletteStops.push_back(aColorA);
     mPaletteStops.push_back(aColorB);
@@ -161,6 +158,7 @@ void RLHeatMap3D::setPalette(Color aColorA, Color aColorB, Color aColorC) {
 }
 
 void RLHeatMap3D::setPalette(Color aColorA, Color aColorB, Color aColorC, Color aColorD) {
+    mRedrawPending = true;
     mPaletteStops.clear();
     mPaletteStops.push_back(aColorA);
     mPaletteStops.push_back(aColorB);
@@ -169,7 +167,15 @@ void RLHeatMap3D::setPalette(Color aColorA, Color aColorB, Color aColorC, Color
     mLutDirty = true;
 }
 
+void RLHeatMap3D::setPalette(RLCharts::ColormapPreset aPreset) {
+    mRedrawPending = true;
+    const RLCharts::ColormapStops lStops = RLCharts::colormapStops(aPreset);
+    mPaletteStops.assign(lStops.begin(), lStops.end());
+    mLutDirty = true;
+}
+
 void RLHeatMap3D::setValueRange(float aMinValue, float aMaxValue) {
+    mRedrawPending = true;
     mAutoRange = false;
     mMinValue = aMinValue;
     mMaxValue = aMaxValue;
@@ -183,107 +189,245 @@ void RLHeatMap3D::setValueRange(float aMinValue, float aMaxValue) {
 }
 
 void RLHeatMap3D::setAutoRange(bool aEnabled) {
+    mRedrawPending = true;
     mAutoRange = aEnabled;
     if (mAutoRange && !mTargetValues.empty()) {
-        float lMin = mTargetValues[0];
-        float lMax = mTargetValues[0];
-        for (size_t i = 1; i < mTargetValues.size(); ++i) {
-            lMin = std::min(lMin, mTargetValues[i]);
-            lMax = std::max(lMax, mTargetValues[i]);
-        }
-        if (lMax - lMin < 1e-6f) {
-            lMax = lMin + 1.0f;
-        }
-        mMinValue = lMin;
-        mMaxValue = lMax;
-        mAxisMinZ = lMin;
-        mAxisMaxZ = lMax;
+        updateAutoRange();
+    }
+}
+
+void RLHeatMap3D::updateAutoRange() {
+    float lMin = mTargetValues[0];
+    float lMax = mTargetValues[0];
+    for (size_t i = 1; i < mTargetValues.size(); ++i) {
+        lMin = std::min(lMin, mTargetValues[i]);
+        lMax = std::max(lMax, mTargetValues[i]);
+    }
+    if (lMax - lMin < 1e-6f) {
+        lMax = lMin + 1.0f;
+    }
+    // Every vertex height depends on the range
+    if (lMin != mMinValue || lMax != mMaxValue) {
         mMeshDirty = true;
     }
+    mMinValue = lMin;
+    mMaxValue = lMax;
+    mAxisMinZ = lMin;
+    mAxisMaxZ = lMax;
 }
 
 void RLHeatMap3D::setAxisRangeX(float aMin, float aMax) {
+    mRedrawPending = true;
     mAxisMinX = aMin;
     mAxisMaxX = aMax;
 }
 
 void RLHeatMap3D::setAxisRangeY(float aMin, float aMax) {
+    mRedrawPending = true;
     mAxisMinY = aMin;
     mAxisMaxY = aMax;
 }
 
 void RLHeatMap3D::setAxisRangeZ(float aMin, float aMax) {
+    mRedrawPending = true;
     mAxisMinZ = aMin;
     mAxisMaxZ = aMax;
 }
 
 void RLHeatMap3D::setAxisLabels(const char* pLabelX, const char* pLabelY, const char* pLabelZ) {
+    mRedrawPending = true;
     mpLabelX = pLabelX;
     mpLabelY = pLabelY;
     mpLabelZ = pLabelZ;
 }
 
 void RLHeatMap3D::setMode(RLHeatMap3DMode aMode) {
+    mRedrawPending = true;
+    mValuesSettled = false;
+    // Surface tiles and scatter vertices are not maintained in the other mode
+    if (aMode != mStyle.mMode) {
+        mMeshDirty = true;
+        mScatterMeshDirty = true;
+    }
     mStyle.mMode = aMode;
 }
 
 void RLHeatMap3D::setSmoothing(float aSpeed) {
+    mRedrawPending = true;
     mStyle.mSmoothingSpeed = aSpeed > 0.0f ? aSpeed : 0.0f;
 }
 
 void RLHeatMap3D::setWireframe(bool aEnabled) {
+    mRedrawPending = true;
     mStyle.mShowWireframe = aEnabled;
 }
 
 void RLHeatMap3D::setPointSize(float aSize) {
+    mRedrawPending = true;
     mStyle.mPointSize = aSize > 0.0f ? aSize : 0.01f;
     mScatterMeshDirty = true;
 }
 
+void RLHeatMap3D::setInstancedScatter(bool aEnabled) {
+    if (aEnabled == mInstancedScatter) {
+        return;
+    }
+    mRedrawPending = true;
+    mInstancedScatter = aEnabled;
+    mInstanceFailed = false;
+    if (aEnabled) {
+        freeScatterMesh();
+    } else {
+        freeInstanceResources();
+    }
+    mScatterMeshDirty = true;
+}
+
 void RLHeatMap3D::setStyle(const RLHeatMap3DStyle& rStyle) {
+    mRedrawPending = true;
     mStyle = rStyle;
     mMeshDirty = true;
     mScatterMeshDirty = true;
 }
 
+bool RLHeatMap3D::isPrepared() const {
+    if (!mValuesSettled || mLutDirty) {
+        return false;
+    }
+    if (mStyle.mMode != RLHeatMap3DMode::Surface) {
+        return !mScatterMeshDirty;
+    }
+    if (mMeshDirty) {
+        return false;
+    }
+    for (const SurfaceChunk& rChunk : mChunks) {
+        if (rChunk.mDirty || std::atomic_ref<int>(rChunk.mWantedLod).load(std::memory_order_relaxed) != rChunk.mLod) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool RLHeatMap3D::isSettled() const {
+    if (mStaging.hasPending() || mRestageAll.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    if (mStyle.mMode != RLHeatMap3DMode::Surface && instancedWanted() != mPreparedInstanced) {
+        return false;
+    }
+    return isPrepared();
+}
+
 void RLHeatMap3D::update(float aDt) {
+    prepare(aDt);
+    commit();
+}
+
+void RLHeatMap3D::prepare(float aDt) {
+    RLCHARTS_PERF_UPDATE(mPerf, "RLHeatMap3D::prepare");
+    if (mRestageAll.exchange(false)) {
+        mScatterMeshDirty = true;
+    }
+    const bool lInstanced = instancedWanted();
+    if (mStyle.mMode != RLHeatMap3DMode::Surface && lInstanced != mPreparedInstanced) {
+        // Switching between instances and the scatter mesh: fill the new buffers
+        mPreparedInstanced = lInstanced;
+        mScatterMeshDirty = true;
+    }
+    if (isPrepared()) {
+        mLastUploadedChunks = 0;
+        return;
+    }
+
     if (mLutDirty) {
         rebuildLut();
+        mMeshDirty = true; // Recolor every tile
+        mScatterMeshDirty = true;
     }
 
     if (mWidth <= 0 || mHeight <= 0) {
+        mValuesSettled = true;
         return;
     }
+    StagedFrame& rFrame = mStaging.beginPrepare();
 
     const float lAlpha = 1.0f - expf(-mStyle.mSmoothingSpeed * aDt);
+    const bool lSurface = mStyle.mMode == RLHeatMap3DMode::Surface && !mChunks.empty();
     bool lChanged = false;
 
-    for (size_t i = 0; i < mCurrentValues.size(); ++i) {
-        const float lDiff = mTargetValues[i] - mCurrentValues[i];
-        if (fabsf(lDiff) > 1e-6f) {
-            mCurrentValues[i] += lDiff * lAlpha;
-            lChanged = true;
+    if (lSurface) {
+        // Animate tile by tile so only tiles with moving vertices get rewritten.
+        // A tile's first column is shared with its left neighbour: step it alone.
+        for (int lY = 0; lY < mHeight; ++lY) {
+            float* pCur = mCurrentValues.data() + (size_t)lY * (size_t)mWidth;
+            const float* pTarget = mTargetValues.data() + (size_t)lY * (size_t)mWidth;
+            for (int lCx = 0; lCx < mChunksX; ++lCx) {
+                const int lX0 = lCx * SURFACE_CHUNK_CELLS;
+                const int lX1 = lCx + 1 == mChunksX ? mWidth : lX0 + SURFACE_CHUNK_CELLS;
+                if (!RLCharts::approachArray(pCur + lX0, pTarget + lX0, 1, lAlpha)) {
+                    markVertexDirty(lX0, lY);
+                    lChanged = true;
+                }
+                if (!RLCharts::approachArray(pCur + lX0 + 1, pTarget + lX0 + 1, (size_t)(lX1 - lX0 - 1), lAlpha)) {
+                    markVertexDirty(lX0 + 1, lY);
+                    lChanged = true;
+                }
+            }
         }
+    } else {
+        lChanged = !RLCharts::approachArray(mCurrentValues.data(), mTargetValues.data(), mCurrentValues.size(), lAlpha);
     }
+    mValuesSettled = !lChanged;
 
-    if (mStyle.mMode == RLHeatMap3DMode::Surface) {
-        if (lChanged || mMeshDirty) {
-            updateMeshVertices();
+    rFrame.mSurface = mStyle.mMode == RLHeatMap3DMode::Surface;
+    rFrame.mInstanced = lInstanced;
+    if (rFrame.mSurface) {
+        if (mMeshDirty) {
+            markAllChunksDirty();
             mMeshDirty = false;
         }
-    } else {
-        // Scatter mode - build mesh on demand if not yet created
-        if (!mScatterMeshValid) {
-            const_cast<RLHeatMap3D*>(this)->buildScatterMesh();
+        updateMeshVertices(rFrame);
+    } else if (lChanged || mScatterMeshDirty) {
+        if (lInstanced) {
+            updateInstanceData(rFrame.mUploads);
+        } else {
+            updateScatterMeshVertices(rFrame.mUploads);
         }
-        if (lChanged || mScatterMeshDirty) {
-            const_cast<RLHeatMap3D*>(this)->updateScatterMeshVertices();
-            mScatterMeshDirty = false;
+        rFrame.mScatter = true;
+        mScatterMeshDirty = false;
+    }
+    mStaging.endPrepare();
+}
+
+void RLHeatMap3D::commit() {
+    StagedFrame* pFrame = mStaging.beginCommit();
+    if (pFrame == nullptr) {
+        return;
+    }
+
+    // Tiles whose level changed get new meshes; their staged vertices cover them fully
+    for (const ChunkBuild& rBuild : pFrame->mChunkBuilds) {
+        buildChunk(mChunks[rBuild.mChunk], rBuild);
+    }
+    if (!pFrame->mSurface) {
+        // New scatter buffers start empty: unless this frame fills them, restage
+        const bool lHadBuffers = pFrame->mInstanced ? mInstanceReady : mScatterMeshValid;
+        const bool lReady = pFrame->mInstanced ? ensureInstanceResources() : buildScatterMesh();
+        if (lReady && !lHadBuffers && !pFrame->mScatter) {
+            mRestageAll = true;
         }
+        mDrawInstanced = pFrame->mInstanced && lReady;
     }
+    [[maybe_unused]] const size_t lSent = pFrame->mUploads.replay();
+    RLCHARTS_PERF_UPLOAD(mPerf, lSent);
+
+    mRedrawPending = true;
+    mStaging.endCommit();
 }
 
 void RLHeatMap3D::draw(Vector3 aPosition, float aScale, const Camera3D& rCamera) const {
+    RLCHARTS_PERF_DRAW(mPerf, "RLHeatMap3D::draw");
+    mRedrawPending = false;
     if (mWidth <= 0 || mHeight <= 0) {
         return;
     }
@@ -295,7 +439,9 @@ void RLHeatMap3D::draw(Vector3 aPosition, float aScale, const Camera3D& rCamera)
 
     // Draw data (surface or scatter) - this is the main content
     if (mStyle.mMode == RLHeatMap3DMode::Surface) {
-        drawSurface(aPosition, aScale);
+        drawSurface(aPosition, aScale, rCamera);
+    } else if (mDrawInstanced && isInstancedScatterActive()) {
+        drawScatterInstanced(aPosition, aScale);
     } else {
         drawScatterPoints(aPosition, aScale);
     }
@@ -486,7 +632,7 @@ void RLHeatMap3D::drawAxisBox(Vector3 aPosition, float aScale, const Camera3D& r
     }
 }
 
-void RLHeatMap3D::drawSurface(Vector3 aPosition, float aScale) const {
+void RLHeatMap3D::drawSurface(Vector3 aPosition, float aScale, const Camera3D& rCamera) const {
     if (!mMeshValid) {
         return;
     }
@@ -494,18 +640,62 @@ void RLHeatMap3D::drawSurface(Vector3 aPosition, float aScale) const {
     // Disable backface culling so the surface is visible from all angles
     rlDisableBackfaceCulling();
 
-    DrawModelEx(mModel, aPosition, Vector3{0, 1, 0}, 0.0f,
-                Vector3{aScale, aScale, aScale}, WHITE);
-
-    if (mStyle.mShowWireframe) {
-        DrawModelWiresEx(mModel, aPosition, Vector3{0, 1, 0}, 0.0f,
-                         Vector3{aScale, aScale, aScale}, mStyle.mWireframeColor);
+    const Vector3 lScale = {aScale, aScale, aScale};
+    const int lCellsX = mWidth - 1;
+    const int lCellsY = mHeight - 1;
+    for (const SurfaceChunk& rChunk : mChunks) {
+        // Request a level from the tile center's camera distance; prepare() applies it
+        int lWantedLod = 0;
+        if (mStyle.mLodDistance > 0.0f) {
+            const float lU = ((float)(rChunk.mCellX0 + rChunk.mCellX1) * 0.5f / (float)lCellsX - 0.5f) * BOX_SIZE;
+            const float lV = ((float)(rChunk.mCellY0 + rChunk.mCellY1) * 0.5f / (float)lCellsY - 0.5f) * BOX_SIZE;
+            const float lDx = aPosition.x + lU * aScale - rCamera.position.x;
+            const float lDy = aPosition.y + BOX_SIZE * 0.5f * aScale - rCamera.position.y;
+            const float lDz = aPosition.z + lV * aScale - rCamera.position.z;
+            const float lDistance = sqrtf(lDx * lDx + lDy * lDy + lDz * lDz);
+            if (lDistance > mStyle.mLodDistance) {
+                const int lLod = (int)floorf(log2f(lDistance / mStyle.mLodDistance)) + 1;
+                lWantedLod = std::min(lLod, MAX_SURFACE_LOD);
+            }
+        }
+        std::atomic_ref<int>(rChunk.mWantedLod).store(lWantedLod, std::memory_order_relaxed);
+        if (rChunk.mModelLod < 0) {
+            continue;
+        }
+        DrawModelEx(rChunk.mModel, aPosition, Vector3{0, 1, 0}, 0.0f, lScale, WHITE);
+        RLCHARTS_PERF_DRAW_CALLS(mPerf, 1);
+        if (mStyle.mShowWireframe) {
+            DrawModelWiresEx(rChunk.mModel, aPosition, Vector3{0, 1, 0}, 0.0f, lScale, mStyle.mWireframeColor);
+            RLCHARTS_PERF_DRAW_CALLS(mPerf, 1);
+        }
     }
 
     // Re-enable backface culling for other rendering
     rlEnableBackfaceCulling();
 }
 
+void RLHeatMap3D::drawScatterInstanced(Vector3 aPosition, float aScale) const {
+    // Flush batched lines (floor grid) before switching to the instancing shader
+    rlDrawRenderBatchActive();
+    rlDisableBackfaceCulling();
+
+    // Same transform DrawModelEx would apply
+    Matrix lModel = MatrixMultiply(MatrixScale(aScale, aScale, aScale),
+                                   MatrixTranslate(aPosition.x, aPosition.y, aPosition.z));
+    lModel = MatrixMultiply(lModel, rlGetMatrixTransform());
+    const Matrix lMvp = MatrixMultiply(MatrixMultiply(lModel, rlGetMatrixModelview()), rlGetMatrixProjection());
+
+    rlEnableShader(mInstanceShader.id);
+    rlSetUniformMatrix(mLocInstanceMvp, lMvp);
+    rlEnableVertexArray(mInstanceVao);
+    rlDrawVertexArrayInstanced(0, 36, mInstanceCount);
+    RLCHARTS_PERF_DRAW_CALLS(mPerf, 1);
+    rlDisableVertexArray();
+    rlDisableShader();
+
+    rlEnableBackfaceCulling();
+}
+
 void RLHeatMap3D::drawScatterPoints(Vector3 aPosition, float aScale) const {
     if (!mScatterMeshValid) {
         return;
@@ -517,6 +707,7 @@ void RLHeatMap3D::drawScatterPoints(Vector3 aPosition, float aScale) const {
 
     DrawModelEx(mScatterModel, aPosition, Vector3{0, 1, 0}, 0.0f,
                 Vector3{aScale, aScale, aScale}, WHITE);
+    RLCHARTS_PERF_DRAW_CALLS(mPerf, 1);
 
     rlEnableBackfaceCulling();
 }
@@ -568,21 +759,7 @@ void RLHeatMap3D::rebuildLut() {
         return;
     }
 
-    const int lNumStops = (int)mPaletteStops.size();
-    for (int i = 0; i < LUT_SIZE; ++i) {
-        const float lT = (float)i / (float)(LUT_SIZE - 1);
-        const float lScaled = lT * (float)(lNumStops - 1);
-        int lIdx0 = (int)lScaled;
-        int lIdx1 = lIdx0 + 1;
-        if (lIdx1 >= lNumStops) {
-            lIdx1 = lNumStops - 1;
-            lIdx0 = lIdx1 - 1;
-        }
-        lIdx0 = std::max(lIdx0, 0);
-
-        const float lLocalT = lScaled - (float)lIdx0;
-        mLut[i] = RLCharts::lerpColor(mPaletteStops[(size_t)lIdx0], mPaletteStops[(size_t)lIdx1], lLocalT);
-    }
+    RLCharts::buildStopLut(mPaletteStops.data(), mPaletteStops.size(), mLut, LUT_SIZE);
 
     mLutDirty = false;
 }
@@ -594,166 +771,262 @@ void RLHeatMap3D::buildMesh() {
 
     freeMesh();
 
+    // Tile layout only; the tile meshes are built by the next update()
     const int lCellsX = mWidth - 1;
     const int lCellsY = mHeight - 1;
-    const int lTriangleCount = lCellsX * lCellsY * 2;
-    const int lVertexCount = lTriangleCount * 3;
-
-    mMesh.triangleCount = lTriangleCount;
-    mMesh.vertexCount = lVertexCount;
+    mChunksX = (lCellsX + SURFACE_CHUNK_CELLS - 1) / SURFACE_CHUNK_CELLS;
+    mChunksY = (lCellsY + SURFACE_CHUNK_CELLS - 1) / SURFACE_CHUNK_CELLS;
+    mChunks.resize((size_t)mChunksX * (size_t)mChunksY);
+    for (int lCy = 0; lCy < mChunksY; ++lCy) {
+        for (int lCx = 0; lCx < mChunksX; ++lCx) {
+            SurfaceChunk& rChunk = mChunks[(size_t)lCy * (size_t)mChunksX + (size_t)lCx];
+            rChunk.mCellX0 = lCx * SURFACE_CHUNK_CELLS;
+            rChunk.mCellY0 = lCy * SURFACE_CHUNK_CELLS;
+            rChunk.mCellX1 = std::min(rChunk.mCellX0 + SURFACE_CHUNK_CELLS, lCellsX);
+            rChunk.mCellY1 = std::min(rChunk.mCellY0 + SURFACE_CHUNK_CELLS, lCellsY);
+        }
+    }
 
-    mMesh.vertices = (float*)MemAlloc((size_t)lVertexCount * 3 * sizeof(float));
-    mMesh.normals = (float*)MemAlloc((size_t)lVertexCount * 3 * sizeof(float));
-    mMesh.colors = (unsigned char*)MemAlloc((size_t)lVertexCount * 4 * sizeof(unsigned char));
+    mMeshValid = true;
+    mMeshDirty = false;
+}
 
-    // Initialize with current values
-    updateMeshVertices();
+void RLHeatMap3D::updateMeshVertices(StagedFrame& rFrame) {
+    RLCHARTS_PERF_REBUILD(mPerf, "RLHeatMap3D::updateMeshVertices");
+    mLastUploadedChunks = 0;
+    if (!mMeshValid) {
+        return;
+    }
 
-    // Calculate normals
-    for (int i = 0; i < lVertexCount; ++i) {
-        mMesh.normals[(size_t)i * 3 + 0] = 0.0f;
-        mMesh.normals[(size_t)i * 3 + 1] = 1.0f;
-        mMesh.normals[(size_t)i * 3 + 2] = 0.0f;
+    // Apply the levels of detail requested by the last draw. A level change also
+    // dirties the neighbours, whose shared edges follow the coarser side.
+    for (int lCy = 0; lCy < mChunksY; ++lCy) {
+        for (int lCx = 0; lCx < mChunksX; ++lCx) {
+            SurfaceChunk& rChunk = mChunks[(size_t)lCy * (size_t)mChunksX + (size_t)lCx];
+            if (rChunk.mLod >= 0 && std::atomic_ref<int>(rChunk.mWantedLod).load(std::memory_order_relaxed) == rChunk.mLod) {
+                continue;
+            }
+            rChunk.mLod = -1;
+            rChunk.mDirty = true;
+            if (lCx > 0) mChunks[(size_t)lCy * (size_t)mChunksX + (size_t)lCx - 1].mDirty = true;
+            if (lCx + 1 < mChunksX) mChunks[(size_t)lCy * (size_t)mChunksX + (size_t)lCx + 1].mDirty = true;
+            if (lCy > 0) mChunks[(size_t)(lCy - 1) * (size_t)mChunksX + (size_t)lCx].mDirty = true;
+            if (lCy + 1 < mChunksY) mChunks[(size_t)(lCy + 1) * (size_t)mChunksX + (size_t)lCx].mDirty = true;
+        }
+    }
+    // Levels first so edge stitching sees the final neighbour levels; commit()
+    // builds the new meshes before uploading their vertices
+    for (size_t i = 0; i < mChunks.size(); ++i) {
+        SurfaceChunk& rChunk = mChunks[i];
+        if (rChunk.mLod < 0) {
+            rChunk.mLod = std::atomic_ref<int>(rChunk.mWantedLod).load(std::memory_order_relaxed);
+            buildChunkSamples(rChunk);
+            rFrame.mChunkBuilds.push_back(ChunkBuild{ i, rChunk.mLod, (int)mSampleX.size(), (int)mSampleY.size() });
+        }
     }
 
-    UploadMesh(&mMesh, true);
-    mModel = LoadModelFromMesh(mMesh);
+    for (SurfaceChunk& rChunk : mChunks) {
+        if (!rChunk.mDirty) {
+            continue;
+        }
+        buildChunkSamples(rChunk);
+        const size_t lVertexCount = mSampleX.size() * mSampleY.size();
+        auto* pVertices = static_cast<float*>(rFrame.mUploads.meshBuffer(&rChunk.mMesh, 0, lVertexCount * 3 * sizeof(float)));
+        auto* pColors = static_cast<unsigned char*>(rFrame.mUploads.meshBuffer(&rChunk.mMesh, 3, lVertexCount * 4));
+        writeChunkVertices(rChunk, pVertices, pColors);
+        rChunk.mDirty = false;
+        mLastUploadedChunks++;
+    }
+}
 
-    mMeshValid = true;
-    mMeshDirty = false;
+void RLHeatMap3D::buildChunkSamples(const SurfaceChunk& rChunk) {
+    // Sample columns/rows at the chunk's stride, always including the far edge
+    const int lStride = 1 << rChunk.mLod;
+    mSampleX.clear();
+    for (int i = rChunk.mCellX0; i < rChunk.mCellX1; i += lStride) {
+        mSampleX.push_back(i);
+    }
+    mSampleX.push_back(rChunk.mCellX1);
+    mSampleY.clear();
+    for (int i = rChunk.mCellY0; i < rChunk.mCellY1; i += lStride) {
+        mSampleY.push_back(i);
+    }
+    mSampleY.push_back(rChunk.mCellY1);
 }
 
-void RLHeatMap3D::updateMeshVertices() {
-    if (mWidth < 2 || mHeight < 2) {
-        return;
+void RLHeatMap3D::buildChunk(SurfaceChunk& rChunk, const ChunkBuild& rBuild) {
+    if (rChunk.mModelLod >= 0) {
+        UnloadModel(rChunk.mModel);
+        rChunk.mModel = Model{};
+        rChunk.mMesh = Mesh{};
+        rChunk.mModelLod = -1;
     }
 
-    // If mesh not built yet, just mark dirty
-    if (!mMeshValid && mMesh.vertices == nullptr) {
-        return;
+    const int lNx = rBuild.mSamplesX;
+    const int lNy = rBuild.mSamplesY;
+    const int lQuads = (lNx - 1) * (lNy - 1);
+
+    // Positions and colors are zero here; the staged frame uploads them
+    Mesh lMesh{};
+    lMesh.vertexCount = lNx * lNy;
+    lMesh.triangleCount = lQuads * 2;
+    lMesh.vertices = (float*)MemAlloc((size_t)lMesh.vertexCount * 3 * sizeof(float));
+    lMesh.normals = (float*)MemAlloc((size_t)lMesh.vertexCount * 3 * sizeof(float));
+    lMesh.colors = (unsigned char*)MemAlloc((size_t)lMesh.vertexCount * 4 * sizeof(unsigned char));
+    lMesh.indices = (unsigned short*)MemAlloc((size_t)lQuads * 6 * sizeof(unsigned short));
+
+    for (int i = 0; i < lMesh.vertexCount; ++i) {
+        lMesh.normals[(size_t)i * 3 + 0] = 0.0f;
+        lMesh.normals[(size_t)i * 3 + 1] = 1.0f;
+        lMesh.normals[(size_t)i * 3 + 2] = 0.0f;
     }
 
+    // Triangle 1: (0,0), (1,0), (0,1); Triangle 2: (1,0), (1,1), (0,1)
+    size_t lIdx = 0;
+    for (int lJ = 0; lJ + 1 < lNy; ++lJ) {
+        for (int lI = 0; lI + 1 < lNx; ++lI) {
+            const auto lV00 = (unsigned short)(lJ * lNx + lI);
+            const auto lV10 = (unsigned short)(lV00 + 1);
+            const auto lV01 = (unsigned short)(lV00 + lNx);
+            const auto lV11 = (unsigned short)(lV01 + 1);
+            lMesh.indices[lIdx++] = lV00;
+            lMesh.indices[lIdx++] = lV10;
+            lMesh.indices[lIdx++] = lV01;
+            lMesh.indices[lIdx++] = lV10;
+            lMesh.indices[lIdx++] = lV11;
+            lMesh.indices[lIdx++] = lV01;
+        }
+    }
+
+    UploadMesh(&lMesh, true);
+    rChunk.mModel = LoadModelFromMesh(lMesh);
+    // The model's copy shares the buffer ids the staged uploads resolve
+    rChunk.mMesh = lMesh;
+    rChunk.mModelLod = rBuild.mLod;
+}
+
+void RLHeatMap3D::writeChunkVertices(const SurfaceChunk& rChunk, float* pVertices, unsigned char* pColors) {
+    // Expects mSampleX/mSampleY from buildChunkSamples(rChunk)
+    const int lStride = 1 << rChunk.mLod;
+
+    // Neighbour levels: a shared edge uses the coarser stride of the two tiles
+    const int lCx = rChunk.mCellX0 / SURFACE_CHUNK_CELLS;
+    const int lCy = rChunk.mCellY0 / SURFACE_CHUNK_CELLS;
+    const int lStrideTop = 1 << std::max(rChunk.mLod, chunkLod(lCx, lCy - 1));
+    const int lStrideBottom = 1 << std::max(rChunk.mLod, chunkLod(lCx, lCy + 1));
+    const int lStrideLeft = 1 << std::max(rChunk.mLod, chunkLod(lCx - 1, lCy));
+    const int lStrideRight = 1 << std::max(rChunk.mLod, chunkLod(lCx + 1, lCy));
+
     const int lCellsX = mWidth - 1;
     const int lCellsY = mHeight - 1;
     const float lHalfSize = BOX_SIZE * 0.5f;
     const float lHeight = BOX_SIZE;
-
-    int lVertIdx = 0;
-    for (int lCy = 0; lCy < lCellsY; ++lCy) {
-        for (int lCx = 0; lCx < lCellsX; ++lCx) {
-            // Grid positions mapped to [-halfSize, +halfSize]
-            const float lX0 = -lHalfSize + ((float)lCx / (float)lCellsX) * lHalfSize * 2.0f;
-            const float lX1 = -lHalfSize + ((float)(lCx + 1) / (float)lCellsX) * lHalfSize * 2.0f;
-            const float lZ0 = -lHalfSize + ((float)lCy / (float)lCellsY) * lHalfSize * 2.0f;
-            const float lZ1 = -lHalfSize + ((float)(lCy + 1) / (float)lCellsY) * lHalfSize * 2.0f;
-
-            const int lIdx00 = lCy * mWidth + lCx;
-            const int lIdx10 = lCy * mWidth + (lCx + 1);
-            const int lIdx01 = (lCy + 1) * mWidth + lCx;
-            const int lIdx11 = (lCy + 1) * mWidth + (lCx + 1);
-
-            const float lN00 = normalizeValue(mCurrentValues[(size_t)lIdx00]);
-            const float lN10 = normalizeValue(mCurrentValues[(size_t)lIdx10]);
-            const float lN01 = normalizeValue(mCurrentValues[(size_t)lIdx01]);
-            const float lN11 = normalizeValue(mCurrentValues[(size_t)lIdx11]);
-
-            const float lH00 = lN00 * lHeight;
-            const float lH10 = lN10 * lHeight;
-            const float lH01 = lN01 * lHeight;
-            const float lH11 = lN11 * lHeight;
-
-            Color lC00 = getColorForValue(lN00);
-            Color lC10 = getColorForValue(lN10);
-            Color lC01 = getColorForValue(lN01);
-            Color lC11 = getColorForValue(lN11);
-
+    const auto lAlpha = (unsigned char)(mStyle.mSurfaceOpacity * 255.0f);
+
+    size_t lV = 0;
+    for (const int lY : mSampleY) {
+        // Grid positions mapped to [-halfSize, +halfSize]
+        const float lZ = -lHalfSize + ((float)lY / (float)lCellsY) * lHalfSize * 2.0f;
+        for (const int lX : mSampleX) {
+            const float lXPos = -lHalfSize + ((float)lX / (float)lCellsX) * lHalfSize * 2.0f;
+
+            float lN;
+            if (lY == rChunk.mCellY0 && lStrideTop > lStride) {
+                lN = edgeSample(lX, lY, rChunk.mCellX0, rChunk.mCellX1, lStrideTop, true);
+            } else if (lY == rChunk.mCellY1 && lStrideBottom > lStride) {
+                lN = edgeSample(lX, lY, rChunk.mCellX0, rChunk.mCellX1, lStrideBottom, true);
+            } else if (lX == rChunk.mCellX0 && lStrideLeft > lStride) {
+                lN = edgeSample(lX, lY, rChunk.mCellY0, rChunk.mCellY1, lStrideLeft, false);
+            } else if (lX == rChunk.mCellX1 && lStrideRight > lStride) {
+                lN = edgeSample(lX, lY, rChunk.mCellY0, rChunk.mCellY1, lStrideRight, false);
+            } else {
+                lN = normalizeValue(mCurrentValues[(size_t)lY * (size_t)mWidth + (size_t)lX]);
+            }
+
+            Color lC = getColorForValue(lN);
             // Apply surface opacity
-            lC00.a = (unsigned char)(mStyle.mSurfaceOpacity * 255.0f);
-            lC10.a = (unsigned char)(mStyle.mSurfaceOpacity * 255.0f);
-            lC01.a = (unsigned char)(mStyle.mSurfaceOpacity * 255.0f);
-            lC11.a = (unsigned char)(mStyle.mSurfaceOpacity * 255.0f);
-
-            // Triangle 1: (0,0), (1,0), (0,1)
-            mMesh.vertices[(size_t)lVertIdx * 3 + 0] = lX0;
-            mMesh.vertices[(size_t)lVertIdx * 3 + 1] = lH00;
-            mMesh.vertices[(size_t)lVertIdx * 3 + 2] = lZ0;
-            mMesh.colors[(size_t)lVertIdx * 4 + 0] = lC00.r;
-            mMesh.colors[(size_t)lVertIdx * 4 + 1] = lC00.g;
-            mMesh.colors[(size_t)lVertIdx * 4 + 2] = lC00.b;
-            mMesh.colors[(size_t)lVertIdx * 4 + 3] = lC00.a;
-            lVertIdx++;
-
-            mMesh.vertices[(size_t)lVertIdx * 3 + 0] = lX1;
-            mMesh.vertices[(size_t)lVertIdx * 3 + 1] = lH10;
-            mMesh.vertices[(size_t)lVertIdx * 3 + 2] = lZ0;
-            mMesh.colors[(size_t)lVertIdx * 4 + 0] = lC10.r;
-            mMesh.colors[(size_t)lVertIdx * 4 + 1] = lC10.g;
-            mMesh.colors[(size_t)lVertIdx * 4 + 2] = lC10.b;
-            mMesh.colors[(size_t)lVertIdx * 4 + 3] = lC10.a;
-            lVertIdx++;
-
-            mMesh.vertices[(size_t)lVertIdx * 3 + 0] = lX0;
-            mMesh.vertices[(size_t)lVertIdx * 3 + 1] = lH01;
-            mMesh.vertices[(size_t)lVertIdx * 3 + 2] = lZ1;
-            mMesh.colors[(size_t)lVertIdx * 4 + 0] = lC01.r;
-            mMesh.colors[(size_t)lVertIdx * 4 + 1] = lC01.g;
-            mMesh.colors[(size_t)lVertIdx * 4 + 2] = lC01.b;
-            mMesh.colors[(size_t)lVertIdx * 4 + 3] = lC01.a;
-            lVertIdx++;
+            lC.a = lAlpha;
+
+            pVertices[lV * 3 + 0] = lXPos;
+            pVertices[lV * 3 + 1] = lN * lHeight;
+            pVertices[lV * 3 + 2] = lZ;
+            pColors[lV * 4 + 0] = lC.r;
+            pColors[lV * 4 + 1] = lC.g;
+            pColors[lV * 4 + 2] = lC.b;
+            pColors[lV * 4 + 3] = lC.a;
+            lV++;
+        }
+    }
+}
 
-            // Triangle 2: (1,0), (1,1), (0,1)
-            mMesh.vertices[(size_t)lVertIdx * 3 + 0] = lX1;
-            mMesh.vertices[(size_t)lVertIdx * 3 + 1] = lH10;
-            mMesh.vertices[(size_t)lVertIdx * 3 + 2] = lZ0;
-            mMesh.colors[(size_t)lVertIdx * 4 + 0] = lC10.r;
-            mMesh.colors[(size_t)lVertIdx * 4 + 1] = lC10.g;
-            mMesh.colors[(size_t)lVertIdx * 4 + 2] = lC10.b;
-            mMesh.colors[(size_t)lVertIdx * 4 + 3] = lC10.a;
-            lVertIdx++;
+float RLHeatMap3D::edgeSample(int aX, int aY, int aFixed0, int aFixed1, int aStride, bool aAlongX) const {
+    // Linear interpolation between the coarser neighbour's samples along an edge,
+    // so both tiles produce the same edge and no cracks open between levels
+    const int lPos = aAlongX ? aX : aY;
+    const int lP0 = aFixed0 + ((lPos - aFixed0) / aStride) * aStride;
+    const int lP1 = std::min(lP0 + aStride, aFixed1);
+    auto sampleAt = [&](int aP) {
+        const int lSx = aAlongX ? aP : aX;
+        const int lSy = aAlongX ? aY : aP;
+        return normalizeValue(mCurrentValues[(size_t)lSy * (size_t)mWidth + (size_t)lSx]);
+    };
+    if (lP1 == lP0) {
+        return sampleAt(lP0);
+    }
+    const float lT = (float)(lPos - lP0) / (float)(lP1 - lP0);
+    return RLCharts::lerpF(sampleAt(lP0), sampleAt(lP1), lT);
+}
 
-            mMesh.vertices[(size_t)lVertIdx * 3 + 0] = lX1;
-            mMesh.vertices[(size_t)lVertIdx * 3 + 1] = lH11;
-            mMesh.vertices[(size_t)lVertIdx * 3 + 2] = lZ1;
-            mMesh.colors[(size_t)lVertIdx * 4 + 0] = lC11.r;
-            mMesh.colors[(size_t)lVertIdx * 4 + 1] = lC11.g;
-            mMesh.colors[(size_t)lVertIdx * 4 + 2] = lC11.b;
-            mMesh.colors[(size_t)lVertIdx * 4 + 3] = lC11.a;
-            lVertIdx++;
+int RLHeatMap3D::chunkLod(int aChunkX, int aChunkY) const {
+    if (aChunkX < 0 || aChunkY < 0 || aChunkX >= mChunksX || aChunkY >= mChunksY) {
+        return 0;
+    }
+    const SurfaceChunk& rChunk = mChunks[(size_t)aChunkY * (size_t)mChunksX + (size_t)aChunkX];
+    return rChunk.mLod >= 0 ? rChunk.mLod : std::atomic_ref<int>(rChunk.mWantedLod).load(std::memory_order_relaxed);
+}
 
-            mMesh.vertices[(size_t)lVertIdx * 3 + 0] = lX0;
-            mMesh.vertices[(size_t)lVertIdx * 3 + 1] = lH01;
-            mMesh.vertices[(size_t)lVertIdx * 3 + 2] = lZ1;
-            mMesh.colors[(size_t)lVertIdx * 4 + 0] = lC01.r;
-            mMesh.colors[(size_t)lVertIdx * 4 + 1] = lC01.g;
-            mMesh.colors[(size_t)lVertIdx * 4 + 2] = lC01.b;
-            mMesh.colors[(size_t)lVertIdx * 4 + 3] = lC01.a;
-            lVertIdx++;
-        }
+void RLHeatMap3D::markVertexDirty(int aX, int aY) {
+    if (mChunks.empty()) {
+        return;
     }
+    // A vertex on a tile border belongs to the tiles on both sides
+    const int lCx = std::min(aX / SURFACE_CHUNK_CELLS, mChunksX - 1);
+    const int lCy = std::min(aY / SURFACE_CHUNK_CELLS, mChunksY - 1);
+    const bool lLeft = lCx > 0 && aX == lCx * SURFACE_CHUNK_CELLS;
+    const bool lUp = lCy > 0 && aY == lCy * SURFACE_CHUNK_CELLS;
+    const size_t lStride = (size_t)mChunksX;
+    mChunks[(size_t)lCy * lStride + (size_t)lCx].mDirty = true;
+    if (lLeft) mChunks[(size_t)lCy * lStride + (size_t)lCx - 1].mDirty = true;
+    if (lUp) mChunks[(size_t)(lCy - 1) * lStride + (size_t)lCx].mDirty = true;
+    if (lLeft && lUp) mChunks[(size_t)(lCy - 1) * lStride + (size_t)lCx - 1].mDirty = true;
+}
 
-    // Update GPU buffers if mesh is valid
-    if (mMeshValid) {
-        UpdateMeshBuffer(mMesh, 0, mMesh.vertices, mMesh.vertexCount * 3 * (int)sizeof(float), 0);
-        UpdateMeshBuffer(mMesh, 3, mMesh.colors, mMesh.vertexCount * 4 * (int)sizeof(unsigned char), 0);
+void RLHeatMap3D::markAllChunksDirty() {
+    for (SurfaceChunk& rChunk : mChunks) {
+        rChunk.mDirty = true;
     }
 }
 
 void RLHeatMap3D::freeMesh() {
-    if (mMeshValid) {
-        UnloadModel(mModel);
-        mMeshValid = false;
+    for (SurfaceChunk& rChunk : mChunks) {
+        if (rChunk.mModelLod >= 0) {
+            UnloadModel(rChunk.mModel);
+        }
     }
-    mMesh = Mesh{};
-    mModel = Model{};
+    mChunks.clear();
+    mChunksX = 0;
+    mChunksY = 0;
+    mMeshValid = false;
 }
 
-void RLHeatMap3D::buildScatterMesh() {
+bool RLHeatMap3D::buildScatterMesh() {
+    if (mScatterMeshValid) {
+        return true;
+    }
     if (mWidth < 2 || mHeight < 2) {
-        return;
+        return false;
     }
 
-    freeScatterMesh();
-
     const int lPointCount = mWidth * mHeight;
     const int lTrianglesPerPoint = 12; // 6 faces x 2 triangles per cube
     const int lTriangleCount = lPointCount * lTrianglesPerPoint;
@@ -773,24 +1046,24 @@ void RLHeatMap3D::buildScatterMesh() {
         mScatterMesh.normals[(size_t)i * 3 + 2] = 0.0f;
     }
 
-    // Initialize with current values
-    updateScatterMeshVertices();
-
+    // Positions and colors come from the staged frame
     UploadMesh(&mScatterMesh, true); // dynamic = true for frequent updates
     mScatterModel = LoadModelFromMesh(mScatterMesh);
 
     mScatterMeshValid = true;
-    mScatterMeshDirty = false;
+    return true;
 }
 
-void RLHeatMap3D::updateScatterMeshVertices() {
+void RLHeatMap3D::updateScatterMeshVertices(RLCharts::UploadList& rUploads) {
+    RLCHARTS_PERF_REBUILD(mPerf, "RLHeatMap3D::updateScatterMeshVertices");
     if (mWidth < 2 || mHeight < 2) {
         return;
     }
 
-    if (!mScatterMeshValid && mScatterMesh.vertices == nullptr) {
-        return;
-    }
+    // 36 vertices per point, written straight into the staged buffers
+    const size_t lVertexCount = (size_t)mWidth * (size_t)mHeight * 36;
+    auto* pVertices = static_cast<float*>(rUploads.meshBuffer(&mScatterMesh, 0, lVertexCount * 3 * sizeof(float)));
+    auto* pColors = static_cast<unsigned char*>(rUploads.meshBuffer(&mScatterMesh, 3, lVertexCount * 4));
 
     const float lHalfSize = BOX_SIZE * 0.5f;
     const float lHeight = BOX_SIZE;
@@ -814,342 +1087,337 @@ void RLHeatMap3D::updateScatterMeshVertices() {
             // Each face has 2 triangles = 6 vertices
 
             // Front face (+Z) - 6 vertices
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 0] = lPx - lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 1] = lPy - lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 2] = lPz + lS;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 0] = lC.r;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 1] = lC.g;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 2] = lC.b;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 3] = lC.a;
+            pVertices[(size_t)lVertIdx * 3 + 0] = lPx - lS;
+            pVertices[(size_t)lVertIdx * 3 + 1] = lPy - lS;
+            pVertices[(size_t)lVertIdx * 3 + 2] = lPz + lS;
+            pColors[(size_t)lVertIdx * 4 + 0] = lC.r;
+            pColors[(size_t)lVertIdx * 4 + 1] = lC.g;
+            pColors[(size_t)lVertIdx * 4 + 2] = lC.b;
+            pColors[(size_t)lVertIdx * 4 + 3] = lC.a;
             lVertIdx++;
 
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 0] = lPx + lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 1] = lPy - lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 2] = lPz + lS;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 0] = lC.r;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 1] = lC.g;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 2] = lC.b;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 3] = lC.a;
+            pVertices[(size_t)lVertIdx * 3 + 0] = lPx + lS;
+            pVertices[(size_t)lVertIdx * 3 + 1] = lPy - lS;
+            pVertices[(size_t)lVertIdx * 3 + 2] = lPz + lS;
+            pColors[(size_t)lVertIdx * 4 + 0] = lC.r;
+            pColors[(size_t)lVertIdx * 4 + 1] = lC.g;
+            pColors[(size_t)lVertIdx * 4 + 2] = lC.b;
+            pColors[(size_t)lVertIdx * 4 + 3] = lC.a;
             lVertIdx++;
 
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 0] = lPx + lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 1] = lPy + lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 2] = lPz + lS;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 0] = lC.r;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 1] = lC.g;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 2] = lC.b;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 3] = lC.a;
+            pVertices[(size_t)lVertIdx * 3 + 0] = lPx + lS;
+            pVertices[(size_t)lVertIdx * 3 + 1] = lPy + lS;
+            pVertices[(size_t)lVertIdx * 3 + 2] = lPz + lS;
+            pColors[(size_t)lVertIdx * 4 + 0] = lC.r;
+            pColors[(size_t)lVertIdx * 4 + 1] = lC.g;
+            pColors[(size_t)lVertIdx * 4 + 2] = lC.b;
+            pColors[(size_t)lVertIdx * 4 + 3] = lC.a;
             lVertIdx++;
 
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 0] = lPx - lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 1] = lPy - lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 2] = lPz + lS;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 0] = lC.r;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 1] = lC.g;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 2] = lC.b;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 3] = lC.a;
+            pVertices[(size_t)lVertIdx * 3 + 0] = lPx - lS;
+            pVertices[(size_t)lVertIdx * 3 + 1] = lPy - lS;
+            pVertices[(size_t)lVertIdx * 3 + 2] = lPz + lS;
+            pColors[(size_t)lVertIdx * 4 + 0] = lC.r;
+            pColors[(size_t)lVertIdx * 4 + 1] = lC.g;
+            pColors[(size_t)lVertIdx * 4 + 2] = lC.b;
+            pColors[(size_t)lVertIdx * 4 + 3] = lC.a;
             lVertIdx++;
 
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 0] = lPx + lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 1] = lPy + lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 2] = lPz + lS;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 0] = lC.r;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 1] = lC.g;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 2] = lC.b;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 3] = lC.a;
+            pVertices[(size_t)lVertIdx * 3 + 0] = lPx + lS;
+            pVertices[(size_t)lVertIdx * 3 + 1] = lPy + lS;
+            pVertices[(size_t)lVertIdx * 3 + 2] = lPz + lS;
+            pColors[(size_t)lVertIdx * 4 + 0] = lC.r;
+            pColors[(size_t)lVertIdx * 4 + 1] = lC.g;
+            pColors[(size_t)lVertIdx * 4 + 2] = lC.b;
+            pColors[(size_t)lVertIdx * 4 + 3] = lC.a;
             lVertIdx++;
 
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 0] = lPx - lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 1] = lPy + lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 2] = lPz + lS;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 0] = lC.r;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 1] = lC.g;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 2] = lC.b;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 3] = lC.a;
+            pVertices[(size_t)lVertIdx * 3 + 0] = lPx - lS;
+            pVertices[(size_t)lVertIdx * 3 + 1] = lPy + lS;
+            pVertices[(size_t)lVertIdx * 3 + 2] = lPz + lS;
+            pColors[(size_t)lVertIdx * 4 + 0] = lC.r;
+            pColors[(size_t)lVertIdx * 4 + 1] = lC.g;
+            pColors[(size_t)lVertIdx * 4 + 2] = lC.b;
+            pColors[(size_t)lVertIdx * 4 + 3] = lC.a;
             lVertIdx++;
 
             // Back face (-Z) - 6 vertices
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 0] = lPx + lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 1] = lPy - lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 2] = lPz - lS;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 0] = lC.r;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 1] = lC.g;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 2] = lC.b;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 3] = lC.a;
+            pVertices[(size_t)lVertIdx * 3 + 0] = lPx + lS;
+            pVertices[(size_t)lVertIdx * 3 + 1] = lPy - lS;
+            pVertices[(size_t)lVertIdx * 3 + 2] = lPz - lS;
+            pColors[(size_t)lVertIdx * 4 + 0] = lC.r;
+            pColors[(size_t)lVertIdx * 4 + 1] = lC.g;
+            pColors[(size_t)lVertIdx * 4 + 2] = lC.b;
+            pColors[(size_t)lVertIdx * 4 + 3] = lC.a;
             lVertIdx++;
 
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 0] = lPx - lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 1] = lPy - lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 2] = lPz - lS;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 0] = lC.r;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 1] = lC.g;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 2] = lC.b;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 3] = lC.a;
+            pVertices[(size_t)lVertIdx * 3 + 0] = lPx - lS;
+            pVertices[(size_t)lVertIdx * 3 + 1] = lPy - lS;
+            pVertices[(size_t)lVertIdx * 3 + 2] = lPz - lS;
+            pColors[(size_t)lVertIdx * 4 + 0] = lC.r;
+            pColors[(size_t)lVertIdx * 4 + 1] = lC.g;
+            pColors[(size_t)lVertIdx * 4 + 2] = lC.b;
+            pColors[(size_t)lVertIdx * 4 + 3] = lC.a;
             lVertIdx++;
 
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 0] = lPx - lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 1] = lPy + lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 2] = lPz - lS;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 0] = lC.r;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 1] = lC.g;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 2] = lC.b;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 3] = lC.a;
+            pVertices[(size_t)lVertIdx * 3 + 0] = lPx - lS;
+            pVertices[(size_t)lVertIdx * 3 + 1] = lPy + lS;
+            pVertices[(size_t)lVertIdx * 3 + 2] = lPz - lS;
+            pColors[(size_t)lVertIdx * 4 + 0] = lC.r;
+            pColors[(size_t)lVertIdx * 4 + 1] = lC.g;
+            pColors[(size_t)lVertIdx * 4 + 2] = lC.b;
+            pColors[(size_t)lVertIdx * 4 + 3] = lC.a;
             lVertIdx++;
 
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 0] = lPx + lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 1] = lPy - lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 2] = lPz - lS;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 0] = lC.r;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 1] = lC.g;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 2] = lC.b;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 3] = lC.a;
+            pVertices[(size_t)lVertIdx * 3 + 0] = lPx + lS;
+            pVertices[(size_t)lVertIdx * 3 + 1] = lPy - lS;
+            pVertices[(size_t)lVertIdx * 3 + 2] = lPz - lS;
+            pColors[(size_t)lVertIdx * 4 + 0] = lC.r;
+            pColors[(size_t)lVertIdx * 4 + 1] = lC.g;
+            pColors[(size_t)lVertIdx * 4 + 2] = lC.b;
+            pColors[(size_t)lVertIdx * 4 + 3] = lC.a;
             lVertIdx++;
 
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 0] = lPx - lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 1] = lPy + lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 2] = lPz - lS;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 0] = lC.r;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 1] = lC.g;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 2] = lC.b;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 3] = lC.a;
+            pVertices[(size_t)lVertIdx * 3 + 0] = lPx - lS;
+            pVertices[(size_t)lVertIdx * 3 + 1] = lPy + lS;
+            pVertices[(size_t)lVertIdx * 3 + 2] = lPz - lS;
+            pColors[(size_t)lVertIdx * 4 + 0] = lC.r;
+            pColors[(size_t)lVertIdx * 4 + 1] = lC.g;
+            pColors[(size_t)lVertIdx * 4 + 2] = lC.b;
+            pColors[(size_t)lVertIdx * 4 + 3] = lC.a;
             lVertIdx++;
 
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 0] = lPx + lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 1] = lPy + lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 2] = lPz - lS;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 0] = lC.r;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 1] = lC.g;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 2] = lC.b;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 3] = lC.a;
+            pVertices[(size_t)lVertIdx * 3 + 0] = lPx + lS;
+            pVertices[(size_t)lVertIdx * 3 + 1] = lPy + lS;
+            pVertices[(size_t)lVertIdx * 3 + 2] = lPz - lS;
+            pColors[(size_t)lVertIdx * 4 + 0] = lC.r;
+            pColors[(size_t)lVertIdx * 4 + 1] = lC.g;
+            pColors[(size_t)lVertIdx * 4 + 2] = lC.b;
+            pColors[(size_t)lVertIdx * 4 + 3] = lC.a;
             lVertIdx++;
 
             // Top face (+Y) - 6 vertices
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 0] = lPx - lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 1] = lPy + lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 2] = lPz + lS;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 0] = lC.r;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 1] = lC.g;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 2] = lC.b;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 3] = lC.a;
+            pVertices[(size_t)lVertIdx * 3 + 0] = lPx - lS;
+            pVertices[(size_t)lVertIdx * 3 + 1] = lPy + lS;
+            pVertices[(size_t)lVertIdx * 3 + 2] = lPz + lS;
+            pColors[(size_t)lVertIdx * 4 + 0] = lC.r;
+            pColors[(size_t)lVertIdx * 4 + 1] = lC.g;
+            pColors[(size_t)lVertIdx * 4 + 2] = lC.b;
+            pColors[(size_t)lVertIdx * 4 + 3] = lC.a;
             lVertIdx++;
 
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 0] = lPx + lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 1] = lPy + lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 2] = lPz + lS;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 0] = lC.r;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 1] = lC.g;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 2] = lC.b;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 3] = lC.a;
+            pVertices[(size_t)lVertIdx * 3 + 0] = lPx + lS;
+            pVertices[(size_t)lVertIdx * 3 + 1] = lPy + lS;
+            pVertices[(size_t)lVertIdx * 3 + 2] = lPz + lS;
+            pColors[(size_t)lVertIdx * 4 + 0] = lC.r;
+            pColors[(size_t)lVertIdx * 4 + 1] = lC.g;
+            pColors[(size_t)lVertIdx * 4 + 2] = lC.b;
+            pColors[(size_t)lVertIdx * 4 + 3] = lC.a;
             lVertIdx++;
 
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 0] = lPx + lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 1] = lPy + lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 2] = lPz - lS;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 0] = lC.r;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 1] = lC.g;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 2] = lC.b;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 3] = lC.a;
+            pVertices[(size_t)lVertIdx * 3 + 0] = lPx + lS;
+            pVertices[(size_t)lVertIdx * 3 + 1] = lPy + lS;
+            pVertices[(size_t)lVertIdx * 3 + 2] = lPz - lS;
+            pColors[(size_t)lVertIdx * 4 + 0] = lC.r;
+            pColors[(size_t)lVertIdx * 4 + 1] = lC.g;
+            pColors[(size_t)lVertIdx * 4 + 2] = lC.b;
+            pColors[(size_t)lVertIdx * 4 + 3] = lC.a;
             lVertIdx++;
 
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 0] = lPx - lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 1] = lPy + lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 2] = lPz + lS;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 0] = lC.r;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 1] = lC.g;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 2] = lC.b;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 3] = lC.a;
+            pVertices[(size_t)lVertIdx * 3 + 0] = lPx - lS;
+            pVertices[(size_t)lVertIdx * 3 + 1] = lPy + lS;
+            pVertices[(size_t)lVertIdx * 3 + 2] = lPz + lS;
+            pColors[(size_t)lVertIdx * 4 + 0] = lC.r;
+            pColors[(size_t)lVertIdx * 4 + 1] = lC.g;
+            pColors[(size_t)lVertIdx * 4 + 2] = lC.b;
+            pColors[(size_t)lVertIdx * 4 + 3] = lC.a;
             lVertIdx++;
 
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 0] = lPx + lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 1] = lPy + lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 2] = lPz - lS;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 0] = lC.r;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 1] = lC.g;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 2] = lC.b;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 3] = lC.a;
+            pVertices[(size_t)lVertIdx * 3 + 0] = lPx + lS;
+            pVertices[(size_t)lVertIdx * 3 + 1] = lPy + lS;
+            pVertices[(size_t)lVertIdx * 3 + 2] = lPz - lS;
+            pColors[(size_t)lVertIdx * 4 + 0] = lC.r;
+            pColors[(size_t)lVertIdx * 4 + 1] = lC.g;
+            pColors[(size_t)lVertIdx * 4 + 2] = lC.b;
+            pColors[(size_t)lVertIdx * 4 + 3] = lC.a;
             lVertIdx++;
 
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 0] = lPx - lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 1] = lPy + lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 2] = lPz - lS;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 0] = lC.r;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 1] = lC.g;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 2] = lC.b;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 3] = lC.a;
+            pVertices[(size_t)lVertIdx * 3 + 0] = lPx - lS;
+            pVertices[(size_t)lVertIdx * 3 + 1] = lPy + lS;
+            pVertices[(size_t)lVertIdx * 3 + 2] = lPz - lS;
+            pColors[(size_t)lVertIdx * 4 + 0] = lC.r;
+            pColors[(size_t)lVertIdx * 4 + 1] = lC.g;
+            pColors[(size_t)lVertIdx * 4 + 2] = lC.b;
+            pColors[(size_t)lVertIdx * 4 + 3] = lC.a;
             lVertIdx++;
 
             // Bottom face (-Y) - 6 vertices
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 0] = lPx - lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 1] = lPy - lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 2] = lPz - lS;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 0] = lC.r;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 1] = lC.g;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 2] = lC.b;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 3] = lC.a;
+            pVertices[(size_t)lVertIdx * 3 + 0] = lPx - lS;
+            pVertices[(size_t)lVertIdx * 3 + 1] = lPy - lS;
+            pVertices[(size_t)lVertIdx * 3 + 2] = lPz - lS;
+            pColors[(size_t)lVertIdx * 4 + 0] = lC.r;
+            pColors[(size_t)lVertIdx * 4 + 1] = lC.g;
+            pColors[(size_t)lVertIdx * 4 + 2] = lC.b;
+            pColors[(size_t)lVertIdx * 4 + 3] = lC.a;
             lVertIdx++;
 
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 0] = lPx + lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 1] = lPy - lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 2] = lPz - lS;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 0] = lC.r;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 1] = lC.g;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 2] = lC.b;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 3] = lC.a;
+            pVertices[(size_t)lVertIdx * 3 + 0] = lPx + lS;
+            pVertices[(size_t)lVertIdx * 3 + 1] = lPy - lS;
+            pVertices[(size_t)lVertIdx * 3 + 2] = lPz - lS;
+            pColors[(size_t)lVertIdx * 4 + 0] = lC.r;
+            pColors[(size_t)lVertIdx * 4 + 1] = lC.g;
+            pColors[(size_t)lVertIdx * 4 + 2] = lC.b;
+            pColors[(size_t)lVertIdx * 4 + 3] = lC.a;
             lVertIdx++;
 
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 0] = lPx + lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 1] = lPy - lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 2] = lPz + lS;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 0] = lC.r;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 1] = lC.g;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 2] = lC.b;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 3] = lC.a;
+            pVertices[(size_t)lVertIdx * 3 + 0] = lPx + lS;
+            pVertices[(size_t)lVertIdx * 3 + 1] = lPy - lS;
+            pVertices[(size_t)lVertIdx * 3 + 2] = lPz + lS;
+            pColors[(size_t)lVertIdx * 4 + 0] = lC.r;
+            pColors[(size_t)lVertIdx * 4 + 1] = lC.g;
+            pColors[(size_t)lVertIdx * 4 + 2] = lC.b;
+            pColors[(size_t)lVertIdx * 4 + 3] = lC.a;
             lVertIdx++;
 
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 0] = lPx - lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 1] = lPy - lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 2] = lPz - lS;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 0] = lC.r;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 1] = lC.g;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 2] = lC.b;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 3] = lC.a;
+            pVertices[(size_t)lVertIdx * 3 + 0] = lPx - lS;
+            pVertices[(size_t)lVertIdx * 3 + 1] = lPy - lS;
+            pVertices[(size_t)lVertIdx * 3 + 2] = lPz - lS;
+            pColors[(size_t)lVertIdx * 4 + 0] = lC.r;
+            pColors[(size_t)lVertIdx * 4 + 1] = lC.g;
+            pColors[(size_t)lVertIdx * 4 + 2] = lC.b;
+            pColors[(size_t)lVertIdx * 4 + 3] = lC.a;
             lVertIdx++;
 
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 0] = lPx + lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 1] = lPy - lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 2] = lPz + lS;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 0] = lC.r;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 1] = lC.g;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 2] = lC.b;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 3] = lC.a;
+            pVertices[(size_t)lVertIdx * 3 + 0] = lPx + lS;
+            pVertices[(size_t)lVertIdx * 3 + 1] = lPy - lS;
+            pVertices[(size_t)lVertIdx * 3 + 2] = lPz + lS;
+            pColors[(size_t)lVertIdx * 4 + 0] = lC.r;
+            pColors[(size_t)lVertIdx * 4 + 1] = lC.g;
+            pColors[(size_t)lVertIdx * 4 + 2] = lC.b;
+            pColors[(size_t)lVertIdx * 4 + 3] = lC.a;
             lVertIdx++;
 
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 0] = lPx - lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 1] = lPy - lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 2] = lPz + lS;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 0] = lC.r;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 1] = lC.g;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 2] = lC.b;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 3] = lC.a;
+            pVertices[(size_t)lVertIdx * 3 + 0] = lPx - lS;
+            pVertices[(size_t)lVertIdx * 3 + 1] = lPy - lS;
+            pVertices[(size_t)lVertIdx * 3 + 2] = lPz + lS;
+            pColors[(size_t)lVertIdx * 4 + 0] = lC.r;
+            pColors[(size_t)lVertIdx * 4 + 1] = lC.g;
+            pColors[(size_t)lVertIdx * 4 + 2] = lC.b;
+            pColors[(size_t)lVertIdx * 4 + 3] = lC.a;
             lVertIdx++;
 
             // Right face (+X) - 6 vertices
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 0] = lPx + lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 1] = lPy - lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 2] = lPz + lS;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 0] = lC.r;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 1] = lC.g;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 2] = lC.b;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 3] = lC.a;
+            pVertices[(size_t)lVertIdx * 3 + 0] = lPx + lS;
+            pVertices[(size_t)lVertIdx * 3 + 1] = lPy - lS;
+            pVertices[(size_t)lVertIdx * 3 + 2] = lPz + lS;
+            pColors[(size_t)lVertIdx * 4 + 0] = lC.r;
+            pColors[(size_t)lVertIdx * 4 + 1] = lC.g;
+            pColors[(size_t)lVertIdx * 4 + 2] = lC.b;
+            pColors[(size_t)lVertIdx * 4 + 3] = lC.a;
             lVertIdx++;
 
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 0] = lPx + lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 1] = lPy - lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 2] = lPz - lS;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 0] = lC.r;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 1] = lC.g;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 2] = lC.b;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 3] = lC.a;
+            pVertices[(size_t)lVertIdx * 3 + 0] = lPx + lS;
+            pVertices[(size_t)lVertIdx * 3 + 1] = lPy - lS;
+            pVertices[(size_t)lVertIdx * 3 + 2] = lPz - lS;
+            pColors[(size_t)lVertIdx * 4 + 0] = lC.r;
+            pColors[(size_t)lVertIdx * 4 + 1] = lC.g;
+            pColors[(size_t)lVertIdx * 4 + 2] = lC.b;
+            pColors[(size_t)lVertIdx * 4 + 3] = lC.a;
             lVertIdx++;
 
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 0] = lPx + lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 1] = lPy + lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 2] = lPz - lS;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 0] = lC.r;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 1] = lC.g;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 2] = lC.b;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 3] = lC.a;
+            pVertices[(size_t)lVertIdx * 3 + 0] = lPx + lS;
+            pVertices[(size_t)lVertIdx * 3 + 1] = lPy + lS;
+            pVertices[(size_t)lVertIdx * 3 + 2] = lPz - lS;
+            pColors[(size_t)lVertIdx * 4 + 0] = lC.r;
+            pColors[(size_t)lVertIdx * 4 + 1] = lC.g;
+            pColors[(size_t)lVertIdx * 4 + 2] = lC.b;
+            pColors[(size_t)lVertIdx * 4 + 3] = lC.a;
             lVertIdx++;
 
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 0] = lPx + lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 1] = lPy - lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 2] = lPz + lS;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 0] = lC.r;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 1] = lC.g;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 2] = lC.b;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 3] = lC.a;
+            pVertices[(size_t)lVertIdx * 3 + 0] = lPx + lS;
+            pVertices[(size_t)lVertIdx * 3 + 1] = lPy - lS;
+            pVertices[(size_t)lVertIdx * 3 + 2] = lPz + lS;
+            pColors[(size_t)lVertIdx * 4 + 0] = lC.r;
+            pColors[(size_t)lVertIdx * 4 + 1] = lC.g;
+            pColors[(size_t)lVertIdx * 4 + 2] = lC.b;
+            pColors[(size_t)lVertIdx * 4 + 3] = lC.a;
             lVertIdx++;
 
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 0] = lPx + lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 1] = lPy + lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 2] = lPz - lS;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 0] = lC.r;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 1] = lC.g;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 2] = lC.b;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 3] = lC.a;
+            pVertices[(size_t)lVertIdx * 3 + 0] = lPx + lS;
+            pVertices[(size_t)lVertIdx * 3 + 1] = lPy + lS;
+            pVertices[(size_t)lVertIdx * 3 + 2] = lPz - lS;
+            pColors[(size_t)lVertIdx * 4 + 0] = lC.r;
+            pColors[(size_t)lVertIdx * 4 + 1] = lC.g;
+            pColors[(size_t)lVertIdx * 4 + 2] = lC.b;
+            pColors[(size_t)lVertIdx * 4 + 3] = lC.a;
             lVertIdx++;
 
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 0] = lPx + lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 1] = lPy + lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 2] = lPz + lS;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 0] = lC.r;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 1] = lC.g;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 2] = lC.b;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 3] = lC.a;
+            pVertices[(size_t)lVertIdx * 3 + 0] = lPx + lS;
+            pVertices[(size_t)lVertIdx * 3 + 1] = lPy + lS;
+            pVertices[(size_t)lVertIdx * 3 + 2] = lPz + lS;
+            pColors[(size_t)lVertIdx * 4 + 0] = lC.r;
+            pColors[(size_t)lVertIdx * 4 + 1] = lC.g;
+            pColors[(size_t)lVertIdx * 4 + 2] = lC.b;
+            pColors[(size_t)lVertIdx * 4 + 3] = lC.a;
             lVertIdx++;
 
             // Left face (-X) - 6 vertices
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 0] = lPx - lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 1] = lPy - lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 2] = lPz - lS;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 0] = lC.r;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 1] = lC.g;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 2] = lC.b;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 3] = lC.a;
+            pVertices[(size_t)lVertIdx * 3 + 0] = lPx - lS;
+            pVertices[(size_t)lVertIdx * 3 + 1] = lPy - lS;
+            pVertices[(size_t)lVertIdx * 3 + 2] = lPz - lS;
+            pColors[(size_t)lVertIdx * 4 + 0] = lC.r;
+            pColors[(size_t)lVertIdx * 4 + 1] = lC.g;
+            pColors[(size_t)lVertIdx * 4 + 2] = lC.b;
+            pColors[(size_t)lVertIdx * 4 + 3] = lC.a;
             lVertIdx++;
 
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 0] = lPx - lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 1] = lPy - lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 2] = lPz + lS;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 0] = lC.r;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 1] = lC.g;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 2] = lC.b;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 3] = lC.a;
+            pVertices[(size_t)lVertIdx * 3 + 0] = lPx - lS;
+            pVertices[(size_t)lVertIdx * 3 + 1] = lPy - lS;
+            pVertices[(size_t)lVertIdx * 3 + 2] = lPz + lS;
+            pColors[(size_t)lVertIdx * 4 + 0] = lC.r;
+            pColors[(size_t)lVertIdx * 4 + 1] = lC.g;
+            pColors[(size_t)lVertIdx * 4 + 2] = lC.b;
+            pColors[(size_t)lVertIdx * 4 + 3] = lC.a;
             lVertIdx++;
 
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 0] = lPx - lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 1] = lPy + lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 2] = lPz + lS;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 0] = lC.r;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 1] = lC.g;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 2] = lC.b;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 3] = lC.a;
+            pVertices[(size_t)lVertIdx * 3 + 0] = lPx - lS;
+            pVertices[(size_t)lVertIdx * 3 + 1] = lPy + lS;
+            pVertices[(size_t)lVertIdx * 3 + 2] = lPz + lS;
+            pColors[(size_t)lVertIdx * 4 + 0] = lC.r;
+            pColors[(size_t)lVertIdx * 4 + 1] = lC.g;
+            pColors[(size_t)lVertIdx * 4 + 2] = lC.b;
+            pColors[(size_t)lVertIdx * 4 + 3] = lC.a;
             lVertIdx++;
 
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 0] = lPx - lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 1] = lPy - lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 2] = lPz - lS;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 0] = lC.r;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 1] = lC.g;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 2] = lC.b;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 3] = lC.a;
+            pVertices[(size_t)lVertIdx * 3 + 0] = lPx - lS;
+            pVertices[(size_t)lVertIdx * 3 + 1] = lPy - lS;
+            pVertices[(size_t)lVertIdx * 3 + 2] = lPz - lS;
+            pColors[(size_t)lVertIdx * 4 + 0] = lC.r;
+            pColors[(size_t)lVertIdx * 4 + 1] = lC.g;
+            pColors[(size_t)lVertIdx * 4 + 2] = lC.b;
+            pColors[(size_t)lVertIdx * 4 + 3] = lC.a;
             lVertIdx++;
 
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 0] = lPx - lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 1] = lPy + lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 2] = lPz + lS;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 0] = lC.r;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 1] = lC.g;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 2] = lC.b;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 3] = lC.a;
+            pVertices[(size_t)lVertIdx * 3 + 0] = lPx - lS;
+            pVertices[(size_t)lVertIdx * 3 + 1] = lPy + lS;
+            pVertices[(size_t)lVertIdx * 3 + 2] = lPz + lS;
+            pColors[(size_t)lVertIdx * 4 + 0] = lC.r;
+            pColors[(size_t)lVertIdx * 4 + 1] = lC.g;
+            pColors[(size_t)lVertIdx * 4 + 2] = lC.b;
+            pColors[(size_t)lVertIdx * 4 + 3] = lC.a;
             lVertIdx++;
 
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 0] = lPx - lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 1] = lPy + lS;
-            mScatterMesh.vertices[(size_t)lVertIdx * 3 + 2] = lPz - lS;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 0] = lC.r;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 1] = lC.g;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 2] = lC.b;
-            mScatterMesh.colors[(size_t)lVertIdx * 4 + 3] = lC.a;
+            pVertices[(size_t)lVertIdx * 3 + 0] = lPx - lS;
+            pVertices[(size_t)lVertIdx * 3 + 1] = lPy + lS;
+            pVertices[(size_t)lVertIdx * 3 + 2] = lPz - lS;
+            pColors[(size_t)lVertIdx * 4 + 0] = lC.r;
+            pColors[(size_t)lVertIdx * 4 + 1] = lC.g;
+            pColors[(size_t)lVertIdx * 4 + 2] = lC.b;
+            pColors[(size_t)lVertIdx * 4 + 3] = lC.a;
             lVertIdx++;
         }
     }
 
-    // Update GPU buffers if mesh is already uploaded
-    if (mScatterMeshValid) {
-        UpdateMeshBuffer(mScatterMesh, 0, mScatterMesh.vertices, mScatterMesh.vertexCount * 3 * (int)sizeof(float), 0);
-        UpdateMeshBuffer(mScatterMesh, 3, mScatterMesh.colors, mScatterMesh.vertexCount * 4 * (int)sizeof(unsigned char), 0);
-    }
 }
 
 void RLHeatMap3D::freeScatterMesh() {
@@ -1161,6 +1429,139 @@ void RLHeatMap3D::freeScatterMesh() {
     mScatterModel = Model{};
 }
 
+bool RLHeatMap3D::ensureInstanceResources() {
+    if (mInstanceReady) {
+        return true;
+    }
+    // The instancing shader is GLSL 330: desktop GL only
+    if (mInstanceFailed || RLCharts::isGlesContext() || mWidth < 2 || mHeight < 2) {
+        mInstanceFailed = true;
+        return false;
+    }
+
+    // Unit cube scaled and offset per instance
+    const char* pVertex =
+        "#version 330\n"
+        "in vec3 vertexPosition;\n"
+        "in vec4 instancePosSize;\n"
+        "in vec4 instanceColor;\n"
+        "uniform mat4 mvp;\n"
+        "out vec4 fragColor;\n"
+        "void main() {\n"
+        "    fragColor = instanceColor;\n"
+        "    gl_Position = mvp * vec4(instancePosSize.xyz + vertexPosition * instancePosSize.w, 1.0);\n"
+        "}\n";
+    const char* pFragment =
+        "#version 330\n"
+        "in vec4 fragColor;\n"
+        "out vec4 finalColor;\n"
+        "void main() { finalColor = fragColor; }\n";
+    mInstanceShader = LoadShaderFromMemory(pVertex, pFragment);
+    if (!IsShaderValid(mInstanceShader)) {
+        freeInstanceResources();
+        mInstanceFailed = true;
+        return false;
+    }
+    mLocInstanceMvp = GetShaderLocation(mInstanceShader, "mvp");
+    const int lLocPosition = GetShaderLocationAttrib(mInstanceShader, "vertexPosition");
+    const int lLocPosSize = GetShaderLocationAttrib(mInstanceShader, "instancePosSize");
+    const int lLocColor = GetShaderLocationAttrib(mInstanceShader, "instanceColor");
+
+    // 6 faces x 2 triangles
+    static const float CUBE[36 * 3] = {
+        -0.5f, -0.5f,  0.5f,   0.5f, -0.5f,  0.5f,   0.5f,  0.5f,  0.5f,
+        -0.5f, -0.5f,  0.5f,   0.5f,  0.5f,  0.5f,  -0.5f,  0.5f,  0.5f,
+         0.5f, -0.5f, -0.5f,  -0.5f, -0.5f, -0.5f,  -0.5f,  0.5f, -0.5f,
+         0.5f, -0.5f, -0.5f,  -0.5f,  0.5f, -0.5f,   0.5f,  0.5f, -0.5f,
+        -0.5f,  0.5f,  0.5f,   0.5f,  0.5f,  0.5f,   0.5f,  0.5f, -0.5f,
+        -0.5f,  0.5f,  0.5f,   0.5f,  0.5f, -0.5f,  -0.5f,  0.5f, -0.5f,
+        -0.5f, -0.5f, -0.5f,   0.5f, -0.5f, -0.5f,   0.5f, -0.5f,  0.5f,
+        -0.5f, -0.5f, -0.5f,   0.5f, -0.5f,  0.5f,  -0.5f, -0.5f,  0.5f,
+         0.5f, -0.5f,  0.5f,   0.5f, -0.5f, -0.5f,   0.5f,  0.5f, -0.5f,
+         0.5f, -0.5f,  0.5f,   0.5f,  0.5f, -0.5f,   0.5f,  0.5f,  0.5f,
+        -0.5f, -0.5f, -0.5f,  -0.5f, -0.5f,  0.5f,  -0.5f,  0.5f,  0.5f,
+        -0.5f, -0.5f, -0.5f,  -0.5f,  0.5f,  0.5f,  -0.5f,  0.5f, -0.5f
+    };
+
+    // Instance buffers are created empty; the staged frame fills them
+    mInstanceCount = mWidth * mHeight;
+
+    // Each rlLoadVertexBuffer leaves its buffer bound for the attribute setup after it
+    mInstanceVao = rlLoadVertexArray();
+    rlEnableVertexArray(mInstanceVao);
+    mInstanceCubeVbo = rlLoadVertexBuffer(CUBE, (int)sizeof(CUBE), false);
+    rlSetVertexAttribute((unsigned int)lLocPosition, 3, RL_FLOAT, false, 0, 0);
+    rlEnableVertexAttribute((unsigned int)lLocPosition);
+    mInstancePosVbo = rlLoadVertexBuffer(nullptr, mInstanceCount * 4 * (int)sizeof(float), true);
+    rlSetVertexAttribute((unsigned int)lLocPosSize, 4, RL_FLOAT, false, 0, 0);
+    rlEnableVertexAttribute((unsigned int)lLocPosSize);
+    rlSetVertexAttributeDivisor((unsigned int)lLocPosSize, 1);
+    mInstanceColorVbo = rlLoadVertexBuffer(nullptr, mInstanceCount * (int)sizeof(Color), true);
+    rlSetVertexAttribute((unsigned int)lLocColor, 4, RL_UNSIGNED_BYTE, true, 0, 0);
+    rlEnableVertexAttribute((unsigned int)lLocColor);
+    rlSetVertexAttributeDivisor((unsigned int)lLocColor, 1);
+    rlDisableVertexArray();
+
+    mInstanceReady = lLocPosition >= 0 && lLocPosSize >= 0 && lLocColor >= 0 && mInstanceVao != 0 &&
+                     mInstanceCubeVbo != 0 && mInstancePosVbo != 0 && mInstanceColorVbo != 0;
+    if (!mInstanceReady) {
+        freeInstanceResources();
+        mInstanceFailed = true;
+        return false;
+    }
+    return true;
+}
+
+void RLHeatMap3D::updateInstanceData(RLCharts::UploadList& rUploads) {
+    RLCHARTS_PERF_REBUILD(mPerf, "RLHeatMap3D::updateInstanceData");
+    const float lHalfSize = BOX_SIZE * 0.5f;
+    const float lHeight = BOX_SIZE;
+
+    // x, y, z, size and a color per point, written straight into the staged buffers
+    const size_t lCount = (size_t)mWidth * (size_t)mHeight;
+    auto* pPosSize = static_cast<float*>(rUploads.vertexBuffer(&mInstancePosVbo, lCount * 4 * sizeof(float)));
+    auto* pColors = static_cast<Color*>(rUploads.vertexBuffer(&mInstanceColorVbo, lCount * sizeof(Color)));
+
+    for (int lY = 0; lY < mHeight; ++lY) {
+        const float lPz = -lHalfSize + ((float)lY / (float)(mHeight - 1)) * lHalfSize * 2.0f;
+        for (int lX = 0; lX < mWidth; ++lX) {
+            const size_t lIdx = (size_t)lY * (size_t)mWidth + (size_t)lX;
+            const float lNorm = normalizeValue(mCurrentValues[lIdx]);
+            float* pInstance = pPosSize + lIdx * 4;
+            pInstance[0] = -lHalfSize + ((float)lX / (float)(mWidth - 1)) * lHalfSize * 2.0f;
+            pInstance[1] = lNorm * lHeight;
+            pInstance[2] = lPz;
+            pInstance[3] = mStyle.mPointSize;
+            pColors[lIdx] = getColorForValue(lNorm);
+        }
+    }
+}
+
+void RLHeatMap3D::freeInstanceResources() {
+    if (mInstanceVao != 0) {
+        rlUnloadVertexArray(mInstanceVao);
+    }
+    if (mInstanceCubeVbo != 0) {
+        rlUnloadVertexBuffer(mInstanceCubeVbo);
+    }
+    if (mInstancePosVbo != 0) {
+        rlUnloadVertexBuffer(mInstancePosVbo);
+    }
+    if (mInstanceColorVbo != 0) {
+        rlUnloadVertexBuffer(mInstanceColorVbo);
+    }
+    if (mInstanceShader.id != 0) {
+        UnloadShader(mInstanceShader);
+    }
+    mInstanceShader = Shader{};
+    mInstanceVao = 0;
+    mInstanceCubeVbo = 0;
+    mInstancePosVbo = 0;
+    mInstanceColorVbo = 0;
+    mInstanceCount = 0;
+    mInstanceReady = false;
+}
+
 float RLHeatMap3D::normalizeValue(float aValue) const {
     const float lRange = mMaxValue - mMinValue;
     if (lRange < 1e-6f) {
@@ -1,7 +1,12 @@
 // RLHeatMap3D.h
 #pragma once
 #include "raylib.h"
+#include "RLPerf.h"
+#include "RLColormap.h"
+#include "RLGpuStaging.h"
+#include <atomic>
 #include <vector>
+#include <span>
 #include <cstddef>
 
 // Rendering mode for the 3D plot
@@ -21,6 +26,10 @@ struct RLHeatMap3DStyle {
     bool mShowWireframe = true;
     Color mWireframeColor{80, 80, 80, 200};
     float mSurfaceOpacity = 0.85f;
+    // Level of detail: 0 disables it. Otherwise surface tiles farther than this
+    // world distance from the camera are drawn at half resolution, and the
+    // resolution halves again each time the distance doubles.
+    float mLodDistance = 0.0f;
 
     // Scatter mode options
     float mPointSize = 0.15f;
@@ -65,14 +74,18 @@ public:
     // Data input - batch update all values (resizes grid if dimensions differ)
     // Returns false if rValues is empty or size doesn't match aWidth * aHeight
     bool setValues(int aWidth, int aHeight, const std::vector<float>& rValues);
+    bool setValues(int aWidth, int aHeight, std::span<const float> aValues);
 
     // Data input - partial region update
     // Returns false if rValues is empty, size doesn't match aW * aH, or zero overlap with grid
     bool updatePartialValues(int aX, int aY, int aW, int aH, const std::vector<float>& rValues);
+    bool updatePartialValues(int aX, int aY, int aW, int aH, std::span<const float> aValues);
 
     // Palette configuration (3-4 color stops)
     void setPalette(Color aColorA, Color aColorB, Color aColorC);
     void setPalette(Color aColorA, Color aColorB, Color aColorC, Color aColorD);
+    // Perceptual preset (viridis, magma, ...) from RLColormap.h
+    void setPalette(RLCharts::ColormapPreset aPreset);
 
     // Value range configuration
     void setValueRange(float aMinValue, float aMaxValue);
@@ -91,12 +104,34 @@ public:
     void setPointSize(float aSize);
     void setStyle(const RLHeatMap3DStyle& rStyle);
 
-    // Update animation (call each frame)
+    // Draw scatter mode as GPU instances of one shared cube: per point only a
+    // position/size and a color are uploaded instead of 36 full vertices.
+    // Desktop GL only; falls back to the combined scatter mesh elsewhere.
+    void setInstancedScatter(bool aEnabled);
+
+    // Update animation (call each frame): prepare(dt) followed by commit().
+    // prepare() animates the values and writes the changed tiles' vertices (or the
+    // scatter vertices / instance data) straight into a staging buffer without GL
+    // calls, so it may run on a worker thread; commit() builds the tile meshes whose
+    // level of detail changed and uploads the staged frame on the render thread.
+    // draw() only reads what commit() published, so prepare() and setValues() for
+    // the next frame may overlap commit() and draw() of the previous one. Other
+    // setters, isSettled() and needsRedraw() must not overlap prepare().
     void update(float aDt);
+    void prepare(float aDt);
+    void commit();
 
     // Draw the 3D plot (call within BeginMode3D/EndMode3D)
     void draw(Vector3 aPosition, float aScale, const Camera3D& rCamera) const;
 
+    // Settled once the values reached their targets and every tile (and its level
+    // of detail) is up to date. Camera motion is the caller's business: a moving
+    // camera needs a redraw whatever needsRedraw() says.
+    [[nodiscard]] bool isSettled() const;
+    [[nodiscard]] bool needsRedraw() const { return mRedrawPending || !isSettled(); }
+    // update()/rebuild/draw() timers and GPU counters (RLPerf.h); zero unless built with RLCHARTS_PERF
+    [[nodiscard]] const RLCharts::PerfStats& getPerfStats() const { return mPerf; }
+
     // Getters
     [[nodiscard]] int getWidth() const { return mWidth; }
     [[nodiscard]] int getHeight() const { return mHeight; }
@@ -104,6 +139,11 @@ public:
     [[nodiscard]] float getMaxValue() const { return mMaxValue; }
     [[nodiscard]] bool isAutoRange() const { return mAutoRange; }
     [[nodiscard]] RLHeatMap3DMode getMode() const { return mStyle.mMode; }
+    // Surface tiles and how many were rewritten/staged by the last prepare()
+    [[nodiscard]] size_t getSurfaceChunkCount() const { return mChunks.size(); }
+    [[nodiscard]] size_t getLastUploadedChunks() const { return mLastUploadedChunks; }
+    [[nodiscard]] bool isInstancedScatterEnabled() const { return mInstancedScatter; }
+    [[nodiscard]] bool isInstancedScatterActive() const { return mInstancedScatter && mInstanceReady; }
 
 private:
     // Grid dimensions
@@ -140,26 +180,100 @@ private:
     Color mLut[256]{};
     bool mLutDirty = true;
 
-    // Mesh resources (for surface mode)
-    Mesh mMesh{};
-    Model mModel{};
+    bool mValuesSettled = false;         // Current values reached the targets in the last update()
+    mutable bool mRedrawPending = true;  // Cleared by draw()
+    mutable RLCharts::PerfStats mPerf;
+
+    // Mesh resources (for surface mode): the surface is split into tiles of up to
+    // SURFACE_CHUNK_CELLS x SURFACE_CHUNK_CELLS cells, each an indexed mesh that is
+    // rewritten only when its own vertices change
+    struct SurfaceChunk {
+        int mCellX0 = 0;            // Cell range [x0, x1) x [y0, y1)
+        int mCellY0 = 0;
+        int mCellX1 = 0;
+        int mCellY1 = 0;
+        int mLod = -1;              // Level prepare() writes (vertex stride 1 << mLod), -1 = none yet
+        mutable int mWantedLod = 0; // Requested by the last draw() (atomic_ref: draw may overlap prepare)
+        bool mDirty = true;
+        int mModelLod = -1;         // Level of mModel (commit()), -1 = no model
+        Model mModel{};             // Owns the mesh
+        Mesh mMesh{};               // Handle of mModel's mesh, target of the staged uploads
+    };
+    std::vector<SurfaceChunk> mChunks;
+    int mChunksX = 0;
+    int mChunksY = 0;
     bool mMeshValid = false;
     bool mMeshDirty = false;
+    size_t mLastUploadedChunks = 0;
+    std::vector<int> mSampleX;  // Scratch: sample columns/rows of the chunk being written
+    std::vector<int> mSampleY;
+
+    // One prepared frame: its uploads and the tile meshes commit() builds first
+    struct ChunkBuild {
+        size_t mChunk = 0;
+        int mLod = 0;
+        int mSamplesX = 0;
+        int mSamplesY = 0;
+    };
+    struct StagedFrame {
+        RLCharts::UploadList mUploads;
+        std::vector<ChunkBuild> mChunkBuilds;
+        bool mSurface = true;
+        bool mInstanced = false;    // Scatter path the frame was prepared for
+        bool mScatter = false;      // Scatter vertices / instance data are staged
+        void clear() {
+            mUploads.clear();
+            mChunkBuilds.clear();
+            mScatter = false;
+        }
+    };
+    RLCharts::StagingBuffers<StagedFrame> mStaging;
+    bool mPreparedInstanced = false;       // Scatter path the last prepare() took
+    std::atomic<bool> mRestageAll{false};  // commit() created buffers the staged frame did not fill
+    bool mDrawInstanced = false;           // Committed scatter path read by draw()
 
     // Mesh resources (for scatter mode)
     Mesh mScatterMesh{};
     Model mScatterModel{};
     bool mScatterMeshValid = false;
-    bool mScatterMeshDirty = false;
+    bool mScatterMeshDirty = true;
+
+    // Instanced scatter resources: static cube VBO plus per-instance VBOs
+    bool mInstancedScatter = false;
+    bool mInstanceReady = false;
+    std::atomic<bool> mInstanceFailed{false}; // Set by commit(), read by prepare()
+    Shader mInstanceShader{};
+    int mLocInstanceMvp = -1;
+    unsigned int mInstanceVao = 0;
+    unsigned int mInstanceCubeVbo = 0;
+    unsigned int mInstancePosVbo = 0;
+    unsigned int mInstanceColorVbo = 0;
+    int mInstanceCount = 0;
 
     // Internal methods
     void rebuildLut();
     void buildMesh();
-    void updateMeshVertices();
+    void updateMeshVertices(StagedFrame& rFrame);
     void freeMesh();
-    void buildScatterMesh();
-    void updateScatterMeshVertices();
+    void buildChunkSamples(const SurfaceChunk& rChunk);
+    void buildChunk(SurfaceChunk& rChunk, const ChunkBuild& rBuild);
+    void writeChunkVertices(const SurfaceChunk& rChunk, float* pVertices, unsigned char* pColors);
+    void markVertexDirty(int aX, int aY);
+    void markAllChunksDirty();
+    [[nodiscard]] int chunkLod(int aChunkX, int aChunkY) const;
+    [[nodiscard]] float edgeSample(int aX, int aY, int aFixed0, int aFixed1, int aStride, bool aAlongX) const;
+    void updateAutoRange();
+    bool buildScatterMesh();
+    void updateScatterMeshVertices(RLCharts::UploadList& rUploads);
     void freeScatterMesh();
+    bool ensureInstanceResources();
+    void updateInstanceData(RLCharts::UploadList& rUploads);
+    // State of the last prepare() alone, without the staging hand-off
+    [[nodiscard]] bool isPrepared() const;
+    [[nodiscard]] bool instancedWanted() const {
+        return mInstancedScatter && !mInstanceFailed.load(std::memory_order_acquire);
+    }
+    void freeInstanceResources();
     float normalizeValue(float aValue) const;
     Color getColorForValue(float aNormalizedValue) const;
 
@@ -167,8 +281,9 @@ private:
     void drawAxisBox(Vector3 aPosition, float aScale, const Camera3D& rCamera) const;
     void drawFloorGrid(Vector3 aPosition, float aScale) const;
     void drawBackWalls(Vector3 aPosition, float aScale, const Camera3D& rCamera) const;
-    void drawSurface(Vector3 aPosition, float aScale) const;
+    void drawSurface(Vector3 aPosition, float aScale, const Camera3D& rCamera) const;
     void drawScatterPoints(Vector3 aPosition, float aScale) const;
+    void drawScatterInstanced(Vector3 aPosition, float aScale) const;
     void drawAxisLabelsAndTicks(Vector3 aPosition, float aScale, const Camera3D& rCamera) const;
     [[nodiscard]] float calculateWallAlpha(Vector3 aWallNormal, const Camera3D& rCamera) const;
 };
@@ -1,6 +1,8 @@
 // RLLinearGauge.cpp
 #include "RLLinearGauge.h"
 #include "RLCommon.h"
+#include "RLGaugePanel.h"
+#include "RLSimd.h"
 #include <algorithm>
 #include <array>
 #include <cmath>
@@ -27,7 +29,11 @@ RLLinearGauge::RLLinearGauge(Rectangle aBounds, float aMinValue, float aMaxValue
 }
 
 void RLLinearGauge::setValue(float aValue) {
-    mValue = clampValue(aValue);
+    const float lValue = clampValue(aValue);
+    if (lValue != mValue) {
+        mRedrawPending = true;
+    }
+    mValue = lValue;
     mTargetValue = mValue;
 }
 
@@ -36,6 +42,7 @@ void RLLinearGauge::setTargetValue(float aValue) {
 }
 
 void RLLinearGauge::setRange(float aMinValue, float aMaxValue) {
+    mRedrawPending = true;
     mMinValue = aMinValue;
     mMaxValue = (aMaxValue == aMinValue) ? (aMinValue + 1.0f) : aMaxValue;
     mValue = clampValue(mValue);
@@ -44,72 +51,87 @@ void RLLinearGauge::setRange(float aMinValue, float aMaxValue) {
 }
 
 void RLLinearGauge::setBounds(Rectangle aBounds) {
+    mRedrawPending = true;
     mBounds = aBounds;
     recomputeGeometry();
 }
 
 void RLLinearGauge::setOrientation(RLLinearGaugeOrientation aOrientation) {
+    mRedrawPending = true;
     mOrientation = aOrientation;
     recomputeGeometry();
 }
 
 void RLLinearGauge::setStyle(const RLLinearGaugeStyle &aStyle) {
+    mRedrawPending = true;
     mStyle = aStyle;
     recomputeGeometry();
 }
 
 void RLLinearGauge::setPointerStyle(RLLinearGaugePointerStyle aStyle) {
+    mRedrawPending = true;
     mPointerStyle = aStyle;
 }
 
 void RLLinearGauge::setAnimationEnabled(bool aEnabled) {
+    mRedrawPending = true;
     mStyle.mSmoothAnimate = aEnabled;
 }
 
 void RLLinearGauge::setTicks(int aMajorCount, int aMinorPerMajor) {
+    mRedrawPending = true;
     mStyle.mMajorTickCount = std::max(0, aMajorCount);
     mStyle.mMinorTicksPerMajor = std::max(0, aMinorPerMajor);
     recomputeGeometry();
 }
 
 void RLLinearGauge::setLabel(const std::string &aTitle) {
+    mRedrawPending = true;
     mTitle = aTitle;
     recomputeGeometry();
 }
 
 void RLLinearGauge::setUnit(const std::string &aUnit) {
+    mRedrawPending = true;
     mUnit = aUnit;
 }
 
 void RLLinearGauge::setRanges(const std::vector<RLLinearGaugeRangeBand> &aRanges) {
+    mRedrawPending = true;
     mRangeBands = aRanges;
 }
 
 void RLLinearGauge::clearRanges() {
+    mRedrawPending = true;
     mRangeBands.clear();
 }
 
 void RLLinearGauge::setTargetMarker(float aValue) {
+    mRedrawPending = true;
     mTargetMarkerValue = clampValue(aValue);
     mShowTargetMarker = true;
     mStyle.mShowTargetMarker = true;
 }
 
 void RLLinearGauge::hideTargetMarker() {
+    mRedrawPending = true;
     mShowTargetMarker = false;
     mStyle.mShowTargetMarker = false;
 }
 
 void RLLinearGauge::setMode(RLLinearGaugeMode aMode) {
+    mRedrawPending = true;
     mMode = aMode;
     recomputeGeometry();
 }
 
 void RLLinearGauge::setVuMeterStyle(const RLVuMeterStyle &aStyle) {
+    mRedrawPending = true;
     mStyle.mVuStyle = aStyle;
 }
 
 void RLLinearGauge::setChannels(const std::vector<RLVuMeterChannel> &aChannels) {
+    mRedrawPending = true;
     mChannels = aChannels;
     mPeakValues.resize(aChannels.size(), mMinValue);
     mPeakHoldTimers.resize(aChannels.size(), 0.0f);
@@ -120,7 +142,11 @@ void RLLinearGauge::setChannels(const std::vector<RLVuMeterChannel> &aChannels)
 
 void RLLinearGauge::setChannelValue(int aIndex, float aValue) {
     if (aIndex >= 0 && aIndex < (int)mChannels.size()) {
-        mChannels[(size_t)aIndex].mValue = clampValue(aValue);
+        const float lValue = clampValue(aValue);
+        if (lValue != mChannels[(size_t)aIndex].mValue) {
+            mRedrawPending = true;
+        }
+        mChannels[(size_t)aIndex].mValue = lValue;
 
         // Update peak tracking
         if (mChannels[(size_t)aIndex].mValue > mPeakValues[(size_t)aIndex]) {
@@ -130,6 +156,7 @@ void RLLinearGauge::setChannelValue(int aIndex, float aValue) {
 
         // Detect clipping (value at or near max)
         if (mChannels[(size_t)aIndex].mValue >= mMaxValue - EPSILON) {
+            mRedrawPending = true;
             mClipStates[(size_t)aIndex] = true;
             mClipTimers[(size_t)aIndex] = mStyle.mVuStyle.mClipFlashDuration;
         }
@@ -157,19 +184,131 @@ bool RLLinearGauge::isClipping(int aIndex) const {
 }
 
 void RLLinearGauge::resetPeaks() {
+    mRedrawPending = true;
     for (size_t i = 0; i < mPeakValues.size(); ++i) {
         mPeakValues[i] = mMinValue;
         mPeakHoldTimers[i] = 0.0f;
     }
+    std::fill(mPcmTruePeak.begin(), mPcmTruePeak.end(), 0.0f);
 }
 
 void RLLinearGauge::resetClip() {
+    mRedrawPending = true;
     for (size_t i = 0; i < mClipStates.size(); ++i) {
         mClipStates[i] = false;
         mClipTimers[i] = 0.0f;
     }
 }
 
+void RLLinearGauge::pushPcm(std::span<const float> aInterleaved, float aSampleRate) {
+    const size_t lChannels = mChannels.size();
+    if (lChannels == 0 || aInterleaved.size() < lChannels) {
+        return;
+    }
+    const size_t lFrames = aInterleaved.size() / lChannels;
+    if (mPcmHistory.size() != 3 * lChannels) {
+        mPcmHistory.assign(3 * lChannels, 0.0f);
+    }
+    mPcmScratch.assign(3 * lChannels, 0.0f);
+    float *pStats = mPcmScratch.data();
+    RLCharts::pcmBlockStats(aInterleaved.data(), lFrames, lChannels, pStats, pStats + lChannels,
+                            pStats + 2 * lChannels, mPcmHistory.data());
+    applyPcmBlock(lFrames, aSampleRate, lChannels, pStats, pStats + lChannels, pStats + 2 * lChannels);
+}
+
+RLLinearGauge::PcmProducer RLLinearGauge::createPcmProducer(float aSampleRate, size_t aBlocks) {
+    if (mChannels.empty() || aSampleRate <= 0.0f) {
+        return PcmProducer{};
+    }
+    mPcmQueues.push_back(std::make_unique<PcmQueue>(mChannels.size(), aSampleRate, aBlocks > 0 ? aBlocks : 1));
+    return PcmProducer{ mPcmQueues.back().get() };
+}
+
+bool RLLinearGauge::PcmProducer::push(const float *pInterleaved, size_t aFrames) {
+    if (mpQueue == nullptr || pInterleaved == nullptr || aFrames == 0) {
+        return false;
+    }
+    PcmQueue &rQueue = *mpQueue;
+    const size_t lRecordSize = rQueue.mRecord.size();
+    // Records go in whole: only the consumer frees space, so the check stays valid
+    if (rQueue.mRing.capacity() - rQueue.mRing.size() < lRecordSize) {
+        return false;
+    }
+    const size_t lChannels = rQueue.mChannels;
+    float *pRecord = rQueue.mRecord.data();
+    std::fill(rQueue.mRecord.begin(), rQueue.mRecord.end(), 0.0f);
+    pRecord[0] = (float)aFrames;
+    RLCharts::pcmBlockStats(pInterleaved, aFrames, lChannels, pRecord + 1, pRecord + 1 + lChannels,
+                            pRecord + 1 + 2 * lChannels, rQueue.mHistory.data());
+    return rQueue.mRing.push(pRecord, lRecordSize) == lRecordSize;
+}
+
+void RLLinearGauge::drainPcmQueues() {
+    for (auto &rpQueue : mPcmQueues) {
+        const size_t lChannels = rpQueue->mChannels;
+        const size_t lRecordSize = 1 + 3 * lChannels;
+        mPcmRecord.resize(lRecordSize);
+        const float *pRecord = mPcmRecord.data();
+        // Producers publish whole records, so every pop that returns data is complete
+        while (rpQueue->mRing.pop(mPcmRecord.data(), lRecordSize) == lRecordSize) {
+            applyPcmBlock((size_t)pRecord[0], rpQueue->mSampleRate, lChannels, pRecord + 1,
+                          pRecord + 1 + lChannels, pRecord + 1 + 2 * lChannels);
+        }
+    }
+}
+
+// VU ballistics for one block: the mean square is integrated with time constant
+// mRmsIntegrationTime over the block's duration, so the meter responds the same
+// whatever the block size or frame rate
+void RLLinearGauge::applyPcmBlock(size_t aFrames, float aSampleRate, size_t aChannels, const float *pSumSq,
+                                  const float *pPeak, const float *pTruePeak) {
+    if (aFrames == 0 || aSampleRate <= 0.0f) {
+        return;
+    }
+    if (mPcmMeanSquare.size() != mChannels.size()) {
+        mPcmMeanSquare.resize(mChannels.size(), 0.0f);
+        mPcmTruePeak.resize(mChannels.size(), 0.0f);
+    }
+    const RLVuMeterStyle &rVu = mStyle.mVuStyle;
+    const float lDuration = (float)aFrames / aSampleRate;
+    const float lAlpha = 1.0f - expf(-lDuration / std::max(rVu.mRmsIntegrationTime, 1e-4f));
+    const float lRange = mMaxValue - mMinValue;
+    const size_t lCount = std::min(aChannels, mChannels.size());
+    for (size_t i = 0; i < lCount; ++i) {
+        float &rMeanSquare = mPcmMeanSquare[i];
+        rMeanSquare += (pSumSq[i] / (float)aFrames - rMeanSquare) * lAlpha;
+        mPcmTruePeak[i] = std::max(mPcmTruePeak[i], pTruePeak[i]);
+        setChannelValue((int)i, mMinValue + std::min(sqrtf(rMeanSquare), 1.0f) * lRange);
+
+        // The sample peak drives the peak marker, the true peak the clip indicator
+        const float lPeak = clampValue(mMinValue + pPeak[i] * lRange);
+        if (lPeak > mPeakValues[i]) {
+            mRedrawPending = true;
+            mPeakValues[i] = lPeak;
+            mPeakHoldTimers[i] = rVu.mPeakHoldTime;
+        }
+        if (pTruePeak[i] >= rVu.mClipLevel) {
+            mRedrawPending = true;
+            mClipStates[i] = true;
+            mClipTimers[i] = rVu.mClipFlashDuration;
+        }
+    }
+}
+
+float RLLinearGauge::getChannelRms(int aIndex) const {
+    if (aIndex >= 0 && aIndex < (int)mPcmMeanSquare.size()) {
+        return sqrtf(mPcmMeanSquare[(size_t)aIndex]);
+    }
+    return 0.0f;
+}
+
+float RLLinearGauge::getTruePeak(int aIndex) const {
+    if (aIndex >= 0 && aIndex < (int)mPcmTruePeak.size()) {
+        return mPcmTruePeak[(size_t)aIndex];
+    }
+    return 0.0f;
+}
+
 float RLLinearGauge::clampValue(float aValue) const {
     return std::max(mMinValue, std::min(mMaxValue, aValue));
 }
@@ -232,6 +371,9 @@ void RLLinearGauge::recomputeGeometry() {
         TickGeom lMajorTick;
         lMajorTick.mValue = lMajorValue;
         lMajorTick.mMajor = true;
+        std::array<char, VALUE_BUFFER_SIZE> lBuf{};
+        snprintf(lBuf.data(), lBuf.size(), "%.0f", lMajorValue);
+        lMajorTick.mLabel = lBuf.data();
 
         const float lPos = valueToPosition(lMajorValue);
         if (mOrientation == RLLinearGaugeOrientation::HORIZONTAL) {
@@ -267,6 +409,13 @@ void RLLinearGauge::recomputeGeometry() {
 }
 
 void RLLinearGauge::update(float aDt) {
+    RLCHARTS_PERF_UPDATE(mPerf, "RLLinearGauge::update");
+    drainPcmQueues();
+    if (isSettled()) {
+        return;
+    }
+    mRedrawPending = true;
+
     // Update VU meter state
     if (mMode == RLLinearGaugeMode::VU_METER) {
         for (size_t i = 0; i < mChannels.size(); ++i) {
@@ -303,28 +452,99 @@ void RLLinearGauge::update(float aDt) {
     // Exponential smoothing
     const float lLambda = mStyle.mAnimateSpeed;
     const float lAlpha = 1.0f - expf(-lLambda * std::max(0.0f, aDt));
-    mValue = mValue + ((mTargetValue - mValue) * lAlpha);
+    mValue = RLCharts::approach(mValue, mTargetValue, lAlpha);
+}
+
+bool RLLinearGauge::isSettled() const {
+    if (mMode != RLLinearGaugeMode::VU_METER) {
+        return RLCharts::nearlyEqual(mValue, mTargetValue);
+    }
+    for (const auto &rpQueue : mPcmQueues) {
+        if (!rpQueue->mRing.empty()) {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < mChannels.size(); ++i) {
+        if (mPeakHoldTimers[i] > 0.0f || mClipTimers[i] > 0.0f) {
+            return false;
+        }
+        if (mPeakValues[i] > mChannels[i].mValue && mPeakValues[i] > mMinValue) {
+            return false;
+        }
+    }
+    return true;
 }
 
 void RLLinearGauge::draw() const {
+    RLCHARTS_PERF_DRAW(mPerf, "RLLinearGauge::draw");
+    drawFace();
+    drawDynamic();
+}
+
+uint64_t RLLinearGauge::getFaceKey() const {
+    RLCharts::FaceKey lKey;
+    lKey.add(mBounds.width).add(mBounds.height);
+    lKey.add((int)mOrientation).add((int)mMode).add(mMinValue).add(mMaxValue);
+    lKey.add(mStyle.mShowBackground).add(mStyle.mBackgroundColor);
+    lKey.add(mStyle.mTrackColor).add(mStyle.mTrackBorderColor).add(mStyle.mTrackThickness);
+    lKey.add(mStyle.mTrackBorderThickness).add(mStyle.mCornerRadius).add(mStyle.mPadding);
+    lKey.add(mStyle.mShowTicks).add(mStyle.mShowTickLabels).add(mStyle.mShowTitle).add(mStyle.mShowValueText);
+    lKey.add(mStyle.mMajorTickCount).add(mStyle.mMinorTicksPerMajor);
+    lKey.add(mStyle.mMajorTickColor).add(mStyle.mMinorTickColor);
+    lKey.add(mStyle.mMajorTickLength).add(mStyle.mMinorTickLength);
+    lKey.add(mStyle.mMajorTickThickness).add(mStyle.mMinorTickThickness);
+    lKey.add(mStyle.mLabelColor).add(mStyle.mTitleColor).add(mStyle.mLabelFont);
+    lKey.add(mStyle.mLabelFontSize).add(mStyle.mTitleFontSize).add(mStyle.mValueFontSize).add(mStyle.mTickLabelGap);
+    lKey.add(mTitle);
+    lKey.add(mStyle.mShowRangeBands).add((int)mRangeBands.size());
+    for (const auto &rBand : mRangeBands) {
+        lKey.add(rBand.mMin).add(rBand.mMax).add(rBand.mColor);
+    }
+    if (mMode == RLLinearGaugeMode::VU_METER) {
+        const RLVuMeterStyle &rVu = mStyle.mVuStyle;
+        lKey.add(rVu.mChannelSpacing).add(rVu.mShowChannelLabels).add(rVu.mChannelLabelFontSize);
+        lKey.add((int)mChannels.size());
+        for (const auto &rChannel : mChannels) {
+            lKey.add(rChannel.mLabel);
+        }
+    }
+    return lKey.get();
+}
+
+void RLLinearGauge::drawFace() const {
     drawBackground();
 
     // Dispatch based on mode
     if (mMode == RLLinearGaugeMode::VU_METER) {
-        drawVuMeter();
+        if (!mChannels.empty()) {
+            // Track background
+            DrawRectangleRounded(mTrackRect, mStyle.mCornerRadius / mStyle.mTrackThickness, 4, mStyle.mTrackColor);
+            for (int i = 0; i < (int)mChannels.size(); ++i) {
+                drawVuMeterChannelLabel(i, getChannelBounds(i));
+            }
+        }
         drawTitle();
         return;
     }
 
-    // Standard gauge drawing
+    // Standard gauge: ticks sit outside the track, so the fill never covers them
     drawRangeBands();
     drawTrack();
-    drawFill();
     drawTicks();
-    drawTargetMarker();
-    drawPointer();
     drawLabels();
     drawTitle();
+}
+
+void RLLinearGauge::drawDynamic() const {
+    mRedrawPending = false;
+    if (mMode == RLLinearGaugeMode::VU_METER) {
+        drawVuMeter();
+        return;
+    }
+
+    drawFill();
+    drawTargetMarker();
+    drawPointer();
     drawValueText();
 }
 
@@ -468,10 +688,7 @@ void RLLinearGauge::drawLabels() const {
             continue;
         }
 
-        std::array<char, VALUE_BUFFER_SIZE> lBuf{};
-        snprintf(lBuf.data(), lBuf.size(), "%.0f", lTick.mValue);
-
-        const Vector2 lTextSize = MeasureTextEx(lFont, lBuf.data(), lFontSize, 0);
+        const Vector2 lTextSize = mLabelCache.measure(lFont, lTick.mLabel.c_str(), lFontSize, 0);
         Vector2 lPos;
 
         if (mOrientation == RLLinearGaugeOrientation::HORIZONTAL) {
@@ -482,7 +699,7 @@ void RLLinearGauge::drawLabels() const {
             lPos.y = lTick.mP0.y - (lTextSize.y * HALF);
         }
 
-        DrawTextEx(lFont, lBuf.data(), lPos, lFontSize, 0, mStyle.mLabelColor);
+        DrawTextEx(lFont, lTick.mLabel.c_str(), lPos, lFontSize, 0, mStyle.mLabelColor);
     }
 }
 
@@ -549,7 +766,7 @@ void RLLinearGauge::drawTitle() const {
     const Font &lFont = (mStyle.mLabelFont.baseSize > 0) ? mStyle.mLabelFont : GetFontDefault();
     const float lFontSize = mStyle.mTitleFontSize;
 
-    const Vector2 lTextSize = MeasureTextEx(lFont, mTitle.c_str(), lFontSize, 0);
+    const Vector2 lTextSize = mLabelCache.measure(lFont, mTitle.c_str(), lFontSize, 0);
     Vector2 lPos;
 
     // Both horizontal and vertical: center title above the gauge in the reserved title space
@@ -632,16 +849,12 @@ void RLLinearGauge::drawVuMeter() const {
         return;
     }
 
-    // Draw track background
-    DrawRectangleRounded(mTrackRect, mStyle.mCornerRadius / mStyle.mTrackThickness, 4, mStyle.mTrackColor);
-
-    // Draw each channel
+    // Track background and channel labels are part of the face
     for (int i = 0; i < (int)mChannels.size(); ++i) {
         auto lChannelBounds = getChannelBounds(i);
         drawVuMeterChannel(i, lChannelBounds);
         drawVuMeterPeakMarker(i, lChannelBounds);
         drawVuMeterClipIndicator(i, lChannelBounds);
-        drawVuMeterChannelLabel(i, lChannelBounds);
     }
 }
 
@@ -843,7 +1056,7 @@ void RLLinearGauge::drawVuMeterChannelLabel(int aIndex, Rectangle aBounds) const
     const Font &lFont = (mStyle.mLabelFont.baseSize > 0) ? mStyle.mLabelFont : GetFontDefault();
     const float lFontSize = mStyle.mVuStyle.mChannelLabelFontSize;
 
-    const Vector2 lTextSize = MeasureTextEx(lFont, lChannel.mLabel.c_str(), lFontSize, 0);
+    const Vector2 lTextSize = mLabelCache.measure(lFont, lChannel.mLabel.c_str(), lFontSize, 0);
     Vector2 lPos;
 
     if (mOrientation == RLLinearGaugeOrientation::VERTICAL) {
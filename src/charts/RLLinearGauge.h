@@ -1,6 +1,12 @@
 // RLLinearGauge.h
 #pragma once
 #include "raylib.h"
+#include "RLPerf.h"
+#include "RLLabelCache.h"
+#include "RLSpscRing.h"
+#include <cstdint>
+#include <memory>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -67,6 +73,10 @@ struct RLVuMeterStyle {
     bool mUseDbScale{false};
     float mDbMin{-60.0f};                    // Minimum dB value (silence)
     float mDbMax{0.0f};                      // Maximum dB value (full scale)
+
+    // PCM ingest (pushPcm / PcmProducer): full scale 1.0 maps to the gauge maximum
+    float mRmsIntegrationTime{0.3f};         // RMS time constant in seconds (VU ballistics)
+    float mClipLevel{1.0f};                  // True peak at or above this flags a clip
 };
 
 // Style configuration for the linear gauge
@@ -135,7 +145,29 @@ struct RLLinearGaugeStyle {
 // A lightweight, performant linear gauge for raylib.
 // Supports horizontal/vertical orientation, colored range bands, smooth animation.
 class RLLinearGauge {
+    struct PcmQueue;
+
 public:
+    // Handle for feeding raw PCM into the VU meter from an audio callback thread.
+    // push() reduces each block to per-channel sum of squares, sample peak and
+    // true peak (SIMD, no allocation, no locks) and hands the result to update()
+    // through a lock-free single-producer/single-consumer ring. Only one thread
+    // may push through a given producer. Handles stay valid for the lifetime of
+    // the gauge.
+    class PcmProducer {
+    public:
+        PcmProducer() = default;
+        // aFrames frames of interleaved float samples, one per channel of the
+        // producer. Returns false if the queue is full (block dropped).
+        bool push(const float* pInterleaved, size_t aFrames);
+        [[nodiscard]] bool isValid() const { return mpQueue != nullptr; }
+
+    private:
+        friend class RLLinearGauge;
+        explicit PcmProducer(PcmQueue* pQueue) : mpQueue(pQueue) {}
+        PcmQueue* mpQueue{ nullptr };
+    };
+
     RLLinearGauge(Rectangle aBounds, float aMinValue, float aMaxValue,
                   RLLinearGaugeOrientation aOrientation = RLLinearGaugeOrientation::HORIZONTAL,
                   const RLLinearGaugeStyle &aStyle = {});
@@ -184,10 +216,39 @@ public:
     void resetPeaks();
     void resetClip();
 
+    // PCM ingest: interleaved float blocks (one sample per channel and frame,
+    // full scale +-1) drive the channel levels with RMS ballistics
+    // (mRmsIntegrationTime), the peak markers with the sample peak and the clip
+    // indicators with the true peak (4x oversampled estimate). Render thread;
+    // the channel count is getChannelCount().
+    void pushPcm(std::span<const float> aInterleaved, float aSampleRate);
+    // Cross-thread variant for the current channel count (call from the render
+    // thread); aBlocks is the number of blocks that can be queued between updates
+    PcmProducer createPcmProducer(float aSampleRate, size_t aBlocks = 64);
+    // Integrated RMS level and highest true peak since resetPeaks(), linear full scale
+    [[nodiscard]] float getChannelRms(int aIndex) const;
+    [[nodiscard]] float getTruePeak(int aIndex) const;
+
     // Rendering
     void update(float aDt);
     void draw() const;
 
+    // Panel rendering (RLGaugePanel.h): draw() is drawFace() then drawDynamic().
+    // The face (background, track, range bands, ticks, labels, title) only depends
+    // on the inputs hashed into getFaceKey(); fill, pointer, target marker, value
+    // text and VU channel bars are dynamic.
+    void drawFace() const;
+    void drawDynamic() const;
+    [[nodiscard]] uint64_t getFaceKey() const;
+    [[nodiscard]] Rectangle getBounds() const { return mBounds; }
+
+    // Settled when the fill has reached its target (VU mode: peak holds expired,
+    // peaks back on the channel levels and no clip flash running)
+    [[nodiscard]] bool isSettled() const;
+    [[nodiscard]] bool needsRedraw() const { return mRedrawPending || !isSettled(); }
+    // update()/rebuild/draw() timers and GPU counters (RLPerf.h); zero unless built with RLCHARTS_PERF
+    [[nodiscard]] const RLCharts::PerfStats& getPerfStats() const { return mPerf; }
+
 private:
     Rectangle mBounds{};
     float mMinValue{0.0f};
@@ -199,6 +260,9 @@ private:
     RLLinearGaugePointerStyle mPointerStyle{RLLinearGaugePointerStyle::FILL_BAR};
     RLLinearGaugeMode mMode{RLLinearGaugeMode::STANDARD};
     RLLinearGaugeStyle mStyle{};
+    mutable bool mRedrawPending{true}; // cleared by draw()
+    mutable RLCharts::PerfStats mPerf;
+    mutable RLCharts::LabelCache mLabelCache; // tick, title and channel label extents
 
     std::string mTitle{};
     std::string mUnit{};
@@ -214,12 +278,35 @@ private:
     std::vector<bool> mClipStates{};
     std::vector<float> mClipTimers{};
 
+    // PCM ingest state: integrated mean square and max true peak per channel
+    std::vector<float> mPcmMeanSquare{};
+    std::vector<float> mPcmTruePeak{};
+    std::vector<float> mPcmHistory{};    // pushPcm() interpolation history
+    std::vector<float> mPcmScratch{};    // pushPcm() block statistics
+    std::vector<float> mPcmRecord{};     // drained block record
+
+    // One producer's ring of block records: [frames, sum of squares x channels,
+    // peak x channels, true peak x channels]. The statistics buffers belong to
+    // the producer thread.
+    struct PcmQueue {
+        size_t mChannels{0};
+        float mSampleRate{48000.0f};
+        RLCharts::SpscRing<float> mRing;
+        std::vector<float> mRecord;
+        std::vector<float> mHistory;
+        PcmQueue(size_t aChannels, float aSampleRate, size_t aBlocks)
+            : mChannels(aChannels), mSampleRate(aSampleRate), mRing(aBlocks * (1 + 3 * aChannels)),
+              mRecord(1 + 3 * aChannels, 0.0f), mHistory(3 * aChannels, 0.0f) {}
+    };
+    std::vector<std::unique_ptr<PcmQueue>> mPcmQueues{};
+
     // Cached geometry for ticks to avoid per-frame recalculation
     struct TickGeom {
         Vector2 mP0{};
         Vector2 mP1{};
         float mValue{0.0f};
         bool mMajor{false};
+        std::string mLabel{};   // major ticks: formatted value
     };
     std::vector<TickGeom> mTicks{};
 
@@ -252,5 +339,9 @@ private:
     [[nodiscard]] float dbToLinear(float aDb) const;
     [[nodiscard]] Color getVuMeterColor(float aNormalizedValue) const;
     [[nodiscard]] Rectangle getChannelBounds(int aIndex) const;
+
+    void applyPcmBlock(size_t aFrames, float aSampleRate, size_t aChannels, const float* pSumSq,
+                       const float* pPeak, const float* pTruePeak);
+    void drainPcmQueues();
 };
 
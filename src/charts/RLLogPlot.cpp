@@ -1,5 +1,6 @@
 #include "RLLogPlot.h"
 #include "RLCommon.h"
+#include "RLFrameArena.h"
 #include <cmath>
 #include <algorithm>
 #include <cstdio>
@@ -11,56 +12,172 @@ RLLogPlot::RLLogPlot(Rectangle aBounds)
 }
 
 void RLLogPlot::setBounds(Rectangle aBounds) {
+    mRedrawPending = true;
     mBounds = aBounds;
     mLayoutDirty = true;
+    mStaticLayer.invalidate();
 }
 
 void RLLogPlot::setTimeSeriesHeight(float aHeightFraction) {
+    mRedrawPending = true;
     mTimeSeriesHeightFraction = RLCharts::clamp01(aHeightFraction);
     mLayoutDirty = true;
+    mStaticLayer.invalidate();
 }
 
 void RLLogPlot::setLogPlotStyle(const RLLogPlotStyle& rStyle) {
+    mRedrawPending = true;
+    mAnimSettled = false;
     mLogPlotStyle = rStyle;
     mScaleDirty = true;
+    mStaticLayer.invalidate();
 }
 
 void RLLogPlot::setTimeSeriesStyle(const RLTimeSeriesStyle& rStyle) {
+    mRedrawPending = true;
     mTimeSeriesStyle = rStyle;
+    mStaticLayer.invalidate();
+}
+
+void RLLogPlot::setStaticLayerCache(bool aEnabled) {
+    mRedrawPending = true;
+    mStaticLayer.setEnabled(aEnabled);
 }
 
 void RLLogPlot::setWindowSize(size_t aMaxSamples) {
+    if (aMaxSamples == mMaxWindowSize) {
+        return;
+    }
+    mRedrawPending = true;
+    // Keep the newest samples that still fit, oldest first at index 0
+    std::vector<float> lKept;
+    linearizeInto(lKept);
+    if (lKept.size() > aMaxSamples) {
+        lKept.erase(lKept.begin(), lKept.begin() + (std::ptrdiff_t)(lKept.size() - aMaxSamples));
+    }
     mMaxWindowSize = aMaxSamples;
-    if (mTimeSeries.size() > mMaxWindowSize) {
-        // Trim oldest samples
-        const size_t lExcess = mTimeSeries.size() - mMaxWindowSize;
-        mTimeSeries.erase(mTimeSeries.begin(), mTimeSeries.begin() + (int)lExcess);
+    mSamples.assign(mMaxWindowSize, 0.0f);
+    std::copy(lKept.begin(), lKept.end(), mSamples.begin());
+    mCount = lKept.size();
+    mHead = mMaxWindowSize > 0 ? mCount % mMaxWindowSize : 0;
+    mLinearDirty = true;
+    mExtrema.clear();
+    for (const float lVal : lKept) {
+        mExtrema.push(lVal);
+    }
+
+    // The tau range follows the window: restart the estimate from what is kept
+    if (mAllanEnabled) {
+        configureAllan();
+        for (const float lVal : lKept) {
+            accumulateAllan(lVal);
+        }
     }
 }
 
 void RLLogPlot::pushSample(float aValue) {
-    mTimeSeries.push_back(aValue);
-    if (mTimeSeries.size() > mMaxWindowSize) {
-        mTimeSeries.erase(mTimeSeries.begin());
+    mRedrawPending = true;
+    if (mAllanEnabled) {
+        accumulateAllan(aValue);
     }
+    storeSample(aValue);
+}
+
+void RLLogPlot::storeSample(float aValue) {
+    if (mMaxWindowSize == 0) {
+        return;
+    }
+    if (mSamples.size() != mMaxWindowSize) {
+        mSamples.assign(mMaxWindowSize, 0.0f);
+    }
+    mSamples[mHead] = aValue;
+    mHead = (mHead + 1) % mMaxWindowSize;
+    if (mCount < mMaxWindowSize) {
+        mCount++;
+    }
+    mExtrema.push(aValue);
+    if (mExtrema.size() > mCount) {
+        mExtrema.popFront();
+    }
+    mLinearDirty = true;
 }
 
 void RLLogPlot::pushSamples(const std::vector<float>& rValues) {
-    for (const float lVal : rValues) {
-        pushSample(lVal);
+    pushSamples(std::span<const float>(rValues.data(), rValues.size()));
+}
+
+void RLLogPlot::pushSamples(std::span<const float> aValues) {
+    if (aValues.empty()) {
+        return;
+    }
+    mRedrawPending = true;
+    // The estimator sees every sample, the window only the newest mMaxWindowSize
+    if (mAllanEnabled) {
+        for (const float lVal : aValues) {
+            accumulateAllan(lVal);
+        }
+    }
+    if (aValues.size() > mMaxWindowSize) {
+        aValues = aValues.subspan(aValues.size() - mMaxWindowSize);
+    }
+    for (const float lVal : aValues) {
+        storeSample(lVal);
     }
 }
 
 void RLLogPlot::clearTimeSeries() {
-    mTimeSeries.clear();
+    mRedrawPending = true;
+    mHead = 0;
+    mCount = 0;
+    mExtrema.clear();
+    mLinearDirty = true;
+    if (mAllanEnabled) {
+        configureAllan();
+    }
+}
+
+size_t RLLogPlot::oldestIndex() const {
+    return (mHead + mMaxWindowSize - mCount) % mMaxWindowSize;
+}
+
+void RLLogPlot::linearizeInto(std::vector<float>& rOut) const {
+    rOut.resize(mCount);
+    if (mCount == 0) {
+        return;
+    }
+    // Two contiguous runs: [oldest, end) and [0, head)
+    const size_t lStart = oldestIndex();
+    const size_t lFirst = std::min(mCount, mMaxWindowSize - lStart);
+    std::copy(mSamples.begin() + (std::ptrdiff_t)lStart, mSamples.begin() + (std::ptrdiff_t)(lStart + lFirst), rOut.begin());
+    std::copy(mSamples.begin(), mSamples.begin() + (std::ptrdiff_t)(mCount - lFirst), rOut.begin() + (std::ptrdiff_t)lFirst);
+}
+
+const std::vector<float>& RLLogPlot::getTimeSeries() const {
+    if (mLinearDirty) {
+        linearizeInto(mLinear);
+        mLinearDirty = false;
+    }
+    return mLinear;
+}
+
+float RLLogPlot::getTimeSeriesSample(size_t aIndex) const {
+    if (aIndex >= mCount) {
+        return 0.0f;
+    }
+    return mSamples[(oldestIndex() + aIndex) % mMaxWindowSize];
 }
 
 void RLLogPlot::clearTraces() {
+    mRedrawPending = true;
+    mAnimSettled = false;
     mTraces.clear();
+    mAllanEnabled = false;
     mScaleDirty = true;
 }
 
 size_t RLLogPlot::addTrace(const RLLogPlotTrace& rTrace) {
+    mRedrawPending = true;
+    mAnimSettled = false;
     mTraces.push_back(rTrace);
     mTraces.back().mDirty = true;
     mScaleDirty = true;
@@ -71,6 +188,8 @@ void RLLogPlot::setTrace(size_t aIndex, const RLLogPlotTrace& rTrace) {
     if (aIndex >= mTraces.size()) {
         return;
     }
+    mRedrawPending = true;
+    mAnimSettled = false;
     mTraces[aIndex] = rTrace;
     mTraces[aIndex].mDirty = true;
     mScaleDirty = true;
@@ -82,6 +201,8 @@ void RLLogPlot::updateTraceData(size_t aIndex, const std::vector<float>& rXValue
     if (aIndex >= mTraces.size()) {
         return;
     }
+    mRedrawPending = true;
+    mAnimSettled = false;
     auto& lTrace = mTraces[aIndex];
     lTrace.mXValues = rXValues;
     lTrace.mYValues = rYValues;
@@ -92,6 +213,137 @@ void RLLogPlot::updateTraceData(size_t aIndex, const std::vector<float>& rXValue
     mScaleDirty = true;
 }
 
+// Streaming Allan deviation
+
+size_t RLLogPlot::enableAllanDeviation(const RLLogPlotAllanConfig& rConfig,
+                                       const RLLogPlotTraceStyle& rStyle) {
+    mRedrawPending = true;
+    mAnimSettled = false;
+    mAllanConfig = rConfig;
+    if (!mAllanEnabled || mAllanTrace >= mTraces.size()) {
+        RLLogPlotTrace lTrace;
+        lTrace.mStyle = rStyle;
+        mAllanTrace = addTrace(lTrace);
+    } else {
+        mTraces[mAllanTrace].mStyle = rStyle;
+    }
+    mAllanEnabled = true;
+
+    // Seed from the samples already in the window
+    configureAllan();
+    const size_t lStart = mCount > 0 ? oldestIndex() : 0;
+    for (size_t i = 0; i < mCount; ++i) {
+        accumulateAllan(mSamples[(lStart + i) % mMaxWindowSize]);
+    }
+    refreshAllanTrace();
+    return mAllanTrace;
+}
+
+void RLLogPlot::disableAllanDeviation() {
+    mRedrawPending = true;
+    mAllanEnabled = false;
+    mAllanOctaves.clear();
+    mAllanPhase.clear();
+}
+
+void RLLogPlot::resetAllanDeviation() {
+    mRedrawPending = true;
+    if (mAllanEnabled) {
+        configureAllan();
+    }
+}
+
+void RLLogPlot::configureAllan() {
+    // Octave taus m = 1, 2, 4, ... while 2m still fits in the window
+    mAllanOctaves.clear();
+    size_t lM = 1;
+    do {
+        AllanOctave lOctave;
+        lOctave.mM = lM;
+        mAllanOctaves.push_back(lOctave);
+        lM *= 2;
+    } while (2 * lM <= mMaxWindowSize &&
+             (mAllanConfig.mMaxOctaves <= 0 || mAllanOctaves.size() < (size_t)mAllanConfig.mMaxOctaves));
+
+    // Phase x_0 = 0 at index 0; the ring only needs the last 2 * max m + 1 phase points
+    mAllanPhase.assign(2 * mAllanOctaves.back().mM + 1, 0.0);
+    mAllanHead = 1;
+    mAllanSamples = 0;
+    mAllanDirty = true;
+}
+
+void RLLogPlot::accumulateAllan(float aValue) {
+    const size_t lLen = mAllanPhase.size();
+    const double lX = mAllanPhase[(mAllanHead + lLen - 1) % lLen] + (double)aValue;
+    mAllanPhase[mAllanHead] = lX;
+    mAllanSamples++;
+
+    // One new overlapping term per octave: x[n] - 2 x[n-m] + x[n-2m]
+    for (AllanOctave& rOctave : mAllanOctaves) {
+        const size_t lM = rOctave.mM;
+        if (mAllanSamples < 2 * lM) {
+            break;
+        }
+        const double lD = lX - 2.0 * mAllanPhase[(mAllanHead + lLen - lM) % lLen]
+                        + mAllanPhase[(mAllanHead + lLen - 2 * lM) % lLen];
+        rOctave.mSum += lD * lD;
+        rOctave.mTerms++;
+    }
+
+    mAllanHead = (mAllanHead + 1) % lLen;
+    if (mAllanHead == 0) {
+        // Second differences ignore a constant offset: rebase once per lap so the
+        // running phase stays small and keeps its precision on long streams
+        for (double& rX : mAllanPhase) {
+            rX -= lX;
+        }
+    }
+    mAllanDirty = true;
+}
+
+void RLLogPlot::refreshAllanTrace() {
+    if (!mAllanEnabled || !mAllanDirty || mAllanTrace >= mTraces.size()) {
+        return;
+    }
+    mAllanDirty = false;
+    mAnimSettled = false;
+
+    RLLogPlotTrace& rTrace = mTraces[mAllanTrace];
+    rTrace.mXValues.clear();
+    rTrace.mYValues.clear();
+    rTrace.mConfidence.clear();
+
+    const double lN = (double)mAllanSamples;
+    for (const AllanOctave& rOctave : mAllanOctaves) {
+        if (rOctave.mTerms == 0) {
+            break;
+        }
+        const double lM = (double)rOctave.mM;
+        const double lAvar = rOctave.mSum / (2.0 * lM * lM * (double)rOctave.mTerms);
+        if (lAvar <= 0.0) {
+            continue; // Not representable on a log axis
+        }
+        const double lAdev = std::sqrt(lAvar);
+
+        // Equivalent degrees of freedom, white FM approximation for overlapping ADEV
+        double lEdf = (3.0 * (lN - 1.0) / (2.0 * lM) - 2.0 * (lN - 2.0) / lN)
+                    * (4.0 * lM * lM) / (4.0 * lM * lM + 5.0);
+        lEdf = std::max(lEdf, 1.0);
+        const double lErr = (double)mAllanConfig.mConfidenceSigma / std::sqrt(2.0 * lEdf);
+
+        RLLogPlotConfidence lConf;
+        lConf.mLowerBound = (float)(lAdev * std::max(1.0 - lErr, 0.05));
+        lConf.mUpperBound = (float)(lAdev * (1.0 + lErr));
+        lConf.mEnabled = mAllanConfig.mShowConfidence;
+
+        rTrace.mXValues.push_back((float)(lM * (double)mAllanConfig.mSampleInterval));
+        rTrace.mYValues.push_back((float)lAdev);
+        rTrace.mConfidence.push_back(lConf);
+    }
+    rTrace.mDirty = true;
+    mScaleDirty = true;
+}
+
 void RLLogPlot::updateLayout() const {
     if (!mLayoutDirty) {
         return;
@@ -243,37 +495,65 @@ void RLLogPlot::ensureTraceAnimation(RLLogPlotTrace& rTrace) const {
 }
 
 
+bool RLLogPlot::isSettled() const {
+    if (mAllanEnabled && mAllanDirty) {
+        return false;
+    }
+    return mAnimSettled || !mLogPlotStyle.mSmoothAnimate;
+}
+
 void RLLogPlot::update(float aDt) {
+    RLCHARTS_PERF_UPDATE(mPerf, "RLLogPlot::update");
+    if (isSettled()) {
+        return;
+    }
+    mRedrawPending = true;
+    refreshAllanTrace();
+
     if (!mLogPlotStyle.mSmoothAnimate) {
         return;
     }
 
     const float lSpeed = mLogPlotStyle.mAnimSpeed * aDt;
+    bool lSettled = true;
 
     for (auto& lTrace : mTraces) {
         ensureTraceAnimation(lTrace);
         const size_t lN = lTrace.mXValues.size();
 
-        // Animate each point
+        // Animate positions in bulk, per-point extras below
+        const size_t lAnimated = std::min(lN, lTrace.mAnimX.size());
+        if (!RLCharts::approachArray(lTrace.mAnimX.data(), lTrace.mXValues.data(), lAnimated, lSpeed)) {
+            lSettled = false;
+        }
+        if (!RLCharts::approachArray(lTrace.mAnimY.data(), lTrace.mYValues.data(), lAnimated, lSpeed)) {
+            lSettled = false;
+        }
+
         for (size_t i = 0; i < lN; ++i) {
             if (i < lTrace.mAnimX.size()) {
-                lTrace.mAnimX[i] = RLCharts::approach(lTrace.mAnimX[i], lTrace.mXValues[i], lSpeed);
-                lTrace.mAnimY[i] = RLCharts::approach(lTrace.mAnimY[i], lTrace.mYValues[i], lSpeed);
-
                 if (i < lTrace.mConfidence.size() && lTrace.mConfidence[i].mEnabled) {
                     lTrace.mAnimConfLower[i] = RLCharts::approach(lTrace.mAnimConfLower[i],
                                                         lTrace.mConfidence[i].mLowerBound, lSpeed);
                     lTrace.mAnimConfUpper[i] = RLCharts::approach(lTrace.mAnimConfUpper[i],
                                                         lTrace.mConfidence[i].mUpperBound, lSpeed);
+                    if (lTrace.mAnimConfLower[i] != lTrace.mConfidence[i].mLowerBound ||
+                        lTrace.mAnimConfUpper[i] != lTrace.mConfidence[i].mUpperBound) {
+                        lSettled = false;
+                    }
                 }
 
                 // Fade in
                 lTrace.mVisibility[i] = RLCharts::approach(lTrace.mVisibility[i], 1.0f, lSpeed);
+                if (lTrace.mVisibility[i] != 1.0f) {
+                    lSettled = false;
+                }
             }
         }
 
         lTrace.mDirty = false;
     }
+    mAnimSettled = lSettled;
 }
 
 Rectangle RLLogPlot::getTimeSeriesBounds() const {
@@ -287,50 +567,48 @@ Rectangle RLLogPlot::getLogPlotBounds() const {
 }
 
 void RLLogPlot::draw() const {
+    RLCHARTS_PERF_DRAW(mPerf, "RLLogPlot::draw");
+    mRedrawPending = false;
     updateLayout();
     updateLogScale();
 
+    // Backgrounds, grids and axes (cached if enabled). Decade labels hang into the
+    // padding and may reach past the bounds, so the layer gets a margin.
+    const float lMargin = mLogPlotStyle.mFontSize * 2.0f;
+    const Rectangle lLayerBounds{ mBounds.x - lMargin, mBounds.y - lMargin,
+                                  mBounds.width + 2.0f * lMargin, mBounds.height + 2.0f * lMargin };
+    RLCharts::FaceKey lKey;
+    lKey.add(mLogMinX).add(mLogMaxX).add(mLogMinY).add(mLogMaxY).add(mCount > 0);
+    mStaticLayer.draw(lLayerBounds, lKey.get(), [this]() { drawStaticLayer(); });
+
     drawLogPlot();
     drawTimeSeries();
 }
 
-void RLLogPlot::drawTimeSeries() const {
-    if (mTimeSeries.empty()) {
-        return;
+void RLLogPlot::drawStaticLayer() const {
+    // Log plot
+    const float lLogPad = mLogPlotStyle.mPadding;
+    const Rectangle lLogRect = { mLogPlotRect.x + lLogPad, mLogPlotRect.y + lLogPad,
+                                 mLogPlotRect.width - 2*lLogPad, mLogPlotRect.height - 2*lLogPad };
+    if (mLogPlotStyle.mShowBackground) {
+        DrawRectangleRec(mLogPlotRect, mLogPlotStyle.mBackground);
     }
+    drawLogGrid(lLogRect);
+    drawLogAxes(lLogRect);
 
+    // Time series (hidden until the first sample)
+    if (mCount == 0) {
+        return;
+    }
     const Rectangle lBounds = mTimeSeriesRect;
     const float lPad = mTimeSeriesStyle.mPadding;
     const Rectangle lPlotRect = { lBounds.x + lPad, lBounds.y + lPad,
                            lBounds.width - 2*lPad, lBounds.height - 2*lPad };
 
-    // Background
     if (mTimeSeriesStyle.mShowBackground) {
         DrawRectangleRec(lBounds, mTimeSeriesStyle.mBackground);
     }
 
-    // Find Y range
-    float lMinY = 0.0f, lMaxY = 1.0f;
-    if (mTimeSeriesStyle.mAutoScaleY && !mTimeSeries.empty()) {
-        lMinY = lMaxY = mTimeSeries[0];
-        for (const float lV : mTimeSeries) {
-            lMinY = std::min(lV, lMinY);
-            lMaxY = std::max(lV, lMaxY);
-        }
-        const float lRange = lMaxY - lMinY;
-        if (lRange < 1e-6f) {
-            lMinY -= 0.5f;
-            lMaxY += 0.5f;
-        } else {
-            lMinY -= lRange * 0.1f;
-            lMaxY += lRange * 0.1f;
-        }
-    } else {
-        lMinY = mTimeSeriesStyle.mMinY;
-        lMaxY = mTimeSeriesStyle.mMaxY;
-    }
-
-    // Grid
     if (mTimeSeriesStyle.mShowGrid) {
         const int lGridLines = 4;
         for (int i = 0; i <= lGridLines; ++i) {
@@ -341,30 +619,64 @@ void RLLogPlot::drawTimeSeries() const {
         }
     }
 
-    // Axes
     DrawLineEx(Vector2{lPlotRect.x, lPlotRect.y},
               Vector2{lPlotRect.x, lPlotRect.y + lPlotRect.height},
               2.0f, mTimeSeriesStyle.mAxesColor);
     DrawLineEx(Vector2{lPlotRect.x, lPlotRect.y + lPlotRect.height},
               Vector2{lPlotRect.x + lPlotRect.width, lPlotRect.y + lPlotRect.height},
               2.0f, mTimeSeriesStyle.mAxesColor);
+}
+
+void RLLogPlot::drawTimeSeries() const {
+    if (mCount == 0) {
+        return;
+    }
+
+    const Rectangle lBounds = mTimeSeriesRect;
+    const float lPad = mTimeSeriesStyle.mPadding;
+    const Rectangle lPlotRect = { lBounds.x + lPad, lBounds.y + lPad,
+                           lBounds.width - 2*lPad, lBounds.height - 2*lPad };
+
+    // Find Y range
+    float lMinY = 0.0f, lMaxY = 1.0f;
+    if (mTimeSeriesStyle.mAutoScaleY) {
+        // Kept up to date per sample, so the window size does not matter here
+        lMinY = mExtrema.getMin();
+        lMaxY = mExtrema.getMax();
+        const float lRange = lMaxY - lMinY;
+        if (lRange < 1e-6f) {
+            lMinY -= 0.5f;
+            lMaxY += 0.5f;
+        } else {
+            lMinY -= lRange * 0.1f;
+            lMaxY += lRange * 0.1f;
+        }
+    } else {
+        lMinY = mTimeSeriesStyle.mMinY;
+        lMaxY = mTimeSeriesStyle.mMaxY;
+    }
 
     // Map points to screen space
-    const size_t lN = mTimeSeries.size();
+    const size_t lN = mCount;
     if (lN < 2) {
         return;
     }
 
-    std::vector<Vector2> lPoints;
+    RLCharts::FrameScratch lScratch;
+    std::pmr::vector<Vector2> lPoints(lScratch.resource());
     lPoints.reserve(lN);
 
+    size_t lIdx = oldestIndex();
     for (size_t i = 0; i < lN; ++i) {
         const float lX = lPlotRect.x + ((float)i / (float)(lN - 1)) * lPlotRect.width;
-        const float lNormY = (mTimeSeries[i] - lMinY) / (lMaxY - lMinY);
+        const float lNormY = (mSamples[lIdx] - lMinY) / (lMaxY - lMinY);
+        lIdx = (lIdx + 1 == mMaxWindowSize) ? 0 : lIdx + 1;
         const float lY = lPlotRect.y + lPlotRect.height - lNormY * lPlotRect.height;
         lPoints.push_back(Vector2{lX, lY});
     }
 
+    mBatch.clear();
+
     // Fill under curve
     if (mTimeSeriesStyle.mFillUnderCurve && lN >= 2) {
         for (size_t i = 0; i < lN - 1; ++i) {
@@ -372,13 +684,13 @@ void RLLogPlot::drawTimeSeries() const {
             const Vector2 lP2 = lPoints[i + 1];
             const float lBottom = lPlotRect.y + lPlotRect.height;
 
-            DrawTriangle(
+            mBatch.addTriangle(
                 Vector2{lP1.x, lBottom},
                 lP1,
                 lP2,
                 mTimeSeriesStyle.mFillColor
             );
-            DrawTriangle(
+            mBatch.addTriangle(
                 Vector2{lP1.x, lBottom},
                 lP2,
                 Vector2{lP2.x, lBottom},
@@ -388,11 +700,10 @@ void RLLogPlot::drawTimeSeries() const {
     }
 
     // Draw line
-    for (size_t i = 0; i < lN - 1; ++i) {
-        DrawLineEx(lPoints[i], lPoints[i + 1],
-                  mTimeSeriesStyle.mLineThickness,
-                  mTimeSeriesStyle.mLineColor);
-    }
+    mBatch.addPolyline(lPoints.data(), lPoints.size(),
+                       mTimeSeriesStyle.mLineThickness,
+                       mTimeSeriesStyle.mLineColor);
+    mBatch.draw();
 
     // Title
     if (!mTimeSeriesStyle.mTitle.empty()) {
@@ -420,15 +731,6 @@ void RLLogPlot::drawLogPlot() const {
     const Rectangle lPlotRect = { lBounds.x + lPad, lBounds.y + lPad,
                            lBounds.width - 2*lPad, lBounds.height - 2*lPad };
 
-    // Background
-    if (mLogPlotStyle.mShowBackground) {
-        DrawRectangleRec(lBounds, mLogPlotStyle.mBackground);
-    }
-
-    // Grid and axes
-    drawLogGrid(lPlotRect);
-    drawLogAxes(lPlotRect);
-
     // Draw all traces
     for (const auto& lTrace : mTraces) {
         drawLogTrace(lTrace, lPlotRect);
@@ -438,7 +740,7 @@ void RLLogPlot::drawLogPlot() const {
     if (!mLogPlotStyle.mTitle.empty()) {
         const int lTitleSize = (int)mLogPlotStyle.mTitleFontSize;
         const Font& lFont = (mLogPlotStyle.mFont.baseSize > 0) ? mLogPlotStyle.mFont : GetFontDefault();
-        const Vector2 lTitleSize2 = MeasureTextEx(lFont, mLogPlotStyle.mTitle.c_str(), (float)lTitleSize, 0);
+        const Vector2 lTitleSize2 = mLabelCache.measure(lFont, mLogPlotStyle.mTitle.c_str(), (float)lTitleSize, 0);
         DrawTextEx(lFont, mLogPlotStyle.mTitle.c_str(),
                 Vector2{lBounds.x + lBounds.width * 0.5f - lTitleSize2.x * 0.5f, lBounds.y + 8},
                 (float)lTitleSize, 0,
@@ -525,6 +827,7 @@ void RLLogPlot::drawLogAxes(Rectangle aPlotRect) const {
     // X-axis labels
     const int lStartDecadeX = (int)floorf(mLogMinX);
     const int lEndDecadeX = (int)ceilf(mLogMaxX);
+    mDecadeLabelsX.resize((size_t)std::max(lEndDecadeX - lStartDecadeX + 1, 0));
     for (int lDec = lStartDecadeX; lDec <= lEndDecadeX; ++lDec) {
         const auto lLogX = (float)lDec;
         if (lLogX < mLogMinX || lLogX > mLogMaxX) {
@@ -532,16 +835,16 @@ void RLLogPlot::drawLogAxes(Rectangle aPlotRect) const {
         }
 
         const Vector2 lPos = mapLogPoint(lLogX, mLogMinY, aPlotRect);
-        char lBuf[32];
-        snprintf(lBuf, sizeof(lBuf), "10^%d", lDec);
-        const Vector2 lTextSize = MeasureTextEx(lFont, lBuf, (float)lFontSize, 0);
-        DrawTextEx(lFont, lBuf, Vector2{lPos.x - lTextSize.x * 0.5f, lPos.y + 8},
+        const char* pText = mDecadeLabelsX[(size_t)(lDec - lStartDecadeX)].format("10^%d", lDec);
+        const Vector2 lTextSize = mLabelCache.measure(lFont, pText, (float)lFontSize, 0);
+        DrawTextEx(lFont, pText, Vector2{lPos.x - lTextSize.x * 0.5f, lPos.y + 8},
                 (float)lFontSize, 0, mLogPlotStyle.mTextColor);
     }
 
     // Y-axis labels
     const int lStartDecadeY = (int)floorf(mLogMinY);
     const int lEndDecadeY = (int)ceilf(mLogMaxY);
+    mDecadeLabelsY.resize((size_t)std::max(lEndDecadeY - lStartDecadeY + 1, 0));
     for (int lDec = lStartDecadeY; lDec <= lEndDecadeY; ++lDec) {
         const auto lLogY = (float)lDec;
         if (lLogY < mLogMinY || lLogY > mLogMaxY) {
@@ -549,17 +852,16 @@ void RLLogPlot::drawLogAxes(Rectangle aPlotRect) const {
         }
 
         const Vector2 lPos = mapLogPoint(mLogMinX, lLogY, aPlotRect);
-        char lBuf[32];
-        snprintf(lBuf, sizeof(lBuf), "10^%d", lDec);
-        const Vector2 lTextSize = MeasureTextEx(lFont, lBuf, (float)lFontSize, 0);
-        DrawTextEx(lFont, lBuf, Vector2{lPos.x - lTextSize.x - 10, lPos.y - (float)lFontSize * 0.5f},
+        const char* pText = mDecadeLabelsY[(size_t)(lDec - lStartDecadeY)].format("10^%d", lDec);
+        const Vector2 lTextSize = mLabelCache.measure(lFont, pText, (float)lFontSize, 0);
+        DrawTextEx(lFont, pText, Vector2{lPos.x - lTextSize.x - 10, lPos.y - (float)lFontSize * 0.5f},
                 (float)lFontSize, 0, mLogPlotStyle.mTextColor);
     }
 
     // Axis labels
     if (!mLogPlotStyle.mXAxisLabel.empty()) {
         const int lLabelSize = lFontSize + 2;
-        const Vector2 lTextSize = MeasureTextEx(lFont, mLogPlotStyle.mXAxisLabel.c_str(), (float)lLabelSize, 0);
+        const Vector2 lTextSize = mLabelCache.measure(lFont, mLogPlotStyle.mXAxisLabel.c_str(), (float)lLabelSize, 0);
         DrawTextEx(lFont, mLogPlotStyle.mXAxisLabel.c_str(),
                 Vector2{aPlotRect.x + aPlotRect.width * 0.5f - lTextSize.x * 0.5f, aPlotRect.y + aPlotRect.height + 35},
                 (float)lLabelSize, 0,
@@ -598,7 +900,8 @@ void RLLogPlot::drawLogTrace(const RLLogPlotTrace& rTrace, Rectangle aPlotRect)
     }
 
     // Map points to screen space
-    std::vector<Vector2> lScreenPoints;
+    RLCharts::FrameScratch lScratch;
+    std::pmr::vector<Vector2> lScreenPoints(lScratch.resource());
     lScreenPoints.reserve(lN);
 
     for (size_t i = 0; i < lN; ++i) {
@@ -613,6 +916,9 @@ void RLLogPlot::drawLogTrace(const RLLogPlotTrace& rTrace, Rectangle aPlotRect)
         return;
     }
 
+    mBatch.clear();
+    mMarkers.clear();
+
     // Draw confidence intervals first (so they're behind the line)
     if (rTrace.mStyle.mShowConfidenceIntervals) {
         Color lConfColor = rTrace.mStyle.mConfidenceColor;
@@ -654,12 +960,12 @@ void RLLogPlot::drawLogTrace(const RLLogPlotTrace& rTrace, Rectangle aPlotRect)
 
             if (rTrace.mStyle.mConfidenceAsBars) {
                 // Error bars
-                DrawLineEx(lLowerPt, lUpperPt, 2.0f, lDrawColor);
+                mBatch.addSegment(lLowerPt, lUpperPt, 2.0f, lDrawColor);
                 const float lCapW = rTrace.mStyle.mConfidenceBarWidth * 0.5f;
-                DrawLineEx(Vector2{lLowerPt.x - lCapW, lLowerPt.y},
-                          Vector2{lLowerPt.x + lCapW, lLowerPt.y}, 2.0f, lDrawColor);
-                DrawLineEx(Vector2{lUpperPt.x - lCapW, lUpperPt.y},
-                          Vector2{lUpperPt.x + lCapW, lUpperPt.y}, 2.0f, lDrawColor);
+                mBatch.addSegment(Vector2{lLowerPt.x - lCapW, lLowerPt.y},
+                                  Vector2{lLowerPt.x + lCapW, lLowerPt.y}, 2.0f, lDrawColor);
+                mBatch.addSegment(Vector2{lUpperPt.x - lCapW, lUpperPt.y},
+                                  Vector2{lUpperPt.x + lCapW, lUpperPt.y}, 2.0f, lDrawColor);
             } else {
                 // Shaded band (draw to next point if available)
                 if (i + 1 < lN && i + 1 < rTrace.mConfidence.size() &&
@@ -679,8 +985,8 @@ void RLLogPlot::drawLogTrace(const RLLogPlotTrace& rTrace, Rectangle aPlotRect)
                         const Vector2 lNextUpperPt = mapLogPoint(lNextLogX, log10f(lNextUpper), aPlotRect);
 
                         // Draw quad as two triangles
-                        DrawTriangle(lLowerPt, lUpperPt, lNextUpperPt, lDrawColor);
-                        DrawTriangle(lLowerPt, lNextUpperPt, lNextLowerPt, lDrawColor);
+                        mBatch.addTriangle(lLowerPt, lUpperPt, lNextUpperPt, lDrawColor);
+                        mBatch.addTriangle(lLowerPt, lNextUpperPt, lNextLowerPt, lDrawColor);
                     }
                 }
             }
@@ -691,8 +997,8 @@ void RLLogPlot::drawLogTrace(const RLLogPlotTrace& rTrace, Rectangle aPlotRect)
     for (size_t i = 0; i < lScreenPoints.size() - 1; ++i) {
         const float lVis = (i < rTrace.mVisibility.size()) ? rTrace.mVisibility[i] : 1.0f;
         const Color lDrawColor = RLCharts::fadeColor(rTrace.mStyle.mLineColor, lVis);
-        DrawLineEx(lScreenPoints[i], lScreenPoints[i + 1],
-                  rTrace.mStyle.mLineThickness, lDrawColor);
+        mBatch.addSegment(lScreenPoints[i], lScreenPoints[i + 1],
+                          rTrace.mStyle.mLineThickness, lDrawColor);
     }
 
     // Draw points
@@ -705,13 +1011,14 @@ void RLLogPlot::drawLogTrace(const RLLogPlotTrace& rTrace, Rectangle aPlotRect)
         for (size_t i = 0; i < lScreenPoints.size(); ++i) {
             const float lVis = (i < rTrace.mVisibility.size()) ? rTrace.mVisibility[i] : 1.0f;
             const Color lDrawColor = RLCharts::fadeColor(lPointColor, lVis);
-            DrawCircleV(lScreenPoints[i], rTrace.mStyle.mPointRadius, lDrawColor);
 
-            // Outline for visibility
+            // Outline for visibility: a 1px ring centered on the point radius
             const Color lOutline = Color{20, 22, 28, (unsigned char)(255.0f * lVis)};
-            DrawCircleLines((int)lScreenPoints[i].x, (int)lScreenPoints[i].y,
-                          rTrace.mStyle.mPointRadius, lOutline);
+            mMarkers.add(lScreenPoints[i], rTrace.mStyle.mPointRadius - 0.5f, lDrawColor, 1.0f, lOutline);
         }
     }
+
+    mBatch.draw();
+    mMarkers.draw();
 }
 
@@ -1,7 +1,14 @@
 #pragma once
 #include "raylib.h"
+#include "RLPerf.h"
+#include "RLLabelCache.h"
 #include "RLCommon.h"
+#include "RLLineBatch.h"
+#include "RLCircleBatch.h"
+#include "RLSlidingExtrema.h"
+#include "RLRenderCache.h"
 #include <vector>
+#include <span>
 #include <functional>
 #include <string>
 
@@ -108,6 +115,14 @@ struct RLTimeSeriesStyle {
     Font mFont{};                 // Optional custom font; if .baseSize==0 use default
 };
 
+// Streaming overlapping Allan deviation estimator configuration
+struct RLLogPlotAllanConfig {
+    float mSampleInterval{ 1.0f };  // tau0 between pushed samples (x axis unit)
+    int mMaxOctaves{ 0 };           // taus are tau0 * 2^k; 0 = as many as the window allows
+    float mConfidenceSigma{ 1.0f }; // half-width of the interval in standard errors
+    bool mShowConfidence{ true };
+};
+
 // Main class: dual-view plot system with time series + log-log analysis
 class RLLogPlot {
 public:
@@ -124,8 +139,9 @@ public:
     void setWindowSize(size_t aMaxSamples);
     void pushSample(float aValue);           // Add one sample (FIFO)
     void pushSamples(const std::vector<float>& rValues); // Add multiple
+    void pushSamples(std::span<const float> aValues);     // Add multiple from caller-owned memory
     void clearTimeSeries();
-    [[nodiscard]] size_t getTimeSeriesSize() const { return mTimeSeries.size(); }
+    [[nodiscard]] size_t getTimeSeriesSize() const { return mCount; }
     [[nodiscard]] size_t getWindowSize() const { return mMaxWindowSize; }
 
     // Log-log trace management
@@ -137,11 +153,33 @@ public:
                          const std::vector<RLLogPlotConfidence>* pConfidence = nullptr);
     [[nodiscard]] size_t getTraceCount() const { return mTraces.size(); }
 
+    // Built-in Allan deviation: every pushed sample (treated as fractional frequency)
+    // updates running sums per octave tau in O(octaves); update() refreshes a trace
+    // with the estimates and confidence intervals. Returns the trace index.
+    size_t enableAllanDeviation(const RLLogPlotAllanConfig& rConfig = {},
+                                const RLLogPlotTraceStyle& rStyle = {});
+    void disableAllanDeviation();
+    void resetAllanDeviation();   // Drop accumulated sums, keep the trace
+    [[nodiscard]] bool isAllanDeviationEnabled() const { return mAllanEnabled; }
+
     // Update animation state (call each frame)
     void update(float aDt);
 
     // Draw both plots
     void draw() const;
+    // Keep the backgrounds, grids, axes and decade labels of both plots in a
+    // render texture that is re-rendered only after a bounds, layout or style
+    // setter or a change of the log-plot decades, and draw just the traces over it
+    // each frame (RLRenderCache.h). Off by default.
+    void setStaticLayerCache(bool aEnabled);
+    [[nodiscard]] const RLCharts::StaticLayer& getStaticLayer() const { return mStaticLayer; }
+
+    // Settled once every trace point finished animating and the Allan trace is
+    // current; needsRedraw() also covers setters and samples since the last draw()
+    [[nodiscard]] bool isSettled() const;
+    [[nodiscard]] bool needsRedraw() const { return mRedrawPending || !isSettled(); }
+    // update()/rebuild/draw() timers and GPU counters (RLPerf.h); zero unless built with RLCHARTS_PERF
+    [[nodiscard]] const RLCharts::PerfStats& getPerfStats() const { return mPerf; }
 
     // Helpers
     [[nodiscard]] Rectangle getBounds() const { return mBounds; }
@@ -149,21 +187,45 @@ public:
     [[nodiscard]] Rectangle getLogPlotBounds() const;
 
     // Direct access for advanced usage
-    [[nodiscard]] const std::vector<float>& getTimeSeries() const { return mTimeSeries; }
-    [[nodiscard]] std::vector<RLLogPlotTrace>& getTraces() { return mTraces; }
+    // Oldest-first copy of the window, rebuilt lazily after new samples arrive
+    [[nodiscard]] const std::vector<float>& getTimeSeries() const;
+    // Oldest-first sample access without linearizing (aIndex < getTimeSeriesSize())
+    [[nodiscard]] float getTimeSeriesSample(size_t aIndex) const;
+    // Handing out mutable traces restarts the animation check
+    [[nodiscard]] std::vector<RLLogPlotTrace>& getTraces() { mAnimSettled = false; mRedrawPending = true; return mTraces; }
 
 private:
     Rectangle mBounds{};
     float mTimeSeriesHeightFraction{ 0.35f };
     float mGapBetweenPlots{ 20.0f };
 
-    // Time series data
-    std::vector<float> mTimeSeries;
+    // Time series data: fixed ring of mMaxWindowSize samples (mHead = next write)
+    std::vector<float> mSamples;
+    size_t mHead{ 0 };
+    size_t mCount{ 0 };
     size_t mMaxWindowSize{ 1000 };
+    RLCharts::SlidingExtrema<float> mExtrema; // range of the ring, for autoscale
+    mutable std::vector<float> mLinear;   // linearized copy for getTimeSeries()
+    mutable bool mLinearDirty{ true };
 
     // Log-log traces
     std::vector<RLLogPlotTrace> mTraces;
 
+    // Streaming Allan deviation state
+    struct AllanOctave {
+        size_t mM{ 1 };        // averaging factor (tau = m * tau0)
+        double mSum{ 0.0 };    // sum of squared second differences of phase
+        size_t mTerms{ 0 };
+    };
+    bool mAllanEnabled{ false };
+    bool mAllanDirty{ false };
+    size_t mAllanTrace{ 0 };
+    RLLogPlotAllanConfig mAllanConfig{};
+    std::vector<AllanOctave> mAllanOctaves;
+    std::vector<double> mAllanPhase;  // ring of integrated samples, 2 * max m + 1 long
+    size_t mAllanHead{ 0 };           // next write in mAllanPhase
+    size_t mAllanSamples{ 0 };        // samples seen since reset
+
     // Styles
     RLLogPlotStyle mLogPlotStyle{};
     RLTimeSeriesStyle mTimeSeriesStyle{};
@@ -180,15 +242,36 @@ private:
     mutable float mLogMaxY{ 0.0f };
     mutable bool mScaleDirty{ true };
 
+    bool mAnimSettled{ false };          // last update() left every trace on its data
+    mutable bool mRedrawPending{ true }; // cleared by draw()
+    mutable RLCharts::PerfStats mPerf;
+    mutable RLCharts::LabelCache mLabelCache;
+    mutable RLCharts::StaticLayer mStaticLayer;
+    // Decade labels, one per visible decade; only reformatted when the range moves
+    mutable std::vector<RLCharts::FormattedLabel> mDecadeLabelsX;
+    mutable std::vector<RLCharts::FormattedLabel> mDecadeLabelsY;
+
+    // Scratch batches for trace lines and bands, and for markers (one submission per pane/trace)
+    mutable RLCharts::LineBatch mBatch;
+    mutable RLCharts::CircleBatch mMarkers; // trace points, instanced
+
     // Helper methods
     void updateLayout() const;
     void updateLogScale() const;
+    void drawStaticLayer() const;
     void drawTimeSeries() const;
     void drawLogPlot() const;
     void drawLogGrid(Rectangle aPlotRect) const;
     void drawLogAxes(Rectangle aPlotRect) const;
     void drawLogTrace(const RLLogPlotTrace& rTrace, Rectangle aPlotRect) const;
 
+    void storeSample(float aValue);
+    [[nodiscard]] size_t oldestIndex() const;
+    void configureAllan();
+    void accumulateAllan(float aValue);
+    void refreshAllanTrace();
+    void linearizeInto(std::vector<float>& rOut) const;
+
     Vector2 mapLogPoint(float aLogX, float aLogY, Rectangle aRect) const;
     void ensureTraceAnimation(RLLogPlotTrace& rTrace) const;
 };
@@ -1,11 +1,14 @@
 // RLOrderBookVis.cpp
 #include "RLOrderBookVis.h"
 #include "RLCommon.h"
+#include "RLGpuColormap.h"
+#include "RLStateCodec.h"
 #include "raymath.h"
 #include <cmath>
 #include <algorithm>
 #include <cstring>
 #include <cstdint>
+#include <string>
 
 RLOrderBookVis::RLOrderBookVis(Rectangle aBounds, size_t aHistoryLength, size_t aPriceLevels)
     : mBounds(aBounds)
@@ -34,6 +37,7 @@ RLOrderBookVis::RLOrderBookVis(Rectangle aBounds, size_t aHistoryLength, size_t
 
 RLOrderBookVis::~RLOrderBookVis() {
     cleanupTexture();
+    cleanupGpuResources();
     cleanupMesh();
     cleanupRenderTarget();
 }
@@ -46,6 +50,213 @@ void RLOrderBookVis::cleanupTexture() {
     }
 }
 
+void RLOrderBookVis::cleanupGpuResources() {
+    cleanupGpuShader();
+    cleanupDisplacement();
+    Texture2D* lTextures[] = { &mBidGridTexture, &mAskGridTexture, &mBidLutTexture, &mAskLutTexture };
+    for (Texture2D* pTexture : lTextures) {
+        if (pTexture->id != 0) {
+            UnloadTexture(*pTexture);
+            *pTexture = Texture2D{};
+        }
+    }
+}
+
+void RLOrderBookVis::cleanupGpuShader() {
+    if (mGpuShader.id != 0) {
+        UnloadShader(mGpuShader);
+        mGpuShader = Shader{};
+    }
+    mGpuReady = false;
+}
+
+void RLOrderBookVis::cleanupDisplacement() {
+    if (mDisplaceMaterial.maps != nullptr) {
+        // The maps only borrow the grid/LUT textures, the shader is unloaded below
+        MemFree(mDisplaceMaterial.maps);
+        mDisplaceMaterial = Material{};
+    }
+    if (mDisplaceShader.id != 0) {
+        UnloadShader(mDisplaceShader);
+        mDisplaceShader = Shader{};
+    }
+    if (mDisplaceMesh.vertexCount > 0) {
+        UnloadMesh(mDisplaceMesh);
+        mDisplaceMesh = Mesh{};
+    }
+    mDisplaceReady = false;
+}
+
+bool RLOrderBookVis::ensureGridTextures() {
+    // Created empty; LUTs and grids come from the staged frame
+    if (mBidLutTexture.id == 0) {
+        mBidLutTexture = RLCharts::loadLutTexture(nullptr);
+        mAskLutTexture = RLCharts::loadLutTexture(nullptr);
+    }
+    if (mBidGridTexture.id == 0) {
+        mBidGridTexture = RLCharts::loadFloatGridTexture((int)mPriceLevels, (int)mHistoryLength, nullptr, true);
+        mAskGridTexture = RLCharts::loadFloatGridTexture((int)mPriceLevels, (int)mHistoryLength, nullptr, true);
+    }
+    return mBidLutTexture.id != 0 && mAskLutTexture.id != 0 && mBidGridTexture.id != 0 && mAskGridTexture.id != 0;
+}
+
+bool RLOrderBookVis::ensureDisplacementResources() {
+    if (mDisplaceReady) {
+        return true;
+    }
+    // Vertex texture fetch is optional on GLES 2 / WebGL 1: desktop GL only
+    if (mDisplaceFailed || RLCharts::isGlesContext()) {
+        mDisplaceFailed = true;
+        return false;
+    }
+
+    if (mDisplaceShader.id == 0) {
+        // Static grid vertex: x = time offset, z = price row. Height and color come
+        // from the ring-ordered grid textures, same math as updateMeshData.
+        const char* pVertex =
+            "#version 330\n"
+            "in vec3 vertexPosition;\n"
+            "uniform mat4 mvp;\n"
+            "uniform sampler2D bidGrid;\n"
+            "uniform sampler2D askGrid;\n"
+            "uniform sampler2D bidLut;\n"
+            "uniform sampler2D askLut;\n"
+            "uniform vec2 invMax;\n"
+            "uniform vec3 ring;\n"
+            "uniform vec2 cellHeight;\n"
+            "uniform float side;\n"
+            "out vec4 fragColor;\n"
+            "void main() {\n"
+            "    float lOffset = min(vertexPosition.x, ring.y - 1.0);\n"
+            "    ivec2 lCell = ivec2(int(vertexPosition.z), int(mod(ring.z + lOffset, ring.x)));\n"
+            "    float lNorm = side < 0.5 ? texelFetch(bidGrid, lCell, 0).r * invMax.x\n"
+            "                             : texelFetch(askGrid, lCell, 0).r * invMax.y;\n"
+            "    ivec2 lLutIdx = ivec2(int(clamp(lNorm * 255.0, 0.0, 255.0)), 0);\n"
+            "    fragColor = side < 0.5 ? texelFetch(bidLut, lLutIdx, 0) : texelFetch(askLut, lLutIdx, 0);\n"
+            "    gl_Position = mvp * vec4(vertexPosition.x * cellHeight.x, lNorm * cellHeight.y,\n"
+            "                             vertexPosition.z * cellHeight.x, 1.0);\n"
+            "}\n";
+        const char* pFragment =
+            "#version 330\n"
+            "in vec4 fragColor;\n"
+            "out vec4 finalColor;\n"
+            "void main() { finalColor = fragColor; }\n";
+        mDisplaceShader = LoadShaderFromMemory(pVertex, pFragment);
+        if (IsShaderValid(mDisplaceShader)) {
+            // Grid/LUT textures are bound through material map slots by DrawMesh
+            mDisplaceShader.locs[SHADER_LOC_MAP_ALBEDO] = GetShaderLocation(mDisplaceShader, "bidGrid");
+            mDisplaceShader.locs[SHADER_LOC_MAP_METALNESS] = GetShaderLocation(mDisplaceShader, "askGrid");
+            mDisplaceShader.locs[SHADER_LOC_MAP_NORMAL] = GetShaderLocation(mDisplaceShader, "bidLut");
+            mDisplaceShader.locs[SHADER_LOC_MAP_ROUGHNESS] = GetShaderLocation(mDisplaceShader, "askLut");
+        }
+        mLocDispInvMax = GetShaderLocation(mDisplaceShader, "invMax");
+        mLocDispRing = GetShaderLocation(mDisplaceShader, "ring");
+        mLocDispCellHeight = GetShaderLocation(mDisplaceShader, "cellHeight");
+        mLocDispSide = GetShaderLocation(mDisplaceShader, "side");
+    }
+
+    const int lQuadsX = (int)mHistoryLength - 1;
+    const int lQuadsY = (int)mPriceLevels - 1;
+    if (mDisplaceMesh.vertexCount == 0 && lQuadsX >= 1 && lQuadsY >= 1) {
+        // Positions never change: upload once as a static buffer
+        mDisplaceMesh.vertexCount = lQuadsX * lQuadsY * 6;
+        mDisplaceMesh.triangleCount = lQuadsX * lQuadsY * 2;
+        mDisplaceMesh.vertices = (float*)MemAlloc(static_cast<unsigned long>(mDisplaceMesh.vertexCount) * 3 * sizeof(float));
+        float* pVerts = mDisplaceMesh.vertices;
+        for (int lQy = 0; lQy < lQuadsY; ++lQy) {
+            for (int lQx = 0; lQx < lQuadsX; ++lQx) {
+                const float lX0 = (float)lQx;
+                const float lX1 = (float)(lQx + 1);
+                const float lZ0 = (float)lQy;
+                const float lZ1 = (float)(lQy + 1);
+                const float lQuad[18] = {
+                    lX0, 0.0f, lZ0,  lX1, 0.0f, lZ0,  lX0, 0.0f, lZ1,
+                    lX1, 0.0f, lZ0,  lX1, 0.0f, lZ1,  lX0, 0.0f, lZ1
+                };
+                std::memcpy(pVerts, lQuad, sizeof(lQuad));
+                pVerts += 18;
+            }
+        }
+        UploadMesh(&mDisplaceMesh, false);
+    }
+
+    mDisplaceReady = IsShaderValid(mDisplaceShader) && mDisplaceMesh.vaoId != 0 && ensureGridTextures();
+    if (!mDisplaceReady) {
+        // The next prepare() switches back to the CPU meshes
+        cleanupDisplacement();
+        mDisplaceFailed = true;
+        return false;
+    }
+
+    if (mDisplaceMaterial.maps == nullptr) {
+        mDisplaceMaterial = LoadMaterialDefault();
+        mDisplaceMaterial.shader = mDisplaceShader;
+    }
+    mDisplaceMaterial.maps[MATERIAL_MAP_ALBEDO].texture = mBidGridTexture;
+    mDisplaceMaterial.maps[MATERIAL_MAP_METALNESS].texture = mAskGridTexture;
+    mDisplaceMaterial.maps[MATERIAL_MAP_NORMAL].texture = mBidLutTexture;
+    mDisplaceMaterial.maps[MATERIAL_MAP_ROUGHNESS].texture = mAskLutTexture;
+
+    // The CPU meshes are no longer needed
+    cleanupMesh();
+    return true;
+}
+
+bool RLOrderBookVis::ensureGpuResources() {
+    if (mGpuReady) {
+        return true;
+    }
+    if (mGpuFailed) {
+        return false;
+    }
+
+    if (mGpuShader.id == 0) {
+        std::string lBody = "uniform sampler2D askGrid;\n"
+                            "uniform sampler2D bidLut;\n"
+                            "uniform sampler2D askLut;\n"
+                            "uniform vec2 invMax;\n"
+                            "uniform vec3 ring;\n"
+                            "uniform vec4 background;\n";
+        lBody += RLCharts::colormapLookupGlsl();
+        lBody += "void main() {\n"
+                 "    // Screen x = time offset (oldest left, clamped to the newest), y = price row\n"
+                 "    float lOffset = min(floor(fragTexCoord.x * ring.x), ring.y - 1.0);\n"
+                 "    float lRow = mod(ring.z + lOffset, ring.x);\n"
+                 "    vec2 lUv = vec2(fragTexCoord.y, (lRow + 0.5) / ring.x);\n"
+                 "    float lBid = GRID_TEXTURE(texture0, lUv).r;\n"
+                 "    float lAsk = GRID_TEXTURE(askGrid, lUv).r;\n"
+                 "    vec4 lColor = background;\n"
+                 "    if (lBid > 0.0 && lAsk > 0.0) {\n"
+                 "        vec4 lBidColor = lutLookup(bidLut, lBid, invMax.x);\n"
+                 "        vec4 lAskColor = lutLookup(askLut, lAsk, invMax.y);\n"
+                 "        float lBidI = lBid * invMax.x;\n"
+                 "        float lAskI = lAsk * invMax.y;\n"
+                 "        float lW = lBidI / (lBidI + lAskI + 0.001 / 255.0);\n"
+                 "        lColor = vec4(mix(lAskColor.rgb, lBidColor.rgb, lW), (lBidColor.a + lAskColor.a) * 0.5);\n"
+                 "    } else if (lBid > 0.0) {\n"
+                 "        lColor = lutLookup(bidLut, lBid, invMax.x);\n"
+                 "    } else if (lAsk > 0.0) {\n"
+                 "        lColor = lutLookup(askLut, lAsk, invMax.y);\n"
+                 "    }\n"
+                 "    FRAG_OUT = lColor * fragColor;\n"
+                 "}\n";
+        mGpuShader = RLCharts::loadColormapShader(lBody.c_str());
+        mLocAskGrid = GetShaderLocation(mGpuShader, "askGrid");
+        mLocBidLut = GetShaderLocation(mGpuShader, "bidLut");
+        mLocAskLut = GetShaderLocation(mGpuShader, "askLut");
+        mLocInvMax = GetShaderLocation(mGpuShader, "invMax");
+        mLocRing = GetShaderLocation(mGpuShader, "ring");
+        mLocBackground = GetShaderLocation(mGpuShader, "background");
+    }
+    mGpuReady = IsShaderValid(mGpuShader) && ensureGridTextures();
+    if (!mGpuReady) {
+        // The next prepare() switches to the CPU texture and restages it
+        cleanupGpuShader();
+        mGpuFailed = true;
+    }
+    return mGpuReady;
+}
+
 void RLOrderBookVis::cleanupMesh() {
     if (mMeshValid) {
         if (mBidMesh.vertexCount > 0) {
@@ -88,6 +299,7 @@ void RLOrderBookVis::ensureRenderTarget() const {
 }
 
 void RLOrderBookVis::setBounds(Rectangle aBounds) {
+    mRedrawPending = true;
     mBounds = aBounds;
 }
 
@@ -95,6 +307,7 @@ void RLOrderBookVis::setHistoryLength(size_t aLength) {
     if (aLength == mHistoryLength || aLength == 0) {
         return;
     }
+    mRedrawPending = true;
     mHistoryLength = aLength;
     ensureBuffers();
     mTextureDirty = true;
@@ -105,6 +318,7 @@ void RLOrderBookVis::setPriceLevels(size_t aLevels) {
     if (aLevels == mPriceLevels || aLevels == 0) {
         return;
     }
+    mRedrawPending = true;
     mPriceLevels = aLevels;
     ensureBuffers();
     mTextureDirty = true;
@@ -112,18 +326,22 @@ void RLOrderBookVis::setPriceLevels(size_t aLevels) {
 }
 
 void RLOrderBookVis::setStyle(const RLOrderBookVisStyle& rStyle) {
+    mRedrawPending = true;
     mStyle = rStyle;
 }
 
 void RLOrderBookVis::setPriceMode(RLOrderBookPriceMode aMode) {
+    mRedrawPending = true;
     mPriceMode = aMode;
 }
 
 void RLOrderBookVis::setSpreadTicks(int aTicks) {
+    mRedrawPending = true;
     mSpreadTicks = aTicks > 0 ? aTicks : 1;
 }
 
 void RLOrderBookVis::setPriceRange(float aMinPrice, float aMaxPrice) {
+    mRedrawPending = true;
     if (aMaxPrice > aMinPrice) {
         mExplicitMinPrice = aMinPrice;
         mExplicitMaxPrice = aMaxPrice;
@@ -131,6 +349,7 @@ void RLOrderBookVis::setPriceRange(float aMinPrice, float aMaxPrice) {
 }
 
 void RLOrderBookVis::setBidColorStops(const std::vector<Color>& rStops) {
+    mRedrawPending = true;
     if (rStops.size() >= 2) {
         mBidStops = rStops;
         mLutDirty = true;
@@ -138,86 +357,108 @@ void RLOrderBookVis::setBidColorStops(const std::vector<Color>& rStops) {
 }
 
 void RLOrderBookVis::setAskColorStops(const std::vector<Color>& rStops) {
+    mRedrawPending = true;
     if (rStops.size() >= 2) {
         mAskStops = rStops;
         mLutDirty = true;
     }
 }
 
+void RLOrderBookVis::setBidColormap(RLCharts::ColormapPreset aPreset) {
+    const RLCharts::ColormapStops lStops = RLCharts::colormapStops(aPreset);
+    setBidColorStops(std::vector<Color>(lStops.begin(), lStops.end()));
+}
+
+void RLOrderBookVis::setAskColormap(RLCharts::ColormapPreset aPreset) {
+    const RLCharts::ColormapStops lStops = RLCharts::colormapStops(aPreset);
+    setAskColorStops(std::vector<Color>(lStops.begin(), lStops.end()));
+}
+
+void RLOrderBookVis::setRingTexture(bool aEnabled) {
+    if (aEnabled == mRingTexture) {
+        return;
+    }
+    mRedrawPending = true;
+    mRingTexture = aEnabled;
+    if (mTextureValid && mTexture.id != 0) {
+        SetTextureWrap(mTexture, mRingTexture ? TEXTURE_WRAP_REPEAT : TEXTURE_WRAP_CLAMP);
+    }
+    // Texel layout changes between time order and ring order
+    mTextureDirty = true;
+}
+
+void RLOrderBookVis::setGpuColormap(bool aEnabled) {
+    if (aEnabled == mGpuColormap) {
+        return;
+    }
+    mRedrawPending = true;
+    mGpuColormap = aEnabled;
+    mGpuFailed = false;
+    if (!aEnabled) {
+        cleanupGpuShader();
+        if (!mGpuDisplacement) {
+            cleanupGpuResources();
+        }
+    }
+    mTextureDirty = true;
+}
+
+void RLOrderBookVis::setGpuDisplacement3D(bool aEnabled) {
+    if (aEnabled == mGpuDisplacement) {
+        return;
+    }
+    mRedrawPending = true;
+    mGpuDisplacement = aEnabled;
+    mDisplaceFailed = false;
+    if (!aEnabled) {
+        cleanupDisplacement();
+        if (!mGpuColormap) {
+            cleanupGpuResources();
+        }
+    }
+    mTextureDirty = true;
+    mMeshDirty = true;
+}
+
 void RLOrderBookVis::ensureBuffers() {
     const size_t lTotal = mHistoryLength * mPriceLevels;
 
     mBidGrid.assign(lTotal, 0.0f);
     mAskGrid.assign(lTotal, 0.0f);
 
-    // RGBA pixels: 2 * priceLevels height (bids on top, asks on bottom)
-    // Actually, we'll interleave: each row has bid and ask at same price
-    // Width = historyLength, Height = priceLevels
-    mPixels.assign(mHistoryLength * mPriceLevels * 4, 0);
-
     mHead = 0;
     mSnapshotCount = 0;
     mMaxBidSize = 1.0f;
     mMaxAskSize = 1.0f;
     mCurrentMaxBid = 1.0f;
     mCurrentMaxAsk = 1.0f;
+    mPendingColumns = 0;
 
     cleanupTexture();
+    cleanupGpuResources();
     cleanupMesh();
+    // Staged frames target the old size
+    mStaging.discard();
+    mDraw = DrawState{};
     mTextureDirty = true;
     mMeshDirty = true;
 }
 
 void RLOrderBookVis::rebuildLUT() {
-    // Build bid LUT
-    const int lBidN = (int)mBidStops.size();
-    if (lBidN >= 2) {
-        for (int i = 0; i < 256; ++i) {
-            const float lT = (float)i / 255.0f;
-            const float lSegF = lT * (float)(lBidN - 1);
-            int lSeg = (int)lSegF;
-            if (lSeg >= lBidN - 1) {
-                lSeg = lBidN - 2;
-            }
-            const float lLocalT = lSegF - (float)lSeg;
-
-            const Color& lA = mBidStops[(size_t)lSeg];
-            const Color& lB = mBidStops[(size_t)lSeg + 1];
-
-            mBidLut[i].r = (unsigned char)((float)lA.r + ((float)lB.r - (float)lA.r) * lLocalT);
-            mBidLut[i].g = (unsigned char)((float)lA.g + ((float)lB.g - (float)lA.g) * lLocalT);
-            mBidLut[i].b = (unsigned char)((float)lA.b + ((float)lB.b - (float)lA.b) * lLocalT);
-            mBidLut[i].a = (unsigned char)((float)lA.a + ((float)lB.a - (float)lA.a) * lLocalT);
-        }
+    if (mBidStops.size() >= 2) {
+        RLCharts::buildStopLut(mBidStops.data(), mBidStops.size(), mBidLut, RLCharts::COLORMAP_LUT_SIZE);
     }
-
-    // Build ask LUT
-    const int lAskN = (int)mAskStops.size();
-    if (lAskN >= 2) {
-        for (int i = 0; i < 256; ++i) {
-            const float lT = (float)i / 255.0f;
-            const float lSegF = lT * (float)(lAskN - 1);
-            int lSeg = (int)lSegF;
-            if (lSeg >= lAskN - 1) {
-                lSeg = lAskN - 2;
-            }
-            const float lLocalT = lSegF - (float)lSeg;
-
-            const Color& lA = mAskStops[(size_t)lSeg];
-            const Color& lB = mAskStops[(size_t)lSeg + 1];
-
-            mAskLut[i].r = (unsigned char)((float)lA.r + ((float)lB.r - (float)lA.r) * lLocalT);
-            mAskLut[i].g = (unsigned char)((float)lA.g + ((float)lB.g - (float)lA.g) * lLocalT);
-            mAskLut[i].b = (unsigned char)((float)lA.b + ((float)lB.b - (float)lA.b) * lLocalT);
-            mAskLut[i].a = (unsigned char)((float)lA.a + ((float)lB.a - (float)lA.a) * lLocalT);
-        }
+    if (mAskStops.size() >= 2) {
+        RLCharts::buildStopLut(mAskStops.data(), mAskStops.size(), mAskLut, RLCharts::COLORMAP_LUT_SIZE);
     }
 
     mLutDirty = false;
+    mLutUploadDirty = true;
     mTextureDirty = true;
 }
 
 void RLOrderBookVis::clear() {
+    mRedrawPending = true;
     std::fill(mBidGrid.begin(), mBidGrid.end(), 0.0f);
     std::fill(mAskGrid.begin(), mAskGrid.end(), 0.0f);
     mHead = 0;
@@ -226,6 +467,7 @@ void RLOrderBookVis::clear() {
     mMaxAskSize = 1.0f;
     mCurrentMaxBid = 1.0f;
     mCurrentMaxAsk = 1.0f;
+    mPendingColumns = 0;
     mTextureDirty = true;
     mMeshDirty = true;
 }
@@ -268,31 +510,313 @@ size_t RLOrderBookVis::ringTimeIndex(size_t aOffset) const {
 }
 
 void RLOrderBookVis::pushSnapshot(const RLOrderBookSnapshot& rSnapshot) {
+    mRedrawPending = true;
     // Update current market state
     if (!rSnapshot.mBids.empty() && !rSnapshot.mAsks.empty()) {
-        mCurrentBestBid = rSnapshot.mBids[0].first;
-        mCurrentBestAsk = rSnapshot.mAsks[0].first;
-        mCurrentMidPrice = (mCurrentBestBid + mCurrentBestAsk) * 0.5f;
-        mCurrentSpread = mCurrentBestAsk - mCurrentBestBid;
+        updateMarketState(rSnapshot.mBids[0].first, rSnapshot.mAsks[0].first);
+    }
+
+    float lLowest = 1e30f;
+    float lHighest = -1e30f;
+    if (mPriceMode == RLOrderBookPriceMode::FullDepth) {
+        for (const auto& lBid : rSnapshot.mBids) {
+            lLowest = std::min(lBid.first, lLowest);
+            lHighest = std::max(lBid.first, lHighest);
+        }
+        for (const auto& lAsk : rSnapshot.mAsks) {
+            lLowest = std::min(lAsk.first, lLowest);
+            lHighest = std::max(lAsk.first, lHighest);
+        }
+    }
+    updatePriceTarget(lLowest, lHighest);
+
+    // Clear the column we're about to write
+    const size_t lColStart = mHead * mPriceLevels;
+    for (size_t i = 0; i < mPriceLevels; ++i) {
+        mBidGrid[lColStart + i] = 0.0f;
+        mAskGrid[lColStart + i] = 0.0f;
+    }
+
+    const float lLocalMaxBid = accumulateLevels(rSnapshot.mBids, mBidGrid);
+    const float lLocalMaxAsk = accumulateLevels(rSnapshot.mAsks, mAskGrid);
+
+    // A snapshot column is not derived from the internal book
+    mBookColumnValid = false;
+    advanceColumn(lLocalMaxBid, lLocalMaxAsk);
+}
+
+void RLOrderBookVis::applyUpdate(RLOrderBookSide aSide, float aPrice, float aSize) {
+    const bool lBid = aSide == RLOrderBookSide::Bid;
+    std::vector<std::pair<float, float>>& rLevels = lBid ? mBookBids : mBookAsks;
+
+    // Bids are kept descending, asks ascending: best level first in both
+    auto lIt = lBid
+        ? std::lower_bound(rLevels.begin(), rLevels.end(), aPrice,
+                           [](const std::pair<float, float>& rL, float aP) { return rL.first > aP; })
+        : std::lower_bound(rLevels.begin(), rLevels.end(), aPrice,
+                           [](const std::pair<float, float>& rL, float aP) { return rL.first < aP; });
+    const bool lFound = lIt != rLevels.end() && lIt->first == aPrice;
+    const float lOldSize = lFound ? lIt->second : 0.0f;
+
+    if (aSize <= 0.0f) {
+        if (lFound) {
+            rLevels.erase(lIt);
+        }
+    } else if (lFound) {
+        lIt->second = aSize;
+    } else {
+        rLevels.insert(lIt, {aPrice, aSize});
+    }
+
+    if (lOldSize != (aSize > 0.0f ? aSize : 0.0f)) {
+        mBookDeltas.push_back({aSide, aPrice, (aSize > 0.0f ? aSize : 0.0f) - lOldSize});
+    }
+}
+
+RLOrderBookVis::Producer RLOrderBookVis::createProducer(size_t aCapacity) {
+    mProducers.push_back(std::make_unique<RLCharts::SpscRing<RLOrderBookUpdate>>(aCapacity > 0 ? aCapacity : 1));
+    return Producer{ mProducers.back().get() };
+}
+
+bool RLOrderBookVis::Producer::push(const RLOrderBookUpdate& rUpdate) {
+    return mpQueue != nullptr && mpQueue->push(rUpdate);
+}
+
+size_t RLOrderBookVis::Producer::push(const RLOrderBookUpdate* pUpdates, size_t aCount) {
+    if (mpQueue == nullptr || pUpdates == nullptr) {
+        return 0;
+    }
+    return mpQueue->push(pUpdates, aCount);
+}
+
+void RLOrderBookVis::drainProducers() {
+    for (auto& rpQueue : mProducers) {
+        rpQueue->consume([&](const RLOrderBookUpdate* pUpdates, size_t aCount) {
+            for (size_t i = 0; i < aCount; ++i) {
+                if (pUpdates[i].mCommit) {
+                    commitSnapshot();
+                } else {
+                    applyUpdate(pUpdates[i].mSide, pUpdates[i].mPrice, pUpdates[i].mSize);
+                }
+            }
+        });
+    }
+}
+
+void RLOrderBookVis::commitSnapshot() {
+    mRedrawPending = true;
+    if (!mBookBids.empty() && !mBookAsks.empty()) {
+        updateMarketState(mBookBids.front().first, mBookAsks.front().first);
+    }
+
+    // Sorted sides: the extremes are the last levels
+    float lLowest = 1e30f;
+    float lHighest = -1e30f;
+    if (!mBookBids.empty()) {
+        lLowest = mBookBids.back().first;
+        lHighest = mBookBids.front().first;
+    }
+    if (!mBookAsks.empty()) {
+        lLowest = std::min(mBookAsks.front().first, lLowest);
+        lHighest = std::max(mBookAsks.back().first, lHighest);
+    }
+    updatePriceTarget(lLowest, lHighest);
+
+    const size_t lColStart = mHead * mPriceLevels;
+    float lLocalMaxBid = 0.0f;
+    float lLocalMaxAsk = 0.0f;
+
+    const bool lIncremental = mBookColumnValid && mSnapshotCount > 0 &&
+                              mBookColumnMinPrice == mCurrentMinPrice && mBookColumnMaxPrice == mCurrentMaxPrice;
+    if (lIncremental) {
+        // Same price-to-row mapping as the previous column: copy it and apply the changed rows
+        const size_t lPrevStart = ((mHead + mHistoryLength - 1) % mHistoryLength) * mPriceLevels;
+        if (lPrevStart != lColStart) {
+            std::copy_n(mBidGrid.begin() + (std::ptrdiff_t)lPrevStart, mPriceLevels, mBidGrid.begin() + (std::ptrdiff_t)lColStart);
+            std::copy_n(mAskGrid.begin() + (std::ptrdiff_t)lPrevStart, mPriceLevels, mAskGrid.begin() + (std::ptrdiff_t)lColStart);
+        }
+        for (const BookDelta& rDelta : mBookDeltas) {
+            if (rDelta.mPrice < mCurrentMinPrice || rDelta.mPrice > mCurrentMaxPrice) {
+                continue;
+            }
+            std::vector<float>& rGrid = rDelta.mSide == RLOrderBookSide::Bid ? mBidGrid : mAskGrid;
+            float& rCell = rGrid[gridIndex(mHead, (size_t)priceToGridRow(rDelta.mPrice))];
+            rCell += rDelta.mSizeDelta;
+            // Snap float residue of removed levels back to empty
+            if (rCell <= 1e-6f * std::fabs(rDelta.mSizeDelta)) {
+                rCell = 0.0f;
+            }
+        }
+        for (size_t i = 0; i < mPriceLevels; ++i) {
+            lLocalMaxBid = std::max(mBidGrid[lColStart + i], lLocalMaxBid);
+            lLocalMaxAsk = std::max(mAskGrid[lColStart + i], lLocalMaxAsk);
+        }
+    } else {
+        for (size_t i = 0; i < mPriceLevels; ++i) {
+            mBidGrid[lColStart + i] = 0.0f;
+            mAskGrid[lColStart + i] = 0.0f;
+        }
+        lLocalMaxBid = accumulateLevels(mBookBids, mBidGrid);
+        lLocalMaxAsk = accumulateLevels(mBookAsks, mAskGrid);
+    }
+
+    mBookDeltas.clear();
+    mBookColumnValid = true;
+    mBookColumnMinPrice = mCurrentMinPrice;
+    mBookColumnMaxPrice = mCurrentMaxPrice;
+    advanceColumn(lLocalMaxBid, lLocalMaxAsk);
+}
+
+float RLOrderBookVis::getHistoryValue(RLOrderBookSide aSide, size_t aTimeOffset, size_t aPriceRow) const {
+    if (mSnapshotCount == 0 || aPriceRow >= mPriceLevels) {
+        return 0.0f;
+    }
+    const std::vector<float>& rGrid = aSide == RLOrderBookSide::Bid ? mBidGrid : mAskGrid;
+    return rGrid[gridIndex(ringTimeIndex(aTimeOffset), aPriceRow)];
+}
+
+void RLOrderBookVis::clearBook() {
+    mRedrawPending = true;
+    mBookBids.clear();
+    mBookAsks.clear();
+    mBookDeltas.clear();
+    mBookColumnValid = false;
+}
+
+namespace RLCharts {
+
+static constexpr uint32_t ORDERBOOK_STATE_TAG = stateTag("OBKV");
+
+// Book side as two float arrays (prices, then sizes)
+static void writeBookSide(StateWriter& rWriter, const std::vector<std::pair<float, float>>& rLevels) {
+    std::vector<float> lValues(rLevels.size() * 2);
+    for (size_t i = 0; i < rLevels.size(); ++i) {
+        lValues[i] = rLevels[i].first;
+        lValues[rLevels.size() + i] = rLevels[i].second;
+    }
+    rWriter.writeU32((uint32_t)rLevels.size());
+    rWriter.writeFloats(lValues);
+}
+
+static bool readBookSide(StateReader& rReader, std::vector<std::pair<float, float>>& rLevels) {
+    uint32_t lCount = 0;
+    std::vector<float> lValues;
+    if (!rReader.readU32(lCount) || !rReader.readFloats(lValues, (size_t)lCount * 2)) {
+        return false;
+    }
+    rLevels.resize(lCount);
+    for (size_t i = 0; i < lCount; ++i) {
+        rLevels[i] = { lValues[i], lValues[lCount + i] };
+    }
+    return true;
+}
+
+} // namespace RLCharts
+
+std::vector<uint8_t> RLOrderBookVis::saveState() const {
+    RLCharts::StateWriter lWriter;
+    lWriter.writeU32((uint32_t)mHistoryLength);
+    lWriter.writeU32((uint32_t)mPriceLevels);
+    const float lScalars[] = {
+        mCurrentMinPrice, mCurrentMaxPrice, mTargetMinPrice, mTargetMaxPrice,
+        mCurrentMidPrice, mCurrentSpread, mCurrentBestBid, mCurrentBestAsk,
+        mMaxBidSize, mMaxAskSize, mCurrentMaxBid, mCurrentMaxAsk
+    };
+    for (float lValue : lScalars) {
+        lWriter.writeF32(lValue);
+    }
+
+    // Visible columns only, oldest first
+    const size_t lVisible = std::min(mSnapshotCount, mHistoryLength);
+    std::vector<float> lColumns(lVisible * mPriceLevels);
+    for (const std::vector<float>* pGrid : { &mBidGrid, &mAskGrid }) {
+        for (size_t t = 0; t < lVisible; ++t) {
+            std::copy_n(pGrid->begin() + (std::ptrdiff_t)gridIndex(ringTimeIndex(t), 0), mPriceLevels,
+                        lColumns.begin() + (std::ptrdiff_t)(t * mPriceLevels));
+        }
+        lWriter.writeU32((uint32_t)lVisible);
+        lWriter.writeFloats(lColumns);
+    }
+
+    RLCharts::writeBookSide(lWriter, mBookBids);
+    RLCharts::writeBookSide(lWriter, mBookAsks);
+    return lWriter.finish(RLCharts::ORDERBOOK_STATE_TAG);
+}
+
+bool RLOrderBookVis::loadState(std::span<const uint8_t> aState) {
+    // Parse everything before touching the chart
+    RLCharts::StateReader lReader;
+    uint32_t lHistoryLength = 0;
+    uint32_t lPriceLevels = 0;
+    if (!lReader.open(aState, RLCharts::ORDERBOOK_STATE_TAG) || !lReader.readU32(lHistoryLength) ||
+        !lReader.readU32(lPriceLevels) || lHistoryLength == 0 || lPriceLevels == 0) {
+        return false;
     }
+    float lScalars[12] = {};
+    for (float& rValue : lScalars) {
+        if (!lReader.readF32(rValue)) {
+            return false;
+        }
+    }
+    std::vector<float> lColumns[2];
+    uint32_t lVisible[2] = {};
+    for (int lSide = 0; lSide < 2; ++lSide) {
+        if (!lReader.readU32(lVisible[lSide]) || lVisible[lSide] > lHistoryLength ||
+            !lReader.readFloats(lColumns[lSide], (size_t)lVisible[lSide] * lPriceLevels)) {
+            return false;
+        }
+    }
+    std::vector<std::pair<float, float>> lBids;
+    std::vector<std::pair<float, float>> lAsks;
+    if (lVisible[0] != lVisible[1] || !RLCharts::readBookSide(lReader, lBids) || !RLCharts::readBookSide(lReader, lAsks) ||
+        !lReader.atEnd()) {
+        return false;
+    }
+
+    setHistoryLength(lHistoryLength);
+    setPriceLevels(lPriceLevels);
+    clear();
+    clearBook();
+    std::copy(lColumns[0].begin(), lColumns[0].end(), mBidGrid.begin());
+    std::copy(lColumns[1].begin(), lColumns[1].end(), mAskGrid.begin());
+    mSnapshotCount = lVisible[0];
+    mHead = mSnapshotCount % mHistoryLength;
+
+    mCurrentMinPrice = lScalars[0];
+    mCurrentMaxPrice = lScalars[1];
+    mTargetMinPrice = lScalars[2];
+    mTargetMaxPrice = lScalars[3];
+    mCurrentMidPrice = lScalars[4];
+    mCurrentSpread = lScalars[5];
+    mCurrentBestBid = lScalars[6];
+    mCurrentBestAsk = lScalars[7];
+    mMaxBidSize = lScalars[8];
+    mMaxAskSize = lScalars[9];
+    mCurrentMaxBid = lScalars[10];
+    mCurrentMaxAsk = lScalars[11];
+    // The next commitSnapshot() rebuilds its column from the restored book
+    mBookBids = std::move(lBids);
+    mBookAsks = std::move(lAsks);
+    return true;
+}
 
-    // Determine price range based on mode
+void RLOrderBookVis::updateMarketState(float aBestBid, float aBestAsk) {
+    mCurrentBestBid = aBestBid;
+    mCurrentBestAsk = aBestAsk;
+    mCurrentMidPrice = (mCurrentBestBid + mCurrentBestAsk) * 0.5f;
+    mCurrentSpread = mCurrentBestAsk - mCurrentBestBid;
+}
+
+void RLOrderBookVis::updatePriceTarget(float aLowest, float aHighest) {
+    // Determine price range based on mode (aLowest/aHighest: extreme prices, FullDepth only)
     float lMinPrice = 0.0f;
     float lMaxPrice = 0.0f;
 
     switch (mPriceMode) {
         case RLOrderBookPriceMode::FullDepth: {
             // Use full range from all bids and asks
-            lMinPrice = 1e30f;
-            lMaxPrice = -1e30f;
-            for (const auto& lBid : rSnapshot.mBids) {
-                lMinPrice = std::min(lBid.first, lMinPrice);
-                lMaxPrice = std::max(lBid.first, lMaxPrice);
-            }
-            for (const auto& lAsk : rSnapshot.mAsks) {
-                lMinPrice = std::min(lAsk.first, lMinPrice);
-                lMaxPrice = std::max(lAsk.first, lMaxPrice);
-            }
+            lMinPrice = aLowest;
+            lMaxPrice = aHighest;
             if (lMinPrice > lMaxPrice) {
                 lMinPrice = mCurrentMidPrice - 1.0f;
                 lMaxPrice = mCurrentMidPrice + 1.0f;
@@ -317,51 +841,31 @@ void RLOrderBookVis::pushSnapshot(const RLOrderBookSnapshot& rSnapshot) {
     // Smooth transition to new price range
     mTargetMinPrice = lMinPrice;
     mTargetMaxPrice = lMaxPrice;
+}
 
-    // Clear the column we're about to write
-    const size_t lColStart = mHead * mPriceLevels;
-    for (size_t i = 0; i < mPriceLevels; ++i) {
-        mBidGrid[lColStart + i] = 0.0f;
-        mAskGrid[lColStart + i] = 0.0f;
-    }
-
-    // Track max sizes for scaling
-    float lLocalMaxBid = 0.0f;
-    float lLocalMaxAsk = 0.0f;
-
-    // Write bids to grid
-    for (const auto& lBid : rSnapshot.mBids) {
-        const float lPrice = lBid.first;
-        const float lSize = lBid.second;
-        if (lPrice < mCurrentMinPrice || lPrice > mCurrentMaxPrice) {
-            continue;
-        }
-
-        const int lRow = priceToGridRow(lPrice);
-        const size_t lIdx = gridIndex(mHead, (size_t)lRow);
-        mBidGrid[lIdx] += lSize;
-
-        lLocalMaxBid = std::max(mBidGrid[lIdx], lLocalMaxBid);
-    }
-
-    // Write asks to grid
-    for (const auto& lAsk : rSnapshot.mAsks) {
-        const float lPrice = lAsk.first;
-        const float lSize = lAsk.second;
+float RLOrderBookVis::accumulateLevels(const std::vector<std::pair<float, float>>& rLevels, std::vector<float>& rGrid) {
+    // Sum level sizes into the head column, return the column max (for scaling)
+    float lLocalMax = 0.0f;
+    for (const auto& lLevel : rLevels) {
+        const float lPrice = lLevel.first;
+        const float lSize = lLevel.second;
         if (lPrice < mCurrentMinPrice || lPrice > mCurrentMaxPrice) {
             continue;
         }
 
         const int lRow = priceToGridRow(lPrice);
         const size_t lIdx = gridIndex(mHead, (size_t)lRow);
-        mAskGrid[lIdx] += lSize;
+        rGrid[lIdx] += lSize;
 
-        lLocalMaxAsk = std::max(mAskGrid[lIdx], lLocalMaxAsk);
+        lLocalMax = std::max(rGrid[lIdx], lLocalMax);
     }
+    return lLocalMax;
+}
 
+void RLOrderBookVis::advanceColumn(float aLocalMaxBid, float aLocalMaxAsk) {
     // Update max sizes
-    mMaxBidSize = std::max(lLocalMaxBid, mMaxBidSize);
-    mMaxAskSize = std::max(lLocalMaxAsk, mMaxAskSize);
+    mMaxBidSize = std::max(aLocalMaxBid, mMaxBidSize);
+    mMaxAskSize = std::max(aLocalMaxAsk, mMaxAskSize);
 
     // Advance ring buffer
     mHead = (mHead + 1) % mHistoryLength;
@@ -369,19 +873,80 @@ void RLOrderBookVis::pushSnapshot(const RLOrderBookSnapshot& rSnapshot) {
         ++mSnapshotCount;
     }
 
-    mTextureDirty = true;
+    if (mPendingColumns < mHistoryLength) {
+        ++mPendingColumns;
+    }
     mMeshDirty = true;
 }
 
+bool RLOrderBookVis::isPrepared() const {
+    if (mLutDirty || mTextureDirty || mPendingColumns > 0 || mMeshDirty) {
+        return false;
+    }
+    if ((mPreparedGpu2D || mPreparedGpu3D) && mLutUploadDirty) {
+        return false;
+    }
+    if (mMaxBidSize > 1.0f || mMaxAskSize > 1.0f) {
+        return false; // Still decaying
+    }
+    return RLCharts::nearlyEqual(mCurrentMinPrice, mTargetMinPrice) &&
+           RLCharts::nearlyEqual(mCurrentMaxPrice, mTargetMaxPrice) &&
+           RLCharts::nearlyEqual(mCurrentMaxBid, mMaxBidSize) &&
+           RLCharts::nearlyEqual(mCurrentMaxAsk, mMaxAskSize);
+}
+
+bool RLOrderBookVis::isSettled() const {
+    for (const auto& rpQueue : mProducers) {
+        if (!rpQueue->empty()) {
+            return false;
+        }
+    }
+    if (mStaging.hasPending() || mRestageAll.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    if (gpu2DWanted() != mPreparedGpu2D || gpu3DWanted() != mPreparedGpu3D) {
+        return false;
+    }
+    return isPrepared();
+}
+
 void RLOrderBookVis::update(float aDt) {
+    prepare(aDt);
+    commit();
+}
+
+void RLOrderBookVis::prepare(float aDt) {
+    RLCHARTS_PERF_UPDATE(mPerf, "RLOrderBookVis::prepare");
+    drainProducers();
+    if (mRestageAll.exchange(false)) {
+        mTextureDirty = true;
+        mMeshDirty = true;
+        mLutUploadDirty = true;
+    }
+    const bool lGpu2D = gpu2DWanted();
+    const bool lGpu3D = gpu3DWanted();
+    if (lGpu2D != mPreparedGpu2D || lGpu3D != mPreparedGpu3D) {
+        // Switching paths (enabled, disabled or GPU setup failed): start from a full upload
+        mPreparedGpu2D = lGpu2D;
+        mPreparedGpu3D = lGpu3D;
+        mTextureDirty = true;
+        mMeshDirty = true;
+        mLutUploadDirty = true;
+    }
+    if (isPrepared()) {
+        mLastUploadCells = 0;
+        return;
+    }
+    StagedFrame& rFrame = mStaging.beginPrepare();
+
     // Smooth price range transitions
     const float lT = RLCharts::clamp01(mStyle.mScaleSpeed * aDt);
-    mCurrentMinPrice = RLCharts::lerpF(mCurrentMinPrice, mTargetMinPrice, lT);
-    mCurrentMaxPrice = RLCharts::lerpF(mCurrentMaxPrice, mTargetMaxPrice, lT);
+    mCurrentMinPrice = RLCharts::approach(mCurrentMinPrice, mTargetMinPrice, lT);
+    mCurrentMaxPrice = RLCharts::approach(mCurrentMaxPrice, mTargetMaxPrice, lT);
 
     // Smooth intensity scale transitions
-    mCurrentMaxBid = RLCharts::lerpF(mCurrentMaxBid, mMaxBidSize, lT);
-    mCurrentMaxAsk = RLCharts::lerpF(mCurrentMaxAsk, mMaxAskSize, lT);
+    mCurrentMaxBid = RLCharts::approach(mCurrentMaxBid, mMaxBidSize, lT);
+    mCurrentMaxAsk = RLCharts::approach(mCurrentMaxAsk, mMaxAskSize, lT);
 
     // Decay max sizes slowly to adapt to changing conditions
     mMaxBidSize *= (1.0f - 0.1f * aDt);
@@ -394,166 +959,289 @@ void RLOrderBookVis::update(float aDt) {
         rebuildLUT();
     }
 
-    // Update texture if dirty
-    if (mTextureDirty) {
-        rebuildTexture();
-        updateTexturePixels();
+    // Stage texture updates if dirty
+    mLastUploadCells = 0;
+    RLCharts::UploadList& rUploads = rFrame.mUploads;
+    if (lGpu2D || lGpu3D) {
+        if (mLutUploadDirty) {
+            rUploads.texture(&mBidLutTexture, mBidLut, sizeof(mBidLut));
+            rUploads.texture(&mAskLutTexture, mAskLut, sizeof(mAskLut));
+            mLutUploadDirty = false;
+        }
+        // Normalization happens in the shaders, so only new snapshot rows change
+        if (mTextureDirty) {
+            rUploads.texture(&mBidGridTexture, mBidGrid.data(), mBidGrid.size() * sizeof(float));
+            rUploads.texture(&mAskGridTexture, mAskGrid.data(), mAskGrid.size() * sizeof(float));
+            mLastUploadCells = mBidGrid.size();
+        } else if (mPendingColumns > 0) {
+            stageGridRows(rUploads, mPendingColumns);
+        }
+    }
+
+    if (lGpu2D) {
         mTextureDirty = false;
+        mPendingColumns = 0;
+    } else if (mRingTexture) {
+        const bool lDrifted =
+            std::fabs(mCurrentMaxBid - mRingColoredMaxBid) > RING_RECOLOR_DRIFT * mRingColoredMaxBid ||
+            std::fabs(mCurrentMaxAsk - mRingColoredMaxAsk) > RING_RECOLOR_DRIFT * mRingColoredMaxAsk;
+        if (mTextureDirty || (lDrifted && mPendingColumns > 0) || mPendingColumns >= mHistoryLength) {
+            updateTexturePixels(rUploads);
+            mTextureDirty = false;
+        } else if (mPendingColumns > 0) {
+            updateRingColumns(rUploads, mPendingColumns);
+        }
+        mPendingColumns = 0;
+    } else if (mTextureDirty || mPendingColumns > 0) {
+        updateTexturePixels(rUploads);
+        mTextureDirty = false;
+        mPendingColumns = 0;
     }
 
     // Update mesh if dirty (only when 3D is likely to be used)
     if (mMeshDirty) {
-        rebuildMesh();
-        updateMeshData();
+        // The displacement mesh is static, the grid rows are already staged
+        if (!lGpu3D) {
+            updateMeshData(rUploads);
+            rFrame.mMeshes = true;
+        }
         mMeshDirty = false;
     }
+
+    DrawState& rDraw = rFrame.mDraw;
+    rDraw.mVisible = mSnapshotCount < mHistoryLength ? mSnapshotCount : mHistoryLength;
+    rDraw.mOldest = (mHead + mHistoryLength - rDraw.mVisible) % mHistoryLength;
+    rDraw.mInvMaxBid = (mCurrentMaxBid > 0.001f) ? (1.0f / mCurrentMaxBid) : 1.0f;
+    rDraw.mInvMaxAsk = (mCurrentMaxAsk > 0.001f) ? (1.0f / mCurrentMaxAsk) : 1.0f;
+    rDraw.mMinPrice = mCurrentMinPrice;
+    rDraw.mMaxPrice = mCurrentMaxPrice;
+    rDraw.mMidPrice = mCurrentMidPrice;
+    rDraw.mBestBid = mCurrentBestBid;
+    rDraw.mBestAsk = mCurrentBestAsk;
+    rDraw.mGpu2D = lGpu2D;
+    rDraw.mGpu3D = lGpu3D;
+    mStaging.endPrepare();
 }
 
-void RLOrderBookVis::rebuildTexture() {
+void RLOrderBookVis::commit() {
+    StagedFrame* pFrame = mStaging.beginCommit();
+    if (pFrame == nullptr) {
+        return;
+    }
+    DrawState& rDraw = pFrame->mDraw;
+    const RLCharts::UploadList& rUploads = pFrame->mUploads;
+
+    // New resources start empty: unless this frame fills them, restage everything
+    bool lRestage = false;
+    if (rDraw.mGpu2D || rDraw.mGpu3D) {
+        const bool lHadGrids = mBidGridTexture.id != 0 && mBidLutTexture.id != 0;
+        if (rDraw.mGpu2D) {
+            rDraw.mGpu2D = ensureGpuResources();
+        }
+        if (rDraw.mGpu3D) {
+            rDraw.mGpu3D = ensureDisplacementResources();
+        }
+        if (!lHadGrids && (rDraw.mGpu2D || rDraw.mGpu3D) &&
+            !(rUploads.coversTexture(&mBidGridTexture) && rUploads.coversTexture(&mBidLutTexture))) {
+            lRestage = true;
+        }
+    }
+    if (!rDraw.mGpu2D) {
+        const bool lHadTexture = mTextureValid;
+        if (rebuildTexture() && !lHadTexture && !rUploads.coversTexture(&mTexture)) {
+            lRestage = true;
+        }
+    }
+    // Staged mesh buffers always cover the whole mesh
+    if (pFrame->mMeshes) {
+        ensureMeshes();
+    }
+    if (lRestage) {
+        mRestageAll = true;
+    }
+    [[maybe_unused]] const size_t lSent = rUploads.replay();
+    RLCHARTS_PERF_UPLOAD(mPerf, lSent);
+
+    mDraw = rDraw;
+    mRedrawPending = true;
+    mStaging.endCommit();
+}
+
+bool RLOrderBookVis::rebuildTexture() {
     if (mTextureValid && mTexture.id != 0) {
-        return; // Already valid
+        return true; // Already valid
     }
 
-    // Create texture from a pixel buffer
+    // Created empty; the staged texels are uploaded right after
     Image lImg = {};
-    lImg.data = mPixels.data();
+    lImg.data = nullptr;
     lImg.width = (int)mHistoryLength;
     lImg.height = (int)mPriceLevels;
     lImg.mipmaps = 1;
     lImg.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
 
     mTexture = LoadTextureFromImage(lImg);
-    SetTextureWrap(mTexture, TEXTURE_WRAP_CLAMP);
+    // The ring texture scrolls by wrapping the source rectangle
+    SetTextureWrap(mTexture, mRingTexture ? TEXTURE_WRAP_REPEAT : TEXTURE_WRAP_CLAMP);
     SetTextureFilter(mTexture, TEXTURE_FILTER_BILINEAR);
 
     mTextureValid = (mTexture.id != 0);
+    return mTextureValid;
+}
+
+Color RLOrderBookVis::cellColor(size_t aGridIdx, float aInvMaxBid, float aInvMaxAsk) const {
+    const float lIntensityMult = mStyle.mIntensityScale * 255.0f;
+    const float lBidVal = mBidGrid[aGridIdx];
+    const float lAskVal = mAskGrid[aGridIdx];
+
+    Color lColor;
+
+    if (lBidVal > 0.0f && lAskVal > 0.0f) {
+        // Both bid and ask at this level - blend colors
+        const float lBidIntensity = lBidVal * aInvMaxBid * lIntensityMult;
+        const float lAskIntensity = lAskVal * aInvMaxAsk * lIntensityMult;
+
+        const int lBidIdx = RLCharts::clampIdx((int)lBidIntensity, 256);
+        const int lAskIdx = RLCharts::clampIdx((int)lAskIntensity, 256);
+
+        const Color lBidColor = mBidLut[lBidIdx];
+        const Color lAskColor = mAskLut[lAskIdx];
+
+        // Blend based on relative intensity
+        const float lTotal = lBidIntensity + lAskIntensity;
+        const float lBidWeight = lBidIntensity / (lTotal + 0.001f);
+
+        lColor.r = (unsigned char)((float)lBidColor.r * lBidWeight + (float)lAskColor.r * (1.0f - lBidWeight));
+        lColor.g = (unsigned char)((float)lBidColor.g * lBidWeight + (float)lAskColor.g * (1.0f - lBidWeight));
+        lColor.b = (unsigned char)((float)lBidColor.b * lBidWeight + (float)lAskColor.b * (1.0f - lBidWeight));
+        lColor.a = (unsigned char)RLCharts::clamp((lBidColor.a + lAskColor.a) / 2, 0, 255);
+    }
+    else if (lBidVal > 0.0f) {
+        const float lIntensity = lBidVal * aInvMaxBid * lIntensityMult;
+        const int lIdx = RLCharts::clampIdx((int)lIntensity, 256);
+        lColor = mBidLut[lIdx];
+    }
+    else if (lAskVal > 0.0f) {
+        const float lIntensity = lAskVal * aInvMaxAsk * lIntensityMult;
+        const int lIdx = RLCharts::clampIdx((int)lIntensity, 256);
+        lColor = mAskLut[lIdx];
+    }
+    else {
+        // Empty cell - use background-ish color
+        lColor = mStyle.mBackground;
+        lColor.a = 255;
+    }
+    return lColor;
 }
 
-void RLOrderBookVis::updateTexturePixels() {
+void RLOrderBookVis::updateTexturePixels(RLCharts::UploadList& rUploads) {
+    RLCHARTS_PERF_REBUILD(mPerf, "RLOrderBookVis::updateTexturePixels");
     if (mSnapshotCount == 0) {
         return;
     }
 
-
     // Inverse max for scaling
     const float lInvMaxBid = (mCurrentMaxBid > 0.001f) ? (1.0f / mCurrentMaxBid) : 1.0f;
     const float lInvMaxAsk = (mCurrentMaxAsk > 0.001f) ? (1.0f / mCurrentMaxAsk) : 1.0f;
-    const float lIntensityMult = mStyle.mIntensityScale * 255.0f;
 
-    // Convert grid to pixels
+    // Convert grid to pixels, straight into the staged upload
     // Pixel layout: row 0 = highest price, row (priceLevels-1) = lowest price
     // Column 0 = oldest snapshot, column (visibleCount-1) = newest
+    // (ring texture mode: column = ring index, the draw call applies the offset)
 
-    auto* pPixels = (uint32_t*)mPixels.data();
+    auto* pPixels = static_cast<uint32_t*>(rUploads.texture(&mTexture, mHistoryLength * mPriceLevels * sizeof(uint32_t)));
 
     for (size_t lTimeOffset = 0; lTimeOffset < mHistoryLength; ++lTimeOffset) {
-        const size_t lRingIdx = ringTimeIndex(lTimeOffset);
+        const size_t lRingIdx = mRingTexture ? lTimeOffset : ringTimeIndex(lTimeOffset);
 
         for (size_t lPriceIdx = 0; lPriceIdx < mPriceLevels; ++lPriceIdx) {
-            const size_t lGridIdx = gridIndex(lRingIdx, lPriceIdx);
             const size_t lPixelIdx = lPriceIdx * mHistoryLength + lTimeOffset;
+            const Color lColor = cellColor(gridIndex(lRingIdx, lPriceIdx), lInvMaxBid, lInvMaxAsk);
+            pPixels[lPixelIdx] = *(const uint32_t*)&lColor;
+        }
+    }
 
-            const float lBidVal = mBidGrid[lGridIdx];
-            const float lAskVal = mAskGrid[lGridIdx];
-
-            Color lColor;
-
-            if (lBidVal > 0.0f && lAskVal > 0.0f) {
-                // Both bid and ask at this level - blend colors
-                const float lBidIntensity = lBidVal * lInvMaxBid * lIntensityMult;
-                const float lAskIntensity = lAskVal * lInvMaxAsk * lIntensityMult;
-
-                const int lBidIdx = RLCharts::clampIdx((int)lBidIntensity, 256);
-                const int lAskIdx = RLCharts::clampIdx((int)lAskIntensity, 256);
+    mRingColoredMaxBid = mCurrentMaxBid;
+    mRingColoredMaxAsk = mCurrentMaxAsk;
+    mLastUploadCells = mHistoryLength * mPriceLevels;
+}
 
-                const Color lBidColor = mBidLut[lBidIdx];
-                const Color lAskColor = mAskLut[lAskIdx];
+void RLOrderBookVis::updateRingColumns(RLCharts::UploadList& rUploads, size_t aCount) {
+    const float lInvMaxBid = (mCurrentMaxBid > 0.001f) ? (1.0f / mCurrentMaxBid) : 1.0f;
+    const float lInvMaxAsk = (mCurrentMaxAsk > 0.001f) ? (1.0f / mCurrentMaxAsk) : 1.0f;
 
-                // Blend based on relative intensity
-                const float lTotal = lBidIntensity + lAskIntensity;
-                const float lBidWeight = lBidIntensity / (lTotal + 0.001f);
+    size_t lFirst = (mHead + mHistoryLength - aCount) % mHistoryLength;
 
-                lColor.r = (unsigned char)((float)lBidColor.r * lBidWeight + (float)lAskColor.r * (1.0f - lBidWeight));
-                lColor.g = (unsigned char)((float)lBidColor.g * lBidWeight + (float)lAskColor.g * (1.0f - lBidWeight));
-                lColor.b = (unsigned char)((float)lBidColor.b * lBidWeight + (float)lAskColor.b * (1.0f - lBidWeight));
-                lColor.a = (unsigned char)RLCharts::clamp((lBidColor.a + lAskColor.a) / 2, 0, 255);
-            }
-            else if (lBidVal > 0.0f) {
-                const float lIntensity = lBidVal * lInvMaxBid * lIntensityMult;
-                const int lIdx = RLCharts::clampIdx((int)lIntensity, 256);
-                lColor = mBidLut[lIdx];
-            }
-            else if (lAskVal > 0.0f) {
-                const float lIntensity = lAskVal * lInvMaxAsk * lIntensityMult;
-                const int lIdx = RLCharts::clampIdx((int)lIntensity, 256);
-                lColor = mAskLut[lIdx];
-            }
-            else {
-                // Empty cell - use background-ish color
-                lColor = mStyle.mBackground;
-                lColor.a = 255;
+    // The new columns are contiguous in the ring except across the wrap: at most two rects
+    while (aCount > 0) {
+        const size_t lRun = RLCharts::minVal(aCount, mHistoryLength - lFirst);
+        const Rectangle lRec = {(float)lFirst, 0.0f, (float)lRun, (float)mPriceLevels};
+        auto* pColumns = static_cast<uint32_t*>(rUploads.textureRect(&mTexture, lRec, lRun * mPriceLevels * sizeof(uint32_t)));
+        for (size_t lPriceIdx = 0; lPriceIdx < mPriceLevels; ++lPriceIdx) {
+            for (size_t c = 0; c < lRun; ++c) {
+                const Color lColor = cellColor(gridIndex(lFirst + c, lPriceIdx), lInvMaxBid, lInvMaxAsk);
+                pColumns[lPriceIdx * lRun + c] = *(const uint32_t*)&lColor;
             }
-
-            pPixels[lPixelIdx] = *(uint32_t*)&lColor;
         }
+        mLastUploadCells += lRun * mPriceLevels;
+        lFirst = (lFirst + lRun) % mHistoryLength;
+        aCount -= lRun;
     }
+}
 
-    if (mTextureValid && mTexture.id != 0) {
-        UpdateTexture(mTexture, mPixels.data());
+void RLOrderBookVis::stageGridRows(RLCharts::UploadList& rUploads, size_t aCount) {
+    // Grid textures are priceLevels wide, one row per ring slot: rows are contiguous
+    size_t lFirst = (mHead + mHistoryLength - aCount) % mHistoryLength;
+    while (aCount > 0) {
+        const size_t lRun = RLCharts::minVal(aCount, mHistoryLength - lFirst);
+        const Rectangle lRec = {0.0f, (float)lFirst, (float)mPriceLevels, (float)lRun};
+        const size_t lBytes = lRun * mPriceLevels * sizeof(float);
+        rUploads.textureRect(&mBidGridTexture, lRec, mBidGrid.data() + gridIndex(lFirst, 0), lBytes);
+        rUploads.textureRect(&mAskGridTexture, lRec, mAskGrid.data() + gridIndex(lFirst, 0), lBytes);
+        mLastUploadCells += lRun * mPriceLevels;
+        lFirst = (lFirst + lRun) % mHistoryLength;
+        aCount -= lRun;
     }
 }
 
-void RLOrderBookVis::rebuildMesh() {
-    cleanupMesh();
+bool RLOrderBookVis::ensureMeshes() {
+    if (mMeshValid) {
+        return true;
+    }
 
     // Create heightmap meshes for bids and asks
     // Each mesh is a grid of quads: (historyLength-1) x (priceLevels-1) quads
-    // 6 vertices per quad (2 triangles)
+    // 6 vertices per quad (2 triangles); positions and colors come from the staged frame
 
     const int lQuadsX = (int)mHistoryLength - 1;
     const int lQuadsY = (int)mPriceLevels - 1;
     if (lQuadsX < 1 || lQuadsY < 1) {
-        return;
+        return false;
     }
 
     const int lVertexCount = lQuadsX * lQuadsY * 6;
 
-    // Allocate mesh data for bid mesh
-    mBidMesh.vertexCount = lVertexCount;
-    mBidMesh.triangleCount = lQuadsX * lQuadsY * 2;
-    mBidMesh.vertices = (float*)MemAlloc(static_cast<unsigned long>(lVertexCount) * 3 * sizeof(float));
-    mBidMesh.colors = (unsigned char*)MemAlloc(static_cast<unsigned long>(lVertexCount) * 4 * sizeof(unsigned char));
-    mBidMesh.normals = (float*)MemAlloc(static_cast<unsigned long>(lVertexCount) * 3 * sizeof(float));
-
-    // Allocate mesh data for ask mesh
-    mAskMesh.vertexCount = lVertexCount;
-    mAskMesh.triangleCount = lQuadsX * lQuadsY * 2;
-    mAskMesh.vertices = (float*)MemAlloc(static_cast<unsigned long>(lVertexCount) * 3 * sizeof(float));
-    mAskMesh.colors = (unsigned char*)MemAlloc(static_cast<unsigned long>(lVertexCount) * 4 * sizeof(unsigned char));
-    mAskMesh.normals = (float*)MemAlloc(static_cast<unsigned long>(lVertexCount) * 3 * sizeof(float));
+    for (Mesh* pMesh : { &mBidMesh, &mAskMesh }) {
+        pMesh->vertexCount = lVertexCount;
+        pMesh->triangleCount = lQuadsX * lQuadsY * 2;
+        pMesh->vertices = (float*)MemAlloc(static_cast<unsigned long>(lVertexCount) * 3 * sizeof(float));
+        pMesh->colors = (unsigned char*)MemAlloc(static_cast<unsigned long>(lVertexCount) * 4 * sizeof(unsigned char));
+        pMesh->normals = (float*)MemAlloc(static_cast<unsigned long>(lVertexCount) * 3 * sizeof(float));
 
-    // Initialize normals to up vector
-    for (int i = 0; i < lVertexCount; ++i) {
-        mBidMesh.normals[i * 3 + 0] = 0.0f;
-        mBidMesh.normals[i * 3 + 1] = 1.0f;
-        mBidMesh.normals[i * 3 + 2] = 0.0f;
+        // Initialize normals to up vector
+        for (int i = 0; i < lVertexCount; ++i) {
+            pMesh->normals[i * 3 + 1] = 1.0f;
+        }
 
-        mAskMesh.normals[i * 3 + 0] = 0.0f;
-        mAskMesh.normals[i * 3 + 1] = 1.0f;
-        mAskMesh.normals[i * 3 + 2] = 0.0f;
+        UploadMesh(pMesh, true); // dynamic = true for updates
     }
 
-    UploadMesh(&mBidMesh, true); // dynamic = true for updates
-    UploadMesh(&mAskMesh, true);
-
     mMeshValid = true;
+    return true;
 }
 
-void RLOrderBookVis::updateMeshData() {
-    if (!mMeshValid) {
-        return;
-    }
-
+void RLOrderBookVis::updateMeshData(RLCharts::UploadList& rUploads) {
+    RLCHARTS_PERF_REBUILD(mPerf, "RLOrderBookVis::updateMeshData");
     const int lQuadsX = (int)mHistoryLength - 1;
     const int lQuadsY = (int)mPriceLevels - 1;
     if (lQuadsX < 1 || lQuadsY < 1) {
@@ -579,6 +1267,13 @@ void RLOrderBookVis::updateMeshData() {
         return mAskGrid[lIdx] * lInvMaxAsk * lHeightScale;
     };
 
+    // Vertices go straight into the staged buffers (0 = positions, 3 = colors)
+    const size_t lVertexCount = static_cast<size_t>(lQuadsX) * static_cast<size_t>(lQuadsY) * 6;
+    auto* pBidPositions = static_cast<float*>(rUploads.meshBuffer(&mBidMesh, 0, lVertexCount * 3 * sizeof(float)));
+    auto* pBidColorData = static_cast<unsigned char*>(rUploads.meshBuffer(&mBidMesh, 3, lVertexCount * 4));
+    auto* pAskPositions = static_cast<float*>(rUploads.meshBuffer(&mAskMesh, 0, lVertexCount * 3 * sizeof(float)));
+    auto* pAskColorData = static_cast<unsigned char*>(rUploads.meshBuffer(&mAskMesh, 3, lVertexCount * 4));
+
     int lVertIdx = 0;
 
     for (int lQy = 0; lQy < lQuadsY; ++lQy) {
@@ -621,8 +1316,8 @@ void RLOrderBookVis::updateMeshData() {
             // Triangle 2: (1,0), (1,1), (0,1)
 
             // Bid mesh vertices
-            float* pBidVerts = mBidMesh.vertices + static_cast<ptrdiff_t>(lVertIdx) * 3;
-            unsigned char* pBidColors = mBidMesh.colors + static_cast<ptrdiff_t>(lVertIdx) * 4;
+            float* pBidVerts = pBidPositions + static_cast<ptrdiff_t>(lVertIdx) * 3;
+            unsigned char* pBidColors = pBidColorData + static_cast<ptrdiff_t>(lVertIdx) * 4;
 
             // Tri 1
             pBidVerts[0] = lX0; pBidVerts[1] = lBh00; pBidVerts[2] = lZ0;
@@ -646,8 +1341,8 @@ void RLOrderBookVis::updateMeshData() {
             pBidColors[20] = lBc01.r; pBidColors[21] = lBc01.g; pBidColors[22] = lBc01.b; pBidColors[23] = lBc01.a;
 
             // Ask mesh vertices (offset in Z to separate from bids)
-            float* pAskVerts = mAskMesh.vertices + static_cast<ptrdiff_t>(lVertIdx) * 3;
-            unsigned char* pAskColors = mAskMesh.colors + static_cast<ptrdiff_t>(lVertIdx) * 4;
+            float* pAskVerts = pAskPositions + static_cast<ptrdiff_t>(lVertIdx) * 3;
+            unsigned char* pAskColors = pAskColorData + static_cast<ptrdiff_t>(lVertIdx) * 4;
 
             pAskVerts[0] = lX0; pAskVerts[1] = lAh00; pAskVerts[2] = lZ0;
             pAskVerts[3] = lX1; pAskVerts[4] = lAh10; pAskVerts[5] = lZ0;
@@ -671,13 +1366,6 @@ void RLOrderBookVis::updateMeshData() {
             lVertIdx += 6;
         }
     }
-
-    // Update GPU buffers
-    UpdateMeshBuffer(mBidMesh, 0, mBidMesh.vertices, (int)(static_cast<unsigned long>(mBidMesh.vertexCount) * 3 * sizeof(float)), 0);
-    UpdateMeshBuffer(mBidMesh, 3, mBidMesh.colors, (int)(static_cast<unsigned long>(mBidMesh.vertexCount) * 4 * sizeof(unsigned char)), 0);
-
-    UpdateMeshBuffer(mAskMesh, 0, mAskMesh.vertices, (int)(static_cast<unsigned long>(mAskMesh.vertexCount) * 3 * sizeof(float)), 0);
-    UpdateMeshBuffer(mAskMesh, 3, mAskMesh.colors, (int)(static_cast<unsigned long>(mAskMesh.vertexCount) * 4 * sizeof(unsigned char)), 0);
 }
 
 Rectangle RLOrderBookVis::getPlotArea() const {
@@ -733,13 +1421,17 @@ void RLOrderBookVis::drawMidLine2D() const {
 
     const Rectangle lPlot = getPlotArea();
 
+    // Prices as of the last commit(), in that frame's price range
+    const float lRange = std::max(mDraw.mMaxPrice - mDraw.mMinPrice, 0.0001f);
+    auto toNormalized = [&](float aPrice) { return (aPrice - mDraw.mMinPrice) / lRange; };
+
     // Normalize mid price to plot Y
-    const float lMidNorm = priceToNormalized(mCurrentMidPrice);
+    const float lMidNorm = toNormalized(mDraw.mMidPrice);
     const float lMidY = lPlot.y + (1.0f - lMidNorm) * lPlot.height;
 
     if (mStyle.mShowSpreadArea) {
-        const float lBidNorm = priceToNormalized(mCurrentBestBid);
-        const float lAskNorm = priceToNormalized(mCurrentBestAsk);
+        const float lBidNorm = toNormalized(mDraw.mBestBid);
+        const float lAskNorm = toNormalized(mDraw.mBestAsk);
 
         const float lBidY = lPlot.y + (1.0f - lBidNorm) * lPlot.height;
         const float lAskY = lPlot.y + (1.0f - lAskNorm) * lPlot.height;
@@ -765,14 +1457,60 @@ void RLOrderBookVis::drawMidLine2D() const {
 }
 
 void RLOrderBookVis::drawHeatmap2D() const {
-    if (!mTextureValid || mTexture.id == 0) {
+    if (mDraw.mVisible == 0) {
         return;
     }
-    if (mSnapshotCount == 0) {
+
+    const Rectangle lPlot = getPlotArea();
+    const size_t lVisible = mDraw.mVisible;
+    const size_t lOldest = mDraw.mOldest;
+
+    if (mDraw.mGpu2D && isGpuColormapActive()) {
+        const float lInvMax[2] = {
+            mDraw.mInvMaxBid * mStyle.mIntensityScale,
+            mDraw.mInvMaxAsk * mStyle.mIntensityScale
+        };
+        const float lRing[3] = { (float)mHistoryLength, (float)lVisible, (float)lOldest };
+        const float lBackground[4] = {
+            (float)mStyle.mBackground.r / 255.0f, (float)mStyle.mBackground.g / 255.0f,
+            (float)mStyle.mBackground.b / 255.0f, 1.0f
+        };
+
+        BeginShaderMode(mGpuShader);
+        SetShaderValueTexture(mGpuShader, mLocAskGrid, mAskGridTexture);
+        SetShaderValueTexture(mGpuShader, mLocBidLut, mBidLutTexture);
+        SetShaderValueTexture(mGpuShader, mLocAskLut, mAskLutTexture);
+        SetShaderValue(mGpuShader, mLocInvMax, lInvMax, SHADER_UNIFORM_VEC2);
+        SetShaderValue(mGpuShader, mLocRing, lRing, SHADER_UNIFORM_VEC3);
+        SetShaderValue(mGpuShader, mLocBackground, lBackground, SHADER_UNIFORM_VEC4);
+        const Rectangle lGridSrc = {0, 0, (float)mPriceLevels, (float)mHistoryLength};
+        DrawTexturePro(mBidGridTexture, lGridSrc, lPlot, Vector2{0, 0}, 0.0f, WHITE);
+        RLCHARTS_PERF_DRAW_CALLS(mPerf, 1);
+        EndShaderMode();
         return;
     }
 
-    const Rectangle lPlot = getPlotArea();
+    if (!mTextureValid || mTexture.id == 0) {
+        return;
+    }
+
+    if (mRingTexture) {
+        // Source starts at the oldest ring column and wraps (TEXTURE_WRAP_REPEAT)
+        const float lVisibleW = lPlot.width * (float)lVisible / (float)mHistoryLength;
+        const Rectangle lSrc = {(float)lOldest, 0, (float)lVisible, (float)mPriceLevels};
+        const Rectangle lDst = {lPlot.x, lPlot.y, lVisibleW, lPlot.height};
+        DrawTexturePro(mTexture, lSrc, lDst, Vector2{0, 0}, 0.0f, WHITE);
+        RLCHARTS_PERF_DRAW_CALLS(mPerf, 1);
+        if (lVisible < mHistoryLength) {
+            // Until the history is full the newest column fills the rest (as ringTimeIndex does)
+            const float lNewest = (float)((lOldest + lVisible - 1) % mHistoryLength) + 0.5f;
+            const Rectangle lFillSrc = {lNewest, 0, 0, (float)mPriceLevels};
+            const Rectangle lFillDst = {lPlot.x + lVisibleW, lPlot.y, lPlot.width - lVisibleW, lPlot.height};
+            DrawTexturePro(mTexture, lFillSrc, lFillDst, Vector2{0, 0}, 0.0f, WHITE);
+            RLCHARTS_PERF_DRAW_CALLS(mPerf, 1);
+        }
+        return;
+    }
 
     // Source rectangle (full texture)
     const Rectangle lSrc = {0, 0, (float)mHistoryLength, (float)mPriceLevels};
@@ -781,9 +1519,12 @@ void RLOrderBookVis::drawHeatmap2D() const {
     const Rectangle lDst = lPlot;
 
     DrawTexturePro(mTexture, lSrc, lDst, Vector2{0, 0}, 0.0f, WHITE);
+    RLCHARTS_PERF_DRAW_CALLS(mPerf, 1);
 }
 
 void RLOrderBookVis::draw2D() const {
+    RLCHARTS_PERF_DRAW(mPerf, "RLOrderBookVis::draw2D");
+    mRedrawPending = false;
     drawBackground();
     drawGrid2D();
     drawHeatmap2D();
@@ -791,10 +1532,12 @@ void RLOrderBookVis::draw2D() const {
 }
 
 void RLOrderBookVis::draw3D(const Camera3D& rCamera) const {
-    if (!mMeshValid) {
+    RLCHARTS_PERF_DRAW(mPerf, "RLOrderBookVis::draw3D");
+    mRedrawPending = false;
+    if (!mMeshValid && !isGpuDisplacementActive()) {
         return;
     }
-    if (mSnapshotCount == 0) {
+    if (mDraw.mVisible == 0) {
         return;
     }
 
@@ -840,11 +1583,27 @@ void RLOrderBookVis::draw3D(const Camera3D& rCamera) const {
     }
 
     // Draw bid and ask meshes
-    // Use a simple material with vertex colors
-    const Material lMat = LoadMaterialDefault();
+    if (mDraw.mGpu3D && isGpuDisplacementActive()) {
+        const float lInvMax[2] = { mDraw.mInvMaxBid, mDraw.mInvMaxAsk };
+        const float lRing[3] = { (float)mHistoryLength, (float)mDraw.mVisible, (float)mDraw.mOldest };
+        const float lCellHeight[2] = { mStyle.m3DCellSize, mStyle.mHeightScale };
+        SetShaderValue(mDisplaceShader, mLocDispInvMax, lInvMax, SHADER_UNIFORM_VEC2);
+        SetShaderValue(mDisplaceShader, mLocDispRing, lRing, SHADER_UNIFORM_VEC3);
+        SetShaderValue(mDisplaceShader, mLocDispCellHeight, lCellHeight, SHADER_UNIFORM_VEC2);
+        // Same static mesh drawn once per side
+        for (const float lSide : { 0.0f, 1.0f }) {
+            SetShaderValue(mDisplaceShader, mLocDispSide, &lSide, SHADER_UNIFORM_FLOAT);
+            DrawMesh(mDisplaceMesh, mDisplaceMaterial, lTransform);
+            RLCHARTS_PERF_DRAW_CALLS(mPerf, 1);
+        }
+    } else if (mMeshValid) {
+        // Use a simple material with vertex colors
+        const Material lMat = LoadMaterialDefault();
 
-    DrawMesh(mBidMesh, lMat, lTransform);
-    DrawMesh(mAskMesh, lMat, lTransform);
+        DrawMesh(mBidMesh, lMat, lTransform);
+        DrawMesh(mAskMesh, lMat, lTransform);
+        RLCHARTS_PERF_DRAW_CALLS(mPerf, 2);
+    }
 
     EndMode3D();
     EndTextureMode();
@@ -854,6 +1613,7 @@ void RLOrderBookVis::draw3D(const Camera3D& rCamera) const {
     const Rectangle lSrc = {0, 0, (float)mRenderTargetWidth, -(float)mRenderTargetHeight};
     const Rectangle lDst = {mBounds.x, mBounds.y, mBounds.width, mBounds.height};
     DrawTexturePro(mRenderTarget.texture, lSrc, lDst, Vector2{0, 0}, 0.0f, WHITE);
+    RLCHARTS_PERF_DRAW_CALLS(mPerf, 1);
 
     // Draw border on top if enabled
     if (mStyle.mShowBorder) {
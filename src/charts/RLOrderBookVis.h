@@ -1,8 +1,16 @@
 // RLOrderBookVis.h
 #pragma once
 #include "raylib.h"
+#include "RLPerf.h"
+#include "RLColormap.h"
+#include "RLGpuStaging.h"
+#include "RLSpscRing.h"
+#include <atomic>
+#include <memory>
+#include <span>
 #include <vector>
 #include <cstddef>
+#include <cstdint>
 #include <utility>
 
 // Order book snapshot: lists of (price, size) pairs for bids and asks
@@ -12,6 +20,21 @@ struct RLOrderBookSnapshot {
     float mTimestamp{0.0f};                      // Optional timestamp for labeling
 };
 
+// Book side for incremental (L2 delta) updates
+enum class RLOrderBookSide {
+    Bid,
+    Ask
+};
+
+// One queued L2 change for RLOrderBookVis::Producer: a level update, or with
+// mCommit set a commitSnapshot() (price and size are ignored)
+struct RLOrderBookUpdate {
+    RLOrderBookSide mSide{RLOrderBookSide::Bid};
+    float mPrice{0.0f};
+    float mSize{0.0f};
+    bool mCommit{false};
+};
+
 // Price filtering mode for limiting displayed depth
 enum class RLOrderBookPriceMode {
     FullDepth,      // Show all price levels
@@ -60,6 +83,25 @@ struct RLOrderBookVisStyle {
 // Main order book visualization class
 class RLOrderBookVis {
 public:
+    // Producer handle for feeding L2 updates from another thread. Backed by a
+    // lock-free single-producer/single-consumer ring that prepare() drains in
+    // order through applyUpdate()/commitSnapshot(). Only one thread may push
+    // through a given producer. Handles stay valid for the lifetime of the chart.
+    class Producer {
+    public:
+        Producer() = default;
+        // Returns false if the queue is full (update dropped)
+        bool push(const RLOrderBookUpdate& rUpdate);
+        // Returns the number of updates queued (less than aCount if the queue filled up)
+        size_t push(const RLOrderBookUpdate* pUpdates, size_t aCount);
+        [[nodiscard]] bool isValid() const { return mpQueue != nullptr; }
+
+    private:
+        friend class RLOrderBookVis;
+        explicit Producer(RLCharts::SpscRing<RLOrderBookUpdate>* pQueue) : mpQueue(pQueue) {}
+        RLCharts::SpscRing<RLOrderBookUpdate>* mpQueue{ nullptr };
+    };
+
     // Constructor: bounds for 2D, history length (number of snapshots), price levels to display
     RLOrderBookVis(Rectangle aBounds, size_t aHistoryLength, size_t aPriceLevels);
     ~RLOrderBookVis();
@@ -82,16 +124,73 @@ public:
     // Color configuration (gradient stops, 2-4 colors each)
     void setBidColorStops(const std::vector<Color>& rStops);
     void setAskColorStops(const std::vector<Color>& rStops);
+    // Perceptual presets from RLColormap.h
+    void setBidColormap(RLCharts::ColormapPreset aPreset);
+    void setAskColormap(RLCharts::ColormapPreset aPreset);
+
+    // Colormap the 2D heatmap on the GPU: the bid/ask grids are uploaded as float
+    // textures in ring order and a fragment shader does intensity scaling, LUT
+    // lookup, bid/ask blending and the ring-to-time remap. Falls back to the CPU
+    // path if float textures or the shader are unavailable.
+    void setGpuColormap(bool aEnabled);
+
+    // Keep the CPU heatmap texture as a circular buffer: each snapshot only colors
+    // and uploads its own column, scrolling is a UV offset at draw time. Older
+    // columns keep the intensity scale they were colored with until the scale
+    // drifts by more than RING_RECOLOR_DRIFT, which triggers one full recolor.
+    // (The GPU colormap path always uploads only the new rows.)
+    void setRingTexture(bool aEnabled);
+
+    // Draw the 3D surface from one static grid mesh displaced in a vertex shader
+    // that samples the float history textures: a new snapshot costs one row
+    // upload instead of rewriting both meshes. Desktop GL only (vertex texture
+    // fetch); falls back to the CPU meshes elsewhere.
+    void setGpuDisplacement3D(bool aEnabled);
 
     // Data input
     void pushSnapshot(const RLOrderBookSnapshot& rSnapshot);
     void clear();
 
-    // Update and rendering
+    // Incremental L2 input: keep an internal book and apply level changes
+    // (aSize <= 0 removes the level), then commitSnapshot() writes one history
+    // column. While the price-to-row mapping is unchanged the new column is the
+    // previous one plus the changed rows; otherwise it is rebuilt from the book.
+    void applyUpdate(RLOrderBookSide aSide, float aPrice, float aSize);
+    void commitSnapshot();
+    void clearBook();
+    // Create a cross-thread producer (call from the render thread)
+    Producer createProducer(size_t aCapacity = 65536);
+
+    // Snapshot of the history grids, price/intensity scales, market state and the
+    // internal L2 book (RLStateCodec.h), e.g. to warm up a dashboard after a
+    // restart. loadState() adopts the saved history length and price levels; it
+    // returns false, leaving the chart untouched, for a blob that does not match.
+    [[nodiscard]] std::vector<uint8_t> saveState() const;
+    bool loadState(std::span<const uint8_t> aState);
+
+    // Update and rendering. update(dt) is prepare(dt) followed by commit().
+    // prepare() drains the producer queues, smooths the scales and colors the new
+    // columns, grid rows and mesh vertices straight into a staging buffer without
+    // GL calls, so it may run on a worker thread; commit() creates the
+    // textures/meshes and uploads the staged frame on the render thread. The
+    // draws only read what commit() published, so prepare() and ingest
+    // (pushSnapshot/commitSnapshot/producers) for the next frame may overlap
+    // commit() and drawing of the previous one. Setters, isSettled() and
+    // needsRedraw() must not overlap prepare().
     void update(float aDt);
+    void prepare(float aDt);
+    void commit();
     void draw2D() const;
     void draw3D(const Camera3D& rCamera) const;
 
+    // Settled once the price/intensity scales stopped moving, every producer queue
+    // is empty and every snapshot is uploaded. The intensity maxima decay towards 1 between bursts, so a book that
+    // saw large sizes keeps animating for a while after the feed goes quiet.
+    [[nodiscard]] bool isSettled() const;
+    [[nodiscard]] bool needsRedraw() const { return mRedrawPending || !isSettled(); }
+    // update()/rebuild/draw() timers and GPU counters (RLPerf.h); zero unless built with RLCHARTS_PERF
+    [[nodiscard]] const RLCharts::PerfStats& getPerfStats() const { return mPerf; }
+
     // Getters
     [[nodiscard]] Rectangle getBounds() const { return mBounds; }
     [[nodiscard]] size_t getHistoryLength() const { return mHistoryLength; }
@@ -100,6 +199,18 @@ public:
     [[nodiscard]] float getCurrentMidPrice() const { return mCurrentMidPrice; }
     [[nodiscard]] float getCurrentSpread() const { return mCurrentSpread; }
     [[nodiscard]] int getSpreadTicks() const { return mSpreadTicks; }
+    [[nodiscard]] bool isGpuColormapEnabled() const { return mGpuColormap; }
+    [[nodiscard]] bool isGpuColormapActive() const { return mGpuColormap && mGpuReady; }
+    [[nodiscard]] bool isRingTextureEnabled() const { return mRingTexture; }
+    [[nodiscard]] bool isGpuDisplacementEnabled() const { return mGpuDisplacement; }
+    [[nodiscard]] bool isGpuDisplacementActive() const { return mGpuDisplacement && mDisplaceReady; }
+    // Aggregated size in history column aTimeOffset (0 = oldest visible), row 0 = highest price
+    [[nodiscard]] float getHistoryValue(RLOrderBookSide aSide, size_t aTimeOffset, size_t aPriceRow) const;
+    [[nodiscard]] size_t getBookLevelCount(RLOrderBookSide aSide) const {
+        return aSide == RLOrderBookSide::Bid ? mBookBids.size() : mBookAsks.size();
+    }
+    // Grid cells colored/staged by the last prepare()
+    [[nodiscard]] size_t getLastUploadCells() const { return mLastUploadCells; }
 
 private:
     // Bounds and dimensions
@@ -135,6 +246,22 @@ private:
     size_t mHead{0};                  // Next write position in ring buffer
     size_t mSnapshotCount{0};         // Current number of snapshots
 
+    // Internal book for applyUpdate/commitSnapshot (best level first on both sides)
+    struct BookDelta {
+        RLOrderBookSide mSide;
+        float mPrice;
+        float mSizeDelta;
+    };
+    std::vector<std::pair<float, float>> mBookBids;  // Descending by price
+    std::vector<std::pair<float, float>> mBookAsks;  // Ascending by price
+    std::vector<BookDelta> mBookDeltas;              // Changes since the last commit
+    bool mBookColumnValid{false};                    // Previous column came from the book
+    float mBookColumnMinPrice{0.0f};                 // Mapping the previous column used
+    float mBookColumnMaxPrice{0.0f};
+
+    // Cross-thread ingest queues, drained by prepare()
+    std::vector<std::unique_ptr<RLCharts::SpscRing<RLOrderBookUpdate>>> mProducers;
+
     // Current market state
     float mCurrentMidPrice{50.0f};
     float mCurrentSpread{0.1f};
@@ -147,11 +274,76 @@ private:
     float mCurrentMaxBid{1.0f};
     float mCurrentMaxAsk{1.0f};
 
-    // 2D texture resources
-    std::vector<unsigned char> mPixels;  // RGBA pixels
+    mutable bool mRedrawPending{true}; // cleared by draw2D()/draw3D()
+    mutable RLCharts::PerfStats mPerf;
+
+    // One prepared frame: its uploads and what the draws show with them
+    struct DrawState {
+        size_t mVisible{0};               // Snapshots on screen
+        size_t mOldest{0};                // Ring index of the oldest one
+        float mInvMaxBid{1.0f};
+        float mInvMaxAsk{1.0f};
+        float mMinPrice{0.0f};
+        float mMaxPrice{100.0f};
+        float mMidPrice{50.0f};
+        float mBestBid{49.95f};
+        float mBestAsk{50.05f};
+        bool mGpu2D{false};
+        bool mGpu3D{false};
+    };
+    struct StagedFrame {
+        RLCharts::UploadList mUploads;
+        DrawState mDraw;
+        bool mMeshes{false};              // Bid/ask mesh buffers are staged
+        void clear() { mUploads.clear(); mMeshes = false; }
+    };
+    RLCharts::StagingBuffers<StagedFrame> mStaging;
+    bool mPreparedGpu2D{false};           // Paths the last prepare() took
+    bool mPreparedGpu3D{false};
+    std::atomic<bool> mRestageAll{false}; // commit() created resources the staged frame did not fill
+    DrawState mDraw;                      // Committed state read by draw2D()/draw3D()
+
+    // 2D texture resources (colored texels go straight into the staging buffer)
     Texture2D mTexture{};
     bool mTextureValid{false};
-    bool mTextureDirty{true};
+    bool mTextureDirty{true};         // Full rebuild needed
+    size_t mPendingColumns{0};        // Snapshots pushed since the last upload
+    size_t mLastUploadCells{0};
+
+    // Ring texture mode: texture column = ring index
+    static constexpr float RING_RECOLOR_DRIFT = 0.25f;
+    bool mRingTexture{false};
+    float mRingColoredMaxBid{1.0f};   // Scale of the last full recolor
+    float mRingColoredMaxAsk{1.0f};
+
+    // GPU colormap resources (grids are priceLevels wide, historyLength tall)
+    bool mGpuColormap{false};
+    bool mGpuReady{false};
+    std::atomic<bool> mGpuFailed{false};       // set by commit(), read by prepare()
+    bool mLutUploadDirty{true};
+    Shader mGpuShader{};
+    int mLocAskGrid{-1};
+    int mLocBidLut{-1};
+    int mLocAskLut{-1};
+    int mLocInvMax{-1};      // vec2: bid, ask (intensity scale folded in)
+    int mLocRing{-1};        // vec3: history length, visible count, oldest ring index
+    int mLocBackground{-1};
+    Texture2D mBidGridTexture{};
+    Texture2D mAskGridTexture{};
+    Texture2D mBidLutTexture{};
+    Texture2D mAskLutTexture{};
+
+    // GPU displacement (3D) resources, sharing the grid/LUT textures above
+    bool mGpuDisplacement{false};
+    bool mDisplaceReady{false};
+    std::atomic<bool> mDisplaceFailed{false};
+    Shader mDisplaceShader{};
+    Material mDisplaceMaterial{};
+    Mesh mDisplaceMesh{};     // Static: x = time offset, z = price row
+    int mLocDispInvMax{-1};
+    int mLocDispRing{-1};
+    int mLocDispCellHeight{-1};
+    int mLocDispSide{-1};
 
     // 3D mesh resources
     Mesh mBidMesh{};
@@ -168,15 +360,35 @@ private:
     // Internal helpers
     void ensureBuffers();
     void rebuildLUT();
-    void rebuildTexture();
-    void updateTexturePixels();
-    void rebuildMesh();
-    void updateMeshData();
+    bool rebuildTexture();
+    void updateTexturePixels(RLCharts::UploadList& rUploads);
+    void updateRingColumns(RLCharts::UploadList& rUploads, size_t aCount);
+    void stageGridRows(RLCharts::UploadList& rUploads, size_t aCount);
+    [[nodiscard]] Color cellColor(size_t aGridIdx, float aInvMaxBid, float aInvMaxAsk) const;
+    bool ensureMeshes();
+    void updateMeshData(RLCharts::UploadList& rUploads);
+    // State of the last prepare() alone, without the staging hand-off
+    [[nodiscard]] bool isPrepared() const;
+    [[nodiscard]] bool gpu2DWanted() const { return mGpuColormap && !mGpuFailed.load(std::memory_order_acquire); }
+    [[nodiscard]] bool gpu3DWanted() const { return mGpuDisplacement && !mDisplaceFailed.load(std::memory_order_acquire); }
     void cleanupTexture();
+    bool ensureGpuResources();
+    bool ensureGridTextures();
+    bool ensureDisplacementResources();
+    void cleanupGpuResources();
+    void cleanupGpuShader();
+    void cleanupDisplacement();
     void cleanupMesh();
     void cleanupRenderTarget() const;
     void ensureRenderTarget() const;
 
+    // Snapshot column helpers (shared by pushSnapshot and commitSnapshot)
+    void updateMarketState(float aBestBid, float aBestAsk);
+    void updatePriceTarget(float aLowest, float aHighest);
+    float accumulateLevels(const std::vector<std::pair<float, float>>& rLevels, std::vector<float>& rGrid);
+    void advanceColumn(float aLocalMaxBid, float aLocalMaxAsk);
+    void drainProducers();
+
     // Price mapping helpers
     [[nodiscard]] float priceToNormalized(float aPrice) const;
     [[nodiscard]] float normalizedToPrice(float aNorm) const;
@@ -3,21 +3,30 @@
 #include <algorithm>
 #include <cmath>
 
+namespace {
+// Arc tessellation: chord error target, and bounds on the angle per step (degrees)
+constexpr float ARC_TOLERANCE_PX = 0.25f;
+constexpr float ARC_MIN_STEP_DEG = 1.0f;
+constexpr float ARC_MAX_STEP_DEG = 20.0f;
+}
 
 RLPieChart::RLPieChart(Rectangle aBounds, const RLPieChartStyle &aStyle)
         : mBounds(aBounds), mStyle(aStyle) {
 }
 
 void RLPieChart::setBounds(Rectangle aBounds){
+    mRedrawPending = true;
     mBounds = aBounds;
     mGeomDirty = true;
 }
 
 void RLPieChart::setStyle(const RLPieChartStyle &rStyle){
+    mRedrawPending = true;
     mStyle = rStyle;
 }
 
 void RLPieChart::setHollowFactor(float aFactor){
+    mRedrawPending = true;
     mHollowFactor = std::clamp(aFactor, 0.0f, 1.0f);
 }
 
@@ -111,7 +120,43 @@ void RLPieChart::recomputeTargetsFromData(const std::vector<RLPieSliceData> &rDa
     }
 }
 
-void RLPieChart::setData(const std::vector<RLPieSliceData> &rData){
+// Slices below mOtherThreshold of the total are summed into one trailing slice.
+// Returns rData itself when nothing is merged.
+const std::vector<RLPieSliceData> &RLPieChart::mergeSmallSlices(const std::vector<RLPieSliceData> &rData){
+    if (mStyle.mOtherThreshold <= 0.0f) {
+        return rData;
+    }
+    float lSum = 0.0f;
+    for (const auto &rS : rData) {
+        lSum += std::max(rS.mValue, 0.0f);
+    }
+    const float lLimit = lSum * mStyle.mOtherThreshold;
+    size_t lSmall = 0;
+    for (const auto &rS : rData) {
+        if (std::max(rS.mValue, 0.0f) < lLimit) {
+            lSmall++;
+        }
+    }
+    if (lSmall < 2) {
+        return rData;
+    }
+
+    mShownData.clear();
+    RLPieSliceData lOther{ 0.0f, mStyle.mOtherColor, mStyle.mOtherLabel };
+    for (const auto &rS : rData) {
+        if (std::max(rS.mValue, 0.0f) < lLimit) {
+            lOther.mValue += std::max(rS.mValue, 0.0f);
+        } else {
+            mShownData.push_back(rS);
+        }
+    }
+    mShownData.push_back(lOther);
+    return mShownData;
+}
+
+void RLPieChart::setData(const std::vector<RLPieSliceData> &rSource){
+    mRedrawPending = true;
+    const std::vector<RLPieSliceData> &rData = mergeSmallSlices(rSource);
     // Immediate: set as both current and target
     recomputeTargetsFromData(rData);
     for (size_t i=0; i<mSlices.size(); ++i){
@@ -130,7 +175,8 @@ void RLPieChart::setData(const std::vector<RLPieSliceData> &rData){
 }
 
 void RLPieChart::setTargetData(const std::vector<RLPieSliceData> &rData){
-    recomputeTargetsFromData(rData);
+    mRedrawPending = true;
+    recomputeTargetsFromData(mergeSmallSlices(rData));
 }
 
 
@@ -149,7 +195,21 @@ void RLPieChart::ensureGeometry() const{
     mGeomDirty = false;
 }
 
+bool RLPieChart::isSettled() const{
+    for (const auto &lS : mSlices){
+        if (!RLCharts::nearlyEqual(lS.mStart, lS.mStartTarget) || !RLCharts::nearlyEqual(lS.mEnd, lS.mEndTarget) ||
+            !RLCharts::nearlyEqual(lS.mVis, lS.mVisTarget) || !RLCharts::nearlyEqual(lS.mValue, lS.mTarget) ||
+            !RLCharts::colorEquals(lS.mColor, lS.mColorTarget)){
+            return false;
+        }
+    }
+    return true;
+}
+
 void RLPieChart::update(float aDt){
+    RLCHARTS_PERF_UPDATE(mPerf, "RLPieChart::update");
+    if (isSettled()) return;
+    mRedrawPending = true;
     const float lAngleK = mStyle.mSmoothAnimate ? (mStyle.mAngleSpeed * aDt) : 1.0f;
     const float lFadeK = mStyle.mSmoothAnimate ? (mStyle.mFadeSpeed * aDt) : 1.0f;
     const float lColorK = mStyle.mSmoothAnimate ? (mStyle.mColorSpeed * aDt) : 1.0f;
@@ -159,42 +219,108 @@ void RLPieChart::update(float aDt){
         lS.mEnd = RLCharts::approach(lS.mEnd, lS.mEndTarget, lAngleK);
         lS.mVis = RLCharts::approach(lS.mVis, lS.mVisTarget, lFadeK);
         lS.mValue = RLCharts::approach(lS.mValue, lS.mTarget, lAngleK);
-        lS.mColor = RLCharts::lerpColor(lS.mColor, lS.mColorTarget, RLCharts::clamp01(lColorK));
+        lS.mColor = RLCharts::approachColor(lS.mColor, lS.mColorTarget, lColorK);
     }
 }
 
 void RLPieChart::draw() const{
+    RLCHARTS_PERF_DRAW(mPerf, "RLPieChart::draw");
+    mRedrawPending = false;
     ensureGeometry();
     if (mStyle.mShowBackground){
         DrawRectangleV(Vector2{mBounds.x, mBounds.y}, Vector2{mBounds.width, mBounds.height}, mStyle.mBackground);
     }
 
-    const float lInner = mOuterRadius * RLCharts::clamp01(mHollowFactor);
+    float lInner = mOuterRadius * RLCharts::clamp01(mHollowFactor);
+    if (lInner <= 0.5f){
+        // Solid sectors
+        lInner = 0.0f;
+    }
+    if (lInner >= mOuterRadius - 0.5f){
+        // Fully hollow -> effectively invisible
+        return;
+    }
 
-    for (const auto &lS : mSlices){
-        constexpr int lSegments = 72;
-        if (lS.mVis <= 0.001f) {
-            continue;
+    // A new radius or center invalidates every slice mesh
+    if (lInner != mMeshInner || mOuterRadius != mMeshOuter || mCenter.x != mMeshCenter.x ||
+        mCenter.y != mMeshCenter.y){
+        mMeshes.clear();
+        mMeshInner = lInner;
+        mMeshOuter = mOuterRadius;
+        mMeshCenter = mCenter;
+    }
+    bool lBatchDirty = mMeshes.size() != mSlices.size() || mBatch.empty();
+    mMeshes.resize(mSlices.size());
+
+    for (size_t i = 0; i < mSlices.size(); ++i){
+        const SliceDyn &lS = mSlices[i];
+        SliceMesh &rMesh = mMeshes[i];
+        const bool lVisible = lS.mVis > 0.001f && lS.mEnd > lS.mStart;
+        Color lCol{ 0, 0, 0, 0 };
+        if (lVisible){
+            // apply visibility to alpha
+            const Color lC = lS.mColor;
+            const float lAlpha = RLCharts::clamp01(lS.mVis);
+            const auto lA = static_cast<unsigned char>(std::lround(static_cast<float>(lC.a) * lAlpha));
+            lCol = Color{ lC.r, lC.g, lC.b, lA };
+            if (lS.mStart != rMesh.mStart || lS.mEnd != rMesh.mEnd){
+                buildSliceMesh(rMesh, lS.mStart, lS.mEnd, lInner);
+                lBatchDirty = true;
+            }
         }
-        const float lStart = lS.mStart;
-        const float lEnd = lS.mEnd;
-        if (lEnd <= lStart) {
-            continue;
+        if (!RLCharts::colorEquals(lCol, rMesh.mColor)){
+            rMesh.mColor = lCol;
+            lBatchDirty = true;
         }
-        const Color lC = lS.mColor;
-        // apply visibility to alpha
-        const float lAlpha = RLCharts::clamp01(lS.mVis);
-        const auto lA = static_cast<unsigned char>(std::lround(static_cast<float>(lC.a) * lAlpha));
-        const Color lCol{ lC.r, lC.g, lC.b, lA };
-
-        if (lInner <= 0.5f){
-            // Solid sector
-            DrawCircleSector(mCenter, mOuterRadius, lStart, lEnd, lSegments, lCol);
-        } else if (lInner >= mOuterRadius - 0.5f){
-            // Fully hollow -> effectively invisible (skip)
-            continue;
-        } else {
-            DrawRing(mCenter, lInner, mOuterRadius, lStart, lEnd, lSegments, lCol);
+    }
+
+    if (lBatchDirty){
+        mBatch.clear();
+        for (const SliceMesh &rMesh : mMeshes){
+            if (rMesh.mColor.a == 0) {
+                continue;
+            }
+            const std::vector<Vector2> &rTri = rMesh.mTriangles;
+            for (size_t t = 0; t + 2 < rTri.size(); t += 3){
+                mBatch.addTriangle(rTri[t], rTri[t + 1], rTri[t + 2], rMesh.mColor);
+            }
+        }
+    }
+    mBatch.draw();
+}
+
+// Sector (aInner == 0) or ring segment from aStart to aEnd degrees, with as many
+// steps as the outer radius needs to stay within ARC_TOLERANCE_PX of the circle
+void RLPieChart::buildSliceMesh(SliceMesh &rMesh, float aStart, float aEnd, float aInner) const{
+    mMeshBuilds++;
+    rMesh.mStart = aStart;
+    rMesh.mEnd = aEnd;
+    rMesh.mTriangles.clear();
+
+    const float lOuter = mOuterRadius;
+    const float lCosLimit = std::max(1.0f - ARC_TOLERANCE_PX / std::max(lOuter, 1.0f), -1.0f);
+    const float lStepDeg = std::clamp(2.0f * acosf(lCosLimit) * RAD2DEG, ARC_MIN_STEP_DEG, ARC_MAX_STEP_DEG);
+    const int lSteps = std::max(1, (int)ceilf((aEnd - aStart) / lStepDeg));
+    const float lDelta = (aEnd - aStart) / (float)lSteps * DEG2RAD;
+    const float lFirst = aStart * DEG2RAD;
+
+    Vector2 lPrevOut{ mCenter.x + cosf(lFirst) * lOuter, mCenter.y + sinf(lFirst) * lOuter };
+    Vector2 lPrevIn{ mCenter.x + cosf(lFirst) * aInner, mCenter.y + sinf(lFirst) * aInner };
+    for (int s = 1; s <= lSteps; ++s){
+        const float lAngle = lFirst + lDelta * (float)s;
+        const float lCos = cosf(lAngle);
+        const float lSin = sinf(lAngle);
+        const Vector2 lOut{ mCenter.x + lCos * lOuter, mCenter.y + lSin * lOuter };
+        rMesh.mTriangles.push_back(lPrevOut);
+        rMesh.mTriangles.push_back(lOut);
+        rMesh.mTriangles.push_back(lPrevIn);
+        if (aInner > 0.0f){
+            const Vector2 lIn{ mCenter.x + lCos * aInner, mCenter.y + lSin * aInner };
+            rMesh.mTriangles.push_back(lPrevIn);
+            rMesh.mTriangles.push_back(lOut);
+            rMesh.mTriangles.push_back(lIn);
+            lPrevIn = lIn;
         }
+        lPrevOut = lOut;
     }
 }
@@ -1,6 +1,8 @@
 #pragma once
 #include "raylib.h"
+#include "RLPerf.h"
 #include "RLCommon.h"
+#include "RLLineBatch.h"
 #include <vector>
 #include <string>
 
@@ -26,6 +28,13 @@ struct RLPieChartStyle {
     float mAngleSpeed{ 8.0f }; // approach speed for angles (1/s)
     float mFadeSpeed{ 8.0f };  // approach speed for visibility (1/s)
     float mColorSpeed{ 6.0f }; // color blend speed (1/s)
+
+    // Small slices: slices below this share of the total (0..1, 0 = off) are merged
+    // into one "other" slice, so they draw no geometry of their own. Applied by the
+    // next setData()/setTargetData(); needs at least two such slices.
+    float mOtherThreshold{ 0.0f };
+    Color mOtherColor{ 110, 114, 124, 255 };
+    std::string mOtherLabel{ "Other" };
 };
 
 class RLPieChart {
@@ -48,7 +57,18 @@ public:
     // Draw
     void draw() const;
 
+    // Settled once slice angles, values, visibility and colors match their targets
+    [[nodiscard]] bool isSettled() const;
+    [[nodiscard]] bool needsRedraw() const { return mRedrawPending || !isSettled(); }
+    // update()/rebuild/draw() timers and GPU counters (RLPerf.h); zero unless built with RLCHARTS_PERF
+    [[nodiscard]] const RLCharts::PerfStats& getPerfStats() const { return mPerf; }
+
     [[nodiscard]] Rectangle getBounds() const { return mBounds; }
+    // Slices of the last data set, after merging small ones into "other"
+    [[nodiscard]] size_t getSliceCount() const { return mTargetCount; }
+    // Slice arcs tessellated by draw() so far; only slices whose angles (or the
+    // radii) changed are rebuilt
+    [[nodiscard]] size_t getSliceMeshBuildCount() const { return mMeshBuilds; }
 
 private:
     struct SliceDyn {
@@ -71,13 +91,33 @@ private:
     std::vector<SliceDyn> mSlices;
     size_t mTargetCount{0};
     float mHollowFactor{0.0f};
+    mutable bool mRedrawPending{true}; // cleared by draw()
+    mutable RLCharts::PerfStats mPerf;
 
     // Cached geometry
     mutable bool mGeomDirty{ true };
     mutable Vector2 mCenter{0,0};
     mutable float mOuterRadius{0.0f};
 
+    // Triangles of one slice arc, kept while its angles and the radii stay the same
+    struct SliceMesh {
+        std::vector<Vector2> mTriangles; // three corners per triangle
+        float mStart{0.0f};
+        float mEnd{-1.0f};
+        Color mColor{0, 0, 0, 0};
+    };
+    mutable std::vector<SliceMesh> mMeshes; // parallel to mSlices
+    mutable float mMeshInner{-1.0f};
+    mutable float mMeshOuter{-1.0f};
+    mutable Vector2 mMeshCenter{0, 0};
+    mutable size_t mMeshBuilds{0};
+    // All visible slices, rebuilt only when a mesh or a slice color changed
+    mutable RLCharts::LineBatch mBatch;
+    std::vector<RLPieSliceData> mShownData; // data after merging small slices
+
     void ensureSize(size_t aCount);
+    const std::vector<RLPieSliceData> &mergeSmallSlices(const std::vector<RLPieSliceData> &rData);
     void recomputeTargetsFromData(const std::vector<RLPieSliceData> &rData);
     void ensureGeometry() const;
+    void buildSliceMesh(SliceMesh &rMesh, float aStart, float aEnd, float aInner) const;
 };
@@ -21,8 +21,11 @@ RLRadarChart::RLRadarChart(Rectangle aBounds, const RLRadarChartStyle& rStyle)
 // ============================================================================
 
 void RLRadarChart::setBounds(Rectangle aBounds) {
+    mRedrawPending = true;
+    mBatchDirty = true;
     mBounds = aBounds;
     mGeomDirty = true;
+    mStaticLayer.invalidate();
     // Mark all series caches dirty
     for (auto& rSeries : mSeries) {
         rSeries.mCacheDirty = true;
@@ -30,15 +33,26 @@ void RLRadarChart::setBounds(Rectangle aBounds) {
 }
 
 void RLRadarChart::setStyle(const RLRadarChartStyle& rStyle) {
+    mRedrawPending = true;
+    mBatchDirty = true;
     mStyle = rStyle;
     mGeomDirty = true;
     mRangeDirty = true;
+    mStaticLayer.invalidate();
+}
+
+void RLRadarChart::setStaticLayerCache(bool aEnabled) {
+    mRedrawPending = true;
+    mStaticLayer.setEnabled(aEnabled);
 }
 
 void RLRadarChart::setAxes(const std::vector<RLRadarAxis>& rAxes) {
+    mRedrawPending = true;
+    mBatchDirty = true;
     mAxes = rAxes;
     mGeomDirty = true;
     mRangeDirty = true;
+    mStaticLayer.invalidate();
 
     // Resize all series values to match axis count
     for (auto& rSeries : mSeries) {
@@ -49,6 +63,8 @@ void RLRadarChart::setAxes(const std::vector<RLRadarAxis>& rAxes) {
 }
 
 void RLRadarChart::setAxes(const std::vector<std::string>& rLabels, float aMin, float aMax) {
+    mRedrawPending = true;
+    mBatchDirty = true;
     std::vector<RLRadarAxis> lAxes;
     lAxes.reserve(rLabels.size());
     for (const auto& rLabel : rLabels) {
@@ -66,6 +82,8 @@ void RLRadarChart::setAxes(const std::vector<std::string>& rLabels, float aMin,
 // ============================================================================
 
 void RLRadarChart::addSeries(const RLRadarSeries& rSeries) {
+    mRedrawPending = true;
+    mBatchDirty = true;
     SeriesDyn lDyn;
     lDyn.mLabel = rSeries.mLabel;
     lDyn.mLineColor = rSeries.mLineColor;
@@ -101,6 +119,8 @@ void RLRadarChart::setSeriesData(size_t aIndex, const std::vector<float>& rValue
     if (aIndex >= mSeries.size()) {
         return;
     }
+    mRedrawPending = true;
+    mBatchDirty = true;
 
     SeriesDyn& rSeries = mSeries[aIndex];
     const size_t lAxisCount = mAxes.size();
@@ -116,6 +136,8 @@ void RLRadarChart::setSeriesData(size_t aIndex, const RLRadarSeries& rSeries) {
     if (aIndex >= mSeries.size()) {
         return;
     }
+    mRedrawPending = true;
+    mBatchDirty = true;
 
     SeriesDyn& rDyn = mSeries[aIndex];
     rDyn.mLabel = rSeries.mLabel;
@@ -134,10 +156,43 @@ void RLRadarChart::setSeriesData(size_t aIndex, const RLRadarSeries& rSeries) {
     mRangeDirty = true;
 }
 
+void RLRadarChart::setAllSeriesData(const std::vector<std::vector<float>>& rMatrix) {
+    mRedrawPending = true;
+    mBatchDirty = true;
+    const size_t lAxisCount = mAxes.size();
+    const size_t lCount = std::min(rMatrix.size(), mSeries.size());
+    for (size_t s = 0; s < lCount; ++s) {
+        SeriesDyn& rSeries = mSeries[s];
+        const std::vector<float>& rRow = rMatrix[s];
+        const size_t lCopy = std::min(lAxisCount, rRow.size());
+        std::copy(rRow.begin(), rRow.begin() + (std::ptrdiff_t)lCopy, rSeries.mTargets.begin());
+        rSeries.mCacheDirty = true;
+    }
+    mRangeDirty = true;
+}
+
+void RLRadarChart::setAllSeriesData(std::span<const float> aValues, size_t aSeriesCount) {
+    mRedrawPending = true;
+    mBatchDirty = true;
+    const size_t lAxisCount = mAxes.size();
+    if (lAxisCount == 0) {
+        return;
+    }
+    const size_t lCount = std::min({ aSeriesCount, mSeries.size(), aValues.size() / lAxisCount });
+    for (size_t s = 0; s < lCount; ++s) {
+        const float* pRow = aValues.data() + s * lAxisCount;
+        std::copy(pRow, pRow + lAxisCount, mSeries[s].mTargets.begin());
+        mSeries[s].mCacheDirty = true;
+    }
+    mRangeDirty = true;
+}
+
 void RLRadarChart::removeSeries(size_t aIndex) {
     if (aIndex >= mSeries.size()) {
         return;
     }
+    mRedrawPending = true;
+    mBatchDirty = true;
 
     // Mark for removal with fade-out animation
     mSeries[aIndex].mVisibilityTarget = 0.0f;
@@ -158,6 +213,8 @@ void RLRadarChart::removeSeries(size_t aIndex) {
 }
 
 void RLRadarChart::clearSeries() {
+    mRedrawPending = true;
+    mBatchDirty = true;
     mSeries.clear();
     mTargetSeriesCount = 0;
 }
@@ -166,7 +223,32 @@ void RLRadarChart::clearSeries() {
 // Update (Animation)
 // ============================================================================
 
+bool RLRadarChart::isSettled() const {
+    for (const auto& rSeries : mSeries) {
+        if (rSeries.mPendingRemoval ||
+            !RLCharts::nearlyEqual(rSeries.mVisibility, rSeries.mVisibilityTarget) ||
+            !RLCharts::nearlyEqual(rSeries.mLineThickness, rSeries.mLineThicknessTarget) ||
+            !RLCharts::colorEquals(rSeries.mLineColor, rSeries.mLineColorTarget) ||
+            !RLCharts::colorEquals(rSeries.mFillColor, rSeries.mFillColorTarget)) {
+            return false;
+        }
+        for (size_t i = 0; i < rSeries.mValues.size(); ++i) {
+            if (!RLCharts::nearlyEqual(rSeries.mValues[i], rSeries.mTargets[i])) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
 void RLRadarChart::update(float aDt) {
+    RLCHARTS_PERF_UPDATE(mPerf, "RLRadarChart::update");
+    if (isSettled()) {
+        return;
+    }
+    mRedrawPending = true;
+    mBatchDirty = true;
+
     if (!mStyle.mSmoothAnimate) {
         // Instant update
         for (auto& rSeries : mSeries) {
@@ -201,8 +283,8 @@ void RLRadarChart::update(float aDt) {
             }
 
             // Animate colors
-            rSeries.mLineColor = RLCharts::lerpColor(rSeries.mLineColor, rSeries.mLineColorTarget, lValueSpeed);
-            rSeries.mFillColor = RLCharts::lerpColor(rSeries.mFillColor, rSeries.mFillColorTarget, lValueSpeed);
+            rSeries.mLineColor = RLCharts::approachColor(rSeries.mLineColor, rSeries.mLineColorTarget, lValueSpeed);
+            rSeries.mFillColor = RLCharts::approachColor(rSeries.mFillColor, rSeries.mFillColorTarget, lValueSpeed);
 
             // Animate line thickness
             rSeries.mLineThickness = RLCharts::approach(rSeries.mLineThickness, rSeries.mLineThicknessTarget, lValueSpeed);
@@ -228,22 +310,26 @@ void RLRadarChart::update(float aDt) {
 // ============================================================================
 
 void RLRadarChart::draw() const {
+    RLCHARTS_PERF_DRAW(mPerf, "RLRadarChart::draw");
+    mRedrawPending = false;
     if (mAxes.size() < 3) {
         return; // Need at least 3 axes for a radar chart
     }
 
     computeGeometry();
 
-    drawBackground();
-    drawGrid();
-    drawAxes();
+    // Background, grid and axes (cached if enabled)
+    mStaticLayer.draw(mBounds, 0, [this]() {
+        drawBackground();
+        drawGrid();
+        drawAxes();
+    });
 
-    // Draw series (back to front for proper layering)
-    for (const auto& rSeries : mSeries) {
-        if (rSeries.mVisibility > 0.001f) {
-            drawSeries(rSeries);
-        }
+    // All series (back to front) in one submission
+    if (mBatchDirty) {
+        rebuildSeriesBatch();
     }
+    mSeriesBatch.draw();
 
     drawAxisLabels();
     drawLegend();
@@ -268,7 +354,7 @@ void RLRadarChart::computeGeometry() const {
 
     // Compute axis angles (evenly distributed, starting from top)
     const size_t lAxisCount = mAxes.size();
-    mAxisAngles.resize(lAxisCount);
+    mAxisDirs.resize(lAxisCount);
     mAxisEndpoints.resize(lAxisCount);
 
     constexpr float LOCAL_PI = 3.14159265358979323846f;
@@ -280,14 +366,19 @@ void RLRadarChart::computeGeometry() const {
 
     for (size_t i = 0; i < lAxisCount; ++i) {
         const float lAngle = lStartAngle + lAngleStep * (float)i;
-        mAxisAngles[i] = lAngle;
+        mAxisDirs[i] = { cosf(lAngle), sinf(lAngle) };
         mAxisEndpoints[i] = {
-            mCenter.x + cosf(lAngle) * mRadius,
-            mCenter.y + sinf(lAngle) * mRadius
+            mCenter.x + mAxisDirs[i].x * mRadius,
+            mCenter.y + mAxisDirs[i].y * mRadius
         };
     }
 
     mGeomDirty = false;
+    mBatchDirty = true;
+    // Cached series points depend on the center, radius and range
+    for (const auto& rSeries : mSeries) {
+        rSeries.mCacheDirty = true;
+    }
 
     // Recompute global range if needed
     if (mRangeDirty) {
@@ -341,16 +432,16 @@ float RLRadarChart::normalizeValue(float aValue, size_t aAxisIndex) const {
 }
 
 Vector2 RLRadarChart::getPointOnAxis(size_t aAxisIndex, float aNormalizedValue) const {
-    if (aAxisIndex >= mAxisAngles.size()) {
+    if (aAxisIndex >= mAxisDirs.size()) {
         return mCenter;
     }
 
-    const float lAngle = mAxisAngles[aAxisIndex];
+    const Vector2 lDir = mAxisDirs[aAxisIndex];
     const float lR = mRadius * aNormalizedValue;
 
     return {
-        mCenter.x + cosf(lAngle) * lR,
-        mCenter.y + sinf(lAngle) * lR
+        mCenter.x + lDir.x * lR,
+        mCenter.y + lDir.y * lR
     };
 }
 
@@ -429,19 +520,19 @@ void RLRadarChart::drawAxisLabels() const {
         }
 
         // Position label beyond the axis endpoint
-        const float lAngle = mAxisAngles[i];
+        const Vector2 lDir = mAxisDirs[i];
         Vector2 lPos = {
-            mAxisEndpoints[i].x + cosf(lAngle) * lOffset,
-            mAxisEndpoints[i].y + sinf(lAngle) * lOffset
+            mAxisEndpoints[i].x + lDir.x * lOffset,
+            mAxisEndpoints[i].y + lDir.y * lOffset
         };
 
         // Measure text for centering
         Vector2 lTextSize;
         if (lUseDefaultFont) {
-            lTextSize.x = (float)MeasureText(rLabel.c_str(), lFontSize);
+            lTextSize.x = (float)mLabelCache.measureDefault(rLabel.c_str(), lFontSize);
             lTextSize.y = (float)lFontSize;
         } else {
-            lTextSize = MeasureTextEx(lFont, rLabel.c_str(), (float)lFontSize, 1.0f);
+            lTextSize = mLabelCache.measure(lFont, rLabel.c_str(), (float)lFontSize, 1.0f);
         }
 
         // Adjust position based on angle for better placement
@@ -449,8 +540,8 @@ void RLRadarChart::drawAxisLabels() const {
         // Bottom: center horizontally, below
         // Left: right-align
         // Right: left-align
-        const float lCosA = cosf(lAngle);
-        const float lSinA = sinf(lAngle);
+        const float lCosA = lDir.x;
+        const float lSinA = lDir.y;
 
         // Horizontal adjustment
         if (lCosA < -0.3f) {
@@ -483,7 +574,18 @@ void RLRadarChart::drawAxisLabels() const {
     }
 }
 
-void RLRadarChart::drawSeries(const SeriesDyn& rSeries) const {
+void RLRadarChart::rebuildSeriesBatch() const {
+    RLCHARTS_PERF_REBUILD(mPerf, "RLRadarChart::rebuildSeriesBatch");
+    mSeriesBatch.clear();
+    for (const auto& rSeries : mSeries) {
+        if (rSeries.mVisibility > 0.001f) {
+            addSeriesGeometry(rSeries);
+        }
+    }
+    mBatchDirty = false;
+}
+
+void RLRadarChart::addSeriesGeometry(const SeriesDyn& rSeries) const {
     computeSeriesPoints(rSeries);
 
     const size_t lAxisCount = mAxes.size();
@@ -500,38 +602,25 @@ void RLRadarChart::drawSeries(const SeriesDyn& rSeries) const {
     Color lFillColor = rSeries.mFillColor;
     lFillColor.a = static_cast<unsigned char>(static_cast<float>(lFillColor.a) * lAlpha);
 
-    // Draw filled polygon
+    // Filled polygon as a triangle fan from center (the batch fixes the winding)
     if (rSeries.mShowFill && lFillColor.a > 0) {
-        // Draw as triangle fan from center
-        // Note: DrawTriangle requires counter-clockwise vertex order
         for (size_t i = 0; i < lAxisCount; ++i) {
             const size_t lNext = (i + 1) % lAxisCount;
-            DrawTriangle(
-                mCenter,
-                rSeries.mCachedPoints[lNext],
-                rSeries.mCachedPoints[i],
-                lFillColor
-            );
+            mSeriesBatch.addTriangle(mCenter, rSeries.mCachedPoints[i], rSeries.mCachedPoints[lNext], lFillColor);
         }
     }
 
-    // Draw outline
+    // Closed outline with mitered joins
     const float lThickness = rSeries.mLineThickness;
-    for (size_t i = 0; i < lAxisCount; ++i) {
-        const size_t lNext = (i + 1) % lAxisCount;
-        DrawLineEx(
-            rSeries.mCachedPoints[i],
-            rSeries.mCachedPoints[lNext],
-            lThickness,
-            lLineColor
-        );
-    }
+    mOutlineScratch.assign(rSeries.mCachedPoints.begin(), rSeries.mCachedPoints.end());
+    mOutlineScratch.push_back(rSeries.mCachedPoints[0]);
+    mSeriesBatch.addPolyline(mOutlineScratch.data(), mOutlineScratch.size(), lThickness, lLineColor);
 
-    // Draw markers
+    // Markers
     if (rSeries.mShowMarkers) {
         const float lMarkerRadius = lThickness * rSeries.mMarkerScale;
         for (size_t i = 0; i < lAxisCount; ++i) {
-            DrawCircleV(rSeries.mCachedPoints[i], lMarkerRadius, lLineColor);
+            mSeriesBatch.addCircle(rSeries.mCachedPoints[i], lMarkerRadius, lLineColor);
         }
     }
 }
@@ -568,9 +657,9 @@ void RLRadarChart::drawLegend() const {
         // Measure text
         Vector2 lTextSize;
         if (lUseDefaultFont) {
-            lTextSize.x = (float)MeasureText(rSeries.mLabel.c_str(), lFontSize);
+            lTextSize.x = (float)mLabelCache.measureDefault(rSeries.mLabel.c_str(), lFontSize);
         } else {
-            lTextSize = MeasureTextEx(lFont, rSeries.mLabel.c_str(), (float)lFontSize, 1.0f);
+            lTextSize = mLabelCache.measure(lFont, rSeries.mLabel.c_str(), (float)lFontSize, 1.0f);
         }
 
         const float lEntryWidth = lBoxSize + lSpacing + lTextSize.x;
@@ -1,7 +1,12 @@
 // RLRadarChart.h
 #pragma once
 #include "raylib.h"
+#include "RLPerf.h"
+#include "RLLabelCache.h"
 #include "RLCommon.h"
+#include "RLLineBatch.h"
+#include "RLRenderCache.h"
+#include <span>
 #include <vector>
 #include <string>
 
@@ -91,12 +96,29 @@ public:
     void addSeries(const RLRadarSeries& rSeries);
     void setSeriesData(size_t aIndex, const std::vector<float>& rValues);
     void setSeriesData(size_t aIndex, const RLRadarSeries& rSeries);
+    // Bulk update: row i holds the values of series i (one per axis). Rows past
+    // the series count are ignored, series without a row keep their targets.
+    void setAllSeriesData(const std::vector<std::vector<float>>& rMatrix);
+    // Same from a row-major aSeriesCount x getAxisCount() block
+    void setAllSeriesData(std::span<const float> aValues, size_t aSeriesCount);
     void removeSeries(size_t aIndex);
     void clearSeries();
 
     // Per-frame update and draw
     void update(float aDt);
     void draw() const;
+    // Keep the background, grid rings and axis spokes in a render texture that is
+    // re-rendered only after setBounds()/setStyle()/setAxes(), and draw the series,
+    // labels and legend over it each frame (RLRenderCache.h). Off by default.
+    void setStaticLayerCache(bool aEnabled);
+    [[nodiscard]] const RLCharts::StaticLayer& getStaticLayer() const { return mStaticLayer; }
+
+    // Settled once every series reached its values, colors and visibility and no
+    // removed series is still fading out
+    [[nodiscard]] bool isSettled() const;
+    [[nodiscard]] bool needsRedraw() const { return mRedrawPending || !isSettled(); }
+    // update()/rebuild/draw() timers and GPU counters (RLPerf.h); zero unless built with RLCHARTS_PERF
+    [[nodiscard]] const RLCharts::PerfStats& getPerfStats() const { return mPerf; }
 
     // Getters
     [[nodiscard]] Rectangle getBounds() const { return mBounds; }
@@ -132,13 +154,14 @@ private:
     void computeSeriesPoints(const SeriesDyn& rSeries) const;
     float normalizeValue(float aValue, size_t aAxisIndex) const;
     Vector2 getPointOnAxis(size_t aAxisIndex, float aNormalizedValue) const;
+    void rebuildSeriesBatch() const;
 
     // Drawing helpers
     void drawBackground() const;
     void drawGrid() const;
     void drawAxes() const;
     void drawAxisLabels() const;
-    void drawSeries(const SeriesDyn& rSeries) const;
+    void addSeriesGeometry(const SeriesDyn& rSeries) const;
     void drawLegend() const;
 
 
@@ -148,17 +171,27 @@ private:
     std::vector<RLRadarAxis> mAxes;
     std::vector<SeriesDyn> mSeries;
     size_t mTargetSeriesCount{0};
+    mutable bool mRedrawPending{true}; // cleared by draw()
+    mutable RLCharts::PerfStats mPerf;
+    mutable RLCharts::LabelCache mLabelCache; // axis and legend label extents
+    mutable RLCharts::StaticLayer mStaticLayer; // background, grid and axes
 
     // Cached geometry (recomputed when bounds change)
     mutable bool mGeomDirty{true};
     mutable Vector2 mCenter{0, 0};
     mutable float mRadius{0.0f};
-    mutable std::vector<float> mAxisAngles;     // Precomputed angles in radians
+    mutable std::vector<Vector2> mAxisDirs;      // Unit vector of each axis
     mutable std::vector<Vector2> mAxisEndpoints; // Outer points of each axis
 
     // Global range (computed from axes when in GLOBAL mode)
     mutable float mGlobalMin{0.0f};
     mutable float mGlobalMax{100.0f};
     mutable bool mRangeDirty{true};
+
+    // Fills, outlines and markers of all series in one triangle buffer, rebuilt
+    // only when a series, the geometry or the style changed
+    mutable RLCharts::LineBatch mSeriesBatch;
+    mutable std::vector<Vector2> mOutlineScratch;
+    mutable bool mBatchDirty{true};
 };
 
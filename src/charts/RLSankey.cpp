@@ -1,9 +1,19 @@
 // RLSankey.cpp
 #include "RLSankey.h"
+#include "RLFrameArena.h"
 #include <cmath>
 #include <algorithm>
-#include <queue>
-#include <set>
+#include <chrono>
+#include <utility>
+
+namespace RLCharts {
+
+// Hit-testing: grid cell size, and how close to a ribbon sample counts as on it
+static constexpr float PICK_CELL_SIZE = 32.0f;
+static constexpr float LINK_PICK_TOLERANCE = 5.0f;
+static constexpr float LINK_PICK_TOLERANCE_X = 10.0f;
+
+} // namespace RLCharts
 
 // ============================================================================
 // Constructor
@@ -21,13 +31,21 @@ RLSankey::RLSankey(Rectangle aBounds, const RLSankeyStyle& rStyle)
 // ============================================================================
 
 void RLSankey::setBounds(Rectangle aBounds) {
+    mRedrawPending = true;
     mBounds = aBounds;
     mLayoutDirty = true;
+    mStructureDirty = true;
+    mRibbonsDirty = true;
+    mPickDirty = true;
 }
 
 void RLSankey::setStyle(const RLSankeyStyle& rStyle) {
+    mRedrawPending = true;
     mStyle = rStyle;
     mLayoutDirty = true;
+    mStructureDirty = true;
+    mRibbonsDirty = true;
+    mPickDirty = true;
 }
 
 // ============================================================================
@@ -35,6 +53,7 @@ void RLSankey::setStyle(const RLSankeyStyle& rStyle) {
 // ============================================================================
 
 size_t RLSankey::addNode(const std::string& rLabel, Color aColor, int aColumn) {
+    mRedrawPending = true;
     RLSankeyNode lNode;
     lNode.mLabel = rLabel;
     lNode.mColor = aColor;
@@ -43,6 +62,7 @@ size_t RLSankey::addNode(const std::string& rLabel, Color aColor, int aColumn) {
 }
 
 size_t RLSankey::addNode(const RLSankeyNode& rNode) {
+    mRedrawPending = true;
     NodeDyn lDyn;
     lDyn.mLabel = rNode.mLabel;
     lDyn.mColor = rNode.mColor;
@@ -54,6 +74,9 @@ size_t RLSankey::addNode(const RLSankeyNode& rNode) {
 
     mNodes.push_back(lDyn);
     mLayoutDirty = true;
+    mStructureDirty = true;
+    mRibbonsDirty = true;
+    mPickDirty = true;
     return mNodes.size() - 1;
 }
 
@@ -61,6 +84,7 @@ void RLSankey::setNodeColor(size_t aNodeId, Color aColor) {
     if (aNodeId >= mNodes.size()) {
         return;
     }
+    mRedrawPending = true;
     mNodes[aNodeId].mColorTarget = aColor;
 }
 
@@ -68,19 +92,27 @@ void RLSankey::setNodeColumn(size_t aNodeId, int aColumn) {
     if (aNodeId >= mNodes.size()) {
         return;
     }
+    mRedrawPending = true;
     mNodes[aNodeId].mColumn = aColumn;
     mLayoutDirty = true;
+    mStructureDirty = true;
+    mRibbonsDirty = true;
+    mPickDirty = true;
 }
 
 void RLSankey::removeNode(size_t aNodeId) {
     if (aNodeId >= mNodes.size()) {
         return;
     }
+    mRedrawPending = true;
 
     // Mark node for removal
     mNodes[aNodeId].mVisibilityTarget = 0.0f;
     mNodes[aNodeId].mPendingRemoval = true;
     mNodes[aNodeId].mHeightTarget = 0.0f;
+    mStructureDirty = true;
+    mRibbonsDirty = true;
+    mPickDirty = true;
 
     // Also remove all links connected to this node
     for (auto& rLink : mLinks) {
@@ -98,6 +130,7 @@ void RLSankey::removeNode(size_t aNodeId) {
 // ============================================================================
 
 size_t RLSankey::addLink(size_t aSourceId, size_t aTargetId, float aValue, Color aColor) {
+    mRedrawPending = true;
     RLSankeyLink lLink;
     lLink.mSourceId = aSourceId;
     lLink.mTargetId = aTargetId;
@@ -107,6 +140,7 @@ size_t RLSankey::addLink(size_t aSourceId, size_t aTargetId, float aValue, Color
 }
 
 size_t RLSankey::addLink(const RLSankeyLink& rLink) {
+    mRedrawPending = true;
     LinkDyn lDyn;
     lDyn.mSourceId = rLink.mSourceId;
     lDyn.mTargetId = rLink.mTargetId;
@@ -121,6 +155,9 @@ size_t RLSankey::addLink(const RLSankeyLink& rLink) {
 
     mLinks.push_back(lDyn);
     mLayoutDirty = true;
+    mStructureDirty = true;
+    mRibbonsDirty = true;
+    mPickDirty = true;
     return mLinks.size() - 1;
 }
 
@@ -128,8 +165,9 @@ void RLSankey::setLinkValue(size_t aLinkId, float aValue) {
     if (aLinkId >= mLinks.size()) {
         return;
     }
+    mRedrawPending = true;
     mLinks[aLinkId].mValueTarget = aValue;
-    mLinks[aLinkId].mCacheDirty = true;
+    mDirtyLinks.push_back(aLinkId);
     mLayoutDirty = true;
 }
 
@@ -137,6 +175,7 @@ void RLSankey::setLinkColor(size_t aLinkId, Color aColor) {
     if (aLinkId >= mLinks.size()) {
         return;
     }
+    mRedrawPending = true;
     mLinks[aLinkId].mColorTarget = aColor;
 }
 
@@ -144,12 +183,16 @@ void RLSankey::removeLink(size_t aLinkId) {
     if (aLinkId >= mLinks.size()) {
         return;
     }
+    mRedrawPending = true;
 
     mLinks[aLinkId].mVisibilityTarget = 0.0f;
     mLinks[aLinkId].mPendingRemoval = true;
     mLinks[aLinkId].mSourceThicknessTarget = 0.0f;
     mLinks[aLinkId].mTargetThicknessTarget = 0.0f;
     mLinks[aLinkId].mValueTarget = 0.0f;
+    mStructureDirty = true;
+    mRibbonsDirty = true;
+    mPickDirty = true;
 }
 
 // ============================================================================
@@ -157,6 +200,7 @@ void RLSankey::removeLink(size_t aLinkId) {
 // ============================================================================
 
 bool RLSankey::setData(const std::vector<RLSankeyNode>& rNodes, const std::vector<RLSankeyLink>& rLinks) {
+    mRedrawPending = true;
     clear();
 
     for (const auto& rNode : rNodes) {
@@ -175,9 +219,14 @@ bool RLSankey::setData(const std::vector<RLSankeyNode>& rNodes, const std::vecto
 }
 
 void RLSankey::clear() {
+    mRedrawPending = true;
     mNodes.clear();
     mLinks.clear();
     mLayoutDirty = true;
+    mStructureDirty = true;
+    mRibbonsDirty = true;
+    mPickDirty = true;
+    mDirtyLinks.clear();
     mColumnCount = 0;
 }
 
@@ -223,7 +272,40 @@ bool RLSankey::hasPendingRemovals() const {
 // Update (Animation)
 // ============================================================================
 
+bool RLSankey::isSettled() const {
+    if (mLayoutDirty || hasPendingRemovals()) {
+        return false;
+    }
+    for (const auto& rNode : mNodes) {
+        if (!RLCharts::nearlyEqual(rNode.mY, rNode.mYTarget) ||
+            !RLCharts::nearlyEqual(rNode.mHeight, rNode.mHeightTarget) ||
+            !RLCharts::nearlyEqual(rNode.mVisibility, rNode.mVisibilityTarget) ||
+            !RLCharts::colorEquals(rNode.mColor, rNode.mColorTarget)) {
+            return false;
+        }
+    }
+    for (const auto& rLink : mLinks) {
+        if (!RLCharts::nearlyEqual(rLink.mValue, rLink.mValueTarget) ||
+            !RLCharts::nearlyEqual(rLink.mSourceThickness, rLink.mSourceThicknessTarget) ||
+            !RLCharts::nearlyEqual(rLink.mTargetThickness, rLink.mTargetThicknessTarget) ||
+            !RLCharts::nearlyEqual(rLink.mSourceY, rLink.mSourceYTarget) ||
+            !RLCharts::nearlyEqual(rLink.mTargetY, rLink.mTargetYTarget) ||
+            !RLCharts::nearlyEqual(rLink.mVisibility, rLink.mVisibilityTarget) ||
+            !RLCharts::colorEquals(rLink.mColor, rLink.mColorTarget)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 void RLSankey::update(float aDt) {
+    RLCHARTS_PERF_UPDATE(mPerf, "RLSankey::update");
+    if (isSettled()) {
+        return;
+    }
+    mRedrawPending = true;
+    mPickDirty = true;
+
     // Recompute layout if dirty
     if (mLayoutDirty) {
         computeLayout();
@@ -246,7 +328,6 @@ void RLSankey::update(float aDt) {
             rLink.mTargetY = rLink.mTargetYTarget;
             rLink.mColor = rLink.mColorTarget;
             rLink.mVisibility = rLink.mVisibilityTarget;
-            rLink.mCacheDirty = true;
         }
     } else {
         const float lValueSpeed = mStyle.mAnimateSpeed * aDt;
@@ -256,34 +337,26 @@ void RLSankey::update(float aDt) {
         for (auto& rNode : mNodes) {
             rNode.mY = RLCharts::approach(rNode.mY, rNode.mYTarget, lValueSpeed);
             rNode.mHeight = RLCharts::approach(rNode.mHeight, rNode.mHeightTarget, lValueSpeed);
-            rNode.mColor = RLCharts::lerpColor(rNode.mColor, rNode.mColorTarget, lValueSpeed);
+            rNode.mColor = RLCharts::approachColor(rNode.mColor, rNode.mColorTarget, lValueSpeed);
             rNode.mVisibility = RLCharts::approach(rNode.mVisibility, rNode.mVisibilityTarget, lFadeSpeed);
         }
 
         // Animate links
         for (auto& rLink : mLinks) {
-            const float lOldValue = rLink.mValue;
-            const float lOldSourceThickness = rLink.mSourceThickness;
-            const float lOldTargetThickness = rLink.mTargetThickness;
             rLink.mValue = RLCharts::approach(rLink.mValue, rLink.mValueTarget, lValueSpeed);
             rLink.mSourceThickness = RLCharts::approach(rLink.mSourceThickness, rLink.mSourceThicknessTarget, lValueSpeed);
             rLink.mTargetThickness = RLCharts::approach(rLink.mTargetThickness, rLink.mTargetThicknessTarget, lValueSpeed);
             rLink.mSourceY = RLCharts::approach(rLink.mSourceY, rLink.mSourceYTarget, lValueSpeed);
             rLink.mTargetY = RLCharts::approach(rLink.mTargetY, rLink.mTargetYTarget, lValueSpeed);
-            rLink.mColor = RLCharts::lerpColor(rLink.mColor, rLink.mColorTarget, lValueSpeed);
+            rLink.mColor = RLCharts::approachColor(rLink.mColor, rLink.mColorTarget, lValueSpeed);
             rLink.mVisibility = RLCharts::approach(rLink.mVisibility, rLink.mVisibilityTarget, lFadeSpeed);
-
-            if (rLink.mValue != lOldValue ||
-                rLink.mSourceThickness != lOldSourceThickness ||
-                rLink.mTargetThickness != lOldTargetThickness) {
-                rLink.mCacheDirty = true;
-            }
         }
     }
 
     // Remove fully faded-out nodes and update link indices
     // Build a mapping from old indices to new indices
-    std::vector<size_t> lIndexMap(mNodes.size());
+    RLCharts::FrameScratch lScratch;
+    std::pmr::vector<size_t> lIndexMap(mNodes.size(), lScratch.resource());
     size_t lNewIndex = 0;
     for (size_t i = 0; i < mNodes.size(); ++i) {
         if (mNodes[i].mPendingRemoval && mNodes[i].mVisibility < 0.001f) {
@@ -305,6 +378,8 @@ void RLSankey::update(float aDt) {
     }
 
     // Now remove the nodes
+    const size_t lNodesBefore = mNodes.size();
+    const size_t lLinksBefore = mLinks.size();
     mNodes.erase(
         std::remove_if(mNodes.begin(), mNodes.end(),
             [](const NodeDyn& rN) {
@@ -321,6 +396,13 @@ void RLSankey::update(float aDt) {
             }),
         mLinks.end()
     );
+    if (mNodes.size() != lNodesBefore || mLinks.size() != lLinksBefore) {
+        // Ids moved: the per-node link lists (and queued link ids) are stale
+        mStructureDirty = true;
+        mRibbonsDirty = true;
+        mPickDirty = true;
+        mDirtyLinks.clear();
+    }
 }
 
 // ============================================================================
@@ -328,6 +410,8 @@ void RLSankey::update(float aDt) {
 // ============================================================================
 
 void RLSankey::draw() const {
+    RLCHARTS_PERF_DRAW(mPerf, "RLSankey::draw");
+    mRedrawPending = false;
     drawBackground();
     drawLinks();
     drawNodes();
@@ -339,7 +423,9 @@ void RLSankey::draw() const {
 // ============================================================================
 
 void RLSankey::computeLayout() {
+    RLCHARTS_PERF_REBUILD(mPerf, "RLSankey::computeLayout");
     if (mNodes.empty()) {
+        mDirtyLinks.clear();
         return;
     }
 
@@ -349,14 +435,85 @@ void RLSankey::computeLayout() {
     mChartWidth = mBounds.width - 2.0f * mStyle.mPadding;
     mChartHeight = mBounds.height - 2.0f * mStyle.mPadding;
 
-    // Assign columns to nodes
-    assignColumns();
+    // Fading links change which links take part, so only plain value changes
+    // take the incremental path
+    const bool lIncremental = !mStructureDirty && !hasPendingRemovals();
+    if (!lIncremental) {
+        buildLinkIndex();
+        assignColumns();
+        buildColumns();
+        if (mStyle.mOrderNodes) {
+            orderColumns();
+        }
+    }
+    computeFlows();
+    const float lOldScale = mValueToPixelScale;
+    computeScale();
 
-    // Compute node positions
-    computeNodePositions();
+    if (!lIncremental || mValueToPixelScale != lOldScale) {
+        for (int col = 0; col < mColumnCount; ++col) {
+            positionColumn(col);
+        }
+        for (size_t i = 0; i < mNodes.size(); ++i) {
+            positionNodeLinks(i);
+        }
+    } else {
+        // Same scale: only the columns holding an endpoint of a changed link move,
+        // and only those endpoints' link bands change
+        mNodeMarks.assign(mNodes.size(), 0);
+        mColumnMarks.assign((size_t)mColumnCount, 0);
+        for (const size_t lLinkId : mDirtyLinks) {
+            const LinkDyn& rLink = mLinks[lLinkId];
+            for (const size_t lNodeId : {rLink.mSourceId, rLink.mTargetId}) {
+                if (lNodeId < mNodes.size() && mNodes[lNodeId].mColumn >= 0 && mNodes[lNodeId].mColumn < mColumnCount) {
+                    mNodeMarks[lNodeId] = 1;
+                    mColumnMarks[(size_t)mNodes[lNodeId].mColumn] = 1;
+                }
+            }
+        }
+        for (int col = 0; col < mColumnCount; ++col) {
+            if (mColumnMarks[(size_t)col] != 0) {
+                positionColumn(col);
+            }
+        }
+        for (size_t i = 0; i < mNodes.size(); ++i) {
+            if (mNodeMarks[i] != 0) {
+                positionNodeLinks(i);
+            }
+        }
+    }
+    mStructureDirty = false;
+    mDirtyLinks.clear();
+}
 
-    // Compute link positions
-    computeLinkPositions();
+void RLSankey::buildLinkIndex() {
+    // Outgoing and incoming links per node; the counting sort keeps link order
+    // (bands stack in link order)
+    const size_t lNodeCount = mNodes.size();
+    mOutOffsets.assign(lNodeCount + 1, 0);
+    mInOffsets.assign(lNodeCount + 1, 0);
+    for (const auto& rLink : mLinks) {
+        if (rLink.mSourceId < lNodeCount && rLink.mTargetId < lNodeCount) {
+            mOutOffsets[rLink.mSourceId + 1]++;
+            mInOffsets[rLink.mTargetId + 1]++;
+        }
+    }
+    for (size_t i = 0; i < lNodeCount; ++i) {
+        mOutOffsets[i + 1] += mOutOffsets[i];
+        mInOffsets[i + 1] += mInOffsets[i];
+    }
+    mOutLinks.resize(mOutOffsets[lNodeCount]);
+    mInLinks.resize(mInOffsets[lNodeCount]);
+    RLCharts::FrameScratch lScratch;
+    std::pmr::vector<size_t> lOutCursor(mOutOffsets.begin(), mOutOffsets.end() - 1, lScratch.resource());
+    std::pmr::vector<size_t> lInCursor(mInOffsets.begin(), mInOffsets.end() - 1, lScratch.resource());
+    for (size_t i = 0; i < mLinks.size(); ++i) {
+        const LinkDyn& rLink = mLinks[i];
+        if (rLink.mSourceId < lNodeCount && rLink.mTargetId < lNodeCount) {
+            mOutLinks[lOutCursor[rLink.mSourceId]++] = i;
+            mInLinks[lInCursor[rLink.mTargetId]++] = i;
+        }
+    }
 }
 
 void RLSankey::assignColumns() {
@@ -380,74 +537,49 @@ void RLSankey::assignColumns() {
         return;
     }
 
-    // Auto-assign columns using topological ordering based on links
-    // Nodes with no incoming links go to column 0
-    // Each node goes to max(source columns) + 1
-
+    // Auto-assign columns in topological order (Kahn): nodes with no incoming
+    // links go to column 0, every other node to max(source columns) + 1 once all
+    // its sources are placed. Explicit columns are kept and passed on. Nodes on a
+    // cycle (or fed by a removed node) are never reached and fall back to 0.
     const size_t lNodeCount = mNodes.size();
-    std::vector<int> lComputedColumn(lNodeCount, -1);
-    std::vector<std::set<size_t>> lIncoming(lNodeCount);
+    RLCharts::FrameScratch lScratch;
+    std::pmr::vector<int> lComputedColumn(lNodeCount, -1, lScratch.resource());
+    std::pmr::vector<size_t> lWaiting(lNodeCount, 0, lScratch.resource()); // live incoming links not yet placed
+    std::pmr::vector<int> lMaxSrcCol(lNodeCount, -1, lScratch.resource());
+    for (size_t i = 0; i < lNodeCount; ++i) {
+        for (size_t c = mInOffsets[i]; c < mInOffsets[i + 1]; ++c) {
+            if (!mLinks[mInLinks[c]].mPendingRemoval) {
+                lWaiting[i]++;
+            }
+        }
+    }
 
-    // Build incoming link sets
-    for (const auto& rLink : mLinks) {
-        if (rLink.mPendingRemoval) {
+    std::pmr::vector<size_t> lQueue(lScratch.resource());
+    lQueue.reserve(lNodeCount);
+    for (size_t i = 0; i < lNodeCount; ++i) {
+        if (mNodes[i].mPendingRemoval) {
             continue;
         }
-        if (rLink.mSourceId < lNodeCount && rLink.mTargetId < lNodeCount) {
-            lIncoming[rLink.mTargetId].insert(rLink.mSourceId);
+        if (mNodes[i].mColumn >= 0) {
+            lComputedColumn[i] = mNodes[i].mColumn;
+            lQueue.push_back(i);
+        } else if (lWaiting[i] == 0) {
+            lComputedColumn[i] = 0;
+            lQueue.push_back(i);
         }
     }
-
-    // Process nodes iteratively
-    bool lChanged = true;
-    int lIterations = 0;
-    const int lMaxIter = (int)lNodeCount + 10;
-
-    while (lChanged && lIterations < lMaxIter) {
-        lChanged = false;
-        lIterations++;
-
-        for (size_t i = 0; i < lNodeCount; ++i) {
-            if (mNodes[i].mPendingRemoval) {
+    for (size_t q = 0; q < lQueue.size(); ++q) {
+        const size_t lNode = lQueue[q];
+        for (size_t c = mOutOffsets[lNode]; c < mOutOffsets[lNode + 1]; ++c) {
+            const LinkDyn& rLink = mLinks[mOutLinks[c]];
+            if (rLink.mPendingRemoval) {
                 continue;
             }
-
-            // If node has explicit column, use it
-            if (mNodes[i].mColumn >= 0) {
-                if (lComputedColumn[i] != mNodes[i].mColumn) {
-                    lComputedColumn[i] = mNodes[i].mColumn;
-                    lChanged = true;
-                }
-                continue;
-            }
-
-            // If no incoming links, column 0
-            if (lIncoming[i].empty()) {
-                if (lComputedColumn[i] != 0) {
-                    lComputedColumn[i] = 0;
-                    lChanged = true;
-                }
-                continue;
-            }
-
-            // Find max column of all sources
-            int lMaxSrcCol = -1;
-            bool lAllSourcesAssigned = true;
-
-            for (const size_t lSrcId : lIncoming[i]) {
-                if (lComputedColumn[lSrcId] < 0) {
-                    lAllSourcesAssigned = false;
-                    break;
-                }
-                lMaxSrcCol = (lComputedColumn[lSrcId] > lMaxSrcCol) ? lComputedColumn[lSrcId] : lMaxSrcCol;
-            }
-
-            if (lAllSourcesAssigned) {
-                const int lNewCol = lMaxSrcCol + 1;
-                if (lComputedColumn[i] != lNewCol) {
-                    lComputedColumn[i] = lNewCol;
-                    lChanged = true;
-                }
+            const size_t lTarget = rLink.mTargetId;
+            lMaxSrcCol[lTarget] = std::max(lMaxSrcCol[lTarget], lComputedColumn[lNode]);
+            if (--lWaiting[lTarget] == 0 && lComputedColumn[lTarget] < 0 && !mNodes[lTarget].mPendingRemoval) {
+                lComputedColumn[lTarget] = lMaxSrcCol[lTarget] + 1;
+                lQueue.push_back(lTarget);
             }
         }
     }
@@ -467,38 +599,144 @@ void RLSankey::assignColumns() {
     }
 }
 
-void RLSankey::computeNodePositions() {
-    if (mColumnCount == 0) {
-        return;
-    }
-
-    // Group nodes by column
-    std::vector<std::vector<size_t>> lColumnNodes(mColumnCount);
+void RLSankey::buildColumns() {
+    // Column membership (live nodes, in id order)
+    mColumnNodes.assign((size_t)mColumnCount, {});
     for (size_t i = 0; i < mNodes.size(); ++i) {
         if (mNodes[i].mPendingRemoval) {
             continue;
         }
         const int lCol = mNodes[i].mColumn;
         if (lCol >= 0 && lCol < mColumnCount) {
-            lColumnNodes[lCol].push_back(i);
+            mColumnNodes[(size_t)lCol].push_back(i);
+        }
+    }
+}
+
+void RLSankey::orderColumns() {
+    // Iterative weighted barycenter: each sweep sorts a column by the mean
+    // position of its neighbours in the columns already placed (downward sweep:
+    // sources, upward sweep: targets), weighted by link value. Ranks are
+    // normalized to 0..1 so links that skip columns compare fairly.
+    const auto lStart = std::chrono::steady_clock::now();
+    mNodeRank.assign(mNodes.size(), 0.5f);
+    const auto lRankColumn = [this](size_t aColumn) {
+        const std::vector<size_t>& rColumn = mColumnNodes[aColumn];
+        for (size_t k = 0; k < rColumn.size(); ++k) {
+            mNodeRank[rColumn[k]] = ((float)k + 0.5f) / (float)rColumn.size();
         }
+    };
+    for (size_t col = 0; col < mColumnNodes.size(); ++col) {
+        lRankColumn(col);
     }
 
+    std::vector<std::pair<float, size_t>> lKeys;
+    const auto lSortColumn = [&](size_t aColumn, bool aBySources) {
+        std::vector<size_t>& rColumn = mColumnNodes[aColumn];
+        lKeys.clear();
+        for (const size_t lNode : rColumn) {
+            const std::vector<size_t>& rOffsets = aBySources ? mInOffsets : mOutOffsets;
+            const std::vector<size_t>& rLinks = aBySources ? mInLinks : mOutLinks;
+            float lSum = 0.0f;
+            float lWeight = 0.0f;
+            for (size_t c = rOffsets[lNode]; c < rOffsets[lNode + 1]; ++c) {
+                const LinkDyn& rLink = mLinks[rLinks[c]];
+                const size_t lOther = aBySources ? rLink.mSourceId : rLink.mTargetId;
+                const int lOtherCol = mNodes[lOther].mColumn;
+                // Only neighbours on the side the sweep comes from
+                if (rLink.mPendingRemoval || (aBySources ? lOtherCol >= (int)aColumn : lOtherCol <= (int)aColumn)) {
+                    continue;
+                }
+                const float lW = std::max(rLink.mValueTarget, 0.001f);
+                lSum += mNodeRank[lOther] * lW;
+                lWeight += lW;
+            }
+            // Unconnected nodes keep their place
+            lKeys.emplace_back(lWeight > 0.0f ? lSum / lWeight : mNodeRank[lNode], lNode);
+        }
+        std::stable_sort(lKeys.begin(), lKeys.end(),
+                         [](const std::pair<float, size_t>& a, const std::pair<float, size_t>& b) {
+                             return a.first < b.first;
+                         });
+        for (size_t k = 0; k < lKeys.size(); ++k) {
+            rColumn[k] = lKeys[k].second;
+        }
+        lRankColumn(aColumn);
+    };
+
+    const size_t lColumns = mColumnNodes.size();
+    for (int lIter = 0; lIter < mStyle.mOrderIterations && lColumns > 1; ++lIter) {
+        for (size_t col = 1; col < lColumns; ++col) {
+            lSortColumn(col, true);
+        }
+        for (size_t col = lColumns - 1; col-- > 0;) {
+            lSortColumn(col, false);
+        }
+        const float lElapsedMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - lStart).count();
+        if (mStyle.mOrderTimeBudgetMs > 0.0f && lElapsedMs >= mStyle.mOrderTimeBudgetMs) {
+            break;
+        }
+    }
+    sortLinksByRank();
+}
+
+void RLSankey::sortLinksByRank() {
+    // Stack each node's bands in the order of the nodes they lead to, so bands
+    // leaving one node do not cross each other
+    const auto lSortRange = [this](std::vector<size_t>& rLinks, size_t aBegin, size_t aEnd, bool aByTarget) {
+        std::stable_sort(rLinks.begin() + (std::ptrdiff_t)aBegin, rLinks.begin() + (std::ptrdiff_t)aEnd,
+                         [this, aByTarget](size_t a, size_t b) {
+                             const size_t lA = aByTarget ? mLinks[a].mTargetId : mLinks[a].mSourceId;
+                             const size_t lB = aByTarget ? mLinks[b].mTargetId : mLinks[b].mSourceId;
+                             if (mNodes[lA].mColumn != mNodes[lB].mColumn) {
+                                 return mNodes[lA].mColumn < mNodes[lB].mColumn;
+                             }
+                             return mNodeRank[lA] < mNodeRank[lB];
+                         });
+    };
+    for (size_t i = 0; i < mNodes.size(); ++i) {
+        lSortRange(mOutLinks, mOutOffsets[i], mOutOffsets[i + 1], true);
+        lSortRange(mInLinks, mInOffsets[i], mInOffsets[i + 1], false);
+    }
+}
+
+void RLSankey::computeFlows() {
+    // computeTotalFlow() for every node in one pass over the links
+    mInflow.assign(mNodes.size(), 0.0f);
+    mOutflow.assign(mNodes.size(), 0.0f);
+    for (const auto& rLink : mLinks) {
+        if (rLink.mPendingRemoval) {
+            continue;
+        }
+        if (rLink.mSourceId < mNodes.size()) {
+            mOutflow[rLink.mSourceId] += rLink.mValueTarget;
+        }
+        if (rLink.mTargetId < mNodes.size()) {
+            mInflow[rLink.mTargetId] += rLink.mValueTarget;
+        }
+    }
+}
+
+namespace RLCharts {
+
+// Flow a node is sized by (isolated nodes get a minimum)
+static float nodeFlow(float aIn, float aOut) {
+    const float lNodeFlow = (aIn > aOut) ? aIn : aOut;
+    return lNodeFlow < 0.001f ? 1.0f : lNodeFlow;
+}
+
+} // namespace RLCharts
+
+void RLSankey::computeScale() {
     // Calculate total flow for height scaling
     float lMaxColumnFlow = 0.0f;
-    for (int col = 0; col < mColumnCount; ++col) {
+    for (const auto& rColumn : mColumnNodes) {
         float lColumnFlow = 0.0f;
-        for (const size_t lNodeId : lColumnNodes[col]) {
-            const float lIn = computeTotalFlow(lNodeId, false);
-            const float lOut = computeTotalFlow(lNodeId, true);
-            float lNodeFlow = (lIn > lOut) ? lIn : lOut;
-            if (lNodeFlow < 0.001f) {
-                lNodeFlow = 1.0f; // Minimum for isolated nodes
-            }
-            lColumnFlow += lNodeFlow;
+        for (const size_t lNodeId : rColumn) {
+            lColumnFlow += RLCharts::nodeFlow(mInflow[lNodeId], mOutflow[lNodeId]);
         }
         // Add padding between nodes
-        const float lPaddingTotal = mStyle.mNodePadding * (float)(lColumnNodes[col].size() > 0 ? lColumnNodes[col].size() - 1 : 0);
+        const float lPaddingTotal = mStyle.mNodePadding * (float)(rColumn.size() > 0 ? rColumn.size() - 1 : 0);
         lColumnFlow += lPaddingTotal;
 
         lMaxColumnFlow = std::max(lColumnFlow, lMaxColumnFlow);
@@ -510,130 +748,88 @@ void RLSankey::computeNodePositions() {
     } else {
         mValueToPixelScale = 1.0f;
     }
+}
 
-    // Position nodes in each column
-    for (int col = 0; col < mColumnCount; ++col) {
-
-        // Calculate the total height for this column to center it
-        float lTotalHeight = 0.0f;
-        for (const size_t lNodeId : lColumnNodes[col]) {
-            const float lIn = computeTotalFlow(lNodeId, false);
-            const float lOut = computeTotalFlow(lNodeId, true);
-            float lNodeFlow = (lIn > lOut) ? lIn : lOut;
-            if (lNodeFlow < 0.001f) {
-                lNodeFlow = 1.0f;
-            }
-            lTotalHeight += lNodeFlow * mValueToPixelScale;
-        }
-        lTotalHeight += mStyle.mNodePadding * (float)(lColumnNodes[col].size() > 0 ? lColumnNodes[col].size() - 1 : 0);
-
-        // Center column vertically
-        float lY = mChartTop + (mChartHeight - lTotalHeight) * 0.5f;
-
-        for (const size_t lNodeId : lColumnNodes[col]) {
-            NodeDyn& rNode = mNodes[lNodeId];
+void RLSankey::positionColumn(int aColumn) {
+    const std::vector<size_t>& rColumn = mColumnNodes[(size_t)aColumn];
 
-            const float lIn = computeTotalFlow(lNodeId, false);
-            const float lOut = computeTotalFlow(lNodeId, true);
-            float lNodeFlow = (lIn > lOut) ? lIn : lOut;
-            if (lNodeFlow < 0.001f) {
-                lNodeFlow = 1.0f;
-            }
+    // Calculate the total height for this column to center it
+    float lTotalHeight = 0.0f;
+    for (const size_t lNodeId : rColumn) {
+        lTotalHeight += RLCharts::nodeFlow(mInflow[lNodeId], mOutflow[lNodeId]) * mValueToPixelScale;
+    }
+    lTotalHeight += mStyle.mNodePadding * (float)(rColumn.size() > 0 ? rColumn.size() - 1 : 0);
 
-            const float lHeight = lNodeFlow * mValueToPixelScale;
+    // Center column vertically
+    float lY = mChartTop + (mChartHeight - lTotalHeight) * 0.5f;
 
-            rNode.mYTarget = lY;
-            rNode.mHeightTarget = lHeight;
+    for (const size_t lNodeId : rColumn) {
+        NodeDyn& rNode = mNodes[lNodeId];
+        const float lHeight = RLCharts::nodeFlow(mInflow[lNodeId], mOutflow[lNodeId]) * mValueToPixelScale;
 
-            // Initialize current values if new
-            if (rNode.mVisibility < 0.01f && !rNode.mPendingRemoval) {
-                rNode.mY = lY;
-                rNode.mHeight = 0.0f; // Start with zero height, grow
-            }
+        rNode.mYTarget = lY;
+        rNode.mHeightTarget = lHeight;
 
-            lY += lHeight + mStyle.mNodePadding;
+        // Initialize current values if new
+        if (rNode.mVisibility < 0.01f && !rNode.mPendingRemoval) {
+            rNode.mY = lY;
+            rNode.mHeight = 0.0f; // Start with zero height, grow
         }
+
+        lY += lHeight + mStyle.mNodePadding;
     }
 }
 
-void RLSankey::computeLinkPositions() {
-    // Reset node flow offsets
-    for (auto& rNode : mNodes) {
-        rNode.mOutflowOffset = 0.0f;
-        rNode.mInflowOffset = 0.0f;
+void RLSankey::positionNodeLinks(size_t aNodeId) {
+    // A link's source side depends only on its source node and its target side
+    // only on its target, so each node stacks its own band ends
+    NodeDyn& rNode = mNodes[aNodeId];
+    const bool lNormalized = mStyle.mFlowMode == RLSankeyFlowMode::NORMALIZED && !rNode.mPendingRemoval;
+
+    // Scale factors to make bands fill the node height (NORMALIZED mode)
+    float lOutflowScale = 1.0f;
+    float lInflowScale = 1.0f;
+    if (lNormalized && mOutflow[aNodeId] > 0.001f) {
+        lOutflowScale = rNode.mHeightTarget / (mOutflow[aNodeId] * mValueToPixelScale);
     }
-
-    // Pre-compute per-node scale factors for NORMALIZED mode
-    std::vector<float> lOutflowScale(mNodes.size(), 1.0f);
-    std::vector<float> lInflowScale(mNodes.size(), 1.0f);
-
-    if (mStyle.mFlowMode == RLSankeyFlowMode::NORMALIZED) {
-        for (size_t i = 0; i < mNodes.size(); ++i) {
-            if (mNodes[i].mPendingRemoval) {
-                continue;
-            }
-
-            const float lInflow = computeTotalFlow(i, false);
-            const float lOutflow = computeTotalFlow(i, true);
-            const float lNodeHeight = mNodes[i].mHeightTarget;
-
-            // Scale factors to make bands fill the node height
-            if (lOutflow > 0.001f) {
-                lOutflowScale[i] = lNodeHeight / (lOutflow * mValueToPixelScale);
-            }
-            if (lInflow > 0.001f) {
-                lInflowScale[i] = lNodeHeight / (lInflow * mValueToPixelScale);
-            }
-        }
+    if (lNormalized && mInflow[aNodeId] > 0.001f) {
+        lInflowScale = rNode.mHeightTarget / (mInflow[aNodeId] * mValueToPixelScale);
     }
 
-    // Compute link positions
-    for (size_t i = 0; i < mLinks.size(); ++i) {
-        LinkDyn& rLink = mLinks[i];
+    rNode.mOutflowOffset = 0.0f;
+    for (size_t c = mOutOffsets[aNodeId]; c < mOutOffsets[aNodeId + 1]; ++c) {
+        LinkDyn& rLink = mLinks[mOutLinks[c]];
         if (rLink.mPendingRemoval && rLink.mVisibility < 0.01f) {
             continue;
         }
-
-        if (rLink.mSourceId >= mNodes.size() || rLink.mTargetId >= mNodes.size()) {
-            continue;
-        }
-
-        NodeDyn& rSource = mNodes[rLink.mSourceId];
-        NodeDyn& rTarget = mNodes[rLink.mTargetId];
-
         // Base link thickness from value
-        float lBaseThickness = rLink.mValueTarget * mValueToPixelScale;
-        lBaseThickness = std::max(lBaseThickness, mStyle.mMinLinkThickness);
+        const float lBaseThickness = std::max(rLink.mValueTarget * mValueToPixelScale, mStyle.mMinLinkThickness);
+        rLink.mSourceThicknessTarget = lBaseThickness * lOutflowScale;
+        rLink.mSourceYTarget = rNode.mOutflowOffset;
+        rNode.mOutflowOffset += rLink.mSourceThicknessTarget;
 
-        // Compute source and target thicknesses based on flow mode
-        float lSourceThickness = lBaseThickness;
-        float lTargetThickness = lBaseThickness;
-
-        if (mStyle.mFlowMode == RLSankeyFlowMode::NORMALIZED) {
-            lSourceThickness = lBaseThickness * lOutflowScale[rLink.mSourceId];
-            lTargetThickness = lBaseThickness * lInflowScale[rLink.mTargetId];
+        // Initialize current values if new
+        if (rLink.mVisibility < 0.01f && !rLink.mPendingRemoval) {
+            rLink.mSourceY = rLink.mSourceYTarget;
+            rLink.mSourceThickness = 0.0f; // Start thin, grow
         }
+    }
 
-        rLink.mSourceThicknessTarget = lSourceThickness;
-        rLink.mTargetThicknessTarget = lTargetThickness;
-
-        // Source Y offset (within source node)
-        rLink.mSourceYTarget = rSource.mOutflowOffset;
-        rSource.mOutflowOffset += lSourceThickness;
-
-        // Target Y offset (within target node)
-        rLink.mTargetYTarget = rTarget.mInflowOffset;
-        rTarget.mInflowOffset += lTargetThickness;
+    rNode.mInflowOffset = 0.0f;
+    for (size_t c = mInOffsets[aNodeId]; c < mInOffsets[aNodeId + 1]; ++c) {
+        LinkDyn& rLink = mLinks[mInLinks[c]];
+        if (rLink.mPendingRemoval && rLink.mVisibility < 0.01f) {
+            continue;
+        }
+        const float lBaseThickness = std::max(rLink.mValueTarget * mValueToPixelScale, mStyle.mMinLinkThickness);
+        rLink.mTargetThicknessTarget = lBaseThickness * lInflowScale;
+        rLink.mTargetYTarget = rNode.mInflowOffset;
+        rNode.mInflowOffset += rLink.mTargetThicknessTarget;
 
-        // Initialize current values if new
         if (rLink.mVisibility < 0.01f && !rLink.mPendingRemoval) {
-            rLink.mSourceY = rLink.mSourceYTarget;
             rLink.mTargetY = rLink.mTargetYTarget;
-            rLink.mSourceThickness = 0.0f; // Start thin, grow
             rLink.mTargetThickness = 0.0f;
         }
-
-        rLink.mCacheDirty = true;
     }
 }
 
@@ -719,11 +915,59 @@ void RLSankey::drawBackground() const {
 }
 
 void RLSankey::drawLinks() const {
-    for (const auto& rLink : mLinks) {
-        if (rLink.mVisibility > 0.001f) {
-            drawLink(rLink);
+    if (!mStyle.mBatchLinks) {
+        for (size_t i = 0; i < mLinks.size(); ++i) {
+            const LinkDyn& rLink = mLinks[i];
+            if (rLink.mVisibility > 0.001f && rLink.mSourceId < mNodes.size() && rLink.mTargetId < mNodes.size()) {
+                computeLinkCurve(rLink);
+                drawLink(rLink, i);
+            }
+        }
+        return;
+    }
+
+    // The ribbons only change with a curve or a link color: a settled (or
+    // node-hover-only) frame resubmits the previous buffer untouched
+    bool lRebuild = mRibbonsDirty;
+    for (size_t i = 0; i < mLinks.size(); ++i) {
+        const LinkDyn& rLink = mLinks[i];
+        Color lStart{};
+        Color lEnd{};
+        bool lDrawn = false;
+        if (rLink.mVisibility > 0.001f && rLink.mSourceId < mNodes.size() && rLink.mTargetId < mNodes.size()) {
+            lRebuild = computeLinkCurve(rLink) || lRebuild;
+            lDrawn = linkColors(rLink, i, lStart, lEnd);
+        }
+        if (lDrawn != rLink.mBatched || (lDrawn && (!RLCharts::colorEquals(lStart, rLink.mBatchedStart) ||
+                                                    !RLCharts::colorEquals(lEnd, rLink.mBatchedEnd)))) {
+            lRebuild = true;
+        }
+        rLink.mBatched = lDrawn;
+        rLink.mBatchedStart = lStart;
+        rLink.mBatchedEnd = lEnd;
+    }
+
+    if (lRebuild) {
+        mRibbonBatch.clear();
+        for (const auto& rLink : mLinks) {
+            if (!rLink.mBatched) {
+                continue;
+            }
+            const std::vector<Vector2>& rTop = rLink.mCachedTopCurve;
+            const std::vector<Vector2>& rBottom = rLink.mCachedBottomCurve;
+            const float lLast = (float)(rTop.size() - 1);
+            Color lC1 = rLink.mBatchedStart;
+            for (size_t s = 0; s + 1 < rTop.size(); ++s) {
+                const Color lC2 = RLCharts::lerpColor(rLink.mBatchedStart, rLink.mBatchedEnd, (float)(s + 1) / lLast);
+                mRibbonBatch.addTriangle(rTop[s], lC1, rBottom[s], lC1, rTop[s + 1], lC2);
+                mRibbonBatch.addTriangle(rTop[s + 1], lC2, rBottom[s], lC1, rBottom[s + 1], lC2);
+                lC1 = lC2;
+            }
         }
+        mRibbonsDirty = false;
+        mRibbonRebuilds++;
     }
+    mRibbonBatch.draw();
 }
 
 void RLSankey::drawNodes() const {
@@ -759,10 +1003,10 @@ void RLSankey::drawLabels() const {
         // Measure text
         Vector2 lTextSize;
         if (lUseDefaultFont) {
-            lTextSize.x = (float)MeasureText(rNode.mLabel.c_str(), lFontSize);
+            lTextSize.x = (float)mLabelCache.measureDefault(rNode.mLabel.c_str(), lFontSize);
             lTextSize.y = (float)lFontSize;
         } else {
-            lTextSize = MeasureTextEx(lFont, rNode.mLabel.c_str(), (float)lFontSize, 1.0f);
+            lTextSize = mLabelCache.measure(lFont, rNode.mLabel.c_str(), (float)lFontSize, 1.0f);
         }
 
         // Position: left of node for first column, right of node otherwise
@@ -842,9 +1086,9 @@ void RLSankey::drawNode(const NodeDyn& rNode, size_t aNodeId) const {
     }
 }
 
-void RLSankey::drawLink(const LinkDyn& rLink) const {
+bool RLSankey::linkColors(const LinkDyn& rLink, size_t aLinkId, Color& rStart, Color& rEnd) const {
     if (rLink.mSourceId >= mNodes.size() || rLink.mTargetId >= mNodes.size()) {
-        return;
+        return false;
     }
 
     const NodeDyn& rSource = mNodes[rLink.mSourceId];
@@ -854,51 +1098,49 @@ void RLSankey::drawLink(const LinkDyn& rLink) const {
     const float lMaxThickness = (rLink.mSourceThickness > rLink.mTargetThickness)
                           ? rLink.mSourceThickness : rLink.mTargetThickness;
     if (lMaxThickness < 0.5f) {
-        return;
+        return false;
     }
 
-    // Compute a curve if dirty
-    computeLinkCurve(rLink);
-
     if (rLink.mCachedTopCurve.size() < 2) {
-        return;
+        return false;
     }
 
     // Determine colors based on mode
-    Color lColorStart, lColorEnd;
     float lAlpha = mStyle.mLinkAlpha * rLink.mVisibility;
 
     switch (mStyle.mLinkColorMode) {
         case RLSankeyLinkColorMode::SOURCE:
-            lColorStart = rSource.mColor;
-            lColorEnd = rSource.mColor;
+            rStart = rSource.mColor;
+            rEnd = rSource.mColor;
             break;
         case RLSankeyLinkColorMode::TARGET:
-            lColorStart = rTarget.mColor;
-            lColorEnd = rTarget.mColor;
+            rStart = rTarget.mColor;
+            rEnd = rTarget.mColor;
             break;
         case RLSankeyLinkColorMode::CUSTOM:
-            lColorStart = rLink.mColor;
-            lColorEnd = rLink.mColor;
+            rStart = rLink.mColor;
+            rEnd = rLink.mColor;
             break;
         case RLSankeyLinkColorMode::GRADIENT:
         default:
-            lColorStart = rSource.mColor;
-            lColorEnd = rTarget.mColor;
+            rStart = rSource.mColor;
+            rEnd = rTarget.mColor;
             break;
     }
 
-    // Check if this link is highlighted
-    bool lHighlighted = false;
-    for (size_t i = 0; i < mLinks.size(); ++i) {
-        if (&mLinks[i] == &rLink && (int)i == mHighlightedLink) {
-            lHighlighted = true;
-            break;
-        }
+    if ((int)aLinkId == mHighlightedLink) {
+        lAlpha = fminf(1.0f, lAlpha * 1.5f);
     }
+    rStart.a = static_cast<unsigned char>(static_cast<float>(rStart.a) * lAlpha);
+    rEnd.a = static_cast<unsigned char>(static_cast<float>(rEnd.a) * lAlpha);
+    return true;
+}
 
-    if (lHighlighted) {
-        lAlpha = fminf(1.0f, lAlpha * 1.5f);
+void RLSankey::drawLink(const LinkDyn& rLink, size_t aLinkId) const {
+    Color lColorStart{};
+    Color lColorEnd{};
+    if (!linkColors(rLink, aLinkId, lColorStart, lColorEnd)) {
+        return;
     }
 
     // Draw ribbon as triangle strip with gradient
@@ -908,11 +1150,8 @@ void RLSankey::drawLink(const LinkDyn& rLink) const {
         const float lT1 = (float)i / (float)(lSegCount - 1);
         const float lT2 = (float)(i + 1) / (float)(lSegCount - 1);
 
-        Color lC1 = RLCharts::lerpColor(lColorStart, lColorEnd, lT1);
-        Color lC2 = RLCharts::lerpColor(lColorStart, lColorEnd, lT2);
-
-        lC1.a = static_cast<unsigned char>(static_cast<float>(lC1.a) * lAlpha);
-        lC2.a = static_cast<unsigned char>(static_cast<float>(lC2.a) * lAlpha);
+        const Color lC1 = RLCharts::lerpColor(lColorStart, lColorEnd, lT1);
+        const Color lC2 = RLCharts::lerpColor(lColorStart, lColorEnd, lT2);
 
         const Vector2 lTop1 = rLink.mCachedTopCurve[i];
         const Vector2 lTop2 = rLink.mCachedTopCurve[i + 1];
@@ -927,11 +1166,7 @@ void RLSankey::drawLink(const LinkDyn& rLink) const {
     }
 }
 
-void RLSankey::computeLinkCurve(const LinkDyn& rLink) const {
-    if (!rLink.mCacheDirty) {
-        return;
-    }
-
+bool RLSankey::computeLinkCurve(const LinkDyn& rLink) const {
     const NodeDyn& rSource = mNodes[rLink.mSourceId];
     const NodeDyn& rTarget = mNodes[rLink.mTargetId];
 
@@ -942,6 +1177,15 @@ void RLSankey::computeLinkCurve(const LinkDyn& rLink) const {
     const float lSourceYTop = rSource.mY + rLink.mSourceY;
     const float lTargetYTop = rTarget.mY + rLink.mTargetY;
 
+    // The ribbon is a function of its two ends: keep it while they stay put
+    const float lKey[7] = {lSourceX, lSourceYTop, rLink.mSourceThickness,
+                           lTargetX, lTargetYTop, rLink.mTargetThickness, (float)mStyle.mLinkSegments};
+    if (!rLink.mCacheDirty && std::equal(lKey, lKey + 7, rLink.mCurveKey)) {
+        return false;
+    }
+    std::copy(lKey, lKey + 7, rLink.mCurveKey);
+    mCurveRebuilds++;
+
     // Control points for cubic Bezier (S-curve) - centerline
     const float lMidX = (lSourceX + lTargetX) * 0.5f;
 
@@ -972,6 +1216,7 @@ void RLSankey::computeLinkCurve(const LinkDyn& rLink) const {
     }
 
     rLink.mCacheDirty = false;
+    return true;
 }
 
 Vector2 RLSankey::cubicBezier(Vector2 aP0, Vector2 aP1, Vector2 aP2, Vector2 aP3, float aT) const {
@@ -1000,57 +1245,105 @@ float RLSankey::getNodeX(int aColumn) const {
 // Interaction
 // ============================================================================
 
-int RLSankey::getHoveredNode(Vector2 aMousePos) const {
-    for (size_t i = 0; i < mNodes.size(); ++i) {
-        const NodeDyn& rNode = mNodes[i];
-        if (rNode.mPendingRemoval || rNode.mVisibility < 0.1f) {
-            continue;
-        }
-
-        const float lX = getNodeX(rNode.mColumn);
-        const Rectangle lRect = {lX, rNode.mY, mStyle.mNodeWidth, rNode.mHeight};
-
-        if (CheckCollisionPointRec(aMousePos, lRect)) {
-            return (int)i;
-        }
+Rectangle RLSankey::getNodeTargetRect(size_t aNodeId) const {
+    if (aNodeId >= mNodes.size()) {
+        return Rectangle{0, 0, 0, 0};
     }
-    return -1;
+    const NodeDyn& rNode = mNodes[aNodeId];
+    return Rectangle{getNodeX(rNode.mColumn), rNode.mYTarget, mStyle.mNodeWidth, rNode.mHeightTarget};
 }
 
-int RLSankey::getHoveredLink(Vector2 aMousePos) const {
-    // Simple proximity check to link centerline
+void RLSankey::buildPickGrids() const {
+    RLCHARTS_PERF_REBUILD(mPerf, "RLSankey::buildPickGrids");
+    mPickDirty = false;
+    mPickCurveBuilds = mCurveRebuilds;
+
+    mPickMaxNodeHalf = 0.0f;
+    for (const auto& rNode : mNodes) {
+        mPickMaxNodeHalf = fmaxf(mPickMaxNodeHalf, rNode.mHeight * 0.5f);
+    }
+    const float lHalfWidth = mStyle.mNodeWidth * 0.5f;
+    mNodeGrid.build(mBounds, fmaxf(mStyle.mNodeWidth, RLCharts::PICK_CELL_SIZE), mNodes.size(), [&](size_t i) {
+        return Vector2{getNodeX(mNodes[i].mColumn) + lHalfWidth, mNodes[i].mY + mNodes[i].mHeight * 0.5f};
+    });
+
+    mPickPoints.clear();
+    mPickHalf.clear();
+    mPickLink.clear();
+    mPickMaxHalf = 0.0f;
     for (size_t i = 0; i < mLinks.size(); ++i) {
         const LinkDyn& rLink = mLinks[i];
-        if (rLink.mPendingRemoval || rLink.mVisibility < 0.1f) {
-            continue;
-        }
-        if (rLink.mCachedTopCurve.empty()) {
-            continue;
-        }
-
-        // Check if point is near the link ribbon
         for (size_t j = 0; j < rLink.mCachedTopCurve.size(); ++j) {
             const Vector2 lTop = rLink.mCachedTopCurve[j];
             const Vector2 lBot = rLink.mCachedBottomCurve[j];
-            const float lCenterY = (lTop.y + lBot.y) * 0.5f;
-            const float lHalfThick = (lBot.y - lTop.y) * 0.5f + 5.0f; // Add some tolerance
-
-            const float lDx = aMousePos.x - lTop.x;
-            const float lDy = aMousePos.y - lCenterY;
+            const float lHalf = (lBot.y - lTop.y) * 0.5f + RLCharts::LINK_PICK_TOLERANCE;
+            mPickPoints.push_back({lTop.x, (lTop.y + lBot.y) * 0.5f});
+            mPickHalf.push_back(lHalf);
+            mPickLink.push_back((uint32_t)i);
+            mPickMaxHalf = fmaxf(mPickMaxHalf, lHalf);
+        }
+    }
+    mLinkGrid.build(mBounds, RLCharts::PICK_CELL_SIZE, mPickPoints.size(), [&](size_t i) { return mPickPoints[i]; });
+}
 
-            if (lDx * lDx < 100.0f && lDy * lDy < lHalfThick * lHalfThick) {
-                return (int)i;
-            }
+int RLSankey::getHoveredNode(Vector2 aMousePos) const {
+    if (mPickDirty) {
+        buildPickGrids();
+    }
+    // Any node containing the point has its center within half a node of it
+    const float lHalfWidth = mStyle.mNodeWidth * 0.5f;
+    const Rectangle lQuery = {aMousePos.x - lHalfWidth, aMousePos.y - mPickMaxNodeHalf,
+                              mStyle.mNodeWidth, 2.0f * mPickMaxNodeHalf};
+    size_t lBest = mNodes.size();
+    mNodeGrid.forEachInRect(lQuery, [&](uint32_t aId) {
+        const NodeDyn& rNode = mNodes[aId];
+        if (aId >= lBest || rNode.mPendingRemoval || rNode.mVisibility < 0.1f) {
+            return;
+        }
+        const Rectangle lRect = {getNodeX(rNode.mColumn), rNode.mY, mStyle.mNodeWidth, rNode.mHeight};
+        if (CheckCollisionPointRec(aMousePos, lRect)) {
+            lBest = aId; // lowest id wins, as in a front-to-back scan
         }
+    });
+    return lBest < mNodes.size() ? (int)lBest : -1;
+}
+
+int RLSankey::getHoveredLink(Vector2 aMousePos) const {
+    if (mPickDirty || mPickCurveBuilds != mCurveRebuilds) {
+        buildPickGrids();
     }
-    return -1;
+    // Proximity to the ribbon centerline samples
+    const Rectangle lQuery = {aMousePos.x - RLCharts::LINK_PICK_TOLERANCE_X, aMousePos.y - mPickMaxHalf,
+                              2.0f * RLCharts::LINK_PICK_TOLERANCE_X, 2.0f * mPickMaxHalf};
+    size_t lBest = mLinks.size();
+    mLinkGrid.forEachInRect(lQuery, [&](uint32_t aSample) {
+        const size_t lLink = mPickLink[aSample];
+        const LinkDyn& rLink = mLinks[lLink];
+        if (lLink >= lBest || rLink.mPendingRemoval || rLink.mVisibility < 0.1f) {
+            return;
+        }
+        const float lDx = aMousePos.x - mPickPoints[aSample].x;
+        const float lDy = aMousePos.y - mPickPoints[aSample].y;
+        const float lHalf = mPickHalf[aSample];
+        if (lDx * lDx < RLCharts::LINK_PICK_TOLERANCE_X * RLCharts::LINK_PICK_TOLERANCE_X && lDy * lDy < lHalf * lHalf) {
+            lBest = lLink;
+        }
+    });
+    return lBest < mLinks.size() ? (int)lBest : -1;
 }
 
 void RLSankey::setHighlightedNode(int aNodeId) {
+    // Called per frame from hover tests: only a change needs a redraw
+    if (aNodeId != mHighlightedNode) {
+        mRedrawPending = true;
+    }
     mHighlightedNode = aNodeId;
 }
 
 void RLSankey::setHighlightedLink(int aLinkId) {
+    if (aLinkId != mHighlightedLink) {
+        mRedrawPending = true;
+    }
     mHighlightedLink = aLinkId;
 }
 
@@ -1,7 +1,11 @@
 // RLSankey.h
 #pragma once
 #include "raylib.h"
+#include "RLPerf.h"
+#include "RLLabelCache.h"
 #include "RLCommon.h"
+#include "RLLineBatch.h"
+#include "RLSpatialGrid.h"
 #include <vector>
 #include <string>
 #include <cstdint>
@@ -59,6 +63,7 @@ struct RLSankeyStyle {
     float mMinLinkThickness{2.0f};      // Minimum link thickness for visibility
     float mLinkAlpha{0.6f};             // Alpha for link ribbons
     int mLinkSegments{24};              // Number of segments for Bezier curves
+    bool mBatchLinks{true};             // All ribbons in one cached vertex buffer (false = DrawTriangle per segment)
     RLSankeyLinkColorMode mLinkColorMode{RLSankeyLinkColorMode::GRADIENT};
     RLSankeyFlowMode mFlowMode{RLSankeyFlowMode::NORMALIZED}; // Band width mode
 
@@ -66,6 +71,11 @@ struct RLSankeyStyle {
     bool mStrictFlowConservation{false}; // Validate inflow == outflow for intermediate nodes
     float mFlowTolerance{0.001f};        // Tolerance for flow conservation validation
 
+    // Node ordering (crossing reduction), run when nodes or links are added or removed
+    bool mOrderNodes{false};            // Reorder nodes within columns by weighted barycenter
+    int mOrderIterations{8};            // Down + up sweeps at most
+    float mOrderTimeBudgetMs{4.0f};     // Stop sweeping after this long (0 = no limit)
+
     // Labels
     bool mShowLabels{true};
     Color mLabelColor{220, 225, 235, 255};
@@ -116,6 +126,13 @@ public:
     void update(float aDt);
     void draw() const;
 
+    // Settled once the layout is current, every node and link reached its targets
+    // and nothing is waiting to fade out
+    [[nodiscard]] bool isSettled() const;
+    [[nodiscard]] bool needsRedraw() const { return mRedrawPending || !isSettled(); }
+    // update()/rebuild/draw() timers and GPU counters (RLPerf.h); zero unless built with RLCHARTS_PERF
+    [[nodiscard]] const RLCharts::PerfStats& getPerfStats() const { return mPerf; }
+
     // Interaction
     int getHoveredNode(Vector2 aMousePos) const;   // Returns node id or -1
     int getHoveredLink(Vector2 aMousePos) const;   // Returns link id or -1
@@ -127,6 +144,12 @@ public:
     [[nodiscard]] size_t getNodeCount() const;
     [[nodiscard]] size_t getLinkCount() const;
     [[nodiscard]] int getColumnCount() const { return mColumnCount; }
+    // Laid-out node rectangle (animation target); empty for an unknown id
+    [[nodiscard]] Rectangle getNodeTargetRect(size_t aNodeId) const;
+    // Link ribbons re-tessellated so far (only links whose endpoints moved are redone)
+    [[nodiscard]] size_t getCurveRebuildCount() const { return mCurveRebuilds; }
+    // Times the batched ribbon buffer was rebuilt (mBatchLinks)
+    [[nodiscard]] size_t getRibbonBatchRebuildCount() const { return mRibbonRebuilds; }
     [[nodiscard]] bool hasPendingRemovals() const;
 
 private:
@@ -173,17 +196,28 @@ private:
         float mTargetY{0.0f};           // Y offset within target node
         float mTargetYTarget{0.0f};
 
-        // Cached ribbon vertices
+        // Cached ribbon vertices, and the endpoint geometry they were built from
         mutable std::vector<Vector2> mCachedTopCurve;
         mutable std::vector<Vector2> mCachedBottomCurve;
+        mutable float mCurveKey[7]{};
         mutable bool mCacheDirty{true};
+        // Colors the link was last written into the ribbon batch with
+        mutable Color mBatchedStart{};
+        mutable Color mBatchedEnd{};
+        mutable bool mBatched{false};
     };
 
     // Layout computation
     void computeLayout();
+    void buildLinkIndex();
     void assignColumns();
-    void computeNodePositions();
-    void computeLinkPositions();
+    void buildColumns();
+    void orderColumns();
+    void sortLinksByRank();
+    void computeFlows();
+    void computeScale();
+    void positionColumn(int aColumn);
+    void positionNodeLinks(size_t aNodeId);
     float computeTotalFlow(size_t aNodeId, bool aOutgoing) const;
     bool isIntermediateNode(size_t aNodeId) const;
 
@@ -192,9 +226,12 @@ private:
     void drawLinks() const;
     void drawNodes() const;
     void drawLabels() const;
-    void drawLink(const LinkDyn& rLink) const;
+    void drawLink(const LinkDyn& rLink, size_t aLinkId) const;
     void drawNode(const NodeDyn& rNode, size_t aNodeId) const;
-    void computeLinkCurve(const LinkDyn& rLink) const;
+    // Ribbon colors at both ends; false if the link is too thin or has no curve
+    bool linkColors(const LinkDyn& rLink, size_t aLinkId, Color& rStart, Color& rEnd) const;
+    // Re-tessellates if the ends moved; returns whether it did
+    bool computeLinkCurve(const LinkDyn& rLink) const;
 
     // Bezier curve helpers
     Vector2 cubicBezier(Vector2 aP0, Vector2 aP1, Vector2 aP2, Vector2 aP3, float aT) const;
@@ -211,6 +248,30 @@ private:
 
     // Layout state
     mutable bool mLayoutDirty{true};
+    // Columns and per-node link lists stay valid until nodes or links are added,
+    // removed or moved; until then setLinkValue() only queues its link and the
+    // next layout redoes the columns and nodes it touches
+    bool mStructureDirty{true};
+    std::vector<size_t> mDirtyLinks;
+    std::vector<std::vector<size_t>> mColumnNodes;
+    std::vector<float> mInflow;
+    std::vector<float> mOutflow;
+    // Links of node i in link order: mOutLinks[mOutOffsets[i] .. mOutOffsets[i + 1]) (same for in)
+    std::vector<size_t> mOutOffsets;
+    std::vector<size_t> mOutLinks;
+    std::vector<size_t> mInOffsets;
+    std::vector<size_t> mInLinks;
+    std::vector<float> mNodeRank;       // position within the column, 0..1 (ordering)
+    std::vector<uint8_t> mNodeMarks;
+    std::vector<uint8_t> mColumnMarks;
+    mutable size_t mCurveRebuilds{0};
+    // Every visible ribbon, rebuilt only when a curve or a link color changed
+    mutable RLCharts::LineBatch mRibbonBatch;
+    mutable bool mRibbonsDirty{true}; // links added, removed or restyled
+    mutable size_t mRibbonRebuilds{0};
+    mutable bool mRedrawPending{true}; // cleared by draw()
+    mutable RLCharts::PerfStats mPerf;
+    mutable RLCharts::LabelCache mLabelCache;
     int mColumnCount{0};
     float mChartLeft{0.0f};
     float mChartTop{0.0f};
@@ -221,5 +282,18 @@ private:
     // Interaction state
     int mHighlightedNode{-1};
     int mHighlightedLink{-1};
+
+    // Hit-testing: node centers and ribbon centerline samples binned into grids,
+    // rebuilt on the first query after the layout or a curve moved
+    mutable RLCharts::SpatialGrid mNodeGrid;
+    mutable RLCharts::SpatialGrid mLinkGrid;
+    mutable std::vector<Vector2> mPickPoints;   // ribbon samples (x, center y)
+    mutable std::vector<float> mPickHalf;       // half thickness + tolerance per sample
+    mutable std::vector<uint32_t> mPickLink;    // link id per sample
+    mutable float mPickMaxHalf{0.0f};
+    mutable float mPickMaxNodeHalf{0.0f};
+    mutable size_t mPickCurveBuilds{0};
+    mutable bool mPickDirty{true};
+    void buildPickGrids() const;
 };
 
@@ -11,19 +11,41 @@ RLScatterPlot::RLScatterPlot(Rectangle aBounds, const RLScatterPlotStyle &rStyle
 }
 
 void RLScatterPlot::setBounds(Rectangle aBounds){
+    mRedrawPending = true;
+    mAnimSettled = false;
     mBounds = aBounds;
     mGeomDirty = true;
+    mStaticLayer.invalidate();
     markAllDirty();
+    configureDensityMap();
 }
 
 void RLScatterPlot::setStyle(const RLScatterPlotStyle &rStyle){
+    mRedrawPending = true;
+    mAnimSettled = false;
     mStyle = rStyle;
     mGeomDirty = true;
     mScaleDirty = true;
+    mStaticLayer.invalidate();
     markAllDirty();
+    configureDensityMap();
+}
+
+void RLScatterPlot::setStaticLayerCache(bool aEnabled){
+    mRedrawPending = true;
+    mStaticLayer.setEnabled(aEnabled);
+}
+
+void RLScatterPlot::setTaskPool(RLCharts::TaskPool* pPool){
+    mpTaskPool = pPool;
+    if (mpDensityMap){
+        mpDensityMap->setTaskPool(pPool);
+    }
 }
 
 void RLScatterPlot::setScale(float aMinX, float aMaxX, float aMinY, float aMaxY){
+    mRedrawPending = true;
+    mAnimSettled = false;
     mStyle.mAutoScale = false;
     mStyle.mMinX = aMinX; mStyle.mMaxX = aMaxX;
     mStyle.mMinY = aMinY; mStyle.mMaxY = aMaxY;
@@ -32,11 +54,18 @@ void RLScatterPlot::setScale(float aMinX, float aMaxX, float aMinY, float aMaxY)
 }
 
 void RLScatterPlot::clearSeries(){
+    mRedrawPending = true;
+    mAnimSettled = false;
     mSeries.clear();
     mScaleDirty = true;
+    mBatchDirty = true;
+    mPickDirty = true;
+    mDensityDirty = true;
 }
 
 size_t RLScatterPlot::addSeries(const RLScatterSeries &rSeries){
+    mRedrawPending = true;
+    mAnimSettled = false;
     mSeries.push_back(rSeries);
     mSeries.back().mDirty = true;
     mScaleDirty = true;
@@ -47,12 +76,16 @@ void RLScatterPlot::setSeries(size_t aIndex, const RLScatterSeries &rSeries){
     if (aIndex >= mSeries.size()) {
         return;
     }
+    mRedrawPending = true;
+    mAnimSettled = false;
     mSeries[aIndex] = rSeries;
     mSeries[aIndex].mDirty = true;
     mScaleDirty = true;
 }
 
 void RLScatterPlot::setSingleSeries(const std::vector<Vector2> &rData, const RLScatterSeriesStyle &aStyle){
+    mRedrawPending = true;
+    mAnimSettled = false;
     RLScatterSeries s;
     s.mData = rData;
     s.mStyle = aStyle;
@@ -140,8 +173,19 @@ Vector2 RLScatterPlot::mapPoint(const Vector2 &rPt) const{
     return lOut;
 }
 
+// Which sides of the current scale a data point lies beyond (0 = inside)
+uint8_t RLScatterPlot::outCode(const Vector2 &rPt) const{
+    uint8_t lCode = 0;
+    lCode |= rPt.x < mScaleMinX ? 1 : 0;
+    lCode |= rPt.x > mScaleMaxX ? 2 : 0;
+    lCode |= rPt.y < mScaleMinY ? 4 : 0;
+    lCode |= rPt.y > mScaleMaxY ? 8 : 0;
+    return lCode;
+}
+
 
 void RLScatterPlot::buildCaches() const{
+    RLCHARTS_PERF_REBUILD(mPerf, "RLScatterPlot::buildCaches");
     const Rectangle lRect = plotRect();
     (void)lRect;
     ensureScale();
@@ -150,6 +194,9 @@ void RLScatterPlot::buildCaches() const{
         if (!s.mDirty) {
             continue;
         }
+        mBatchDirty = true;
+        mPickDirty = true;
+        mDensityDirty = true;
         // Ensure dyn arrays are initialized
         ensureDynInitialized(s);
         // Map to screen space from dynamic positions
@@ -157,48 +204,73 @@ void RLScatterPlot::buildCaches() const{
         s.mCache.reserve(s.mDynPos.size());
         s.mCacheVis.clear();
         s.mCacheVis.reserve(s.mDynPos.size());
+        s.mCacheOut.clear();
+        s.mCacheOut.reserve(s.mDynPos.size());
         for (size_t i=0; i<s.mDynPos.size(); ++i){
             s.mCache.push_back(mapPoint(s.mDynPos[i]));
             s.mCacheVis.push_back(s.mVis[i]);
+            s.mCacheOut.push_back(outCode(s.mDynPos[i]));
         }
 
-        // Build spline polyline if needed (with visibility sampling)
-        s.mSpline.clear();
+        // Build spline polyline if needed (with visibility sampling); segments whose
+        // control points did not move are copied from the previous tessellation
         s.mSplineVis.clear();
+        s.mSplineOut.clear();
         if (s.mStyle.mLineMode == RLScatterLineMode::Spline && s.mCache.size() >= 2){
-            const std::vector<Vector2> &lPts = s.mCache;
-            // Estimate sampling based on pixel spacing
-            const float lTargetPx = RLCharts::maxVal(2.0f, mStyle.mSplinePixels);
-            // For endpoints, duplicate end points to compute CR
-            const size_t lN = lPts.size();
-            s.mSpline.reserve(lN * 8);
-            s.mSplineVis.reserve(lN * 8);
-            for (size_t i = 0; i+1 < lN; ++i){
-                const Vector2 &p0 = (i==0) ? lPts[0] : lPts[i-1];
-                const Vector2 &p1 = lPts[i];
-                const Vector2 &p2 = lPts[i+1];
-                const Vector2 &p3 = (i+2<lN) ? lPts[i+2] : lPts[lN-1];
-                const float lSegLen = RLCharts::distance(p1,p2);
-                const int lSteps = (int)RLCharts::maxVal(1.0f, floorf(lSegLen / lTargetPx));
-                const float lInv = 1.0f / (float)lSteps;
-                for (int k=0; k<lSteps; ++k){
-                    const float t = (float)k * lInv;
-                    s.mSpline.push_back(RLCharts::catmullRom(p0,p1,p2,p3,t));
-                    const float lVa = s.mCacheVis[i];
-                    const float lVb = s.mCacheVis[i+1];
+            s.mSpline.build(s.mCache.data(), s.mCache.size(), RLCharts::maxVal(2.0f, mStyle.mSplinePixels),
+                            mStyle.mSplineTolerancePx);
+            const size_t lSegments = s.mSpline.getSegmentCount();
+            s.mSplineVis.reserve(s.mSpline.getPoints().size());
+            s.mSplineOut.reserve(s.mSpline.getPoints().size());
+            for (size_t i = 0; i < lSegments; ++i){
+                const size_t lSteps = s.mSpline.getSegmentStart(i + 1) - s.mSpline.getSegmentStart(i);
+                const float lVa = s.mCacheVis[i];
+                const float lVb = s.mCacheVis[i+1];
+                const uint8_t lOut = s.mCacheOut[i] & s.mCacheOut[i+1];
+                for (size_t k = 0; k < lSteps; ++k){
+                    const float t = (float)k / (float)lSteps;
                     s.mSplineVis.push_back(lVa + (lVb - lVa) * t);
+                    s.mSplineOut.push_back(lOut);
                 }
             }
-            // Ensure last point appended
-            s.mSpline.push_back(s.mCache.back());
+            // Closing point
             s.mSplineVis.push_back(s.mCacheVis.back());
+            s.mSplineOut.push_back(s.mCacheOut.back());
+        } else {
+            s.mSpline.clear();
         }
         s.mDirty = false;
     }
 }
 
 void RLScatterPlot::draw() const{
-    // Background
+    RLCHARTS_PERF_DRAW(mPerf, "RLScatterPlot::draw");
+    mRedrawPending = false;
+    // Background, grid and axes (cached if enabled)
+    mStaticLayer.draw(mBounds, 0, [this]() { drawStaticLayer(); });
+
+    // Build caches if needed
+    buildCaches();
+    if (mDensityDirty || mDensityMapDirty){
+        // Points moved without prepare()/update() since
+        refreshDensity();
+        if (mpDensityMap){
+            mpDensityMap->commit();
+        }
+    }
+    if (mpDensityMap && !mDensityGrid.empty()){
+        mpDensityMap->draw();
+    }
+
+    if (mBatchDirty){
+        buildBatch();
+        mBatchDirty = false;
+    }
+    mBatch.draw();
+    mMarkers.draw();
+}
+
+void RLScatterPlot::drawStaticLayer() const{
     if (mStyle.mShowBackground){
         DrawRectangleRounded(mBounds, 0.06f, 6, mStyle.mBackground);
     }
@@ -219,63 +291,69 @@ void RLScatterPlot::draw() const{
     if (mStyle.mShowAxes){
         DrawRectangleLinesEx(lRect, 1.0f, mStyle.mAxesColor);
     }
+}
 
-    // Build caches if needed
-    buildCaches();
+void RLScatterPlot::buildBatch() const{
+    mBatch.clear();
+    mMarkers.clear();
 
-    // Draw series (lines first then points so points are on top). Alpha is modulated by visibility.
-    for (const auto &s : mSeries){
+    // Series lines first then points so points are on top. Alpha is modulated by visibility.
+    for (size_t si = 0; si < mSeries.size(); ++si){
+        const RLScatterSeries &s = mSeries[si];
         const RLScatterSeriesStyle &lSS = s.mStyle;
-        if (lSS.mLineMode != RLScatterLineMode::None){
+        if (lSS.mLineMode != RLScatterLineMode::None && !usesDensity(si)){
             if (lSS.mLineMode == RLScatterLineMode::Linear){
-                // Draw consecutive segments
+                // Consecutive segments
                 if (s.mCache.size() >= 2){
                     for (size_t i=0;i+1<s.mCache.size();++i){
                         const float lVa = (i < s.mCacheVis.size()) ? s.mCacheVis[i] : 1.0f;
                         const float lVb = (i+1 < s.mCacheVis.size()) ? s.mCacheVis[i+1] : 1.0f;
                         const float lV = RLCharts::minVal(lVa, lVb);
-                        if (lV <= 0.001f) {
+                        // Both ends beyond the same side of a zoomed scale: off-plot
+                        if (lV <= 0.001f || (s.mCacheOut[i] & s.mCacheOut[i+1]) != 0) {
                             continue;
                         }
                         Color lC = lSS.mLineColor;
                         lC.a = RLCharts::mulAlpha(lC.a, lV);
-                        DrawLineEx(s.mCache[i], s.mCache[i+1], RLCharts::maxVal(1.0f, lSS.mLineThickness), lC);
+                        mBatch.addSegment(s.mCache[i], s.mCache[i+1], RLCharts::maxVal(1.0f, lSS.mLineThickness), lC);
                     }
                 }
             } else { // Spline
-                if (s.mSpline.size() >= 2){
-                    for (size_t i=0;i+1<s.mSpline.size();++i){
+                const std::vector<Vector2> &rSpline = s.mSpline.getPoints();
+                if (rSpline.size() >= 2){
+                    for (size_t i=0;i+1<rSpline.size();++i){
                         const float lVa = (i < s.mSplineVis.size()) ? s.mSplineVis[i] : 1.0f;
                         const float lVb = (i+1 < s.mSplineVis.size()) ? s.mSplineVis[i+1] : 1.0f;
                         const float lV = RLCharts::minVal(lVa, lVb);
-                        if (lV <= 0.001f) {
+                        if (lV <= 0.001f || s.mSplineOut[i] != 0) {
                             continue;
                         }
                         Color lC = lSS.mLineColor;
                         lC.a = RLCharts::mulAlpha(lC.a, lV);
-                        DrawLineEx(s.mSpline[i], s.mSpline[i+1], RLCharts::maxVal(1.0f, lSS.mLineThickness), lC);
+                        mBatch.addSegment(rSpline[i], rSpline[i+1], RLCharts::maxVal(1.0f, lSS.mLineThickness), lC);
                     }
                 }
             }
         }
     }
 
-    for (const auto &s : mSeries){
+    for (size_t si = 0; si < mSeries.size(); ++si){
+        const RLScatterSeries &s = mSeries[si];
         const RLScatterSeriesStyle &lSS = s.mStyle;
-        if (!lSS.mShowPoints) {
+        if (!lSS.mShowPoints || usesDensity(si)) {
             continue;
         }
         const Color lPc = (lSS.mPointColor.a == 0) ? lSS.mLineColor : lSS.mPointColor;
         const float lRadius = lSS.mPointSizePx > 0.0f ? lSS.mPointSizePx : RLCharts::maxVal(1.0f, lSS.mLineThickness * lSS.mPointScale);
-        // Draw all points
+        // All points
         for (size_t i=0; i<s.mCache.size(); ++i){
             const float lV = (i < s.mCacheVis.size()) ? s.mCacheVis[i] : 1.0f;
-            if (lV <= 0.001f) {
+            if (lV <= 0.001f || s.mCacheOut[i] != 0) {
                 continue;
             }
             Color lC = lPc;
             lC.a = RLCharts::mulAlpha(lC.a, lV);
-            DrawCircleV(s.mCache[i], lRadius, lC);
+            mMarkers.add(s.mCache[i], lRadius, lC);
         }
     }
 }
@@ -292,11 +370,43 @@ void RLScatterPlot::ensureDynInitialized(const RLScatterSeries &rSeries) const{
 }
 
 void RLScatterPlot::setSeriesTargetData(size_t aIndex, const std::vector<Vector2> &rData){
+    setSeriesTargetData(aIndex, std::span<const Vector2>(rData.data(), rData.size()));
+}
+
+void RLScatterPlot::setSeriesTargetData(size_t aIndex, std::span<const Vector2> aData){
     if (aIndex >= mSeries.size()) {
         return;
     }
+    mRedrawPending = true;
+    mAnimSettled = false;
     RLScatterSeries &s = mSeries[aIndex];
-    s.mTargetData = rData;
+    s.mTargetData.assign(aData.begin(), aData.end());
+    applyTargetData(s);
+}
+
+void RLScatterPlot::setSeriesTargetData(size_t aIndex, const float *pX, const float *pY, size_t aCount, size_t aStride){
+    if (aIndex >= mSeries.size() || (aCount > 0 && (pX == nullptr || pY == nullptr))) {
+        return;
+    }
+    mRedrawPending = true;
+    mAnimSettled = false;
+    RLScatterSeries &s = mSeries[aIndex];
+    s.mTargetData.resize(aCount);
+    for (size_t i=0;i<aCount;++i){
+        s.mTargetData[i] = { pX[i * aStride], pY[i * aStride] };
+    }
+    applyTargetData(s);
+}
+
+std::span<const Vector2> RLScatterPlot::getSeriesTargetData(size_t aIndex) const{
+    if (aIndex >= mSeries.size()) {
+        return {};
+    }
+    return mSeries[aIndex].mTargetData;
+}
+
+void RLScatterPlot::applyTargetData(RLScatterSeries &s){
+    const std::vector<Vector2> &rData = s.mTargetData;
     ensureDynInitialized(s);
     const size_t lOld = s.mDynPos.size();
     const size_t lNew = rData.size();
@@ -331,6 +441,8 @@ void RLScatterPlot::setSeriesTargetData(size_t aIndex, const std::vector<Vector2
 }
 
 void RLScatterPlot::setSingleSeriesTargetData(const std::vector<Vector2> &rData){
+    mRedrawPending = true;
+    mAnimSettled = false;
     if (mSeries.empty()){
         RLScatterSeries s; s.mData = rData; s.mTargetData = rData; addSeries(s);
     }
@@ -338,9 +450,16 @@ void RLScatterPlot::setSingleSeriesTargetData(const std::vector<Vector2> &rData)
 }
 
 void RLScatterPlot::update(float aDt){
-    if (aDt <= 0.0f) {
+    prepare(aDt);
+    commit();
+}
+
+void RLScatterPlot::prepare(float aDt){
+    RLCHARTS_PERF_UPDATE(mPerf, "RLScatterPlot::prepare");
+    if (aDt <= 0.0f || mAnimSettled) {
         return;
     }
+    mAnimSettled = true;
     const float lMoveT = RLCharts::clamp01(mStyle.mMoveSpeed * aDt);
     const float lFadeT = RLCharts::clamp01(mStyle.mFadeSpeed * aDt);
     for (auto &s : mSeries){
@@ -348,20 +467,21 @@ void RLScatterPlot::update(float aDt){
         bool lAnyChange = false;
         const size_t n = s.mDynPos.size();
         // If we had points faded to zero and beyond new size, we can shrink containers lazily
-        // But keep them until visibility is ~0
-        for (size_t i=0;i<n;++i){
-            // If i exceeds target array (after shrink), keep target at current to not move
-            const Vector2 lTarget = (i < s.mDynTarget.size()) ? s.mDynTarget[i] : s.mDynPos[i];
-            Vector2 lP = s.mDynPos[i];
-            lP.x += (lTarget.x - lP.x) * lMoveT;
-            lP.y += (lTarget.y - lP.y) * lMoveT;
-            if (fabsf(lP.x - s.mDynPos[i].x) > 1e-6f || fabsf(lP.y - s.mDynPos[i].y) > 1e-6f) {
-                lAnyChange = true;
-            }
-            s.mDynPos[i] = lP;
-            const float lVt = (i < s.mVisTarget.size()) ? s.mVisTarget[i] : 1.0f;
-            const float lV = s.mVis[i] + (lVt - s.mVis[i]) * lFadeT;
-            if (fabsf(lV - s.mVis[i]) > 1e-6f) {
+        // But keep them until visibility is ~0.
+        // Points past the end of the target arrays (after shrink) keep their position
+        // and fade towards 1; everything else is stepped in bulk.
+        static_assert(sizeof(Vector2) == 2 * sizeof(float), "Vector2 is stepped as packed floats");
+        const size_t lMoving = std::min(n, s.mDynTarget.size());
+        if (!RLCharts::approachArray((float*)s.mDynPos.data(), (const float*)s.mDynTarget.data(), lMoving * 2, lMoveT)) {
+            lAnyChange = true;
+        }
+        const size_t lFading = std::min(n, s.mVisTarget.size());
+        if (!RLCharts::approachArray(s.mVis.data(), s.mVisTarget.data(), lFading, lFadeT)) {
+            lAnyChange = true;
+        }
+        for (size_t i = lFading; i < n; ++i) {
+            const float lV = RLCharts::approach(s.mVis[i], 1.0f, lFadeT);
+            if (lV != s.mVis[i]) {
                 lAnyChange = true;
             }
             s.mVis[i] = lV;
@@ -403,8 +523,213 @@ void RLScatterPlot::update(float aDt){
                 lAnyChange = true;
             }
         }
-        if (lAnyChange){ s.mDirty = true; }
+        if (lAnyChange){ s.mDirty = true; mAnimSettled = false; mRedrawPending = true; }
         // Also keep s.mData in sync for immediate replace semantics
         s.mData = s.mDynPos; // so external getters (if any) would see moving state; also scale uses mData
     }
+    // Bin moved density series here rather than in draw()
+    if (mStyle.mDensityThreshold != 0){
+        buildCaches();
+        refreshDensity();
+    }
+}
+
+void RLScatterPlot::commit(){
+    if (mpDensityMap){
+        mpDensityMap->commit();
+    }
+}
+
+void RLScatterPlot::buildPickIndex() const{
+    RLCHARTS_PERF_REBUILD(mPerf, "RLScatterPlot::buildPickIndex");
+    mPickRefs.clear();
+    for (size_t si = 0; si < mSeries.size(); ++si){
+        const RLScatterSeries &s = mSeries[si];
+        for (size_t i = 0; i < s.mCache.size(); ++i){
+            if (s.mCacheVis[i] > 0.001f && s.mCacheOut[i] == 0){
+                mPickRefs.push_back({ (uint32_t)si, (uint32_t)i });
+            }
+        }
+    }
+    // About four points per cell on average, but no finer than 8px
+    const Rectangle lRect = plotRect();
+    const float lArea = lRect.width * lRect.height;
+    const float lCell = RLCharts::maxVal(8.0f, sqrtf(4.0f * lArea / (float)RLCharts::maxVal((size_t)1, mPickRefs.size())));
+    mPickGrid.build(lRect, lCell, mPickRefs.size(), [this](size_t aId){
+        const PickRef &rRef = mPickRefs[aId];
+        return mSeries[rRef.mSeries].mCache[rRef.mIndex];
+    });
+    mPickDirty = false;
+}
+
+RLScatterHit RLScatterPlot::getNearestPoint(Vector2 aScreenPos, float aMaxDistancePx) const{
+    RLScatterHit lHit;
+    buildCaches();
+    if (mPickDirty){
+        buildPickIndex();
+    }
+    float lDistance = 0.0f;
+    const uint32_t lId = mPickGrid.nearest(aScreenPos, aMaxDistancePx, [this](uint32_t aId){
+        const PickRef &rRef = mPickRefs[aId];
+        return mSeries[rRef.mSeries].mCache[rRef.mIndex];
+    }, [](uint32_t){ return true; }, lDistance);
+    if (lId == RLCharts::SpatialGrid::NONE){
+        return lHit;
+    }
+    const PickRef &rRef = mPickRefs[lId];
+    const RLScatterSeries &s = mSeries[rRef.mSeries];
+    lHit.mFound = true;
+    lHit.mSeries = rRef.mSeries;
+    lHit.mIndex = rRef.mIndex;
+    lHit.mData = s.mDynPos[rRef.mIndex];
+    lHit.mScreen = s.mCache[rRef.mIndex];
+    lHit.mDistance = lDistance;
+    return lHit;
+}
+
+bool RLScatterPlot::usesDensity(size_t aIndex) const{
+    if (aIndex >= mSeries.size() || mStyle.mDensityThreshold == 0) {
+        return false;
+    }
+    // Animated point count once initialized (includes points still fading out)
+    const RLScatterSeries &s = mSeries[aIndex];
+    return (s.mDynPos.empty() ? s.mData.size() : s.mDynPos.size()) >= mStyle.mDensityThreshold;
+}
+
+// Accumulate visibility-weighted points of one slice into a density grid
+void RLScatterPlot::binDensitySlice(const RLScatterSeries &rSeries, size_t aBegin, size_t aEnd, Rectangle aRect,
+                                    float aInvCell, int aCellsX, int aCellsY, float *pGrid){
+    for (size_t i = aBegin; i < aEnd; ++i){
+        const float lV = rSeries.mCacheVis[i];
+        if (lV <= 0.001f || rSeries.mCacheOut[i] != 0) {
+            continue;
+        }
+        const Vector2 &rP = rSeries.mCache[i];
+        const int lX = RLCharts::clampIdx((int)((rP.x - aRect.x) * aInvCell), aCellsX);
+        const int lY = RLCharts::clampIdx((int)((rP.y - aRect.y) * aInvCell), aCellsY);
+        pGrid[(size_t)lY * (size_t)aCellsX + (size_t)lX] += lV;
+    }
+}
+
+// Sum the partial grids into pGrid over [aBegin, aEnd) and apply the log scale
+void RLScatterPlot::reduceDensityCells(float *pGrid, const float *pPartials, size_t aPartials, size_t aCells,
+                                       size_t aBegin, size_t aEnd, bool aLog){
+    for (size_t p = 0; p < aPartials; ++p){
+        const float *pPartial = pPartials + p * aCells;
+        for (size_t c = aBegin; c < aEnd; ++c){
+            pGrid[c] += pPartial[c];
+        }
+    }
+    if (aLog){
+        for (size_t c = aBegin; c < aEnd; ++c){
+            pGrid[c] = log2f(1.0f + pGrid[c]);
+        }
+    }
+}
+
+void RLScatterPlot::buildDensity() const{
+    RLCHARTS_PERF_REBUILD(mPerf, "RLScatterPlot::buildDensity");
+    mDensityDirty = false;
+    mDensityMapDirty = true;
+    size_t lPoints = 0;
+    for (size_t si = 0; si < mSeries.size(); ++si){
+        lPoints += usesDensity(si) ? mSeries[si].mCache.size() : 0;
+    }
+    if (lPoints == 0){
+        mDensityGrid.clear();
+        mDensityCellsX = 0;
+        mDensityCellsY = 0;
+        return;
+    }
+
+    const Rectangle lRect = plotRect();
+    const float lInvCell = 1.0f / RLCharts::maxVal(1.0f, mStyle.mDensityCellPx);
+    densityGridSize(mDensityCellsX, mDensityCellsY);
+    const size_t lCells = (size_t)mDensityCellsX * (size_t)mDensityCellsY;
+    mDensityGrid.assign(lCells, 0.0f);
+
+    RLCharts::TaskPool &rPool = getTaskPool();
+    size_t lThreads = mStyle.mDensityThreads == 0 ? rPool.getThreadCount()
+                                                  : (size_t)RLCharts::maxVal(1, mStyle.mDensityThreads);
+    lThreads = RLCharts::maxVal((size_t)1, RLCharts::minVal(lThreads, lPoints / DENSITY_MIN_POINTS_PER_THREAD));
+
+    // Task t bins slice t of every density series into its own grid (t = 0 into
+    // mDensityGrid), so no cell is ever written by two threads
+    mDensityPartials.assign((lThreads - 1) * lCells, 0.0f);
+    rPool.parallelFor(lThreads, [this, lThreads, lCells, lRect, lInvCell](size_t aTask){
+        float *pGrid = aTask == 0 ? mDensityGrid.data() : mDensityPartials.data() + (aTask - 1) * lCells;
+        for (size_t si = 0; si < mSeries.size(); ++si){
+            if (!usesDensity(si)) {
+                continue;
+            }
+            const size_t lN = mSeries[si].mCache.size();
+            binDensitySlice(mSeries[si], lN * aTask / lThreads, lN * (aTask + 1) / lThreads, lRect, lInvCell,
+                            mDensityCellsX, mDensityCellsY, pGrid);
+        }
+    });
+    // Then each task sums one band of cells across the partials
+    rPool.parallelFor(lThreads, [this, lThreads, lCells](size_t aTask){
+        reduceDensityCells(mDensityGrid.data(), mDensityPartials.data(), lThreads - 1, lCells,
+                           lCells * aTask / lThreads, lCells * (aTask + 1) / lThreads, mStyle.mDensityLog);
+    });
+}
+
+const std::vector<float>& RLScatterPlot::getDensityGrid() const{
+    buildCaches();
+    if (mDensityDirty){
+        buildDensity();
+    }
+    return mDensityGrid;
+}
+
+void RLScatterPlot::densityGridSize(int &rCellsX, int &rCellsY) const{
+    const Rectangle lRect = plotRect();
+    const float lInvCell = 1.0f / RLCharts::maxVal(1.0f, mStyle.mDensityCellPx);
+    rCellsX = RLCharts::maxVal(1, (int)ceilf(lRect.width * lInvCell));
+    rCellsY = RLCharts::maxVal(1, (int)ceilf(lRect.height * lInvCell));
+}
+
+// Colormap, bounds and grid size of the density heat map. Changing them may
+// release or recreate its textures, so this runs from the setters on the render
+// thread and never from prepare()
+void RLScatterPlot::configureDensityMap() const{
+    if (!mpDensityMap){
+        return;
+    }
+    static const std::vector<Color> DEFAULT_STOPS = {
+        Color{ 30, 60, 140, 0 }, Color{ 40, 150, 255, 255 }, Color{ 255, 220, 60, 255 }, Color{ 255, 255, 255, 255 }
+    };
+    int lCellsX = 0;
+    int lCellsY = 0;
+    densityGridSize(lCellsX, lCellsY);
+    mpDensityMap->setColorStops(mStyle.mDensityStops.size() >= 2 ? mStyle.mDensityStops : DEFAULT_STOPS);
+    mpDensityMap->setGpuColormap(mStyle.mDensityGpuColormap);
+    mpDensityMap->setBounds(plotRect());
+    mpDensityMap->setGrid(lCellsX, lCellsY);
+}
+
+// Bin the density series if their points moved and stage the grid in the heat
+// map (CPU only; its commit() uploads it)
+void RLScatterPlot::refreshDensity() const{
+    if (mDensityDirty){
+        buildDensity();
+    }
+    if (!mDensityMapDirty){
+        return;
+    }
+    mDensityMapDirty = false;
+    if (mDensityGrid.empty()){
+        return;
+    }
+    if (!mpDensityMap){
+        // A new heat map has no textures yet, so configuring it makes no GL calls
+        mpDensityMap = std::make_unique<RLHeatMap>(plotRect(), mDensityCellsX, mDensityCellsY);
+        RLHeatMapStyle lStyle;
+        lStyle.mShowBackground = false;
+        mpDensityMap->setStyle(lStyle);
+        mpDensityMap->setTaskPool(mpTaskPool);
+        configureDensityMap();
+    }
+    mpDensityMap->setCounts(mDensityGrid);
+    mpDensityMap->prepare(0.0f);
 }
@@ -1,7 +1,18 @@
 #pragma once
 #include "raylib.h"
+#include "RLPerf.h"
 #include "RLCommon.h"
+#include "RLLineBatch.h"
+#include "RLCircleBatch.h"
+#include "RLSpatialGrid.h"
+#include "RLSpline.h"
+#include "RLHeatMap.h"
+#include "RLRenderCache.h"
+#include "RLTaskPool.h"
+#include <cstdint>
+#include <memory>
 #include <vector>
+#include <span>
 
 // High-performance Scatter Plot for raylib.
 // Supports single and multiple series, with linear or spline lines and point markers.
@@ -44,13 +55,25 @@ struct RLScatterPlotStyle {
     float mMinY{ 0.0f };
     float mMaxY{ 1.0f };
 
-    // Spline quality (higher = smoother, more points). Base target pixels per segment.
-    float mSplinePixels{ 6.0f }; // approximate pixels between samples
+    // Spline quality: segments are subdivided until they are within mSplineTolerancePx
+    // of the curve, but never finer than mSplinePixels (straight runs get one step)
+    float mSplinePixels{ 6.0f };       // minimum pixels between samples
+    float mSplineTolerancePx{ 0.25f }; // allowed deviation from the true curve
 
     // Animation
     bool mSmoothAnimate{ true };
     float mMoveSpeed{ 8.0f };  // position approach speed (1/s)
     float mFadeSpeed{ 6.0f };  // visibility fade speed (1/s)
+
+    // Density mode: series with at least mDensityThreshold points (0 = never) are
+    // binned into a count grid and drawn through RLHeatMap's colormap instead of as
+    // markers and lines; smaller series are still drawn on top of it
+    size_t mDensityThreshold{ 0 };
+    float mDensityCellPx{ 1.0f };     // grid cell size in pixels (1 = pixel resolution)
+    bool mDensityLog{ true };         // log2(1 + count), so sparse areas stay visible next to dense cores
+    std::vector<Color> mDensityStops; // empty = transparent to blue, yellow and white
+    int mDensityThreads{ 0 };         // binning tasks, 0 = every task pool thread; small series stay serial
+    bool mDensityGpuColormap{ false }; // see RLHeatMap::setGpuColormap
 };
 
 struct RLScatterSeries {
@@ -62,9 +85,11 @@ struct RLScatterSeries {
 
     // Internal cache (mutable, maintained by RLScatterPlot)
     mutable std::vector<Vector2> mCache; // mapped to screen space for fast drawing
-    mutable std::vector<Vector2> mSpline; // sampled spline polyline (screen space)
+    mutable RLCharts::SplineCache mSpline; // sampled spline polyline (screen space), reused per segment
     mutable std::vector<float> mSplineVis; // visibility along spline samples
     mutable std::vector<float> mCacheVis; // per cached point visibility [0..1]
+    mutable std::vector<uint8_t> mCacheOut;  // per point: outside-the-scale bits (left/right/below/above)
+    mutable std::vector<uint8_t> mSplineOut; // per spline sample: bits shared by its segment's end points
     mutable bool mDirty{ true };
 
     // Animation state (screen space independent; works in data space then mapped)
@@ -74,6 +99,16 @@ struct RLScatterSeries {
     mutable std::vector<float> mVisTarget;      // [0..1]
 };
 
+// Result of RLScatterPlot::getNearestPoint
+struct RLScatterHit {
+    bool mFound{ false };
+    size_t mSeries{ 0 };
+    size_t mIndex{ 0 };
+    Vector2 mData{ 0.0f, 0.0f };   // data-space position (animated)
+    Vector2 mScreen{ 0.0f, 0.0f }; // screen position
+    float mDistance{ 0.0f };       // pixels from the query point
+};
+
 class RLScatterPlot {
 public:
     explicit RLScatterPlot(Rectangle aBounds, const RLScatterPlotStyle &rStyle = {});
@@ -95,13 +130,56 @@ public:
 
     // Animated data update APIs
     void setSeriesTargetData(size_t aIndex, const std::vector<Vector2> &rData);
+    void setSeriesTargetData(size_t aIndex, std::span<const Vector2> aData);
+    // Separate x/y arrays; aStride is in floats, so interleaved {x,y,...} records work too
+    void setSeriesTargetData(size_t aIndex, const float *pX, const float *pY, size_t aCount, size_t aStride = 1);
     void setSingleSeriesTargetData(const std::vector<Vector2> &rData);
-
-    // Step animation (call each frame with dt seconds)
+    // The points a series animates towards (empty for an invalid index)
+    [[nodiscard]] std::span<const Vector2> getSeriesTargetData(size_t aIndex) const;
+
+    // Step animation (call each frame with dt seconds). update(dt) is prepare(dt)
+    // followed by commit(). prepare() steps the animation and bins density series
+    // whose points moved into the density heat map's staging, without GL calls, so
+    // it may run on a worker thread; commit() uploads the staged grid on the render
+    // thread. draw() then only draws (a chart drawn without update() bins there).
+    // Setters must not overlap prepare().
     void update(float aDt);
+    void prepare(float aDt);
+    void commit();
 
     // Draw chart
     void draw() const;
+    // Keep the background, grid and axes frame in a render texture that is
+    // re-rendered only after setBounds()/setStyle(), and draw just the series
+    // over it each frame (RLRenderCache.h). Off by default.
+    void setStaticLayerCache(bool aEnabled);
+    [[nodiscard]] const RLCharts::StaticLayer& getStaticLayer() const { return mStaticLayer; }
+    // Pool that bins density series (RLTaskPool.h); nullptr =
+    // RLCharts::TaskPool::shared(). The pool must outlive the chart.
+    void setTaskPool(RLCharts::TaskPool* pPool);
+    [[nodiscard]] RLCharts::TaskPool& getTaskPool() const {
+        return mpTaskPool != nullptr ? *mpTaskPool : RLCharts::TaskPool::shared();
+    }
+
+    // Settled once the last update() moved and faded nothing; needsRedraw() also
+    // covers setters since the last draw()
+    [[nodiscard]] bool isSettled() const { return mAnimSettled; }
+    [[nodiscard]] bool needsRedraw() const { return mRedrawPending || !isSettled(); }
+    // update()/rebuild/draw() timers and GPU counters (RLPerf.h); zero unless built with RLCHARTS_PERF
+    [[nodiscard]] const RLCharts::PerfStats& getPerfStats() const { return mPerf; }
+
+    // Closest drawn point to aScreenPos within aMaxDistancePx, e.g. for tooltips.
+    // Backed by a uniform grid over the screen-space points (RLSpatialGrid.h),
+    // rebuilt only after the points moved, so a query is sub-linear.
+    [[nodiscard]] RLScatterHit getNearestPoint(Vector2 aScreenPos, float aMaxDistancePx = 12.0f) const;
+
+    // True if series aIndex is drawn as a density grid (see mDensityThreshold)
+    [[nodiscard]] bool usesDensity(size_t aIndex) const;
+    // Binned values handed to the colormap (log-scaled if mDensityLog), row-major,
+    // getDensityCellsX() * getDensityCellsY() entries; empty without density series
+    [[nodiscard]] const std::vector<float>& getDensityGrid() const;
+    [[nodiscard]] int getDensityCellsX() const { return mDensityCellsX; }
+    [[nodiscard]] int getDensityCellsY() const { return mDensityCellsY; }
 
     // Helpers
     [[nodiscard]] Rectangle getBounds() const { return mBounds; }
@@ -120,12 +198,56 @@ private:
     mutable Rectangle mPlotRect{}; // bounds minus padding
     mutable bool mGeomDirty{ true };
 
+    // Batched lines (all series) followed by points (all series, instanced)
+    mutable RLCharts::LineBatch mBatch;
+    mutable RLCharts::CircleBatch mMarkers;
+    mutable bool mBatchDirty{ true };
+
+    // Hit-test index over the visible points
+    struct PickRef {
+        uint32_t mSeries;
+        uint32_t mIndex;
+    };
+    mutable RLCharts::SpatialGrid mPickGrid;
+    mutable std::vector<PickRef> mPickRefs;
+    mutable bool mPickDirty{ true };
+
+    // Density grid: per-task partial grids summed into mDensityGrid, colored by
+    // an RLHeatMap covering the plot rect (created with the first density series)
+    static constexpr size_t DENSITY_MIN_POINTS_PER_THREAD = 128 * 1024;
+    mutable std::vector<float> mDensityGrid;
+    mutable std::vector<float> mDensityPartials; // (tasks - 1) grids
+    mutable int mDensityCellsX{ 0 };
+    mutable int mDensityCellsY{ 0 };
+    mutable bool mDensityDirty{ true };
+    mutable bool mDensityMapDirty{ false }; // mDensityGrid not yet handed to mpDensityMap
+    mutable std::unique_ptr<RLHeatMap> mpDensityMap;
+    RLCharts::TaskPool* mpTaskPool{nullptr};
+
+    bool mAnimSettled{ false };
+    mutable bool mRedrawPending{ true }; // cleared by draw()
+    mutable RLCharts::PerfStats mPerf;
+    mutable RLCharts::StaticLayer mStaticLayer;
+
     void markAllDirty() const;
     [[nodiscard]] Rectangle plotRect() const;
     void ensureScale() const;
     [[nodiscard]] Vector2 mapPoint(const Vector2 &rPt) const;
+    [[nodiscard]] uint8_t outCode(const Vector2 &rPt) const;
+    void buildPickIndex() const;
+    void buildDensity() const;
+    void refreshDensity() const;
+    void densityGridSize(int &rCellsX, int &rCellsY) const;
+    void configureDensityMap() const;
+    static void binDensitySlice(const RLScatterSeries &rSeries, size_t aBegin, size_t aEnd, Rectangle aRect,
+                                float aInvCell, int aCellsX, int aCellsY, float *pGrid);
+    static void reduceDensityCells(float *pGrid, const float *pPartials, size_t aPartials, size_t aCells,
+                                   size_t aBegin, size_t aEnd, bool aLog);
+    void drawStaticLayer() const;
 
     void buildCaches() const;
+    void buildBatch() const;
 
     void ensureDynInitialized(const RLScatterSeries &rSeries) const;
+    void applyTargetData(RLScatterSeries &rSeries);
 };
@@ -1,6 +1,9 @@
 // RLTimeSeries.cpp
 #include "RLTimeSeries.h"
 #include "RLCommon.h"
+#include "RLRenderCache.h"
+#include "RLSimd.h"
+#include "RLStateCodec.h"
 #include <cmath>
 #include <algorithm>
 
@@ -18,19 +21,30 @@ RLTimeSeries::RLTimeSeries(Rectangle aBounds, size_t aWindowSize)
 // ============================================================================
 
 void RLTimeSeries::setBounds(Rectangle aBounds) {
+    markChanged();
     mBounds = aBounds;
+    mStaticLayer.invalidate();
     for (auto& lTrace : mTraces) {
         lTrace.mDirty = true;
+        lTrace.mFullRebuild = true;
     }
 }
 
 void RLTimeSeries::setStyle(const RLTimeSeriesChartStyle& rStyle) {
+    markChanged();
     mStyle = rStyle;
+    mStaticLayer.invalidate();
     for (auto& lTrace : mTraces) {
         lTrace.mDirty = true;
+        lTrace.mFullRebuild = true;
     }
 }
 
+void RLTimeSeries::setStaticLayerCache(bool aEnabled) {
+    mRedrawPending = true;
+    mStaticLayer.setEnabled(aEnabled);
+}
+
 void RLTimeSeries::setWindowSize(size_t aWindowSize) {
     if (aWindowSize == 0) {
         aWindowSize = 1;
@@ -38,27 +52,54 @@ void RLTimeSeries::setWindowSize(size_t aWindowSize) {
     if (aWindowSize == mWindowSize) {
         return;
     }
+    markChanged();
 
     const size_t lOldWindowSize = mWindowSize;
     mWindowSize = aWindowSize;
 
     // Resize all trace buffers
     for (auto& lTrace : mTraces) {
-        if (lTrace.mSamples.size() != mWindowSize) {
+        if (lTrace.mGroup == RLTimeSeriesTrace::NO_GROUP && lTrace.mSamples.size() != mWindowSize) {
             // Need to reorganize ring buffer
             std::vector<float> lNewBuffer(mWindowSize, 0.0f);
             const size_t lCopyCount = lTrace.mCount < mWindowSize ? lTrace.mCount : mWindowSize;
 
-            // Copy most recent samples
+            // Copy most recent samples (they end just before mHead, full or not)
             for (size_t i = 0; i < lCopyCount; ++i) {
-                const size_t lOldIdx = (lTrace.mHead + lTrace.mCount - lCopyCount + i) % lOldWindowSize;
+                const size_t lOldIdx = (lTrace.mHead + lOldWindowSize - lCopyCount + i) % lOldWindowSize;
                 lNewBuffer[i] = lTrace.mSamples[lOldIdx];
             }
 
             lTrace.mSamples = std::move(lNewBuffer);
             lTrace.mHead = mWindowSize > 0 ? lCopyCount % mWindowSize : 0;
             lTrace.mCount = lCopyCount;
+            resetExtrema(lTrace);
             lTrace.mDirty = true;
+            lTrace.mFullRebuild = true;
+        }
+    }
+
+    // Same for the channel groups, block by block
+    for (auto& rGroup : mGroups) {
+        RLTimeSeriesTrace& rFirst = mTraces[rGroup.mFirstTrace];
+        std::vector<float> lNewRing(mWindowSize * rGroup.mChannels, 0.0f);
+        const size_t lCopyCount = rFirst.mCount < mWindowSize ? rFirst.mCount : mWindowSize;
+        for (size_t c = 0; c < rGroup.mChannels; ++c) {
+            const float* pOld = rGroup.mRing.data() + c * lOldWindowSize;
+            float* pNew = lNewRing.data() + c * mWindowSize;
+            for (size_t i = 0; i < lCopyCount; ++i) {
+                pNew[i] = pOld[(rFirst.mHead + lOldWindowSize - lCopyCount + i) % lOldWindowSize];
+            }
+        }
+        rGroup.mRing = std::move(lNewRing);
+        rGroup.mScreenYValid = false;
+        for (size_t c = 0; c < rGroup.mChannels; ++c) {
+            RLTimeSeriesTrace& rTrace = mTraces[rGroup.mFirstTrace + c];
+            rTrace.mHead = lCopyCount % mWindowSize;
+            rTrace.mCount = lCopyCount;
+            resetExtrema(rTrace);
+            rTrace.mDirty = true;
+            rTrace.mFullRebuild = true;
         }
     }
 }
@@ -68,29 +109,57 @@ void RLTimeSeries::setWindowSize(size_t aWindowSize) {
 // ============================================================================
 
 size_t RLTimeSeries::addTrace(const RLTimeSeriesTraceStyle& aStyle) {
+    markChanged();
     RLTimeSeriesTrace lTrace;
     lTrace.mStyle = aStyle;
     lTrace.mSamples.resize(mWindowSize, 0.0f);
     lTrace.mHead = 0;
     lTrace.mCount = 0;
     lTrace.mDirty = true;
+    lTrace.mFullRebuild = true;
 
     mTraces.push_back(std::move(lTrace));
     return mTraces.size() - 1;
 }
 
+size_t RLTimeSeries::addChannelGroup(size_t aChannels, const RLTimeSeriesTraceStyle& aStyle) {
+    if (aChannels == 0) {
+        aChannels = 1;
+    }
+    ChannelGroup lGroup;
+    lGroup.mFirstTrace = mTraces.size();
+    lGroup.mChannels = aChannels;
+    lGroup.mRing.resize(mWindowSize * aChannels, 0.0f);
+    for (size_t c = 0; c < aChannels; ++c) {
+        RLTimeSeriesTrace& rTrace = mTraces[addTrace(aStyle)];
+        rTrace.mSamples.clear();
+        rTrace.mSamples.shrink_to_fit();
+        rTrace.mGroup = mGroups.size();
+        rTrace.mChannel = c;
+    }
+    mGroups.push_back(std::move(lGroup));
+    return mGroups.back().mFirstTrace;
+}
+
+bool RLTimeSeries::isGroupedTrace(size_t aTraceIndex) const {
+    return aTraceIndex < mTraces.size() && mTraces[aTraceIndex].mGroup != RLTimeSeriesTrace::NO_GROUP;
+}
+
 void RLTimeSeries::setTraceStyle(size_t aIndex, const RLTimeSeriesTraceStyle& rStyle) {
     if (aIndex >= mTraces.size()) {
         return;
     }
+    markChanged();
     mTraces[aIndex].mStyle = rStyle;
     mTraces[aIndex].mDirty = true;
+    mTraces[aIndex].mFullRebuild = true;
 }
 
 void RLTimeSeries::setTraceVisible(size_t aIndex, bool aVisible) {
     if (aIndex >= mTraces.size()) {
         return;
     }
+    markChanged();
     mTraces[aIndex].mStyle.mVisible = aVisible;
 }
 
@@ -98,16 +167,42 @@ void RLTimeSeries::clearTrace(size_t aIndex) {
     if (aIndex >= mTraces.size()) {
         return;
     }
-    mTraces[aIndex].mHead = 0;
-    mTraces[aIndex].mCount = 0;
-    mTraces[aIndex].mDirty = true;
+    markChanged();
+    // A group's channels share head and count, so they are cleared together
+    size_t lFirst = aIndex;
+    size_t lCount = 1;
+    if (isGroupedTrace(aIndex)) {
+        const ChannelGroup& rGroup = mGroups[mTraces[aIndex].mGroup];
+        rGroup.mScreenYValid = false;
+        lFirst = rGroup.mFirstTrace;
+        lCount = rGroup.mChannels;
+    }
+    for (size_t i = lFirst; i < lFirst + lCount; ++i) {
+        mTraces[i].mHead = 0;
+        mTraces[i].mCount = 0;
+        mTraces[i].mExtrema.clear();
+        mTraces[i].mDirty = true;
+        mTraces[i].mFullRebuild = true;
+        if (mTraces[i].mHistory) {
+            mTraces[i].mHistory->clear();
+        }
+    }
 }
 
 void RLTimeSeries::clearAllTraces() {
+    markChanged();
     for (auto& lTrace : mTraces) {
         lTrace.mHead = 0;
         lTrace.mCount = 0;
+        lTrace.mExtrema.clear();
         lTrace.mDirty = true;
+        lTrace.mFullRebuild = true;
+        if (lTrace.mHistory) {
+            lTrace.mHistory->clear();
+        }
+    }
+    for (auto& rGroup : mGroups) {
+        rGroup.mScreenYValid = false;
     }
 }
 
@@ -118,38 +213,351 @@ size_t RLTimeSeries::getTraceSampleCount(size_t aIndex) const {
     return mTraces[aIndex].mCount;
 }
 
+size_t RLTimeSeries::getTraceScreenPointCount(size_t aIndex) const {
+    if (aIndex >= mTraces.size()) {
+        return 0;
+    }
+    const RLTimeSeriesTrace& rTrace = mTraces[aIndex];
+    if (rTrace.mDirty) {
+        rebuildScreenPoints(aIndex);
+        rTrace.mDirty = false;
+    }
+    return rTrace.mScreenPoints.size();
+}
+
+void RLTimeSeries::getTraceScreenPoints(size_t aIndex, std::vector<Vector2>& rOut, bool aSpline) const {
+    rOut.clear();
+    if (aIndex >= mTraces.size()) {
+        return;
+    }
+    const RLTimeSeriesTrace& rTrace = mTraces[aIndex];
+    if (rTrace.mDirty) {
+        rebuildScreenPoints(aIndex);
+        rTrace.mDirty = false;
+    }
+    const RLCharts::RingQueue<Vector2>& rPoints = aSpline ? rTrace.mSplineCache : rTrace.mScreenPoints;
+    rOut.reserve(rPoints.size());
+    for (size_t i = 0; i < rPoints.size(); ++i) {
+        rOut.push_back({ rPoints[i].x - rTrace.mScreenShiftX, rPoints[i].y });
+    }
+}
+
 // ============================================================================
 // Sample Input
 // ============================================================================
 
 void RLTimeSeries::pushSample(size_t aTraceIndex, float aValue) {
-    if (aTraceIndex >= mTraces.size()) {
+    if (aTraceIndex >= mTraces.size() || isGroupedTrace(aTraceIndex)) {
         return;
     }
+    markChanged();
 
     RLTimeSeriesTrace& rTrace = mTraces[aTraceIndex];
+    if (rTrace.mHistory) {
+        rTrace.mHistory->append(aValue);
+    }
     rTrace.mSamples[rTrace.mHead] = aValue;
+    trackExtrema(rTrace, &aValue, 1);
     rTrace.mHead = (rTrace.mHead + 1) % mWindowSize;
     if (rTrace.mCount < mWindowSize) {
         rTrace.mCount++;
     }
+    if (rTrace.mPendingSamples < mWindowSize) {
+        rTrace.mPendingSamples++;
+    }
     rTrace.mDirty = true;
 }
 
 bool RLTimeSeries::pushSamples(size_t aTraceIndex, const std::vector<float>& rValues) {
-    if (rValues.empty() || aTraceIndex >= mTraces.size()) {
+    return pushSamples(aTraceIndex, std::span<const float>(rValues.data(), rValues.size()));
+}
+
+bool RLTimeSeries::pushSamples(size_t aTraceIndex, std::span<const float> aValues) {
+    if (aValues.empty() || aTraceIndex >= mTraces.size() || isGroupedTrace(aTraceIndex)) {
         return false;
     }
+    markChanged();
 
-    RLTimeSeriesTrace& rTrace = mTraces[aTraceIndex];
-    for (size_t i = 0; i < rValues.size(); ++i) {
-        rTrace.mSamples[rTrace.mHead] = rValues[i];
-        rTrace.mHead = (rTrace.mHead + 1) % mWindowSize;
-        if (rTrace.mCount < mWindowSize) {
-            rTrace.mCount++;
+    appendSamples(mTraces[aTraceIndex], aValues.data(), aValues.size());
+    return true;
+}
+
+void RLTimeSeries::appendSamples(RLTimeSeriesTrace& rTrace, const float* pValues, size_t aCount) {
+    if (aCount == 0) {
+        return;
+    }
+    if (rTrace.mHistory) {
+        rTrace.mHistory->append(std::span<const float>(pValues, aCount));
+    }
+
+    // Only the newest mWindowSize samples can survive
+    if (aCount > mWindowSize) {
+        const size_t lSkip = aCount - mWindowSize;
+        rTrace.mHead = (rTrace.mHead + lSkip) % mWindowSize;
+        pValues += lSkip;
+        aCount = mWindowSize;
+    }
+    trackExtrema(rTrace, pValues, aCount);
+
+    // Copy in at most two contiguous runs (split at the ring wrap)
+    size_t lRemaining = aCount;
+    while (lRemaining > 0) {
+        const size_t lRun = std::min(lRemaining, mWindowSize - rTrace.mHead);
+        std::copy(pValues, pValues + lRun, rTrace.mSamples.data() + rTrace.mHead);
+        rTrace.mHead = (rTrace.mHead + lRun) % mWindowSize;
+        pValues += lRun;
+        lRemaining -= lRun;
+    }
+
+    rTrace.mCount = std::min(rTrace.mCount + aCount, mWindowSize);
+    rTrace.mPendingSamples = std::min(rTrace.mPendingSamples + aCount, mWindowSize);
+    rTrace.mDirty = true;
+}
+
+bool RLTimeSeries::pushFrame(size_t aFirstTrace, const float* pValues, size_t aChannels) {
+    return pushFrames(aFirstTrace, pValues, 1, aChannels);
+}
+
+bool RLTimeSeries::pushFrames(size_t aFirstTrace, const float* pFrames, size_t aFrameCount, size_t aChannels) {
+    if (pFrames == nullptr || aFrameCount == 0 || !isGroupedTrace(aFirstTrace)) {
+        return false;
+    }
+    ChannelGroup& rGroup = mGroups[mTraces[aFirstTrace].mGroup];
+    if (rGroup.mFirstTrace != aFirstTrace || rGroup.mChannels != aChannels) {
+        return false;
+    }
+    markChanged();
+    rGroup.mScreenYValid = false;
+
+    for (size_t c = 0; c < aChannels; ++c) {
+        RLCharts::SamplePyramid* pHistory = mTraces[aFirstTrace + c].mHistory.get();
+        if (pHistory != nullptr) {
+            for (size_t f = 0; f < aFrameCount; ++f) {
+                pHistory->append(pFrames[f * aChannels + c]);
+            }
+        }
+    }
+
+    // Only the newest mWindowSize frames can survive
+    size_t lHead = mTraces[aFirstTrace].mHead;
+    size_t lFrames = aFrameCount;
+    if (lFrames > mWindowSize) {
+        const size_t lSkip = lFrames - mWindowSize;
+        lHead = (lHead + lSkip) % mWindowSize;
+        pFrames += lSkip * aChannels;
+        lFrames = mWindowSize;
+    }
+    for (size_t c = 0; c < aChannels; ++c) {
+        trackExtrema(mTraces[aFirstTrace + c], pFrames + c, lFrames, aChannels);
+    }
+
+    // Transpose into the channel blocks in at most two runs (split at the ring wrap)
+    size_t lRemaining = lFrames;
+    while (lRemaining > 0) {
+        const size_t lRun = std::min(lRemaining, mWindowSize - lHead);
+        for (size_t c = 0; c < aChannels; ++c) {
+            float* pDst = rGroup.mRing.data() + c * mWindowSize + lHead;
+            const float* pSrc = pFrames + c;
+            for (size_t f = 0; f < lRun; ++f) {
+                pDst[f] = pSrc[f * aChannels];
+            }
         }
+        lHead = (lHead + lRun) % mWindowSize;
+        pFrames += lRun * aChannels;
+        lRemaining -= lRun;
+    }
+
+    for (size_t c = 0; c < aChannels; ++c) {
+        RLTimeSeriesTrace& rTrace = mTraces[aFirstTrace + c];
+        rTrace.mHead = lHead;
+        rTrace.mCount = std::min(rTrace.mCount + lFrames, mWindowSize);
+        rTrace.mPendingSamples = std::min(rTrace.mPendingSamples + lFrames, mWindowSize);
+        rTrace.mDirty = true;
     }
+    return true;
+}
+
+// ============================================================================
+// Cross-thread ingest
+// ============================================================================
+
+RLTimeSeries::Producer RLTimeSeries::createProducer(size_t aTraceIndex, size_t aCapacity) {
+    if (aTraceIndex >= mTraces.size() || isGroupedTrace(aTraceIndex)) {
+        return Producer{};
+    }
+    mProducers.push_back(std::make_unique<ProducerQueue>(aTraceIndex, aCapacity > 0 ? aCapacity : 1));
+    return Producer{ &mProducers.back()->mRing };
+}
+
+bool RLTimeSeries::Producer::push(float aValue) {
+    return mpQueue != nullptr && mpQueue->push(aValue);
+}
+
+size_t RLTimeSeries::Producer::push(const float* pValues, size_t aCount) {
+    if (mpQueue == nullptr || pValues == nullptr) {
+        return 0;
+    }
+    return mpQueue->push(pValues, aCount);
+}
+
+void RLTimeSeries::drainProducers() {
+    for (auto& rpQueue : mProducers) {
+        RLTimeSeriesTrace& rTrace = mTraces[rpQueue->mTraceIndex];
+        rpQueue->mRing.consume([&](const float* pData, size_t aCount) {
+            appendSamples(rTrace, pData, aCount);
+            markChanged();
+        });
+    }
+}
+
+// ============================================================================
+// History
+// ============================================================================
+
+bool RLTimeSeries::setTraceHistoryEnabled(size_t aIndex, bool aEnabled, const char* pSpillPath) {
+    if (aIndex >= mTraces.size()) {
+        return false;
+    }
+    markChanged();
+    RLTimeSeriesTrace& rTrace = mTraces[aIndex];
     rTrace.mDirty = true;
+    rTrace.mFullRebuild = true;
+    if (!aEnabled) {
+        rTrace.mHistory.reset();
+        return true;
+    }
+    if (!rTrace.mHistory) {
+        rTrace.mHistory = std::make_unique<RLCharts::SamplePyramid>();
+    }
+    if (pSpillPath != nullptr) {
+        return rTrace.mHistory->enableSpill(pSpillPath);
+    }
+    rTrace.mHistory->disableSpill();
+    return true;
+}
+
+const RLCharts::SamplePyramid* RLTimeSeries::getTraceHistory(size_t aIndex) const {
+    if (aIndex >= mTraces.size()) {
+        return nullptr;
+    }
+    return mTraces[aIndex].mHistory.get();
+}
+
+void RLTimeSeries::setHistoryView(size_t aFirst, size_t aCount) {
+    markChanged();
+    mHistoryView = true;
+    mHistoryFirst = aFirst;
+    mHistoryCount = aCount > 2 ? aCount : 2;
+    for (auto& lTrace : mTraces) {
+        lTrace.mDirty = true;
+        lTrace.mFullRebuild = true;
+    }
+}
+
+void RLTimeSeries::setLiveView() {
+    markChanged();
+    mHistoryView = false;
+    for (auto& lTrace : mTraces) {
+        lTrace.mDirty = true;
+        lTrace.mFullRebuild = true;
+    }
+}
+
+// ============================================================================
+// State
+// ============================================================================
+
+namespace RLCharts {
+
+static constexpr uint32_t TIMESERIES_STATE_TAG = stateTag("TSER");
+
+} // namespace RLCharts
+
+std::vector<uint8_t> RLTimeSeries::saveState() const {
+    RLCharts::StateWriter lWriter;
+    lWriter.writeU32((uint32_t)mTraces.size());
+    lWriter.writeF32(mCurrentMinY);
+    lWriter.writeF32(mCurrentMaxY);
+    lWriter.writeF32(mTargetMinY);
+    lWriter.writeF32(mTargetMaxY);
+    std::vector<float> lOrdered;
+    for (const auto& rTrace : mTraces) {
+        // Oldest to newest, so the restored ring does not depend on the saved head
+        const float* pRing = ringData(rTrace);
+        const size_t lStart = (rTrace.mHead + mWindowSize - rTrace.mCount) % mWindowSize;
+        lOrdered.resize(rTrace.mCount);
+        for (size_t i = 0; i < rTrace.mCount; ++i) {
+            lOrdered[i] = pRing[(lStart + i) % mWindowSize];
+        }
+        lWriter.writeU32((uint32_t)rTrace.mCount);
+        lWriter.writeFloats(lOrdered);
+    }
+    return lWriter.finish(RLCharts::TIMESERIES_STATE_TAG);
+}
+
+bool RLTimeSeries::loadState(std::span<const uint8_t> aState) {
+    // Parse everything before touching the chart
+    RLCharts::StateReader lReader;
+    uint32_t lTraceCount = 0;
+    float lScale[4] = {};
+    if (!lReader.open(aState, RLCharts::TIMESERIES_STATE_TAG) || !lReader.readU32(lTraceCount) ||
+        lTraceCount != mTraces.size()) {
+        return false;
+    }
+    for (float& rValue : lScale) {
+        if (!lReader.readF32(rValue)) {
+            return false;
+        }
+    }
+    std::vector<std::vector<float>> lSamples(lTraceCount);
+    for (auto& rSamples : lSamples) {
+        uint32_t lCount = 0;
+        if (!lReader.readU32(lCount) || !lReader.readFloats(rSamples, lCount)) {
+            return false;
+        }
+    }
+    if (!lReader.atEnd()) {
+        return false;
+    }
+    // A group's channels share one head and count
+    for (const auto& rGroup : mGroups) {
+        for (size_t c = 1; c < rGroup.mChannels; ++c) {
+            if (lSamples[rGroup.mFirstTrace + c].size() != lSamples[rGroup.mFirstTrace].size()) {
+                return false;
+            }
+        }
+    }
+
+    markChanged();
+    for (size_t t = 0; t < mTraces.size(); ++t) {
+        RLTimeSeriesTrace& rTrace = mTraces[t];
+        const std::vector<float>& rSamples = lSamples[t];
+        const size_t lKeep = std::min(rSamples.size(), mWindowSize);
+        float* pRing = rTrace.mGroup == RLTimeSeriesTrace::NO_GROUP
+            ? rTrace.mSamples.data()
+            : mGroups[rTrace.mGroup].mRing.data() + rTrace.mChannel * mWindowSize;
+        std::copy(rSamples.end() - (std::ptrdiff_t)lKeep, rSamples.end(), pRing);
+        rTrace.mHead = lKeep % mWindowSize;
+        rTrace.mCount = lKeep;
+        resetExtrema(rTrace);
+        if (rTrace.mHistory) {
+            rTrace.mHistory->clear();
+            rTrace.mHistory->append(std::span<const float>(pRing, lKeep));
+        }
+        rTrace.mPendingSamples = 0;
+        rTrace.mDirty = true;
+        rTrace.mFullRebuild = true;
+    }
+    for (auto& rGroup : mGroups) {
+        rGroup.mScreenYValid = false;
+    }
+    // Start at the saved scale instead of animating towards it from the default
+    if (lScale[0] < lScale[1] && lScale[2] < lScale[3]) {
+        mCurrentMinY = lScale[0];
+        mCurrentMaxY = lScale[1];
+        mTargetMinY = lScale[2];
+        mTargetMaxY = lScale[3];
+    }
     return true;
 }
 
@@ -157,7 +565,25 @@ bool RLTimeSeries::pushSamples(size_t aTraceIndex, const std::vector<float>& rVa
 // Update
 // ============================================================================
 
+bool RLTimeSeries::isSettled() const {
+    if (!mScaleSettled) {
+        return false;
+    }
+    for (const auto& rpQueue : mProducers) {
+        if (!rpQueue->mRing.empty()) {
+            return false;
+        }
+    }
+    return true;
+}
+
 void RLTimeSeries::update(float aDt) {
+    RLCHARTS_PERF_UPDATE(mPerf, "RLTimeSeries::update");
+    drainProducers();
+    if (mScaleSettled) {
+        return;
+    }
+    mRedrawPending = true;
     updateScale(aDt);
 }
 
@@ -172,20 +598,29 @@ void RLTimeSeries::updateScale(float aDt) {
         bool lHasData = false;
 
         for (const auto& lTrace : mTraces) {
+            if (mHistoryView) {
+                // The pyramid answers for the whole view range at once
+                float lMin = 0.0f;
+                float lMax = 0.0f;
+                if (!lTrace.mStyle.mVisible || !lTrace.mHistory ||
+                    !lTrace.mHistory->extent(mHistoryFirst, mHistoryCount, lMin, lMax)) {
+                    continue;
+                }
+                lDataMin = lHasData ? std::min(lMin, lDataMin) : lMin;
+                lDataMax = lHasData ? std::max(lMax, lDataMax) : lMax;
+                lHasData = true;
+                continue;
+            }
             if (!lTrace.mStyle.mVisible || lTrace.mCount == 0) {
                 continue;
             }
 
-            for (size_t i = 0; i < lTrace.mCount; ++i) {
-                const float lVal = getSample(lTrace, i);
-                if (!lHasData) {
-                    lDataMin = lDataMax = lVal;
-                    lHasData = true;
-                } else {
-                    lDataMin = std::min(lVal, lDataMin);
-                    lDataMax = std::max(lVal, lDataMax);
-                }
-            }
+            // O(1) per trace whatever the window size
+            const float lMin = lTrace.mExtrema.getMin();
+            const float lMax = lTrace.mExtrema.getMax();
+            lDataMin = lHasData ? std::min(lMin, lDataMin) : lMin;
+            lDataMax = lHasData ? std::max(lMax, lDataMax) : lMax;
+            lHasData = true;
         }
 
         if (lHasData) {
@@ -216,6 +651,7 @@ void RLTimeSeries::updateScale(float aDt) {
             lTrace.mDirty = true;
         }
     }
+    mScaleSettled = RLCharts::nearlyEqual(mCurrentMinY, mTargetMinY) && RLCharts::nearlyEqual(mCurrentMaxY, mTargetMaxY);
 }
 
 // ============================================================================
@@ -223,31 +659,21 @@ void RLTimeSeries::updateScale(float aDt) {
 // ============================================================================
 
 void RLTimeSeries::draw() const {
+    RLCHARTS_PERF_DRAW(mPerf, "RLTimeSeries::draw");
+    mRedrawPending = false;
     const Rectangle lPlotArea = getPlotArea();
 
-    // Background
-    if (mStyle.mShowBackground) {
-        DrawRectangleRec(mBounds, mStyle.mBackground);
-    }
-
-    // Grid
-    if (mStyle.mShowGrid) {
-        drawGrid();
-    }
-
-    // Axes
-    if (mStyle.mShowAxes) {
-        drawAxes();
-    }
+    // Background, grid and axes (cached if enabled)
+    mStaticLayer.draw(mBounds, 0, [this]() { drawStaticLayer(); });
 
     // Clip to plot area
-    BeginScissorMode((int)lPlotArea.x, (int)lPlotArea.y,
-                     (int)lPlotArea.width, (int)lPlotArea.height);
+    RLCharts::beginChartScissor((int)lPlotArea.x, (int)lPlotArea.y,
+                                (int)lPlotArea.width, (int)lPlotArea.height);
 
     // Draw all visible traces
     for (size_t i = 0; i < mTraces.size(); ++i) {
         const RLTimeSeriesTrace& rTrace = mTraces[i];
-        if (!rTrace.mStyle.mVisible || rTrace.mCount < 2) {
+        if (!rTrace.mStyle.mVisible || (mHistoryView ? !rTrace.mHistory : rTrace.mCount < 2)) {
             continue;
         }
 
@@ -262,6 +688,18 @@ void RLTimeSeries::draw() const {
     EndScissorMode();
 }
 
+void RLTimeSeries::drawStaticLayer() const {
+    if (mStyle.mShowBackground) {
+        DrawRectangleRec(mBounds, mStyle.mBackground);
+    }
+    if (mStyle.mShowGrid) {
+        drawGrid();
+    }
+    if (mStyle.mShowAxes) {
+        drawAxes();
+    }
+}
+
 void RLTimeSeries::drawGrid() const {
     const Rectangle lPlotArea = getPlotArea();
 
@@ -295,27 +733,41 @@ void RLTimeSeries::drawAxes() const {
 }
 
 void RLTimeSeries::drawTrace(const RLTimeSeriesTrace& rTrace) const {
-    const RLTimeSeriesTraceStyle& rStyle = rTrace.mStyle;
-
-    if (rStyle.mLineMode == RLTimeSeriesLineMode::Spline && rTrace.mSplineCache.size() >= 2) {
-        // Draw spline
-        for (size_t i = 0; i < rTrace.mSplineCache.size() - 1; ++i) {
-            DrawLineEx(rTrace.mSplineCache[i], rTrace.mSplineCache[i + 1],
-                       rStyle.mLineThickness, rStyle.mColor);
+    if (rTrace.mBatchDirty) {
+        const RLTimeSeriesTraceStyle& rStyle = rTrace.mStyle;
+        rTrace.mBatch.clear();
+        rTrace.mMarkers.clear();
+
+        // Spline or linear segments, straight from the ring (at most two runs)
+        const bool lSpline = rStyle.mLineMode == RLTimeSeriesLineMode::Spline && rTrace.mSplineCache.size() >= 2;
+        const RLCharts::RingQueue<Vector2>& rLine = lSpline ? rTrace.mSplineCache : rTrace.mScreenPoints;
+        if (rLine.size() >= 2) {
+            const Vector2* pFirst = nullptr;
+            const Vector2* pSecond = nullptr;
+            const size_t lFirstCount = rLine.firstRun(pFirst);
+            const size_t lSecondCount = rLine.secondRun(pSecond);
+            rTrace.mBatch.addPolyline(pFirst, lFirstCount, pSecond, lSecondCount,
+                                      rStyle.mLineThickness, rStyle.mColor);
         }
-    } else if (rTrace.mScreenPoints.size() >= 2) {
-        // Draw linear segments
-        for (size_t i = 0; i < rTrace.mScreenPoints.size() - 1; ++i) {
-            DrawLineEx(rTrace.mScreenPoints[i], rTrace.mScreenPoints[i + 1],
-                       rStyle.mLineThickness, rStyle.mColor);
+
+        // Draw points if enabled
+        if (rStyle.mShowPoints) {
+            for (size_t i = 0; i < rTrace.mScreenPoints.size(); ++i) {
+                rTrace.mMarkers.add(rTrace.mScreenPoints[i], rStyle.mPointRadius, rStyle.mColor);
+            }
         }
+        rTrace.mBatchDirty = false;
     }
 
-    // Draw points if enabled
-    if (rStyle.mShowPoints && !rTrace.mScreenPoints.empty()) {
-        for (const auto& lPt : rTrace.mScreenPoints) {
-            DrawCircleV(lPt, rStyle.mPointRadius, rStyle.mColor);
-        }
+    const bool lShifted = rTrace.mScreenShiftX != 0.0f;
+    if (lShifted) {
+        rlPushMatrix();
+        rlTranslatef(-rTrace.mScreenShiftX, 0.0f, 0.0f);
+    }
+    rTrace.mBatch.draw();
+    rTrace.mMarkers.draw();
+    if (lShifted) {
+        rlPopMatrix();
     }
 }
 
@@ -333,26 +785,61 @@ Rectangle RLTimeSeries::getPlotArea() const {
     };
 }
 
-float RLTimeSeries::getSample(const RLTimeSeriesTrace& rTrace, size_t aIndex) {
-    // Get sample at logical index (0 = oldest, mCount-1 = newest)
-    if (aIndex >= rTrace.mCount) {
-        return 0.0f;
+const float* RLTimeSeries::ringData(const RLTimeSeriesTrace& rTrace) const {
+    if (rTrace.mGroup == RLTimeSeriesTrace::NO_GROUP) {
+        return rTrace.mSamples.data();
+    }
+    return mGroups[rTrace.mGroup].mRing.data() + rTrace.mChannel * mWindowSize;
+}
+
+void RLTimeSeries::trackExtrema(RLTimeSeriesTrace& rTrace, const float* pValues, size_t aCount,
+                                size_t aStride) {
+    // Keeps mExtrema on the newest mWindowSize samples; call with the samples
+    // that actually enter the ring (at most mWindowSize)
+    if (aCount >= mWindowSize) {
+        rTrace.mExtrema.clear();
+    }
+    for (size_t i = 0; i < aCount; ++i) {
+        rTrace.mExtrema.push(pValues[i * aStride]);
+        if (rTrace.mExtrema.size() > mWindowSize) {
+            rTrace.mExtrema.popFront();
+        }
+    }
+}
+
+void RLTimeSeries::resetExtrema(RLTimeSeriesTrace& rTrace) {
+    rTrace.mExtrema.clear();
+    const float* pRing = ringData(rTrace);
+    const size_t lStart = (rTrace.mHead + mWindowSize - rTrace.mCount) % mWindowSize;
+    for (size_t i = 0; i < rTrace.mCount; ++i) {
+        rTrace.mExtrema.push(pRing[(lStart + i) % mWindowSize]);
     }
-    const size_t lBufferSize = rTrace.mSamples.size();
-    const size_t lStart = (rTrace.mHead + lBufferSize - rTrace.mCount) % lBufferSize;
-    const size_t lActualIdx = (lStart + aIndex) % lBufferSize;
-    return rTrace.mSamples[lActualIdx];
 }
 
 void RLTimeSeries::rebuildScreenPoints(size_t aTraceIndex) const {
+    RLCHARTS_PERF_REBUILD(mPerf, "RLTimeSeries::rebuildScreenPoints");
     if (aTraceIndex >= mTraces.size()) {
         return;
     }
 
     const RLTimeSeriesTrace& rTrace = mTraces[aTraceIndex];
+    const size_t lNewSamples = rTrace.mPendingSamples;
+    rTrace.mPendingSamples = 0;
+    rTrace.mBatchDirty = true;
+
+    if (mHistoryView) {
+        clearScreenPoints(rTrace);
+        rTrace.mFullRebuild = true;
+        if (rTrace.mHistory) {
+            float lHistoryRange = mCurrentMaxY - mCurrentMinY;
+            buildHistoryPoints(rTrace, getPlotArea(), lHistoryRange < 0.0001f ? 1.0f : lHistoryRange);
+        }
+        return;
+    }
+
     if (rTrace.mCount < 2) {
-        rTrace.mScreenPoints.clear();
-        rTrace.mSplineCache.clear();
+        clearScreenPoints(rTrace);
+        rTrace.mFullRebuild = true;
         return;
     }
 
@@ -362,73 +849,308 @@ void RLTimeSeries::rebuildScreenPoints(size_t aTraceIndex) const {
         lYRange = 1.0f;
     }
 
-    // Build screen points
-    rTrace.mScreenPoints.resize(rTrace.mCount);
-
     // Calculate X spacing based on window size (full width = full window)
     // During build-up phase, data fills from left toward right
     const float lXStep = lPlotArea.width / (float)(mWindowSize - 1);
 
-    for (size_t i = 0; i < rTrace.mCount; ++i) {
-        const float lVal = getSample(rTrace, i);
+    // More than one sample per pixel column: reduce to min/max per column
+    if (rTrace.mStyle.mDecimate && lXStep < 1.0f) {
+        clearScreenPoints(rTrace);
+        buildDecimatedPoints(rTrace, lPlotArea, lXStep, lYRange);
+        rTrace.mFullRebuild = true;
+        return;
+    }
+
+    // Incremental path: with an unchanged Y scale the cached points are still valid,
+    // they only move left by the number of samples that dropped out of the window.
+    // A full remap every few windows of scrolling keeps the stored x bounded.
+    const size_t lOldCount = rTrace.mScreenPoints.size();
+    const bool lAppend = !rTrace.mFullRebuild &&
+                         rTrace.mCachedMinY == mCurrentMinY && rTrace.mCachedMaxY == mCurrentMaxY &&
+                         lNewSamples < rTrace.mCount && lOldCount + lNewSamples >= rTrace.mCount &&
+                         lOldCount + lNewSamples - rTrace.mCount + 2 <= lOldCount &&
+                         rTrace.mScreenSeq + lNewSamples <= SCREEN_REBASE_WINDOWS * mWindowSize;
+
+    rTrace.mFullRebuild = false;
+    rTrace.mCachedMinY = mCurrentMinY;
+    rTrace.mCachedMaxY = mCurrentMaxY;
+
+    const bool lSplineMode = rTrace.mStyle.mLineMode == RLTimeSeriesLineMode::Spline && rTrace.mCount >= 4;
+
+    if (!lAppend) {
+        clearScreenPoints(rTrace);
+        rTrace.mScreenPoints.reserve(mWindowSize);
+        mapScreenPoints(rTrace, 0, lPlotArea, lXStep, lYRange);
+        if (lSplineMode) {
+            rebuildSplineFrom(rTrace, 0);
+        }
+        return;
+    }
+
+    // Drop the samples that left the window and map only the new ones; the kept
+    // points stay where they are in the ring and the draw shift grows instead
+    const size_t lDropped = lOldCount + lNewSamples - rTrace.mCount;
+    const size_t lKept = lOldCount - lDropped;
+    rTrace.mScreenPoints.popFront(lDropped);
+    rTrace.mScreenSeq += lDropped;
+    rTrace.mScreenShiftX = lXStep * (float)rTrace.mScreenSeq;
+    mapScreenPoints(rTrace, lKept, lPlotArea, lXStep, lYRange);
+
+    if (!lSplineMode) {
+        rTrace.mSplineCache.clear();
+        rTrace.mSplineSegmentStart.clear();
+        return;
+    }
+
+    // Spline segments only depend on their four control points, so apart from the
+    // head (lost its left neighbour) and the old tail (gains a right neighbour) the
+    // tessellation is reused in place
+    if (rTrace.mSplineSegmentStart.size() + 1 != lOldCount || lKept < 3) {
+        rTrace.mSplineCache.clear();
+        rTrace.mSplineSegmentStart.clear();
+        rebuildSplineFrom(rTrace, 0);
+        return;
+    }
+    if (lDropped > 0) {
+        retessellateSplineHead(rTrace, lDropped);
+    }
+    rebuildSplineFrom(rTrace, lKept - 2);
+}
+
+void RLTimeSeries::clearScreenPoints(const RLTimeSeriesTrace& rTrace) const {
+    rTrace.mScreenPoints.clear();
+    rTrace.mSplineCache.clear();
+    rTrace.mSplineSegmentStart.clear();
+    rTrace.mScreenSeq = 0;
+    rTrace.mScreenShiftX = 0.0f;
+}
+
+void RLTimeSeries::mapGroupScreenY(const ChannelGroup& rGroup, const Rectangle& rPlotArea, float aYRange) const {
+    // y = top + height * (1 - (v - min) / range), as one scale-and-offset pass over
+    // every channel, shared by all channels remapped at this scale
+    if (rGroup.mScreenYValid && rGroup.mCachedMinY == mCurrentMinY && rGroup.mCachedMaxY == mCurrentMaxY &&
+        rGroup.mCachedTop == rPlotArea.y && rGroup.mCachedHeight == rPlotArea.height) {
+        return;
+    }
+    const float lScale = -rPlotArea.height / aYRange;
+    const float lOffset = rPlotArea.y + rPlotArea.height * (1.0f + mCurrentMinY / aYRange);
+    rGroup.mScreenY.resize(rGroup.mRing.size());
+    RLCharts::scaleOffset(rGroup.mRing.data(), rGroup.mScreenY.data(), rGroup.mRing.size(), lScale, lOffset);
+    rGroup.mScreenYValid = true;
+    rGroup.mCachedMinY = mCurrentMinY;
+    rGroup.mCachedMaxY = mCurrentMaxY;
+    rGroup.mCachedTop = rPlotArea.y;
+    rGroup.mCachedHeight = rPlotArea.height;
+}
+
+void RLTimeSeries::mapScreenPoints(const RLTimeSeriesTrace& rTrace, size_t aFirst, const Rectangle& rPlotArea,
+                                   float aXStep, float aYRange) const {
+    const size_t lBufferSize = mWindowSize;
+    size_t lBufIdx = (rTrace.mHead + lBufferSize - rTrace.mCount + aFirst) % lBufferSize;
+
+    // Full remap of a channel: read the group's mapped Y block
+    if (aFirst == 0 && rTrace.mGroup != RLTimeSeriesTrace::NO_GROUP) {
+        const ChannelGroup& rGroup = mGroups[rTrace.mGroup];
+        mapGroupScreenY(rGroup, rPlotArea, aYRange);
+        const float* pScreenY = rGroup.mScreenY.data() + rTrace.mChannel * mWindowSize;
+        for (size_t i = 0; i < rTrace.mCount; ++i) {
+            rTrace.mScreenPoints.pushBack({ rPlotArea.x + aXStep * (float)(rTrace.mScreenSeq + i), pScreenY[lBufIdx] });
+            if (++lBufIdx == lBufferSize) {
+                lBufIdx = 0;
+            }
+        }
+        return;
+    }
+
+    const float* pRing = ringData(rTrace);
+    for (size_t i = aFirst; i < rTrace.mCount; ++i) {
+        const float lVal = pRing[lBufIdx];
+        if (++lBufIdx == lBufferSize) {
+            lBufIdx = 0;
+        }
 
         // X: position based on sample index within the window
         // Oldest sample at left, newest at right
-        const float lX = lPlotArea.x + lXStep * (float)i;
+        const float lX = rPlotArea.x + aXStep * (float)(rTrace.mScreenSeq + i);
 
         // Y: map value to screen (inverted: higher values = lower Y)
-        const float lNormY = (lVal - mCurrentMinY) / lYRange;
-        const float lY = lPlotArea.y + lPlotArea.height * (1.0f - lNormY);
+        const float lNormY = (lVal - mCurrentMinY) / aYRange;
+        const float lY = rPlotArea.y + rPlotArea.height * (1.0f - lNormY);
+
+        rTrace.mScreenPoints.pushBack({ lX, lY });
+    }
+}
+
+size_t RLTimeSeries::splineSegmentSteps(const RLTimeSeriesTrace& rTrace, size_t aSegment) const {
+    const RLCharts::RingQueue<Vector2>& rPts = rTrace.mScreenPoints;
+    const size_t lI0 = (aSegment > 0) ? aSegment - 1 : 0;
+    const size_t lI3 = (aSegment + 2 < rPts.size()) ? aSegment + 2 : rPts.size() - 1;
+    return RLCharts::splineSegmentSteps(rPts[lI0], rPts[aSegment], rPts[aSegment + 1], rPts[lI3],
+                                        mStyle.mSplinePixels, mStyle.mSplineTolerancePx);
+}
+
+void RLTimeSeries::tessellateSplineSegment(const RLTimeSeriesTrace& rTrace, size_t aSegment,
+                                           Vector2* pOut, size_t aSteps) const {
+    // Get control points for Catmull-Rom
+    const RLCharts::RingQueue<Vector2>& rPts = rTrace.mScreenPoints;
+    const size_t lI0 = (aSegment > 0) ? aSegment - 1 : 0;
+    const size_t lI3 = (aSegment + 2 < rPts.size()) ? aSegment + 2 : rPts.size() - 1;
+    RLCharts::tessellateSplineSegment(rPts[lI0], rPts[aSegment], rPts[aSegment + 1], rPts[lI3], aSteps, pOut);
+}
+
+void RLTimeSeries::rebuildSplineFrom(const RLTimeSeriesTrace& rTrace, size_t aFirstSegment) const {
+    // Cache layout: the points of every segment back to back, then the final screen point
+    RLCharts::RingQueue<Vector2>& rCache = rTrace.mSplineCache;
+    RLCharts::RingQueue<uint64_t>& rStarts = rTrace.mSplineSegmentStart;
+
+    if (aFirstSegment < rStarts.size()) {
+        rCache.truncate(rStarts[aFirstSegment]);
+        rStarts.popBack(rStarts.size() - aFirstSegment);
+    } else if (!rCache.empty()) {
+        rCache.popBack();
+    }
+
+    const size_t lNumSegments = rTrace.mScreenPoints.size() - 1;
+    for (size_t lSeg = rStarts.size(); lSeg < lNumSegments; ++lSeg) {
+        const size_t lSteps = splineSegmentSteps(rTrace, lSeg);
+        mSplineScratch.resize(lSteps);
+        tessellateSplineSegment(rTrace, lSeg, mSplineScratch.data(), lSteps);
+        rStarts.pushBack(rCache.getEndPos());
+        for (size_t i = 0; i < lSteps; ++i) {
+            rCache.pushBack(mSplineScratch[i]);
+        }
+    }
+
+    // Ensure last point is included
+    rCache.pushBack(rTrace.mScreenPoints.back());
+}
 
-        rTrace.mScreenPoints[i] = { lX, lY };
+void RLTimeSeries::retessellateSplineHead(const RLTimeSeriesTrace& rTrace, size_t aDropped) const {
+    // The first aDropped segments left with their samples; the one after them is
+    // the new head and is tessellated again without its former left neighbour
+    RLCharts::RingQueue<Vector2>& rCache = rTrace.mSplineCache;
+    RLCharts::RingQueue<uint64_t>& rStarts = rTrace.mSplineSegmentStart;
+    rCache.dropBefore(rStarts[aDropped + 1]);
+    rStarts.popFront(aDropped + 1);
+
+    const size_t lSteps = splineSegmentSteps(rTrace, 0);
+    mSplineScratch.resize(lSteps);
+    tessellateSplineSegment(rTrace, 0, mSplineScratch.data(), lSteps);
+    for (size_t i = lSteps; i-- > 0;) {
+        rCache.pushFront(mSplineScratch[i]);
     }
+    rStarts.pushFront(rCache.getBeginPos());
+}
 
-    // Build spline cache if needed
-    if (rTrace.mStyle.mLineMode == RLTimeSeriesLineMode::Spline && rTrace.mCount >= 4) {
-        // Estimate total spline points needed
-        float lTotalDist = 0.0f;
-        for (size_t i = 1; i < rTrace.mScreenPoints.size(); ++i) {
-            lTotalDist += RLCharts::distance(rTrace.mScreenPoints[i - 1], rTrace.mScreenPoints[i]);
+void RLTimeSeries::buildHistoryPoints(const RLTimeSeriesTrace& rTrace, const Rectangle& rPlotArea,
+                                      float aYRange) const {
+    // One pyramid bucket per pixel column (or per sample when zoomed in further).
+    // A column with a spread becomes a vertical stroke from min to max, entered
+    // from the end nearer the previous column, so the polyline stays continuous.
+    const RLCharts::SamplePyramid& rHistory = *rTrace.mHistory;
+    if (mHistoryFirst >= rHistory.getSampleCount()) {
+        return;
+    }
+    const size_t lAvailable = std::min(mHistoryCount, rHistory.getSampleCount() - mHistoryFirst);
+    const size_t lColumns = rPlotArea.width > 1.0f ? (size_t)rPlotArea.width : 1;
+    mHistoryBuckets.clear();
+    const size_t lCount = rHistory.collect(mHistoryFirst, lAvailable, lColumns, mHistoryBuckets);
+    rTrace.mScreenPoints.reserve(lCount * 2);
+
+    const float lXStep = rPlotArea.width / (float)(mHistoryCount - 1);
+    auto lMapY = [&](float aValue) {
+        return rPlotArea.y + rPlotArea.height * (1.0f - (aValue - mCurrentMinY) / aYRange);
+    };
+    for (size_t c = 0; c < lCount; ++c) {
+        const RLCharts::SampleBucket& rBucket = mHistoryBuckets[c];
+        const float lX = rPlotArea.x + lXStep * (float)(c * lAvailable / lCount);
+        const float lYMin = lMapY(rBucket.mMin);
+        const float lYMax = lMapY(rBucket.mMax);
+        if (rBucket.mMin == rBucket.mMax) {
+            rTrace.mScreenPoints.pushBack({ lX, lYMin });
+            continue;
         }
+        const bool lMaxFirst = !rTrace.mScreenPoints.empty() &&
+                               fabsf(rTrace.mScreenPoints.back().y - lYMax) < fabsf(rTrace.mScreenPoints.back().y - lYMin);
+        rTrace.mScreenPoints.pushBack({ lX, lMaxFirst ? lYMax : lYMin });
+        rTrace.mScreenPoints.pushBack({ lX, lMaxFirst ? lYMin : lYMax });
+    }
+}
 
-        size_t lSplinePoints = (size_t)(lTotalDist / mStyle.mSplinePixels) + rTrace.mCount;
-        lSplinePoints = std::max(lSplinePoints, rTrace.mCount);
-        lSplinePoints = std::min(lSplinePoints, (size_t)10000); // Reasonable limit
+void RLTimeSeries::buildDecimatedPoints(const RLTimeSeriesTrace& rTrace, const Rectangle& rPlotArea,
+                                        float aXStep, float aYRange) const {
+    // M4 aggregation: every pixel column keeps its first, min, max and last sample
+    // (in time order, duplicates removed). The rasterized line is identical to the
+    // full-resolution one while the point count is bounded by 4 * plot width.
+    rTrace.mScreenPoints.reserve(((size_t)rPlotArea.width + 1) * 4);
 
-        rTrace.mSplineCache.resize(lSplinePoints);
+    const float* pRing = ringData(rTrace);
+    const size_t lBufferSize = mWindowSize;
+    const size_t lStart = (rTrace.mHead + lBufferSize - rTrace.mCount) % lBufferSize;
 
-        const size_t lNumSegments = rTrace.mScreenPoints.size() - 1;
-        size_t lPointsPerSegment = lSplinePoints / lNumSegments;
-        lPointsPerSegment = std::max(lPointsPerSegment, (size_t)2);
+    auto lEmit = [&](size_t aIndex, float aValue) {
+        const float lNormY = (aValue - mCurrentMinY) / aYRange;
+        rTrace.mScreenPoints.pushBack({ rPlotArea.x + aXStep * (float)aIndex,
+                                         rPlotArea.y + rPlotArea.height * (1.0f - lNormY) });
+    };
 
-        size_t lOutIdx = 0;
-        for (size_t seg = 0; seg < lNumSegments && lOutIdx < lSplinePoints; ++seg) {
-            // Get control points for Catmull-Rom
-            const size_t lI0 = (seg > 0) ? seg - 1 : 0;
-            const size_t lI1 = seg;
-            const size_t lI2 = seg + 1;
-            const size_t lI3 = (seg + 2 < rTrace.mScreenPoints.size()) ? seg + 2 : rTrace.mScreenPoints.size() - 1;
+    size_t lColumn = 0;
+    size_t lFirstIdx = 0;
+    size_t lMinIdx = 0;
+    size_t lMaxIdx = 0;
+    size_t lLastIdx = 0;
+    float lFirstVal = 0.0f;
+    float lMinVal = 0.0f;
+    float lMaxVal = 0.0f;
+    float lLastVal = 0.0f;
+
+    auto lFlushColumn = [&]() {
+        const bool lMinFirst = lMinIdx <= lMaxIdx;
+        const size_t lLowIdx = lMinFirst ? lMinIdx : lMaxIdx;
+        const size_t lHighIdx = lMinFirst ? lMaxIdx : lMinIdx;
+        const float lLowVal = lMinFirst ? lMinVal : lMaxVal;
+        const float lHighVal = lMinFirst ? lMaxVal : lMinVal;
+
+        lEmit(lFirstIdx, lFirstVal);
+        if (lLowIdx > lFirstIdx) {
+            lEmit(lLowIdx, lLowVal);
+        }
+        if (lHighIdx > lLowIdx) {
+            lEmit(lHighIdx, lHighVal);
+        }
+        if (lLastIdx > lHighIdx) {
+            lEmit(lLastIdx, lLastVal);
+        }
+    };
 
-            const Vector2 lP0 = rTrace.mScreenPoints[lI0];
-            const Vector2 lP1 = rTrace.mScreenPoints[lI1];
-            const Vector2 lP2 = rTrace.mScreenPoints[lI2];
-            const Vector2 lP3 = rTrace.mScreenPoints[lI3];
+    size_t lBufIdx = lStart;
+    for (size_t i = 0; i < rTrace.mCount; ++i) {
+        const float lVal = pRing[lBufIdx];
+        if (++lBufIdx == lBufferSize) {
+            lBufIdx = 0;
+        }
 
-            const size_t lSteps = (seg == lNumSegments - 1) ? (lSplinePoints - lOutIdx) : lPointsPerSegment;
-            for (size_t s = 0; s < lSteps && lOutIdx < lSplinePoints; ++s) {
-                const float lT = (float)s / (float)lSteps;
-                rTrace.mSplineCache[lOutIdx++] = RLCharts::catmullRom(lP0, lP1, lP2, lP3, lT);
+        const size_t lCol = (size_t)((float)i * aXStep);
+        if (i == 0 || lCol != lColumn) {
+            if (i > 0) {
+                lFlushColumn();
             }
+            lColumn = lCol;
+            lFirstIdx = lMinIdx = lMaxIdx = lLastIdx = i;
+            lFirstVal = lMinVal = lMaxVal = lLastVal = lVal;
+            continue;
         }
 
-        // Ensure last point is included
-        if (lOutIdx > 0 && lOutIdx <= lSplinePoints) {
-            rTrace.mSplineCache[lOutIdx - 1] = rTrace.mScreenPoints.back();
+        if (lVal < lMinVal) {
+            lMinVal = lVal;
+            lMinIdx = i;
         }
-        rTrace.mSplineCache.resize(lOutIdx);
-    } else {
-        rTrace.mSplineCache.clear();
+        if (lVal > lMaxVal) {
+            lMaxVal = lVal;
+            lMaxIdx = i;
+        }
+        lLastIdx = i;
+        lLastVal = lVal;
     }
+    lFlushColumn();
 }
-
-
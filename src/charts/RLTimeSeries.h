@@ -1,9 +1,21 @@
 // RLTimeSeries.h
 #pragma once
 #include "raylib.h"
+#include "RLPerf.h"
 #include "RLCommon.h"
+#include "RLLineBatch.h"
+#include "RLCircleBatch.h"
+#include "RLSpscRing.h"
+#include "RLSpline.h"
+#include "RLSamplePyramid.h"
+#include "RLSlidingExtrema.h"
+#include "RLRingQueue.h"
+#include "RLRenderCache.h"
 #include <vector>
+#include <span>
+#include <memory>
 #include <cstddef>
+#include <cstdint>
 
 // High-performance streaming time series visualizer for raylib.
 // Supports multiple overlapping traces, each updated independently.
@@ -24,21 +36,55 @@ struct RLTimeSeriesTraceStyle {
     bool mShowPoints{ false };
     float mPointRadius{ 3.0f };
     bool mVisible{ true };
+    // Min/max (M4) decimation: when the window holds more samples than the plot
+    // has pixel columns, each column is reduced to its first/min/max/last sample
+    bool mDecimate{ false };
 };
 
 // Single trace data and state
 struct RLTimeSeriesTrace {
+    static constexpr size_t NO_GROUP = SIZE_MAX;
+
     RLTimeSeriesTraceStyle mStyle{};
 
-    // Ring buffer for samples
+    // Ring buffer for samples (empty for a channel of a group, whose samples live
+    // in the group's ring)
     std::vector<float> mSamples;
     size_t mHead{ 0 };       // Next write position
     size_t mCount{ 0 };      // Current number of samples in buffer
+    // Min/max of the samples in the ring, updated per push (autoscale reads it)
+    RLCharts::SlidingExtrema<float> mExtrema;
+
+    // Channel group (addChannelGroup) and channel within it
+    size_t mGroup{ NO_GROUP };
+    size_t mChannel{ 0 };
 
-    // Cached screen-space points for drawing
-    mutable std::vector<Vector2> mScreenPoints;
-    mutable std::vector<Vector2> mSplineCache;
+    // Cached screen-space points for drawing. The caches are rings: scrolling
+    // drops points at the front and maps new ones at the back without moving the
+    // rest. Points are stored mScreenShiftX to the right of where they are drawn
+    // (the x of a sample is fixed when it is mapped; draw() translates back).
+    mutable RLCharts::RingQueue<Vector2> mScreenPoints;
+    mutable RLCharts::RingQueue<Vector2> mSplineCache;
+    mutable RLCharts::RingQueue<uint64_t> mSplineSegmentStart; // mSplineCache position of each segment
+    mutable size_t mScreenSeq{ 0 };   // Samples scrolled out since the last full remap
+    mutable float mScreenShiftX{ 0.0f };
     mutable bool mDirty{ true };
+
+    // Batched line geometry and point markers (instanced), rebuilt whenever the
+    // screen points change
+    mutable RLCharts::LineBatch mBatch;
+    mutable RLCharts::CircleBatch mMarkers;
+    mutable bool mBatchDirty{ true };
+
+    // Incremental rebuild state: samples pushed since the last rebuild and the
+    // Y scale the cache was mapped with. mFullRebuild forces a complete remap.
+    mutable size_t mPendingSamples{ 0 };
+    mutable bool mFullRebuild{ true };
+    mutable float mCachedMinY{ 0.0f };
+    mutable float mCachedMaxY{ 0.0f };
+
+    // Every sample ever pushed, as a min/max/mean pyramid (null unless enabled)
+    std::unique_ptr<RLCharts::SamplePyramid> mHistory;
 };
 
 // Overall chart style
@@ -64,8 +110,10 @@ struct RLTimeSeriesChartStyle {
     float mMaxY{ 1.0f };
     float mAutoScaleMargin{ 0.1f }; // 10% margin above/below data range
 
-    // Spline quality (pixels per segment)
+    // Spline quality: adaptive subdivision (RLSpline.h) within mSplineTolerancePx
+    // of the curve, never finer than mSplinePixels between samples
     float mSplinePixels{ 4.0f };
+    float mSplineTolerancePx{ 0.25f };
 
     // Smooth scale transitions
     bool mSmoothScale{ true };
@@ -75,6 +123,25 @@ struct RLTimeSeriesChartStyle {
 // Main time series visualizer class
 class RLTimeSeries {
 public:
+    // Producer handle for feeding one trace from another thread.
+    // Backed by a lock-free single-producer/single-consumer ring; update() moves
+    // the queued samples into the trace in bulk. Only one thread may push through
+    // a given producer. Handles stay valid for the lifetime of the chart.
+    class Producer {
+    public:
+        Producer() = default;
+        // Returns false if the queue is full (sample dropped)
+        bool push(float aValue);
+        // Returns the number of samples queued (less than aCount if the queue filled up)
+        size_t push(const float* pValues, size_t aCount);
+        [[nodiscard]] bool isValid() const { return mpQueue != nullptr; }
+
+    private:
+        friend class RLTimeSeries;
+        explicit Producer(RLCharts::SpscRing<float>* pQueue) : mpQueue(pQueue) {}
+        RLCharts::SpscRing<float>* mpQueue{ nullptr };
+    };
+
     explicit RLTimeSeries(Rectangle aBounds, size_t aWindowSize = 500);
 
     // Configuration
@@ -91,20 +158,81 @@ public:
     void clearAllTraces();
     [[nodiscard]] size_t getTraceCount() const { return mTraces.size(); }
     [[nodiscard]] size_t getTraceSampleCount(size_t aIndex) const;
+    // Number of screen-space points the trace is drawn from (after decimation)
+    [[nodiscard]] size_t getTraceScreenPointCount(size_t aIndex) const;
+    // The screen-space polyline the trace is drawn from: the mapped samples, or
+    // with aSpline the tessellated curve (spline mode only, empty otherwise)
+    void getTraceScreenPoints(size_t aIndex, std::vector<Vector2>& rOut, bool aSpline = false) const;
 
     // Sample input
     void pushSample(size_t aTraceIndex, float aValue);
     // Push multiple samples at once
     // Returns false if rValues is empty or aTraceIndex is invalid
     bool pushSamples(size_t aTraceIndex, const std::vector<float>& rValues);
+    // Same as above for caller-owned memory (mapped files, pooled buffers); no copy beyond the trace ring
+    bool pushSamples(size_t aTraceIndex, std::span<const float> aValues);
+    // Create a cross-thread producer for a trace (call from the render thread).
+    // Returns an invalid handle if aTraceIndex is invalid.
+    Producer createProducer(size_t aTraceIndex, size_t aCapacity = 8192);
+
+    // Synchronized channels: aChannels traces fed together by pushFrame(), one
+    // value per channel per frame. They share one channel-major ring (each
+    // channel's window is a contiguous block), so auto-scale and screen mapping
+    // run as vectorized passes over all channels. Returns the index of the first
+    // channel's trace; the others follow it. The traces keep their own styles,
+    // visibility and history but reject pushSample(), pushSamples() and
+    // createProducer(); clearTrace() on any of them clears the whole group.
+    size_t addChannelGroup(size_t aChannels, const RLTimeSeriesTraceStyle& aStyle = {});
+    // One frame of aChannels values. aFirstTrace is the value addChannelGroup()
+    // returned and aChannels must match the group; returns false otherwise.
+    bool pushFrame(size_t aFirstTrace, const float* pValues, size_t aChannels);
+    // aFrameCount interleaved frames (pFrames[frame * aChannels + channel])
+    bool pushFrames(size_t aFirstTrace, const float* pFrames, size_t aFrameCount, size_t aChannels);
+
+    // Long history: keep every sample of a trace in a min/max/mean pyramid
+    // (RLSamplePyramid.h) that setHistoryView() can show at any zoom. With
+    // pSpillPath the old part of the pyramid moves to that memory-mapped scratch
+    // file. Disabling drops the history. Returns false for an invalid index or a
+    // spill file that cannot be created.
+    bool setTraceHistoryEnabled(size_t aIndex, bool aEnabled, const char* pSpillPath = nullptr);
+    [[nodiscard]] const RLCharts::SamplePyramid* getTraceHistory(size_t aIndex) const;
+    // Show history samples [aFirst, aFirst + aCount) (0 = first sample recorded)
+    // across the plot, one min/max column per pixel, instead of the live window.
+    // Traces without a history are hidden meanwhile. setLiveView() goes back.
+    void setHistoryView(size_t aFirst, size_t aCount);
+    void setLiveView();
+    [[nodiscard]] bool isHistoryView() const { return mHistoryView; }
+
+    // Snapshot of every trace's window and the Y scale (RLStateCodec.h), e.g. to
+    // warm up a dashboard after a restart. loadState() needs the same traces and
+    // groups in the same order; it keeps the current window size (the newest
+    // samples win) and rebuilds each trace's history from the restored window.
+    // Returns false, leaving the chart untouched, for a blob that does not match.
+    [[nodiscard]] std::vector<uint8_t> saveState() const;
+    bool loadState(std::span<const uint8_t> aState);
 
     // Update and draw
     void update(float aDt);
     void draw() const;
+    // Keep the background, grid and axes in a render texture that is re-rendered
+    // only after setBounds()/setStyle(), and draw just the traces over it each
+    // frame (RLRenderCache.h). Off by default.
+    void setStaticLayerCache(bool aEnabled);
+    [[nodiscard]] const RLCharts::StaticLayer& getStaticLayer() const { return mStaticLayer; }
+
+    // Settled once the Y scale caught up with the data and every producer queue is
+    // empty; needsRedraw() also covers samples pushed since the last draw()
+    [[nodiscard]] bool isSettled() const;
+    [[nodiscard]] bool needsRedraw() const { return mRedrawPending || !isSettled(); }
+    // update()/rebuild/draw() timers and GPU counters (RLPerf.h); zero unless built with RLCHARTS_PERF
+    [[nodiscard]] const RLCharts::PerfStats& getPerfStats() const { return mPerf; }
 
     // Helpers
     [[nodiscard]] Rectangle getBounds() const { return mBounds; }
     [[nodiscard]] Rectangle getPlotArea() const;
+    // Current (animated) Y scale
+    [[nodiscard]] float getMinY() const { return mCurrentMinY; }
+    [[nodiscard]] float getMaxY() const { return mCurrentMaxY; }
 
 private:
     Rectangle mBounds{};
@@ -112,20 +240,80 @@ private:
     RLTimeSeriesChartStyle mStyle{};
     std::vector<RLTimeSeriesTrace> mTraces;
 
+    // Channel groups: ring block c holds channel c's window (mWindowSize samples,
+    // same head and count as every channel trace). mScreenY caches the mapped Y of
+    // every ring slot for the scale, plot area and data it was computed with.
+    struct ChannelGroup {
+        size_t mFirstTrace{ 0 };
+        size_t mChannels{ 0 };
+        std::vector<float> mRing;
+        mutable std::vector<float> mScreenY;
+        mutable bool mScreenYValid{ false };
+        mutable float mCachedMinY{ 0.0f };
+        mutable float mCachedMaxY{ 0.0f };
+        mutable float mCachedTop{ 0.0f };
+        mutable float mCachedHeight{ 0.0f };
+    };
+    std::vector<ChannelGroup> mGroups;
+
     // Animated scale state
     float mCurrentMinY{ -1.0f };
     float mCurrentMaxY{ 1.0f };
     float mTargetMinY{ -1.0f };
     float mTargetMaxY{ 1.0f };
+    bool mScaleSettled{ false };         // last updateScale() left current == target
+    mutable bool mRedrawPending{ true }; // cleared by draw()
+
+    // History view (setHistoryView)
+    bool mHistoryView{ false };
+    size_t mHistoryFirst{ 0 };
+    size_t mHistoryCount{ 0 };
+    mutable std::vector<RLCharts::SampleBucket> mHistoryBuckets; // collect() scratch
+    mutable std::vector<Vector2> mSplineScratch;                  // One tessellated segment
+    mutable RLCharts::PerfStats mPerf;
+    mutable RLCharts::StaticLayer mStaticLayer;
+
+    // Cross-thread ingest queues, drained by update()
+    struct ProducerQueue {
+        size_t mTraceIndex{ 0 };
+        RLCharts::SpscRing<float> mRing;
+        ProducerQueue(size_t aTraceIndex, size_t aCapacity) : mTraceIndex(aTraceIndex), mRing(aCapacity) {}
+    };
+    std::vector<std::unique_ptr<ProducerQueue>> mProducers;
+
+    // Windows of scrolling between full remaps of a trace (bounds the stored x)
+    static constexpr size_t SCREEN_REBASE_WINDOWS = 4;
 
     // Internal helpers
+    void markChanged() {
+        mRedrawPending = true;
+        mScaleSettled = false;
+    }
+    void appendSamples(RLTimeSeriesTrace& rTrace, const float* pValues, size_t aCount);
+    [[nodiscard]] bool isGroupedTrace(size_t aTraceIndex) const;
+    void mapGroupScreenY(const ChannelGroup& rGroup, const Rectangle& rPlotArea, float aYRange) const;
+    void trackExtrema(RLTimeSeriesTrace& rTrace, const float* pValues, size_t aCount, size_t aStride = 1);
+    void resetExtrema(RLTimeSeriesTrace& rTrace);
+    void drainProducers();
     void updateScale(float aDt);
     void rebuildScreenPoints(size_t aTraceIndex) const;
+    void buildHistoryPoints(const RLTimeSeriesTrace& rTrace, const Rectangle& rPlotArea, float aYRange) const;
+    void buildDecimatedPoints(const RLTimeSeriesTrace& rTrace, const Rectangle& rPlotArea,
+                              float aXStep, float aYRange) const;
+    void mapScreenPoints(const RLTimeSeriesTrace& rTrace, size_t aFirst, const Rectangle& rPlotArea,
+                         float aXStep, float aYRange) const;
+    [[nodiscard]] size_t splineSegmentSteps(const RLTimeSeriesTrace& rTrace, size_t aSegment) const;
+    void tessellateSplineSegment(const RLTimeSeriesTrace& rTrace, size_t aSegment,
+                                 Vector2* pOut, size_t aSteps) const;
+    void rebuildSplineFrom(const RLTimeSeriesTrace& rTrace, size_t aFirstSegment) const;
+    void retessellateSplineHead(const RLTimeSeriesTrace& rTrace, size_t aDropped) const;
+    void clearScreenPoints(const RLTimeSeriesTrace& rTrace) const;
     void drawTrace(const RLTimeSeriesTrace& rTrace) const;
+    void drawStaticLayer() const;
     void drawGrid() const;
     void drawAxes() const;
 
-    // Ring buffer helpers
-    static float getSample(const RLTimeSeriesTrace& rTrace, size_t aIndex);
+    // Ring buffer helper: a trace's mWindowSize ring slots, wherever they live
+    [[nodiscard]] const float* ringData(const RLTimeSeriesTrace& rTrace) const;
 };
 
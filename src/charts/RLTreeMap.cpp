@@ -1,5 +1,7 @@
 // RLTreeMap.cpp
 #include "RLTreeMap.h"
+#include "RLCommon.h"
+#include "RLFrameArena.h"
 #include <algorithm>
 #include <cmath>
 #include <limits>
@@ -26,63 +28,151 @@ RLTreeMap::RLTreeMap(Rectangle aBounds, RLTreeMapStyle  aStyle)
 }
 
 void RLTreeMap::setBounds(Rectangle aBounds) {
+    mRedrawPending = true;
     mBounds = aBounds;
     mDataDirty = true;
 }
 
 void RLTreeMap::setStyle(const RLTreeMapStyle& rStyle) {
+    mRedrawPending = true;
     mStyle = rStyle;
     ensureDefaultPalette();
     mDataDirty = true;
 }
 
 void RLTreeMap::setLayout(RLTreeMapLayout aLayout) {
+    mRedrawPending = true;
     mLayout = aLayout;
     mDataDirty = true;
 }
 
 void RLTreeMap::setData(const RLTreeNode& rRoot) {
-    mRoot = rRoot;
-    computeLayout();
+    mConvertScratch.clear();
+    if (!rRoot.mLabel.empty() || !rRoot.mChildren.empty()) {
+        mLabelIds.clear();
+        flattenHierarchy(rRoot, RLTreeFlatData::NO_PARENT, mConvertScratch);
+    }
+    adoptData(mConvertScratch, false);
+}
 
-    // Set current state to target (no animation)
-    for (auto& rRect : mRects) {
-        rRect.mRect = rRect.mTargetRect;
-        rRect.mColor = rRect.mTargetColor;
-        rRect.mAlpha = rRect.mTargetAlpha;
+bool RLTreeMap::setData(const RLTreeFlatData& rData) {
+    if (!isValidData(rData)) {
+        return false;
     }
+    adoptData(rData, false);
+    return true;
 }
 
 void RLTreeMap::setTargetData(const RLTreeNode& rRoot) {
-    // Store old rects for animation
-    const std::vector<RLTreeRect> lOldRects = mRects;
+    mConvertScratch.clear();
+    if (!rRoot.mLabel.empty() || !rRoot.mChildren.empty()) {
+        mLabelIds.clear();
+        flattenHierarchy(rRoot, RLTreeFlatData::NO_PARENT, mConvertScratch);
+    }
+    adoptData(mConvertScratch, true);
+}
 
-    mRoot = rRoot;
-    computeLayout();
+bool RLTreeMap::setTargetData(const RLTreeFlatData& rData) {
+    if (!isValidData(rData)) {
+        return false;
+    }
+    adoptData(rData, true);
+    return true;
+}
 
-    // Match old rects by label for smooth transitions
-    for (auto& rRect : mRects) {
-        // Try to find matching node in old data
-        for (const auto& rOld : lOldRects) {
-            if (rOld.mLabel == rRect.mLabel && rOld.mDepth == rRect.mDepth) {
-                // Start from old position
-                rRect.mRect = rOld.mRect;
-                rRect.mColor = rOld.mColor;
-                rRect.mAlpha = rOld.mAlpha;
-                break;
+bool RLTreeMap::isValidData(const RLTreeFlatData& rData) {
+    const size_t lCount = rData.size();
+    if (rData.mValue.size() != lCount || rData.mLabelId.size() != lCount) {
+        return false;
+    }
+    if ((!rData.mColor.empty() && rData.mColor.size() != lCount) ||
+        (!rData.mUseColor.empty() && rData.mUseColor.size() != lCount) ||
+        (!rData.mUseColor.empty() && rData.mColor.empty())) {
+        return false;
+    }
+    for (size_t i = 0; i < lCount; ++i) {
+        const bool lParentOk = i == 0 ? rData.mParent[i] == RLTreeFlatData::NO_PARENT : rData.mParent[i] < i;
+        if (!lParentOk || rData.mLabelId[i] >= rData.mLabels.size()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool RLTreeMap::sameStructure(const RLTreeFlatData& rData) const {
+    return mRects.size() == rData.size() && mData.mParent == rData.mParent &&
+           mData.mLabelId == rData.mLabelId && mData.mLabels == rData.mLabels;
+}
+
+void RLTreeMap::adoptData(const RLTreeFlatData& rData, bool aAnimate) {
+    mRedrawPending = true;
+    mPickDirty = true;
+    if (!mRects.empty() && sameStructure(rData)) {
+        // Same nodes: only values and colors change, rects keep their animation state
+        mData.mValue = rData.mValue;
+        mData.mColor = rData.mColor;
+        mData.mUseColor = rData.mUseColor;
+        computeLayout();
+    } else {
+        // Old rect per (label, depth), to start matching nodes from where they were
+        std::vector<RLTreeRect> lOldRects;
+        std::unordered_map<std::string, size_t> lOldByLabel;
+        std::unordered_map<uint64_t, size_t> lOldByKey;
+        if (aAnimate) {
+            lOldRects.swap(mRects);
+            for (size_t i = 0; i < mData.mLabels.size(); ++i) {
+                lOldByLabel.emplace(mData.mLabels[i], i);
+            }
+            for (size_t i = 0; i < lOldRects.size(); ++i) {
+                const uint64_t lKey = ((uint64_t)lOldRects[i].mLabelId << 32) | (uint32_t)lOldRects[i].mDepth;
+                lOldByKey.emplace(lKey, i);
+            }
+        }
+        mData = rData;
+        buildChildIndex();
+        rebuildRects();
+        computeLayout();
+        for (auto& rRect : mRects) {
+            rRect.mColor = rRect.mTargetColor;
+        }
+        if (aAnimate && !lOldRects.empty()) {
+            for (auto& rRect : mRects) {
+                const auto lLabel = lOldByLabel.find(mData.mLabels[rRect.mLabelId]);
+                if (lLabel == lOldByLabel.end()) {
+                    continue;
+                }
+                const auto lOld = lOldByKey.find(((uint64_t)lLabel->second << 32) | (uint32_t)rRect.mDepth);
+                if (lOld != lOldByKey.end()) {
+                    const RLTreeRect& rOld = lOldRects[lOld->second];
+                    rRect.mRect = rOld.mRect;
+                    rRect.mColor = rOld.mColor;
+                    rRect.mAlpha = rOld.mAlpha;
+                }
             }
         }
     }
+
+    if (!aAnimate) {
+        // Set current state to target (no animation)
+        for (auto& rRect : mRects) {
+            rRect.mRect = rRect.mTargetRect;
+            rRect.mColor = rRect.mTargetColor;
+            rRect.mAlpha = rRect.mTargetAlpha;
+        }
+    }
 }
 
 void RLTreeMap::updateValue(const std::vector<std::string>& rPath, float aNewValue) {
-    // Navigate to node and update its value
-    RLTreeNode* pNode = &mRoot;
+    if (mData.size() == 0) {
+        return;
+    }
+    // Walk the path through the child index (first label match per level)
+    size_t lNode = 0;
     for (const auto& rName : rPath) {
         bool lFound = false;
-        for (auto& rChild : pNode->mChildren) {
-            if (rChild.mLabel == rName) {
-                pNode = &rChild;
+        for (size_t c = mChildOffsets[lNode]; c < mChildOffsets[lNode + 1]; ++c) {
+            if (mData.mLabels[mData.mLabelId[mChildList[c]]] == rName) {
+                lNode = mChildList[c];
                 lFound = true;
                 break;
             }
@@ -91,11 +181,73 @@ void RLTreeMap::updateValue(const std::vector<std::string>& rPath, float aNewVal
             return; // Path not found
         }
     }
-    pNode->mValue = aNewValue;
-    setTargetData(mRoot);
+    updateValue(lNode, aNewValue);
+}
+
+void RLTreeMap::updateValue(size_t aNode, float aNewValue) {
+    if (aNode >= mData.size()) {
+        return;
+    }
+    mRedrawPending = true;
+    mData.mValue[aNode] = aNewValue;
+    // Internal node values are always the sum of their children; a pending full
+    // layout picks the value up anyway
+    if (mDataDirty || !mRects[aNode].mIsLeaf) {
+        return;
+    }
+    mRects[aNode].mValue = aNewValue;
+    std::vector<size_t> lFlatPath;
+    for (size_t i = aNode; i != (size_t)-1; i = mRects[i].mParentIndex) {
+        lFlatPath.push_back(i);
+    }
+    std::reverse(lFlatPath.begin(), lFlatPath.end());
+    if (!relayoutPath(lFlatPath)) {
+        computeLayout();
+    }
+}
+
+bool RLTreeMap::relayoutPath(const std::vector<size_t>& rPath) {
+    RLCHARTS_PERF_REBUILD(mPerf, "RLTreeMap::relayoutPath");
+    // Re-sum the ancestors bottom-up, in the same order as sumSubtreeValues()
+    for (size_t k = rPath.size() - 1; k-- > 0;) {
+        const size_t lNode = rPath[k];
+        float lSum = 0.0f;
+        for (size_t c = mChildOffsets[lNode]; c < mChildOffsets[lNode + 1]; ++c) {
+            lSum += mRects[mChildList[c]].mValue;
+        }
+        mRects[lNode].mValue = lSum;
+    }
+
+    // Walk down the path: every node on it has children with new values, off-path
+    // children only need a pass if their rectangle changed
+    for (size_t k = 0; k + 1 < rPath.size(); ++k) {
+        const size_t lNode = rPath[k];
+        const size_t lFirst = mChildOffsets[lNode];
+        const size_t lLast = mChildOffsets[lNode + 1];
+        mOldTargets.clear();
+        for (size_t c = lFirst; c < lLast; ++c) {
+            mOldTargets.push_back(mRects[mChildList[c]].mTargetRect);
+        }
+        if (!layoutChildren(lNode, mRects[lNode].mDepth)) {
+            return true; // the rest of the path was cleared with the subtree
+        }
+        for (size_t c = lFirst; c < lLast; ++c) {
+            const size_t lChild = mChildList[c];
+            if (lChild == rPath[k + 1]) {
+                continue;
+            }
+            const Rectangle& rOld = mOldTargets[c - lFirst];
+            const Rectangle& rNew = mRects[lChild].mTargetRect;
+            if (rOld.x != rNew.x || rOld.y != rNew.y || rOld.width != rNew.width || rOld.height != rNew.height) {
+                layoutNode(lChild, rNew, mRects[lChild].mDepth);
+            }
+        }
+    }
+    return true;
 }
 
 void RLTreeMap::recomputeLayout() {
+    mRedrawPending = true;
     computeLayout();
 }
 
@@ -109,15 +261,19 @@ void RLTreeMap::ensureDefaultPalette() {
 }
 
 void RLTreeMap::computeLayout() {
-    mRects.clear();
-    mTargetRects.clear();
-
-    if (mRoot.mLabel.empty() && mRoot.mChildren.empty()) {
+    RLCHARTS_PERF_REBUILD(mPerf, "RLTreeMap::computeLayout");
+    mDataDirty = false;
+    if (mRects.empty()) {
         return;
     }
 
-    // Flatten hierarchy into mRects
-    flattenHierarchy(mRoot, 0, (size_t)-1);
+    // Leaf values and colors from the data; internal nodes are summed
+    for (size_t i = 0; i < mRects.size(); ++i) {
+        RLTreeRect& rRect = mRects[i];
+        rRect.mValue = rRect.mIsLeaf ? mData.mValue[i] : 0.0f;
+        rRect.mTargetColor = computeNodeColor(i, rRect.mDepth);
+    }
+    sumSubtreeValues();
 
     // Calculate the available area
     const Rectangle lAvailable = {
@@ -128,55 +284,84 @@ void RLTreeMap::computeLayout() {
     };
 
     // Start layout from root
-    if (!mRects.empty()) {
-        layoutNode(0, lAvailable, 0);
-    }
-
-    mDataDirty = false;
+    layoutNode(0, lAvailable, 0);
 }
 
-float RLTreeMap::computeSubtreeValue(const RLTreeNode& rNode) const {
-    if (rNode.mChildren.empty()) {
-        return rNode.mValue;
+void RLTreeMap::buildChildIndex() {
+    // Counting sort by parent; scanning in index order keeps every child list in sibling order
+    const size_t lCount = mData.size();
+    mChildOffsets.assign(lCount + 1, 0);
+    for (size_t i = 1; i < lCount; ++i) {
+        mChildOffsets[mData.mParent[i] + 1]++;
     }
-    float lSum = 0.0f;
-    for (const auto& rChild : rNode.mChildren) {
-        lSum += computeSubtreeValue(rChild);
+    for (size_t i = 0; i < lCount; ++i) {
+        mChildOffsets[i + 1] += mChildOffsets[i];
+    }
+    mChildList.resize(lCount > 0 ? lCount - 1 : 0);
+    mLayoutScratch.assign(mChildOffsets.begin(), mChildOffsets.end() - 1); // write cursors
+    for (size_t i = 1; i < lCount; ++i) {
+        mChildList[mLayoutScratch[mData.mParent[i]]++] = i;
     }
-    return lSum;
 }
 
-void RLTreeMap::flattenHierarchy(const RLTreeNode& rNode, int aDepth, size_t aParentIdx) {
-    const size_t lMyIndex = mRects.size();
-
-    RLTreeRect lRect;
-    lRect.mLabel = rNode.mLabel;
-    lRect.mDepth = aDepth;
-    lRect.mIsLeaf = rNode.mChildren.empty();
-    lRect.mParentIndex = aParentIdx;
-    lRect.mAlpha = 1.0f;
-    lRect.mTargetAlpha = 1.0f;
+void RLTreeMap::rebuildRects() {
+    // Parents precede their children, so depths resolve in one forward pass
+    mRects.assign(mData.size(), RLTreeRect{});
+    for (size_t i = 0; i < mRects.size(); ++i) {
+        RLTreeRect& rRect = mRects[i];
+        const uint32_t lParent = mData.mParent[i];
+        rRect.mParentIndex = lParent == RLTreeFlatData::NO_PARENT ? (size_t)-1 : (size_t)lParent;
+        rRect.mDepth = lParent == RLTreeFlatData::NO_PARENT ? 0 : mRects[lParent].mDepth + 1;
+        rRect.mIsLeaf = mChildOffsets[i] == mChildOffsets[i + 1];
+        rRect.mLabelId = mData.mLabelId[i];
+    }
+}
 
-    // Calculate value: for leaves use mValue, for internal nodes sum children
-    if (lRect.mIsLeaf) {
-        lRect.mValue = rNode.mValue;
-    } else {
+void RLTreeMap::sumSubtreeValues() {
+    // Children come after their parent, so a reverse pass sees final child sums
+    for (size_t i = mRects.size(); i-- > 0;) {
+        if (mRects[i].mIsLeaf) {
+            continue;
+        }
         float lSum = 0.0f;
-        for (const auto& rChild : rNode.mChildren) {
-            lSum += computeSubtreeValue(rChild);
+        for (size_t c = mChildOffsets[i]; c < mChildOffsets[i + 1]; ++c) {
+            lSum += mRects[mChildList[c]].mValue;
         }
-        lRect.mValue = lSum;
+        mRects[i].mValue = lSum;
     }
+}
 
-    // Compute color
-    lRect.mTargetColor = computeNodeColor(rNode, aDepth);
-    lRect.mColor = lRect.mTargetColor;
-
-    mRects.push_back(lRect);
+void RLTreeMap::flattenHierarchy(const RLTreeNode& rNode, uint32_t aParentIdx, RLTreeFlatData& rOut) {
+    // Equal labels share an id, in order of first appearance, so converting the
+    // same tree twice gives the same structure
+    uint32_t lLabelId = 0;
+    const auto lIt = mLabelIds.find(rNode.mLabel);
+    if (lIt != mLabelIds.end()) {
+        lLabelId = lIt->second;
+    } else {
+        lLabelId = rOut.addLabel(rNode.mLabel);
+        mLabelIds.emplace(rNode.mLabel, lLabelId);
+    }
+    const uint32_t lMyIndex = rOut.addNode(aParentIdx, lLabelId, rNode.mValue);
+    rOut.mColor.push_back(rNode.mColor);
+    rOut.mUseColor.push_back(rNode.mUseColor ? 1 : 0);
 
     // Process children
     for (const auto& rChild : rNode.mChildren) {
-        flattenHierarchy(rChild, aDepth + 1, lMyIndex);
+        flattenHierarchy(rChild, lMyIndex, rOut);
+    }
+}
+
+void RLTreeMap::clearSubtreeTargets(size_t aNodeIdx) {
+    mClearStack.clear();
+    mClearStack.push_back(aNodeIdx);
+    while (!mClearStack.empty()) {
+        const size_t lNode = mClearStack.back();
+        mClearStack.pop_back();
+        for (size_t c = mChildOffsets[lNode]; c < mChildOffsets[lNode + 1]; ++c) {
+            mRects[mChildList[c]].mTargetRect = Rectangle{0, 0, 0, 0};
+            mClearStack.push_back(mChildList[c]);
+        }
     }
 }
 
@@ -184,25 +369,28 @@ void RLTreeMap::layoutNode(size_t aNodeIdx, Rectangle aAvailable, int aDepth) {
     if (aNodeIdx >= mRects.size()) {
         return;
     }
+    mRects[aNodeIdx].mTargetRect = aAvailable;
+    if (!layoutChildren(aNodeIdx, aDepth)) {
+        return;
+    }
 
-    RLTreeRect& rNode = mRects[aNodeIdx];
-    rNode.mTargetRect = aAvailable;
-
-    // Find children of this node
-    std::vector<size_t> lChildIndices;
-    for (size_t i = aNodeIdx + 1; i < mRects.size(); ++i) {
-        if (mRects[i].mParentIndex == aNodeIdx) {
-            lChildIndices.push_back(i);
-        }
+    // Recursively layout children
+    for (size_t c = mChildOffsets[aNodeIdx]; c < mChildOffsets[aNodeIdx + 1]; ++c) {
+        const size_t lIdx = mChildList[c];
+        layoutNode(lIdx, mRects[lIdx].mTargetRect, mRects[lIdx].mDepth);
     }
+}
 
-    if (lChildIndices.empty()) {
+bool RLTreeMap::layoutChildren(size_t aNodeIdx, int aDepth) {
+    const size_t lFirst = mChildOffsets[aNodeIdx];
+    const size_t lLast = mChildOffsets[aNodeIdx + 1];
+    if (lFirst == lLast) {
         // Leaf node - just set the rect
-        return;
+        return false;
     }
 
     // Calculate child area (accounting for internal node padding if showing)
-    Rectangle lChildArea = aAvailable;
+    Rectangle lChildArea = mRects[aNodeIdx].mTargetRect;
     if (mStyle.mShowInternalNodes) {
         lChildArea.x += mStyle.mPaddingInner;
         lChildArea.y += mStyle.mPaddingTop;  // Extra space for label
@@ -210,33 +398,34 @@ void RLTreeMap::layoutNode(size_t aNodeIdx, Rectangle aAvailable, int aDepth) {
         lChildArea.height -= mStyle.mPaddingTop + mStyle.mPaddingInner;
     }
 
+    // Unplaced nodes keep an empty target, also when they had one before
+    for (size_t c = lFirst; c < lLast; ++c) {
+        mRects[mChildList[c]].mTargetRect = Rectangle{0, 0, 0, 0};
+    }
+
     // Skip if area too small
     if (lChildArea.width < mStyle.mMinNodeSize || lChildArea.height < mStyle.mMinNodeSize) {
-        return;
+        clearSubtreeTargets(aNodeIdx);
+        return false;
     }
 
     // Apply layout algorithm
+    mLayoutScratch.assign(mChildList.begin() + (std::ptrdiff_t)lFirst, mChildList.begin() + (std::ptrdiff_t)lLast);
     switch (mLayout) {
         case RLTreeMapLayout::SQUARIFIED:
-            layoutSquarified(lChildIndices, lChildArea);
+            layoutSquarified(mLayoutScratch, lChildArea);
             break;
         case RLTreeMapLayout::SLICE:
-            layoutSlice(lChildIndices, lChildArea, true);
+            layoutSlice(mLayoutScratch, lChildArea, true);
             break;
         case RLTreeMapLayout::DICE:
-            layoutSlice(lChildIndices, lChildArea, false);
+            layoutSlice(mLayoutScratch, lChildArea, false);
             break;
         case RLTreeMapLayout::SLICE_DICE:
-            layoutSlice(lChildIndices, lChildArea, (aDepth % 2) == 0);
+            layoutSlice(mLayoutScratch, lChildArea, (aDepth % 2) == 0);
             break;
     }
-
-    // Recursively layout children
-    for (const size_t lIdx : lChildIndices) {
-        // Find grandchildren depth
-        const int lChildDepth = mRects[lIdx].mDepth;
-        layoutNode(lIdx, mRects[lIdx].mTargetRect, lChildDepth);
-    }
+    return true;
 }
 
 float RLTreeMap::sumChildValues(const std::vector<size_t>& rIndices) const {
@@ -265,7 +454,8 @@ void RLTreeMap::layoutSquarified(std::vector<size_t>& rChildIndices, Rectangle a
 
     // Working variables
     Rectangle lRemaining = aAvailable;
-    std::vector<size_t> lRow;
+    RLCharts::FrameScratch lScratch;
+    std::pmr::vector<size_t> lRow(lScratch.resource());
     float lRowValue = 0.0f;
     size_t lIdx = 0;
 
@@ -403,9 +593,9 @@ void RLTreeMap::layoutSlice(std::vector<size_t>& rChildIndices, Rectangle aAvail
     }
 }
 
-Color RLTreeMap::computeNodeColor(const RLTreeNode& rNode, int aDepth) const {
-    if (rNode.mUseColor) {
-        return rNode.mColor;
+Color RLTreeMap::computeNodeColor(size_t aNode, int aDepth) const {
+    if (!mData.mUseColor.empty() && mData.mUseColor[aNode] != 0) {
+        return mData.mColor[aNode];
     }
 
     if (mStyle.mUseDepthColors && !mStyle.mDepthPalette.empty()) {
@@ -417,7 +607,31 @@ Color RLTreeMap::computeNodeColor(const RLTreeNode& rNode, int aDepth) const {
     return Color{80, 180, 255, 255};
 }
 
+bool RLTreeMap::isSettled() const {
+    if (mDataDirty) {
+        return false;
+    }
+    for (const auto& rRect : mRects) {
+        if (!RLCharts::nearlyEqual(rRect.mRect.x, rRect.mTargetRect.x) ||
+            !RLCharts::nearlyEqual(rRect.mRect.y, rRect.mTargetRect.y) ||
+            !RLCharts::nearlyEqual(rRect.mRect.width, rRect.mTargetRect.width) ||
+            !RLCharts::nearlyEqual(rRect.mRect.height, rRect.mTargetRect.height) ||
+            !RLCharts::nearlyEqual(rRect.mAlpha, rRect.mTargetAlpha) ||
+            !RLCharts::colorEquals(rRect.mColor, rRect.mTargetColor)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 void RLTreeMap::update(float aDt) {
+    RLCHARTS_PERF_UPDATE(mPerf, "RLTreeMap::update");
+    if (isSettled()) {
+        return;
+    }
+    mRedrawPending = true;
+    mPickDirty = true;
+
     if (mDataDirty) {
         computeLayout();
     }
@@ -434,14 +648,17 @@ void RLTreeMap::update(float aDt) {
     const float lSizeDt = mStyle.mAnimateSpeed * aDt;
     const float lColorDt = mStyle.mColorSpeed * aDt;
 
+    static_assert(sizeof(Rectangle) == 4 * sizeof(float), "Rectangle is stepped as packed floats");
     for (auto& rRect : mRects) {
-        rRect.mRect = lerpRect(rRect.mRect, rRect.mTargetRect, lSizeDt);
-        rRect.mColor = lerpColor(rRect.mColor, rRect.mTargetColor, lColorDt);
+        RLCharts::approachArray(&rRect.mRect.x, &rRect.mTargetRect.x, 4, lSizeDt);
+        rRect.mColor = RLCharts::approachColor(rRect.mColor, rRect.mTargetColor, lColorDt);
         rRect.mAlpha = approach(rRect.mAlpha, rRect.mTargetAlpha, lSizeDt);
     }
 }
 
 void RLTreeMap::draw() const {
+    RLCHARTS_PERF_DRAW(mPerf, "RLTreeMap::draw");
+    mRedrawPending = false;
     // Background
     if (mStyle.mShowBackground) {
         DrawRectangleRec(mBounds, mStyle.mBackground);
@@ -506,10 +723,11 @@ void RLTreeMap::draw() const {
         const bool lShowLabel = (rRect.mIsLeaf && mStyle.mShowLeafLabels) ||
                           (!rRect.mIsLeaf && mStyle.mShowInternalLabels);
 
-        if (lShowLabel && !rRect.mLabel.empty()) {
+        const std::string& rLabel = mData.mLabels[rRect.mLabelId];
+        if (lShowLabel && !rLabel.empty()) {
             const int lFontSize = mStyle.mLabelFontSize;
             const Font& lFont = (mStyle.mLabelFont.baseSize > 0) ? mStyle.mLabelFont : GetFontDefault();
-            const Vector2 lTextSize = MeasureTextEx(lFont, rRect.mLabel.c_str(), (float)lFontSize, 0);
+            const Vector2 lTextSize = mLabelCache.measure(lFont, rLabel.c_str(), (float)lFontSize, 0);
             const int lTextWidth = (int)lTextSize.x;
             const int lTextHeight = (int)lTextSize.y;
 
@@ -541,26 +759,90 @@ void RLTreeMap::draw() const {
                     lY = rRect.mRect.y + 2.0f;
                 }
 
-                DrawTextEx(lFont, rRect.mLabel.c_str(), Vector2{lX, lY}, (float)lFontSize, 0, lLabelColor);
+                DrawTextEx(lFont, rLabel.c_str(), Vector2{lX, lY}, (float)lFontSize, 0, lLabelColor);
             }
         }
     }
 }
 
-int RLTreeMap::getNodeAtPoint(Vector2 aPoint) const {
-    // Return deepest node containing the point
-    int lResult = -1;
+const std::string& RLTreeMap::getLabel(size_t aNode) const {
+    static const std::string EMPTY_LABEL;
+    if (aNode >= mRects.size()) {
+        return EMPTY_LABEL;
+    }
+    return mData.mLabels[mRects[aNode].mLabelId];
+}
+
+namespace RLCharts {
+
+static bool pickContains(const Rectangle& rR, Vector2 aPoint) {
+    return rR.width > 0.0f && rR.height > 0.0f && aPoint.x >= rR.x && aPoint.x <= rR.x + rR.width &&
+           aPoint.y >= rR.y && aPoint.y <= rR.y + rR.height;
+}
+
+} // namespace RLCharts
+
+void RLTreeMap::buildPickBounds() const {
+    mPickDirty = false;
+    mPickBounds.resize(mRects.size());
     for (size_t i = 0; i < mRects.size(); ++i) {
         const Rectangle& rR = mRects[i].mRect;
-        if (aPoint.x >= rR.x && aPoint.x <= rR.x + rR.width &&
-            aPoint.y >= rR.y && aPoint.y <= rR.y + rR.height) {
-            lResult = (int)i;
+        // Empty (cleared or collapsed) rects are never hit
+        mPickBounds[i] = (rR.width > 0.0f && rR.height > 0.0f) ? rR : Rectangle{0, 0, 0, 0};
+    }
+    // Children come after their parent: a reverse pass grows each parent by
+    // its finished subtrees
+    for (size_t i = mRects.size(); i-- > 1;) {
+        const Rectangle& rChild = mPickBounds[i];
+        if (rChild.width <= 0.0f) {
+            continue;
+        }
+        Rectangle& rParent = mPickBounds[mRects[i].mParentIndex];
+        if (rParent.width <= 0.0f) {
+            rParent = rChild;
+            continue;
+        }
+        const float lX0 = fminf(rParent.x, rChild.x);
+        const float lY0 = fminf(rParent.y, rChild.y);
+        const float lX1 = fmaxf(rParent.x + rParent.width, rChild.x + rChild.width);
+        const float lY1 = fmaxf(rParent.y + rParent.height, rChild.y + rChild.height);
+        rParent = Rectangle{lX0, lY0, lX1 - lX0, lY1 - lY0};
+    }
+}
+
+int RLTreeMap::getNodeAtPoint(Vector2 aPoint) const {
+    if (mRects.empty()) {
+        return -1;
+    }
+    if (mPickDirty) {
+        buildPickBounds();
+    }
+    // Return deepest node containing the point (the last one in node order),
+    // descending only into subtrees whose bounds contain it
+    int lResult = -1;
+    mPickStack.clear();
+    mPickStack.push_back(0);
+    while (!mPickStack.empty()) {
+        const size_t lNode = mPickStack.back();
+        mPickStack.pop_back();
+        if (!RLCharts::pickContains(mPickBounds[lNode], aPoint)) {
+            continue;
+        }
+        if ((int)lNode > lResult && RLCharts::pickContains(mRects[lNode].mRect, aPoint)) {
+            lResult = (int)lNode;
+        }
+        for (size_t c = mChildOffsets[lNode]; c < mChildOffsets[lNode + 1]; ++c) {
+            mPickStack.push_back(mChildList[c]);
         }
     }
     return lResult;
 }
 
 void RLTreeMap::setHighlightedNode(int aIndex) {
+    // Usually driven by per-frame hover tests: only a change needs a redraw
+    if (aIndex != mHighlightedIndex) {
+        mRedrawPending = true;
+    }
     mHighlightedIndex = aIndex;
 }
 
@@ -571,33 +853,3 @@ float RLTreeMap::approach(float a, float b, float aSpeedDt) {
     }
     return a + lDiff * (aSpeedDt > 1.0f ? 1.0f : aSpeedDt);
 }
-
-Color RLTreeMap::lerpColor(const Color& a, const Color& b, float t) {
-    if (t >= 1.0f) {
-        return b;
-    }
-    if (t <= 0.0f) {
-        return a;
-    }
-    Color lResult;
-    lResult.r = (unsigned char)((float)a.r + ((float)b.r - (float)a.r) * t);
-    lResult.g = (unsigned char)((float)a.g + ((float)b.g - (float)a.g) * t);
-    lResult.b = (unsigned char)((float)a.b + ((float)b.b - (float)a.b) * t);
-    lResult.a = (unsigned char)((float)a.a + ((float)b.a - (float)a.a) * t);
-    return lResult;
-}
-
-Rectangle RLTreeMap::lerpRect(const Rectangle& a, const Rectangle& b, float t) {
-    if (t >= 1.0f) {
-        return b;
-    }
-    if (t <= 0.0f) {
-        return a;
-    }
-    Rectangle lResult;
-    lResult.x = a.x + (b.x - a.x) * t;
-    lResult.y = a.y + (b.y - a.y) * t;
-    lResult.width = a.width + (b.width - a.width) * t;
-    lResult.height = a.height + (b.height - a.height) * t;
-    return lResult;
-}
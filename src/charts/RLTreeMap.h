@@ -1,9 +1,13 @@
 // RLTreeMap.h
 #pragma once
 #include "raylib.h"
+#include "RLPerf.h"
+#include "RLLabelCache.h"
 #include <vector>
 #include <string>
 #include <functional>
+#include <cstdint>
+#include <unordered_map>
 
 // D3-style TreeMap visualization for raylib
 // Usage: construct with bounds, set hierarchy via setData(), call update(dt) and draw() each frame.
@@ -17,6 +21,42 @@ struct RLTreeNode {
     std::vector<RLTreeNode> mChildren;          // Child nodes (empty for leaves)
 };
 
+// Flat (structure-of-arrays) hierarchy, the cheap form for large trees: node 0 is
+// the root and every other node's parent comes before it. Labels are ids into
+// mLabels, so repeated names share one string. setTargetData() with an unchanged
+// structure (parents and label ids) only reads the values and colors.
+struct RLTreeFlatData {
+    static constexpr uint32_t NO_PARENT = 0xFFFFFFFFu;
+
+    std::vector<uint32_t> mParent;   // parent index (NO_PARENT for the root)
+    std::vector<float> mValue;       // leaf value; internal nodes are summed
+    std::vector<uint32_t> mLabelId;  // index into mLabels
+    std::vector<Color> mColor;       // optional (empty or one per node)
+    std::vector<uint8_t> mUseColor;  // optional (empty or one per node): 0 = color mapping rules
+    std::vector<std::string> mLabels;
+
+    [[nodiscard]] size_t size() const { return mParent.size(); }
+    void clear() {
+        mParent.clear();
+        mValue.clear();
+        mLabelId.clear();
+        mColor.clear();
+        mUseColor.clear();
+        mLabels.clear();
+    }
+    uint32_t addLabel(const std::string& rLabel) {
+        mLabels.push_back(rLabel);
+        return (uint32_t)(mLabels.size() - 1);
+    }
+    // Returns the node index
+    uint32_t addNode(uint32_t aParent, uint32_t aLabelId, float aValue) {
+        mParent.push_back(aParent);
+        mLabelId.push_back(aLabelId);
+        mValue.push_back(aValue);
+        return (uint32_t)(mParent.size() - 1);
+    }
+};
+
 // Layout algorithm options
 enum class RLTreeMapLayout {
     SQUARIFIED,     // Squarified treemap (best aspect ratios)
@@ -73,7 +113,7 @@ struct RLTreeRect {
     Color mTargetColor{80, 180, 255, 255}; // Target color
     float mAlpha{1.0f};                 // Current visibility alpha
     float mTargetAlpha{1.0f};           // Target alpha
-    std::string mLabel;                 // Node label
+    uint32_t mLabelId{0};               // Label, see RLTreeMap::getLabel()
     int mDepth{0};                      // Depth in hierarchy
     bool mIsLeaf{true};                 // Whether this is a leaf node
     float mValue{0.0f};                 // Node value
@@ -89,14 +129,23 @@ public:
     void setStyle(const RLTreeMapStyle& rStyle);
     void setLayout(RLTreeMapLayout aLayout);
 
-    // Set hierarchy data (triggers layout recomputation)
+    // Set hierarchy data (triggers layout recomputation). The node tree is
+    // converted to the flat form on the way in, it is not kept.
     void setData(const RLTreeNode& rRoot);
+    // Flat form; returns false (and keeps the current data) if a parent index
+    // does not precede its node or the optional arrays have the wrong size
+    bool setData(const RLTreeFlatData& rData);
 
     // Dynamic update: set new data with animation
     void setTargetData(const RLTreeNode& rRoot);
+    bool setTargetData(const RLTreeFlatData& rData);
 
-    // Update a single node value by path (e.g., {"Parent", "Child"})
+    // Update a single node value by path (e.g., {"Parent", "Child"}). Only the
+    // leaf's ancestors are re-summed and re-laid out, plus the subtrees whose
+    // rectangle moved as a result; the rest of the layout is kept.
     void updateValue(const std::vector<std::string>& rPath, float aNewValue);
+    // Same by node index (RLTreeFlatData order, which is also getComputedRects() order)
+    void updateValue(size_t aNode, float aNewValue);
 
     // Force layout recomputation
     void recomputeLayout();
@@ -107,10 +156,19 @@ public:
     // Draw the treemap
     void draw() const;
 
+    // Settled once the layout is current and every rectangle reached its target
+    // geometry, color and alpha
+    [[nodiscard]] bool isSettled() const;
+    [[nodiscard]] bool needsRedraw() const { return mRedrawPending || !isSettled(); }
+    // update()/rebuild/draw() timers and GPU counters (RLPerf.h); zero unless built with RLCHARTS_PERF
+    [[nodiscard]] const RLCharts::PerfStats& getPerfStats() const { return mPerf; }
+
     // Accessors
     [[nodiscard]] Rectangle getBounds() const { return mBounds; }
     [[nodiscard]] const std::vector<RLTreeRect>& getComputedRects() const { return mRects; }
     [[nodiscard]] size_t getNodeCount() const { return mRects.size(); }
+    [[nodiscard]] const std::string& getLabel(size_t aNode) const;
+    [[nodiscard]] const RLTreeFlatData& getData() const { return mData; }
 
     // Optional: get node at point (returns index or -1)
     [[nodiscard]] int getNodeAtPoint(Vector2 aPoint) const;
@@ -124,37 +182,63 @@ private:
     RLTreeMapStyle mStyle{};
     RLTreeMapLayout mLayout{RLTreeMapLayout::SQUARIFIED};
 
-    // Hierarchy storage
-    RLTreeNode mRoot;
+    // Hierarchy storage (flat; RLTreeNode input is converted into it)
+    RLTreeFlatData mData;
+    RLTreeFlatData mConvertScratch;                       // RLTreeNode input, converted
+    std::unordered_map<std::string, uint32_t> mLabelIds; // label interning during the conversion
     bool mDataDirty{false};
 
-    // Flattened computed rectangles
+    // Computed rectangles, one per node in mData order
     std::vector<RLTreeRect> mRects;
-    std::vector<RLTreeRect> mTargetRects;
+    // Children of node i: mChildList[mChildOffsets[i] .. mChildOffsets[i + 1])
+    std::vector<size_t> mChildOffsets;
+    std::vector<size_t> mChildList;
+    std::vector<size_t> mLayoutScratch;  // child order handed to the layout algorithms
+    std::vector<size_t> mClearStack;     // subtree walk when clearing targets
+    std::vector<Rectangle> mOldTargets;  // children's targets before an incremental re-layout
 
     // Highlight
     int mHighlightedIndex{-1};
 
+    // Hit-testing: per node, the bounds of its rect and all its descendants'
+    // (children can overhang while animating); rebuilt on the first query after
+    // the rects moved
+    mutable std::vector<Rectangle> mPickBounds;
+    mutable std::vector<size_t> mPickStack;
+    mutable bool mPickDirty{true};
+
+    mutable bool mRedrawPending{true}; // cleared by draw()
+    mutable RLCharts::PerfStats mPerf;
+    mutable RLCharts::LabelCache mLabelCache; // label extents for the fit check
+
     // Layout computation
     void computeLayout();
-    void flattenHierarchy(const RLTreeNode& rNode, int aDepth, size_t aParentIdx);
+    void flattenHierarchy(const RLTreeNode& rNode, uint32_t aParentIdx, RLTreeFlatData& rOut);
+    [[nodiscard]] static bool isValidData(const RLTreeFlatData& rData);
+    [[nodiscard]] bool sameStructure(const RLTreeFlatData& rData) const;
+    void adoptData(const RLTreeFlatData& rData, bool aAnimate);
+    void rebuildRects();
+    void clearSubtreeTargets(size_t aNodeIdx);
     void layoutNode(size_t aNodeIdx, Rectangle aAvailable, int aDepth);
+    // Place the direct children of aNodeIdx inside its target rect; false if the
+    // area is too small (the whole subtree is then cleared)
+    bool layoutChildren(size_t aNodeIdx, int aDepth);
+    void buildChildIndex();
+    void sumSubtreeValues();
+    [[nodiscard]] bool relayoutPath(const std::vector<size_t>& rPath);
     void layoutSquarified(std::vector<size_t>& rChildIndices, Rectangle aAvailable);
     void layoutSlice(std::vector<size_t>& rChildIndices, Rectangle aAvailable, bool aVertical);
 
     // Helper: sum values of children
     [[nodiscard]] float sumChildValues(const std::vector<size_t>& rIndices) const;
 
-    // Helper: compute total value of a subtree
-    [[nodiscard]] float computeSubtreeValue(const RLTreeNode& rNode) const;
+    void buildPickBounds() const;
 
     // Color computation
-    [[nodiscard]] Color computeNodeColor(const RLTreeNode& rNode, int aDepth) const;
+    [[nodiscard]] Color computeNodeColor(size_t aNode, int aDepth) const;
 
     // Animation helpers
     [[nodiscard]] static float approach(float a, float b, float aSpeedDt);
-    [[nodiscard]] static Color lerpColor(const Color& a, const Color& b, float t);
-    [[nodiscard]] static Rectangle lerpRect(const Rectangle& a, const Rectangle& b, float t);
 
     // Default palette
     void ensureDefaultPalette();
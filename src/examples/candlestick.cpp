@@ -4,62 +4,9 @@
 #include <string>
 #include <vector>
 #include <fstream>
-#include <sstream>
 #include <iostream>
 #include "RLCandlestickChart.h"
-
-struct CSVRow {
-    std::string aDate;
-    float aOpen{0.0f};
-    float aHigh{0.0f};
-    float aLow{0.0f};
-    float aClose{0.0f};
-    float aVolume{0.0f};
-    int aBarCount{0};
-    int aOfBars{0};
-};
-
-static bool parseRow(const std::string &aLine, CSVRow &rOut){
-    // Expect: date,open,high,low,close,volume,bar_count,of_bars
-    std::vector<std::string> lParts;
-    lParts.reserve(8);
-    std::stringstream lSS(aLine);
-    std::string lItem;
-    while (std::getline(lSS, lItem, ',')) lParts.push_back(lItem);
-    if (lParts.size() < 6) return false;
-    rOut.aDate = lParts[0];
-    try {
-        rOut.aOpen = std::stof(lParts[1]);
-        rOut.aHigh = std::stof(lParts[2]);
-        rOut.aLow = std::stof(lParts[3]);
-        rOut.aClose = std::stof(lParts[4]);
-        rOut.aVolume = std::stof(lParts[5]);
-        if (lParts.size() >= 7) rOut.aBarCount = std::stoi(lParts[6]);
-        if (lParts.size() >= 8) rOut.aOfBars = std::stoi(lParts[7]);
-    } catch (...) { return false; }
-    return true;
-}
-
-static std::vector<CSVRow> loadCSV(const std::string &aPath){
-    std::ifstream lIn(aPath);
-    std::vector<CSVRow> lRows;
-    if (!lIn.is_open()) return lRows;
-    std::string lLine;
-    // Optional header: detect if first line has alpha characters
-    if (std::getline(lIn, lLine)){
-        bool lHasAlpha = false;
-        for (char c : lLine){ if ((c>='A'&&c<='Z')||(c>='a'&&c<='z')) { lHasAlpha = true; break; } }
-        if (!lHasAlpha){
-            CSVRow lRow{};
-            if (parseRow(lLine, lRow)) lRows.push_back(lRow);
-        }
-    }
-    while (std::getline(lIn, lLine)){
-        CSVRow lRow{};
-        if (parseRow(lLine, lRow)) lRows.push_back(lRow);
-    }
-    return lRows;
-}
+#include "RLOhlcLoader.h"
 
 static std::string resolveCSVPath(){
     // Try common paths relative to typical CMake build dirs
@@ -96,9 +43,13 @@ int main(){
     } else {
         std::cerr << "Loading CSV from: " << lCsvPath << "\n";
     }
-    std::vector<CSVRow> lData = lCsvPath.empty() ? std::vector<CSVRow>{} : loadCSV(lCsvPath);
+    RLCharts::OhlcColumns lData;
+    if (!lCsvPath.empty()) {
+        RLCharts::loadOhlcCsv(lCsvPath.c_str(), lData);
+    }
     std::cerr << "Loaded rows: " << lData.size() << "\n";
-    size_t lCursor = 0;
+    RLCharts::OhlcReplay lReplay(lData);
+    lReplay.setRate(1.0);
 
     // Create styles
     RLCandleStyle lStyleDefault{};
@@ -119,27 +70,22 @@ int main(){
     RLCandlestickChart lChart2(lR2, 3, 30, lStyleAlt);      // faster aggregation, more candles
     RLCandlestickChart lChart3(lR3, 8, 15, lStyleDefault);  // slower aggregation, fewer candles
 
-    float lAccum = 0.0f;
-
     while (!WindowShouldClose()){
         float lDt = GetFrameTime();
-        lAccum += lDt;
-
-        // Feed one CSV row per second
-        if (lAccum >= 1.0f && lCursor < lData.size()){
-            lAccum -= 1.0f;
-            const CSVRow &lRow = lData[lCursor++];
-            RLCandlestickChart::CandleInput lIn{};
-            lIn.aDate = lRow.aDate;
-            lIn.aOpen = lRow.aOpen;
-            lIn.aHigh = lRow.aHigh;
-            lIn.aLow = lRow.aLow;
-            lIn.aClose = lRow.aClose;
-            lIn.aVolume = lRow.aVolume;
+
+        // Replay the CSV at a fixed row rate
+        lReplay.advance(lDt, [&](size_t aRow) {
+            RLCandlestickChart::CandleSample lIn{};
+            lIn.aOpen = lData.mOpen[aRow];
+            lIn.aHigh = lData.mHigh[aRow];
+            lIn.aLow = lData.mLow[aRow];
+            lIn.aClose = lData.mClose[aRow];
+            lIn.aVolume = lData.mVolume[aRow];
+            lIn.aTime = lData.mTime[aRow];
             lChart1.addSample(lIn);
             lChart2.addSample(lIn);
             lChart3.addSample(lIn);
-        }
+        });
 
         lChart1.update(lDt);
         lChart2.update(lDt);
@@ -160,7 +106,7 @@ int main(){
         // Status
         if (lData.empty()){
             DrawTextEx(lFont, "CSV not found or empty. Place JPM_1_minute_bars.csv in project root or build dir.", Vector2{20, (float)(lScreenH - 28)}, 20, 1.0f, {255, 120, 120, 255});
-        } else if (lCursor >= lData.size()){
+        } else if (lReplay.finished()){
             DrawTextEx(lFont, "End of CSV reached", Vector2{20, (float)(lScreenH - 28)}, 20, 1.0f, {200, 200, 210, 255});
         } else {
             DrawTextEx(lFont, "Streaming 1 row/sec from JPM_1_minute_bars.csv", Vector2{20, (float)(lScreenH - 28)}, 20, 1.0f, {200, 200, 210, 255});
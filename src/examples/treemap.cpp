@@ -415,7 +415,7 @@ int main() {
             if ((size_t)lHoveredNode < lRects.size()) {
                 const RLTreeRect& lHovered = lRects[(size_t)lHoveredNode];
 
-                snprintf(lBuf, sizeof(lBuf), "Label: %s", lHovered.mLabel.c_str());
+                snprintf(lBuf, sizeof(lBuf), "Label: %s", lTreeMap.getLabel((size_t)lHoveredNode).c_str());
                 DrawTextEx(lBaseFont, lBuf, Vector2{(float)lInfoX, (float)lInfoY}, 16, 1.0f, Color{180, 180, 190, 255});
                 lInfoY += lLineH;
 
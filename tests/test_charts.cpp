@@ -11,6 +11,8 @@
 #include "RLBarChart.h"
 #include "RLBubble.h"
 #include "RLCandlestickChart.h"
+#include "RLDashboard.h"
+#include "RLDataSource.h"
 #include "RLGauge.h"
 #include "RLHeatMap.h"
 #include "RLHeatMap3D.h"
@@ -23,8 +25,16 @@
 #include "RLScatterPlot.h"
 #include "RLTimeSeries.h"
 #include "RLTreeMap.h"
+#include "RLRenderCache.h"
+#include "RLGaugePanel.h"
+#include "RLOffscreen.h"
+#include "RLGpuStaging.h"
 
 #include "doctest/doctest.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
 
 // Global flag from test_main.cpp indicating raylib availability
 extern bool gRaylibAvailable;
@@ -32,6 +42,18 @@ extern bool gRaylibAvailable;
 // Helper macro to skip tests when raylib isn't available
 #define REQUIRE_RAYLIB() do { if (!gRaylibAvailable) { MESSAGE("Skipping: no raylib context"); return; } } while(0)
 
+// operator new calls on this thread, counted by test_main.cpp
+extern thread_local size_t gThreadAllocations;
+
+// Allocations and GPU upload bytes since construction, for the perf-contract tests
+struct PerfBudget {
+    size_t mAllocStart = gThreadAllocations;
+    uint64_t mUploadStart = RLCharts::gpuUploadCounters().getTotalBytes();
+
+    [[nodiscard]] size_t allocations() const { return gThreadAllocations - mAllocStart; }
+    [[nodiscard]] uint64_t uploadBytes() const { return RLCharts::gpuUploadCounters().getTotalBytes() - mUploadStart; }
+};
+
 // Test bounds used across tests
 const Rectangle TEST_BOUNDS = {0, 0, 400, 300};
 
@@ -140,6 +162,117 @@ TEST_SUITE("RLGauge") {
         CHECK(lGauge.getValue() == doctest::Approx(75.0f));
     }
 
+    TEST_CASE("Settles and stops requesting redraws") {
+        REQUIRE_RAYLIB();
+
+        RLGauge lGauge(TEST_BOUNDS, 0.0f, 100.0f);
+        lGauge.setTargetValue(80.0f);
+        CHECK_FALSE(lGauge.isSettled());
+
+        int lFrames = 0;
+        while (!lGauge.isSettled() && lFrames < 1000) {
+            lGauge.update(0.016f);
+            lFrames++;
+        }
+        CHECK(lGauge.isSettled());
+        CHECK(lGauge.getValue() == doctest::Approx(80.0f));
+        CHECK(lGauge.needsRedraw());
+
+        lGauge.draw();
+        CHECK_FALSE(lGauge.needsRedraw());
+
+        // Re-publishing the same target or value is free
+        lGauge.setTargetValue(80.0f);
+        lGauge.setValue(lGauge.getValue());
+        lGauge.update(0.016f);
+        CHECK_FALSE(lGauge.needsRedraw());
+
+        lGauge.setBounds({10, 10, 200, 200});
+        CHECK(lGauge.needsRedraw());
+    }
+
+    TEST_CASE("Render cache only re-renders on change") {
+        REQUIRE_RAYLIB();
+
+        RLGauge lGauge(TEST_BOUNDS, 0.0f, 100.0f);
+        lGauge.setValue(40.0f);
+        RLCharts::RenderCache lCache;
+
+        lCache.draw(lGauge, TEST_BOUNDS);
+        CHECK(lCache.getRenderCount() == 1u);
+        for (int i = 0; i < 10; i++) {
+            lGauge.update(0.016f);
+            lCache.draw(lGauge, TEST_BOUNDS);
+        }
+        CHECK(lCache.getRenderCount() == 1u);
+
+        lGauge.setValue(60.0f);
+        lCache.draw(lGauge, TEST_BOUNDS);
+        CHECK(lCache.getRenderCount() == 2u);
+
+        // A size change recreates the target
+        lCache.draw(lGauge, Rectangle{0, 0, 200, 150});
+        CHECK(lCache.getRenderCount() == 3u);
+
+        lCache.invalidate();
+        lCache.draw(lGauge, Rectangle{0, 0, 200, 150});
+        CHECK(lCache.getRenderCount() == 4u);
+    }
+
+    TEST_CASE("Panel bakes one face per distinct key") {
+        REQUIRE_RAYLIB();
+
+        std::vector<RLGauge> lGauges;
+        for (int i = 0; i < 20; ++i) {
+            lGauges.emplace_back(Rectangle{ (float)(i % 5) * 80.0f, (float)(i / 5) * 80.0f, 80, 80 }, 0.0f, 100.0f);
+            lGauges.back().setValue((float)i * 5.0f);
+        }
+        // Values never change the face
+        CHECK(lGauges[0].getFaceKey() == lGauges[7].getFaceKey());
+
+        RLLinearGauge lLinear(Rectangle{0, 0, 300, 80}, 0.0f, 100.0f);
+        lLinear.setLabel("Load");
+        const uint64_t lLinearKey = lLinear.getFaceKey();
+        lLinear.setValue(70.0f);
+        CHECK(lLinear.getFaceKey() == lLinearKey);
+        lLinear.setLabel("Temp");
+        CHECK(lLinear.getFaceKey() != lLinearKey);
+
+        RLCharts::GaugePanel lPanel(1024);
+        for (int lFrame = 0; lFrame < 3; ++lFrame) {
+            lPanel.begin();
+            for (const RLGauge& rGauge : lGauges) {
+                lPanel.add(rGauge);
+            }
+            lPanel.add(lLinear);
+            lPanel.end();
+        }
+        CHECK(lPanel.isValid());
+        CHECK(lPanel.getFaceCount() == 2);
+        CHECK(lPanel.getBakeCount() == 2);
+        CHECK(lPanel.getDirectFaceCount() == 0);
+        CHECK_FALSE(lGauges[3].needsRedraw());
+
+        // A different style is a new face
+        RLGaugeStyle lStyle;
+        lStyle.mTickCount = 30;
+        lGauges[0].setStyle(lStyle);
+        lPanel.begin();
+        lPanel.add(lGauges[0]);
+        lPanel.add(lGauges[1]);
+        lPanel.end();
+        CHECK(lPanel.getFaceCount() == 3);
+        CHECK(lPanel.getBakeCount() == 3);
+
+        // Faces larger than the atlas are drawn directly
+        RLCharts::GaugePanel lSmall(64);
+        lSmall.begin();
+        lSmall.add(lGauges[1]);
+        lSmall.end();
+        CHECK(lSmall.getFaceCount() == 0);
+        CHECK(lSmall.getDirectFaceCount() == 1);
+    }
+
 }
 
 TEST_SUITE("RLLinearGauge") {
@@ -449,6 +582,84 @@ TEST_SUITE("RLLinearGauge") {
         CHECK(lGauge.isClipping(1) == false);
     }
 
+    TEST_CASE("VU Meter PCM ingest drives RMS, peak and clip") {
+        REQUIRE_RAYLIB();
+
+        RLLinearGaugeStyle lStyle;
+        lStyle.mVuStyle.mRmsIntegrationTime = 0.01f;
+        RLLinearGauge lGauge(TEST_BOUNDS, 0.0f, 1.0f, RLLinearGaugeOrientation::VERTICAL, lStyle);
+        lGauge.setMode(RLLinearGaugeMode::VU_METER);
+        std::vector<RLVuMeterChannel> lChannels = {
+            {0.0f, "L"},
+            {0.0f, "R"}
+        };
+        lGauge.setChannels(lChannels);
+
+        // Left: constant 0.5 (RMS 0.5), right: silence. 0.1 s at 48 kHz settles the 10 ms integrator
+        std::vector<float> lPcm(2 * 4800, 0.0f);
+        for (size_t f = 0; f < 4800; f++) {
+            lPcm[2 * f] = 0.5f;
+        }
+        lGauge.pushPcm(lPcm, 48000.0f);
+        CHECK(lGauge.getChannelRms(0) == doctest::Approx(0.5f).epsilon(0.01));
+        CHECK(lGauge.getChannelRms(1) == doctest::Approx(0.0f));
+        CHECK(lGauge.getPeakValue(0) >= 0.5f);
+        CHECK(lGauge.getTruePeak(0) >= 0.5f);
+        CHECK_FALSE(lGauge.isClipping(0));
+
+        // A full-scale sample on the right raises its true peak to the clip level
+        lPcm.assign(2 * 64, 0.0f);
+        lPcm[2 * 10 + 1] = 1.0f;
+        lGauge.pushPcm(lPcm, 48000.0f);
+        CHECK(lGauge.getTruePeak(1) >= 1.0f);
+        CHECK(lGauge.isClipping(1));
+
+        lGauge.resetPeaks();
+        CHECK(lGauge.getTruePeak(1) == doctest::Approx(0.0f));
+    }
+
+    TEST_CASE("VU Meter PCM producer hands blocks across threads") {
+        REQUIRE_RAYLIB();
+
+        RLLinearGauge lGauge(TEST_BOUNDS, 0.0f, 1.0f);
+        lGauge.setMode(RLLinearGaugeMode::VU_METER);
+        std::vector<RLVuMeterChannel> lChannels = {
+            {0.0f, "1"},
+            {0.0f, "2"},
+            {0.0f, "3"},
+            {0.0f, "4"},
+            {0.0f, "5"}
+        };
+        lGauge.setChannels(lChannels);
+
+        RLLinearGauge::PcmProducer lProducer = lGauge.createPcmProducer(48000.0f, 4);
+        REQUIRE(lProducer.isValid());
+        CHECK_FALSE(RLLinearGauge::PcmProducer{}.isValid());
+
+        // Five channels at 0.1, 0.2, ... 0.5; the queue holds four blocks
+        std::vector<float> lBlock(5 * 256);
+        for (size_t i = 0; i < lBlock.size(); i++) {
+            lBlock[i] = 0.1f * (float)(i % 5 + 1);
+        }
+        int lPushed = 0;
+        std::thread lAudio([&]() {
+            for (int i = 0; i < 8; i++) {
+                lPushed += lProducer.push(lBlock.data(), 256) ? 1 : 0;
+            }
+        });
+        lAudio.join();
+        CHECK(lPushed == 4);   // The rest were dropped, not blocked on
+        CHECK_FALSE(lGauge.isSettled());
+
+        lGauge.update(0.016f);
+        for (int c = 0; c < 5; c++) {
+            CHECK(lGauge.getPeakValue(c) >= 0.1f * (float)(c + 1) - 1e-4f);
+            CHECK(lGauge.getTruePeak(c) >= 0.1f * (float)(c + 1) - 1e-4f);
+            CHECK(lGauge.getChannelRms(c) > 0.0f);
+        }
+        CHECK(lProducer.push(lBlock.data(), 256));
+    }
+
     TEST_CASE("VU Meter style configuration") {
         REQUIRE_RAYLIB();
 
@@ -480,6 +691,30 @@ TEST_SUITE("RLLinearGauge") {
 
 TEST_SUITE("RLAreaChart") {
 
+    TEST_CASE("Static layer follows the value axis") {
+        REQUIRE_RAYLIB();
+
+        RLAreaChart lChart(TEST_BOUNDS, RLAreaChartMode::STACKED);
+        RLAreaSeries lSeries;
+        lSeries.mValues = {10.0f, 20.0f, 30.0f};
+        lChart.setData({ lSeries });
+        lChart.setStaticLayerCache(true);
+        for (int i = 0; i < 200 && !lChart.isSettled(); i++) {
+            lChart.update(0.05f);
+        }
+        REQUIRE(lChart.isSettled());
+        lChart.draw();
+        lChart.draw();
+        CHECK(lChart.getStaticLayer().getRenderCount() == 1u);
+
+        // New data rescales the value axis, so its labels are re-rendered
+        lSeries.mValues = {100.0f, 200.0f, 300.0f};
+        lChart.setTargetData({ lSeries });
+        lChart.update(0.05f);
+        lChart.draw();
+        CHECK(lChart.getStaticLayer().getRenderCount() == 2u);
+    }
+
     TEST_CASE("Mode switching") {
         REQUIRE_RAYLIB();
 
@@ -562,6 +797,54 @@ TEST_SUITE("RLAreaChart") {
         CHECK(lChart.getMaxValue() == doctest::Approx(100.0f).epsilon(0.1));
     }
 
+    TEST_CASE("Streaming window keeps the last points") {
+        REQUIRE_RAYLIB();
+
+        RLAreaChart lChart(TEST_BOUNDS, RLAreaChartMode::STACKED);
+        std::vector<RLAreaSeries> lData(2);
+        lData[0].mValues = {1.0f, 2.0f};
+        lData[1].mValues = {10.0f, 20.0f};
+        lChart.setData(lData);
+        lChart.setStreamingWindow(4);
+        CHECK(lChart.isStreaming());
+        CHECK(lChart.getPointCount() == 2);
+        // Seeded from setData() without an entry animation
+        CHECK(lChart.getValue(1, 1) == doctest::Approx(20.0f));
+
+        for (int i = 3; i <= 7; ++i) {
+            const float lSample[2] = { (float)i, (float)(i * 10) };
+            lChart.pushSample(lSample);
+        }
+        REQUIRE(lChart.getPointCount() == 4);
+        for (size_t i = 0; i < 4; ++i) {
+            CHECK(lChart.getValue(0, i) == doctest::Approx((float)(i + 4)));
+            CHECK(lChart.getValue(1, i) == doctest::Approx((float)(i + 4) * 10.0f));
+        }
+        // Missing values are 0
+        const float lShort[1] = { 8.0f };
+        lChart.pushSample(lShort);
+        CHECK(lChart.getValue(1, 3) == doctest::Approx(0.0f));
+
+        // The value axis follows the largest stack in the window: 7 + 70
+        for (int i = 0; i < 200; ++i) {
+            lChart.update(0.016f);
+        }
+        CHECK(lChart.getMaxValue() == doctest::Approx(77.0f * 1.1f).epsilon(0.01));
+        lChart.setMode(RLAreaChartMode::OVERLAPPED);
+        for (int i = 0; i < 200; ++i) {
+            lChart.update(0.016f);
+        }
+        CHECK(lChart.getMaxValue() == doctest::Approx(70.0f * 1.1f).epsilon(0.01));
+        lChart.draw();
+
+        // Leaving streaming keeps the window as plain data
+        lChart.setStreamingWindow(0);
+        CHECK_FALSE(lChart.isStreaming());
+        CHECK(lChart.getPointCount() == 4);
+        CHECK(lChart.getValue(0, 0) == doctest::Approx(5.0f));
+        CHECK(lChart.getValue(0, 3) == doctest::Approx(8.0f));
+    }
+
 }
 
 TEST_SUITE("RLBarChart") {
@@ -627,6 +910,91 @@ TEST_SUITE("RLBarChart") {
         CHECK(lChart.getBounds().height == doctest::Approx(300.0f));
     }
 
+    TEST_CASE("Settles after removed bars fade out") {
+        REQUIRE_RAYLIB();
+
+        RLBarChart lChart(TEST_BOUNDS, RLBarOrientation::VERTICAL);
+        lChart.setData({{10.0f, RED, false, BLACK, "A"}, {20.0f, GREEN, false, BLACK, "B"}});
+        lChart.setTargetData({{35.0f, BLUE, false, BLACK, "A"}});
+        CHECK_FALSE(lChart.isSettled());
+
+        int lFrames = 0;
+        while (!lChart.isSettled() && lFrames < 1000) {
+            lChart.update(0.016f);
+            lFrames++;
+        }
+        CHECK(lChart.isSettled());
+        CHECK(lFrames < 1000);
+
+        lChart.draw();
+        CHECK_FALSE(lChart.needsRedraw());
+        lChart.update(0.016f);
+        CHECK_FALSE(lChart.needsRedraw());
+    }
+
+    TEST_CASE("Dense mode windows and merges bins") {
+        REQUIRE_RAYLIB();
+
+        RLBarChartStyle lStyle;
+        lStyle.mPadding = 0.0f; // 400 px plot
+        lStyle.mShowBackground = false;
+        RLBarChart lChart(TEST_BOUNDS, RLBarOrientation::VERTICAL, lStyle);
+        std::vector<float> lBins(10000, 1.0f);
+        lChart.setDenseData(lBins);
+        CHECK(lChart.isDense());
+        CHECK(lChart.getDenseBinCount() == 10000);
+
+        // 25 bins per pixel column: one merged bar per column
+        lChart.draw();
+        CHECK(lChart.getDenseDrawnBars() == 400);
+
+        // 200 bins over 400 px: one bar per bin, and a half-bin pan shows one more
+        lChart.setViewRange(100.0f, 200.0f);
+        lChart.draw();
+        CHECK(lChart.getDenseDrawnBars() == 200);
+        lChart.setViewRange(100.5f, 200.0f);
+        lChart.draw();
+        CHECK(lChart.getDenseDrawnBars() == 201);
+
+        // A single-bin spike survives merging; empty bins draw nothing
+        std::fill(lBins.begin(), lBins.end(), 0.0f);
+        lBins[5003] = 40.0f;
+        lChart.setDenseData(lBins);
+        lChart.resetViewRange();
+        lChart.draw();
+        CHECK(lChart.getDenseDrawnBars() == 1);
+        lChart.setViewRange(0.0f, 5000.0f);
+        lChart.draw();
+        CHECK(lChart.getDenseDrawnBars() == 0);
+
+        lChart.setData({{10.0f, RED, false, BLACK, "A"}});
+        CHECK_FALSE(lChart.isDense());
+        CHECK(lChart.getDenseBinCount() == 0);
+    }
+
+    TEST_CASE("Dense mode animates to target bins") {
+        REQUIRE_RAYLIB();
+
+        RLBarChart lChart(TEST_BOUNDS, RLBarOrientation::HORIZONTAL);
+        const std::vector<float> lFirst(2000, 5.0f);
+        const std::vector<float> lSecond(3000, 20.0f);
+        lChart.setDenseData(lFirst);
+        CHECK(lChart.isSettled());
+        lChart.setDenseTargetData(lSecond);
+        CHECK_FALSE(lChart.isSettled());
+
+        int lFrames = 0;
+        while (!lChart.isSettled() && lFrames < 1000) {
+            lChart.update(0.016f);
+            lFrames++;
+        }
+        CHECK(lChart.isSettled());
+        CHECK(lChart.getDenseBinCount() == 3000);
+        lChart.draw();
+        CHECK(lChart.getDenseDrawnBars() > 0);
+        CHECK_FALSE(lChart.needsRedraw());
+    }
+
 }
 
 TEST_SUITE("RLPieChart") {
@@ -680,6 +1048,48 @@ TEST_SUITE("RLPieChart") {
         CHECK(lChart.getBounds().width == doctest::Approx(400.0f));
     }
 
+    TEST_CASE("Slice meshes are rebuilt only on change") {
+        REQUIRE_RAYLIB();
+
+        RLPieChart lChart(TEST_BOUNDS);
+        lChart.setData({{25.0f, RED, "A"}, {25.0f, GREEN, "B"}, {25.0f, BLUE, "C"}, {25.0f, YELLOW, "D"}});
+        lChart.draw();
+        CHECK(lChart.getSliceMeshBuildCount() == 4);
+        lChart.draw();
+        CHECK(lChart.getSliceMeshBuildCount() == 4);
+
+        // Same total: only the last two slices move
+        lChart.setData({{25.0f, RED, "A"}, {25.0f, GREEN, "B"}, {40.0f, BLUE, "C"}, {10.0f, YELLOW, "D"}});
+        lChart.draw();
+        CHECK(lChart.getSliceMeshBuildCount() == 6);
+
+        // A new radius rebuilds every slice
+        lChart.setHollowFactor(0.5f);
+        lChart.draw();
+        CHECK(lChart.getSliceMeshBuildCount() == 10);
+    }
+
+    TEST_CASE("Small slices merge into other") {
+        REQUIRE_RAYLIB();
+
+        RLPieChartStyle lStyle;
+        lStyle.mOtherThreshold = 0.02f;
+        RLPieChart lChart(TEST_BOUNDS, lStyle);
+        std::vector<RLPieSliceData> lData = {{40.0f, RED, "A"}, {30.0f, GREEN, "B"}, {26.0f, BLUE, "C"}};
+        for (int i = 0; i < 8; ++i) {
+            lData.push_back({0.5f, WHITE, "tiny"});
+        }
+        lChart.setData(lData);
+        CHECK(lChart.getSliceCount() == 4);
+        lChart.draw();
+        CHECK(lChart.getSliceMeshBuildCount() == 4);
+
+        // A single small slice is kept as it is
+        lData.resize(4);
+        lChart.setData(lData);
+        CHECK(lChart.getSliceCount() == 4);
+    }
+
 }
 
 TEST_SUITE("RLRadarChart") {
@@ -810,10 +1220,86 @@ TEST_SUITE("RLRadarChart") {
         CHECK(lChart.getBounds().height == doctest::Approx(500.0f));
     }
 
+    TEST_CASE("Bulk series update") {
+        REQUIRE_RAYLIB();
+
+        RLRadarChartStyle lStyle;
+        lStyle.mSmoothAnimate = false;
+        RLRadarChart lChart(TEST_BOUNDS, lStyle);
+        lChart.setAxes(std::vector<std::string>{"A", "B", "C", "D"}, 0.0f, 100.0f);
+        for (int s = 0; s < 3; s++) {
+            lChart.addSeries(RLRadarSeries{});
+        }
+        lChart.update(0.016f);
+        CHECK(lChart.isSettled());
+
+        // Nested rows: extra rows are ignored, short rows update their leading axes
+        lChart.setAllSeriesData({{10.0f, 20.0f, 30.0f, 40.0f}, {50.0f, 60.0f}, {}, {1.0f, 2.0f, 3.0f, 4.0f}});
+        CHECK(lChart.needsRedraw());
+        lChart.update(0.016f);
+        CHECK(lChart.isSettled());
+
+        // Row-major block for the first two series
+        std::vector<float> lBlock = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f};
+        lChart.setAllSeriesData(lBlock, 2);
+        lChart.update(0.016f);
+        CHECK(lChart.isSettled());
+        CHECK(lChart.getSeriesCount() == 3);
+
+        // Draw builds one batch for all series; a settled chart reuses it
+        lChart.draw();
+        CHECK_FALSE(lChart.needsRedraw());
+        lChart.draw();
+    }
+
 }
 
 TEST_SUITE("RLScatterPlot") {
 
+    TEST_CASE("Strided x/y target data") {
+        REQUIRE_RAYLIB();
+
+        RLScatterPlot lPlot(TEST_BOUNDS);
+
+        RLScatterSeries lSeries;
+        lSeries.mData = {{0.0f, 0.0f}, {1.0f, 1.0f}};
+        size_t lIdx = lPlot.addSeries(lSeries);
+
+        // Interleaved {x, y} records read through a stride of 2 floats
+        const float lXY[6] = {0.0f, 1.0f, 1.0f, 2.0f, 2.0f, 0.5f};
+        lPlot.setSeriesTargetData(lIdx, &lXY[0], &lXY[1], 3, 2);
+        std::span<const Vector2> lTarget = lPlot.getSeriesTargetData(lIdx);
+        REQUIRE(lTarget.size() == 3);
+        CHECK(lTarget[0].x == 0.0f);
+        CHECK(lTarget[0].y == 1.0f);
+        CHECK(lTarget[1].x == 1.0f);
+        CHECK(lTarget[1].y == 2.0f);
+        CHECK(lTarget[2].x == 2.0f);
+        CHECK(lTarget[2].y == 0.5f);
+        for (int i = 0; i < 50; i++) {
+            lPlot.update(0.016f);
+        }
+
+        // Separate x and y arrays
+        const float lX[2] = {4.0f, 5.0f};
+        const float lY[2] = {-1.0f, -2.0f};
+        lPlot.setSeriesTargetData(lIdx, lX, lY, 2);
+        lTarget = lPlot.getSeriesTargetData(lIdx);
+        REQUIRE(lTarget.size() == 2);
+        CHECK(lTarget[1].x == 5.0f);
+        CHECK(lTarget[1].y == -2.0f);
+
+        // Span overload from a plain array
+        const Vector2 lPoints[2] = {{0.0f, 0.0f}, {3.0f, 3.0f}};
+        lPlot.setSeriesTargetData(lIdx, std::span<const Vector2>(lPoints, 2));
+        lTarget = lPlot.getSeriesTargetData(lIdx);
+        REQUIRE(lTarget.size() == 2);
+        CHECK(lTarget[0].x == 0.0f);
+        CHECK(lTarget[1].x == 3.0f);
+        CHECK(lTarget[1].y == 3.0f);
+        CHECK(lPlot.getSeriesTargetData(lIdx + 1).empty());
+    }
+
     TEST_CASE("Series management") {
         REQUIRE_RAYLIB();
 
@@ -977,10 +1463,161 @@ TEST_SUITE("RLScatterPlot") {
         CHECK(lPlot.getBounds().width == doctest::Approx(400.0f));
     }
 
+    TEST_CASE("Nearest point hit-testing") {
+        REQUIRE_RAYLIB();
+
+        RLScatterPlot lPlot(TEST_BOUNDS);
+        lPlot.setScale(0.0f, 10.0f, 0.0f, 10.0f);
+
+        RLScatterSeries lSeries1;
+        lSeries1.mData = {{1.0f, 1.0f}, {5.0f, 5.0f}, {12.0f, 5.0f}};
+        RLScatterSeries lSeries2;
+        lSeries2.mData = {{5.5f, 5.0f}, {9.0f, 9.0f}};
+        lPlot.addSeries(lSeries1);
+        lPlot.addSeries(lSeries2);
+
+        // Plot rect is the bounds minus 10px padding: (5,5) maps to (200,150)
+        RLScatterHit lHit = lPlot.getNearestPoint({ 201.0f, 151.0f });
+        REQUIRE(lHit.mFound);
+        CHECK(lHit.mSeries == 0);
+        CHECK(lHit.mIndex == 1);
+        CHECK(lHit.mScreen.x == doctest::Approx(200.0f));
+        CHECK(lHit.mScreen.y == doctest::Approx(150.0f));
+        CHECK(lHit.mData.x == doctest::Approx(5.0f));
+
+        lHit = lPlot.getNearestPoint({ 220.0f, 150.0f });
+        REQUIRE(lHit.mFound);
+        CHECK(lHit.mSeries == 1);
+        CHECK(lHit.mIndex == 0);
+
+        CHECK_FALSE(lPlot.getNearestPoint({ 300.0f, 40.0f }).mFound);
+        // (12,5) is beyond the zoomed scale: clamped to the edge but culled, not pickable
+        CHECK_FALSE(lPlot.getNearestPoint({ 390.0f, 150.0f }, 5.0f).mFound);
+
+        // Index follows a scale change
+        lPlot.setScale(0.0f, 20.0f, 0.0f, 10.0f);
+        lHit = lPlot.getNearestPoint({ 238.0f, 150.0f }, 5.0f);
+        REQUIRE(lHit.mFound);
+        CHECK(lHit.mSeries == 0);
+        CHECK(lHit.mIndex == 2);
+    }
+
+    TEST_CASE("Density mode bins large series") {
+        REQUIRE_RAYLIB();
+
+        RLScatterPlotStyle lStyle;
+        lStyle.mDensityThreshold = 1000;
+        lStyle.mDensityCellPx = 2.0f;
+        lStyle.mDensityLog = false;
+        lStyle.mDensityThreads = 4;
+        RLScatterPlot lPlot(TEST_BOUNDS, lStyle);
+        RLCharts::TaskPool lPool(4);
+        lPlot.setTaskPool(&lPool);
+
+        RLScatterSeries lLarge;
+        uint32_t lSeed = 3u;
+        for (int i = 0; i < 300000; i++) {
+            lSeed = lSeed * 1664525u + 1013904223u;
+            const float lX = (float)(lSeed >> 8) / 16777216.0f;
+            lSeed = lSeed * 1664525u + 1013904223u;
+            lLarge.mData.push_back({ lX, lX * (float)(lSeed >> 8) / 16777216.0f });
+        }
+        RLScatterSeries lSmall;
+        lSmall.mData = {{0.2f, 0.2f}, {0.8f, 0.6f}};
+        lPlot.addSeries(lLarge);
+        lPlot.addSeries(lSmall);
+        CHECK(lPlot.usesDensity(0));
+        CHECK_FALSE(lPlot.usesDensity(1));
+
+        // Plot rect is 380x280 px: 190x140 cells of 2px; every point lands in one cell
+        const std::vector<float> &rGrid = lPlot.getDensityGrid();
+        CHECK(lPlot.getDensityCellsX() == 190);
+        CHECK(lPlot.getDensityCellsY() == 140);
+        REQUIRE(rGrid.size() == 190u * 140u);
+        double lSum = 0.0;
+        for (float lV : rGrid) {
+            lSum += lV;
+        }
+        CHECK(lSum == doctest::Approx(300000.0));
+        const std::vector<float> lThreaded = rGrid;
+
+        // Same grid when binned on one thread
+        lStyle.mDensityThreads = 1;
+        lPlot.setStyle(lStyle);
+        CHECK(lPlot.getDensityGrid() == lThreaded);
+        lPlot.draw();
+
+        // Below the threshold nothing is binned
+        lStyle.mDensityThreshold = 0;
+        lPlot.setStyle(lStyle);
+        CHECK_FALSE(lPlot.usesDensity(0));
+        CHECK(lPlot.getDensityGrid().empty());
+        lPlot.draw();
+    }
+
 }
 
 TEST_SUITE("RLTimeSeries") {
 
+    TEST_CASE("Static layer re-renders only after bounds or style changes") {
+        REQUIRE_RAYLIB();
+
+        RLTimeSeries lSeries(TEST_BOUNDS, 100);
+        lSeries.addTrace();
+        lSeries.setStaticLayerCache(true);
+        CHECK(lSeries.getStaticLayer().isEnabled());
+        for (int i = 0; i < 10; i++) {
+            lSeries.pushSample(0, sinf((float)i));
+            lSeries.update(0.016f);
+            lSeries.draw();
+        }
+        CHECK(lSeries.getStaticLayer().isValid());
+        CHECK(lSeries.getStaticLayer().getRenderCount() == 1u);
+
+        lSeries.setBounds(Rectangle{ 20, 10, 400, 300 });
+        lSeries.draw();
+        lSeries.draw();
+        CHECK(lSeries.getStaticLayer().getRenderCount() == 2u);
+
+        RLTimeSeriesChartStyle lStyle;
+        lStyle.mShowGrid = false;
+        lSeries.setStyle(lStyle);
+        lSeries.draw();
+        CHECK(lSeries.getStaticLayer().getRenderCount() == 3u);
+
+        lSeries.setStaticLayerCache(false);
+        CHECK_FALSE(lSeries.getStaticLayer().isValid());
+        lSeries.draw();
+        CHECK(lSeries.getStaticLayer().getRenderCount() == 3u);
+    }
+
+    TEST_CASE("Rejected input leaves a settled chart settled") {
+        REQUIRE_RAYLIB();
+
+        RLTimeSeries lSeries(TEST_BOUNDS, 100);
+        lSeries.addTrace();
+        lSeries.pushSamples(0, std::vector<float>{ 1.0f, 2.0f, 3.0f });
+        for (int i = 0; i < 600 && !lSeries.isSettled(); i++) {
+            lSeries.update(0.016f);
+        }
+        REQUIRE(lSeries.isSettled());
+        lSeries.draw();
+        REQUIRE_FALSE(lSeries.needsRedraw());
+
+        lSeries.setTraceStyle(5, RLTimeSeriesTraceStyle{});
+        lSeries.setTraceVisible(5, false);
+        lSeries.clearTrace(5);
+        lSeries.pushSample(5, 1.0f);
+        CHECK_FALSE(lSeries.pushSamples(5, std::vector<float>{ 1.0f }));
+        CHECK_FALSE(lSeries.pushSamples(0, std::vector<float>{}));
+        lSeries.setWindowSize(100);
+        CHECK(lSeries.isSettled());
+        CHECK_FALSE(lSeries.needsRedraw());
+
+        lSeries.pushSample(0, 4.0f);
+        CHECK(lSeries.needsRedraw());
+    }
+
     TEST_CASE("Trace management") {
         REQUIRE_RAYLIB();
 
@@ -1059,93 +1696,692 @@ TEST_SUITE("RLTimeSeries") {
         CHECK(lResult == false);
     }
 
-}
-
-TEST_SUITE("RLHeatMap") {
-
-    TEST_CASE("Grid configuration") {
+    TEST_CASE("Push samples - span from caller-owned buffer") {
         REQUIRE_RAYLIB();
 
-        RLHeatMap lHm(TEST_BOUNDS, 32, 32);
-
-        CHECK(lHm.getCellsX() == 32);
-        CHECK(lHm.getCellsY() == 32);
+        RLTimeSeries lTs(TEST_BOUNDS, 100);
+        size_t lTraceIdx = lTs.addTrace();
 
-        lHm.setGrid(64, 64);
-        CHECK(lHm.getCellsX() == 64);
-        CHECK(lHm.getCellsY() == 64);
+        float lBuffer[8] = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f};
+        CHECK(lTs.pushSamples(lTraceIdx, std::span<const float>(lBuffer, 6)) == true);
+        CHECK(lTs.getTraceSampleCount(lTraceIdx) == 6);
+        CHECK(lTs.pushSamples(lTraceIdx, std::span<const float>()) == false);
     }
 
-    TEST_CASE("Update modes") {
+    TEST_CASE("Min/max decimation bounds point count") {
         REQUIRE_RAYLIB();
 
-        RLHeatMap lHm(TEST_BOUNDS, 16, 16);
-
-        lHm.setUpdateMode(RLHeatMapUpdateMode::Replace);
-        CHECK(lHm.getUpdateMode() == RLHeatMapUpdateMode::Replace);
+        RLTimeSeries lTs(TEST_BOUNDS, 10000);
+        RLTimeSeriesTraceStyle lStyle;
+        lStyle.mDecimate = true;
+        size_t lDecimated = lTs.addTrace(lStyle);
+        size_t lFull = lTs.addTrace();
 
-        lHm.setUpdateMode(RLHeatMapUpdateMode::Accumulate);
-        CHECK(lHm.getUpdateMode() == RLHeatMapUpdateMode::Accumulate);
+        for (int i = 0; i < 10000; i++) {
+            const float lValue = (i % 7 == 0) ? 1.0f : -1.0f;
+            lTs.pushSample(lDecimated, lValue);
+            lTs.pushSample(lFull, lValue);
+        }
 
-        lHm.setUpdateMode(RLHeatMapUpdateMode::Decay);
-        CHECK(lHm.getUpdateMode() == RLHeatMapUpdateMode::Decay);
+        const float lPlotWidth = lTs.getPlotArea().width;
+        CHECK(lTs.getTraceScreenPointCount(lFull) == 10000);
+        CHECK(lTs.getTraceScreenPointCount(lDecimated) <= (size_t)(lPlotWidth + 1.0f) * 4);
+        CHECK(lTs.getTraceScreenPointCount(lDecimated) >= (size_t)lPlotWidth);
     }
 
-    TEST_CASE("Point addition") {
+    TEST_CASE("History view reads the pyramid at pixel resolution") {
         REQUIRE_RAYLIB();
 
-        RLHeatMap lHm(TEST_BOUNDS, 16, 16);
-
-        std::vector<Vector2> lPoints = {{0.0f, 0.0f}, {0.5f, 0.5f}, {-0.5f, -0.5f}};
-        bool lResult = lHm.addPoints(lPoints);
-        CHECK(lResult == true);
+        RLTimeSeries lTs(TEST_BOUNDS, 500);
+        size_t lLong = lTs.addTrace();
+        size_t lShort = lTs.addTrace();
+        CHECK(lTs.setTraceHistoryEnabled(lLong, true));
+        CHECK_FALSE(lTs.setTraceHistoryEnabled(99, true));
+        CHECK(lTs.getTraceHistory(lShort) == nullptr);
 
-        // Should handle points without crash
-        lHm.update(0.016f);
-        CHECK(lHm.getBounds().width == doctest::Approx(400.0f));
+        std::vector<float> lValues(100000);
+        for (size_t i = 0; i < lValues.size(); i++) {
+            lValues[i] = (float)(i % 1000) * 0.01f;
+        }
+        CHECK(lTs.pushSamples(lLong, lValues));
+        CHECK(lTs.pushSamples(lShort, lValues));
+        lTs.pushSample(lLong, 50.0f);
+        CHECK(lTs.getTraceSampleCount(lLong) == 500);
+        REQUIRE(lTs.getTraceHistory(lLong) != nullptr);
+        CHECK(lTs.getTraceHistory(lLong)->getSampleCount() == 100001);
+
+        // Whole history: at most two points (min and max) per pixel column
+        lTs.setHistoryView(0, 100001);
+        CHECK(lTs.isHistoryView());
+        const float lPlotWidth = lTs.getPlotArea().width;
+        CHECK(lTs.getTraceScreenPointCount(lLong) <= (size_t)lPlotWidth * 2);
+        CHECK(lTs.getTraceScreenPointCount(lLong) >= (size_t)lPlotWidth);
+        CHECK(lTs.getTraceScreenPointCount(lShort) == 0);
+        for (int i = 0; i < 100; i++) {
+            lTs.update(0.1f);
+        }
+        CHECK(lTs.isSettled());
+        lTs.draw();
+
+        // Zoomed in to 20 samples: one point each
+        lTs.setHistoryView(1000, 20);
+        CHECK(lTs.getTraceScreenPointCount(lLong) == 20);
+
+        lTs.setLiveView();
+        CHECK_FALSE(lTs.isHistoryView());
+        CHECK(lTs.getTraceScreenPointCount(lLong) == 500);
+        CHECK(lTs.getTraceScreenPointCount(lShort) == 500);
+
+        lTs.clearTrace(lLong);
+        CHECK(lTs.getTraceHistory(lLong)->getSampleCount() == 0);
+        CHECK(lTs.setTraceHistoryEnabled(lLong, false));
+        CHECK(lTs.getTraceHistory(lLong) == nullptr);
     }
 
-    TEST_CASE("Point addition - empty vector returns false") {
+    TEST_CASE("Autoscale follows the sliding window") {
         REQUIRE_RAYLIB();
 
-        RLHeatMap lHm(TEST_BOUNDS, 16, 16);
-
-        std::vector<Vector2> lEmptyPoints;
-        bool lResult = lHm.addPoints(lEmptyPoints);
-        CHECK(lResult == false);
+        RLTimeSeries lTs(TEST_BOUNDS, 50);
+        RLTimeSeriesChartStyle lStyle;
+        lStyle.mSmoothScale = false;
+        lStyle.mAutoScaleMargin = 0.0f;
+        lTs.setStyle(lStyle);
+        size_t lTrace = lTs.addTrace();
+        size_t lFirst = lTs.addChannelGroup(2);
+
+        // A spike stays in range until 50 newer samples pushed it out
+        lTs.pushSample(lTrace, 9.0f);
+        for (int i = 0; i < 49; i++) {
+            lTs.pushSample(lTrace, (float)(i % 5) - 2.0f);
+        }
+        lTs.update(0.1f);
+        CHECK(lTs.getMinY() == doctest::Approx(-2.0f));
+        CHECK(lTs.getMaxY() == doctest::Approx(9.0f));
+        lTs.pushSample(lTrace, 0.0f);
+        lTs.update(0.1f);
+        CHECK(lTs.getMaxY() == doctest::Approx(2.0f));
+
+        // Batches longer than the window, frames and a shrinking window
+        std::vector<float> lBatch(120);
+        for (size_t i = 0; i < lBatch.size(); i++) {
+            lBatch[i] = i < 60 ? -50.0f : (float)i * 0.01f;
+        }
+        CHECK(lTs.pushSamples(lTrace, lBatch));
+        const float lFrame[2] = { -4.0f, 3.5f };
+        CHECK(lTs.pushFrame(lFirst, lFrame, 2));
+        lTs.update(0.1f);
+        CHECK(lTs.getMinY() == doctest::Approx(-4.0f));
+        CHECK(lTs.getMaxY() == doctest::Approx(3.5f));
+
+        lTs.clearTrace(lFirst);
+        lTs.setWindowSize(10);
+        lTs.update(0.1f);
+        CHECK(lTs.getMinY() == doctest::Approx(1.1f));
+        CHECK(lTs.getMaxY() == doctest::Approx(1.19f));
     }
 
-    TEST_CASE("Clear") {
+    TEST_CASE("Channel group fed by frames") {
         REQUIRE_RAYLIB();
 
-        RLHeatMap lHm(TEST_BOUNDS, 16, 16);
+        RLTimeSeries lTs(TEST_BOUNDS, 100);
+        size_t lSolo = lTs.addTrace();
+        const size_t lChannels = 5;
+        size_t lFirst = lTs.addChannelGroup(lChannels);
+        CHECK(lFirst == lSolo + 1);
+        CHECK(lTs.getTraceCount() == 1 + lChannels);
+        CHECK(lTs.setTraceHistoryEnabled(lFirst + 2, true));
+
+        // 130 interleaved frames into a 100-sample window: the oldest 30 drop out
+        std::vector<float> lFrames(130 * lChannels);
+        for (size_t f = 0; f < 130; f++) {
+            for (size_t c = 0; c < lChannels; c++) {
+                lFrames[f * lChannels + c] = (float)c * 10.0f + (float)(f % 9);
+            }
+        }
+        CHECK(lTs.pushFrames(lFirst, lFrames.data(), 130, lChannels));
+        CHECK(lTs.pushFrame(lFirst, lFrames.data(), lChannels));
+        CHECK_FALSE(lTs.pushFrame(lFirst, lFrames.data(), lChannels - 1));
+        CHECK_FALSE(lTs.pushFrame(lFirst + 1, lFrames.data(), lChannels));
+        CHECK_FALSE(lTs.pushFrame(lSolo, lFrames.data(), 1));
+        for (size_t c = 0; c < lChannels; c++) {
+            CHECK(lTs.getTraceSampleCount(lFirst + c) == 100);
+        }
+        CHECK(lTs.getTraceHistory(lFirst + 2)->getSampleCount() == 131);
 
-        std::vector<Vector2> lPoints = {{0.0f, 0.0f}};
-        lHm.addPoints(lPoints);
-        lHm.clear();
+        // Channels only take frames
+        lTs.pushSample(lFirst, 1.0f);
+        CHECK_FALSE(lTs.pushSamples(lFirst + 1, std::vector<float>{ 1.0f, 2.0f }));
+        CHECK_FALSE(lTs.createProducer(lFirst).isValid());
+        CHECK(lTs.getTraceSampleCount(lFirst) == 100);
 
-        // Should clear without crash
-        CHECK(lHm.getCellsX() == 16);
-    }
+        for (int i = 0; i < 100; i++) {
+            lTs.update(0.1f);
+        }
+        CHECK(lTs.isSettled());
+        for (size_t c = 0; c < lChannels; c++) {
+            CHECK(lTs.getTraceScreenPointCount(lFirst + c) == 100);
+        }
+        lTs.draw();
 
-}
+        // Shrinking keeps the newest frames of every channel
+        lTs.setWindowSize(40);
+        CHECK(lTs.getTraceSampleCount(lFirst + 4) == 40);
+        CHECK(lTs.getTraceScreenPointCount(lFirst + 4) == 40);
 
-TEST_SUITE("RLHeatMap3D") {
+        // Clearing one channel clears the group
+        lTs.clearTrace(lFirst + 3);
+        for (size_t c = 0; c < lChannels; c++) {
+            CHECK(lTs.getTraceSampleCount(lFirst + c) == 0);
+        }
+        CHECK(lTs.getTraceHistory(lFirst + 2)->getSampleCount() == 0);
+        CHECK(lTs.pushFrame(lFirst, lFrames.data(), lChannels));
+        CHECK(lTs.getTraceSampleCount(lFirst + 1) == 1);
+    }
 
-    TEST_CASE("Grid configuration") {
+    TEST_CASE("Resizing a partly filled window keeps the newest samples") {
         REQUIRE_RAYLIB();
 
-        RLHeatMap3D lHm(32, 32);
+        // 20 samples (10..29) in a 100-sample window, then shrink to the last 5
+        RLTimeSeriesChartStyle lStyle;
+        lStyle.mSmoothScale = false;
+        lStyle.mAutoScaleMargin = 0.0f;
+        RLTimeSeries lSolo(TEST_BOUNDS, 100);
+        lSolo.setStyle(lStyle);
+        const size_t lTrace = lSolo.addTrace();
+        RLTimeSeries lGrouped(TEST_BOUNDS, 100);
+        lGrouped.setStyle(lStyle);
+        const size_t lFirst = lGrouped.addChannelGroup(2);
+        for (int i = 10; i < 30; i++) {
+            lSolo.pushSample(lTrace, (float)i);
+            const float lFrame[2] = { (float)i, (float)i + 100.0f };
+            CHECK(lGrouped.pushFrame(lFirst, lFrame, 2));
+        }
+        lSolo.setWindowSize(5);
+        lGrouped.setWindowSize(5);
+        CHECK(lSolo.getTraceSampleCount(lTrace) == 5);
+        CHECK(lGrouped.getTraceSampleCount(lFirst + 1) == 5);
+        lSolo.update(0.1f);
+        lGrouped.update(0.1f);
+        CHECK(lSolo.getMinY() == doctest::Approx(25.0f));
+        CHECK(lSolo.getMaxY() == doctest::Approx(29.0f));
+        CHECK(lGrouped.getMinY() == doctest::Approx(25.0f));
+        CHECK(lGrouped.getMaxY() == doctest::Approx(129.0f));
+
+        // Growing keeps all of them
+        lGrouped.setWindowSize(50);
+        CHECK(lGrouped.getTraceSampleCount(lFirst) == 5);
+        lGrouped.update(0.1f);
+        CHECK(lGrouped.getMinY() == doctest::Approx(25.0f));
+        CHECK(lGrouped.getMaxY() == doctest::Approx(129.0f));
+    }
 
-        CHECK(lHm.getWidth() == 32);
-        CHECK(lHm.getHeight() == 32);
+    TEST_CASE("State round trip warms up a fresh chart") {
+        REQUIRE_RAYLIB();
 
-        lHm.setGridSize(64, 48);
-        CHECK(lHm.getWidth() == 64);
-        CHECK(lHm.getHeight() == 48);
+        RLTimeSeries lTs(TEST_BOUNDS, 100);
+        size_t lSolo = lTs.addTrace();
+        size_t lFirst = lTs.addChannelGroup(3);
+        for (int i = 0; i < 130; i++) {
+            lTs.pushSample(lSolo, sinf((float)i * 0.1f));
+        }
+        std::vector<float> lFrames(60 * 3);
+        for (size_t i = 0; i < lFrames.size(); i++) {
+            lFrames[i] = (float)(i % 3) * 5.0f + (float)(i / 3);
+        }
+        CHECK(lTs.pushFrames(lFirst, lFrames.data(), 60, 3));
+        for (int i = 0; i < 100; i++) {
+            lTs.update(0.1f);
+        }
+        const std::vector<uint8_t> lState = lTs.saveState();
+        REQUIRE_FALSE(lState.empty());
+
+        RLTimeSeries lRestored(TEST_BOUNDS, 100);
+        lRestored.addTrace();
+        CHECK_FALSE(lRestored.loadState(lState)); // different trace layout
+        lRestored.addChannelGroup(3);
+        CHECK(lRestored.setTraceHistoryEnabled(lSolo, true));
+        CHECK(lRestored.loadState(lState));
+        CHECK(lRestored.getTraceSampleCount(lSolo) == 100);
+        CHECK(lRestored.getTraceSampleCount(lFirst + 2) == 60);
+        CHECK(lRestored.getTraceHistory(lSolo)->getSampleCount() == 100);
+        CHECK(lRestored.getMinY() == doctest::Approx(lTs.getMinY()));
+        CHECK(lRestored.getMaxY() == doctest::Approx(lTs.getMaxY()));
+        CHECK(lRestored.saveState() == lState);
+        lRestored.update(0.016f);
+        CHECK(lRestored.getTraceScreenPointCount(lFirst + 1) == 60);
+
+        // A smaller window keeps the newest samples; a damaged blob changes nothing
+        RLTimeSeries lSmall(TEST_BOUNDS, 40);
+        lSmall.addTrace();
+        lSmall.addChannelGroup(3);
+        CHECK(lSmall.loadState(lState));
+        CHECK(lSmall.getTraceSampleCount(lSolo) == 40);
+        CHECK(lSmall.getTraceSampleCount(lFirst) == 40);
+        std::vector<uint8_t> lDamaged(lState.begin(), lState.end() - 8);
+        CHECK_FALSE(lSmall.loadState(lDamaged));
+        CHECK(lSmall.getTraceSampleCount(lSolo) == 40);
     }
 
-    TEST_CASE("Value range configuration") {
+    TEST_CASE("Min/max decimation inactive below one sample per pixel") {
+        REQUIRE_RAYLIB();
+
+        RLTimeSeries lTs(TEST_BOUNDS, 100);
+        RLTimeSeriesTraceStyle lStyle;
+        lStyle.mDecimate = true;
+        size_t lTraceIdx = lTs.addTrace(lStyle);
+
+        for (int i = 0; i < 100; i++) {
+            lTs.pushSample(lTraceIdx, (float)i);
+        }
+
+        CHECK(lTs.getTraceScreenPointCount(lTraceIdx) == 100);
+    }
+
+    TEST_CASE("Incremental screen point updates while scrolling") {
+        REQUIRE_RAYLIB();
+
+        RLTimeSeriesChartStyle lStyle;
+        lStyle.mAutoScaleY = false;
+        lStyle.mSmoothScale = false;
+
+        RLTimeSeries lTs(TEST_BOUNDS, 20);
+        lTs.setStyle(lStyle);
+        RLTimeSeriesTraceStyle lTraceStyle;
+        lTraceStyle.mLineMode = RLTimeSeriesLineMode::Spline;
+        size_t lTraceIdx = lTs.addTrace(lTraceStyle);
+
+        // Build-up phase, then scroll past the window one and several samples at a time
+        for (int i = 0; i < 60; i++) {
+            lTs.pushSample(lTraceIdx, sinf((float)i * 0.3f));
+            if (i % 3 == 0) {
+                lTs.pushSample(lTraceIdx, cosf((float)i * 0.3f));
+            }
+            lTs.update(0.016f);
+            CHECK(lTs.getTraceScreenPointCount(lTraceIdx) == lTs.getTraceSampleCount(lTraceIdx));
+        }
+        CHECK(lTs.getTraceSampleCount(lTraceIdx) == 20);
+
+        // Bounds change forces a full remap
+        lTs.setBounds({0, 0, 200, 100});
+        CHECK(lTs.getTraceScreenPointCount(lTraceIdx) == 20);
+    }
+
+    TEST_CASE("Incremental screen points match a full rebuild") {
+        REQUIRE_RAYLIB();
+
+        RLTimeSeriesChartStyle lStyle;
+        lStyle.mAutoScaleY = false;
+        lStyle.mSmoothScale = false;
+
+        RLTimeSeries lTs(TEST_BOUNDS, 50);
+        lTs.setStyle(lStyle);
+        RLTimeSeriesTraceStyle lTraceStyle;
+        lTraceStyle.mLineMode = RLTimeSeriesLineMode::Spline;
+        const size_t lSpline = lTs.addTrace(lTraceStyle);
+        lTraceStyle.mLineMode = RLTimeSeriesLineMode::Linear;
+        const size_t lLinear = lTs.addTrace(lTraceStyle);
+
+        auto lSame = [](const std::vector<Vector2>& rA, const std::vector<Vector2>& rB) {
+            bool lEqual = rA.size() == rB.size() && !rA.empty();
+            for (size_t i = 0; lEqual && i < rA.size(); i++) {
+                lEqual = rA[i].x == doctest::Approx(rB[i].x).epsilon(1e-4) &&
+                         rA[i].y == doctest::Approx(rB[i].y).epsilon(1e-4);
+            }
+            return lEqual;
+        };
+
+        // Scroll well past the window in uneven steps, comparing the incrementally
+        // maintained caches with a fresh remap along the way
+        std::vector<Vector2> lLinearPoints;
+        std::vector<Vector2> lSplinePoints;
+        std::vector<Vector2> lFull;
+        int lSample = 0;
+        for (int lFrame = 0; lFrame < 150; lFrame++) {
+            const int lBatch = 1 + lFrame % 4;
+            for (int i = 0; i < lBatch; i++, lSample++) {
+                const float lValue = 0.8f * sinf((float)lSample * 0.37f);
+                lTs.pushSample(lSpline, lValue);
+                lTs.pushSample(lLinear, lValue);
+            }
+            lTs.update(0.016f);
+            if (lFrame % 25 == 24) {
+                lTs.getTraceScreenPoints(lLinear, lLinearPoints);
+                lTs.getTraceScreenPoints(lSpline, lSplinePoints, true);
+                // Same bounds again: forces the full remap
+                lTs.setBounds(TEST_BOUNDS);
+                lTs.getTraceScreenPoints(lLinear, lFull);
+                CHECK(lSame(lLinearPoints, lFull));
+                lTs.getTraceScreenPoints(lSpline, lFull, true);
+                CHECK(lSame(lSplinePoints, lFull));
+            } else if (lSample >= 2) {
+                CHECK(lTs.getTraceScreenPointCount(lSpline) == lTs.getTraceSampleCount(lSpline));
+                CHECK(lTs.getTraceScreenPointCount(lLinear) == lTs.getTraceSampleCount(lLinear));
+            }
+        }
+        CHECK(lSample > (int)(4 * 50));
+    }
+
+    TEST_CASE("Producer handle feeds trace from another thread") {
+        REQUIRE_RAYLIB();
+
+        RLTimeSeries lTs(TEST_BOUNDS, 10000);
+        size_t lTraceIdx = lTs.addTrace();
+
+        CHECK_FALSE(lTs.createProducer(99).isValid());
+        RLTimeSeries::Producer lProducer = lTs.createProducer(lTraceIdx, 1024);
+        REQUIRE(lProducer.isValid());
+
+        const int lTotal = 5000;
+        std::thread lThread([&lProducer]() {
+            int lSent = 0;
+            while (lSent < lTotal) {
+                if (lProducer.push((float)lSent)) {
+                    lSent++;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+        for (int i = 0; i < 100000 && lTs.getTraceSampleCount(lTraceIdx) < (size_t)lTotal; i++) {
+            lTs.update(0.016f);
+            std::this_thread::yield();
+        }
+        lThread.join();
+        lTs.update(0.016f);
+
+        CHECK(lTs.getTraceSampleCount(lTraceIdx) == (size_t)lTotal);
+    }
+
+    TEST_CASE("Producer bulk push reports queued count") {
+        REQUIRE_RAYLIB();
+
+        RLTimeSeries lTs(TEST_BOUNDS, 100);
+        size_t lTraceIdx = lTs.addTrace();
+        RLTimeSeries::Producer lProducer = lTs.createProducer(lTraceIdx, 64);
+
+        std::vector<float> lValues(100, 1.0f);
+        CHECK(lProducer.push(lValues.data(), lValues.size()) == 64);
+        CHECK(lTs.getTraceSampleCount(lTraceIdx) == 0);
+
+        lTs.update(0.016f);
+        CHECK(lTs.getTraceSampleCount(lTraceIdx) == 64);
+    }
+
+}
+
+TEST_SUITE("RLHeatMap") {
+
+    TEST_CASE("Grid configuration") {
+        REQUIRE_RAYLIB();
+
+        RLHeatMap lHm(TEST_BOUNDS, 32, 32);
+
+        CHECK(lHm.getCellsX() == 32);
+        CHECK(lHm.getCellsY() == 32);
+
+        lHm.setGrid(64, 64);
+        CHECK(lHm.getCellsX() == 64);
+        CHECK(lHm.getCellsY() == 64);
+    }
+
+    TEST_CASE("Parallel and weighted binning match serial binning") {
+        REQUIRE_RAYLIB();
+
+        // Enough points for four binning threads; weights are exact in float, so
+        // the per-thread grids sum to the same counts in any order
+        std::vector<Vector2> lPoints(4 * 40000);
+        std::vector<float> lWeights(lPoints.size());
+        for (size_t i = 0; i < lPoints.size(); i++) {
+            lPoints[i] = {sinf((float)i * 0.013f) * 1.05f, cosf((float)i * 0.029f) * 0.7f};
+            lWeights[i] = (float)(i % 4) * 0.5f;
+        }
+        RLHeatMap lSerial(TEST_BOUNDS, 96, 64);
+        RLHeatMap lParallel(TEST_BOUNDS, 96, 64);
+        lParallel.setBinningThreads(4);
+        CHECK(lParallel.getBinningThreads() == 4);
+        for (RLHeatMap* pHm : {&lSerial, &lParallel}) {
+            CHECK(pHm->addPoints(lPoints));
+            CHECK(pHm->addPoints(lPoints, lWeights));
+            CHECK_FALSE(pHm->addPoints(lPoints, std::span<const float>(lWeights.data(), 3)));
+        }
+        // Unmerged per-thread grids are part of the state as well
+        CHECK(lParallel.saveState() == lSerial.saveState());
+        CHECK_FALSE(lParallel.isSettled());
+        lSerial.update(0.016f);
+        lParallel.update(0.016f);
+        CHECK(lParallel.saveState() == lSerial.saveState());
+        CHECK(lParallel.getLastUploadCells() == lSerial.getLastUploadCells());
+        lParallel.draw();
+
+        // Replace mode drops points binned before the replacing batch
+        lParallel.addPoints(lPoints);
+        lParallel.setUpdateMode(RLHeatMapUpdateMode::Replace);
+        lSerial.setUpdateMode(RLHeatMapUpdateMode::Replace);
+        lParallel.addPoints(lPoints, lWeights);
+        lSerial.addPoints(lPoints, lWeights);
+        lParallel.update(0.016f);
+        lSerial.update(0.016f);
+        CHECK(lParallel.saveState() == lSerial.saveState());
+    }
+
+    TEST_CASE("State round trip restores grid and counts") {
+        REQUIRE_RAYLIB();
+
+        RLHeatMap lHm(TEST_BOUNDS, 24, 12);
+        std::vector<Vector2> lPoints;
+        for (int i = 0; i < 500; i++) {
+            lPoints.push_back({sinf((float)i) * 0.8f, cosf((float)i * 0.7f) * 0.8f});
+        }
+        CHECK(lHm.addPoints(lPoints));
+        const std::vector<uint8_t> lState = lHm.saveState();
+        REQUIRE_FALSE(lState.empty());
+
+        // The saved grid size wins over the restoring map's
+        RLHeatMap lRestored(TEST_BOUNDS, 8, 8);
+        CHECK(lRestored.loadState(lState));
+        CHECK(lRestored.getCellsX() == 24);
+        CHECK(lRestored.getCellsY() == 12);
+        CHECK(lRestored.saveState() == lState);
+        lRestored.update(0.016f);
+        lRestored.draw();
+
+        RLTimeSeries lOther(TEST_BOUNDS, 10);
+        CHECK_FALSE(lRestored.loadState(lOther.saveState()));
+        CHECK(lRestored.getCellsX() == 24);
+    }
+
+    TEST_CASE("Update modes") {
+        REQUIRE_RAYLIB();
+
+        RLHeatMap lHm(TEST_BOUNDS, 16, 16);
+
+        lHm.setUpdateMode(RLHeatMapUpdateMode::Replace);
+        CHECK(lHm.getUpdateMode() == RLHeatMapUpdateMode::Replace);
+
+        lHm.setUpdateMode(RLHeatMapUpdateMode::Accumulate);
+        CHECK(lHm.getUpdateMode() == RLHeatMapUpdateMode::Accumulate);
+
+        lHm.setUpdateMode(RLHeatMapUpdateMode::Decay);
+        CHECK(lHm.getUpdateMode() == RLHeatMapUpdateMode::Decay);
+    }
+
+    TEST_CASE("Point addition") {
+        REQUIRE_RAYLIB();
+
+        RLHeatMap lHm(TEST_BOUNDS, 16, 16);
+
+        std::vector<Vector2> lPoints = {{0.0f, 0.0f}, {0.5f, 0.5f}, {-0.5f, -0.5f}};
+        bool lResult = lHm.addPoints(lPoints);
+        CHECK(lResult == true);
+
+        // Should handle points without crash
+        lHm.update(0.016f);
+        CHECK(lHm.getBounds().width == doctest::Approx(400.0f));
+    }
+
+    TEST_CASE("Point addition - empty vector returns false") {
+        REQUIRE_RAYLIB();
+
+        RLHeatMap lHm(TEST_BOUNDS, 16, 16);
+
+        std::vector<Vector2> lEmptyPoints;
+        bool lResult = lHm.addPoints(lEmptyPoints);
+        CHECK(lResult == false);
+    }
+
+    TEST_CASE("Threaded colorization of a large grid") {
+        REQUIRE_RAYLIB();
+
+        RLHeatMap lHm(TEST_BOUNDS, 512, 512);
+        lHm.setColorizeThreads(4);
+        CHECK(lHm.getColorizeThreads() == 4);
+
+        std::vector<Vector2> lPoints;
+        for (int i = 0; i < 1000; i++) {
+            lPoints.push_back({(float)(i % 100) / 50.0f - 1.0f, (float)(i / 10) / 50.0f - 1.0f});
+        }
+        CHECK(lHm.addPoints(lPoints));
+        lHm.update(0.016f);
+
+        // The bands run on the shared pool unless the chart is given one
+        CHECK(&lHm.getTaskPool() == &RLCharts::TaskPool::shared());
+        RLCharts::TaskPool lPool(3);
+        lHm.setTaskPool(&lPool);
+        CHECK(&lHm.getTaskPool() == &lPool);
+        lHm.setColorizeThreads(0);
+        CHECK(lHm.addPoints(lPoints));
+        lHm.update(0.016f);
+        CHECK(lHm.getLastUploadCells() > 0u);
+        lHm.setTaskPool(nullptr);
+        CHECK(&lHm.getTaskPool() == &RLCharts::TaskPool::shared());
+
+        lHm.setColorizeThreads(-3);
+        CHECK(lHm.getColorizeThreads() == 1);
+    }
+
+    TEST_CASE("Dirty rectangle uploads") {
+        REQUIRE_RAYLIB();
+
+        RLHeatMap lHm(TEST_BOUNDS, 256, 256);
+        lHm.update(0.016f);
+        CHECK(lHm.getLastUploadCells() == 256u * 256u);
+
+        // One point below the current max only recolors its own cell
+        std::vector<Vector2> lPoints = {{0.0f, 0.0f}};
+        CHECK(lHm.addPoints(lPoints));
+        lHm.update(0.016f);
+        CHECK(lHm.getLastUploadCells() == 1u);
+
+        lHm.update(0.016f);
+        CHECK(lHm.getLastUploadCells() == 0u);
+
+        // Two separated points: their bounding box
+        lPoints = {{-0.5f, 0.0f}, {-0.5f + 4.0f / 128.0f, 0.0f}};
+        CHECK(lHm.addPoints(lPoints));
+        lHm.update(0.016f);
+        CHECK(lHm.getLastUploadCells() == 5u);
+
+        // Decay only touches the live box and stops once everything reached zero
+        lHm.setUpdateMode(RLHeatMapUpdateMode::Decay);
+        lHm.setDecayHalfLifeSeconds(0.01f);
+        lHm.update(0.016f);
+        CHECK(lHm.getLastUploadCells() > 0u);
+        CHECK(lHm.getLastUploadCells() < 256u * 256u);
+        for (int i = 0; i < 20; i++) {
+            lHm.update(0.016f);
+        }
+        CHECK(lHm.getLastUploadCells() == 0u);
+        CHECK(lHm.isSettled());
+        lHm.draw();
+        CHECK_FALSE(lHm.needsRedraw());
+
+        CHECK(lHm.addPoints(lPoints));
+        CHECK(lHm.needsRedraw());
+        CHECK_FALSE(lHm.isSettled());
+    }
+
+    TEST_CASE("Prepare and commit phases") {
+        REQUIRE_RAYLIB();
+
+        RLHeatMap lHm(TEST_BOUNDS, 64, 64);
+        lHm.update(0.016f);
+        CHECK(lHm.isSettled());
+
+        // prepare() stages the frame; it is pending until commit() uploads it
+        std::vector<Vector2> lPoints = {{0.0f, 0.0f}};
+        CHECK(lHm.addPoints(lPoints));
+        lHm.prepare(0.016f);
+        CHECK(lHm.getLastUploadCells() > 0u);
+        CHECK_FALSE(lHm.isSettled());
+
+        // A second prepare() before commit() adds to the same staged frame
+        lPoints = {{0.5f, 0.5f}};
+        CHECK(lHm.addPoints(lPoints));
+        lHm.prepare(0.016f);
+        CHECK(lHm.getLastUploadCells() > 0u);
+        lHm.commit();
+        CHECK(lHm.isSettled());
+        CHECK(lHm.needsRedraw());
+        lHm.draw();
+        CHECK_FALSE(lHm.needsRedraw());
+
+        // commit() without a prepared frame does nothing
+        lHm.commit();
+        CHECK_FALSE(lHm.needsRedraw());
+    }
+
+    TEST_CASE("GPU colormap falls back to the CPU path") {
+        REQUIRE_RAYLIB();
+
+        RLHeatMap lHm(TEST_BOUNDS, 32, 32);
+        lHm.setUpdateMode(RLHeatMapUpdateMode::Decay);
+        lHm.setGpuColormap(true);
+        CHECK(lHm.isGpuColormapEnabled());
+
+        std::vector<Vector2> lPoints = {{0.0f, 0.0f}, {0.5f, 0.5f}};
+        CHECK(lHm.addPoints(lPoints));
+        lHm.update(0.016f);
+        lHm.draw();
+        // Activation depends on float texture support; either way the chart keeps rendering
+        CHECK(lHm.isGpuColormapEnabled());
+
+        lHm.setGpuColormap(false);
+        CHECK_FALSE(lHm.isGpuColormapEnabled());
+        CHECK_FALSE(lHm.isGpuColormapActive());
+    }
+
+    TEST_CASE("Clear") {
+        REQUIRE_RAYLIB();
+
+        RLHeatMap lHm(TEST_BOUNDS, 16, 16);
+
+        std::vector<Vector2> lPoints = {{0.0f, 0.0f}};
+        lHm.addPoints(lPoints);
+        lHm.clear();
+
+        // Should clear without crash
+        CHECK(lHm.getCellsX() == 16);
+    }
+
+}
+
+TEST_SUITE("RLHeatMap3D") {
+
+    TEST_CASE("Grid configuration") {
+        REQUIRE_RAYLIB();
+
+        RLHeatMap3D lHm(32, 32);
+
+        CHECK(lHm.getWidth() == 32);
+        CHECK(lHm.getHeight() == 32);
+
+        lHm.setGridSize(64, 48);
+        CHECK(lHm.getWidth() == 64);
+        CHECK(lHm.getHeight() == 48);
+    }
+
+    TEST_CASE("Value range configuration") {
         REQUIRE_RAYLIB();
 
         RLHeatMap3D lHm(16, 16);
@@ -1292,6 +2528,97 @@ TEST_SUITE("RLHeatMap3D") {
         CHECK(lResult == false);
     }
 
+    TEST_CASE("Surface tiles upload only changed regions") {
+        REQUIRE_RAYLIB();
+
+        // 299x299 cells -> 3x3 tiles
+        RLHeatMap3D lHm(300, 300);
+        CHECK(lHm.getSurfaceChunkCount() == 9);
+        lHm.setValueRange(0.0f, 1.0f);
+        lHm.setSmoothing(1000.0f);
+
+        std::vector<float> lValues(300 * 300, 0.5f);
+        lHm.setValues(300, 300, lValues);
+        lHm.update(0.016f);
+        CHECK(lHm.getLastUploadedChunks() == 9);
+        lHm.update(0.016f);
+        lHm.update(0.016f);
+        CHECK(lHm.getLastUploadedChunks() == 0);
+
+        // Interior of the first tile
+        std::vector<float> lPatch(4, 0.9f);
+        lHm.updatePartialValues(10, 10, 2, 2, lPatch);
+        lHm.update(0.016f);
+        CHECK(lHm.getLastUploadedChunks() == 1);
+        lHm.update(0.016f);
+        lHm.update(0.016f);
+
+        // A vertex on the corner shared by four tiles
+        std::vector<float> lCorner(1, 0.1f);
+        lHm.updatePartialValues(128, 128, 1, 1, lCorner);
+        lHm.update(0.016f);
+        CHECK(lHm.getLastUploadedChunks() == 4);
+    }
+
+    TEST_CASE("Instanced scatter toggle") {
+        REQUIRE_RAYLIB();
+
+        RLHeatMap3D lHm(32, 32);
+        lHm.setMode(RLHeatMap3DMode::Scatter);
+        CHECK_FALSE(lHm.isInstancedScatterEnabled());
+
+        lHm.setInstancedScatter(true);
+        CHECK(lHm.isInstancedScatterEnabled());
+
+        std::vector<float> lValues(32 * 32, 0.25f);
+        lHm.setValues(32, 32, lValues);
+        lHm.update(0.016f);
+
+        // Without a usable GL 3.3 shader the combined scatter mesh is drawn instead
+        if (!lHm.isInstancedScatterActive()) {
+            Camera3D lCamera{};
+            lCamera.position = Vector3{0.0f, 2.0f, 4.0f};
+            lCamera.up = Vector3{0.0f, 1.0f, 0.0f};
+            lCamera.fovy = 45.0f;
+            lHm.draw(Vector3{0.0f, 0.0f, 0.0f}, 1.0f, lCamera);
+        }
+
+        lHm.setInstancedScatter(false);
+        CHECK_FALSE(lHm.isInstancedScatterActive());
+        lHm.update(0.016f);
+        CHECK(lHm.getWidth() == 32);
+    }
+
+    TEST_CASE("Surface level of detail follows camera distance") {
+        REQUIRE_RAYLIB();
+
+        RLHeatMap3D lHm(300, 300);
+        RLHeatMap3DStyle lStyle;
+        lStyle.mLodDistance = 10.0f;
+        lHm.setStyle(lStyle);
+        lHm.update(0.016f);
+        CHECK(lHm.getLastUploadedChunks() == 9);
+
+        Camera3D lCamera{};
+        lCamera.position = Vector3{0.0f, 2.0f, 4.0f};
+        lCamera.up = Vector3{0.0f, 1.0f, 0.0f};
+        lCamera.fovy = 45.0f;
+
+        // Nearby camera keeps full resolution: nothing to rebuild
+        lHm.draw(Vector3{0.0f, 0.0f, 0.0f}, 1.0f, lCamera);
+        lHm.update(0.016f);
+        CHECK(lHm.getLastUploadedChunks() == 0);
+
+        // Far camera coarsens every tile once, then stays stable
+        lCamera.position = Vector3{0.0f, 40.0f, 80.0f};
+        lHm.draw(Vector3{0.0f, 0.0f, 0.0f}, 1.0f, lCamera);
+        lHm.update(0.016f);
+        CHECK(lHm.getLastUploadedChunks() == 9);
+        lHm.draw(Vector3{0.0f, 0.0f, 0.0f}, 1.0f, lCamera);
+        lHm.update(0.016f);
+        CHECK(lHm.getLastUploadedChunks() == 0);
+    }
+
     TEST_CASE("Axis range configuration") {
         REQUIRE_RAYLIB();
 
@@ -1471,6 +2798,90 @@ TEST_SUITE("RLCandlestickChart") {
         CHECK(true);
     }
 
+    TEST_CASE("Sliding window settles with culled, translated draws") {
+        REQUIRE_RAYLIB();
+
+        RLCandlestickChart lChart(TEST_BOUNDS, 1, 10);
+        RLCandlestickChart::CandleSample lSample;
+        for (int i = 0; i < 40; i++) {
+            // A spike early on must leave the auto scale once it scrolls out
+            lSample.aClose = i == 3 ? 500.0f : 100.0f + (float)(i % 5);
+            lSample.aOpen = lSample.aClose - 1.0f;
+            lSample.aHigh = lSample.aClose + 2.0f;
+            lSample.aLow = lSample.aOpen - 2.0f;
+            lSample.aVolume = 10.0f;
+            lSample.aTime = 1700000000 + i * 60;
+            lChart.addSample(lSample);
+            lChart.update(0.05f);
+            lChart.draw();
+        }
+        CHECK(lChart.getCandleCount() <= 10);
+
+        // Toggling wick scaling rebuilds the window extrema
+        RLCandleStyle lStyle;
+        lStyle.mIncludeWicksInScale = false;
+        lChart.setStyle(lStyle);
+        int lFrames = 0;
+        while (!lChart.isSettled() && lFrames < 2000) {
+            lChart.update(0.05f);
+            lFrames++;
+        }
+        CHECK(lChart.isSettled());
+        lChart.draw();
+    }
+
+    TEST_CASE("Candles finalized between updates are all kept") {
+        REQUIRE_RAYLIB();
+
+        RLCandlestickChart lChart(TEST_BOUNDS, 1, 4);
+        RLCandlestickChart::CandleSample lSample;
+        for (int i = 0; i < 6; i++) {
+            lSample.aOpen = 100.0f + (float)i;
+            lSample.aHigh = lSample.aOpen + 1.0f;
+            lSample.aLow = lSample.aOpen - 1.0f;
+            lSample.aClose = lSample.aOpen;
+            lSample.aVolume = 10.0f;
+            lSample.aTime = 1700000000 + i * 60;
+            lChart.addSample(lSample);
+        }
+        for (int f = 0; f < 200 && !lChart.isSettled(); ++f) {
+            lChart.update(0.05f);
+        }
+        // Only the newest candles remain, none lost to the pending slide
+        CHECK(lChart.getCandleCount() == 4);
+    }
+
+    TEST_CASE("Batched geometry follows appends, pops and rebuilds") {
+        REQUIRE_RAYLIB();
+
+        RLCandleStyle lStyle;
+        lStyle.mBatchGeometry = true;
+        lStyle.mShowDayLabels = true;
+        RLCandlestickChart lChart(TEST_BOUNDS, 2, 12, lStyle);
+        lChart.setHistoryEnabled(true);
+        RLCandlestickChart::CandleSample lSample;
+        for (int i = 0; i < 300; i++) {
+            lSample.aClose = 100.0f + (float)(i % 7);
+            lSample.aOpen = lSample.aClose - 0.5f;
+            lSample.aHigh = lSample.aClose + 1.0f;
+            lSample.aLow = lSample.aOpen - 1.0f;
+            lSample.aVolume = (float)(1 + i % 3);
+            lSample.aTime = 1700000000 + (int64_t)i * 1800; // day changes every 48 samples
+            lChart.addSample(lSample);
+            lChart.update(0.03f);
+            lChart.draw();
+            if (i == 100) {
+                lChart.setVisibleCandles(40);
+            } else if (i == 150) {
+                lChart.setBounds(Rectangle{ 0, 0, 300, 120 });
+            } else if (i == 200) {
+                lChart.setValuesPerCandle(5); // rebuilt from history
+            }
+        }
+        CHECK(lChart.getCandleCount() <= 40);
+        CHECK(lChart.getCandleCount() > 0);
+    }
+
     TEST_CASE("Configuration changes") {
         REQUIRE_RAYLIB();
 
@@ -1487,6 +2898,194 @@ TEST_SUITE("RLCandlestickChart") {
         CHECK(true);
     }
 
+    TEST_CASE("Resolution changes rebuild from history") {
+        REQUIRE_RAYLIB();
+
+        RLCandlestickChart lChart(TEST_BOUNDS, 5, 10);
+        lChart.setHistoryEnabled(true);
+        RLCandlestickChart lDirect(TEST_BOUNDS, 15, 10);
+
+        RLCandlestickChart::CandleInput lSample;
+        lSample.aVolume = 10.0f;
+        for (int i = 0; i < 300; i++) {
+            lSample.aOpen = 100.0f + (float)(i % 17);
+            lSample.aClose = lSample.aOpen + 1.0f;
+            lSample.aHigh = lSample.aClose + 0.5f;
+            lSample.aLow = lSample.aOpen - 0.5f;
+            lSample.aDate = i < 150 ? "2024-01-15 09:30:00" : "2024-01-16 09:30:00";
+            lChart.addSample(lSample);
+            lDirect.addSample(lSample);
+            lDirect.update(1.0f); // finish each slide
+        }
+        CHECK(lChart.getHistory().getSampleCount() == 300);
+
+        lChart.setValuesPerCandle(15);
+        CHECK(lChart.getCandleCount() == lDirect.getCandleCount());
+        CHECK(lChart.getCandleCount() == 10);
+
+        // Two days: the first is finalized, the second is still aggregating
+        lChart.setDailyCandles(true);
+        CHECK(lChart.isDailyCandles());
+        CHECK(lChart.getCandleCount() == 1);
+
+        lChart.setValuesPerCandle(1);
+        CHECK_FALSE(lChart.isDailyCandles());
+        CHECK(lChart.getCandleCount() == 10);
+    }
+
+    TEST_CASE("Epoch samples split days like date strings") {
+        REQUIRE_RAYLIB();
+
+        RLCandleStyle lStyle;
+        lStyle.mShowDayLabels = true;
+        RLCandlestickChart lEpoch(TEST_BOUNDS, 5, 20, lStyle);
+        RLCandlestickChart lStrings(TEST_BOUNDS, 5, 20, lStyle);
+        // 2024-01-15 23:58:00 UTC, one sample per minute across midnight
+        const int64_t lStart = 1705363080;
+        const char* lDates[] = { "2024-01-15 23:58:00", "2024-01-15 23:59:00", "2024-01-16 00:00:00",
+                                 "2024-01-16 00:01:00", "2024-01-16 00:02:00" };
+        for (int i = 0; i < 5; i++) {
+            RLCandlestickChart::CandleSample lSample;
+            lSample.aOpen = 100.0f;
+            lSample.aHigh = 101.0f;
+            lSample.aLow = 99.0f;
+            lSample.aClose = 100.5f;
+            lSample.aVolume = 1.0f;
+            lSample.aTime = lStart + i * 60;
+            lEpoch.addSample(lSample);
+
+            RLCandlestickChart::CandleInput lInput;
+            lInput.aOpen = lSample.aOpen;
+            lInput.aHigh = lSample.aHigh;
+            lInput.aLow = lSample.aLow;
+            lInput.aClose = lSample.aClose;
+            lInput.aVolume = lSample.aVolume;
+            lInput.aDate = lDates[i];
+            lStrings.addSample(lInput);
+
+            lEpoch.update(1.0f);
+            lStrings.update(1.0f);
+        }
+        // The midnight sample closed the first (2-sample) candle early
+        CHECK(lEpoch.getCandleCount() == 1);
+        CHECK(lStrings.getCandleCount() == lEpoch.getCandleCount());
+        lEpoch.draw();
+
+        // Shifting the boundary an hour back puts all samples on the same day:
+        // 3 + 2 samples instead of 2 + 3
+        RLCandlestickChart lShifted(TEST_BOUNDS, 3, 20);
+        lShifted.setDayBoundaryOffset(-3600);
+        for (int i = 0; i < 5; i++) {
+            RLCandlestickChart::CandleSample lSample;
+            lSample.aClose = 100.0f;
+            lSample.aTime = lStart + i * 60;
+            lShifted.addSample(lSample);
+            lShifted.update(1.0f);
+        }
+        CHECK(lShifted.getCandleCount() == 1);
+        CHECK(lShifted.getHistory().getSampleCount() == 0);
+    }
+
+    TEST_CASE("Offscreen thumbnails are pipelined in order") {
+        REQUIRE_RAYLIB();
+
+        const Rectangle lBounds{ 0.0f, 0.0f, 64.0f, 32.0f };
+        RLCharts::OffscreenRenderer lRenderer(64, 32, 3);
+        RLCandlestickChart::CandleInput lSample;
+        lSample.aOpen = 100.0f;
+        lSample.aHigh = 105.0f;
+        lSample.aLow = 95.0f;
+        lSample.aClose = 102.0f;
+        lSample.aVolume = 1000.0f;
+        lSample.aDate = "2024-01-15 09:30:00";
+
+        RLCharts::OffscreenRenderer::Frame lFrame;
+        uint64_t lExpected = 1;
+        for (int i = 0; i < 8; i++) {
+            RLCandlestickChart lChart(lBounds, 1, 10);
+            lChart.addSample(lSample);
+            lChart.update(0.016f);
+            const uint64_t lTicket = lRenderer.submit(lChart, lBounds);
+            if (lTicket == 0) {
+                return; // no framebuffer support
+            }
+            CHECK(lTicket == (uint64_t)i + 1);
+            // Readback lags the ring depth behind submission
+            CHECK(lRenderer.getInFlightCount() <= lRenderer.getDepth());
+            while (lRenderer.fetch(lFrame)) {
+                CHECK(lFrame.mTicket == lExpected++);
+            }
+        }
+        CHECK(lExpected == 6);
+
+        lRenderer.flush();
+        CHECK(lRenderer.getInFlightCount() == 0);
+        while (lRenderer.fetch(lFrame)) {
+            CHECK(lFrame.mTicket == lExpected++);
+            CHECK(lFrame.mWidth == 64);
+            CHECK(lFrame.mHeight == 32);
+            CHECK(lFrame.mPixels.size() == (size_t)64 * 32 * 4);
+        }
+        CHECK(lExpected == 9);
+    }
+
+    TEST_CASE("Offscreen frames come back top row first") {
+        REQUIRE_RAYLIB();
+
+        // A red square at the top-left corner of the chart bounds on a blue background
+        const Rectangle lBounds{ 10.0f, 20.0f, 16.0f, 8.0f };
+        RLCharts::OffscreenRenderer lRenderer(16, 8, 1);
+        lRenderer.setClearColor(BLUE);
+        const uint64_t lTicket = lRenderer.submitWith(lBounds, []() { DrawRectangle(10, 20, 4, 2, RED); });
+        if (lTicket == 0) {
+            return; // no framebuffer support
+        }
+        lRenderer.flush();
+        RLCharts::OffscreenRenderer::Frame lFrame;
+        REQUIRE(lRenderer.fetch(lFrame));
+        REQUIRE(lFrame.mPixels.size() == (size_t)16 * 8 * 4);
+
+        const auto lPixel = [&lFrame](int aX, int aY) {
+            const unsigned char* pPixel = lFrame.mPixels.data() + ((size_t)aY * 16 + (size_t)aX) * 4;
+            return Color{ pPixel[0], pPixel[1], pPixel[2], pPixel[3] };
+        };
+        const Color lTopLeft = lPixel(0, 0);
+        CHECK(lTopLeft.r == RED.r);
+        CHECK(lTopLeft.g == RED.g);
+        CHECK(lTopLeft.b == RED.b);
+        CHECK(lTopLeft.a == 255);
+        const Color lBottomLeft = lPixel(0, 7);
+        CHECK(lBottomLeft.r == BLUE.r);
+        CHECK(lBottomLeft.g == BLUE.g);
+        CHECK(lBottomLeft.b == BLUE.b);
+        const Color lBelowSquare = lPixel(0, 2);
+        CHECK(lBelowSquare.b == BLUE.b);
+    }
+
+    TEST_CASE("Producer feeds samples through update") {
+        REQUIRE_RAYLIB();
+
+        RLCandlestickChart lChart(TEST_BOUNDS, 2, 20);
+        RLCandlestickChart::Producer lProducer = lChart.createProducer(4);
+        REQUIRE(lProducer.isValid());
+        CHECK_FALSE(RLCandlestickChart::Producer{}.isValid());
+
+        std::vector<RLCandlestickChart::CandleSample> lSamples(6);
+        for (size_t i = 0; i < lSamples.size(); ++i) {
+            const float lPrice = 100.0f + (float)i;
+            lSamples[i] = {lPrice, lPrice + 1.0f, lPrice - 1.0f, lPrice, 10.0f, 1700000000 + (int64_t)i * 60};
+        }
+        CHECK(lProducer.push(lSamples.data(), lSamples.size()) == 4);
+        CHECK_FALSE(lChart.isSettled());
+
+        // update() drains the queue: 4 samples at 2 per candle finalize two candles
+        for (int f = 0; f < 200 && !lChart.isSettled(); ++f) {
+            lChart.update(0.05f);
+        }
+        CHECK(lChart.getCandleCount() == 2);
+        CHECK(lProducer.push(lSamples[4]));
+    }
+
 }
 
 TEST_SUITE("RLTreeMap") {
@@ -1684,6 +3283,177 @@ TEST_SUITE("RLTreeMap") {
         CHECK(lTm.getNodeCount() > 0);
     }
 
+    TEST_CASE("Incremental updateValue matches a full layout") {
+        REQUIRE_RAYLIB();
+
+        const Rectangle lBounds = {0, 0, 800, 600};
+        RLTreeNode lRoot;
+        lRoot.mLabel = "Root";
+        uint32_t lSeed = 5u;
+        for (int g = 0; g < 6; g++) {
+            RLTreeNode lGroup;
+            lGroup.mLabel = "G" + std::to_string(g);
+            for (int m = 0; m < 5; m++) {
+                RLTreeNode lSub;
+                lSub.mLabel = "S" + std::to_string(m);
+                for (int l = 0; l < 8; l++) {
+                    lSeed = lSeed * 1664525u + 1013904223u;
+                    lSub.mChildren.push_back({"L" + std::to_string(l), 1.0f + (float)((lSeed >> 8) % 100u), RED, false, {}});
+                }
+                lGroup.mChildren.push_back(lSub);
+            }
+            lRoot.mChildren.push_back(lGroup);
+        }
+
+        RLTreeMap lTm(lBounds);
+        lTm.setData(lRoot);
+        for (int i = 0; i < 60; i++) {
+            lSeed = lSeed * 1664525u + 1013904223u;
+            const int lG = (int)((lSeed >> 4) % 6u);
+            const int lM = (int)((lSeed >> 10) % 5u);
+            const int lL = (int)((lSeed >> 16) % 8u);
+            // Mostly small moves, sometimes a leaf that takes over or vanishes
+            float lValue = 1.0f + (float)((lSeed >> 20) % 100u);
+            if (i % 11 == 0) {
+                lValue = 5000.0f;
+            } else if (i % 13 == 0) {
+                lValue = 0.0f;
+            }
+            lRoot.mChildren[lG].mChildren[lM].mChildren[lL].mValue = lValue;
+            lTm.updateValue({"G" + std::to_string(lG), "S" + std::to_string(lM), "L" + std::to_string(lL)}, lValue);
+
+            RLTreeMap lFull(lBounds);
+            lFull.setData(lRoot);
+            const std::vector<RLTreeRect>& rA = lTm.getComputedRects();
+            const std::vector<RLTreeRect>& rB = lFull.getComputedRects();
+            REQUIRE(rA.size() == rB.size());
+            size_t lMismatches = 0;
+            for (size_t n = 0; n < rA.size(); n++) {
+                const Rectangle& rRa = rA[n].mTargetRect;
+                const Rectangle& rRb = rB[n].mTargetRect;
+                lMismatches += (rA[n].mValue != rB[n].mValue || rRa.x != rRb.x || rRa.y != rRb.y ||
+                                rRa.width != rRb.width || rRa.height != rRb.height) ? 1 : 0;
+            }
+            CHECK(lMismatches == 0);
+        }
+
+        // Internal nodes and unknown paths leave the layout alone
+        const Rectangle lBefore = lTm.getComputedRects()[1].mTargetRect;
+        lTm.updateValue({"G0"}, 1.0e6f);
+        lTm.updateValue({"G0", "Missing"}, 1.0e6f);
+        CHECK(lTm.getComputedRects()[1].mTargetRect.width == lBefore.width);
+    }
+
+    TEST_CASE("Flat data matches node data") {
+        REQUIRE_RAYLIB();
+
+        RLTreeNode lRoot;
+        lRoot.mLabel = "Root";
+        lRoot.mChildren = {
+            {"A", 0.0f, RED, false, {{"A1", 30.0f, RED, true, {}}, {"A2", 10.0f, RED, false, {}}}},
+            {"B", 60.0f, BLUE, false, {}}
+        };
+        RLTreeMap lNodes(TEST_BOUNDS);
+        lNodes.setData(lRoot);
+
+        // Same tree, breadth-first instead of preorder, with a shared label table
+        RLTreeFlatData lFlat;
+        const uint32_t lRootLabel = lFlat.addLabel("Root");
+        const uint32_t lA = lFlat.addNode(RLTreeFlatData::NO_PARENT, lRootLabel, 0.0f);
+        const uint32_t lNodeA = lFlat.addNode(lA, lFlat.addLabel("A"), 0.0f);
+        lFlat.addNode(lA, lFlat.addLabel("B"), 60.0f);
+        const uint32_t lNodeA1 = lFlat.addNode(lNodeA, lFlat.addLabel("A1"), 30.0f);
+        lFlat.addNode(lNodeA, lFlat.addLabel("A2"), 10.0f);
+        RLTreeMap lTm(TEST_BOUNDS);
+        REQUIRE(lTm.setData(lFlat));
+
+        REQUIRE(lTm.getNodeCount() == lNodes.getNodeCount());
+        // Node order differs, so compare by label
+        for (size_t i = 0; i < lTm.getNodeCount(); i++) {
+            for (size_t j = 0; j < lNodes.getNodeCount(); j++) {
+                if (lNodes.getLabel(j) == lTm.getLabel(i)) {
+                    const RLTreeRect& rA = lTm.getComputedRects()[i];
+                    const RLTreeRect& rB = lNodes.getComputedRects()[j];
+                    CHECK(rA.mValue == rB.mValue);
+                    CHECK(rA.mDepth == rB.mDepth);
+                    CHECK(rA.mTargetRect.width == rB.mTargetRect.width);
+                    CHECK(rA.mTargetRect.height == rB.mTargetRect.height);
+                }
+            }
+        }
+        CHECK(lTm.getComputedRects()[lNodeA].mValue == doctest::Approx(40.0f));
+
+        // Unchanged structure: values only, current geometry keeps animating from where it is
+        const Rectangle lStart = lTm.getComputedRects()[lNodeA1].mRect;
+        lFlat.mValue[lNodeA1] = 300.0f;
+        REQUIRE(lTm.setTargetData(lFlat));
+        CHECK(lTm.getComputedRects()[lNodeA1].mRect.width == lStart.width);
+        CHECK(lTm.getComputedRects()[lNodeA1].mTargetRect.width > lStart.width);
+        CHECK(lTm.getComputedRects()[lNodeA].mValue == doctest::Approx(310.0f));
+
+        // By index, as a flat caller would
+        lTm.updateValue((size_t)lNodeA1, 30.0f);
+        CHECK(lTm.getComputedRects()[lNodeA].mValue == doctest::Approx(40.0f));
+    }
+
+    TEST_CASE("Invalid flat data is rejected") {
+        REQUIRE_RAYLIB();
+
+        RLTreeMap lTm(TEST_BOUNDS);
+        RLTreeFlatData lFlat;
+        const uint32_t lLabel = lFlat.addLabel("N");
+        lFlat.addNode(RLTreeFlatData::NO_PARENT, lLabel, 0.0f);
+        lFlat.addNode(0, lLabel, 1.0f);
+        REQUIRE(lTm.setData(lFlat));
+
+        RLTreeFlatData lBad = lFlat;
+        lBad.mParent[1] = 1; // parent must precede its node
+        CHECK_FALSE(lTm.setData(lBad));
+        lBad = lFlat;
+        lBad.mLabelId[1] = 7;
+        CHECK_FALSE(lTm.setTargetData(lBad));
+        lBad = lFlat;
+        lBad.mColor.push_back(RED);
+        CHECK_FALSE(lTm.setData(lBad));
+        CHECK(lTm.getNodeCount() == 2);
+    }
+
+    TEST_CASE("Picking matches a scan of all rects") {
+        REQUIRE_RAYLIB();
+
+        // Three levels, uneven values
+        RLTreeFlatData lFlat;
+        const uint32_t lLabel = lFlat.addLabel("n");
+        const uint32_t lRoot = lFlat.addNode(RLTreeFlatData::NO_PARENT, lLabel, 0.0f);
+        for (int g = 0; g < 6; g++) {
+            const uint32_t lGroup = lFlat.addNode(lRoot, lLabel, 0.0f);
+            for (int c = 0; c < 8; c++) {
+                lFlat.addNode(lGroup, lLabel, 1.0f + (float)((g * 7 + c * 3) % 11));
+            }
+        }
+        RLTreeMap lTm(TEST_BOUNDS);
+        REQUIRE(lTm.setData(lFlat));
+
+        const std::vector<RLTreeRect>& rRects = lTm.getComputedRects();
+        for (int y = 0; y < 300; y += 7) {
+            for (int x = 0; x < 400; x += 9) {
+                const Vector2 lP = {(float)x + 0.5f, (float)y + 0.5f};
+                int lExpected = -1;
+                for (size_t i = 0; i < rRects.size(); i++) {
+                    const Rectangle& rR = rRects[i].mRect;
+                    if (rR.width > 0.0f && rR.height > 0.0f && lP.x >= rR.x && lP.x <= rR.x + rR.width &&
+                        lP.y >= rR.y && lP.y <= rR.y + rR.height) {
+                        lExpected = (int)i;
+                    }
+                }
+                CHECK(lTm.getNodeAtPoint(lP) == lExpected);
+            }
+        }
+        const int lLeaf = lTm.getNodeAtPoint({200.5f, 150.5f});
+        REQUIRE(lLeaf >= 0);
+        CHECK(rRects[(size_t)lLeaf].mIsLeaf);
+    }
+
     TEST_CASE("Bounds update") {
         REQUIRE_RAYLIB();
 
@@ -1773,10 +3543,106 @@ TEST_SUITE("RLLogPlot") {
             lPlot.pushSample((float)i * 0.1f);
         }
 
-        CHECK(lPlot.getTimeSeriesSize() == 50);
+        CHECK(lPlot.getTimeSeriesSize() == 50);
+        lPlot.update(0.016f);
+
+        CHECK(lPlot.getBounds().width == doctest::Approx(400.0f));
+    }
+
+    TEST_CASE("Time series span push trims to window") {
+        REQUIRE_RAYLIB();
+
+        RLLogPlot lPlot(TEST_BOUNDS);
+        lPlot.setWindowSize(10);
+
+        std::vector<float> lValues(25);
+        for (size_t i = 0; i < lValues.size(); i++) {
+            lValues[i] = (float)i;
+        }
+        lPlot.pushSamples(std::span<const float>(lValues.data(), 4));
+        CHECK(lPlot.getTimeSeriesSize() == 4);
+        lPlot.pushSamples(std::span<const float>(lValues.data(), 8));
+        CHECK(lPlot.getTimeSeriesSize() == 10);
+        lPlot.pushSamples(lValues);
+        CHECK(lPlot.getTimeSeriesSize() == 10);
+    }
+
+    TEST_CASE("Time series ring keeps oldest-first order") {
+        REQUIRE_RAYLIB();
+
+        RLLogPlot lPlot(TEST_BOUNDS);
+        lPlot.setWindowSize(5);
+        for (int i = 0; i < 12; i++) {
+            lPlot.pushSample((float)i);
+        }
+
+        const std::vector<float>& rSeries = lPlot.getTimeSeries();
+        REQUIRE(rSeries.size() == 5);
+        CHECK(rSeries[0] == doctest::Approx(7.0f));
+        CHECK(rSeries[4] == doctest::Approx(11.0f));
+        CHECK(lPlot.getTimeSeriesSample(1) == doctest::Approx(8.0f));
+
+        // Shrinking the window keeps the newest samples
+        lPlot.setWindowSize(3);
+        CHECK(lPlot.getTimeSeriesSize() == 3);
+        CHECK(lPlot.getTimeSeries()[0] == doctest::Approx(9.0f));
+        lPlot.pushSample(12.0f);
+        CHECK(lPlot.getTimeSeries()[0] == doctest::Approx(10.0f));
+        CHECK(lPlot.getTimeSeries()[2] == doctest::Approx(12.0f));
+
+        lPlot.clearTimeSeries();
+        CHECK(lPlot.getTimeSeriesSize() == 0);
+        CHECK(lPlot.getTimeSeries().empty());
+    }
+
+    TEST_CASE("Streaming Allan deviation matches batch estimate") {
+        REQUIRE_RAYLIB();
+
+        RLLogPlot lPlot(TEST_BOUNDS);
+        lPlot.setWindowSize(64);
+
+        // Deterministic pseudo-noise
+        std::vector<float> lValues(200);
+        unsigned int lSeed = 12345u;
+        for (float& rV : lValues) {
+            lSeed = lSeed * 1664525u + 1013904223u;
+            rV = (float)(lSeed >> 8) / (float)(1u << 24) - 0.5f;
+        }
+
+        RLLogPlotAllanConfig lConfig;
+        lConfig.mSampleInterval = 0.5f;
+        size_t lIdx = lPlot.enableAllanDeviation(lConfig);
+        CHECK(lPlot.isAllanDeviationEnabled());
+        lPlot.pushSamples(lValues);
+        lPlot.update(0.016f);
+
+        const RLLogPlotTrace& rTrace = lPlot.getTraces()[lIdx];
+        REQUIRE(rTrace.mXValues.size() == 6); // m = 1..32 for a 64-sample window
+        CHECK(rTrace.mXValues[0] == doctest::Approx(0.5f));
+        CHECK(rTrace.mXValues[5] == doctest::Approx(16.0f));
+
+        // Reference: overlapping ADEV over all samples for m = 4
+        const size_t lM = 4;
+        std::vector<double> lPhase(lValues.size() + 1, 0.0);
+        for (size_t i = 0; i < lValues.size(); i++) {
+            lPhase[i + 1] = lPhase[i] + (double)lValues[i];
+        }
+        double lSum = 0.0;
+        size_t lTerms = 0;
+        for (size_t j = 0; j + 2 * lM < lPhase.size(); j++) {
+            const double lD = lPhase[j + 2 * lM] - 2.0 * lPhase[j + lM] + lPhase[j];
+            lSum += lD * lD;
+            lTerms++;
+        }
+        const float lExpected = (float)std::sqrt(lSum / (2.0 * (double)(lM * lM) * (double)lTerms));
+        CHECK(rTrace.mYValues[2] == doctest::Approx(lExpected).epsilon(1e-4));
+        CHECK(rTrace.mConfidence[2].mEnabled);
+        CHECK(rTrace.mConfidence[2].mLowerBound < rTrace.mYValues[2]);
+        CHECK(rTrace.mConfidence[2].mUpperBound > rTrace.mYValues[2]);
+
+        lPlot.resetAllanDeviation();
         lPlot.update(0.016f);
-
-        CHECK(lPlot.getBounds().width == doctest::Approx(400.0f));
+        CHECK(lPlot.getTraces()[lIdx].mXValues.empty());
     }
 
     TEST_CASE("Trace management") {
@@ -1831,6 +3697,212 @@ TEST_SUITE("RLOrderBookVis") {
         CHECK(lOb.getSnapshotCount() == 1);
     }
 
+    TEST_CASE("Ring texture uploads only new columns") {
+        REQUIRE_RAYLIB();
+
+        RLOrderBookVis lOb(TEST_BOUNDS, 100, 10);
+        lOb.setPriceMode(RLOrderBookPriceMode::ExplicitRange);
+        lOb.setPriceRange(95.0f, 105.0f);
+        lOb.setRingTexture(true);
+        CHECK(lOb.isRingTextureEnabled());
+
+        // Sizes below the scale floor keep the intensity scale fixed
+        RLOrderBookSnapshot lSnapshot;
+        lSnapshot.mBids = {{100.0f, 0.5f}, {99.0f, 0.25f}};
+        lSnapshot.mAsks = {{101.0f, 0.5f}};
+
+        lOb.pushSnapshot(lSnapshot);
+        lOb.update(0.016f);
+        CHECK(lOb.getLastUploadCells() == 100u * 10u);
+
+        lOb.pushSnapshot(lSnapshot);
+        lOb.update(0.016f);
+        CHECK(lOb.getLastUploadCells() == 10u);
+
+        // Several snapshots per frame, wrapping around the ring end
+        for (int i = 0; i < 99; i++) {
+            lOb.pushSnapshot(lSnapshot);
+        }
+        lOb.update(0.016f);
+        CHECK(lOb.getLastUploadCells() == 99u * 10u);
+        lOb.draw2D();
+
+        lOb.update(0.016f);
+        CHECK(lOb.getLastUploadCells() == 0u);
+
+        // Leaving ring mode re-lays the texture out in time order
+        lOb.setRingTexture(false);
+        lOb.update(0.016f);
+        CHECK(lOb.getLastUploadCells() == 100u * 10u);
+    }
+
+    TEST_CASE("Delta updates match full snapshots") {
+        REQUIRE_RAYLIB();
+
+        RLOrderBookVis lFull(TEST_BOUNDS, 8, 20);
+        RLOrderBookVis lDelta(TEST_BOUNDS, 8, 20);
+        for (RLOrderBookVis* pOb : {&lFull, &lDelta}) {
+            pOb->setPriceMode(RLOrderBookPriceMode::ExplicitRange);
+            pOb->setPriceRange(90.0f, 110.0f);
+            pOb->update(10.0f); // settle the price range
+        }
+
+        RLOrderBookSnapshot lSnapshot;
+        lSnapshot.mBids = {{100.0f, 5.0f}, {99.0f, 3.0f}, {98.0f, 2.0f}};
+        lSnapshot.mAsks = {{101.0f, 4.0f}, {102.0f, 6.0f}};
+        lFull.pushSnapshot(lSnapshot);
+        lDelta.applyUpdate(RLOrderBookSide::Bid, 99.0f, 3.0f);
+        lDelta.applyUpdate(RLOrderBookSide::Bid, 100.0f, 5.0f);
+        lDelta.applyUpdate(RLOrderBookSide::Bid, 98.0f, 2.0f);
+        lDelta.applyUpdate(RLOrderBookSide::Ask, 102.0f, 6.0f);
+        lDelta.applyUpdate(RLOrderBookSide::Ask, 101.0f, 4.0f);
+        lDelta.commitSnapshot();
+        CHECK(lDelta.getBookLevelCount(RLOrderBookSide::Bid) == 3);
+        CHECK(lDelta.getBookLevelCount(RLOrderBookSide::Ask) == 2);
+
+        // Second tick: one level changes, one is removed (incremental column)
+        lSnapshot.mBids = {{100.0f, 7.0f}, {98.0f, 2.0f}};
+        lFull.pushSnapshot(lSnapshot);
+        lDelta.applyUpdate(RLOrderBookSide::Bid, 100.0f, 7.0f);
+        lDelta.applyUpdate(RLOrderBookSide::Bid, 99.0f, 0.0f);
+        lDelta.commitSnapshot();
+        CHECK(lDelta.getBookLevelCount(RLOrderBookSide::Bid) == 2);
+
+        CHECK(lDelta.getSnapshotCount() == lFull.getSnapshotCount());
+        CHECK(lDelta.getCurrentMidPrice() == doctest::Approx(lFull.getCurrentMidPrice()));
+        CHECK(lDelta.getCurrentSpread() == doctest::Approx(lFull.getCurrentSpread()));
+        for (size_t t = 0; t < 2; t++) {
+            for (size_t r = 0; r < 20; r++) {
+                CHECK(lDelta.getHistoryValue(RLOrderBookSide::Bid, t, r) == doctest::Approx(lFull.getHistoryValue(RLOrderBookSide::Bid, t, r)));
+                CHECK(lDelta.getHistoryValue(RLOrderBookSide::Ask, t, r) == doctest::Approx(lFull.getHistoryValue(RLOrderBookSide::Ask, t, r)));
+            }
+        }
+
+        lDelta.clearBook();
+        CHECK(lDelta.getBookLevelCount(RLOrderBookSide::Bid) == 0);
+    }
+
+    TEST_CASE("State round trip restores history and book") {
+        REQUIRE_RAYLIB();
+
+        RLOrderBookVis lOb(TEST_BOUNDS, 8, 20);
+        lOb.setPriceMode(RLOrderBookPriceMode::ExplicitRange);
+        lOb.setPriceRange(90.0f, 110.0f);
+        lOb.update(10.0f);
+        RLOrderBookSnapshot lSnapshot;
+        lSnapshot.mBids = {{100.0f, 5.0f}, {99.0f, 3.0f}};
+        lSnapshot.mAsks = {{101.0f, 4.0f}, {102.0f, 6.0f}};
+        for (int i = 0; i < 11; i++) {
+            lSnapshot.mBids[0].second = 5.0f + (float)i;
+            lOb.pushSnapshot(lSnapshot);
+        }
+        lOb.applyUpdate(RLOrderBookSide::Bid, 100.0f, 2.0f);
+        lOb.applyUpdate(RLOrderBookSide::Ask, 101.0f, 1.0f);
+        lOb.commitSnapshot();
+        const std::vector<uint8_t> lState = lOb.saveState();
+        REQUIRE_FALSE(lState.empty());
+
+        RLOrderBookVis lRestored(TEST_BOUNDS, 4, 5);
+        lRestored.setPriceMode(RLOrderBookPriceMode::ExplicitRange);
+        lRestored.setPriceRange(90.0f, 110.0f);
+        CHECK(lRestored.loadState(lState));
+        CHECK(lRestored.getHistoryLength() == 8);
+        CHECK(lRestored.getPriceLevels() == 20);
+        CHECK(lRestored.getSnapshotCount() == 8);
+        CHECK(lRestored.getBookLevelCount(RLOrderBookSide::Bid) == 1);
+        CHECK(lRestored.getCurrentMidPrice() == doctest::Approx(lOb.getCurrentMidPrice()));
+        for (size_t t = 0; t < 8; t++) {
+            for (size_t r = 0; r < 20; r++) {
+                CHECK(lRestored.getHistoryValue(RLOrderBookSide::Bid, t, r) == lOb.getHistoryValue(RLOrderBookSide::Bid, t, r));
+                CHECK(lRestored.getHistoryValue(RLOrderBookSide::Ask, t, r) == lOb.getHistoryValue(RLOrderBookSide::Ask, t, r));
+            }
+        }
+        CHECK(lRestored.saveState() == lState);
+        lRestored.update(0.016f);
+        lRestored.draw2D();
+
+        // The restored book keeps taking deltas
+        lRestored.applyUpdate(RLOrderBookSide::Bid, 99.5f, 1.0f);
+        lRestored.commitSnapshot();
+        CHECK(lRestored.getBookLevelCount(RLOrderBookSide::Bid) == 2);
+        CHECK_FALSE(lRestored.loadState({}));
+    }
+
+    TEST_CASE("GPU colormap toggle") {
+        REQUIRE_RAYLIB();
+
+        RLOrderBookVis lOb(TEST_BOUNDS, 10, 5);
+        lOb.setGpuColormap(true);
+        CHECK(lOb.isGpuColormapEnabled());
+
+        RLOrderBookSnapshot lSnapshot;
+        lSnapshot.mBids = {{100.0f, 50.0f}, {99.0f, 30.0f}};
+        lSnapshot.mAsks = {{101.0f, 40.0f}, {102.0f, 60.0f}};
+        for (int i = 0; i < 12; i++) {
+            lOb.pushSnapshot(lSnapshot);
+            lOb.update(0.016f);
+        }
+        lOb.draw2D();
+        CHECK(lOb.getSnapshotCount() == lOb.getHistoryLength());
+
+        lOb.setGpuColormap(false);
+        CHECK_FALSE(lOb.isGpuColormapActive());
+        lOb.update(0.016f);
+    }
+
+    TEST_CASE("GPU displacement toggle") {
+        REQUIRE_RAYLIB();
+
+        RLOrderBookVis lOb(TEST_BOUNDS, 16, 8);
+        lOb.setGpuDisplacement3D(true);
+        CHECK(lOb.isGpuDisplacementEnabled());
+
+        RLOrderBookSnapshot lSnapshot;
+        lSnapshot.mBids = {{100.0f, 50.0f}};
+        lSnapshot.mAsks = {{101.0f, 40.0f}};
+        lOb.pushSnapshot(lSnapshot);
+        lOb.update(0.016f);
+
+        Camera3D lCamera = {};
+        lCamera.position = {0.0f, 20.0f, 20.0f};
+        lCamera.up = {0.0f, 1.0f, 0.0f};
+        lCamera.fovy = 45.0f;
+        lCamera.projection = CAMERA_PERSPECTIVE;
+        // Either the displaced static mesh or the CPU fallback meshes draw
+        lOb.draw3D(lCamera);
+
+        lOb.setGpuDisplacement3D(false);
+        CHECK_FALSE(lOb.isGpuDisplacementActive());
+        lOb.update(0.016f);
+        lOb.draw3D(lCamera);
+    }
+
+    TEST_CASE("Producer applies updates and commits in prepare") {
+        REQUIRE_RAYLIB();
+
+        RLOrderBookVis lOb(TEST_BOUNDS, 50, 10);
+        RLOrderBookVis::Producer lProducer = lOb.createProducer(16);
+        REQUIRE(lProducer.isValid());
+
+        const RLOrderBookUpdate lUpdates[] = {
+            {RLOrderBookSide::Bid, 99.0f, 5.0f, false},
+            {RLOrderBookSide::Bid, 98.0f, 3.0f, false},
+            {RLOrderBookSide::Ask, 101.0f, 4.0f, false},
+            {RLOrderBookSide::Bid, 0.0f, 0.0f, true},
+            {RLOrderBookSide::Bid, 98.0f, 0.0f, false},
+            {RLOrderBookSide::Bid, 0.0f, 0.0f, true},
+        };
+        CHECK(lProducer.push(lUpdates, 6) == 6);
+        CHECK(lOb.getSnapshotCount() == 0);
+        CHECK_FALSE(lOb.isSettled());
+
+        lOb.update(0.016f);
+        CHECK(lOb.getSnapshotCount() == 2);
+        CHECK(lOb.getBookLevelCount(RLOrderBookSide::Bid) == 1);
+        CHECK(lOb.getBookLevelCount(RLOrderBookSide::Ask) == 1);
+        CHECK(lOb.getCurrentMidPrice() == doctest::Approx(100.0f));
+    }
+
 }
 
 TEST_SUITE("RLBubble") {
@@ -1852,6 +3924,67 @@ TEST_SUITE("RLBubble") {
         CHECK(lBubble.getBounds().width == doctest::Approx(400.0f));
     }
 
+    TEST_CASE("Gravity packing is thread-count independent") {
+        REQUIRE_RAYLIB();
+
+        std::vector<RLBubblePoint> lData(5000);
+        uint32_t lSeed = 3u;
+        for (auto& rP : lData) {
+            lSeed = lSeed * 1664525u + 1013904223u;
+            rP.mX = (float)((lSeed >> 8) % 1000u) / 1000.0f;
+            rP.mY = (float)((lSeed >> 18) % 1000u) / 1000.0f;
+            rP.mSize = 0.001f;
+        }
+        RLBubbleStyle lStyle;
+        lStyle.mSizeScale = 8.0f;
+        lStyle.mMinRadius = 0.5f;
+        RLBubble lSerial(TEST_BOUNDS, RLBubbleMode::Gravity, lStyle);
+        lStyle.mPhysicsThreads = 4;
+        RLBubble lThreaded(TEST_BOUNDS, RLBubbleMode::Gravity, lStyle);
+        RLCharts::TaskPool lPool(4);
+        lThreaded.setTaskPool(&lPool);
+        lSerial.setData(lData);
+        lThreaded.setData(lData);
+        for (int i = 0; i < 5; i++) {
+            lSerial.update(0.016f);
+            lThreaded.update(0.016f);
+        }
+        REQUIRE(lSerial.getBubbleCount() == lThreaded.getBubbleCount());
+        for (size_t i = 0; i < lSerial.getBubbleCount(); i++) {
+            CHECK(lSerial.getBubblePosition(i).x == lThreaded.getBubblePosition(i).x);
+            CHECK(lSerial.getBubblePosition(i).y == lThreaded.getBubblePosition(i).y);
+        }
+        lSerial.draw();
+    }
+
+    TEST_CASE("Gravity packing separates bubbles") {
+        REQUIRE_RAYLIB();
+
+        std::vector<RLBubblePoint> lData(60);
+        for (size_t i = 0; i < lData.size(); i++) {
+            lData[i].mX = 0.5f + 0.01f * (float)(i % 7);
+            lData[i].mY = 0.5f + 0.01f * (float)(i % 5);
+            lData[i].mSize = 0.02f + 0.01f * (float)(i % 4);
+        }
+        RLBubble lBubble(TEST_BOUNDS, RLBubbleMode::Gravity);
+        lBubble.setData(lData);
+        for (int i = 0; i < 600; i++) {
+            lBubble.update(0.016f);
+        }
+        // Left over overlap is a small fraction of the radii
+        float lWorst = 0.0f;
+        for (size_t i = 0; i < lBubble.getBubbleCount(); i++) {
+            for (size_t j = i + 1; j < lBubble.getBubbleCount(); j++) {
+                const Vector2 lA = lBubble.getBubblePosition(i);
+                const Vector2 lB = lBubble.getBubblePosition(j);
+                const float lDist = sqrtf((lA.x - lB.x) * (lA.x - lB.x) + (lA.y - lB.y) * (lA.y - lB.y));
+                const float lRSum = lBubble.getBubbleRadius(i) + lBubble.getBubbleRadius(j);
+                lWorst = fmaxf(lWorst, (lRSum - lDist) / lRSum);
+            }
+        }
+        CHECK(lWorst < 0.25f);
+    }
+
     TEST_CASE("Animation") {
         REQUIRE_RAYLIB();
 
@@ -2155,4 +4288,628 @@ TEST_SUITE("RLSankey") {
         CHECK(lSankeyRaw.getNodeCount() == 3);
     }
 
+    TEST_CASE("Incremental setLinkValue matches a full layout") {
+        REQUIRE_RAYLIB();
+
+        RLSankeyStyle lStyle;
+        lStyle.mSmoothAnimate = false;
+        const Rectangle lBounds = {0, 0, 800, 600};
+        // Heavy columns 0/1, light columns 2/3 (so a light link keeps the scale)
+        const std::vector<RLSankeyNode> lNodes = {
+            {"P", RED, 0}, {"X", RED, 0}, {"Q", GREEN, 1}, {"R", GREEN, 1},
+            {"S", BLUE, 2}, {"T", BLUE, 3}
+        };
+        std::vector<RLSankeyLink> lLinks = {
+            {0, 2, 150.0f}, {1, 3, 50.0f}, {1, 2, 20.0f}, {3, 4, 5.0f}, {4, 5, 3.0f}
+        };
+        RLSankey lSankey(lBounds, lStyle);
+        lSankey.setData(lNodes, lLinks);
+        lSankey.update(0.016f);
+
+        uint32_t lSeed = 11u;
+        for (int i = 0; i < 20; i++) {
+            lSeed = lSeed * 1664525u + 1013904223u;
+            const size_t lLink = (size_t)((lSeed >> 8) % lLinks.size());
+            lLinks[lLink].mValue = 1.0f + (float)((lSeed >> 16) % 60u);
+            lSankey.setLinkValue(lLink, lLinks[lLink].mValue);
+            lSankey.update(0.016f);
+
+            RLSankey lFull(lBounds, lStyle);
+            lFull.setData(lNodes, lLinks);
+            lFull.update(0.016f);
+            for (size_t n = 0; n < lNodes.size(); n++) {
+                const Rectangle lA = lSankey.getNodeTargetRect(n);
+                const Rectangle lB = lFull.getNodeTargetRect(n);
+                CHECK(lA.y == doctest::Approx(lB.y));
+                CHECK(lA.height == doctest::Approx(lB.height));
+            }
+        }
+
+        // Only ribbons whose ends moved are re-tessellated
+        lLinks = {{0, 2, 150.0f}, {1, 3, 50.0f}, {1, 2, 20.0f}, {3, 4, 5.0f}, {4, 5, 3.0f}};
+        RLSankey lLight(lBounds, lStyle);
+        lLight.setData(lNodes, lLinks);
+        lLight.update(0.016f);
+        lLight.draw();
+        const size_t lBuilt = lLight.getCurveRebuildCount();
+        CHECK(lBuilt == lLinks.size());
+        lLight.draw();
+        CHECK(lLight.getCurveRebuildCount() == lBuilt);
+        lLight.setLinkValue(4, 4.0f);
+        lLight.update(0.016f);
+        lLight.draw();
+        CHECK(lLight.getCurveRebuildCount() == lBuilt + 1);
+    }
+
+    TEST_CASE("Batched ribbons are rebuilt only on change") {
+        REQUIRE_RAYLIB();
+
+        RLSankey lSankey(TEST_BOUNDS);
+        lSankey.setData({{"A", RED, 0}, {"B", GREEN, 1}, {"C", BLUE, 1}}, {{0, 1, 30.0f}, {0, 2, 10.0f}});
+        for (int i = 0; i < 200 && !lSankey.isSettled(); i++) {
+            lSankey.update(0.1f);
+        }
+        lSankey.draw();
+        const size_t lBuilt = lSankey.getRibbonBatchRebuildCount();
+        CHECK(lBuilt >= 1);
+        lSankey.draw();
+        lSankey.draw();
+        CHECK(lSankey.getRibbonBatchRebuildCount() == lBuilt);
+
+        // A color change rebuilds the buffer
+        RLSankeyStyle lStyle;
+        lStyle.mLinkAlpha = 0.3f;
+        lSankey.setStyle(lStyle);
+        lSankey.update(0.016f);
+        lSankey.draw();
+        CHECK(lSankey.getRibbonBatchRebuildCount() == lBuilt + 1);
+
+        // Immediate path never touches the buffer
+        lStyle.mBatchLinks = false;
+        lSankey.setStyle(lStyle);
+        lSankey.update(0.016f);
+        lSankey.draw();
+        CHECK(lSankey.getRibbonBatchRebuildCount() == lBuilt + 1);
+    }
+
+    TEST_CASE("Topological columns on a large graph") {
+        REQUIRE_RAYLIB();
+
+        // Layered DAG with links that skip layers; a node's column is its longest path
+        RLSankey lSankey(TEST_BOUNDS);
+        const size_t lLayers = 40;
+        const size_t lPerLayer = 50;
+        for (size_t i = 0; i < lLayers * lPerLayer; i++) {
+            lSankey.addNode("N" + std::to_string(i));
+        }
+        for (size_t l = 0; l + 1 < lLayers; l++) {
+            for (size_t n = 0; n < lPerLayer; n++) {
+                const size_t lSrc = l * lPerLayer + n;
+                lSankey.addLink(lSrc, (l + 1) * lPerLayer + (n * 7) % lPerLayer, 1.0f);
+                if (l + 3 < lLayers) {
+                    lSankey.addLink(lSrc, (l + 3) * lPerLayer + n, 1.0f);
+                }
+            }
+        }
+        // A cycle cannot be ordered and falls back to column 0
+        const size_t lCycleA = lSankey.addNode("CycleA");
+        const size_t lCycleB = lSankey.addNode("CycleB");
+        lSankey.addLink(lCycleA, lCycleB, 1.0f);
+        lSankey.addLink(lCycleB, lCycleA, 1.0f);
+        lSankey.update(0.016f);
+
+        CHECK(lSankey.getColumnCount() == (int)lLayers);
+        const float lSpacing = lSankey.getNodeTargetRect(lPerLayer).x - lSankey.getNodeTargetRect(0).x;
+        REQUIRE(lSpacing > 0.0f);
+        const float lLastX = lSankey.getNodeTargetRect((lLayers - 1) * lPerLayer).x;
+        CHECK((lLastX - lSankey.getNodeTargetRect(0).x) / lSpacing == doctest::Approx((float)(lLayers - 1)));
+        CHECK(lSankey.getNodeTargetRect(lCycleA).x == doctest::Approx(lSankey.getNodeTargetRect(0).x));
+        CHECK(lSankey.getNodeTargetRect(lCycleB).x == doctest::Approx(lSankey.getNodeTargetRect(0).x));
+    }
+
+    TEST_CASE("Hover picking matches a scan of all links") {
+        REQUIRE_RAYLIB();
+
+        RLSankey lSankey(TEST_BOUNDS);
+        for (int i = 0; i < 24; i++) {
+            lSankey.addNode({"n", RED, i / 6});
+        }
+        uint32_t lSeed = 5u;
+        for (int c = 0; c < 3; c++) {
+            for (int k = 0; k < 10; k++) {
+                lSeed = lSeed * 1664525u + 1013904223u;
+                const size_t lSrc = (size_t)(c * 6) + (lSeed >> 8) % 6u;
+                const size_t lDst = (size_t)((c + 1) * 6) + (lSeed >> 16) % 6u;
+                lSankey.addLink({lSrc, lDst, 1.0f + (float)((lSeed >> 4) % 9u)});
+            }
+        }
+        for (int i = 0; i < 300 && !lSankey.isSettled(); i++) {
+            lSankey.update(0.1f);
+        }
+        lSankey.draw(); // tessellates the ribbons
+
+        // Nodes: every target rect center finds its node; gaps find nothing
+        for (size_t n = 0; n < lSankey.getNodeCount(); n++) {
+            const Rectangle lR = lSankey.getNodeTargetRect(n);
+            if (lR.height > 1.0f) {
+                CHECK(lSankey.getHoveredNode({lR.x + lR.width * 0.5f, lR.y + lR.height * 0.5f}) == (int)n);
+            }
+        }
+        CHECK(lSankey.getHoveredNode({-50.0f, -50.0f}) == -1);
+
+        // Links: some probes land on ribbons, all answers are valid ids
+        int lLinkHits = 0;
+        for (int y = 0; y < 300; y += 5) {
+            for (int x = 0; x < 400; x += 5) {
+                const int lLink = lSankey.getHoveredLink({(float)x, (float)y});
+                lLinkHits += lLink >= 0 ? 1 : 0;
+                CHECK(lLink < (int)lSankey.getLinkCount());
+            }
+        }
+        CHECK(lLinkHits > 0);
+
+        // A single flat ribbon: hit along its middle, missed well above it
+        RLSankey lPair(TEST_BOUNDS);
+        lPair.setData({{"A", RED, 0}, {"B", BLUE, 1}}, {{0, 1, 10.0f}});
+        for (int i = 0; i < 300 && !lPair.isSettled(); i++) {
+            lPair.update(0.1f);
+        }
+        lPair.draw();
+        const Rectangle lA = lPair.getNodeTargetRect(0);
+        const Rectangle lB = lPair.getNodeTargetRect(1);
+        const float lMidX = (lA.x + lA.width + lB.x) * 0.5f;
+        CHECK(lPair.getHoveredLink({lMidX, lA.y + lA.height * 0.5f}) == 0);
+        CHECK(lPair.getHoveredLink({lMidX, lA.y - 40.0f}) == -1);
+
+        // After a change the grid follows the new layout
+        lSankey.setLinkValue(0, 40.0f);
+        for (int i = 0; i < 300 && !lSankey.isSettled(); i++) {
+            lSankey.update(0.1f);
+        }
+        lSankey.draw();
+        for (size_t n = 0; n < lSankey.getNodeCount(); n++) {
+            const Rectangle lR = lSankey.getNodeTargetRect(n);
+            if (lR.height > 1.0f) {
+                CHECK(lSankey.getHoveredNode({lR.x + lR.width * 0.5f, lR.y + lR.height * 0.5f}) == (int)n);
+            }
+        }
+    }
+
+    TEST_CASE("Barycenter ordering removes a crossing") {
+        REQUIRE_RAYLIB();
+
+        const std::vector<RLSankeyNode> lNodes = {
+            {"A", RED, 0}, {"B", RED, 0}, {"C", BLUE, 1}, {"D", BLUE, 1}
+        };
+        const std::vector<RLSankeyLink> lLinks = {{0, 3, 10.0f}, {1, 2, 10.0f}};
+
+        RLSankey lPlain(TEST_BOUNDS);
+        lPlain.setData(lNodes, lLinks);
+        lPlain.update(0.016f);
+        CHECK(lPlain.getNodeTargetRect(2).y < lPlain.getNodeTargetRect(3).y);
+
+        RLSankeyStyle lStyle;
+        lStyle.mOrderNodes = true;
+        RLSankey lOrdered(TEST_BOUNDS, lStyle);
+        lOrdered.setData(lNodes, lLinks);
+        lOrdered.update(0.016f);
+        // D (fed by A, the upper source) now sits above C
+        CHECK(lOrdered.getNodeTargetRect(3).y < lOrdered.getNodeTargetRect(2).y);
+        CHECK(lOrdered.getNodeTargetRect(0).y < lOrdered.getNodeTargetRect(1).y);
+    }
+
+}
+
+// Line protocol adapters. ManualFeedSource has no transport: the tests drive it
+// through feed()/flush() on the test thread.
+struct ManualFeedSource : RLDataSource {
+    using RLDataSource::RLDataSource;
+
+protected:
+    bool open() override { return false; }
+    long read(const char*&, int) override { return -1; }
+    void close() override {}
+};
+
+TEST_SUITE("RLDataSource") {
+
+    TEST_CASE("Line protocol parsing") {
+        RLFeedRecord lRecord;
+        CHECK(parseFeedLine("s 3 1.5", lRecord) == RLFeedParse::Record);
+        CHECK(lRecord.mKind == RLFeedKind::Sample);
+        CHECK(lRecord.mChannel == 3);
+        CHECK(lRecord.mValues[0] == doctest::Approx(1.5f));
+
+        CHECK(parseFeedLine("a,2,101.25,7\r", lRecord) == RLFeedParse::Record);
+        CHECK(lRecord.mKind == RLFeedKind::Ask);
+        CHECK(lRecord.mValues[1] == doctest::Approx(7.0f));
+
+        CHECK(parseFeedLine("o\t1\t1700000000\t1\t2\t0.5\t1.5\t100", lRecord) == RLFeedParse::Record);
+        CHECK(lRecord.mKind == RLFeedKind::Candle);
+        CHECK(lRecord.mTime == 1700000000);
+        CHECK(lRecord.mValues[4] == doctest::Approx(100.0f));
+
+        CHECK(parseFeedLine("c 4", lRecord) == RLFeedParse::Record);
+        CHECK(lRecord.mKind == RLFeedKind::Commit);
+
+        CHECK(parseFeedLine("", lRecord) == RLFeedParse::Empty);
+        CHECK(parseFeedLine("   # comment", lRecord) == RLFeedParse::Empty);
+        CHECK(parseFeedLine("s 1", lRecord) == RLFeedParse::Invalid);
+        CHECK(parseFeedLine("s 1 2 3", lRecord) == RLFeedParse::Invalid);
+        CHECK(parseFeedLine("s 1 2x", lRecord) == RLFeedParse::Invalid);
+        CHECK(parseFeedLine("sample 1 2", lRecord) == RLFeedParse::Invalid);
+        CHECK(parseFeedLine("x 1 2", lRecord) == RLFeedParse::Invalid);
+    }
+
+    TEST_CASE("Routes by channel and carries partial lines") {
+        REQUIRE_RAYLIB();
+
+        RLTimeSeries lTs(TEST_BOUNDS, 100);
+        const size_t lTrace = lTs.addTrace();
+        ManualFeedSource lSource;
+        CHECK_FALSE(lSource.addSampleRoute(0, RLTimeSeries::Producer{}));
+        REQUIRE(lSource.addSampleRoute(2, lTs.createProducer(lTrace)));
+
+        lSource.feed("s 2 1\ns 2 2\ns 9 5\nbad line\ns 2 ");
+        lSource.feed("3\ns 2 4");
+        lSource.flush();
+        lTs.update(0.016f);
+
+        CHECK(lTs.getTraceSampleCount(lTrace) == 4);
+        const RLFeedStats lStats = lSource.getStats();
+        CHECK(lStats.mRecords == 5);
+        CHECK(lStats.mDelivered == 4);
+        CHECK(lStats.mUnrouted == 1);
+        CHECK(lStats.mInvalid == 1);
+    }
+
+    TEST_CASE("Backpressure policies") {
+        REQUIRE_RAYLIB();
+
+        const char* pBurst = "s 0 1\ns 0 2\ns 0 3\ns 0 4\ns 0 5\ns 0 6\ns 0 7\ns 0 8\n";
+        RLTimeSeries lTs(TEST_BOUNDS, 100);
+        const size_t lTrace = lTs.addTrace();
+
+        // The queue takes 4; Drop discards the other 4
+        ManualFeedSource lDrop(RLFeedPolicy::Drop);
+        lDrop.addSampleRoute(0, lTs.createProducer(lTrace, 4));
+        lDrop.feed(pBurst);
+        CHECK(lDrop.getStats().mDelivered == 4);
+        CHECK(lDrop.getStats().mDropped == 4);
+
+        // LatestWins holds back only the newest, Aggregate their mean
+        ManualFeedSource lLatest(RLFeedPolicy::LatestWins);
+        lLatest.addSampleRoute(0, lTs.createProducer(lTrace, 4));
+        lLatest.feed(pBurst);
+        CHECK(lLatest.getStats().mCoalesced == 3);
+        ManualFeedSource lAggregate(RLFeedPolicy::Aggregate);
+        lAggregate.addSampleRoute(0, lTs.createProducer(lTrace, 4));
+        lAggregate.feed(pBurst);
+        CHECK(lAggregate.getStats().mCoalesced == 3);
+
+        lTs.update(0.016f);
+        CHECK(lTs.getTraceSampleCount(lTrace) == 12);
+        lLatest.flush();
+        lAggregate.flush();
+        lTs.update(0.016f);
+        REQUIRE(lTs.getTraceSampleCount(lTrace) == 14);
+        CHECK(lLatest.getStats().mDelivered == 5);
+        CHECK(lAggregate.getStats().mDelivered == 5);
+    }
+
+    TEST_CASE("Coalesced book updates reach the same book") {
+        REQUIRE_RAYLIB();
+
+        RLOrderBookVis lOb(TEST_BOUNDS, 50, 10);
+        ManualFeedSource lSource(RLFeedPolicy::LatestWins);
+        lSource.addBookRoute(1, lOb.createProducer(2));
+        lSource.feed("b 1 99 5\na 1 101 5\nc 1\n"
+                     "b 1 99 7\nb 1 98 1\nc 1\n"
+                     "b 1 98 0\nb 1 97 2\na 1 102 3\nc 1\n");
+        // Three columns collapse into one: unique levels plus the last commit
+        CHECK(lSource.getStats().mCoalesced > 0);
+        for (int f = 0; f < 8; ++f) {
+            lOb.update(0.016f);
+            lSource.flush();
+        }
+        CHECK(lOb.getSnapshotCount() == 1);
+        CHECK(lOb.getBookLevelCount(RLOrderBookSide::Bid) == 2);
+        CHECK(lOb.getBookLevelCount(RLOrderBookSide::Ask) == 2);
+    }
+
+    TEST_CASE("Aggregate merges candles") {
+        REQUIRE_RAYLIB();
+
+        RLCandlestickChart lChart(TEST_BOUNDS, 1, 20);
+        ManualFeedSource lSource(RLFeedPolicy::Aggregate);
+        lSource.addCandleRoute(0, lChart.createProducer(2));
+        lSource.feed("o 0 60 1 1 1 1 1\no 0 120 1 1 1 1 1\n"
+                     "o 0 180 2 5 1.5 3 10\no 0 240 3 4 0.5 2 20\n");
+        CHECK(lSource.getStats().mCoalesced == 1);
+        for (int f = 0; f < 200 && !lChart.isSettled(); ++f) {
+            lChart.update(0.05f);
+            lSource.flush();
+        }
+        // The two that fit plus the merged one, one candle each
+        CHECK(lSource.getStats().mDelivered == 3);
+        CHECK(lChart.getCandleCount() == 3);
+    }
+
+    TEST_CASE("Replay delivers every line") {
+        REQUIRE_RAYLIB();
+
+        const char* pPath = "rlcharts_test_feed.txt";
+        FILE* lpFile = std::fopen(pPath, "wb");
+        REQUIRE(lpFile != nullptr);
+        for (int i = 0; i < 3000; ++i) {
+            std::fprintf(lpFile, "s 0 %d\n", i);
+        }
+        std::fclose(lpFile);
+
+        RLTimeSeries lTs(TEST_BOUNDS, 5000);
+        const size_t lTrace = lTs.addTrace();
+        RLReplayFeedSource lReplay(pPath, 0.0, false);
+        lReplay.addSampleRoute(0, lTs.createProducer(lTrace, 256));
+        REQUIRE(lReplay.start());
+
+        // Replay never drops: the I/O thread waits while the small queue is full
+        for (int i = 0; i < 100000 && (lReplay.isRunning() || !lTs.isSettled()); ++i) {
+            lTs.update(0.016f);
+            std::this_thread::yield();
+        }
+        lReplay.stop();
+        lTs.update(0.016f);
+        std::remove(pPath);
+
+        CHECK(lTs.getTraceSampleCount(lTrace) == 3000);
+        CHECK(lReplay.getStats().mDropped == 0);
+    }
+
+}
+
+TEST_SUITE("RLDashboard") {
+
+    TEST_CASE("Parallel updates match sequential updates") {
+        REQUIRE_RAYLIB();
+
+        constexpr size_t GAUGES = 12;
+        std::vector<RLGauge> lParallel;
+        std::vector<RLGauge> lSerial;
+        lParallel.reserve(GAUGES);
+        lSerial.reserve(GAUGES);
+        RLDashboard lDashboard(4);
+        for (size_t i = 0; i < GAUGES; ++i) {
+            lParallel.emplace_back(TEST_BOUNDS, 0.0f, 100.0f);
+            lSerial.emplace_back(TEST_BOUNDS, 0.0f, 100.0f);
+            lParallel[i].setTargetValue(5.0f * (float)i);
+            lSerial[i].setTargetValue(5.0f * (float)i);
+            lDashboard.add(lParallel[i]);
+        }
+        CHECK(lDashboard.getChartCount() == GAUGES);
+        CHECK(lDashboard.getThreadCount() == 4);
+
+        for (int f = 0; f < 10; ++f) {
+            lDashboard.update(0.016f);
+            for (RLGauge& rGauge : lSerial) {
+                rGauge.update(0.016f);
+            }
+        }
+        for (size_t i = 0; i < GAUGES; ++i) {
+            CHECK(lParallel[i].getValue() == lSerial[i].getValue());
+        }
+    }
+
+    TEST_CASE("GPU charts prepare on the pool and commit on the calling thread") {
+        REQUIRE_RAYLIB();
+
+        RLHeatMap lHeatMap(TEST_BOUNDS, 16, 16);
+        RLOrderBookVis lOrderBook(TEST_BOUNDS, 100, 10);
+        RLHeatMap3D lHeatMap3D(16, 16);
+        RLGauge lGauge(TEST_BOUNDS, 0.0f, 100.0f);
+        RLScatterPlotStyle lScatterStyle;
+        lScatterStyle.mDensityThreshold = 2;
+        RLScatterPlot lScatter(TEST_BOUNDS, lScatterStyle);
+        lScatter.setSingleSeries({{0.2f, 0.3f}, {0.6f, 0.7f}, {0.9f, 0.1f}});
+        RLDashboard lDashboard(2);
+        lDashboard.add(lHeatMap);
+        lDashboard.add(lScatter);
+        lDashboard.add(lOrderBook, [&] { lOrderBook.draw2D(); });
+        const Camera3D lCamera{};
+        lDashboard.add(lHeatMap3D, [&] { lHeatMap3D.draw({0.0f, 0.0f, 0.0f}, 1.0f, lCamera); });
+        lDashboard.add(lGauge);
+        const std::vector<Vector2> lPoints = {{0.5f, 0.5f}, {0.25f, 0.75f}};
+        CHECK(lHeatMap.addPoints(lPoints));
+        lDashboard.update(0.016f);
+        CHECK(lHeatMap.getLastUploadCells() > 0u);
+        CHECK(lHeatMap.isSettled());
+        CHECK(lHeatMap.needsRedraw());
+        // Density binned by prepare() on the pool
+        CHECK(lScatter.getDensityGrid().size() == (size_t)lScatter.getDensityCellsX() * (size_t)lScatter.getDensityCellsY());
+        CHECK_FALSE(lScatter.getDensityGrid().empty());
+        lDashboard.draw();
+    }
+
+}
+
+// Performance contracts: steady-state work must not allocate, and idle charts
+// must not upload. A failure here is a performance regression, not a crash.
+TEST_SUITE("Perf contracts") {
+
+    TEST_CASE("Streaming a full time series window does not allocate") {
+        REQUIRE_RAYLIB();
+
+        RLTimeSeries lChart(TEST_BOUNDS, 500);
+        lChart.addTrace();
+        lChart.addTrace();
+        float lT = 0.0f;
+        auto lFrame = [&]() {
+            for (int i = 0; i < 10; i++) {
+                lT += 0.05f;
+                lChart.pushSample(0, sinf(lT));
+                lChart.pushSample(1, cosf(lT * 0.7f));
+            }
+            lChart.update(0.016f);
+            lChart.draw();
+        };
+        // Fill the window a few times so every buffer reached its final size
+        for (int i = 0; i < 300; i++) {
+            lFrame();
+        }
+
+        const PerfBudget lBudget;
+        for (int i = 0; i < 200; i++) {
+            lFrame();
+        }
+        CHECK(lBudget.allocations() == 0);
+    }
+
+    TEST_CASE("Heat map uploads only when points arrive") {
+        REQUIRE_RAYLIB();
+
+        RLHeatMap lChart(TEST_BOUNDS, 64, 64);
+        std::vector<Vector2> lPoints(1000);
+        for (size_t i = 0; i < lPoints.size(); i++) {
+            lPoints[i] = { sinf((float)i * 0.1f) * 0.9f, cosf((float)i * 0.07f) * 0.9f };
+        }
+        lChart.addPoints(lPoints);
+        lChart.update(0.016f);
+        lChart.draw();
+
+        {
+            const PerfBudget lBudget;
+            lChart.addPoints(lPoints);
+            lChart.update(0.016f);
+            lChart.draw();
+            CHECK(lBudget.uploadBytes() > 0);
+        }
+        {
+            const PerfBudget lBudget;
+            for (int i = 0; i < 20; i++) {
+                lChart.update(0.016f);
+                lChart.draw();
+            }
+            CHECK(lBudget.uploadBytes() == 0);
+        }
+        {
+            // Binning, colorizing and staging reuse their buffers
+            const PerfBudget lBudget;
+            for (int i = 0; i < 50; i++) {
+                lChart.addPoints(lPoints);
+                lChart.update(0.016f);
+                lChart.draw();
+            }
+            CHECK(lBudget.allocations() == 0);
+        }
+    }
+
+    TEST_CASE("Threaded heat map binning does not allocate per batch") {
+        REQUIRE_RAYLIB();
+
+        RLCharts::TaskPool lPool(4);
+        RLHeatMap lChart(TEST_BOUNDS, 128, 128);
+        lChart.setTaskPool(&lPool);
+        lChart.setBinningThreads(4);
+        std::vector<Vector2> lPoints(4 * 40000);
+        for (size_t i = 0; i < lPoints.size(); i++) {
+            lPoints[i] = { sinf((float)i * 0.013f) * 0.9f, cosf((float)i * 0.029f) * 0.9f };
+        }
+        for (int i = 0; i < 3; i++) {
+            lChart.addPoints(lPoints);
+            lChart.update(0.016f);
+        }
+
+        // Slices and merge bands run on the pool; no threads or vectors per call
+        const PerfBudget lBudget;
+        for (int i = 0; i < 20; i++) {
+            lChart.addPoints(lPoints);
+            lChart.update(0.016f);
+        }
+        CHECK(lBudget.allocations() == 0);
+    }
+
+    TEST_CASE("Animating scatter density does not allocate per frame") {
+        REQUIRE_RAYLIB();
+
+        RLCharts::TaskPool lPool(4);
+        RLScatterPlotStyle lStyle;
+        lStyle.mDensityThreshold = 1000;
+        lStyle.mDensityThreads = 4;
+        RLScatterPlot lChart(TEST_BOUNDS, lStyle);
+        lChart.setTaskPool(&lPool);
+        std::vector<Vector2> lFrom(4 * 140000);
+        std::vector<Vector2> lTo(lFrom.size());
+        for (size_t i = 0; i < lFrom.size(); i++) {
+            lFrom[i] = { 0.5f + sinf((float)i * 0.013f) * 0.4f, 0.5f + cosf((float)i * 0.029f) * 0.4f };
+            lTo[i] = { lFrom[i].y, lFrom[i].x };
+        }
+        RLScatterSeriesStyle lSeriesStyle;
+        lSeriesStyle.mLineMode = RLScatterLineMode::None;
+        lChart.setSingleSeries(lFrom, lSeriesStyle);
+        for (int i = 0; i < 3; i++) {
+            lChart.setSingleSeriesTargetData(i % 2 == 0 ? lTo : lFrom);
+            lChart.update(0.016f);
+            lChart.draw();
+        }
+        REQUIRE(lChart.usesDensity(0));
+
+        // Binned in update() as tasks on the pool; no threads or vectors per frame
+        const PerfBudget lBudget;
+        for (int i = 0; i < 10; i++) {
+            lChart.setSingleSeriesTargetData(i % 2 == 0 ? lTo : lFrom);
+            lChart.update(0.016f);
+            lChart.draw();
+        }
+        CHECK(lBudget.allocations() == 0);
+    }
+
+    TEST_CASE("Threaded bubble collisions do not allocate per step") {
+        REQUIRE_RAYLIB();
+
+        std::vector<RLBubblePoint> lData(4 * 2048);
+        for (size_t i = 0; i < lData.size(); i++) {
+            lData[i].mX = 0.5f + 0.3f * sinf((float)i * 0.37f);
+            lData[i].mY = 0.5f + 0.3f * cosf((float)i * 0.53f);
+            lData[i].mSize = 0.01f;
+        }
+        RLCharts::TaskPool lPool(4);
+        RLBubbleStyle lStyle;
+        lStyle.mSizeScale = 8.0f;
+        lStyle.mMinRadius = 0.5f;
+        lStyle.mPhysicsThreads = 4;
+        RLBubble lChart(TEST_BOUNDS, RLBubbleMode::Gravity, lStyle);
+        lChart.setTaskPool(&lPool);
+        lChart.setData(lData);
+        for (int i = 0; i < 3; i++) {
+            lChart.update(0.016f);
+        }
+
+        // Eight passes per step as tasks on the pool; no threads or vectors per step
+        const PerfBudget lBudget;
+        for (int i = 0; i < 10; i++) {
+            lChart.update(0.016f);
+        }
+        CHECK(lBudget.allocations() == 0);
+    }
+
+    TEST_CASE("Settled dense bar chart neither allocates nor uploads") {
+        REQUIRE_RAYLIB();
+
+        RLBarChart lChart(TEST_BOUNDS, RLBarOrientation::VERTICAL);
+        std::vector<float> lBins(10000);
+        for (size_t i = 0; i < lBins.size(); i++) {
+            lBins[i] = (float)(i % 97);
+        }
+        lChart.setDenseData(lBins);
+        lChart.draw();
+        REQUIRE(lChart.isSettled());
+
+        const PerfBudget lBudget;
+        for (int i = 0; i < 20; i++) {
+            lChart.update(0.016f);
+            lChart.draw();
+        }
+        CHECK(lBudget.allocations() == 0);
+        CHECK(lBudget.uploadBytes() == 0);
+    }
+
 }
@@ -7,10 +7,39 @@
     #define NOUSER            // Excludes USER (CloseWindow, ShowCursor, etc.)
 #endif
 
+#include "RLCircleBatch.h"
+#include "RLColormap.h"
 #include "RLCommon.h"
+#include "RLFrameArena.h"
+#include "RLGpuStaging.h"
+#include "RLLabelCache.h"
+#include "RLLineBatch.h"
+#include "RLOhlcLoader.h"
+#include "RLOhlcPyramid.h"
+#include "RLPerf.h"
+#include "RLRectBatch.h"
+#include "RLRingQueue.h"
+#include "RLSamplePyramid.h"
+#include "RLSlidingExtrema.h"
+#include "RLSpatialGrid.h"
+#include "RLSpline.h"
+#include "RLSpscRing.h"
+#include "RLSimd.h"
+#include "RLStateCodec.h"
+#include "RLTaskPool.h"
 
 #include "doctest/doctest.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
 
 TEST_SUITE("RLCommon") {
 
@@ -150,5 +179,1415 @@ TEST_SUITE("RLCommon") {
         CHECK(lAt1.y == doctest::Approx(1.0f));
     }
 
+    TEST_CASE("CellRect") {
+        RLCharts::CellRect lRect;
+        CHECK(lRect.isEmpty());
+        CHECK(lRect.area() == 0u);
+
+        lRect.include(3, 4);
+        CHECK(lRect.area() == 1u);
+        lRect.include(1, 6);
+        CHECK(lRect.mX0 == 1);
+        CHECK(lRect.mY0 == 4);
+        CHECK(lRect.width() == 3);
+        CHECK(lRect.height() == 3);
+
+        lRect.merge(RLCharts::CellRect{});
+        CHECK(lRect.area() == 9u);
+        lRect.reset();
+        CHECK(lRect.isEmpty());
+    }
+
+}
+
+TEST_SUITE("RLLabelCache") {
+
+    TEST_CASE("Extents are measured once per text, font and size") {
+        RLCharts::LabelCache lCache;
+        const Font lFont{};
+        const Vector2 lDirect = MeasureTextEx(lFont, "Revenue", 14.0f, 1.0f);
+        const Vector2 lFirst = lCache.measure(lFont, "Revenue", 14.0f, 1.0f);
+        const Vector2 lSecond = lCache.measure(lFont, "Revenue", 14.0f, 1.0f);
+        CHECK(lFirst.x == lDirect.x);
+        CHECK(lSecond.x == lDirect.x);
+        CHECK(lCache.getMisses() == 1);
+        CHECK(lCache.getHits() == 1);
+
+        // Any part of the key differing is a separate entry
+        (void)lCache.measure(lFont, "Revenue", 16.0f, 1.0f);
+        (void)lCache.measure(lFont, "Revenue", 14.0f, 0.0f);
+        (void)lCache.measure(lFont, "Cost", 14.0f, 1.0f);
+        CHECK(lCache.measureDefault("Revenue", 14) == MeasureText("Revenue", 14));
+        CHECK(lCache.size() == 5);
+        CHECK(lCache.getHits() == 1);
+    }
+
+    TEST_CASE("Entry limit bounds the cache") {
+        RLCharts::LabelCache lCache(8);
+        const Font lFont{};
+        for (int i = 0; i < 100; i++) {
+            const std::string lText = std::to_string(i);
+            (void)lCache.measure(lFont, lText.c_str(), 12.0f, 0.0f);
+        }
+        CHECK(lCache.size() <= 8);
+        CHECK(lCache.getMisses() == 100);
+    }
+
+    TEST_CASE("FormattedLabel reformats on change only") {
+        RLCharts::FormattedLabel lLabel;
+        CHECK(std::string(lLabel.format("%.0f", 42.0)) == "42");
+        CHECK(std::string(lLabel.format("%.0f", 42.0)) == "42");
+        CHECK(lLabel.getFormatCount() == 1);
+        CHECK(std::string(lLabel.format("10^%d", 3)) == "10^3");
+        CHECK(std::string(lLabel.format("10^%d", -2)) == "10^-2");
+        CHECK(lLabel.getFormatCount() == 3);
+    }
+}
+
+TEST_SUITE("RLLineBatch") {
+
+    TEST_CASE("Segments and polylines expand to triangles") {
+        RLCharts::LineBatch lBatch;
+        CHECK(lBatch.empty());
+
+        lBatch.addSegment({0.0f, 0.0f}, {10.0f, 0.0f}, 2.0f, WHITE);
+        CHECK(lBatch.getTriangleCount() == 2);
+
+        // Degenerate input produces no geometry
+        lBatch.addSegment({5.0f, 5.0f}, {5.0f, 5.0f}, 2.0f, WHITE);
+        CHECK(lBatch.getTriangleCount() == 2);
+
+        lBatch.clear();
+        const Vector2 lPoints[] = {{0.0f, 0.0f}, {10.0f, 5.0f}, {10.0f, 5.0f}, {20.0f, 0.0f}, {30.0f, 10.0f}};
+        lBatch.addPolyline(lPoints, 5, 3.0f, WHITE);
+        CHECK(lBatch.getTriangleCount() == 6); // 3 non-degenerate segments
+        CHECK(lBatch.getVertexCount() == 18);
+    }
+
+    TEST_CASE("A polyline split in two runs matches the contiguous one") {
+        const Vector2 lPoints[] = {{0.0f, 0.0f}, {10.0f, 5.0f}, {20.0f, 0.0f}, {30.0f, 10.0f}, {40.0f, 2.0f}};
+        RLCharts::LineBatch lWhole;
+        lWhole.addPolyline(lPoints, 5, 3.0f, WHITE);
+        RLCharts::LineBatch lSplit;
+        lSplit.addPolyline(lPoints, 2, lPoints + 2, 3, 3.0f, WHITE);
+        CHECK(lSplit.getVertexCount() == lWhole.getVertexCount());
+        RLCharts::LineBatch lSecondOnly;
+        lSecondOnly.addPolyline(nullptr, 0, lPoints, 5, 3.0f, WHITE);
+        CHECK(lSecondOnly.getVertexCount() == lWhole.getVertexCount());
+    }
+
+    TEST_CASE("Markers and strips") {
+        RLCharts::LineBatch lBatch;
+        lBatch.addCircle({50.0f, 50.0f}, 3.0f, WHITE);
+        CHECK(lBatch.getTriangleCount() >= 12);
+
+        lBatch.clear();
+        const Vector2 lStrip[] = {{0.0f, 0.0f}, {0.0f, 10.0f}, {10.0f, 0.0f}, {10.0f, 10.0f}};
+        lBatch.addTriangleStrip(lStrip, 4, WHITE);
+        CHECK(lBatch.getTriangleCount() == 2);
+    }
+
+    TEST_CASE("Triangles survive copies and moves") {
+        RLCharts::LineBatch lBatch;
+        lBatch.addSegment({0.0f, 0.0f}, {10.0f, 0.0f}, 2.0f, WHITE);
+        CHECK_FALSE(lBatch.wasBuffered());
+
+        RLCharts::LineBatch lCopy(lBatch);
+        CHECK(lCopy.getTriangleCount() == 2);
+        RLCharts::LineBatch lMoved(std::move(lCopy));
+        CHECK(lMoved.getTriangleCount() == 2);
+        lMoved = lBatch;
+        CHECK(lMoved.getVertexCount() == 6);
+
+        lBatch.clear();
+        CHECK(lBatch.empty());
+        CHECK(lMoved.getTriangleCount() == 2);
+    }
+
+}
+
+TEST_SUITE("RLCircleBatch") {
+
+    TEST_CASE("Circles are collected and survive copies and moves") {
+        RLCharts::CircleBatch lBatch;
+        CHECK(lBatch.empty());
+        lBatch.add({10.0f, 10.0f}, 4.0f, RED);
+        lBatch.add({20.0f, 10.0f}, 0.0f, RED); // empty discs are dropped
+        lBatch.add({30.0f, 10.0f}, 6.0f, BLUE, 2.0f, BLACK);
+        CHECK(lBatch.size() == 2);
+
+        RLCharts::CircleBatch lCopy(lBatch);
+        CHECK(lCopy.size() == 2);
+        RLCharts::CircleBatch lMoved(std::move(lCopy));
+        CHECK(lMoved.size() == 2);
+        lMoved = lBatch;
+        CHECK(lMoved.size() == 2);
+
+        lBatch.clear();
+        CHECK(lBatch.empty());
+        CHECK(lMoved.size() == 2);
+    }
+
+    TEST_CASE("Instancing can be turned off") {
+        RLCharts::CircleBatch lBatch;
+        CHECK(lBatch.isInstancingEnabled());
+        lBatch.setInstancing(false);
+        lBatch.add({10.0f, 10.0f}, 4.0f, RED, 1.0f, BLACK);
+        CHECK_FALSE(lBatch.wasInstanced());
+        std::vector<RLCharts::CircleBatch> lBatches(3, lBatch);
+        lBatches.emplace_back();
+        CHECK(lBatches[2].size() == 1);
+        CHECK_FALSE(lBatches[2].isInstancingEnabled());
+    }
+}
+
+TEST_SUITE("RLRectBatch") {
+
+    TEST_CASE("Rectangles are collected and survive copies and moves") {
+        RLCharts::RectBatch lBatch;
+        CHECK(lBatch.empty());
+        lBatch.add({0.0f, 0.0f, 4.0f, 10.0f}, RED);
+        lBatch.add({4.0f, 0.0f, 0.0f, 10.0f}, RED); // empty rectangles are dropped
+        lBatch.add({8.0f, 5.0f, 4.0f, 5.0f}, BLUE);
+        CHECK(lBatch.size() == 2);
+
+        RLCharts::RectBatch lCopy(lBatch);
+        RLCharts::RectBatch lMoved(std::move(lCopy));
+        CHECK(lMoved.size() == 2);
+        lMoved.setInstancing(false);
+        lMoved = lBatch;
+        CHECK(lMoved.isInstancingEnabled());
+
+        lBatch.clear();
+        CHECK(lBatch.empty());
+        CHECK(lMoved.size() == 2);
+        CHECK_FALSE(lMoved.wasInstanced());
+    }
+}
+
+TEST_SUITE("RLSpscRing") {
+
+    TEST_CASE("Capacity, full and wrap-around consume") {
+        RLCharts::SpscRing<int> lRing(5);
+        CHECK(lRing.capacity() == 8);
+
+        for (int i = 0; i < 8; i++) {
+            CHECK(lRing.push(i));
+        }
+        CHECK_FALSE(lRing.push(8));
+
+        int lOut[4] = {};
+        CHECK(lRing.pop(lOut, 4) == 4);
+        CHECK(lOut[3] == 3);
+
+        const int lMore[] = {8, 9, 10, 11, 12};
+        CHECK(lRing.push(lMore, 5) == 4);
+
+        // Remaining values arrive in order across the wrap
+        int lExpected = 4;
+        bool lInOrder = true;
+        const size_t lConsumed = lRing.consume([&](const int* pData, size_t aCount) {
+            for (size_t i = 0; i < aCount; i++) {
+                lInOrder = lInOrder && pData[i] == lExpected++;
+            }
+        });
+        CHECK(lConsumed == 8);
+        CHECK(lInOrder);
+        CHECK(lRing.empty());
+    }
+
+}
+
+TEST_SUITE("RLRingQueue") {
+
+    TEST_CASE("Positions survive growth, wrap and trimming at both ends") {
+        RLCharts::RingQueue<int> lQueue;
+        for (int i = 0; i < 10; i++) {
+            lQueue.pushBack(i);
+        }
+        lQueue.popFront(6);
+        const uint64_t lMark = lQueue.getEndPos();
+        for (int i = 10; i < 30; i++) {
+            lQueue.pushBack(i); // wraps, then grows past 16
+        }
+        CHECK(lQueue.size() == 24);
+        CHECK(lQueue.front() == 6);
+        CHECK(lQueue.at(lMark) == 10);
+
+        lQueue.truncate(lMark + 2);
+        CHECK(lQueue.back() == 11);
+        lQueue.dropBefore(lMark);
+        lQueue.pushFront(-1);
+        CHECK(lQueue.size() == 3);
+        CHECK(lQueue[0] == -1);
+        CHECK(lQueue[2] == 11);
+
+        // The two runs hold the elements in order
+        std::vector<int> lRuns;
+        const int* pRun = nullptr;
+        const size_t lFirst = lQueue.firstRun(pRun);
+        lRuns.insert(lRuns.end(), pRun, pRun + lFirst);
+        const size_t lSecond = lQueue.secondRun(pRun);
+        if (lSecond > 0) {
+            lRuns.insert(lRuns.end(), pRun, pRun + lSecond);
+        }
+        CHECK(lRuns == std::vector<int>{-1, 10, 11});
+    }
+
+    TEST_CASE("clear keeps the storage") {
+        RLCharts::RingQueue<int> lQueue;
+        lQueue.reserve(100);
+        for (int lRound = 0; lRound < 4; lRound++) {
+            for (int i = 0; i < 100; i++) {
+                lQueue.pushBack(i);
+            }
+            CHECK(lQueue.size() == 100);
+            lQueue.clear();
+            CHECK(lQueue.empty());
+        }
+    }
+}
+
+TEST_SUITE("RLSimd") {
+
+    TEST_CASE("Vectorized LUT colorization matches scalar reference") {
+        uint32_t lLut[256];
+        for (uint32_t i = 0; i < 256; i++) {
+            lLut[i] = 0xFF000000u | (i << 16) | ((255u - i) << 8) | (i / 2u);
+        }
+
+        // Odd length exercises the scalar tail; values cover below-zero, in-range and saturated
+        std::vector<float> lValues(1027);
+        for (size_t i = 0; i < lValues.size(); i++) {
+            lValues[i] = (float)((int)(i * 37u % 301u) - 20) * 0.5f;
+        }
+
+        std::vector<uint32_t> lSimd(lValues.size());
+        std::vector<uint32_t> lScalar(lValues.size());
+        const float lInvMax = 1.0f / 120.0f;
+        RLCharts::colorizeLut(lValues.data(), lSimd.data(), lValues.size(), lInvMax, lLut);
+        RLCharts::colorizeLutScalar(lValues.data(), lScalar.data(), lValues.size(), lInvMax, lLut);
+
+        CHECK(lSimd == lScalar);
+        CHECK(lScalar[0] == lLut[0]);                             // -10 clamps to index 0
+        CHECK(lScalar[8] == lLut[255]);                           // 138 > max saturates
+        CHECK(RLCharts::simdName() != nullptr);
+    }
+
+    TEST_CASE("Vectorized approachArray matches scalar reference and reports settling") {
+        // Odd length exercises the scalar tail
+        std::vector<float> lTarget(1027);
+        std::vector<float> lSimd(lTarget.size());
+        for (size_t i = 0; i < lTarget.size(); i++) {
+            lTarget[i] = (float)(i % 13u) * 0.75f;
+            lSimd[i] = (float)(i % 7u) - 2.0f;
+        }
+        std::vector<float> lScalar = lSimd;
+
+        bool lSimdSettled = RLCharts::approachArray(lSimd.data(), lTarget.data(), lSimd.size(), 0.3f);
+        bool lScalarSettled = RLCharts::approachArrayScalar(lScalar.data(), lTarget.data(), lScalar.size(), 0.3f);
+        CHECK_FALSE(lSimdSettled);
+        CHECK_FALSE(lScalarSettled);
+        for (size_t i = 0; i < lSimd.size(); i++) {
+            CHECK(lSimd[i] == doctest::Approx(lScalar[i]));
+        }
+
+        // Full speed lands on the targets; the next step reports settled
+        RLCharts::approachArray(lSimd.data(), lTarget.data(), lSimd.size(), 1.0f);
+        CHECK(RLCharts::approachArray(lSimd.data(), lTarget.data(), lSimd.size(), 0.3f));
+        CHECK(lSimd == lTarget);
+
+        // One moving element in the vector body or in the tail is detected
+        lSimd[5] += 1.0f;
+        CHECK_FALSE(RLCharts::approachArray(lSimd.data(), lTarget.data(), lSimd.size(), 0.5f));
+        lSimd[5] = lTarget[5];
+        lSimd[1026] -= 1.0f;
+        CHECK_FALSE(RLCharts::approachArray(lSimd.data(), lTarget.data(), lSimd.size(), 0.5f));
+    }
+
+    TEST_CASE("Vectorized PCM block statistics match scalar reference") {
+        // 7 channels: one vector group plus a scalar tail
+        const size_t lChannels = 7;
+        const size_t lFrames = 257;
+        std::vector<float> lPcm(lChannels * lFrames);
+        for (size_t f = 0; f < lFrames; f++) {
+            for (size_t c = 0; c < lChannels; c++) {
+                lPcm[f * lChannels + c] = sinf((float)f * 0.05f * (float)(c + 1)) * 0.1f * (float)(c + 1);
+            }
+        }
+
+        std::vector<float> lSimd(3 * lChannels, 0.0f);
+        std::vector<float> lScalar(3 * lChannels, 0.0f);
+        std::vector<float> lSimdHistory(3 * lChannels, 0.0f);
+        std::vector<float> lScalarHistory(3 * lChannels, 0.0f);
+        // Two blocks so the interpolation history is carried across the boundary
+        for (size_t lBlock = 0; lBlock < 2; lBlock++) {
+            const float* pBlock = lPcm.data() + lBlock * 128 * lChannels;
+            const size_t lCount = lBlock == 0 ? 128 : lFrames - 128;
+            RLCharts::pcmBlockStats(pBlock, lCount, lChannels, lSimd.data(), lSimd.data() + lChannels,
+                                    lSimd.data() + 2 * lChannels, lSimdHistory.data());
+            RLCharts::pcmBlockStatsScalar(pBlock, lCount, lChannels, 0, lScalar.data(), lScalar.data() + lChannels,
+                                          lScalar.data() + 2 * lChannels, lScalarHistory.data());
+        }
+        for (size_t i = 0; i < lSimd.size(); i++) {
+            CHECK(lSimd[i] == doctest::Approx(lScalar[i]));
+        }
+        CHECK(lSimdHistory == lScalarHistory);
+
+        for (size_t c = 0; c < lChannels; c++) {
+            float lPeak = 0.0f;
+            for (size_t f = 0; f < lFrames; f++) {
+                lPeak = std::max(lPeak, fabsf(lPcm[f * lChannels + c]));
+            }
+            CHECK(lScalar[lChannels + c] == doctest::Approx(lPeak));
+            CHECK(lScalar[2 * lChannels + c] >= lScalar[lChannels + c]);   // True peak never below sample peak
+        }
+
+        // A full-scale square wave at Nyquist/2 overshoots between samples
+        std::vector<float> lSquare = { 1.0f, 1.0f, -1.0f, -1.0f, 1.0f, 1.0f, -1.0f, -1.0f };
+        float lSumSq = 0.0f, lPeak = 0.0f, lTruePeak = 0.0f;
+        float lHistory[3] = { 0.0f, 0.0f, 0.0f };
+        RLCharts::pcmBlockStats(lSquare.data(), lSquare.size(), 1, &lSumSq, &lPeak, &lTruePeak, lHistory);
+        CHECK(lSumSq == doctest::Approx(8.0f));
+        CHECK(lPeak == doctest::Approx(1.0f));
+        CHECK(lTruePeak > 1.0f);
+    }
+
+    TEST_CASE("Vectorized min/max and scale-offset match scalar reference") {
+        // Odd length exercises the scalar tail; the extremes sit in the vector body and in the tail
+        std::vector<float> lValues(1027);
+        for (size_t i = 0; i < lValues.size(); i++) {
+            lValues[i] = sinf((float)i * 0.1f) * 3.0f;
+        }
+        lValues[9] = -7.5f;
+        lValues[1025] = 8.25f;
+
+        float lSimdMin = lValues[500], lSimdMax = lValues[500];
+        float lScalarMin = lValues[500], lScalarMax = lValues[500];
+        RLCharts::minMax(lValues.data(), lValues.size(), lSimdMin, lSimdMax);
+        RLCharts::minMaxScalar(lValues.data(), lValues.size(), lScalarMin, lScalarMax);
+        CHECK(lSimdMin == -7.5f);
+        CHECK(lSimdMax == 8.25f);
+        CHECK(lSimdMin == lScalarMin);
+        CHECK(lSimdMax == lScalarMax);
+
+        // The seed takes part; an empty range leaves it alone
+        float lMin = -100.0f, lMax = 100.0f;
+        RLCharts::minMax(lValues.data(), 3, lMin, lMax);
+        CHECK(lMin == -100.0f);
+        CHECK(lMax == 100.0f);
+        lMin = lMax = 1.0f;
+        RLCharts::minMax(lValues.data(), 0, lMin, lMax);
+        CHECK(lMin == 1.0f);
+        CHECK(lMax == 1.0f);
+
+        std::vector<float> lSimd(lValues.size());
+        std::vector<float> lScalar(lValues.size());
+        RLCharts::scaleOffset(lValues.data(), lSimd.data(), lValues.size(), -12.5f, 300.0f);
+        RLCharts::scaleOffsetScalar(lValues.data(), lScalar.data(), lValues.size(), -12.5f, 300.0f);
+        for (size_t i = 0; i < lSimd.size(); i++) {
+            CHECK(lSimd[i] == doctest::Approx(lScalar[i]));
+        }
+        CHECK(lScalar[9] == doctest::Approx(393.75f));
+
+        // In place
+        RLCharts::scaleOffset(lSimd.data(), lSimd.data(), lSimd.size(), 2.0f, -1.0f);
+        CHECK(lSimd[1025] == doctest::Approx(8.25f * -12.5f * 2.0f + 599.0f));
+    }
+
+    TEST_CASE("Vectorized point binning matches scalar reference") {
+        // Interleaved x, y; edges, out-of-range and NaN points sit in the vector body and the tail
+        std::vector<float> lXY(2 * 1031);
+        for (size_t i = 0; i < lXY.size() / 2; i++) {
+            lXY[2 * i] = sinf((float)i * 0.37f) * 1.1f;
+            lXY[2 * i + 1] = cosf((float)i * 0.23f) * 0.9f;
+        }
+        lXY[0] = -1.0f;
+        lXY[1] = 1.0f;
+        lXY[2] = 1.0f;
+        lXY[3] = -1.0f;
+        lXY[5] = std::numeric_limits<float>::quiet_NaN();
+        lXY[2 * 1030] = 1.5f;
+
+        const int lGrids[][2] = { { 1, 1 }, { 7, 5 }, { 640, 480 } };
+        for (const auto& rGrid : lGrids) {
+            std::vector<int32_t> lSimd(lXY.size() / 2);
+            std::vector<int32_t> lScalar(lXY.size() / 2);
+            int32_t lSimdBounds[4] = { INT32_MAX, INT32_MAX, -1, -1 };
+            int32_t lScalarBounds[4] = { INT32_MAX, INT32_MAX, -1, -1 };
+            RLCharts::normalizedToCells(lXY.data(), lSimd.size(), rGrid[0], rGrid[1], lSimd.data(), lSimdBounds);
+            RLCharts::normalizedToCellsScalar(lXY.data(), lScalar.size(), rGrid[0], rGrid[1], lScalar.data(),
+                                              lScalarBounds);
+            CHECK(lSimd == lScalar);
+            for (int b = 0; b < 4; b++) {
+                CHECK(lSimdBounds[b] == lScalarBounds[b]);
+            }
+            // Corners land in the corner cells (row 0 is the top)
+            CHECK(lScalar[0] == 0);
+            CHECK(lScalar[1] == rGrid[0] * rGrid[1] - 1);
+            CHECK(lScalar[2] == -1);
+            CHECK(lScalar[1030] == -1);
+            CHECK(lScalarBounds[0] == 0);
+            CHECK(lScalarBounds[3] == rGrid[1] - 1);
+        }
+
+        // No valid point leaves the bounds alone
+        const float lOutside[8] = { 2.0f, 0.0f, -3.0f, 0.0f, 0.0f, 5.0f, 0.0f, -5.0f };
+        int32_t lCells[4];
+        int32_t lBounds[4] = { INT32_MAX, INT32_MAX, -1, -1 };
+        RLCharts::normalizedToCells(lOutside, 4, 8, 8, lCells, lBounds);
+        CHECK(lCells[3] == -1);
+        CHECK(lBounds[2] == -1);
+    }
+
+}
+
+TEST_SUITE("RLColormap") {
+
+    TEST_CASE("Stop LUT hits the stops and interpolates between them") {
+        const Color lStops[3] = { {0, 0, 0, 255}, {200, 100, 0, 255}, {0, 50, 250, 0} };
+        Color lLut[256];
+        RLCharts::buildStopLut(lStops, 3, lLut, 256);
+        CHECK(RLCharts::colorEquals(lLut[0], lStops[0]));
+        CHECK(RLCharts::colorEquals(lLut[255], lStops[2]));
+        CHECK(lLut[64].r == 100);
+        CHECK(lLut[64].g == 50);
+        CHECK(lLut[128].r > lLut[191].r);
+        CHECK(lLut[255].a == 0);
+
+        // A single stop fills the table
+        RLCharts::buildStopLut(lStops + 1, 1, lLut, 256);
+        CHECK(RLCharts::colorEquals(lLut[17], lStops[1]));
+    }
+
+    TEST_CASE("Presets are built at compile time and match the runtime expansion") {
+        constexpr auto VIRIDIS = RLCharts::makePresetLut<RLCharts::COLORMAP_LUT_SIZE>(RLCharts::ColormapPreset::VIRIDIS);
+        static_assert(VIRIDIS[0].r == 68 && VIRIDIS[0].g == 1 && VIRIDIS[0].b == 84);
+        static_assert(VIRIDIS[255].r == 253 && VIRIDIS[255].g == 231 && VIRIDIS[255].b == 37);
+
+        const RLCharts::ColormapPreset lPresets[] = {
+            RLCharts::ColormapPreset::VIRIDIS, RLCharts::ColormapPreset::MAGMA, RLCharts::ColormapPreset::INFERNO,
+            RLCharts::ColormapPreset::PLASMA, RLCharts::ColormapPreset::CIVIDIS, RLCharts::ColormapPreset::TURBO,
+            RLCharts::ColormapPreset::GRAYSCALE
+        };
+        for (RLCharts::ColormapPreset lPreset : lPresets) {
+            const Color* pShared = RLCharts::presetLut(lPreset);
+            CHECK(pShared == RLCharts::presetLut(lPreset));
+            const RLCharts::ColormapStops lStops = RLCharts::colormapStops(lPreset);
+            Color lRuntime[256];
+            RLCharts::buildStopLut(lStops.data(), lStops.size(), lRuntime, 256);
+            for (size_t i = 0; i < 256; i++) {
+                CHECK(RLCharts::colorEquals(pShared[i], lRuntime[i]));
+            }
+        }
+
+        // The perceptual maps brighten monotonically (sum of channels as a luminance proxy)
+        const Color* pMagma = RLCharts::presetLut(RLCharts::ColormapPreset::MAGMA);
+        for (size_t i = 1; i < 256; i++) {
+            CHECK(pMagma[i].r + pMagma[i].g + pMagma[i].b >= pMagma[i - 1].r + pMagma[i - 1].g + pMagma[i - 1].b);
+        }
+    }
+
+    TEST_CASE("High-resolution colormap") {
+        RLCharts::Colormap lMap(RLCharts::ColormapPreset::VIRIDIS, RLCharts::COLORMAP_HIRES_LUT_SIZE);
+        CHECK(lMap.size() == 4096);
+        CHECK(RLCharts::colorEquals(lMap.sample(0.0f), RLCharts::presetLut(RLCharts::ColormapPreset::VIRIDIS)[0]));
+        CHECK(RLCharts::colorEquals(lMap.sample(2.0f), RLCharts::presetLut(RLCharts::ColormapPreset::VIRIDIS)[255]));
+
+        // Finer steps: neighbouring entries differ by at most one level per channel
+        for (size_t i = 1; i < lMap.size(); i++) {
+            CHECK(std::abs((int)lMap.data()[i].g - (int)lMap.data()[i - 1].g) <= 1);
+        }
+
+        lMap.setResolution(256);
+        CHECK(lMap.size() == 256);
+        RLCharts::Colormap lCustom(std::vector<Color>{ {0, 0, 0, 255}, {255, 255, 255, 255} });
+        CHECK(lCustom.getStops().size() == 2);
+        CHECK(lCustom.sample(0.5f).r >= 127);
+    }
+
+}
+
+TEST_SUITE("RLFrameArena") {
+
+    TEST_CASE("Steady-state frames do not allocate") {
+        RLCharts::FrameArena lArena(1024);
+        auto lFrame = [&](size_t aCount) {
+            lArena.reset();
+            std::pmr::vector<float> lA(&lArena);
+            std::pmr::vector<double> lB(&lArena);
+            for (size_t i = 0; i < aCount; i++) {
+                lA.push_back((float)i);
+                lB.push_back((double)i);
+            }
+            CHECK(lA[aCount - 1] == (float)(aCount - 1));
+            CHECK(((uintptr_t)lB.data() % alignof(double)) == 0);
+        };
+
+        // The first frame spills over several chunks, the next one merges them
+        lFrame(4096);
+        CHECK(lArena.getHeapAllocations() > 1);
+        lFrame(4096);
+        lFrame(4096);
+        CHECK(lArena.getLastFrameHeapAllocations() == 0);
+        CHECK(lArena.getLastFrameBytes() >= 4096 * (sizeof(float) + sizeof(double)));
+
+        const size_t lTotal = lArena.getHeapAllocations();
+        for (int i = 0; i < 10; i++) {
+            lFrame(1000 + (size_t)i * 100);
+        }
+        CHECK(lArena.getHeapAllocations() == lTotal);
+    }
+
+    TEST_CASE("Scratch scopes rewind on exit") {
+        RLCharts::beginFrame();
+        RLCharts::FrameArena& rArena = RLCharts::frameArena();
+        const RLCharts::FrameArena::Marker lStart = rArena.mark();
+        {
+            RLCharts::FrameScratch lScratch;
+            std::pmr::vector<int> lValues(256, 7, lScratch.resource());
+            {
+                RLCharts::FrameScratch lInner;
+                std::pmr::vector<int> lMore(64, 1, lInner.resource());
+                CHECK(rArena.mark().mOffset > lStart.mOffset);
+            }
+            CHECK(lValues[255] == 7);
+        }
+        CHECK(rArena.mark().mChunk == lStart.mChunk);
+        CHECK(rArena.mark().mOffset == lStart.mOffset);
+
+        // Every thread has its own arena
+        const RLCharts::FrameArena* pMain = &RLCharts::frameArena();
+        const RLCharts::FrameArena* pOther = nullptr;
+        std::thread lWorker([&]() { pOther = &RLCharts::frameArena(); });
+        lWorker.join();
+        CHECK(pOther != pMain);
+    }
+
+}
+
+TEST_SUITE("RLGpuStaging") {
+
+    TEST_CASE("Staged memory stays put while the list grows") {
+        RLCharts::UploadList lList;
+        Texture2D lTexture{};
+        Mesh lMesh{};
+        for (int lFrame = 0; lFrame < 3; lFrame++) {
+            // Several uploads taken before any is written, then far more bytes
+            // than the first block holds
+            auto* pFirst = static_cast<uint32_t*>(lList.texture(&lTexture, 64 * sizeof(uint32_t)));
+            auto* pSecond = static_cast<float*>(lList.meshBuffer(&lMesh, 0, 300000 * sizeof(float)));
+            std::vector<unsigned char*> lMore;
+            for (int i = 0; i < 40; i++) {
+                lMore.push_back(static_cast<unsigned char*>(lList.meshBuffer(&lMesh, 3, 100000)));
+            }
+            for (uint32_t i = 0; i < 64; i++) {
+                pFirst[i] = i * 7u + (uint32_t)lFrame;
+            }
+            for (size_t i = 0; i < 300000; i++) {
+                pSecond[i] = (float)i;
+            }
+            for (size_t i = 0; i < lMore.size(); i++) {
+                std::memset(lMore[i], (int)i, 100000);
+            }
+            CHECK(((uintptr_t)pFirst & 15u) == 0);
+            CHECK(((uintptr_t)pSecond & 15u) == 0);
+            for (uint32_t i = 0; i < 64; i++) {
+                REQUIRE(pFirst[i] == i * 7u + (uint32_t)lFrame);
+            }
+            CHECK(pSecond[299999] == 299999.0f);
+            CHECK(lMore[39][99999] == 39);
+            CHECK(lList.getByteCount() == 64 * sizeof(uint32_t) + 300000 * sizeof(float) + 40 * 100000);
+            lList.clear();
+            CHECK(lList.empty());
+            CHECK(lList.getByteCount() == 0);
+        }
+    }
+
+    TEST_CASE("A cleared list reuses its blocks") {
+        RLCharts::UploadList lList;
+        Texture2D lTexture{};
+        void* pFirst = nullptr;
+        for (int lFrame = 0; lFrame < 4; lFrame++) {
+            void* pData = lList.texture(&lTexture, 1 << 20);
+            lList.texture(&lTexture, 1000);
+            if (lFrame == 0) {
+                pFirst = pData;
+            }
+            CHECK(pData == pFirst);
+            lList.clear();
+        }
+    }
+
+}
+
+TEST_SUITE("RLTaskPool") {
+
+    TEST_CASE("parallelFor runs every index exactly once") {
+        RLCharts::TaskPool lPool(4);
+        CHECK(lPool.getThreadCount() == 4);
+        std::vector<std::atomic<int>> lHits(1000);
+        for (int lRound = 0; lRound < 20; ++lRound) {
+            lPool.parallelFor(lHits.size(), [&](size_t i) { lHits[i].fetch_add(1); });
+        }
+        bool lAllTwenty = true;
+        for (const std::atomic<int>& rHit : lHits) {
+            lAllTwenty = lAllTwenty && rHit.load() == 20;
+        }
+        CHECK(lAllTwenty);
+        lPool.parallelFor(0, [](size_t) {});
+    }
+
+    TEST_CASE("Idle threads steal from a slow queue") {
+        RLCharts::TaskPool lPool(4);
+        std::atomic<size_t> lDone{ 0 };
+        // Task 0 blocks its thread; the other tasks dealt to it must be stolen
+        lPool.parallelFor(64, [&](size_t i) {
+            if (i == 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            }
+            lDone.fetch_add(1);
+        });
+        CHECK(lDone.load() == 64);
+        CHECK(lPool.getStealCount() > 0);
+    }
+
+    TEST_CASE("Nested calls run serially and exceptions reach the caller") {
+        RLCharts::TaskPool lPool(3);
+        std::atomic<int> lInner{ 0 };
+        lPool.parallelFor(4, [&](size_t) {
+            lPool.parallelFor(5, [&](size_t) { lInner.fetch_add(1); });
+        });
+        CHECK(lInner.load() == 20);
+
+        bool lCaught = false;
+        try {
+            lPool.parallelFor(8, [](size_t i) {
+                if (i == 5) {
+                    throw std::runtime_error("task failed");
+                }
+            });
+        } catch (const std::runtime_error&) {
+            lCaught = true;
+        }
+        CHECK(lCaught);
+        // The pool stays usable
+        std::atomic<int> lCount{ 0 };
+        lPool.parallelFor(8, [&](size_t) { lCount.fetch_add(1); });
+        CHECK(lCount.load() == 8);
+    }
+
+}
+
+TEST_SUITE("RLPerf") {
+
+    TEST_CASE("Timer tracks last, max and moving average") {
+        RLCharts::PerfTimer lTimer;
+        lTimer.record(2.0f);
+        CHECK(lTimer.mEmaMs == doctest::Approx(2.0f));
+        lTimer.record(8.0f);
+        lTimer.record(1.0f);
+        CHECK(lTimer.mLastMs == doctest::Approx(1.0f));
+        CHECK(lTimer.mMaxMs == doctest::Approx(8.0f));
+        CHECK(lTimer.mEmaMs > 2.0f);
+        CHECK(lTimer.mEmaMs < 8.0f);
+        CHECK(lTimer.mCount == 3);
+    }
+
+    TEST_CASE("Frame counters close on endFrame") {
+        RLCharts::PerfStats lStats;
+        lStats.addUpload(100);
+        lStats.addUpload(28);
+        lStats.mPendingDrawCalls += 3;
+        lStats.endFrame();
+        CHECK(lStats.mUploadBytes == 128);
+        CHECK(lStats.mDrawCalls == 3);
+
+        lStats.addUpload(4);
+        lStats.endFrame();
+        CHECK(lStats.mUploadBytes == 4);
+        CHECK(lStats.mDrawCalls == 0);
+        CHECK(lStats.mUploadBytesTotal == 132);
+    }
+
+    TEST_CASE("Scopes are recorded into the trace while it runs") {
+        RLCharts::PerfTrace& rTrace = RLCharts::PerfTrace::instance();
+        RLCharts::PerfStats lStats;
+        rTrace.start();
+        {
+            RLCharts::PerfScope lScope(lStats.mUpdate, "test::update");
+        }
+        {
+            RLCharts::PerfFrameScope lScope(lStats, "test::draw");
+        }
+        rTrace.stop();
+        {
+            RLCharts::PerfScope lScope(lStats.mUpdate, "test::ignored");
+        }
+        CHECK(rTrace.getEventCount() == 2);
+        CHECK(lStats.mUpdate.mCount == 2);
+        CHECK(lStats.mDraw.mCount == 1);
+    }
+
+}
+
+TEST_SUITE("RLSlidingExtrema") {
+
+    TEST_CASE("Window extrema match a rescan") {
+        RLCharts::SlidingExtrema<float> lExtrema;
+        std::vector<float> lLows;
+        std::vector<float> lHighs;
+        size_t lHead = 0;
+        uint32_t lSeed = 99u;
+        for (int i = 0; i < 2000; i++) {
+            lSeed = lSeed * 1664525u + 1013904223u;
+            const float lLow = (float)((lSeed >> 8) % 1000u);
+            const float lHigh = lLow + (float)((lSeed >> 20) % 50u);
+            lExtrema.push(lLow, lHigh);
+            lLows.push_back(lLow);
+            lHighs.push_back(lHigh);
+            // Variable window: mostly 1 in, 1 out, sometimes 2 out
+            const size_t lPops = (lSeed & 7u) == 0 ? 2 : (lLows.size() - lHead > 64 ? 1 : 0);
+            for (size_t p = 0; p < lPops && lHead < lLows.size(); p++) {
+                lExtrema.popFront();
+                lHead++;
+            }
+            REQUIRE(lExtrema.size() == lLows.size() - lHead);
+            if (lExtrema.empty()) {
+                continue;
+            }
+            CHECK(lExtrema.getMin() == *std::min_element(lLows.begin() + (std::ptrdiff_t)lHead, lLows.end()));
+            CHECK(lExtrema.getMax() == *std::max_element(lHighs.begin() + (std::ptrdiff_t)lHead, lHighs.end()));
+        }
+    }
+
+    TEST_CASE("Equal values and clear") {
+        RLCharts::SlidingExtrema<int> lExtrema;
+        lExtrema.push(5);
+        lExtrema.push(5);
+        lExtrema.push(3);
+        lExtrema.popFront();
+        CHECK(lExtrema.getMax() == 5);
+        CHECK(lExtrema.getMin() == 3);
+        lExtrema.popFront();
+        CHECK(lExtrema.getMax() == 3);
+        lExtrema.popFront();
+        CHECK(lExtrema.empty());
+        lExtrema.popFront(); // no-op when empty
+        lExtrema.push(7);
+        lExtrema.clear();
+        CHECK(lExtrema.size() == 0);
+    }
+
+    TEST_CASE("Queues grow while wrapped around") {
+        // Ascending values keep the whole window in the min queue; the window
+        // widens from 8 to 200 while the queue's front has moved past its start
+        RLCharts::SlidingExtrema<int> lExtrema;
+        int lHead = 0;
+        int lNext = 0;
+        for (size_t lWindow = 8; lWindow <= 200; lWindow += 24) {
+            for (int i = 0; i < 50; i++) {
+                lExtrema.push(lNext++);
+                while (lExtrema.size() > lWindow) {
+                    lExtrema.popFront();
+                    lHead++;
+                }
+                REQUIRE(lExtrema.getMin() == lHead);
+                REQUIRE(lExtrema.getMax() == lNext - 1);
+            }
+        }
+        // Descending values do the same to the max queue
+        lExtrema.clear();
+        for (int i = 0; i < 300; i++) {
+            lExtrema.push(-i);
+            if (lExtrema.size() > 100) {
+                lExtrema.popFront();
+            }
+            REQUIRE(lExtrema.getMax() == -(i - (int)lExtrema.size() + 1));
+            REQUIRE(lExtrema.getMin() == -i);
+        }
+    }
+
 }
 
+TEST_SUITE("RLSpatialGrid") {
+
+    TEST_CASE("Nearest matches a brute-force scan") {
+        std::vector<Vector2> lPoints;
+        uint32_t lSeed = 7u;
+        for (int i = 0; i < 3000; i++) {
+            lSeed = lSeed * 1664525u + 1013904223u;
+            const float lX = (float)((lSeed >> 8) % 1000u) * 0.5f;
+            lSeed = lSeed * 1664525u + 1013904223u;
+            const float lY = (float)((lSeed >> 8) % 1000u) * 0.3f;
+            lPoints.push_back({ lX, lY });
+        }
+        // Some points beyond the area still have to be found
+        lPoints.push_back({ -40.0f, -40.0f });
+        lPoints.push_back({ 900.0f, 200.0f });
+
+        RLCharts::SpatialGrid lGrid;
+        lGrid.build({ 0.0f, 0.0f, 500.0f, 300.0f }, 12.0f, lPoints.size(),
+                    [&lPoints](size_t aIndex) { return lPoints[aIndex]; });
+        CHECK(lGrid.size() == lPoints.size());
+
+        const auto lGet = [&lPoints](uint32_t aIndex) { return lPoints[aIndex]; };
+        const auto lAll = [](uint32_t) { return true; };
+        for (int q = 0; q < 200; q++) {
+            lSeed = lSeed * 1664525u + 1013904223u;
+            const Vector2 lQuery{ (float)((lSeed >> 8) % 600u) - 50.0f, (float)((lSeed >> 20) % 400u) - 50.0f };
+            const float lMaxDistance = (q % 2 == 0) ? 25.0f : 1000.0f;
+            size_t lExpected = (size_t)-1;
+            float lBestD2 = lMaxDistance * lMaxDistance;
+            for (size_t i = 0; i < lPoints.size(); i++) {
+                const float lDx = lPoints[i].x - lQuery.x;
+                const float lDy = lPoints[i].y - lQuery.y;
+                if (lDx * lDx + lDy * lDy <= lBestD2) {
+                    lBestD2 = lDx * lDx + lDy * lDy;
+                    lExpected = i;
+                }
+            }
+            float lDistance = 0.0f;
+            const uint32_t lFound = lGrid.nearest(lQuery, lMaxDistance, lGet, lAll, lDistance);
+            if (lExpected == (size_t)-1) {
+                CHECK(lFound == RLCharts::SpatialGrid::NONE);
+                continue;
+            }
+            REQUIRE(lFound != RLCharts::SpatialGrid::NONE);
+            // Ties may resolve to another point at the same distance
+            CHECK(lDistance == doctest::Approx(std::sqrt(lBestD2)));
+        }
+
+        float lDistance = 0.0f;
+        CHECK(lGrid.nearest({ -45.0f, -40.0f }, 10.0f, lGet, lAll, lDistance) == lPoints.size() - 2);
+        CHECK(lDistance == doctest::Approx(5.0f));
+        // Rejected items are skipped
+        const uint32_t lNext = lGrid.nearest({ -45.0f, -40.0f }, 1000.0f, lGet,
+                                             [&lPoints](uint32_t aIndex) { return aIndex != lPoints.size() - 2; },
+                                             lDistance);
+        CHECK(lNext != lPoints.size() - 2);
+        CHECK(lNext != RLCharts::SpatialGrid::NONE);
+    }
+
+    TEST_CASE("Rect query covers the items inside it") {
+        std::vector<Vector2> lPoints;
+        for (int y = 0; y < 20; y++) {
+            for (int x = 0; x < 20; x++) {
+                lPoints.push_back({ (float)x * 10.0f + 5.0f, (float)y * 10.0f + 5.0f });
+            }
+        }
+        RLCharts::SpatialGrid lGrid;
+        lGrid.build({ 0.0f, 0.0f, 200.0f, 200.0f }, 16.0f, lPoints.size(),
+                    [&lPoints](size_t aIndex) { return lPoints[aIndex]; });
+        const Rectangle lRect{ 42.0f, 61.0f, 50.0f, 30.0f };
+        size_t lInside = 0;
+        size_t lVisited = 0;
+        lGrid.forEachInRect(lRect, [&](uint32_t aIndex) {
+            lVisited++;
+            lInside += CheckCollisionPointRec(lPoints[aIndex], lRect) ? 1 : 0;
+        });
+        CHECK(lInside == 15); // 5 columns x 3 rows
+        CHECK(lVisited < lPoints.size() / 4);
+
+        lGrid.clear();
+        CHECK(lGrid.empty());
+        float lDistance = 0.0f;
+        CHECK(lGrid.nearest({ 5.0f, 5.0f }, 100.0f, [&lPoints](uint32_t aIndex) { return lPoints[aIndex]; },
+                            [](uint32_t) { return true; }, lDistance) == RLCharts::SpatialGrid::NONE);
+    }
+
+}
+
+TEST_SUITE("RLSpline") {
+
+    // Largest distance from dense curve samples to the tessellated polyline of one segment
+    static float maxSegmentError(const Vector2* pCtl, const Vector2* pPts, size_t aCount) {
+        float lWorst = 0.0f;
+        for (int k = 0; k <= 200; k++) {
+            const Vector2 lC = RLCharts::catmullRom(pCtl[0], pCtl[1], pCtl[2], pCtl[3], (float)k / 200.0f);
+            float lBest = 1e30f;
+            for (size_t i = 0; i + 1 < aCount; i++) {
+                const Vector2 lA = pPts[i];
+                const Vector2 lB = pPts[i + 1];
+                const float lDx = lB.x - lA.x;
+                const float lDy = lB.y - lA.y;
+                const float lLen2 = lDx * lDx + lDy * lDy;
+                float lT = lLen2 > 0.0f ? ((lC.x - lA.x) * lDx + (lC.y - lA.y) * lDy) / lLen2 : 0.0f;
+                lT = RLCharts::clamp01(lT);
+                lBest = std::min(lBest, RLCharts::distance(lC, { lA.x + lDx * lT, lA.y + lDy * lT }));
+            }
+            lWorst = std::max(lWorst, lBest);
+        }
+        return lWorst;
+    }
+
+    TEST_CASE("Straight runs take one step, curves stay within tolerance") {
+        CHECK(RLCharts::splineSegmentSteps({ 0, 0 }, { 100, 50 }, { 200, 100 }, { 300, 150 }, 2.0f, 0.25f) == 1);
+        // End segments duplicate a control point but are still straight
+        CHECK(RLCharts::splineSegmentSteps({ 0, 0 }, { 0, 0 }, { 200, 100 }, { 400, 200 }, 2.0f, 0.25f) == 1);
+
+        const Vector2 lCtl[4] = { { 0, 200 }, { 100, 0 }, { 200, 200 }, { 300, 0 } };
+        const size_t lSteps = RLCharts::splineSegmentSteps(lCtl[0], lCtl[1], lCtl[2], lCtl[3], 1.0f, 0.25f);
+        CHECK(lSteps > 4);
+        std::vector<Vector2> lPts(lSteps + 1);
+        RLCharts::tessellateSplineSegment(lCtl[0], lCtl[1], lCtl[2], lCtl[3], lSteps, lPts.data());
+        lPts[lSteps] = lCtl[2];
+        CHECK(maxSegmentError(lCtl, lPts.data(), lPts.size()) <= 0.25f);
+        // The minimum spacing caps the step count
+        CHECK(RLCharts::splineSegmentSteps(lCtl[0], lCtl[1], lCtl[2], lCtl[3], 100.0f, 0.01f) <= 3);
+    }
+
+    static bool samePoints(const std::vector<Vector2>& rA, const std::vector<Vector2>& rB) {
+        return std::equal(rA.begin(), rA.end(), rB.begin(), rB.end(),
+                          [](const Vector2& rL, const Vector2& rR) { return rL.x == rR.x && rL.y == rR.y; });
+    }
+
+    TEST_CASE("Cache reuses unchanged segments") {
+        std::vector<Vector2> lPts;
+        for (int i = 0; i < 20; i++) {
+            lPts.push_back({ (float)i * 30.0f, (i % 2 == 0) ? 0.0f : 80.0f });
+        }
+        RLCharts::SplineCache lCache;
+        lCache.build(lPts.data(), lPts.size(), 2.0f, 0.25f);
+        CHECK(lCache.getSegmentCount() == 19);
+        CHECK(lCache.getReusedSegments() == 0);
+        CHECK(lCache.getPoints().front().x == doctest::Approx(lPts.front().x));
+        CHECK(lCache.getPoints().back().x == doctest::Approx(lPts.back().x));
+        const std::vector<Vector2> lFirst = lCache.getPoints();
+
+        lCache.build(lPts.data(), lPts.size(), 2.0f, 0.25f);
+        CHECK(lCache.getReusedSegments() == 19);
+        CHECK(samePoints(lCache.getPoints(), lFirst));
+
+        // Moving point 10 touches the four segments that use it as a control point
+        lPts[10].y += 15.0f;
+        lCache.build(lPts.data(), lPts.size(), 2.0f, 0.25f);
+        CHECK(lCache.getReusedSegments() == 15);
+        RLCharts::SplineCache lFresh;
+        lFresh.build(lPts.data(), lPts.size(), 2.0f, 0.25f);
+        CHECK(samePoints(lCache.getPoints(), lFresh.getPoints()));
+
+        // Appending changes the old last segment (its end control point) only
+        lPts.push_back({ 600.0f, 0.0f });
+        lCache.build(lPts.data(), lPts.size(), 2.0f, 0.25f);
+        CHECK(lCache.getReusedSegments() == 18);
+        CHECK(lCache.getSegmentCount() == 20);
+
+        lCache.build(lPts.data(), 1, 2.0f, 0.25f);
+        CHECK(lCache.getPoints().empty());
+    }
+
+}
+
+TEST_SUITE("RLOhlcPyramid") {
+
+    // Two days of 100 samples (the second day starts mid-way through a 15-sample bar)
+    void fillPyramid(RLCharts::OhlcPyramid& rPyramid, std::vector<float>& rCloses) {
+        uint32_t lSeed = 7u;
+        for (int i = 0; i < 200; i++) {
+            lSeed = lSeed * 1664525u + 1013904223u;
+            const float lClose = 100.0f + (float)((lSeed >> 16) % 1000u) * 0.01f;
+            rCloses.push_back(lClose);
+            rPyramid.add(lClose, lClose + 0.5f, lClose - 0.5f, lClose, 1.0f, i == 100);
+        }
+    }
+
+    TEST_CASE("Collected bars match direct aggregation") {
+        RLCharts::OhlcPyramid lPyramid;
+        std::vector<float> lCloses;
+        fillPyramid(lPyramid, lCloses);
+        CHECK(lPyramid.getSampleCount() == 200);
+        CHECK(lPyramid.getDayCount() == 2);
+
+        for (const uint32_t lPerBar : { 1u, 10u, 15u, 30u, 7u }) {
+            std::vector<RLCharts::OhlcBar> lBars;
+            lPyramid.collect(lPerBar, 1000, lBars);
+            // Per day: ceil(100 / n) bars
+            const size_t lPerDay = (100 + lPerBar - 1) / lPerBar;
+            REQUIRE(lBars.size() == 2 * lPerDay);
+            size_t lSample = 0;
+            for (const RLCharts::OhlcBar& rBar : lBars) {
+                const size_t lDayEnd = lSample < 100 ? 100 : 200;
+                const size_t lEnd = std::min(lSample + lPerBar, lDayEnd);
+                float lHigh = -1e30f;
+                for (size_t i = lSample; i < lEnd; i++) {
+                    lHigh = std::max(lHigh, lCloses[i] + 0.5f);
+                }
+                CHECK(rBar.mOpen == lCloses[lSample]);
+                CHECK(rBar.mClose == lCloses[lEnd - 1]);
+                CHECK(rBar.mHigh == lHigh);
+                CHECK(rBar.mCount == (uint32_t)(lEnd - lSample));
+                CHECK(rBar.mVolume == doctest::Approx((float)(lEnd - lSample)));
+                lSample = lEnd;
+            }
+        }
+    }
+
+    TEST_CASE("Daily bars and partial collection") {
+        RLCharts::OhlcPyramid lPyramid;
+        std::vector<float> lCloses;
+        fillPyramid(lPyramid, lCloses);
+
+        std::vector<RLCharts::OhlcBar> lDays;
+        lPyramid.collect(0, 10, lDays);
+        REQUIRE(lDays.size() == 2);
+        CHECK(lDays[0].mCount == 100);
+        CHECK(lDays[1].mDay == 1);
+        CHECK(lDays[1].mClose == lCloses[199]);
+
+        // Newest 3 bars only, appended after existing content
+        std::vector<RLCharts::OhlcBar> lBars(1);
+        lPyramid.collect(60, 3, lBars);
+        REQUIRE(lBars.size() == 4);
+        CHECK(lBars[1].mDay == 0);
+        CHECK(lBars[1].mCount == 40);
+        CHECK(lBars[2].mCount == 60);
+        CHECK(lBars[3].mCount == 40);
+        CHECK(RLCharts::OhlcPyramid::levelFor(30) == 2);
+        CHECK(RLCharts::OhlcPyramid::levelFor(120) == 3);
+        CHECK(RLCharts::OhlcPyramid::levelFor(7) == 0);
+    }
+
+}
+
+TEST_SUITE("RLSamplePyramid") {
+
+    std::vector<float> makeSamples(size_t aCount) {
+        std::vector<float> lSamples(aCount);
+        uint32_t lSeed = 11u;
+        for (float& rValue : lSamples) {
+            lSeed = lSeed * 1664525u + 1013904223u;
+            rValue = (float)((lSeed >> 8) % 20001u) * 0.001f - 10.0f;
+        }
+        return lSamples;
+    }
+
+    void checkAgainstRescan(const std::vector<RLCharts::SampleBucket>& rBuckets, const std::vector<float>& rSamples) {
+        for (size_t c = 0; c < rBuckets.size(); c++) {
+            const RLCharts::SampleBucket& rBucket = rBuckets[c];
+            REQUIRE(rBucket.mCount > 0);
+            REQUIRE(rBucket.mFirst + rBucket.mCount <= rSamples.size());
+            if (c > 0) {
+                CHECK(rBucket.mFirst == rBuckets[c - 1].mFirst + rBuckets[c - 1].mCount);
+            }
+            float lMin = rSamples[rBucket.mFirst];
+            float lMax = lMin;
+            double lSum = 0.0;
+            for (size_t i = rBucket.mFirst; i < rBucket.mFirst + rBucket.mCount; i++) {
+                lMin = std::min(lMin, rSamples[i]);
+                lMax = std::max(lMax, rSamples[i]);
+                lSum += rSamples[i];
+            }
+            CHECK(rBucket.mMin == lMin);
+            CHECK(rBucket.mMax == lMax);
+            CHECK(rBucket.mMean == doctest::Approx(lSum / (double)rBucket.mCount).epsilon(1e-4));
+        }
+    }
+
+    TEST_CASE("Columns match a rescan of their samples") {
+        const std::vector<float> lSamples = makeSamples(10007);
+        RLCharts::SamplePyramid lPyramid;
+        lPyramid.append(lSamples);
+        CHECK(lPyramid.getSampleCount() == 10007);
+        CHECK(lPyramid.getLevelCount() == 7); // 4^6 = 4096 <= 10007 < 4^7
+
+        // 9000 samples on 100 columns: level 3 (64 samples), a handful of buckets per column
+        std::vector<RLCharts::SampleBucket> lColumns;
+        CHECK(lPyramid.collect(123, 9000, 100, lColumns) == 100);
+        checkAgainstRescan(lColumns, lSamples);
+        CHECK(lColumns.front().mFirst <= 123);
+        CHECK(lColumns.front().mFirst + 64 > 123);
+        CHECK(lColumns.back().mFirst + lColumns.back().mCount <= 9123);
+
+        // A range reaching the newest sample includes the partly filled buckets
+        lColumns.clear();
+        CHECK(lPyramid.collect(0, 20000, 3, lColumns) == 3);
+        checkAgainstRescan(lColumns, lSamples);
+        CHECK(lColumns.back().mFirst + lColumns.back().mCount == 10007);
+
+        float lMin = 0.0f;
+        float lMax = 0.0f;
+        REQUIRE(lPyramid.extent(0, 10007, lMin, lMax));
+        CHECK(lMin == *std::min_element(lSamples.begin(), lSamples.end()));
+        CHECK(lMax == *std::max_element(lSamples.begin(), lSamples.end()));
+        CHECK_FALSE(lPyramid.extent(10007, 5, lMin, lMax));
+    }
+
+    TEST_CASE("Zoomed in past one sample per column") {
+        const std::vector<float> lSamples = makeSamples(50);
+        RLCharts::SamplePyramid lPyramid;
+        lPyramid.append(lSamples);
+
+        std::vector<RLCharts::SampleBucket> lColumns;
+        CHECK(lPyramid.collect(10, 5, 100, lColumns) == 5);
+        for (size_t i = 0; i < lColumns.size(); i++) {
+            CHECK(lColumns[i].mFirst == 10 + i);
+            CHECK(lColumns[i].mMin == lSamples[10 + i]);
+            CHECK(lColumns[i].mMax == lSamples[10 + i]);
+        }
+        CHECK(lPyramid.collect(50, 5, 100, lColumns) == 0);
+
+        lPyramid.clear();
+        CHECK(lPyramid.getSampleCount() == 0);
+        CHECK(lPyramid.collect(0, 5, 100, lColumns) == 0);
+    }
+
+    TEST_CASE("Spilled levels read back through the mapping") {
+        constexpr size_t BLOCK = RLCharts::SamplePyramid::SPILL_BLOCK;
+        const std::vector<float> lSamples = makeSamples(5 * BLOCK + 123);
+        RLCharts::SamplePyramid lMemory;
+        lMemory.append(lSamples);
+
+        RLCharts::SamplePyramid lSpilled;
+        REQUIRE(lSpilled.enableSpill("rlcharts_test_history.bin", BLOCK));
+        lSpilled.append(std::span<const float>(lSamples.data(), 1000));
+        lSpilled.append(std::span<const float>(lSamples.data() + 1000, lSamples.size() - 1000));
+        CHECK(lSpilled.isSpilling());
+        CHECK(lSpilled.getSpilledBytes() >= 3 * BLOCK * sizeof(float));
+        CHECK(lSpilled.getResidentBytes() < lMemory.getResidentBytes());
+
+        std::vector<RLCharts::SampleBucket> lExpected;
+        std::vector<RLCharts::SampleBucket> lActual;
+        for (const size_t lFirst : { (size_t)0, (size_t)777, 2 * BLOCK + 5 }) {
+            lExpected.clear();
+            lActual.clear();
+            lMemory.collect(lFirst, 3 * BLOCK, 640, lExpected);
+            lSpilled.collect(lFirst, 3 * BLOCK, 640, lActual);
+            REQUIRE(lActual.size() == lExpected.size());
+            for (size_t c = 0; c < lActual.size(); c++) {
+                CHECK(lActual[c].mMin == lExpected[c].mMin);
+                CHECK(lActual[c].mMax == lExpected[c].mMax);
+                CHECK(lActual[c].mMean == lExpected[c].mMean);
+            }
+        }
+        lActual.clear();
+        lSpilled.collect(0, 10, 10, lActual);
+        REQUIRE(lActual.size() == 10);
+        CHECK(lActual[9].mMin == lSamples[9]);
+
+        // Back to memory: same answers, file gone
+        lSpilled.disableSpill();
+        CHECK_FALSE(lSpilled.isSpilling());
+        CHECK(lSpilled.getSpilledBytes() == 0);
+        CHECK(std::fopen("rlcharts_test_history.bin", "rb") == nullptr);
+        lActual.clear();
+        lSpilled.collect(0, lSamples.size(), 640, lActual);
+        lExpected.clear();
+        lMemory.collect(0, lSamples.size(), 640, lExpected);
+        REQUIRE(lActual.size() == lExpected.size());
+        CHECK(lActual[100].mMax == lExpected[100].mMax);
+        CHECK(lActual[639].mMean == lExpected[639].mMean);
+    }
+
+}
+
+TEST_SUITE("RLOhlcLoader") {
+
+    void writeFile(const char* pPath, const std::string& rText) {
+        FILE* lpFile = std::fopen(pPath, "wb");
+        REQUIRE(lpFile != nullptr);
+        std::fwrite(rText.data(), 1, rText.size(), lpFile);
+        std::fclose(lpFile);
+    }
+
+    TEST_CASE("CSV rows parse on any thread count") {
+        std::string lText = "date,open,high,low,close,volume,bar_count,of_bars\n";
+        for (int i = 0; i < 500; i++) {
+            // 390 one-minute bars per day from 09:30
+            const int lMinute = 570 + i % 390;
+            char lLine[96];
+            std::snprintf(lLine, sizeof(lLine), "2019-01-%02d %02d:%02d:00,%d.25,%d.5,%d,%d.75,%d\r\n",
+                          2 + i / 390, lMinute / 60, lMinute % 60, 100 + i, 101 + i, 99 + i, 100 + i, 1000 * i);
+            lText += lLine;
+            if (i == 250) {
+                lText += "garbage line\n";
+            }
+        }
+        lText += "1546421400,1,2,0.5,1.5,7"; // epoch seconds, no trailing newline
+        writeFile("rlcharts_test_ohlc.csv", lText);
+
+        RLCharts::OhlcColumns lSingle;
+        REQUIRE(RLCharts::loadOhlcCsv("rlcharts_test_ohlc.csv", lSingle, 1));
+        REQUIRE(lSingle.size() == 501);
+        CHECK(lSingle.mTime[0] == 1546421400); // 2019-01-02 09:30:00 read as UTC
+        CHECK(lSingle.mTime[1] - lSingle.mTime[0] == 60);
+        CHECK(lSingle.mOpen[0] == 100.25f);
+        CHECK(lSingle.mHigh[3] == 104.5f);
+        CHECK(lSingle.mLow[3] == 102.0f);
+        CHECK(lSingle.mClose[3] == 103.75f);
+        CHECK(lSingle.mVolume[400] == 400000.0f);
+        CHECK(lSingle.mTime[390] / 86400 == lSingle.mTime[0] / 86400 + 1);
+        CHECK(lSingle.mTime[500] == 1546421400);
+        CHECK(lSingle.mVolume[500] == 7.0f);
+
+        for (const unsigned lThreads : { 2u, 3u, 7u }) {
+            RLCharts::OhlcColumns lSplit;
+            REQUIRE(RLCharts::loadOhlcCsv("rlcharts_test_ohlc.csv", lSplit, lThreads));
+            CHECK(lSplit.mTime == lSingle.mTime);
+            CHECK(lSplit.mClose == lSingle.mClose);
+            CHECK(lSplit.mVolume == lSingle.mVolume);
+        }
+        RLCharts::OhlcColumns lMissing;
+        CHECK_FALSE(RLCharts::loadOhlcCsv("rlcharts_test_missing.csv", lMissing));
+        std::remove("rlcharts_test_ohlc.csv");
+    }
+
+    TEST_CASE("Binary cache round trip") {
+        writeFile("rlcharts_test_cache.csv", "2020-03-01,1,2,0.5,1.5,10\n2020-03-02,2,3,1.5,2.5,20\n");
+        std::remove("rlcharts_test_cache.ohlc");
+        RLCharts::OhlcColumns lData;
+        REQUIRE(RLCharts::loadOhlcCached("rlcharts_test_cache.csv", "rlcharts_test_cache.ohlc", lData));
+        REQUIRE(lData.size() == 2);
+
+        // The second load comes from the cache, even with the CSV gone
+        std::remove("rlcharts_test_cache.csv");
+        RLCharts::OhlcColumns lCached;
+        REQUIRE(RLCharts::loadOhlcCached("rlcharts_test_cache.csv", "rlcharts_test_cache.ohlc", lCached));
+        CHECK(lCached.mTime == lData.mTime);
+        CHECK(lCached.mOpen == lData.mOpen);
+        CHECK(lCached.mVolume == lData.mVolume);
+        CHECK(lCached.mTime[1] - lCached.mTime[0] == 86400);
+
+        // An edited CSV invalidates the cache, which is then rewritten
+        writeFile("rlcharts_test_cache.csv", "2020-03-01,1,2,0.5,1.5,10\n2020-03-02,2,3,1.5,2.5,20\n2020-03-03,3,4,2.5,3.5,30\n");
+        CHECK_FALSE(RLCharts::loadOhlcBinary("rlcharts_test_cache.ohlc", lCached, "rlcharts_test_cache.csv"));
+        REQUIRE(RLCharts::loadOhlcCached("rlcharts_test_cache.csv", "rlcharts_test_cache.ohlc", lCached));
+        CHECK(lCached.size() == 3);
+        CHECK(RLCharts::loadOhlcBinary("rlcharts_test_cache.ohlc", lCached, "rlcharts_test_cache.csv"));
+        CHECK(lCached.size() == 3);
+
+        // A cache written without a source does not match any CSV
+        REQUIRE(RLCharts::saveOhlcBinary("rlcharts_test_cache.ohlc", lData));
+        CHECK(RLCharts::loadOhlcBinary("rlcharts_test_cache.ohlc", lCached));
+        CHECK_FALSE(RLCharts::loadOhlcBinary("rlcharts_test_cache.ohlc", lCached, "rlcharts_test_cache.csv"));
+        std::remove("rlcharts_test_cache.csv");
+
+        writeFile("rlcharts_test_cache.ohlc", "not a cache");
+        CHECK_FALSE(RLCharts::loadOhlcBinary("rlcharts_test_cache.ohlc", lCached));
+        CHECK(lCached.empty());
+        std::remove("rlcharts_test_cache.ohlc");
+    }
+
+    struct ReplaySink {
+        struct CandleSample {
+            float aOpen{ 0.0f };
+            float aHigh{ 0.0f };
+            float aLow{ 0.0f };
+            float aClose{ 0.0f };
+            float aVolume{ 0.0f };
+            int64_t aTime{ 0 };
+        };
+        void addSample(const CandleSample& rSample) { mTimes.push_back(rSample.aTime); }
+        std::vector<int64_t> mTimes;
+    };
+
+    TEST_CASE("Replay follows recorded time, capped gaps and fixed rates") {
+        RLCharts::OhlcColumns lData;
+        for (const int64_t lTime : { 0, 60, 120, 3600, 3660 }) {
+            lData.mTime.push_back(lTime);
+            lData.mOpen.push_back(1.0f);
+            lData.mHigh.push_back(1.0f);
+            lData.mLow.push_back(1.0f);
+            lData.mClose.push_back(1.0f);
+            lData.mVolume.push_back(1.0f);
+        }
+        RLCharts::OhlcReplay lReplay(lData);
+        lReplay.setSpeed(60.0); // a recorded minute per second
+        lReplay.setMaxGap(120.0);
+        ReplaySink lSink;
+        CHECK(lReplay.feed(0.5f, lSink) == 1);  // first row is due at once
+        CHECK(lReplay.feed(0.5f, lSink) == 1);  // t = 60
+        CHECK(lReplay.feed(0.75f, lSink) == 0);
+        CHECK(lReplay.feed(0.25f, lSink) == 1); // t = 120
+        CHECK(lReplay.feed(1.5f, lSink) == 0);  // 58 minute gap capped to 2
+        CHECK(lReplay.feed(1.5f, lSink) == 2);
+        CHECK(lReplay.finished());
+        CHECK(lSink.mTimes.size() == 5);
+        CHECK(lSink.mTimes[3] == 3600);
+
+        lReplay.seek(0);
+        lReplay.setRate(4.0);
+        size_t lRows = 0;
+        CHECK(lReplay.advance(0.5f, [&lRows](size_t) { lRows++; }) == 2);
+        lReplay.setPaused(true);
+        CHECK(lReplay.advance(10.0f, [&lRows](size_t) { lRows++; }) == 0);
+        lReplay.setPaused(false);
+        CHECK(lReplay.advance(10.0f, [&lRows](size_t) { lRows++; }, 1) == 1);
+        CHECK(lRows == 3);
+        CHECK(lReplay.getCursor() == 3);
+    }
+
+}
+
+TEST_SUITE("RLStateCodec") {
+
+    TEST_CASE("Scalars and float arrays round trip") {
+        const uint32_t lTag = RLCharts::stateTag("TEST");
+        std::vector<float> lRing(4096);
+        for (size_t i = 0; i < lRing.size(); i++) {
+            lRing[i] = 100.0f + sinf((float)i * 0.01f);
+        }
+        lRing[7] = -0.0f;
+        lRing[8] = std::numeric_limits<float>::infinity();
+        lRing[9] = -3.5e-30f;
+
+        RLCharts::StateWriter lWriter;
+        lWriter.writeU32(0xDEADBEEFu);
+        lWriter.writeU64(0x0123456789ABCDEFull);
+        lWriter.writeF32(-2.5f);
+        lWriter.writeFloats(lRing);
+        lWriter.writeFloats(nullptr, 0);
+        const std::vector<uint8_t> lBlob = lWriter.finish(lTag);
+        REQUIRE_FALSE(lBlob.empty());
+        // Slowly varying data compresses well after the delta and byte-plane split
+        CHECK(lBlob.size() < lWriter.getPayloadSize() / 2);
+
+        RLCharts::StateReader lReader;
+        REQUIRE(lReader.open(lBlob, lTag));
+        uint32_t lU32 = 0;
+        uint64_t lU64 = 0;
+        float lF32 = 0.0f;
+        std::vector<float> lRead;
+        std::vector<float> lEmpty;
+        CHECK(lReader.readU32(lU32));
+        CHECK(lReader.readU64(lU64));
+        CHECK(lReader.readF32(lF32));
+        CHECK(lReader.readFloats(lRead, lRing.size()));
+        CHECK(lReader.readFloats(lEmpty, 0));
+        CHECK(lReader.atEnd());
+        CHECK(lU32 == 0xDEADBEEFu);
+        CHECK(lU64 == 0x0123456789ABCDEFull);
+        CHECK(lF32 == -2.5f);
+        REQUIRE(lRead.size() == lRing.size());
+        CHECK(std::memcmp(lRead.data(), lRing.data(), lRing.size() * sizeof(float)) == 0);
+
+        // Reads past the payload fail instead of running off the end
+        CHECK_FALSE(lReader.readU32(lU32));
+        CHECK_FALSE(lReader.readFloats(lRead, 1));
+    }
+
+    TEST_CASE("Foreign or damaged blobs are rejected") {
+        const uint32_t lTag = RLCharts::stateTag("TEST");
+        RLCharts::StateWriter lWriter;
+        for (uint32_t i = 0; i < 100; i++) {
+            lWriter.writeU32(i);
+        }
+        const std::vector<uint8_t> lBlob = lWriter.finish(lTag);
+
+        RLCharts::StateReader lReader;
+        CHECK_FALSE(lReader.open(lBlob, RLCharts::stateTag("OTHR")));
+        CHECK_FALSE(lReader.open(std::span<const uint8_t>(lBlob.data(), 10), lTag));
+        CHECK_FALSE(lReader.open(std::span<const uint8_t>(lBlob.data(), lBlob.size() - 4), lTag));
+        std::vector<uint8_t> lDamaged = lBlob;
+        lDamaged[0] = 'X';
+        CHECK_FALSE(lReader.open(lDamaged, lTag));
+        // A raw size no deflate stream could produce
+        lDamaged = lBlob;
+        lDamaged[19] = 0x7F;
+        CHECK_FALSE(lReader.open(lDamaged, lTag));
+        CHECK(lReader.remaining() == 0);
+        CHECK(lReader.open(lBlob, lTag));
+        CHECK(lReader.remaining() == 400);
+    }
+
+}
@@ -16,10 +16,83 @@
 #include "doctest/doctest.h"
 #include <cstdlib>
 #include <cstdio>
+#include <new>
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
 
 // Global flag to indicate if raylib is available
 bool gRaylibAvailable = false;
 
+// Allocation counter for the perf-contract tests: every operator new on this
+// thread bumps it (raylib's own C allocations are not counted). Per thread, so a
+// dashboard's pool workers do not disturb a measurement on the test thread.
+thread_local size_t gThreadAllocations = 0;
+
+namespace {
+
+void* countedAlloc(std::size_t aSize) {
+    ++gThreadAllocations;
+    return std::malloc(aSize == 0 ? 1 : aSize);
+}
+
+void* countedAlignedAlloc(std::size_t aSize, std::align_val_t aAlign) {
+    ++gThreadAllocations;
+    const auto lAlign = (std::size_t)aAlign;
+#if defined(_WIN32)
+    return _aligned_malloc(aSize == 0 ? 1 : aSize, lAlign);
+#else
+    // aligned_alloc wants a size that is a multiple of the alignment
+    return std::aligned_alloc(lAlign, ((aSize == 0 ? 1 : aSize) + lAlign - 1) / lAlign * lAlign);
+#endif
+}
+
+void alignedFree(void* pMemory) {
+#if defined(_WIN32)
+    _aligned_free(pMemory);
+#else
+    std::free(pMemory);
+#endif
+}
+
+} // namespace
+
+void* operator new(std::size_t aSize) {
+    if (void* pMemory = countedAlloc(aSize)) {
+        return pMemory;
+    }
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t aSize) { return operator new(aSize); }
+void* operator new(std::size_t aSize, const std::nothrow_t&) noexcept { return countedAlloc(aSize); }
+void* operator new[](std::size_t aSize, const std::nothrow_t&) noexcept { return countedAlloc(aSize); }
+void* operator new(std::size_t aSize, std::align_val_t aAlign) {
+    if (void* pMemory = countedAlignedAlloc(aSize, aAlign)) {
+        return pMemory;
+    }
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t aSize, std::align_val_t aAlign) { return operator new(aSize, aAlign); }
+void* operator new(std::size_t aSize, std::align_val_t aAlign, const std::nothrow_t&) noexcept {
+    return countedAlignedAlloc(aSize, aAlign);
+}
+void* operator new[](std::size_t aSize, std::align_val_t aAlign, const std::nothrow_t&) noexcept {
+    return countedAlignedAlloc(aSize, aAlign);
+}
+
+void operator delete(void* pMemory) noexcept { std::free(pMemory); }
+void operator delete[](void* pMemory) noexcept { std::free(pMemory); }
+void operator delete(void* pMemory, std::size_t) noexcept { std::free(pMemory); }
+void operator delete[](void* pMemory, std::size_t) noexcept { std::free(pMemory); }
+void operator delete(void* pMemory, const std::nothrow_t&) noexcept { std::free(pMemory); }
+void operator delete[](void* pMemory, const std::nothrow_t&) noexcept { std::free(pMemory); }
+void operator delete(void* pMemory, std::align_val_t) noexcept { alignedFree(pMemory); }
+void operator delete[](void* pMemory, std::align_val_t) noexcept { alignedFree(pMemory); }
+void operator delete(void* pMemory, std::size_t, std::align_val_t) noexcept { alignedFree(pMemory); }
+void operator delete[](void* pMemory, std::size_t, std::align_val_t) noexcept { alignedFree(pMemory); }
+void operator delete(void* pMemory, std::align_val_t, const std::nothrow_t&) noexcept { alignedFree(pMemory); }
+void operator delete[](void* pMemory, std::align_val_t, const std::nothrow_t&) noexcept { alignedFree(pMemory); }
+
 int main(int aArgc, char** apArgv) {
     // Check if we should skip raylib initialization (CI environment without display)
     const char* lpSkipRaylib = std::getenv("CPP_CHARTS_SKIP_RAYLIB");
@@ -7,6 +7,7 @@ set -e
 
 SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
 BUILD_DIR="${SCRIPT_DIR}/build"
+FAST_BUILD_DIR="${SCRIPT_DIR}/build-fast"
 
 echo "╔══════════════════════════════════════════════════════════════╗"
 echo "║           cpp-charts WebAssembly Build                       ║"
@@ -52,6 +53,16 @@ echo "🔨 Building all demos..."
 NPROC=$(nproc 2>/dev/null || sysctl -n hw.ncpu 2>/dev/null || echo 4)
 emmake make -j${NPROC}
 
+# SIMD128 + pthreads variant of the dashboard, copied to build/fast/ for perf.html
+echo ""
+echo "⚡ Building the SIMD128 + pthreads dashboard..."
+mkdir -p "${FAST_BUILD_DIR}"
+cd "${FAST_BUILD_DIR}"
+emcmake cmake .. -DCMAKE_BUILD_TYPE=Release -DCPP_CHARTS_WASM_SIMD=ON -DCPP_CHARTS_WASM_THREADS=ON
+emmake make -j${NPROC} dashboard
+mkdir -p "${BUILD_DIR}/fast"
+cp dashboard.* "${BUILD_DIR}/fast/"
+
 echo ""
 echo "╔══════════════════════════════════════════════════════════════╗"
 echo "║                    Build Complete! 🎉                        ║"
@@ -62,8 +73,10 @@ echo ""
 echo "To run the demos locally:"
 echo ""
 echo "  cd ${BUILD_DIR}"
-echo "  python3 -m http.server 8080"
+echo "  python3 serve.py 8080"
 echo ""
 echo "Then open http://localhost:8080 in your browser"
+echo "(serve.py adds the COOP/COEP headers the threaded build in fast/ needs;"
+echo " http://localhost:8080/perf.html compares it with the baseline)"
 echo ""
 
@@ -0,0 +1,26 @@
+#!/usr/bin/env python3
+# Static file server for the WebAssembly demos with cross-origin isolation.
+# Threaded builds (CPP_CHARTS_WASM_THREADS) use SharedArrayBuffer, which browsers
+# only enable on pages served with these COOP/COEP headers; python3 -m http.server
+# does not send them.
+#
+# Usage: python3 serve.py [port]   (serves the current directory)
+
+import sys
+from http.server import SimpleHTTPRequestHandler, ThreadingHTTPServer
+
+
+class IsolatedHandler(SimpleHTTPRequestHandler):
+    extensions_map = {**SimpleHTTPRequestHandler.extensions_map, ".wasm": "application/wasm"}
+
+    def end_headers(self):
+        self.send_header("Cross-Origin-Opener-Policy", "same-origin")
+        self.send_header("Cross-Origin-Embedder-Policy", "require-corp")
+        self.send_header("Cache-Control", "no-store")
+        super().end_headers()
+
+
+if __name__ == "__main__":
+    port = int(sys.argv[1]) if len(sys.argv) > 1 else 8080
+    print(f"Serving on http://localhost:{port} (cross-origin isolated)")
+    ThreadingHTTPServer(("", port), IsolatedHandler).serve_forever()